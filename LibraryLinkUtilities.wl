@@ -17,6 +17,46 @@ InitializePacletLibrary::usage = "InitializePacletLibrary[libPath_]
 	libPath - path to the main paclet library (the one that LLU was linked into)";
 LazyInitializePacletLibrary::usage = "Lazy version of InitializePacletLibrary
 	which loads the library at the time the first library function is loaded.";
+PrefetchPacletFunctions::usage = "PrefetchPacletFunctions[]
+	Loads all library functions that were set with one of the Lazy*FunctionSet functions and have not been used yet.
+	Functions that use MArguments are only loaded if they are registered in the function table of the paclet library,
+	the other ones are left to be loaded on first use, which reports any loading errors.
+	Returns the list of names of loaded functions.
+	With the option \"Prefetch\" -> True, InitializePacletLibrary and LazyInitializePacletLibrary submit this function
+	to be evaluated when the current evaluation (e.g. loading of the paclet) finishes.";
+PacletFunctionTable::usage = "PacletFunctionTable[]
+	Returns an Association of names and IDs of all library functions registered in the paclet library,
+	which includes all functions defined with LLU_LIBRARY_FUNCTION and related macros.";
+PacletFunctionStats::usage = "PacletFunctionStats[]
+	Returns an Association of names of library functions defined with LLU_LIBRARY_FUNCTION and related macros and their statistics:
+	numbers of calls and exceptions, total, minimal, maximal, mean, median, 90th and 99th percentile time in seconds and a histogram of latencies.
+	Statistics are only collected if the paclet library was compiled with LLU_FUNCTION_STATS defined, otherwise an empty Association is returned.
+PacletFunctionStats[libPath]
+	Returns statistics of functions from given library.";
+ResetPacletFunctionStats::usage = "ResetPacletFunctionStats[]
+	Resets statistics of all library functions in the paclet library, see PacletFunctionStats.
+ResetPacletFunctionStats[libPath]
+	Resets statistics of all library functions in given library.";
+PacletTrace::usage = "PacletTrace[]
+	Returns a String with spans of library functions, thread pool tasks, expressions sent with WSStream and log calls recorded in the paclet library,
+	as a JSON document in the Chrome trace event format that can be exported to a file and opened in chrome://tracing or ui.perfetto.dev.
+	Spans are only recorded if the paclet library was compiled with LLU_TRACING defined, otherwise the document has no events.
+PacletTrace[libPath]
+	Returns spans recorded in given library.";
+ResetPacletTrace::usage = "ResetPacletTrace[]
+	Forgets all spans recorded in the paclet library, see PacletTrace.
+ResetPacletTrace[libPath]
+	Forgets all spans recorded in given library.";
+PacletMemoryStats::usage = "PacletMemoryStats[]
+	Returns an Association with the memory held in containers owned by the paclet library: \"LiveBytes\", \"PeakBytes\", \"LiveCount\" and \"TotalCount\",
+	and the same statistics per container type under \"Containers\" and per allocation-site tag under \"Tags\".
+	Memory is only counted if the paclet library was compiled with LLU_MEMORY_STATS defined, otherwise all numbers are zero.
+PacletMemoryStats[libPath]
+	Returns memory statistics of given library.";
+ResetPacletMemoryStats::usage = "ResetPacletMemoryStats[]
+	Resets peaks and total counts of the memory statistics of the paclet library to the current usage, see PacletMemoryStats.
+ResetPacletMemoryStats[libPath]
+	Resets memory statistics of given library.";
 
 (* ---------------- Paclet errors ------------------------------------------ *)
 
@@ -33,11 +73,22 @@ on the to-be-thrown Failure object and can be customized.
 ThrowPacletFailure[type_?StringQ, tag_, opts]
 Throws a Failure object for the custom error named by type with explicitly specified tag (second argument to Throw).";
 
+CollectedFailures::usage = "CollectedFailures[records_List]
+	Turns errors collected in C++ with LLU::ErrorCollector into a list of Failure objects, each with an additional \"ElementIndex\" key.
+	records can be either a matrix of {errorCode, elementIndex} pairs returned by ErrorCollector::toTensor or a list of {errorCode, elementIndex, params}
+	triples sent by ErrorCollector::put.";
+
+LastCollectedFailures::usage = "LastCollectedFailures[]
+	Returns the list of Failure objects for the errors most recently sent with ErrorCollector::sendFailures and clears them.";
+
 (* ---------------- Configuration ------------------------------------------ *)
 
 $Throws::usage = "Default value for the \"Throws\" option for loading library functions. Notice that this setting does not affect LLU API functions
 (e.g. RegisterPacletErrors, InitializePacletLibrary, etc.) as they always throw on failure.";
 
+$Dispatch::usage = "Default value for the \"Dispatch\" option for loading library functions. When True, functions registered in the library
+are bound through its single dispatcher entry point instead of being loaded one by one.";
+
 $ExceptionTagFunction::usage = "Function to be applied to a Failure returned by a library function to determine the second argument to Throw[].";
 
 (* ---------------- Loading libraries and library functions ---------------- *)
@@ -82,6 +133,13 @@ PacletFunctionLoad::usage = "PacletFunctionLoad[fname_?StringQ, fParams_, retTyp
 	a library name can be specified as the first argument. Unlike PacletFunctionSet, there is no mechanism
 	by which to avoid eager loading of the default paclet library.";
 
+ResolveSharedResults::usage = "ResolveSharedResults[expr, libPath]
+	Replaces every LLU`SharedResult[ticket, type, dims] in expr with the Tensor or NumericArray that a WSTP function of the library staged
+	with LLU::WS::shared, instead of sending it over WSTP. The array is passed from the library without copying and each ticket can be resolved once.
+	WSTP functions loaded with the option \"SharedResults\" -> True resolve their results automatically.
+ResolveSharedResults[expr]
+	Resolves shared results from the paclet library.";
+
 (* ---------------- Managed Library Expressions ---------------------------- *)
 
 Constructor::usage = "Constructor[exprHead_] shall evaluate to a function that takes an instanceID (Integer) and an arbitrary number of additional arguments.
@@ -90,6 +148,10 @@ Managed::usage = "Managed[exprHead_]
 	represents a MLE instance.";
 NewManagedExpression::usage = "NewManagedExpression[exprHead_][args___]
 	Creates a MLE instance.";
+BatchConstructor::usage = "BatchConstructor[exprHead_] may evaluate to a function that takes a list of instanceIDs and an arbitrary number of additional arguments.
+	This function is responsible for creating instances of managed expression for all given IDs in the corresponding ManagedExpressionStore on the C++ side";
+NewManagedExpressions::usage = "NewManagedExpressions[exprHead_][n_, args___]
+	Creates a list of n MLE instances. If BatchConstructor[exprHead] is defined, all instances are constructed in a single library function call.";
 ManagedQ::usage = "ManagedQ[exprHead_][expr]
 	Checks whether expr is a valid MLE instance.";
 ManagedIDQ::usage = "ManagedIDQ[exprHead_][expr]
@@ -172,6 +234,15 @@ and returns an expression of \"type\" t. DownValues for this symbol can be provi
 	Append to a list and assign to given symbol. Good choice if you don't want to see the logs immediately, but want to store them for later analysis.";
 `Logger`PrintLogFunctionSelector::usage = "This is a \"selector\" called by other functions below. Feel free to modify/Block this symbol, see examples.";
 `Logger`LogHandler::usage = "This is a function WSTP will call from the C++ code. It all starts here. Feel free to modify/Block this symbol, see examples.";
+`Logger`SetAsyncLogging::usage = "SetAsyncLogging[True | False]
+	Switch between sending every log from the C++ code immediately and queueing logs to send them in batches. Returns the previous setting.
+	Queued logs are sent when a library function defined with LLU_LIBRARY_FUNCTION or related macros finishes,
+	or when FlushLogs[] is evaluated. Logging in the asynchronous mode is cheap and can also be done from worker threads.";
+`Logger`FlushLogs::usage = "FlushLogs[]
+	Send all queued logs to LogHandler, see SetAsyncLogging.";
+`Logger`SetLogLevel::usage = "SetLogLevel[\"Debug\" | \"Warning\" | \"Error\"]
+	Set the lowest severity of logs sent from the C++ code, other logs are discarded before they are formatted or sent to top-level.
+	Only affects log levels that were enabled when compiling the paclet library. Returns the previous level.";
 
 (* ::Section:: *)
 (* Load Dependencies *)
@@ -197,10 +268,21 @@ LoadWSTPLibrary[] :=
  * unless it failed. Failures are indicated by Throwing. In the lazy version, loading is triggered when the first library function is loaded.
  * libPath - path to the main paclet library (the one that LLU was linked into)
  *)
+Options[InitializePacletLibrary] = {
+	"Prefetch" -> False
+};
+Options[LazyInitializePacletLibrary] = Options[InitializePacletLibrary];
+
 SetAttributes[LazyInitializePacletLibrary, HoldFirst];
-LazyInitializePacletLibrary[libPath_] := LazyLoad[$PacletLibrary, $InitializePacletLibrary[libPath]];
+LazyInitializePacletLibrary[libPath_, opts : OptionsPattern[]] := (
+	LazyLoad[$PacletLibrary, $InitializePacletLibrary[libPath]];
+	If[TrueQ @ OptionValue["Prefetch"],
+		(* Lazy functions are usually set after the library is initialized, so prefetching starts when the current evaluation is done *)
+		SessionSubmit[PrefetchPacletFunctions[]]
+	];
+);
 
-InitializePacletLibrary[libPath_?StringQ] := (LazyInitializePacletLibrary[libPath]; $PacletLibrary);
+InitializePacletLibrary[libPath_?StringQ, opts : OptionsPattern[]] := (LazyInitializePacletLibrary[libPath, opts]; $PacletLibrary);
 
 $InitializePacletLibrary[libPath_?StringQ] := (
 	(* Load WSTP *)
@@ -247,7 +329,8 @@ $CorePacletFailureLUT = <|
 	"UnknownFailure" -> {23, "The error `ErrorName` has not been registered."},
 	"ProgressMonInvalidValue" -> {24, "Expecting None or a Symbol for the option \"ProgressMonitor\"."},
 	"InvalidManagedExpressionID" -> {25, "`Expr` is not a valid ManagedExpression." },
-	"UnexpectedManagedExpression" -> {26, "Expected managed `Expected`, got `Actual`." }
+	"UnexpectedManagedExpression" -> {26, "Expected managed `Expected`, got `Actual`." },
+	"ListableInvalidType" -> {27, "Listable library functions only take and return Integer, Real or Complex scalars, got `Type`." }
 |>;
 
 (* Every error used in the paclet must have unique ID. We distinguish 4 ranges of IDs:
@@ -368,9 +451,48 @@ SafeLibraryLoad[lib_] :=
 	];
 
 Options[SafeLibraryFunctionLoad] = {
+	"Dispatch" :> $Dispatch,
 	"Optional" -> False
 };
 
+(* Table of functions registered in an LLU library, it is fetched once per library. Libraries without the table get an empty one. *)
+FunctionTable[libName_?StringQ] :=
+	FunctionTable[libName] = Replace[
+		Quiet @ LibraryFunctionLoad[libName, "getFunctionTable", LinkObject, LinkObject],
+		{lf_LibraryFunction :> Replace[Quiet @ lf[], Except[_?AssociationQ] -> <||>], _ -> <||>}
+	];
+
+(* The dispatcher takes the function ID followed by the arguments of the function. It is loaded once per library and signature. *)
+Dispatcher[libName_, fParams_, retType_] :=
+	With[{dispatcher = LibraryFunctionLoad[libName, "dispatchLibraryFunction", Prepend[fParams, Integer], retType]},
+		If[FailureQ[dispatcher], dispatcher, Dispatcher[libName, fParams, retType] = dispatcher]
+	];
+
+(* Arrays staged by WSTP functions are fetched with a LibraryLink function, loaded once per library and result type *)
+sharedResultType["Integer"] := {Integer, _};
+sharedResultType["Real"] := {Real, _};
+sharedResultType["Complex"] := {Complex, _};
+sharedResultType["NumericArray"] := LibraryDataType[NumericArray];
+
+SharedResultFetcher[libName_, type_] :=
+	With[{fetcher = LibraryFunctionLoad[libName, "fetchSharedResult", {Integer}, sharedResultType[type]]},
+		If[FailureQ[fetcher], fetcher, SharedResultFetcher[libName, type] = fetcher]
+	];
+
+ResolveSharedResults[expr_, libName_?StringQ] :=
+	expr /. LLU`SharedResult[ticket_Integer, type : "Integer" | "Real" | "Complex" | "NumericArray", _List] :>
+		With[{fetcher = SharedResultFetcher[libName, type]}, If[FailureQ[fetcher], fetcher, fetcher[ticket]]];
+ResolveSharedResults[expr_] := ResolveSharedResults[expr, $PacletLibrary];
+
+(* Load a library function directly, or bind it through the dispatcher if it is registered in the library *)
+LoadLibraryFunction[libName_, fname_, fParams_List, retType_, True] :=
+	With[{id = Lookup[FunctionTable[libName], fname]},
+		With[{dispatcher = Dispatcher[libName, fParams, retType]},
+			If[FailureQ[dispatcher], dispatcher, dispatcher[id, ##]&]
+		] /; IntegerQ[id]
+	];
+LoadLibraryFunction[libName_, fname_, fParams_, retType_, _] := LibraryFunctionLoad[libName, fname, fParams, retType];
+
 (* 
  *	SafeLibraryFunctionLoad[libName_, fname_?StringQ, fParams_, retType_, opts___]
  *	Quietly tries to load a function fname from the dynamic library libName, and Throws if the loading does not succeed.
@@ -385,14 +507,15 @@ SafeLibraryFunctionLoad[libName_?StringQ, fname_?StringQ, fParams_, retType : Ex
 		 * - special - extensions added by LLU or paclet developers that need extra parsing before they can be passed to LibraryLink,
 		 *             for example Managed Expressions
 		 *)
-		Block[{specialArgs = SelectSpecialArgs[fParams], specialRetQ = CustomMResultTypeQ[retType], actualRetType, libFunction},
+		Block[{specialArgs = SelectSpecialArgs[fParams], specialRetQ = CustomMResultTypeQ[retType], dispatchQ = TrueQ @ OptionValue["Dispatch"],
+			actualRetType, libFunction},
 			actualRetType = If[specialRetQ, MResultCustomType[retType], retType];
 			libFunction = If[Length @ specialArgs > 0,
 				(* If the function that we are registering takes special arguments, we need to compose it with argumentParser function,
 				 * which will parse input arguments before every call, so that they are accepted by LibraryLink.*)
-				LibraryFunctionLoad[libName, fname, MArgumentCustomType /@ fParams, actualRetType] @* ArgumentParser[specialArgs]
+				LoadLibraryFunction[libName, fname, MArgumentCustomType /@ fParams, actualRetType, dispatchQ] @* ArgumentParser[specialArgs]
 				,
-				LibraryFunctionLoad[libName, fname, fParams, actualRetType]
+				LoadLibraryFunction[libName, fname, fParams, actualRetType, dispatchQ]
 			];
 			If[FailureQ[libFunction],
 				If[TrueQ @ OptionValue["Optional"],
@@ -414,7 +537,9 @@ SafeLibraryFunctionLoad[libName_?StringQ, fname_?StringQ, fParams_, retType : Ex
 Options[PacletFunctionLoad] = SortBy[ToString] @ Join[
 	Options[SafeLibraryFunctionLoad],
 	{
+		"Listable" -> False,
 		"ProgressMonitor" -> None,
+		"SharedResults" -> False,
 		"Throws" :> $Throws
 	}
 ];
@@ -424,6 +549,32 @@ holdSet[Hold[sym_], rhs_] := sym = rhs;
 PacletFunctionLoad[fname_?StringQ, fParams_, retType : Except[_?OptionQ], opts : OptionsPattern[]] :=
     PacletFunctionLoad[$PacletLibrary, fname, fParams, retType, opts];
 
+(* Listable functions get lists of scalar arguments packed into Tensors of the corresponding type and return a Tensor of results *)
+listableElementType[type : Integer | Real | Complex] := type;
+listableElementType[type_] := ThrowPacletFailure["ListableInvalidType", "MessageParameters" -> <|"Type" -> type|>];
+
+listableResultType["Void"] := "Void";
+listableResultType[type_] := {listableElementType[type], _};
+
+(* Scalar arguments are repeated to match the dimensions of the first list argument *)
+packListableArguments[types_, args_List] :=
+	With[{dims = Dimensions @ SelectFirst[args, ListQ, {}]},
+		MapThread[Developer`ToPackedArray[If[ListQ[#1], #1, ConstantArray[#1, dims]], #2]&, {args, types}]
+	] /; Length[types] == Length[args];
+packListableArguments[_, args_List] := args;
+
+(* With only scalar arguments the function is called on lists of length 1 and the single result is returned as a scalar *)
+callListable[lf_, types_, args_List] /; NoneTrue[args, ListQ] := Replace[lf @@ packListableArguments[types, List /@ args], {r_} :> r];
+callListable[lf_, types_, args_List] := lf @@ packListableArguments[types, args];
+
+PacletFunctionLoad[libName_?StringQ, fname_?StringQ, fParams_List, retType : Except[_?OptionQ], opts : OptionsPattern[]] /;
+	TrueQ[OptionValue[PacletFunctionLoad, FilterRules[{opts}, Options[PacletFunctionLoad]], "Listable"]] :=
+	With[{types = listableElementType /@ fParams},
+		With[{lf = PacletFunctionLoad[libName, fname, {#, _, "Constant"}& /@ types, listableResultType[retType], "Listable" -> False, opts]},
+			callListable[lf, types, {##}]&
+		]
+	];
+
 PacletFunctionLoad[libName_?StringQ, fname_?StringQ, fParams_, retType : Except[_?OptionQ], opts : OptionsPattern[]] :=
 Module[{errorHandler, pmSymbol, newParams, functionOptions, loadOptions},
 	functionOptions = FilterRules[{opts}, Options[PacletFunctionLoad]];
@@ -434,19 +585,27 @@ Module[{errorHandler, pmSymbol, newParams, functionOptions, loadOptions},
 	];
 	pmSymbol = OptionValue[Automatic, functionOptions, "ProgressMonitor", Hold];
 	loadOptions = FilterRules[{opts}, Options[SafeLibraryFunctionLoad]];
-	If[fParams === LinkObject || pmSymbol === Hold[None],
-		errorHandler @* SafeLibraryFunctionLoad[libName, fname, fParams, retType, loadOptions]
-		, (* else *)
-		If[Not @ Developer`SymbolQ @ ReleaseHold @ pmSymbol,
-			ThrowPacletFailure["ProgressMonInvalidValue"];
-		];
-		newParams = Append[fParams, {Real, 1, "Shared"}];
-		With[{ps = pmSymbol, lf = errorHandler @* SafeLibraryFunctionLoad[libName, fname, newParams, retType, loadOptions]},
-			(
-				holdSet[ps, Developer`ToPackedArray[{0.0}]];
-				lf[##, ReleaseHold[ps]]
-			)&
-		]
+	Which[
+		fParams === LinkObject && TrueQ[OptionValue[Automatic, functionOptions, "SharedResults"]],
+			(* shared results are fetched from the same library that the function comes from *)
+			With[{lib = libName, lf = errorHandler @* SafeLibraryFunctionLoad[libName, fname, fParams, retType, loadOptions]},
+				ResolveSharedResults[lf[##], lib]&
+			]
+		,
+		fParams === LinkObject || pmSymbol === Hold[None],
+			errorHandler @* SafeLibraryFunctionLoad[libName, fname, fParams, retType, loadOptions]
+		,
+		True,
+			If[Not @ Developer`SymbolQ @ ReleaseHold @ pmSymbol,
+				ThrowPacletFailure["ProgressMonInvalidValue"];
+			];
+			newParams = Append[fParams, {Real, 1, "Shared"}];
+			With[{ps = pmSymbol, lf = errorHandler @* SafeLibraryFunctionLoad[libName, fname, newParams, retType, loadOptions]},
+				(
+					holdSet[ps, Developer`ToPackedArray[{0.0}]];
+					lf[##, ReleaseHold[ps]]
+				)&
+			]
 	]
 ];
 
@@ -467,6 +626,9 @@ iLoadLibraryFunction[symbol_, assignmentHead_, loader_, libraryName_, args___, o
 		loadingOpts = FilterRules[{opts}, Options[Replace[loader, _MemberFunctionLoad -> MemberFunctionSet]]];
 
 		clearLHS[symbol];
+		If[assignmentHead === LazyLoad,
+			AppendTo[$LazyLibraryFunctions, {Hold[symbol], libraryName, args}]
+		];
 		assignmentHead[
 			symbol,
 			(
@@ -566,6 +728,55 @@ LazyWSTPFunctionSet[symbol_, opts : OptionsPattern[]] :=
 Attributes[LazyLoad] = {HoldAll};
 LazyLoad[f_, expr_] := (f := f = expr);
 
+(* Lazily loaded library functions, in the form {Hold[symbol], libraryName, functionName, paramTypes, retType}, to be loaded by PrefetchPacletFunctions *)
+$LazyLibraryFunctions = {};
+
+PacletFunctionTable[] := FunctionTable[$PacletLibrary];
+
+(* Functions that report statistics of library functions, recorded trace spans and memory held in containers, exported by libraries linked with LLU *)
+StatsFunction[libName_?StringQ, fname_] :=
+	StatsFunction[libName, fname] = Replace[Quiet @ LibraryFunctionLoad[libName, fname, LinkObject, LinkObject], Except[_LibraryFunction] -> None];
+
+PacletFunctionStats[] := PacletFunctionStats[$PacletLibrary];
+PacletFunctionStats[libName_?StringQ] :=
+	Replace[StatsFunction[libName, "getFunctionStats"], {lf_LibraryFunction :> Replace[lf[], Except[_?AssociationQ] -> <||>], _ -> <||>}];
+
+ResetPacletFunctionStats[] := ResetPacletFunctionStats[$PacletLibrary];
+ResetPacletFunctionStats[libName_?StringQ] :=
+	(Replace[StatsFunction[libName, "resetFunctionStats"], lf_LibraryFunction :> lf[]]; Null);
+
+PacletTrace[] := PacletTrace[$PacletLibrary];
+PacletTrace[libName_?StringQ] :=
+	Replace[StatsFunction[libName, "getTrace"], {lf_LibraryFunction :> Replace[lf[], Except[_?StringQ] -> $Failed], _ -> $Failed}];
+
+ResetPacletTrace[] := ResetPacletTrace[$PacletLibrary];
+ResetPacletTrace[libName_?StringQ] :=
+	(Replace[StatsFunction[libName, "resetTrace"], lf_LibraryFunction :> lf[]]; Null);
+
+PacletMemoryStats[] := PacletMemoryStats[$PacletLibrary];
+PacletMemoryStats[libName_?StringQ] :=
+	Replace[StatsFunction[libName, "getMemoryStats"], {lf_LibraryFunction :> Replace[lf[], Except[_?AssociationQ] -> <||>], _ -> <||>}];
+
+ResetPacletMemoryStats[] := ResetPacletMemoryStats[$PacletLibrary];
+ResetPacletMemoryStats[libName_?StringQ] :=
+	(Replace[StatsFunction[libName, "resetMemoryStats"], lf_LibraryFunction :> lf[]]; Null);
+
+PrefetchPacletFunctions[] :=
+	Module[{pending = $LazyLibraryFunctions, table},
+		$LazyLibraryFunctions = {};
+		table = Quiet @ Catch[PacletFunctionTable[], _, <||>&];
+		prefetchLibraryFunction[#, table]& /@ pending
+	];
+
+(* A function that fails to load is left to be loaded on first use, which will report the failure *)
+prefetchLibraryFunction[{symbol_Hold, libraryName_, fname_, paramTypes_, ___}, table_] :=
+	If[paramTypes =!= LinkObject && MemberQ[{None, $PacletLibrary}, libraryName] && Length[table] > 0 && !KeyExistsQ[table, fname],
+		Nothing
+		,
+		Quiet @ Catch[ReleaseHold[symbol]; fname, _, Nothing&]
+	];
+prefetchLibraryFunction[___] := Nothing;
+
 
 (* ::SubSection:: *)
 (* RegisterPacletErrors *)
@@ -663,6 +874,36 @@ ThrowPacletFailure[type_?StringQ, tag_, opts : OptionsPattern[CreatePacletFailur
 		Throw[failure, tag];
 	];
 
+(* ::SubSection:: *)
+(* CollectedFailures *)
+(* ------------------------------------------------------------------------- *)
+(* ------------------------------------------------------------------------- *)
+
+(* Errors collected with ErrorCollector are sent all at once, either as the result of a library function or assigned to this symbol by
+ * ErrorCollector::sendFailures, and only here they become Failure objects. Message parameters of each error are passed to CreatePacletFailure
+ * in the same way as for a thrown exception, by temporarily assigning them to $LastFailureParameters.
+ *)
+Clear @ $LastCollectedFailures;
+
+CollectedFailures[records_List] :=
+	Map[
+		Replace[{
+			{code_Integer, index_Integer, params_List : {}} :>
+				Replace[
+					Block[{$LastFailureParameters = params}, CreatePacletFailure[ErrorCodeToName[code]]],
+					Failure[type_, assoc_] :> Failure[type, Append[assoc, "ElementIndex" -> index]]
+				],
+			_ -> Nothing
+		}],
+		Normal[records]
+	];
+
+LastCollectedFailures[] :=
+	With[{records = If[ListQ[$LastCollectedFailures], $LastCollectedFailures, {}]},
+		$LastCollectedFailures = {};
+		CollectedFailures[records]
+	];
+
 (* ::SubSection:: *)
 (* CatchLibraryLinkError *)
 (* ------------------------------------------------------------------------- *)
@@ -716,6 +957,8 @@ End[]; (* `Private` *)
 
 $Throws = True;
 
+$Dispatch = False;
+
 $ExceptionTagString = "LLUExceptionTag";
 
 $ExceptionTagFunction := $ExceptionTagString&;
@@ -831,6 +1074,25 @@ PrintLogFunctionSelector := PrintLogToNotebook;
 (* This is a function WSTP will call from the C++ code. It all starts here. Feel free to modify/Block this symbol, see examples. *)
 LogHandler := PrintLogFunctionSelector @* LogFilterSelector;
 
+
+(************* Asynchronous logging *************)
+
+(* Library functions that control the queue of logs, they are loaded on first use *)
+$SetAsyncLogging := $SetAsyncLogging = PacletFunctionLoad["setLoggerAsync", {True | False}, True | False];
+$FlushLogs := $FlushLogs = PacletFunctionLoad["flushLogs", {}, "Void"];
+
+SetAsyncLogging[async : True | False] := $SetAsyncLogging[async];
+
+FlushLogs[] := $FlushLogs[];
+
+(************* Runtime log level *************)
+
+$LogLevels = {"Debug", "Warning", "Error"};
+
+$SetLogLevel := $SetLogLevel = PacletFunctionLoad["setLoggerThreshold", {Integer}, Integer];
+
+SetLogLevel[level : Alternatives @@ $LogLevels] := $LogLevels[[$SetLogLevel[First @ FirstPosition[$LogLevels, level] - 1] + 1]];
+
 End[]; (* `Logger` *)
 
 
@@ -926,6 +1188,21 @@ NewManagedExpression[exprHead_][args___] :=
 		res
 	];
 
+BatchConstructor;
+
+NewManagedExpressions[exprHead_][n_Integer?NonNegative, args___] :=
+	Block[{res, batchConstructor = BatchConstructor[exprHead], constructor},
+		res = Table[CreateManagedLibraryExpression[SymbolName[exprHead], exprHead], n];
+		If[MatchQ[batchConstructor, _BatchConstructor],
+			(* no batch constructor, fall back to constructing instances one by one *)
+			constructor = Constructor[exprHead];
+			Scan[constructor[ManagedLibraryExpressionID[#], args]&, res]
+			,
+			batchConstructor[ManagedLibraryExpressionID /@ res, args]
+		];
+		res
+	];
+
 ManagedQ[exprHead_] := ManagedLibraryExpressionQ[#, SymbolName[exprHead]]&;
 ManagedIDQ[exprHead_] := ManagedLibraryExpressionQ[exprHead[#], SymbolName[exprHead]]&;
 
@@ -0,0 +1,83 @@
+/**
+ * @file	AbortCheck.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Waiting for thread pool work from the main thread while reacting to user aborts in the Wolfram Language.
+ */
+#ifndef LLU_ASYNC_ABORTCHECK_H
+#define LLU_ASYNC_ABORTCHECK_H
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "LLU/Async/TaskGroup.h"
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/LibraryData.h"
+
+namespace LLU::Async {
+
+	/// Default time between two calls to AbortQ in waitWithAbortCheck
+	inline constexpr std::chrono::milliseconds defaultAbortCheckInterval {10};
+
+	/**
+	 * @brief   Block the calling thread until \p done returns true, polling the Kernel for an abort in the meantime.
+	 * @details AbortQ can only be called from the main thread, so the worker threads cannot check it themselves. This function does it for them:
+	 * every \p interval it asks the Kernel whether the user aborted the evaluation and if so, it cancels the pool. Tasks that are already running
+	 * should poll the pool's cancellation token to stop early, waiting tasks are discarded. Once \p done is satisfied, the cancellation is reset
+	 * and the abort is reported to the Kernel.
+	 * @tparam  Pool - thread pool with cancel() and resetCancellation(), like LLU::ThreadPool
+	 * @tparam  Predicate - callable returning bool
+	 * @param   pool - thread pool that evaluates the work
+	 * @param   done - returns true when the work is finished, it must become true eventually also after the pool is cancelled
+	 * @param   interval - time between two checks for abort
+	 * @throws  ErrorName::Aborted - if the user aborted the evaluation
+	 * @note    Call it only from the main thread, i.e. the thread that called the library function.
+	 */
+	template<typename Pool, typename Predicate>
+	void waitWithAbortCheck(Pool& pool, Predicate&& done, std::chrono::milliseconds interval = defaultAbortCheckInterval) {
+		using Clock = std::chrono::steady_clock;
+		const auto nap = std::min<std::chrono::milliseconds>(interval, std::chrono::milliseconds {1});
+		bool aborted = false;
+		auto nextCheck = Clock::now();
+		while (!done()) {
+			if (!aborted && Clock::now() >= nextCheck) {
+				nextCheck = Clock::now() + interval;
+				if (LibraryData::API()->AbortQ() != 0) {
+					aborted = true;
+					pool.cancel();
+				}
+			}
+			std::this_thread::sleep_for(nap);
+		}
+		if (aborted) {
+			pool.resetCancellation();
+			ErrorManager::throwException(ErrorName::Aborted);
+		}
+	}
+
+	/**
+	 * Block the calling thread until all tasks of the \p group finish, cancelling the pool if the user aborts the evaluation.
+	 * @param   pool - thread pool that runs the tasks of the group
+	 * @param   group - group of tasks to wait for
+	 * @param   interval - time between two checks for abort
+	 * @throws  ErrorName::Aborted - if the user aborted the evaluation
+	 * @throws  the first exception thrown by a task from the group, if there was no abort
+	 * @see     waitWithAbortCheck(Pool&, Predicate&&, std::chrono::milliseconds)
+	 */
+	template<typename Pool>
+	void waitWithAbortCheck(Pool& pool, TaskGroup& group, std::chrono::milliseconds interval = defaultAbortCheckInterval) {
+		try {
+			waitWithAbortCheck(pool, [&group] { return group.done(); }, interval);
+		} catch (...) {
+			try {
+				group.wait();
+			} catch (...) {
+				// the abort takes precedence over exceptions from the tasks
+			}
+			throw;
+		}
+		group.wait();
+	}
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_ABORTCHECK_H
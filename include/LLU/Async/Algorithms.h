@@ -0,0 +1,251 @@
+/**
+ * @file	Algorithms.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Data-parallel algorithms (parallel for and parallel reduce) built on top of the thread pools from LLU::Async.
+ */
+#ifndef LLU_ASYNC_ALGORITHMS_H
+#define LLU_ASYNC_ALGORITHMS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "LLU/Async/TaskGroup.h"
+
+namespace LLU::Async {
+
+	namespace Detail {
+		/// Type trait that checks whether T has data() and size() member functions, e.g. IterableContainer or std::vector
+		template<typename T, typename = void>
+		struct has_data_and_size : std::false_type {};
+
+		/// @cond
+		template<typename T>
+		struct has_data_and_size<T, std::void_t<decltype(std::declval<T&>().data()), decltype(std::declval<T&>().size())>> : std::true_type {};
+		/// @endcond
+
+		/// Convenience variable template for has_data_and_size
+		template<typename T>
+		inline constexpr bool has_data_and_size_v = has_data_and_size<T>::value;
+
+		/// Type trait that checks whether the pool supports cooperative cancellation, i.e. has a cancelled() member function
+		template<typename Pool, typename = void>
+		struct is_cancellable : std::false_type {};
+
+		/// @cond
+		template<typename Pool>
+		struct is_cancellable<Pool, std::void_t<decltype(std::declval<const Pool&>().cancelled())>> : std::true_type {};
+		/// @endcond
+
+		/// Throw TaskCancelled if the pool was cancelled, so that the remaining part of the range is not processed
+		template<typename Pool>
+		void throwIfCancelled([[maybe_unused]] const Pool& pool) {
+			if constexpr (is_cancellable<Pool>::value) {
+				if (pool.cancelled()) {
+					throw TaskCancelled {};
+				}
+			}
+		}
+
+		/// Evaluate \p f in the current thread and wait for the \p group, also when \p f throws, so that no task outlives the data it refers to
+		template<typename Pool, typename F>
+		auto runThenWait(Pool& pool, TaskGroup& group, F&& f) {
+			try {
+				if constexpr (std::is_void_v<std::invoke_result_t<F>>) {
+					f();
+					group.wait(pool);
+				} else {
+					auto res = f();
+					group.wait(pool);
+					return res;
+				}
+			} catch (...) {
+				try {
+					group.wait(pool);
+				} catch (...) {
+					// the exception from the current thread takes precedence
+				}
+				throw;
+			}
+		}
+
+		/// Data shared by all tasks spawned by a single call to parallelFor
+		template<typename Pool, typename Index, typename F>
+		struct ForContext {
+			Pool& pool;
+			TaskGroup& group;
+			Index grain;
+			F& body;
+		};
+
+		/**
+		 * Split [first, last) in halves until it is not longer than the grain size, posting the upper halves as new tasks.
+		 * Tasks spawned from a worker land in its local queue, so the halves are either processed by the same worker or stolen
+		 * by the idle ones.
+		 */
+		template<typename Pool, typename Index, typename F>
+		void splitAndRun(const ForContext<Pool, Index, F>& ctx, Index first, Index last) {
+			while (last - first > ctx.grain) {
+				throwIfCancelled(ctx.pool);
+				Index mid = first + (last - first) / 2;
+				ctx.group.run(ctx.pool, [&ctx, mid, last] { splitAndRun(ctx, mid, last); });
+				last = mid;
+			}
+			throwIfCancelled(ctx.pool);
+			for (; first != last; ++first) {
+				ctx.body(first);
+			}
+		}
+
+		/// Data shared by all tasks spawned by a single call to parallelReduce
+		template<typename Pool, typename Index, typename T, typename F, typename C>
+		struct ReduceContext {
+			Pool& pool;
+			Index grain;
+			const T& identity;
+			F& rangeReduce;
+			C& combine;
+		};
+
+		/// Reduce [first, last) by reducing both halves in parallel and combining the results
+		template<typename Pool, typename Index, typename T, typename F, typename C>
+		T reduceRange(const ReduceContext<Pool, Index, T, F, C>& ctx, Index first, Index last) {
+			throwIfCancelled(ctx.pool);
+			if (last - first <= ctx.grain) {
+				return ctx.rangeReduce(first, last, ctx.identity);
+			}
+			Index mid = first + (last - first) / 2;
+			T upper = ctx.identity;
+			TaskGroup group;
+			group.run(ctx.pool, [&ctx, &upper, mid, last] { upper = reduceRange(ctx, mid, last); });
+			T lower = runThenWait(ctx.pool, group, [&] { return reduceRange(ctx, first, mid); });
+			return ctx.combine(std::move(lower), std::move(upper));
+		}
+	}  // namespace Detail
+
+	/**
+	 * @brief   Call \p f for every index in [first, last), distributing the work among threads of the pool.
+	 * @details The range is split recursively into halves until the pieces are not larger than \p grain. Then each piece is processed sequentially
+	 * by a single thread. The calling thread takes part in the computation and the function returns when the whole range has been processed.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  Index - integral type of indices
+	 * @tparam  F - callable that takes a single index
+	 * @param   pool - thread pool to run the tasks
+	 * @param   first - first index of the range
+	 * @param   last - index past the end of the range
+	 * @param   grain - maximal number of indices processed by a single task, should be big enough to amortize the cost of a task
+	 * @param   f - function to be called on each index
+	 * @note    If \p f throws, the first exception is rethrown from parallelFor after all tasks finish. If the pool gets cancelled, the remaining
+	 * pieces are skipped and parallelFor throws Async::TaskCancelled.
+	 */
+	template<typename Pool, typename Index, typename F, typename = std::enable_if_t<std::is_integral_v<Index>>>
+	void parallelFor(Pool& pool, Index first, Index last, typename std::common_type<Index>::type grain, F&& f) {
+		if (last <= first) {
+			return;
+		}
+		TaskGroup group;
+		Detail::ForContext<Pool, Index, std::remove_reference_t<F>> ctx {pool, group, grain > 0 ? grain : Index {1}, f};
+		Detail::runThenWait(pool, group, [&] { Detail::splitAndRun(ctx, first, last); });
+	}
+
+	/**
+	 * @brief   Call \p f on every element of a contiguous container, distributing the work among threads of the pool.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  Container - contiguous container with data() and size(), e.g. Tensor, NumericArray or any other IterableContainer
+	 * @tparam  F - callable that takes a reference to the container element
+	 * @param   pool - thread pool to run the tasks
+	 * @param   c - container
+	 * @param   grain - maximal number of elements processed by a single task
+	 * @param   f - function to be called on each element
+	 */
+	template<typename Pool, typename Container, typename F, typename = std::enable_if_t<Detail::has_data_and_size_v<Container>>>
+	void parallelFor(Pool& pool, Container& c, std::ptrdiff_t grain, F&& f) {
+		// obtain the data pointer once, so that the loop body does not go through IterableContainer's virtual functions
+		auto* data = c.data();
+		parallelFor(pool, std::ptrdiff_t {0}, static_cast<std::ptrdiff_t>(c.size()), grain, [data, &f](std::ptrdiff_t i) { f(data[i]); });
+	}
+
+	/**
+	 * @brief   Assign \p value to every element of a contiguous container, distributing the work among threads of the pool.
+	 * @details Combined with containers created with LLU::Uninitialized, each memory page is first written by the worker that fills it,
+	 * so on NUMA systems pages are placed on the nodes of the threads that later process the same chunks with the same \p grain.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  Container - contiguous container with data() and size(), e.g. Tensor, NumericArray or any other IterableContainer
+	 * @param   pool - thread pool to run the tasks
+	 * @param   c - container
+	 * @param   value - value to be assigned
+	 * @param   grain - number of elements filled by a single task
+	 */
+	template<typename Pool, typename Container, typename T, typename = std::enable_if_t<Detail::has_data_and_size_v<Container>>>
+	void fill(Pool& pool, Container& c, const T& value, std::ptrdiff_t grain) {
+		auto* data = c.data();
+		const auto length = static_cast<std::ptrdiff_t>(c.size());
+		const auto chunk = grain > 0 ? grain : std::ptrdiff_t {1};
+		parallelFor(pool, std::ptrdiff_t {0}, (length + chunk - 1) / chunk, 1, [data, length, chunk, &value](std::ptrdiff_t k) {
+			const auto first = k * chunk;
+			std::fill_n(data + first, std::min(chunk, length - first), value);
+		});
+	}
+
+	/**
+	 * @brief   Reduce the range [first, last) in parallel.
+	 * @details The range is split recursively into halves until the pieces are not larger than \p grain, each piece is reduced sequentially
+	 * with \p rangeReduce and partial results are merged pairwise with \p combine, following the splitting tree. For deterministic \p rangeReduce
+	 * and \p combine the result does not depend on the number of threads or the order in which tasks are executed.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  Index - integral type of indices
+	 * @tparam  T - type of the result
+	 * @tparam  F - callable with signature T(Index first, Index last, const T& init)
+	 * @tparam  C - callable with signature T(T, T)
+	 * @param   pool - thread pool to run the tasks
+	 * @param   first - first index of the range
+	 * @param   last - index past the end of the range
+	 * @param   grain - maximal number of indices processed by a single task
+	 * @param   identity - identity element for \p combine, used as the initial value for every piece
+	 * @param   rangeReduce - function that reduces a subrange starting from given initial value
+	 * @param   combine - function that merges two partial results
+	 * @return  result of the reduction
+	 * @throws  Async::TaskCancelled if the pool was cancelled during the reduction
+	 */
+	template<typename Pool, typename Index, typename T, typename F, typename C, typename = std::enable_if_t<std::is_integral_v<Index>>>
+	T parallelReduce(Pool& pool, Index first, Index last, typename std::common_type<Index>::type grain, T identity, F&& rangeReduce, C&& combine) {
+		if (last <= first) {
+			return identity;
+		}
+		Detail::ReduceContext<Pool, Index, T, std::remove_reference_t<F>, std::remove_reference_t<C>> ctx {pool, grain > 0 ? grain : Index {1}, identity,
+																											rangeReduce, combine};
+		return Detail::reduceRange(ctx, first, last);
+	}
+
+	/**
+	 * @brief   Reduce all elements of a contiguous container in parallel with a binary operation.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  Container - contiguous container with data() and size(), e.g. Tensor, NumericArray or any other IterableContainer
+	 * @tparam  T - type of the result
+	 * @tparam  C - callable with signature T(T, const Container::value_type&) which must also accept two values of type T
+	 * @param   pool - thread pool to run the tasks
+	 * @param   c - container
+	 * @param   grain - maximal number of elements processed by a single task
+	 * @param   identity - identity element for \p combine
+	 * @param   combine - associative operation used to reduce elements and partial results
+	 * @return  result of the reduction
+	 */
+	template<typename Pool, typename Container, typename T, typename C, typename = std::enable_if_t<Detail::has_data_and_size_v<Container>>>
+	T parallelReduce(Pool& pool, const Container& c, std::ptrdiff_t grain, T identity, C&& combine) {
+		const auto* data = c.data();
+		return parallelReduce(
+			pool, std::ptrdiff_t {0}, static_cast<std::ptrdiff_t>(c.size()), grain, std::move(identity),
+			[data, &combine](std::ptrdiff_t first, std::ptrdiff_t last, const T& init) {
+				T acc = init;
+				for (auto i = first; i < last; ++i) {
+					acc = combine(std::move(acc), data[i]);
+				}
+				return acc;
+			},
+			combine);
+	}
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_ALGORITHMS_H
@@ -0,0 +1,181 @@
+/**
+ * @file	BackgroundTask.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Long-running tasks executed in a thread pool that report partial results to the Wolfram Language as asynchronous task events.
+ */
+#ifndef LLU_ASYNC_BACKGROUNDTASK_H
+#define LLU_ASYNC_BACKGROUNDTASK_H
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "LLU/Async/Cancellation.h"
+#include "LLU/Containers/Generic/DataStore.hpp"
+
+namespace LLU::Async {
+
+	namespace Detail {
+		/// State shared by a BackgroundTask running in the pool and by library functions that acknowledge its events or cancel it
+		struct BackgroundTaskState {
+			/// Id of the LibraryLink asynchronous task
+			mint id = 0;
+
+			/// Maximal number of events raised but not acknowledged yet, non-positive means no limit
+			mint maxPendingEvents = 0;
+
+			/// Number of events raised but not acknowledged yet
+			mint pendingEvents = 0;
+
+			/// Guards pendingEvents
+			std::mutex mutex;
+
+			/// Notified when events are acknowledged or the task is cancelled
+			std::condition_variable changed;
+
+			/// Cancellation requested from the library
+			CancellationSource cancellation;
+
+			/// Whether the final event was raised
+			bool finished = false;
+
+			BackgroundTaskState() = default;
+			BackgroundTaskState(const BackgroundTaskState&) = delete;
+			BackgroundTaskState& operator=(const BackgroundTaskState&) = delete;
+			BackgroundTaskState(BackgroundTaskState&&) = delete;
+			BackgroundTaskState& operator=(BackgroundTaskState&&) = delete;
+
+			/// Remove the task from the registry used by BackgroundTask::acknowledge and BackgroundTask::cancel. If the body never ran,
+			/// e.g. because the pool was shut down, the cancelled event is raised.
+			~BackgroundTaskState();
+		};
+	}  // namespace Detail
+
+	/**
+	 * @class   BackgroundTask
+	 * @brief   Handle to a computation that runs in a thread pool and streams results to the Wolfram Language as asynchronous task events.
+	 * @details BackgroundTask::start creates a LibraryLink asynchronous task, posts the body to the pool and returns the id of the task
+	 * immediately, so the library function that started it does not block the kernel. The library function returns this id to
+	 * ``Internal`CreateAsynchronousTask``, whose handler is then called for every event raised by the task with its type and the
+	 * DataList payload.
+	 *
+	 * The body calls emit() to send partial results. To keep a slow front end from being flooded, at most maxPendingEvents events may be
+	 * waiting for acknowledgement; when the limit is reached emit() blocks until the handler calls a library function that invokes
+	 * BackgroundTask::acknowledge. When the body finishes, one of the events finishedEvent, failedEvent or cancelledEvent is raised,
+	 * and it is never subject to the limit.
+	 *
+	 * The body should check cancelled() regularly. A task is cancelled when BackgroundTask::cancel is called with its id or when the task
+	 * was removed in the Wolfram Language, e.g. with RemoveAsynchronousTask.
+	 */
+	class BackgroundTask {
+	public:
+		/// Default limit of events waiting for acknowledgement
+		static constexpr mint defaultMaxPendingEvents = 16;
+
+		/// Type of the event raised when the body returns, the payload is the DataList returned by the body or an empty DataList
+		static constexpr std::string_view finishedEvent = "Finished";
+
+		/// Type of the event raised when the body throws, the payload has "Error" and "Message" nodes with the name and message of the error
+		static constexpr std::string_view failedEvent = "Failed";
+
+		/// Type of the event raised when the body stops with Async::TaskCancelled, the payload is an empty DataList
+		static constexpr std::string_view cancelledEvent = "Cancelled";
+
+		/**
+		 * @brief   Start a background task
+		 * @tparam  Pool - thread pool with a post method, like LLU::ThreadPool, it must outlive the task
+		 * @tparam  F - callable that takes BackgroundTask& and returns void or GenericDataList
+		 * @param   pool - thread pool that will run the body
+		 * @param   body - function that computes the results and sends them with emit()
+		 * @param   maxPendingEvents - maximal number of events waiting for acknowledgement, non-positive values disable the limit
+		 * @return  id of the LibraryLink asynchronous task, to be returned to ``Internal`CreateAsynchronousTask``
+		 * @throws  ErrorName::AsyncTaskCreateError - if LibraryLink could not create the asynchronous task
+		 * @note    The body occupies a worker of the pool for its whole duration, also when it waits in emit().
+		 */
+		template<class Pool, typename F>
+		static mint start(Pool& pool, F&& body, mint maxPendingEvents = defaultMaxPendingEvents) {
+			BackgroundTask task {create(maxPendingEvents)};
+			const auto id = task.id();
+			pool.post([task = std::move(task), body = std::forward<F>(body)]() mutable {
+				try {
+					if constexpr (std::is_void_v<std::invoke_result_t<F&, BackgroundTask&>>) {
+						body(task);
+						task.finish(GenericDataList {});
+					} else {
+						task.finish(body(task));
+					}
+				} catch (...) {
+					task.fail(std::current_exception());
+				}
+			});
+			return id;
+		}
+
+		/**
+		 * @brief   Acknowledge events of a task, allowing it to raise more events
+		 * @param   id - id of the task
+		 * @param   count - number of events that were processed
+		 * @return  true iff a running task with given id was found
+		 */
+		static bool acknowledge(mint id, mint count = 1);
+
+		/**
+		 * @brief   Request cancellation of a task, the task stops when it next checks cancelled() or calls emit()
+		 * @param   id - id of the task
+		 * @return  true iff a running task with given id was found
+		 */
+		static bool cancel(mint id);
+
+		/// Get the id of the LibraryLink asynchronous task
+		[[nodiscard]] mint id() const noexcept {
+			return state->id;
+		}
+
+		/// Check whether the task should stop, either because it was cancelled with BackgroundTask::cancel or removed in the Wolfram Language
+		[[nodiscard]] bool cancelled() const;
+
+		/// Throw Async::TaskCancelled if the task should stop
+		void throwIfCancelled() const {
+			if (cancelled()) {
+				throw TaskCancelled {};
+			}
+		}
+
+		/// Get a token that observes cancellation requests made with BackgroundTask::cancel, e.g. to pass to other tasks
+		[[nodiscard]] CancellationToken token() const {
+			return state->cancellation.token();
+		}
+
+		/**
+		 * @brief   Send a partial result to the Wolfram Language
+		 * @param   eventType - type of the event passed to the handler
+		 * @param   payload - data of the event, the Wolfram Language takes it over, DataLists not owned by the library are copied first
+		 * @throws  Async::TaskCancelled - if the task was cancelled, possibly while waiting for acknowledgements
+		 */
+		void emit(std::string eventType, GenericDataList payload);
+
+	private:
+		explicit BackgroundTask(std::shared_ptr<Detail::BackgroundTaskState> s) noexcept : state(std::move(s)) {}
+
+		/// Create a new LibraryLink asynchronous task and register it
+		static std::shared_ptr<Detail::BackgroundTaskState> create(mint maxPendingEvents);
+
+		/// Raise the finishedEvent with given payload
+		void finish(GenericDataList result) noexcept;
+
+		/// Raise the failedEvent or, for Async::TaskCancelled, the cancelledEvent
+		void fail(const std::exception_ptr& error) noexcept;
+
+		/// Raise an event without waiting for acknowledgements, unless the task is no longer alive in the Wolfram Language
+		void raise(std::string eventType, GenericDataList payload) const;
+
+		std::shared_ptr<Detail::BackgroundTaskState> state;
+	};
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_BACKGROUNDTASK_H
@@ -0,0 +1,248 @@
+/**
+ * @file	BoundedQueue.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Definition and implementation of a bounded multi-producer multi-consumer queue based on a ring buffer of sequence-numbered slots.
+ * @see     D. Vyukov "Bounded MPMC queue", https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ */
+#ifndef LLU_ASYNC_BOUNDEDQUEUE_H
+#define LLU_ASYNC_BOUNDEDQUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+namespace LLU::Async {
+
+	/// Behavior of a BoundedQueue when a new element is pushed to a queue that is already full
+	enum class FullQueuePolicy {
+		Block,	   //!< push waits on a condition variable until some element is popped
+		Spin,	   //!< push busy-waits (yielding the thread) until some element is popped
+		Reject	   //!< push returns immediately without adding the element and reports failure
+	};
+	/// @note   When a thread pool submits a task to a queue with FullQueuePolicy::Reject and the task is rejected, the std::future returned from submit
+	///         will throw std::future_error with error code broken_promise on get().
+
+	/**
+	 * @brief   Fixed-capacity, thread-safe MPMC queue that does not allocate any memory after construction.
+	 * @details Each slot in the ring buffer carries a sequence number which tells producers and consumers whether the slot is ready to be written
+	 * or read in the current lap. Enqueue and dequeue each take a single CAS on the shared position counter, there are no locks on the fast path.
+	 * A mutex and condition variables are only used to park threads that wait for data in waitPop or for free space when Policy is Block.
+	 *
+	 * BoundedQueue implements the same push/tryPop/waitPop/empty contract as ThreadsafeQueue, so it can be used as a queue for BasicThreadPool
+	 * and as the pool queue of GenericThreadPool.
+	 *
+	 * @tparam  T - type of the data stored in the queue, must be nothrow move constructible
+	 * @tparam  Capacity - maximal number of elements in the queue, must be a power of 2
+	 * @tparam  Policy - what to do when pushing to a full queue
+	 */
+	template<typename T, std::size_t Capacity = 1024, FullQueuePolicy Policy = FullQueuePolicy::Block>
+	class BoundedQueue {
+		static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "BoundedQueue capacity must be a power of 2.");
+		static_assert(std::is_nothrow_move_constructible_v<T>, "BoundedQueue requires nothrow move constructible elements.");
+
+	public:
+		/// Value type of queue elements
+		using value_type = T;
+
+	public:
+		/**
+		 * @brief   Create new empty queue. This is the only place where BoundedQueue allocates memory.
+		 */
+		BoundedQueue() : cells(std::make_unique<Cell[]>(Capacity)) {
+			for (std::size_t i = 0; i < Capacity; ++i) {
+				cells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		BoundedQueue(const BoundedQueue&) = delete;
+		BoundedQueue& operator=(const BoundedQueue&) = delete;
+		BoundedQueue(BoundedQueue&&) = delete;
+		BoundedQueue& operator=(BoundedQueue&&) = delete;
+
+		/// Destroy all elements that remain in the queue
+		~BoundedQueue() {
+			for (auto pos = dequeuePos.load(); pos != enqueuePos.load(); ++pos) {
+				cells[pos & (Capacity - 1)].get()->~T();
+			}
+		}
+
+		/**
+		 * @brief   Push new value to the end of the queue, handling full queue according to the Policy.
+		 * @param   new_value - value to be pushed to the queue
+		 * @return  True iff the value was added to the queue, which is always the case unless Policy is Reject.
+		 */
+		bool push(value_type new_value) {
+			if constexpr (Policy == FullQueuePolicy::Reject) {
+				if (!tryEnqueue(new_value)) {
+					return false;
+				}
+			} else {
+				while (!tryEnqueue(new_value)) {
+					if constexpr (Policy == FullQueuePolicy::Block) {
+						std::unique_lock<std::mutex> lock(waitMutex);
+						waitingProducers.fetch_add(1);
+						notFull.wait(lock, [this] { return !full(); });
+						waitingProducers.fetch_sub(1);
+					} else {
+						std::this_thread::yield();
+					}
+				}
+			}
+			notify(waitingConsumers, notEmpty);
+			return true;
+		}
+
+		/**
+		 * @brief   Push new value to the end of the queue if there is room for it, regardless of the Policy.
+		 * @param   new_value - value to be pushed to the queue, it is left untouched if the queue is full
+		 * @return  True iff the value was added to the queue.
+		 */
+		bool tryPush(value_type& new_value) {
+			if (!tryEnqueue(new_value)) {
+				return false;
+			}
+			notify(waitingConsumers, notEmpty);
+			return true;
+		}
+
+		/**
+		 * @brief       Get data from the queue if available.
+		 * If data is not available in the queue, the calling thread will not wait.
+		 * @param[out]  value - reference to the data from the queue
+		 * @return      True iff there was data in the queue, otherwise the out-parameter remains unchanged.
+		 */
+		bool tryPop(value_type& value) {
+			if (!tryDequeue(value)) {
+				return false;
+			}
+			if constexpr (Policy == FullQueuePolicy::Block) {
+				notify(waitingProducers, notFull);
+			}
+			return true;
+		}
+
+		/**
+		 * @brief   Get data from the queue, possibly waiting for it.
+		 * @param   value - reference to the data from the queue
+		 */
+		void waitPop(value_type& value) {
+			while (!tryPop(value)) {
+				std::unique_lock<std::mutex> lock(waitMutex);
+				waitingConsumers.fetch_add(1);
+				notEmpty.wait(lock, [this] { return !empty(); });
+				waitingConsumers.fetch_sub(1);
+			}
+		}
+
+		/**
+		 * @brief   Check if the queue is empty.
+		 * @return  True iff the queue is empty i.e. has no data to be popped.
+		 */
+		[[nodiscard]] bool empty() const {
+			auto consumed = dequeuePos.load();
+			return enqueuePos.load() == consumed;
+		}
+
+		/**
+		 * @brief   Check if the queue is full.
+		 * @return  True iff the queue is full i.e. new element cannot be pushed without waiting.
+		 */
+		[[nodiscard]] bool full() const {
+			// read the consumer position first, so that the difference cannot underflow
+			auto consumed = dequeuePos.load();
+			return enqueuePos.load() - consumed >= Capacity;
+		}
+
+		/// Get the maximal number of elements the queue can hold
+		[[nodiscard]] static constexpr std::size_t capacity() noexcept {
+			return Capacity;
+		}
+
+	private:
+		/// Single slot of the ring buffer with raw storage for one element and a sequence number
+		struct Cell {
+			std::atomic<std::size_t> sequence = 0;
+			alignas(T) std::byte storage[sizeof(T)];
+
+			T* get() noexcept {
+				return std::launder(reinterpret_cast<T*>(&storage));
+			}
+		};
+
+		/// Assumed size of the cache line, used to keep producer and consumer positions from false sharing
+		static constexpr std::size_t cacheLineSize = 64;
+
+		std::unique_ptr<Cell[]> cells;
+		alignas(cacheLineSize) std::atomic<std::size_t> enqueuePos = 0;
+		alignas(cacheLineSize) std::atomic<std::size_t> dequeuePos = 0;
+
+		alignas(cacheLineSize) std::atomic<int> waitingConsumers = 0;
+		std::atomic<int> waitingProducers = 0;
+		std::mutex waitMutex;
+		std::condition_variable notEmpty;
+		std::condition_variable notFull;
+
+		bool tryEnqueue(value_type& value) {
+			Cell* cell = nullptr;
+			auto pos = enqueuePos.load(std::memory_order_relaxed);
+			while (true) {
+				cell = &cells[pos & (Capacity - 1)];
+				auto seq = cell->sequence.load(std::memory_order_acquire);
+				auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+				if (diff == 0) {
+					if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+						break;
+					}
+				} else if (diff < 0) {
+					return false;
+				} else {
+					pos = enqueuePos.load(std::memory_order_relaxed);
+				}
+			}
+			new (&cell->storage) T(std::move(value));
+			cell->sequence.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool tryDequeue(value_type& value) {
+			Cell* cell = nullptr;
+			auto pos = dequeuePos.load(std::memory_order_relaxed);
+			while (true) {
+				cell = &cells[pos & (Capacity - 1)];
+				auto seq = cell->sequence.load(std::memory_order_acquire);
+				auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+				if (diff == 0) {
+					if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+						break;
+					}
+				} else if (diff < 0) {
+					return false;
+				} else {
+					pos = dequeuePos.load(std::memory_order_relaxed);
+				}
+			}
+			value = std::move(*cell->get());
+			cell->get()->~T();
+			cell->sequence.store(pos + Capacity, std::memory_order_release);
+			return true;
+		}
+
+		/// Wake up one waiting thread, the mutex is only touched if somebody is actually waiting
+		void notify(const std::atomic<int>& waiting, std::condition_variable& cond) {
+			// pairs with the increment of the waiting counter, so that either the waiter sees the new state or we see the waiter
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (waiting.load() > 0) {
+				std::lock_guard<std::mutex> lock(waitMutex);
+				cond.notify_one();
+			}
+		}
+	};
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_BOUNDEDQUEUE_H
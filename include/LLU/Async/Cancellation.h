@@ -0,0 +1,111 @@
+/**
+ * @file	Cancellation.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Cooperative cancellation of tasks running in thread pools.
+ */
+#ifndef LLU_ASYNC_CANCELLATION_H
+#define LLU_ASYNC_CANCELLATION_H
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+
+namespace LLU::Async {
+
+	/// Exception thrown from tasks that noticed a cancellation request, and stored in futures and task groups of tasks that were discarded
+	struct TaskCancelled : std::exception {
+		/// Get the description of the exception
+		[[nodiscard]] const char* what() const noexcept override {
+			return "Task was cancelled.";
+		}
+	};
+
+	namespace Detail {
+		/// State shared by a CancellationSource and all tokens created from it
+		struct CancellationState {
+			std::atomic<std::uint64_t> epoch = 0;
+			std::atomic_bool cancelled = false;
+		};
+	}  // namespace Detail
+
+	/**
+	 * @class   CancellationToken
+	 * @brief   Lightweight handle which tasks use to check whether they should stop early.
+	 * @details A token is cheap to copy and stays valid after the source is destroyed. Once a token observes a cancellation, it stays cancelled
+	 * even if the source is reset afterwards; tokens obtained after the reset are not cancelled.
+	 */
+	class CancellationToken {
+	public:
+		/// Create a token that will never be cancelled
+		CancellationToken() = default;
+
+		/**
+		 * Check if cancellation was requested. This is a single atomic load, so it can be called often, e.g. in every iteration of a loop.
+		 * @return true iff the task should stop
+		 */
+		[[nodiscard]] bool cancelled() const noexcept {
+			return state && (state->cancelled.load(std::memory_order_acquire) || state->epoch.load(std::memory_order_acquire) != epoch);
+		}
+
+		/// Throw TaskCancelled if cancellation was requested
+		void throwIfCancelled() const {
+			if (cancelled()) {
+				throw TaskCancelled {};
+			}
+		}
+
+	private:
+		friend class CancellationSource;
+
+		std::shared_ptr<const Detail::CancellationState> state;
+		std::uint64_t epoch = 0;
+
+		CancellationToken(std::shared_ptr<const Detail::CancellationState> s, std::uint64_t e) : state(std::move(s)), epoch(e) {}
+	};
+
+	/**
+	 * @class   CancellationSource
+	 * @brief   Owner of the cancellation flag, hands out tokens and requests cancellation.
+	 */
+	class CancellationSource {
+	public:
+		/// Create a source in the non-cancelled state
+		CancellationSource() : state(std::make_shared<Detail::CancellationState>()) {}
+
+		/**
+		 * Get a token which observes this source
+		 * @return new token
+		 */
+		[[nodiscard]] CancellationToken token() const {
+			return CancellationToken {state, state->epoch.load(std::memory_order_acquire)};
+		}
+
+		/// Request cancellation, all tokens obtained so far become cancelled
+		void cancel() noexcept {
+			state->cancelled.store(true, std::memory_order_release);
+		}
+
+		/**
+		 * Check if cancellation was requested since the last reset
+		 * @return true iff cancel was called and reset was not called afterwards
+		 */
+		[[nodiscard]] bool cancelled() const noexcept {
+			return state->cancelled.load(std::memory_order_acquire);
+		}
+
+		/// Return to the non-cancelled state, tokens obtained before the reset remain cancelled. Does nothing if cancellation was not requested.
+		void reset() noexcept {
+			if (state->cancelled.load(std::memory_order_acquire)) {
+				state->epoch.fetch_add(1, std::memory_order_acq_rel);
+				state->cancelled.store(false, std::memory_order_release);
+			}
+		}
+
+	private:
+		std::shared_ptr<Detail::CancellationState> state;
+	};
+
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_CANCELLATION_H
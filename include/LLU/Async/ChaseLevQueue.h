@@ -0,0 +1,225 @@
+/**
+ * @file	ChaseLevQueue.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Definition and implementation of a lock-free work stealing deque based on the Chase-Lev algorithm.
+ * @see     N. M. Lê, A. Pop, A. Cohen, F. Zappa Nardelli "Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013
+ */
+#ifndef LLU_ASYNC_CHASELEVQUEUE_H
+#define LLU_ASYNC_CHASELEVQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+namespace LLU::Async {
+
+	/**
+	 * @brief   Lock-free work stealing deque with the same interface as WorkStealingQueue.
+	 * @details The owner thread pushes and pops tasks at the bottom of a fixed-size ring buffer and other threads steal from the top.
+	 * On the fast path the owner performs only plain atomic loads and stores; the only read-modify-write operations are the CAS executed by thieves
+	 * and the CAS the owner needs when it races with thieves for the very last element.
+	 *
+	 * Classic Chase-Lev deque grows by copying elements into a bigger buffer, which cannot be done for move-only types like FunctionWrapper
+	 * while thieves may be moving out of the old buffer. Instead, when the ring buffer is full new elements go to a small mutex-protected
+	 * overflow deque, which is only touched when the ring is saturated.
+	 *
+	 * @tparam  T - type of the data stored in the queue, must be nothrow move constructible
+	 * @tparam  Capacity - number of slots in the ring buffer, must be a power of 2
+	 */
+	template<typename T, std::size_t Capacity = 1024>
+	class ChaseLevQueue {
+		static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "ChaseLevQueue capacity must be a power of 2.");
+		static_assert(std::is_nothrow_move_constructible_v<T>, "ChaseLevQueue requires nothrow move constructible elements.");
+
+	public:
+		/// Value type of queue elements
+		using value_type = T;
+
+	public:
+		ChaseLevQueue() = default;
+		ChaseLevQueue(const ChaseLevQueue&) = delete;
+		ChaseLevQueue& operator=(const ChaseLevQueue&) = delete;
+		ChaseLevQueue(ChaseLevQueue&&) = delete;
+		ChaseLevQueue& operator=(ChaseLevQueue&&) = delete;
+
+		/// Destroy all elements that remain in the queue
+		~ChaseLevQueue() {
+			auto t = top.load(std::memory_order_relaxed);
+			auto b = bottom.load(std::memory_order_relaxed);
+			for (; t < b; ++t) {
+				slotAt(t).destroy();
+			}
+		}
+
+		/**
+		 * Push new element to the bottom of the queue. Must only be called by the owner thread.
+		 * @param data - new element
+		 */
+		void push(value_type data) {
+			auto b = bottom.load(std::memory_order_relaxed);
+			auto t = top.load(std::memory_order_acquire);
+			if (b - t >= static_cast<std::int64_t>(Capacity)) {
+				pushOverflow(std::move(data));
+				return;
+			}
+			auto& slot = slotAt(b);
+			// a thief that won this slot in a previous round may still be moving the element out of it
+			while (!slot.vacant.load(std::memory_order_acquire)) {
+				std::this_thread::yield();
+			}
+			slot.construct(std::move(data));
+			slot.vacant.store(false, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			bottom.store(b + 1, std::memory_order_relaxed);
+		}
+
+		/**
+		 * Check if the queue is empty. The result is only a snapshot and may be outdated immediately if other threads access the queue.
+		 * @return true iff the queue is empty
+		 */
+		[[nodiscard]] bool empty() const {
+			auto t = top.load(std::memory_order_acquire);
+			auto b = bottom.load(std::memory_order_acquire);
+			return b <= t && overflowSize.load(std::memory_order_acquire) == 0;
+		}
+
+		/**
+		 * Get the approximate number of elements in the queue. Like empty(), the result is only a snapshot.
+		 * @return number of elements in the queue at some point during the call
+		 */
+		[[nodiscard]] std::size_t size() const {
+			auto t = top.load(std::memory_order_acquire);
+			auto b = bottom.load(std::memory_order_acquire);
+			return static_cast<std::size_t>(b > t ? b - t : 0) + overflowSize.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * Try to pop a task from the bottom of the queue in a non-blocking way. Must only be called by the owner thread.
+		 * @param[out] res - reference to which the new task should be assigned
+		 * @return  true iff the queue was not empty and a task was popped
+		 */
+		[[nodiscard]] bool tryPop(value_type& res) {
+			auto b = bottom.load(std::memory_order_relaxed) - 1;
+			bottom.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			auto t = top.load(std::memory_order_relaxed);
+			if (t > b) {
+				bottom.store(b + 1, std::memory_order_relaxed);
+				return popOverflowFront(res);
+			}
+			if (t == b) {
+				// the last element in the ring, race against thieves for it
+				bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+				bottom.store(b + 1, std::memory_order_relaxed);
+				if (!won) {
+					return popOverflowFront(res);
+				}
+			}
+			slotAt(b).moveOut(res);
+			return true;
+		}
+
+		/**
+		 * Try to pop a task from the top of the queue (this is what we call "stealing") in a non-blocking way. Can be called by any thread.
+		 * @param[out] res - reference to which the new task should be assigned
+		 * @return  true iff the queue was not empty and a task was popped
+		 */
+		[[nodiscard]] bool trySteal(value_type& res) {
+			auto t = top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			auto b = bottom.load(std::memory_order_acquire);
+			if (t < b) {
+				if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+					// lost the race with another thief or the owner, let the caller try another victim
+					return false;
+				}
+				slotAt(t).moveOut(res);
+				return true;
+			}
+			return popOverflowBack(res);
+		}
+
+	private:
+		/// Single cell of the ring buffer with raw storage for one element
+		struct Slot {
+			std::atomic_bool vacant = true;
+			alignas(T) std::byte storage[sizeof(T)];
+
+			T* get() noexcept {
+				return std::launder(reinterpret_cast<T*>(&storage));
+			}
+
+			void construct(T&& data) noexcept {
+				new (&storage) T(std::move(data));
+			}
+
+			void destroy() noexcept {
+				get()->~T();
+				vacant.store(true, std::memory_order_release);
+			}
+
+			void moveOut(T& res) {
+				res = std::move(*get());
+				destroy();
+			}
+		};
+
+		/// Assumed size of the cache line, used to keep top and bottom indices from false sharing
+		static constexpr std::size_t cacheLineSize = 64;
+
+		alignas(cacheLineSize) std::atomic<std::int64_t> top = 0;
+		alignas(cacheLineSize) std::atomic<std::int64_t> bottom = 0;
+		alignas(cacheLineSize) std::array<Slot, Capacity> ring {};
+
+		std::atomic<std::size_t> overflowSize = 0;
+		std::mutex overflowMutex;
+		std::deque<T> overflow;
+
+		Slot& slotAt(std::int64_t index) noexcept {
+			return ring[static_cast<std::size_t>(index) & (Capacity - 1)];
+		}
+
+		void pushOverflow(value_type&& data) {
+			std::lock_guard<std::mutex> lock(overflowMutex);
+			overflow.push_front(std::move(data));
+			overflowSize.store(overflow.size(), std::memory_order_release);
+		}
+
+		bool popOverflowFront(value_type& res) {
+			if (overflowSize.load(std::memory_order_acquire) == 0) {
+				return false;
+			}
+			std::lock_guard<std::mutex> lock(overflowMutex);
+			if (overflow.empty()) {
+				return false;
+			}
+			res = std::move(overflow.front());
+			overflow.pop_front();
+			overflowSize.store(overflow.size(), std::memory_order_release);
+			return true;
+		}
+
+		bool popOverflowBack(value_type& res) {
+			if (overflowSize.load(std::memory_order_acquire) == 0) {
+				return false;
+			}
+			std::lock_guard<std::mutex> lock(overflowMutex);
+			if (overflow.empty()) {
+				return false;
+			}
+			res = std::move(overflow.back());
+			overflow.pop_back();
+			overflowSize.store(overflow.size(), std::memory_order_release);
+			return true;
+		}
+	};
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_CHASELEVQUEUE_H
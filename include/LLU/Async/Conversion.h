@@ -0,0 +1,114 @@
+/**
+ * @file	Conversion.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Conversion of NumericArrays between data types and of Images between layouts, distributed among threads of a pool from LLU::Async.
+ */
+#ifndef LLU_ASYNC_CONVERSION_H
+#define LLU_ASYNC_CONVERSION_H
+
+#include <algorithm>
+
+#include "LLU/Async/Algorithms.h"
+#include "LLU/Containers/Conversion.hpp"
+#include "LLU/Containers/Interleaving.hpp"
+#include "LLU/Containers/NumericArray.h"
+#include "LLU/Containers/Views/NumericArray.hpp"
+
+namespace LLU::Async {
+
+	/// Default number of elements converted by a single task in convertNumericArray
+	inline constexpr mint defaultConversionGrain = 1 << 16;
+
+	/// Default number of pixels moved by a single task in deinterleave and interleave
+	inline constexpr mint defaultInterleavingGrain = 1 << 14;
+
+	/**
+	 * @brief   Check if convertNumericArray converts from T to U natively, i.e. without calling MNumericArray_convertType
+	 * @details All pairs of integer and real types are converted natively, conversions from or to complex types are left to LibraryLink.
+	 */
+	template<typename U, typename T>
+	inline constexpr bool is_native_conversion_v = !NA::Detail::is_complex_v<U> && !NA::Detail::is_complex_v<T>;
+
+	/**
+	 * @brief   Convert a NumericArray of any type to NumericArray<U>, distributing the work among threads of the pool.
+	 *
+	 * The data is split into contiguous chunks of \p grain elements and each chunk is converted with NA::convertRange. LibraryLink's
+	 * MNumericArray_convertType is only used for the pairs of types for which is_native_conversion_v is false.
+	 *
+	 * @tparam  U - target type
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @param   pool - thread pool to run the tasks
+	 * @param   na - NumericArray to be converted
+	 * @param   method - conversion method
+	 * @param   tolerance - tolerance used by the Check method
+	 * @param   grain - number of elements converted by a single task
+	 * @return  new NumericArray with converted data
+	 * @throws  ErrorName::NumericArrayConversionError - if any element cannot be converted to U with given method
+	 * @see     NA::convertValue for the semantics of each conversion method
+	 */
+	template<typename U, typename Pool>
+	NumericArray<U> convertNumericArray(Pool& pool, const GenericNumericArray& na, NA::ConversionMethod method, double tolerance = 0.0,
+										mint grain = defaultConversionGrain) {
+		return asTypedNumericArray(NumericArrayView {na}, [&](auto&& typedNA) {
+			using T = typename std::remove_reference_t<decltype(typedNA)>::value_type;
+			if constexpr (is_native_conversion_v<U, T>) {
+				NumericArray<U> result {GenericNumericArray {NumericArrayType<U>, typedNA.getRank(), typedNA.getDimensions()}};
+				const T* in = typedNA.data();
+				U* out = result.data();
+				const mint length = typedNA.size();
+				const mint chunk = std::max(grain, mint {1});
+				parallelFor(pool, mint {0}, (length + chunk - 1) / chunk, 1, [=](mint k) {
+					const mint first = k * chunk;
+					NA::convertRange(in + first, out + first, std::min(chunk, length - first), method, tolerance);
+				});
+				return result;
+			} else {
+				return NumericArray<U> {na, method, tolerance};
+			}
+		});
+	}
+
+	/**
+	 * @brief   Copy an interleaved image to a planar image of the same shape and type, distributing the work among threads of the pool.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @param   pool - thread pool to run the tasks
+	 * @param   src - interleaved Image<T> or ImageTypedView<T>
+	 * @param   dst - planar Image<T> or ImageTypedView<T>, allocated by the caller
+	 * @param   grain - number of pixels moved by a single task
+	 * @throws  see LLU::deinterleave
+	 */
+	template<typename Pool, class ImageIn, class ImageOut>
+	void deinterleave(Pool& pool, const ImageIn& src, ImageOut& dst, mint grain = defaultInterleavingGrain) {
+		const auto planeSize = LLU::Detail::checkLayoutTransform(src, dst, true);
+		const auto channels = src.channels();
+		const auto* in = src.data();
+		auto* out = dst.data();
+		const mint chunk = std::max(grain, mint {1});
+		parallelFor(pool, mint {0}, (planeSize + chunk - 1) / chunk, 1, [=](mint k) {
+			deinterleaveRange(in, out, planeSize, channels, k * chunk, std::min(planeSize, (k + 1) * chunk));
+		});
+	}
+
+	/**
+	 * @brief   Copy a planar image to an interleaved image of the same shape and type, distributing the work among threads of the pool.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @param   pool - thread pool to run the tasks
+	 * @param   src - planar Image<T> or ImageTypedView<T>
+	 * @param   dst - interleaved Image<T> or ImageTypedView<T>, allocated by the caller
+	 * @param   grain - number of pixels moved by a single task
+	 * @throws  see LLU::interleave
+	 */
+	template<typename Pool, class ImageIn, class ImageOut>
+	void interleave(Pool& pool, const ImageIn& src, ImageOut& dst, mint grain = defaultInterleavingGrain) {
+		const auto planeSize = LLU::Detail::checkLayoutTransform(src, dst, false);
+		const auto channels = src.channels();
+		const auto* in = src.data();
+		auto* out = dst.data();
+		const mint chunk = std::max(grain, mint {1});
+		parallelFor(pool, mint {0}, (planeSize + chunk - 1) / chunk, 1, [=](mint k) {
+			interleaveRange(in, out, planeSize, channels, k * chunk, std::min(planeSize, (k + 1) * chunk));
+		});
+	}
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_CONVERSION_H
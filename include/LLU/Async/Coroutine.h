@@ -0,0 +1,347 @@
+/**
+ * @file	Coroutine.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   C++20 coroutine tasks for thread pools from LLU::Async, which suspend instead of occupying a worker while they wait.
+ *
+ * This header is opt-in: it needs a compiler with C++20 coroutine support, without it only Async::coroutinesEnabled is defined (and false).
+ * A coroutine returning Async::Task<T> can:
+ *  - move itself to a worker thread with <tt>co_await pool.schedule()</tt>,
+ *  - await another Task, which runs it inline in the awaiting coroutine,
+ *  - await an Async::Future, e.g. of a subtask started with Async::spawn(pool, task), without blocking the worker.
+ *
+ * @code
+ *  template<typename Pool>
+ *  Async::Task<mint> fib(Pool& pool, mint n) {
+ *      if (n < 2) {
+ *          co_return n;
+ *      }
+ *      auto a = Async::spawn(pool, fib(pool, n - 1));    // runs in parallel, possibly stolen by another worker
+ *      auto b = co_await fib(pool, n - 2);               // runs inline
+ *      co_return co_await std::move(a) + b;             // suspends until the subtask is done
+ *  }
+ *
+ *  mint result = Async::spawn(pool, fib(pool, 30)).get();
+ * @endcode
+ */
+#ifndef LLU_ASYNC_COROUTINE_H
+#define LLU_ASYNC_COROUTINE_H
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define LLU_ASYNC_COROUTINES
+#endif
+#endif
+
+#include <exception>
+#include <future>
+#include <optional>
+#include <utility>
+
+#ifdef LLU_ASYNC_COROUTINES
+#include <coroutine>
+#endif
+
+#include "LLU/Async/Future.h"
+
+namespace LLU::Async {
+
+#ifdef LLU_ASYNC_COROUTINES
+	/// True iff the compiler supports coroutines and Async::Task is available
+	inline constexpr bool coroutinesEnabled = true;
+#else
+	/// True iff the compiler supports coroutines and Async::Task is available
+	inline constexpr bool coroutinesEnabled = false;
+#endif
+
+}  // namespace LLU::Async
+
+#ifdef LLU_ASYNC_COROUTINES
+
+namespace LLU::Async {
+
+	template<typename T = void>
+	class Task;
+
+	namespace Detail {
+		/// Final suspension point of a Task, transfers control to the coroutine that awaits the Task, if any
+		struct FinalAwaiter {
+			[[nodiscard]] bool await_ready() const noexcept {
+				return false;
+			}
+
+			template<typename Promise>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) const noexcept {
+				auto next = h.promise().continuation;
+				return next ? next : std::noop_coroutine();
+			}
+
+			void await_resume() const noexcept {}
+		};
+
+		/// Part of the promise of a Task that does not depend on the type of the result
+		class TaskPromiseBase {
+		public:
+			/// Tasks are lazy, they start when awaited
+			[[nodiscard]] std::suspend_always initial_suspend() const noexcept {
+				return {};
+			}
+
+			[[nodiscard]] FinalAwaiter final_suspend() const noexcept {
+				return {};
+			}
+
+			void unhandled_exception() noexcept {
+				exception = std::current_exception();
+			}
+
+			/// Coroutine which awaits the Task and is resumed when it finishes
+			std::coroutine_handle<> continuation;
+
+		protected:
+			void rethrowIfFailed() const {
+				if (exception) {
+					std::rethrow_exception(exception);
+				}
+			}
+
+		private:
+			std::exception_ptr exception;
+		};
+
+		/// Promise of a Task with a result of type T
+		template<typename T>
+		class TaskPromise : public TaskPromiseBase {
+		public:
+			Task<T> get_return_object() noexcept;
+
+			template<typename U>
+			void return_value(U&& v) {
+				value.emplace(std::forward<U>(v));
+			}
+
+			/// Get the result of the finished Task or rethrow its exception
+			T result() {
+				rethrowIfFailed();
+				return std::move(*value);
+			}
+
+		private:
+			std::optional<T> value;
+		};
+
+		/// Promise of a Task without a result
+		template<>
+		class TaskPromise<void> : public TaskPromiseBase {
+		public:
+			Task<void> get_return_object() noexcept;
+
+			void return_void() noexcept {}
+
+			/// Rethrow the exception of the finished Task, if any
+			void result() {
+				rethrowIfFailed();
+			}
+		};
+
+		/// Awaiter of an Async::Future, the awaiting coroutine is resumed by the thread that makes the future ready
+		template<typename T>
+		class FutureAwaiter {
+		public:
+			explicit FutureAwaiter(Future<T>&& f) noexcept : future(std::move(f)) {}
+
+			[[nodiscard]] bool await_ready() const {
+				return future.ready();
+			}
+
+			void await_suspend(std::coroutine_handle<> h) {
+				// the coroutine may be resumed, and this awaiter destroyed, before onReady returns, so no member is accessed afterwards
+				future.onReady([h]() mutable { h.resume(); });
+			}
+
+			T await_resume() {
+				return future.get();
+			}
+
+		private:
+			Future<T> future;
+		};
+
+		/// Coroutine type that starts immediately and destroys itself when it finishes, used to run Tasks in a pool
+		struct DetachedCoroutine {
+			struct promise_type {
+				DetachedCoroutine get_return_object() const noexcept {
+					return {};
+				}
+
+				[[nodiscard]] std::suspend_never initial_suspend() const noexcept {
+					return {};
+				}
+
+				[[nodiscard]] std::suspend_never final_suspend() const noexcept {
+					return {};
+				}
+
+				void return_void() const noexcept {}
+
+				/// Exceptions are passed to the Promise in runInPool, nothing else can throw
+				void unhandled_exception() const noexcept {
+					std::terminate();
+				}
+			};
+		};
+
+		/// Resume in a worker thread of the pool, await the Task there and fulfill the promise with its result
+		template<typename Pool, typename T>
+		DetachedCoroutine runInPool(Pool& pool, Task<T> task, Promise<T> promise) {
+			try {
+				co_await pool.schedule();
+				if constexpr (std::is_void_v<T>) {
+					co_await std::move(task);
+					promise.setValue();
+				} else {
+					promise.setValue(co_await std::move(task));
+				}
+			} catch (...) {
+				promise.setException(std::current_exception());
+			}
+		}
+	}  // namespace Detail
+
+	/**
+	 * @class   Task
+	 * @brief   Lazy coroutine with a result of type T.
+	 * @details A Task starts when it is awaited, in the thread of the awaiting coroutine, and resumes that coroutine when it finishes, without
+	 * going through the queues of the pool. Use Async::spawn to run a Task in a pool concurrently with the caller. A Task can be awaited once.
+	 * Exceptions thrown in the Task are rethrown in the awaiting coroutine.
+	 * @tparam  T - type of the result
+	 */
+	template<typename T>
+	class [[nodiscard]] Task {
+	public:
+		/// Promise type of the coroutine
+		using promise_type = Detail::TaskPromise<T>;
+
+		/// Type of the result
+		using value_type = T;
+
+	public:
+		/// Create an invalid Task
+		Task() = default;
+
+		Task(const Task&) = delete;
+		Task& operator=(const Task&) = delete;
+
+		Task(Task&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+
+		Task& operator=(Task&& other) noexcept {
+			if (this != &other) {
+				destroy();
+				handle = std::exchange(other.handle, {});
+			}
+			return *this;
+		}
+
+		/// Destroy the coroutine frame, a Task must not be destroyed while it runs
+		~Task() {
+			destroy();
+		}
+
+		/// Check if the Task refers to a coroutine
+		[[nodiscard]] bool valid() const noexcept {
+			return static_cast<bool>(handle);
+		}
+
+		/// Check if the coroutine has finished
+		[[nodiscard]] bool done() const noexcept {
+			return handle && handle.done();
+		}
+
+		/**
+		 * Start the Task and suspend the awaiting coroutine until the Task finishes
+		 * @throws std::future_error - if the Task is invalid
+		 */
+		auto operator co_await() && noexcept {
+			struct Awaiter {
+				std::coroutine_handle<promise_type> h;
+
+				[[nodiscard]] bool await_ready() const noexcept {
+					return !h || h.done();
+				}
+
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+					h.promise().continuation = awaiting;
+					return h;
+				}
+
+				T await_resume() const {
+					if (!h) {
+						throw std::future_error(std::future_errc::no_state);
+					}
+					return h.promise().result();
+				}
+			};
+			return Awaiter {handle};
+		}
+
+	private:
+		friend promise_type;
+
+		explicit Task(std::coroutine_handle<promise_type> h) noexcept : handle(h) {}
+
+		void destroy() noexcept {
+			if (handle) {
+				handle.destroy();
+				handle = {};
+			}
+		}
+
+		std::coroutine_handle<promise_type> handle;
+	};
+
+	namespace Detail {
+		template<typename T>
+		Task<T> TaskPromise<T>::get_return_object() noexcept {
+			return Task<T> {std::coroutine_handle<TaskPromise>::from_promise(*this)};
+		}
+
+		inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+			return Task<void> {std::coroutine_handle<TaskPromise>::from_promise(*this)};
+		}
+	}  // namespace Detail
+
+	/**
+	 * Await an Async::Future in a coroutine, consuming it like Future::get. The coroutine is resumed by the thread which makes the future
+	 * ready, for a future of a Task started with Async::spawn this is the worker that finished the Task.
+	 * @param future - valid future
+	 */
+	template<typename T>
+	Detail::FutureAwaiter<T> operator co_await(Future<T>&& future) noexcept {
+		return Detail::FutureAwaiter<T> {std::move(future)};
+	}
+
+	/// @copydoc operator co_await(Future<T>&&)
+	template<typename T>
+	Detail::FutureAwaiter<T> operator co_await(Future<T>& future) noexcept {
+		return Detail::FutureAwaiter<T> {std::move(future)};
+	}
+
+	/**
+	 * Run a Task in the pool and get an Async::Future of its result. The Task starts in a worker thread, when spawned from a worker of a pool
+	 * with local queues it goes to the local queue of that worker, so idle workers can steal it.
+	 * @param pool - thread pool with a schedule method, like LLU::ThreadPool
+	 * @param task - valid Task
+	 * @return future of the result of \p task, which can be awaited in another Task or waited for with Future::get
+	 */
+	template<typename Pool, typename T>
+	Future<T> spawn(Pool& pool, Task<T> task) {
+		Promise<T> promise;
+		auto result = promise.getFuture();
+		Detail::runInPool(pool, std::move(task), std::move(promise));
+		return result;
+	}
+
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_COROUTINES
+
+#endif	  // LLU_ASYNC_COROUTINE_H
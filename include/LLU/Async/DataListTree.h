@@ -0,0 +1,131 @@
+/**
+ * @file	DataListTree.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Flat snapshot of nested DataLists and parallel algorithms that process its nodes on thread pools from LLU::Async.
+ */
+#ifndef LLU_ASYNC_DATALISTTREE_H
+#define LLU_ASYNC_DATALISTTREE_H
+
+#include <vector>
+
+#include "LLU/Async/Algorithms.h"
+#include "LLU/Containers/Generic/DataStore.hpp"
+#include "LLU/TypedMArgument.h"
+
+namespace LLU::Async {
+
+	/// Single node of a DataListTree
+	struct TreeNode {
+		/// The node itself, its name and value can be read from any thread as long as no DataList in the tree is modified
+		GenericDataNode node;
+		/// Index of the DataList node that contains this node, or -1 for nodes of the root DataList
+		mint parent;
+		/// Nesting level, 0 for nodes of the root DataList
+		mint depth;
+	};
+
+	/**
+	 * @class   DataListTree
+	 * @brief   Index of all nodes of a DataList and of all DataLists nested in it, in pre-order.
+	 * @details LibraryLink DataStores are linked lists, so they can only be traversed sequentially. DataListTree walks all the node chains once
+	 * and stores the nodes in an array, which can then be processed in parallel, e.g. with forEachLeaf or transformLeaves.
+	 * Nodes of a nested DataList at index i occupy the indices [i + 1, subtreeEnd(i)).
+	 * The tree does not own any data, so it must not outlive the root DataList and none of the DataLists may be modified while the tree is used.
+	 */
+	class DataListTree {
+	public:
+		/**
+		 * @brief   Walk the whole tree and index its nodes
+		 * @param   root - DataList to traverse, nested DataLists are traversed recursively
+		 */
+		explicit DataListTree(const GenericDataList& root);
+
+		/// Get the total number of nodes, including the DataList nodes
+		[[nodiscard]] mint size() const noexcept {
+			return static_cast<mint>(nodes.size());
+		}
+
+		/// Get the node at given index
+		[[nodiscard]] const TreeNode& operator[](mint index) const {
+			return nodes[static_cast<std::size_t>(index)];
+		}
+
+		/// Get the index past the last node nested in the node at \p index, for nodes that are not DataLists this is index + 1
+		[[nodiscard]] mint subtreeEnd(mint index) const {
+			return ends[static_cast<std::size_t>(index)];
+		}
+
+		/// Get the indices of all nodes that are not DataLists, in pre-order
+		[[nodiscard]] const std::vector<mint>& leaves() const noexcept {
+			return leafIndices;
+		}
+
+		/// Get the indices of all DataList nodes with given nesting level, in pre-order
+		[[nodiscard]] std::vector<mint> subLists(mint depth) const;
+
+	private:
+		std::vector<TreeNode> nodes;
+		std::vector<mint> ends;
+		std::vector<mint> leafIndices;
+	};
+
+	/**
+	 * @brief   Call \p f on every node of the tree that is not a DataList, distributing the nodes among threads of the pool
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  F - callable that takes const TreeNode&
+	 * @param   pool - thread pool to run the tasks
+	 * @param   tree - snapshot of the DataList
+	 * @param   grain - maximal number of nodes processed by a single task
+	 * @param   f - function to be called on each leaf node, calls for different nodes may run concurrently and must not modify any DataList of the tree
+	 */
+	template<typename Pool, typename F>
+	void forEachLeaf(Pool& pool, const DataListTree& tree, mint grain, F&& f) {
+		const auto& leaves = tree.leaves();
+		parallelFor(pool, std::size_t {0}, leaves.size(), static_cast<std::size_t>(grain), [&tree, &leaves, &f](std::size_t k) { f(tree[leaves[k]]); });
+	}
+
+	/**
+	 * @brief   Call \p f on every DataList node at given nesting level, distributing whole sub-lists among threads of the pool
+	 * @details Use it when the nested DataLists are independent records, the nodes of the sub-list at index i are [i + 1, tree.subtreeEnd(i)).
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  F - callable that takes the index of a DataList node in the tree
+	 * @param   pool - thread pool to run the tasks
+	 * @param   tree - snapshot of the DataList
+	 * @param   depth - nesting level of the sub-lists, 0 for DataLists that are nodes of the root
+	 * @param   f - function to be called on each sub-list, calls for different sub-lists may run concurrently
+	 */
+	template<typename Pool, typename F>
+	void forEachSubList(Pool& pool, const DataListTree& tree, mint depth, F&& f) {
+		auto lists = tree.subLists(depth);
+		parallelFor(pool, std::size_t {0}, lists.size(), 1, [&lists, &f](std::size_t k) { f(lists[k]); });
+	}
+
+	namespace Detail {
+		/// Build a new DataList with the same structure and names as \p tree, with leaf values taken from \p values in pre-order
+		GenericDataList assembleTree(const DataListTree& tree, std::vector<Argument::TypedArgument>& values);
+	}  // namespace Detail
+
+	/**
+	 * @brief   Create a new DataList with the same nesting and node names, in which every value that is not a DataList is replaced by \p f(node)
+	 * @details New values are computed in parallel. The new DataLists are then assembled on the calling thread, which is a single sequential pass.
+	 * Containers returned by \p f that are not owned by the library, e.g. the unchanged value of the node, are copied into the new DataList.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  F - callable that takes const TreeNode& and returns a value convertible to Argument::TypedArgument
+	 * @param   pool - thread pool to run the tasks
+	 * @param   tree - snapshot of the DataList
+	 * @param   grain - maximal number of nodes processed by a single task
+	 * @param   f - function to be called on each leaf node, calls for different nodes may run concurrently and must not modify any DataList of the tree
+	 * @return  new DataList owned by the library
+	 * @note    Strings returned as std::string_view must stay valid until this function returns, e.g. they may point to strings in the original tree.
+	 */
+	template<typename Pool, typename F>
+	GenericDataList transformLeaves(Pool& pool, const DataListTree& tree, mint grain, F&& f) {
+		std::vector<Argument::TypedArgument> values(tree.leaves().size());
+		const auto& leaves = tree.leaves();
+		parallelFor(pool, std::size_t {0}, leaves.size(), static_cast<std::size_t>(grain),
+					[&tree, &leaves, &values, &f](std::size_t k) { values[k] = f(tree[leaves[k]]); });
+		return Detail::assembleTree(tree, values);
+	}
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_DATALISTTREE_H
@@ -0,0 +1,554 @@
+/**
+ * @file	Future.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Pool-aware futures and promises with continuations, which let tasks form pipelines and graphs without blocking worker threads.
+ */
+#ifndef LLU_ASYNC_FUTURE_H
+#define LLU_ASYNC_FUTURE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "LLU/Async/Utilities.h"
+
+namespace LLU::Async {
+
+	template<typename T>
+	class Future;
+
+	template<typename T>
+	class Promise;
+
+	namespace Detail {
+		template<typename T>
+		class FutureAwaiter;
+
+		/// Placeholder stored in the shared state of Future<void>
+		struct Unit {};
+
+		/// Type actually stored in the shared state of a Future<T>
+		template<typename T>
+		using Stored = std::conditional_t<std::is_void_v<T>, Unit, T>;
+
+		/**
+		 * @brief   State shared between a Promise and the corresponding Future.
+		 * @details Holds the result or the exception and at most one continuation, which is called by the thread that makes the state ready.
+		 */
+		template<typename T>
+		class SharedState {
+		public:
+			/// Store the result or the exception and run the continuation, if any
+			template<typename... U>
+			void setValue(U&&... value) {
+				std::unique_lock<std::mutex> lock(mutex);
+				if (readyQ) {
+					throw std::future_error(std::future_errc::promise_already_satisfied);
+				}
+				result.emplace(std::forward<U>(value)...);
+				makeReady(lock);
+			}
+
+			/// Store an exception and run the continuation, if any
+			void setException(std::exception_ptr e) {
+				std::unique_lock<std::mutex> lock(mutex);
+				if (readyQ) {
+					throw std::future_error(std::future_errc::promise_already_satisfied);
+				}
+				exception = std::move(e);
+				makeReady(lock);
+			}
+
+			/// Register a function to be called as soon as the state is ready. If it already is, the function is called immediately.
+			void setContinuation(FunctionWrapper&& f) {
+				std::unique_lock<std::mutex> lock(mutex);
+				if (!readyQ) {
+					continuation = std::move(f);
+					return;
+				}
+				lock.unlock();
+				f();
+			}
+
+			[[nodiscard]] bool ready() const {
+				return readyFlag.load(std::memory_order_acquire);
+			}
+
+			void wait() {
+				std::unique_lock<std::mutex> lock(mutex);
+				becameReady.wait(lock, [this] { return readyQ; });
+			}
+
+			/// Move the result out of a ready state or rethrow the stored exception
+			Stored<T> take() {
+				if (exception) {
+					std::rethrow_exception(exception);
+				}
+				return std::move(*result);
+			}
+
+		private:
+			std::mutex mutex;
+			std::condition_variable becameReady;
+			bool readyQ = false;
+			std::atomic_bool readyFlag = false;
+			std::optional<Stored<T>> result;
+			std::exception_ptr exception;
+			FunctionWrapper continuation;
+
+			void makeReady(std::unique_lock<std::mutex>& lock) {
+				readyQ = true;
+				readyFlag.store(true, std::memory_order_release);
+				FunctionWrapper next = std::move(continuation);
+				becameReady.notify_all();
+				lock.unlock();
+				if (next) {
+					next();
+				}
+			}
+		};
+
+		/// Call \p f on the value stored in \p state and pass the result (or the exception) to \p promise
+		template<typename T, typename R, typename F>
+		void fulfill(SharedState<T>& state, Promise<R>& promise, F& f) {
+			try {
+				if constexpr (std::is_void_v<T>) {
+					state.take();
+					if constexpr (std::is_void_v<R>) {
+						f();
+						promise.setValue();
+					} else {
+						promise.setValue(f());
+					}
+				} else {
+					if constexpr (std::is_void_v<R>) {
+						f(state.take());
+						promise.setValue();
+					} else {
+						promise.setValue(f(state.take()));
+					}
+				}
+			} catch (...) {
+				promise.setException(std::current_exception());
+			}
+		}
+
+		/// Result type of a continuation F attached to a Future<T>
+		template<typename T, typename F>
+		struct continuation_result {
+			using type = std::invoke_result_t<F, T>;
+		};
+
+		/// @cond
+		template<typename F>
+		struct continuation_result<void, F> {
+			using type = std::invoke_result_t<F>;
+		};
+		/// @endcond
+
+		/// Convenience alias for continuation_result
+		template<typename T, typename F>
+		using continuation_result_t = typename continuation_result<T, F>::type;
+	}  // namespace Detail
+
+	/**
+	 * @class   Promise
+	 * @brief   Producing end of an Async::Future. If the Promise is destroyed before it is fulfilled, the Future gets a broken_promise error.
+	 * @tparam  T - type of the value
+	 */
+	template<typename T>
+	class Promise {
+	public:
+		/// Create a promise with a fresh shared state
+		Promise() : state(std::make_shared<Detail::SharedState<T>>()) {}
+
+		Promise(const Promise&) = delete;
+		Promise& operator=(const Promise&) = delete;
+		Promise(Promise&&) noexcept = default;
+		Promise& operator=(Promise&& other) noexcept {
+			if (this != &other) {
+				abandon();
+				state = std::move(other.state);
+				futureRetrieved = other.futureRetrieved;
+			}
+			return *this;
+		}
+
+		/// Fulfill the promise with a broken_promise error if it was not fulfilled yet
+		~Promise() {
+			abandon();
+		}
+
+		/**
+		 * Get the future associated with this promise. Can be called only once.
+		 * @return Future that will become ready when the promise is fulfilled
+		 */
+		Future<T> getFuture() {
+			if (futureRetrieved) {
+				throw std::future_error(std::future_errc::future_already_retrieved);
+			}
+			futureRetrieved = true;
+			return Future<T> {state};
+		}
+
+		/**
+		 * Store the value and run the continuation of the associated future, if any. The continuation runs in the calling thread,
+		 * but continuations added with Future::then only schedule a new task in the pool, so this is always cheap.
+		 * @param value - value of the future (no argument when T is void)
+		 */
+		template<typename... U>
+		void setValue(U&&... value) {
+			checkState();
+			std::exchange(state, nullptr)->setValue(std::forward<U>(value)...);
+		}
+
+		/**
+		 * Store an exception to be rethrown from Future::get
+		 * @param e - exception pointer
+		 */
+		void setException(std::exception_ptr e) {
+			checkState();
+			std::exchange(state, nullptr)->setException(std::move(e));
+		}
+
+	private:
+		std::shared_ptr<Detail::SharedState<T>> state;
+		bool futureRetrieved = false;
+
+		void checkState() const {
+			if (!state) {
+				throw std::future_error(std::future_errc::promise_already_satisfied);
+			}
+		}
+
+		void abandon() noexcept {
+			if (state && !state->ready()) {
+				try {
+					state->setException(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+				} catch (...) {
+					// the promise was fulfilled by the time we got here, or the continuation threw
+				}
+			}
+		}
+	};
+
+	/**
+	 * @class   Future
+	 * @brief   Result of an asynchronous computation which, unlike std::future, can schedule follow-up work on a thread pool when it becomes ready.
+	 * @details Chaining with then() never blocks a thread: the continuation is posted to the pool by the thread which completes the input.
+	 * Together with whenAll() and whenAny() this allows expressing arbitrary acyclic task graphs.
+	 * @tparam  T - type of the value
+	 */
+	template<typename T>
+	class Future {
+		friend class Promise<T>;
+
+		template<typename U>
+		friend class Future;
+
+	public:
+		/// Value type of the future
+		using value_type = T;
+
+	public:
+		/// Create an invalid future with no shared state
+		Future() = default;
+
+		/**
+		 * Check if the future refers to a shared state. A future becomes invalid after get() or then() is called on it.
+		 * @return true iff the future is valid
+		 */
+		[[nodiscard]] bool valid() const noexcept {
+			return static_cast<bool>(state);
+		}
+
+		/**
+		 * Check if the result is available
+		 * @return true iff get() will not block
+		 */
+		[[nodiscard]] bool ready() const {
+			checkValid();
+			return state->ready();
+		}
+
+		/// Block until the result is available
+		void wait() const {
+			checkValid();
+			state->wait();
+		}
+
+		/**
+		 * Wait until the result is available, running pending tasks from the pool in the meantime.
+		 * This is the way to wait for a future inside a task of a pool with work stealing.
+		 * @param pool - thread pool with a non-blocking runPendingTask method
+		 */
+		template<typename Pool>
+		void wait(Pool& pool) const {
+			checkValid();
+			while (!state->ready()) {
+				pool.runPendingTask();
+			}
+		}
+
+		/**
+		 * Get the result, blocking if it is not ready yet. Rethrows the exception if the computation failed.
+		 * @return the value of the future
+		 */
+		T get() {
+			wait();
+			return take();
+		}
+
+		/**
+		 * Get the result, running pending tasks from the pool while waiting for it.
+		 * @param pool - thread pool with a non-blocking runPendingTask method
+		 * @return the value of the future
+		 */
+		template<typename Pool>
+		T get(Pool& pool) {
+			wait(pool);
+			return take();
+		}
+
+		/**
+		 * Schedule a function to run in the pool on the value of this future once it is ready. Invalidates this future.
+		 * If the future holds an exception, \p f is not called and the exception is passed on to the returned future.
+		 * @param pool - thread pool with a post method where the continuation will run
+		 * @param f - function that takes the value of this future (no arguments when T is void)
+		 * @return future of the result of \p f
+		 */
+		template<typename Pool, typename F>
+		Future<Detail::continuation_result_t<T, F>> then(Pool& pool, F&& f) {
+			using R = Detail::continuation_result_t<T, F>;
+			checkValid();
+			Promise<R> promise;
+			auto result = promise.getFuture();
+			auto input = std::move(state);
+			auto& inputRef = *input;
+			inputRef.setContinuation(FunctionWrapper {[&pool, input = std::move(input), promise = std::move(promise), fn = std::forward<F>(f)]() mutable {
+				auto body = [input = std::move(input), promise = std::move(promise), fn = std::move(fn)]() mutable {
+					Detail::fulfill(*input, promise, fn);
+				};
+				// the posted wrapper only shares the task, so it is not lost if post fails and can still be run inline
+				auto task = std::make_shared<decltype(body)>(std::move(body));
+				try {
+					pool.post([task] { (*task)(); });
+				} catch (...) {
+					(*task)();
+				}
+			}});
+			return result;
+		}
+
+	private:
+		std::shared_ptr<Detail::SharedState<T>> state;
+
+		explicit Future(std::shared_ptr<Detail::SharedState<T>> s) : state(std::move(s)) {}
+
+		void checkValid() const {
+			if (!state) {
+				throw std::future_error(std::future_errc::no_state);
+			}
+		}
+
+		T take() {
+			auto s = std::move(state);
+			if constexpr (std::is_void_v<T>) {
+				s->take();
+			} else {
+				return s->take();
+			}
+		}
+
+		/// Register a raw continuation that will be called in the completing thread, used by whenAll and whenAny
+		template<typename F>
+		void onReady(F&& f) {
+			checkValid();
+			// f may consume this future, keep the state alive until setContinuation returns
+			auto keepAlive = state;
+			keepAlive->setContinuation(FunctionWrapper {std::forward<F>(f)});
+		}
+
+		template<typename U>
+		friend Future<std::conditional_t<std::is_void_v<U>, void, std::vector<U>>> whenAll(std::vector<Future<U>> futures);
+
+		template<typename... U>
+		friend Future<std::tuple<U...>> whenAll(Future<U>... futures);
+
+		template<typename U>
+		friend auto whenAny(std::vector<Future<U>> futures);
+
+		friend class Detail::FutureAwaiter<T>;
+	};
+
+	/**
+	 * Run a function in the pool and get an Async::Future of its result
+	 * @param pool - thread pool with a post method
+	 * @param f - function to be called in a worker thread
+	 * @param args - arguments for \p f
+	 * @return future of the result of \p f
+	 */
+	template<typename Pool, typename FunctionType, typename... Args>
+	Future<std::invoke_result_t<FunctionType, Args...>> spawn(Pool& pool, FunctionType&& f, Args&&... args) {
+		using R = std::invoke_result_t<FunctionType, Args...>;
+		Promise<R> promise;
+		auto result = promise.getFuture();
+		// NOLINTNEXTLINE(modernize-avoid-bind): perfect forwarding capture of a parameter pack in a lambda is not trivial
+		auto boundF = std::bind(std::forward<FunctionType>(f), std::forward<Args>(args)...);
+		pool.post([promise = std::move(promise), fn = std::move(boundF)]() mutable {
+			try {
+				if constexpr (std::is_void_v<R>) {
+					fn();
+					promise.setValue();
+				} else {
+					promise.setValue(fn());
+				}
+			} catch (...) {
+				promise.setException(std::current_exception());
+			}
+		});
+		return result;
+	}
+
+	/**
+	 * Create a future which becomes ready when all futures from the list are ready.
+	 * If any of the inputs fails, the result holds the exception of the first failed input (in list order).
+	 * @param futures - list of valid futures, all of them are invalidated
+	 * @return future of the list of values, or Future<void> when T is void
+	 */
+	template<typename T>
+	Future<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> whenAll(std::vector<Future<T>> futures) {
+		using R = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+		struct Context {
+			std::vector<Future<T>> inputs;
+			std::atomic<std::size_t> remaining;
+			Promise<R> promise;
+		};
+		auto ctx = std::make_shared<Context>();
+		ctx->remaining = futures.size();
+		auto result = ctx->promise.getFuture();
+		if (futures.empty()) {
+			if constexpr (std::is_void_v<T>) {
+				ctx->promise.setValue();
+			} else {
+				ctx->promise.setValue(R {});
+			}
+			return result;
+		}
+		ctx->inputs = std::move(futures);
+		auto complete = [ctx] {
+			if (ctx->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+				return;
+			}
+			try {
+				if constexpr (std::is_void_v<T>) {
+					for (auto& f : ctx->inputs) {
+						f.get();
+					}
+					ctx->promise.setValue();
+				} else {
+					R values;
+					values.reserve(ctx->inputs.size());
+					for (auto& f : ctx->inputs) {
+						values.push_back(f.get());
+					}
+					ctx->promise.setValue(std::move(values));
+				}
+			} catch (...) {
+				ctx->promise.setException(std::current_exception());
+			}
+		};
+		for (auto& f : ctx->inputs) {
+			f.onReady(complete);
+		}
+		return result;
+	}
+
+	/**
+	 * Create a future which becomes ready when all given futures are ready.
+	 * @param futures - valid futures of non-void types, all of them are invalidated
+	 * @return future of the tuple of values
+	 */
+	template<typename... T>
+	Future<std::tuple<T...>> whenAll(Future<T>... futures) {
+		static_assert((!std::is_void_v<T> && ...), "Variadic whenAll does not support Future<void>, use the overload that takes a vector.");
+		struct Context {
+			std::tuple<Future<T>...> inputs;
+			std::atomic<std::size_t> remaining = sizeof...(T);
+			Promise<std::tuple<T...>> promise;
+		};
+		auto ctx = std::make_shared<Context>();
+		ctx->inputs = std::make_tuple(std::move(futures)...);
+		auto result = ctx->promise.getFuture();
+		auto complete = [ctx] {
+			if (ctx->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+				return;
+			}
+			try {
+				ctx->promise.setValue(std::apply([](auto&... f) { return std::tuple<T...> {f.get()...}; }, ctx->inputs));
+			} catch (...) {
+				ctx->promise.setException(std::current_exception());
+			}
+		};
+		std::apply([&complete](auto&... f) { (f.onReady(complete), ...); }, ctx->inputs);
+		return result;
+	}
+
+	/// Result of whenAny: index of the first future that became ready together with its value
+	template<typename T>
+	using WhenAnyResult = std::conditional_t<std::is_void_v<T>, std::size_t, std::pair<std::size_t, T>>;
+
+	/**
+	 * Create a future which becomes ready as soon as any of the futures from the list is ready.
+	 * The first input to complete determines the result, also if it completes with an exception.
+	 * @param futures - non-empty list of valid futures, all of them are invalidated
+	 * @return future of the index of the first completed input and its value (only the index when T is void)
+	 */
+	template<typename T>
+	auto whenAny(std::vector<Future<T>> futures) {
+		using R = WhenAnyResult<T>;
+		if (futures.empty()) {
+			throw std::invalid_argument("whenAny requires at least one future.");
+		}
+		struct Context {
+			std::vector<Future<T>> inputs;
+			std::atomic_bool decided = false;
+			Promise<R> promise;
+		};
+		auto ctx = std::make_shared<Context>();
+		auto result = ctx->promise.getFuture();
+		ctx->inputs = std::move(futures);
+		for (std::size_t i = 0; i < ctx->inputs.size(); ++i) {
+			// inputs may complete (and run these continuations) while we are still registering them, so the index is captured by value
+			ctx->inputs[i].onReady([ctx, i] {
+				if (ctx->decided.exchange(true, std::memory_order_acq_rel)) {
+					return;
+				}
+				try {
+					if constexpr (std::is_void_v<T>) {
+						ctx->inputs[i].get();
+						ctx->promise.setValue(i);
+					} else {
+						ctx->promise.setValue(R {i, ctx->inputs[i].get()});
+					}
+				} catch (...) {
+					ctx->promise.setException(std::current_exception());
+				}
+			});
+		}
+		return result;
+	}
+
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_FUTURE_H
@@ -0,0 +1,142 @@
+/**
+ * @file	Idle.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Idle strategies for thread pool workers and a simple event count used to park and wake idle workers.
+ */
+#ifndef LLU_ASYNC_IDLE_H
+#define LLU_ASYNC_IDLE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace LLU::Async {
+
+	/// Hint the CPU that the calling thread is in a spin-wait loop
+	inline void cpuRelax() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		_mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+		_mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+		asm volatile("yield" ::: "memory");
+#endif
+	}
+
+	/**
+	 * @class   EventCount
+	 * @brief   Lets threads sleep until an event happens without missing notifications that arrive between checking a condition and going to sleep.
+	 * @details A waiter calls prepareWait(), checks its condition once more and then either cancelWait() or commitWait(). A notifier publishes
+	 * its change and calls notifyOne() or notifyAll(). Notifying is a single atomic load when there are no waiters.
+	 */
+	class EventCount {
+	public:
+		/// Token returned from prepareWait
+		using Key = std::uint64_t;
+
+		/**
+		 * Announce that the calling thread is about to wait. Must be followed by a call to either cancelWait or commitWait.
+		 * @return key to be passed to commitWait
+		 */
+		Key prepareWait() noexcept {
+			waiters.fetch_add(1);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			return epoch.load(std::memory_order_acquire);
+		}
+
+		/// Give up waiting after prepareWait, for instance because the condition turned out to be satisfied
+		void cancelWait() noexcept {
+			waiters.fetch_sub(1);
+		}
+
+		/**
+		 * Block until a notification issued after the matching prepareWait
+		 * @param key - value returned from prepareWait
+		 */
+		void commitWait(Key key) {
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wakeUp.wait(lock, [&] { return epoch.load(std::memory_order_acquire) != key; });
+			}
+			waiters.fetch_sub(1);
+		}
+
+		/// Wake up one waiting thread, if there is any
+		void notifyOne() {
+			notify(false);
+		}
+
+		/// Wake up all waiting threads
+		void notifyAll() {
+			notify(true);
+		}
+
+	private:
+		std::atomic<Key> epoch = 0;
+		std::atomic<int> waiters = 0;
+		std::mutex mutex;
+		std::condition_variable wakeUp;
+
+		void notify(bool all) {
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (waiters.load() == 0) {
+				return;
+			}
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				epoch.fetch_add(1, std::memory_order_release);
+			}
+			if (all) {
+				wakeUp.notify_all();
+			} else {
+				wakeUp.notify_one();
+			}
+		}
+	};
+
+	/**
+	 * @brief   Idle strategy for thread pool workers: spin for a while, then yield for a while and finally go to sleep until new work arrives.
+	 * @tparam  SpinRounds - number of consecutive unsuccessful attempts to find work, after which the worker starts yielding
+	 * @tparam  YieldRounds - number of unsuccessful attempts with yielding, after which the worker goes to sleep
+	 */
+	template<unsigned SpinRounds = 64, unsigned YieldRounds = 64>
+	struct AdaptiveIdle {
+		/// Rounds of busy waiting
+		static constexpr unsigned spinRounds = SpinRounds;
+		/// Rounds of yielding after the busy waiting
+		static constexpr unsigned yieldRounds = YieldRounds;
+		/// Whether workers are allowed to sleep
+		static constexpr bool parks = true;
+	};
+
+	/// Idle strategy for thread pool workers that never sleep and yield their time slice whenever they do not find work.
+	struct YieldIdle {
+		/// Rounds of busy waiting
+		static constexpr unsigned spinRounds = 0;
+		/// Rounds of yielding
+		static constexpr unsigned yieldRounds = std::numeric_limits<unsigned>::max();
+		/// Whether workers are allowed to sleep
+		static constexpr bool parks = false;
+	};
+
+	/// Idle strategy for latency-critical thread pools: workers busy-wait for new work all the time, occupying their cores.
+	struct SpinIdle {
+		/// Rounds of busy waiting
+		static constexpr unsigned spinRounds = std::numeric_limits<unsigned>::max();
+		/// Rounds of yielding
+		static constexpr unsigned yieldRounds = 0;
+		/// Whether workers are allowed to sleep
+		static constexpr bool parks = false;
+	};
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_IDLE_H
@@ -0,0 +1,155 @@
+/**
+ * @file	LaneQueue.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Definition of LaneQueue - a set of threadsafe queues, one per task priority, served in a weighted round-robin order.
+ */
+#ifndef LLU_ASYNC_LANEQUEUE_H
+#define LLU_ASYNC_LANEQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace LLU::Async {
+
+	/// Priority of a task submitted to a thread pool with priority lanes
+	enum class TaskPriority {
+		High,	   //!< latency-sensitive work, overtakes tasks with lower priorities
+		Normal,	   //!< default priority
+		Low		   //!< bulk work which only needs to make progress eventually
+	};
+
+	/**
+	 * @brief   Queue with a separate lane for each TaskPriority.
+	 * @details Consumers serve the lanes in a weighted round-robin: out of every 7 pops, 4 start from the High lane, 2 from the Normal lane
+	 * and 1 from the Low lane, falling back to other lanes in the order of priority when the chosen lane is empty. This way urgent tasks
+	 * overtake queued bulk work, but a steady stream of urgent tasks cannot starve the lower lanes.
+	 *
+	 * LaneQueue provides the same push/tryPop/empty interface as the underlying queue, so it can be used as the pool queue of GenericThreadPool.
+	 * Elements pushed without a priority go to the Normal lane.
+	 *
+	 * @tparam  Queue - any threadsafe queue class that provides push, tryPop and empty methods, e.g. ThreadsafeQueue or BoundedQueue
+	 */
+	template<typename Queue>
+	class LaneQueue {
+	public:
+		/// Value type of queue elements
+		using value_type = typename Queue::value_type;
+
+		/// Number of lanes, one for each TaskPriority
+		static constexpr std::size_t laneCount = 3;
+
+	public:
+		/**
+		 * Push new value to the Normal lane
+		 * @param new_value - value to be pushed to the queue
+		 * @return whatever the underlying queue returns from push
+		 */
+		decltype(auto) push(value_type new_value) {
+			return push(TaskPriority::Normal, std::move(new_value));
+		}
+
+		/**
+		 * Push new value to the lane of given priority
+		 * @param priority - priority of the new value
+		 * @param new_value - value to be pushed to the queue
+		 * @return whatever the underlying queue returns from push
+		 */
+		decltype(auto) push(TaskPriority priority, value_type new_value) {
+			return lane(priority).push(std::move(new_value));
+		}
+
+		/**
+		 * Push all elements from a range to the Normal lane. Only available if the underlying queue supports bulk push.
+		 * @tparam InputIt - input iterator type
+		 * @param first - iterator to the first element
+		 * @param last - iterator past the last element
+		 */
+		template<typename InputIt>
+		auto pushBulk(InputIt first, InputIt last) -> decltype(std::declval<Queue&>().pushBulk(first, last)) {
+			return lane(TaskPriority::Normal).pushBulk(first, last);
+		}
+
+		/**
+		 * Get data from one of the lanes, chosen according to the weighted round-robin schedule
+		 * @param[out] value - reference to the data from the queue
+		 * @return true iff there was data in any lane, otherwise the out-parameter remains unchanged
+		 */
+		bool tryPop(value_type& value) {
+			constexpr std::array<std::size_t, 7> schedule {0, 0, 1, 0, 0, 1, 2};
+			const auto first = schedule[turn.fetch_add(1, std::memory_order_relaxed) % schedule.size()];
+			if (lanes[first].tryPop(value)) {
+				return true;
+			}
+			for (std::size_t i = 0; i < laneCount; ++i) {
+				if (i != first && lanes[i].tryPop(value)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * Get data from the High lane only. After a couple of consecutive urgent pops this function reports failure once,
+		 * so that consumers which check for urgent work before anything else still get to their other tasks.
+		 * @param[out] value - reference to the data from the queue
+		 * @return true iff there was data in the High lane and it was popped
+		 */
+		bool tryPopUrgent(value_type& value) {
+			if (urgentStreak.fetch_add(1, std::memory_order_relaxed) >= maxUrgentStreak) {
+				urgentStreak.store(0, std::memory_order_relaxed);
+				return false;
+			}
+			if (lane(TaskPriority::High).tryPop(value)) {
+				return true;
+			}
+			urgentStreak.store(0, std::memory_order_relaxed);
+			return false;
+		}
+
+		/**
+		 * Check if all lanes are empty
+		 * @return true iff there is no data to be popped
+		 */
+		[[nodiscard]] bool empty() const {
+			for (const auto& l : lanes) {
+				if (!l.empty()) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+	private:
+		/// Number of urgent pops in a row after which tryPopUrgent lets other work through
+		static constexpr std::size_t maxUrgentStreak = 4;
+
+		std::array<Queue, laneCount> lanes;
+		std::atomic<std::size_t> turn = 0;
+		std::atomic<std::size_t> urgentStreak = 0;
+
+		Queue& lane(TaskPriority priority) {
+			return lanes[static_cast<std::size_t>(priority)];
+		}
+	};
+
+	/// Type trait that checks whether a queue type supports task priorities
+	template<typename Queue, typename = void>
+	struct has_priority_lanes : std::false_type {};
+
+	/// @cond
+	template<typename Queue>
+	struct has_priority_lanes<
+		Queue, std::void_t<decltype(std::declval<Queue&>().push(TaskPriority::High, std::declval<typename Queue::value_type>())),
+						   decltype(std::declval<Queue&>().tryPopUrgent(std::declval<typename Queue::value_type&>()))>> : std::true_type {};
+	/// @endcond
+
+	/// Convenience variable template for has_priority_lanes
+	template<typename Queue>
+	inline constexpr bool has_priority_lanes_v = has_priority_lanes<Queue>::value;
+
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_LANEQUEUE_H
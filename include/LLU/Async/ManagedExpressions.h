@@ -0,0 +1,55 @@
+/**
+ * @file	ManagedExpressions.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Parallel processing of all instances of a managed class on thread pools from LLU::Async.
+ */
+#ifndef LLU_ASYNC_MANAGEDEXPRESSIONS_H
+#define LLU_ASYNC_MANAGEDEXPRESSIONS_H
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "LLU/Async/Algorithms.h"
+
+namespace LLU::Async {
+
+	/**
+	 * @brief   Call \p f on every object from a snapshot of managed instances, distributing the objects among threads of the pool
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  T - managed class
+	 * @tparam  F - callable that takes T&
+	 * @param   pool - thread pool to run the tasks
+	 * @param   instances - snapshot taken with snapshot() member function of a store, none of the pointers may be null
+	 * @param   grain - maximal number of objects processed by a single task
+	 * @param   f - function to be called on each object, calls for different objects may run concurrently
+	 */
+	template<typename Pool, typename T, typename F>
+	void parallelForEach(Pool& pool, const std::vector<std::shared_ptr<T>>& instances, std::ptrdiff_t grain, F&& f) {
+		const auto* data = instances.data();
+		parallelFor(pool, std::ptrdiff_t {0}, static_cast<std::ptrdiff_t>(instances.size()), grain, [data, &f](std::ptrdiff_t i) { f(*data[i]); });
+	}
+
+	/**
+	 * @brief   Call \p f on every instance in a managed expression store, distributing the instances among threads of the pool
+	 * @details The store is accessed only once, on the calling thread, to take a snapshot of its instances. The snapshot keeps the objects alive,
+	 * so instances released while the tasks run are still processed and freed afterwards, and instances created in the meantime are not processed.
+	 * With ConcurrentManagedExpressionStore other threads may create and release instances during the whole call, other stores must not be
+	 * modified concurrently, as usual.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  Store - ManagedExpressionStore, ConcurrentManagedExpressionStore or SlabManagedExpressionStore
+	 * @tparam  F - callable that takes a reference to the managed class
+	 * @param   pool - thread pool to run the tasks
+	 * @param   store - store of the managed class
+	 * @param   grain - maximal number of instances processed by a single task
+	 * @param   f - function to be called on each instance, calls for different instances may run concurrently
+	 */
+	template<typename Pool, typename Store, typename F, typename = decltype(std::declval<const Store&>().snapshot())>
+	void parallelForEach(Pool& pool, const Store& store, std::ptrdiff_t grain, F&& f) {
+		parallelForEach(pool, store.snapshot(), grain, std::forward<F>(f));
+	}
+
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_MANAGEDEXPRESSIONS_H
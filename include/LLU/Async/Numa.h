@@ -0,0 +1,172 @@
+/**
+ * @file	Numa.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Node-local thread pools and data-parallel algorithms that keep each chunk of a container on the NUMA node that first touched it.
+ */
+#ifndef LLU_ASYNC_NUMA_H
+#define LLU_ASYNC_NUMA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "LLU/Async/Algorithms.h"
+#include "LLU/Async/TaskGroup.h"
+#include "LLU/Async/ThreadPool.h"
+#include "LLU/Async/Topology.h"
+
+namespace LLU::Async {
+
+	/**
+	 * @class   NumaPools
+	 * @brief   Set of thread pools, one per NUMA node, with workers pinned to the CPUs of their node.
+	 * @details Work stealing happens only within a pool, so a task posted to the pool of some node is run by the threads of that node, together
+	 * with all tasks it spawns. Ranges processed with Async::parallelFor or Async::fill are split between nodes with partition(), each node getting
+	 * a part proportional to its number of threads. Since the split depends only on the range and the thread counts, consecutive calls over
+	 * the same range send every chunk to the same node, which is where a container created with LLU::Uninitialized has its pages after Async::fill.
+	 * @tparam  Pool - thread pool with a (threadCount, cpus) constructor, post and runPendingTask, like LLU::ThreadPool
+	 */
+	template<class Pool = ThreadPool>
+	class NumaPools {
+	public:
+		/**
+		 * Create one pool per NUMA node of the system
+		 * @param threadsPerNode - number of threads in every pool, 0 means one thread per logical CPU of the node
+		 * @see Topology::numaNodeCpus
+		 */
+		explicit NumaPools(unsigned threadsPerNode = 0) : NumaPools(Topology::numaNodeCpus(), threadsPerNode) {}
+
+		/**
+		 * Create one pool per group of logical CPUs, e.g. to use only a subset of nodes
+		 * @param nodeCpus - groups of logical CPUs, workers of the i-th pool are pinned to CPUs from nodeCpus[i], an empty list means a single pool
+		 * without pinning
+		 * @param threadsPerNode - number of threads in every pool, 0 means one thread per CPU in the group
+		 */
+		NumaPools(const std::vector<std::vector<int>>& nodeCpus, unsigned threadsPerNode) {
+			threadOffsets.push_back(0);
+			if (nodeCpus.empty()) {
+				addPool({}, threadsPerNode);
+			}
+			for (const auto& cpus : nodeCpus) {
+				addPool(cpus, threadsPerNode);
+			}
+		}
+
+		/// Get the number of nodes, i.e. of pools
+		[[nodiscard]] std::size_t nodeCount() const noexcept {
+			return pools.size();
+		}
+
+		/// Get the pool of given node
+		[[nodiscard]] Pool& node(std::size_t index) noexcept {
+			return *pools[index];
+		}
+
+		/// Get the total number of threads in all pools
+		[[nodiscard]] unsigned threadCount() const noexcept {
+			return threadOffsets.back();
+		}
+
+		/**
+		 * Get the part of the range [first, last) processed by given node
+		 * @param index - node index
+		 * @param first - first index of the range
+		 * @param last - index past the end of the range
+		 * @return subrange whose length is proportional to the number of threads of the node, subranges of consecutive nodes are adjacent
+		 */
+		template<typename Index>
+		[[nodiscard]] std::pair<Index, Index> partition(std::size_t index, Index first, Index last) const noexcept {
+			return {splitPoint(threadOffsets[index], first, last), splitPoint(threadOffsets[index + 1], first, last)};
+		}
+
+	private:
+		/// Add a pool pinned to given CPUs, a pool without CPUs is not pinned and by default gets one thread per logical CPU of the system
+		void addPool(const std::vector<int>& cpus, unsigned threadsPerNode) {
+			const auto defaultThreads = cpus.empty() ? std::thread::hardware_concurrency() : static_cast<unsigned>(cpus.size());
+			const auto threads = threadsPerNode > 0 ? threadsPerNode : std::max(defaultThreads, 1U);
+			pools.push_back(std::make_unique<Pool>(threads, cpus));
+			threadOffsets.push_back(threadOffsets.back() + threads);
+		}
+
+		/// Compute first + (last - first) * offset / threadCount() without overflow
+		template<typename Index>
+		Index splitPoint(unsigned offset, Index first, Index last) const noexcept {
+			const auto length = last - first;
+			const auto total = static_cast<Index>(threadCount());
+			const auto weight = static_cast<Index>(offset);
+			return first + length / total * weight + length % total * weight / total;
+		}
+
+		std::vector<std::unique_ptr<Pool>> pools;
+
+		/// Prefix sums of thread counts, threadOffsets[i] is the number of threads in pools before the i-th one
+		std::vector<unsigned> threadOffsets;
+	};
+
+	namespace Detail {
+		/// Call f(pool, first, last) once per node in a task of that node's pool, with the node's part of [first, last), and wait for all of them
+		template<class Pool, typename Index, typename F>
+		void runOnNodes(NumaPools<Pool>& pools, Index first, Index last, F& f) {
+			TaskGroup group;
+			for (std::size_t k = 0; k < pools.nodeCount(); ++k) {
+				auto [begin, end] = pools.partition(k, first, last);
+				if (begin < end) {
+					auto& pool = pools.node(k);
+					group.run(pool, [&pool, &f, begin = begin, end = end] { f(pool, begin, end); });
+				}
+			}
+			group.wait();
+		}
+	}  // namespace Detail
+
+	/**
+	 * @brief   Call \p f for every index in [first, last), processing the part of the range assigned to each node with the threads of that node.
+	 * @details The range is split between nodes with NumaPools::partition and each part is processed with parallelFor on the pool of its node.
+	 * Hence for a fixed range every index is always handled by the same node, which keeps the data of containers initialized with
+	 * Async::fill(NumaPools&, ...) in the memory local to the threads that use it.
+	 * @param   pools - node-local pools
+	 * @param   first - first index of the range
+	 * @param   last - index past the end of the range
+	 * @param   grain - maximal number of indices processed by a single task
+	 * @param   f - function to be called on each index
+	 * @note    The calling thread only waits, so this function must not be called from a worker of \p pools.
+	 */
+	template<class Pool, typename Index, typename F, typename = std::enable_if_t<std::is_integral_v<Index>>>
+	void parallelFor(NumaPools<Pool>& pools, Index first, Index last, typename std::common_type<Index>::type grain, F&& f) {
+		if (last <= first) {
+			return;
+		}
+		auto nodeFor = [grain, &f](Pool& pool, Index begin, Index end) { parallelFor(pool, begin, end, grain, f); };
+		Detail::runOnNodes(pools, first, last, nodeFor);
+	}
+
+	/**
+	 * @brief   Assign \p value to every element of a contiguous container, each node writing the part that it later processes.
+	 * @details Use it on containers created with LLU::Uninitialized to place the memory pages of each part of the container on the node
+	 * whose threads process that part in parallelFor(NumaPools&, ...) over the same range. Within a node the part is filled in chunks of \p grain
+	 * elements by the workers of the node.
+	 * @param   pools - node-local pools
+	 * @param   c - container with data() and size(), e.g. Tensor or NumericArray
+	 * @param   value - value to be assigned
+	 * @param   grain - number of elements filled by a single task
+	 * @note    The calling thread only waits, so this function must not be called from a worker of \p pools.
+	 */
+	template<class Pool, typename Container, typename T, typename = std::enable_if_t<Detail::has_data_and_size_v<Container>>>
+	void fill(NumaPools<Pool>& pools, Container& c, const T& value, std::ptrdiff_t grain) {
+		auto* data = c.data();
+		const auto chunk = grain > 0 ? grain : std::ptrdiff_t {1};
+		auto nodeFill = [data, chunk, &value](Pool& pool, std::ptrdiff_t begin, std::ptrdiff_t end) {
+			parallelFor(pool, std::ptrdiff_t {0}, (end - begin + chunk - 1) / chunk, 1, [data, begin, end, chunk, &value](std::ptrdiff_t k) {
+				const auto first = begin + k * chunk;
+				std::fill(data + first, data + std::min(first + chunk, end), value);
+			});
+		};
+		Detail::runOnNodes(pools, std::ptrdiff_t {0}, static_cast<std::ptrdiff_t>(c.size()), nodeFill);
+	}
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_NUMA_H
@@ -0,0 +1,441 @@
+/**
+ * @file	Pipeline.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Multi-stage pipelines whose stages run concurrently in a thread pool and pass items through bounded channels.
+ */
+#ifndef LLU_ASYNC_PIPELINE_H
+#define LLU_ASYNC_PIPELINE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "LLU/Async/Algorithms.h"
+#include "LLU/Async/BoundedQueue.h"
+#include "LLU/Async/Cancellation.h"
+#include "LLU/Async/TaskGroup.h"
+
+namespace LLU::Async {
+
+	/// Default number of items that may wait in a single channel between two stages of a pipeline
+	inline constexpr std::size_t defaultChannelCapacity = 64;
+
+	/// Stage of a pipeline, created with Async::stage or Async::orderedStage
+	template<typename F>
+	struct PipelineStage {
+		/// Function that takes an item produced by the previous stage and returns the item for the next one
+		F f;
+
+		/// Maximal number of items processed by the stage at the same time
+		unsigned parallelism = 1;
+
+		/// Whether the stage gets the items in the order in which the source produced them
+		bool ordered = false;
+	};
+
+	/**
+	 * Create a stage that processes up to \p parallelism items at the same time, in any order
+	 * @param f - function that takes an item produced by the previous stage and returns the item for the next one, or void in the last stage
+	 * @param parallelism - maximal number of concurrent calls to \p f, 1 means that the calls never overlap
+	 * @return stage to be passed to runPipeline
+	 */
+	template<typename F>
+	PipelineStage<std::decay_t<F>> stage(F&& f, unsigned parallelism = 1) {
+		return {std::forward<F>(f), parallelism > 0 ? parallelism : 1, false};
+	}
+
+	/**
+	 * Create a serial stage that gets the items in the order in which the source produced them, e.g. to write the results to a file.
+	 * Items that overtook each other in earlier parallel stages are set aside until their predecessors arrive.
+	 * @param f - function that takes an item produced by the previous stage and returns the item for the next one, or void in the last stage
+	 * @return stage to be passed to runPipeline
+	 */
+	template<typename F>
+	PipelineStage<std::decay_t<F>> orderedStage(F&& f) {
+		return {std::forward<F>(f), 1, true};
+	}
+
+	namespace Detail {
+		/// Item of a pipeline together with its position in the sequence produced by the source
+		template<typename T>
+		struct Sequenced {
+			std::size_t seq;
+			T value;
+		};
+
+		/**
+		 * Bounded queue between two stages. The occupancy counts the items in the queue and the items being produced for it, so a producer
+		 * that reserved a slot never waits for a consumer to make room.
+		 */
+		template<typename T, std::size_t Capacity>
+		struct Channel {
+			BoundedQueue<Sequenced<T>, Capacity, FullQueuePolicy::Reject> queue;
+			std::atomic<std::size_t> occupancy = 0;
+
+			bool reserve() noexcept {
+				if (occupancy.fetch_add(1) >= Capacity) {
+					occupancy.fetch_sub(1);
+					return false;
+				}
+				return true;
+			}
+
+			void release() noexcept {
+				occupancy.fetch_sub(1);
+			}
+
+			/// Push an item for which a slot was reserved
+			void push(Sequenced<T>& item) noexcept {
+				// Consumers finish popping out of order, so the slot for this item may still be emptied by a consumer that claimed it before
+				// the consumer which released the reservation. It is only a matter of moving one item out.
+				while (!queue.tryPush(item)) {
+					std::this_thread::yield();
+				}
+			}
+
+			[[nodiscard]] bool hasRoom() const noexcept {
+				return occupancy.load() < Capacity;
+			}
+		};
+
+		/// Compute the types of items that enter every stage, the first one is the type produced by the source
+		template<typename In, typename... Stages>
+		struct StageInputs {
+			using type = std::tuple<>;
+		};
+
+		template<typename In, typename Stage, typename... Stages>
+		struct StageInputs<In, Stage, Stages...> {
+			using Out = std::invoke_result_t<decltype(std::declval<Stage&>().f)&, In>;
+			using type = decltype(std::tuple_cat(std::declval<std::tuple<In>>(), std::declval<typename StageInputs<Out, Stages...>::type>()));
+		};
+
+		/// Bookkeeping of a stage: the number of running workers and, for ordered stages, items that arrived too early
+		template<typename In>
+		struct StageState {
+			std::atomic<unsigned> active = 0;
+			std::map<std::size_t, In> early;
+			std::size_t nextSeq = 0;
+
+			/// Whether the next item in order is among the early ones, set by the only worker of an ordered stage before it stops
+			std::atomic_bool nextReady = false;
+		};
+
+		/// Type of items produced by the source
+		template<typename Source>
+		using source_value_t = typename std::invoke_result_t<Source&>::value_type;
+
+		/**
+		 * Single run of a pipeline. No worker ever waits for another one: a worker of a stage stops when its input channel is empty or its output
+		 * channel is full, and stages are started again by their neighbours when items are pushed or popped. Hence stages never occupy threads
+		 * of the pool without doing work, and a pipeline with any number of stages runs on a pool with any number of threads.
+		 *
+		 * Ordered stages move items that arrive too early out of their input channel, otherwise the item they wait for could get stuck behind
+		 * a full channel. Instead, the source stops when maxInFlight items are in the pipeline, which bounds the number of early items.
+		 */
+		template<std::size_t Capacity, typename Pool, typename Source, typename... Stages>
+		class PipelineRun {
+			using Inputs = typename StageInputs<source_value_t<Source>, Stages...>::type;
+			static constexpr std::size_t stageCount = sizeof...(Stages);
+
+			/// Maximal number of items that left the source but were not processed by the last stage yet
+			static constexpr std::size_t maxInFlight = Capacity * stageCount;
+
+			template<std::size_t I>
+			using input_t = std::tuple_element_t<I, Inputs>;
+
+			template<std::size_t... I>
+			static auto makeChannels(std::index_sequence<I...> /*unused*/) {
+				return std::make_tuple(std::make_unique<Channel<input_t<I>, Capacity>>()...);
+			}
+
+			template<std::size_t... I>
+			static auto makeStates(std::index_sequence<I...> /*unused*/) {
+				return std::make_tuple(std::make_unique<StageState<input_t<I>>>()...);
+			}
+
+		public:
+			PipelineRun(Pool& p, CancellationToken t, Source& src, std::tuple<Stages&...> s)
+				: pool(p), token(std::move(t)), source(src), stages(std::move(s)), channels(makeChannels(std::index_sequence_for<Stages...> {})),
+				  states(makeStates(std::index_sequence_for<Stages...> {})) {}
+
+			void run() {
+				scheduleSource();
+				group.wait(pool);
+				if (failure) {
+					std::rethrow_exception(failure);
+				}
+				if (stopped.load()) {
+					throw TaskCancelled {};
+				}
+			}
+
+		private:
+			Pool& pool;
+			CancellationToken token;
+			Source& source;
+			std::tuple<Stages&...> stages;
+			decltype(makeChannels(std::index_sequence_for<Stages...> {})) channels;
+			decltype(makeStates(std::index_sequence_for<Stages...> {})) states;
+			TaskGroup group;
+
+			std::atomic<unsigned> sourceActive = 0;
+			std::atomic_bool sourceDone = false;
+			std::size_t produced = 0;
+			std::atomic<std::size_t> inFlight = 0;
+
+			std::atomic_bool stopped = false;
+			std::mutex failureMutex;
+			std::exception_ptr failure;
+
+			template<std::size_t I>
+			auto& channel() noexcept {
+				return *std::get<I>(channels);
+			}
+
+			template<std::size_t I>
+			auto& state() noexcept {
+				return *std::get<I>(states);
+			}
+
+			bool shouldStop() {
+				if (!stopped.load() && (token.cancelled() || poolCancelled())) {
+					stopped.store(true);
+				}
+				return stopped.load();
+			}
+
+			bool poolCancelled() const {
+				if constexpr (is_cancellable<Pool>::value) {
+					return pool.cancelled();
+				} else {
+					return false;
+				}
+			}
+
+			void fail(std::exception_ptr e) {
+				{
+					std::lock_guard<std::mutex> lock {failureMutex};
+					if (!failure) {
+						failure = std::move(e);
+					}
+				}
+				stopped.store(true);
+			}
+
+			/// Start a worker if fewer than \p limit workers are running
+			template<typename Worker>
+			void start(std::atomic<unsigned>& active, unsigned limit, Worker worker) {
+				// pairs with the fence in finishWorker, so that either the new item is seen by a stopping worker or this thread sees it stopped
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				auto current = active.load();
+				while (current < limit) {
+					if (active.compare_exchange_weak(current, current + 1)) {
+						group.run(pool, worker);
+						return;
+					}
+				}
+			}
+
+			void scheduleSource() {
+				start(sourceActive, 1, [this] { sourceWorker(); });
+			}
+
+			template<std::size_t I>
+			void scheduleStage() {
+				start(state<I>().active, std::get<I>(stages).parallelism, [this] { stageWorker<I>(); });
+			}
+
+			/// Schedule the stage in front of the channel I, which might have stopped because the channel was full
+			template<std::size_t I>
+			void scheduleProducer() {
+				if constexpr (I == 0) {
+					scheduleSource();
+				} else {
+					scheduleStage<I - 1>();
+				}
+			}
+
+			template<typename HasWork, typename Restart>
+			void finishWorker(std::atomic<unsigned>& active, HasWork hasWork, Restart restart) {
+				active.fetch_sub(1);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (!stopped.load() && hasWork()) {
+					restart();
+				}
+			}
+
+			/// Check whether the source may produce another item
+			bool sourceMayRun() {
+				return !sourceDone.load() && inFlight.load() < maxInFlight;
+			}
+
+			void sourceWorker() {
+				auto& out = channel<0>();
+				while (!shouldStop() && sourceMayRun() && out.reserve()) {
+					try {
+						auto item = source();
+						if (!item) {
+							out.release();
+							sourceDone.store(true);
+							break;
+						}
+						inFlight.fetch_add(1);
+						Sequenced<input_t<0>> s {produced++, std::move(*item)};
+						out.push(s);
+					} catch (...) {
+						out.release();
+						fail(std::current_exception());
+						break;
+					}
+					scheduleStage<0>();
+				}
+				finishWorker(
+					sourceActive, [this, &out] { return sourceMayRun() && out.hasRoom(); }, [this] { scheduleSource(); });
+			}
+
+			/// Pop an item from the input channel of stage I and let the previous stage know that there is room for another one
+			template<std::size_t I>
+			bool pop(Sequenced<input_t<I>>& s) {
+				auto& in = channel<I>();
+				if (!in.queue.tryPop(s)) {
+					return false;
+				}
+				in.release();
+				scheduleProducer<I>();
+				return true;
+			}
+
+			/// Get the next item for stage I, respecting the order of the source if the stage is ordered
+			template<std::size_t I>
+			std::optional<Sequenced<input_t<I>>> take() {
+				auto& st = state<I>();
+				Sequenced<input_t<I>> s {0, input_t<I> {}};
+				if (!std::get<I>(stages).ordered) {
+					if (!pop<I>(s)) {
+						return std::nullopt;
+					}
+					return s;
+				}
+				while (true) {
+					if (auto it = st.early.find(st.nextSeq); it != st.early.end()) {
+						s = {st.nextSeq++, std::move(it->second)};
+						st.early.erase(it);
+						return s;
+					}
+					if (!pop<I>(s)) {
+						return std::nullopt;
+					}
+					if (s.seq == st.nextSeq) {
+						++st.nextSeq;
+						return s;
+					}
+					st.early.emplace(s.seq, std::move(s.value));
+				}
+			}
+
+			template<std::size_t I>
+			void stageWorker() {
+				auto& in = channel<I>();
+				auto& st = state<I>();
+				auto& stage = std::get<I>(stages);
+				while (!shouldStop()) {
+					if constexpr (I + 1 < stageCount) {
+						if (!channel<I + 1>().reserve()) {
+							break;
+						}
+					}
+					auto item = take<I>();
+					if (!item) {
+						if constexpr (I + 1 < stageCount) {
+							channel<I + 1>().release();
+						}
+						break;
+					}
+					try {
+						if constexpr (I + 1 < stageCount) {
+							Sequenced<input_t<I + 1>> s {item->seq, stage.f(std::move(item->value))};
+							channel<I + 1>().push(s);
+						} else {
+							stage.f(std::move(item->value));
+						}
+					} catch (...) {
+						if constexpr (I + 1 < stageCount) {
+							channel<I + 1>().release();
+						}
+						fail(std::current_exception());
+						break;
+					}
+					if constexpr (I + 1 < stageCount) {
+						scheduleStage<I + 1>();
+					} else {
+						inFlight.fetch_sub(1);
+						scheduleSource();
+					}
+				}
+				if (stage.ordered) {
+					st.nextReady.store(st.early.count(st.nextSeq) > 0);
+				}
+				finishWorker(
+					st.active,
+					[this, &in, &st] {
+						bool roomForOutput = true;
+						if constexpr (I + 1 < stageCount) {
+							roomForOutput = channel<I + 1>().hasRoom();
+						}
+						return roomForOutput && (!in.queue.empty() || st.nextReady.load());
+					},
+					[this] { scheduleStage<I>(); });
+			}
+		};
+	}  // namespace Detail
+
+	/**
+	 * @brief   Run a pipeline in which a source produces items and every stage transforms the items produced by the previous one.
+	 * @details All stages run at the same time on the threads of the pool, so e.g. reading the next chunk of data overlaps with decoding and
+	 * processing of the previous ones. Consecutive stages are connected with lock-free bounded channels that hold at most \p Capacity items.
+	 * When a channel is full, the stage that feeds it pauses until the next stage takes some item, so slow stages hold back the fast ones and the
+	 * memory used by the pipeline stays bounded. Paused stages do not occupy threads of the pool, hence the pool may have fewer threads than
+	 * the stages need in total.
+	 *
+	 * The source is never called concurrently. Stages created with Async::stage process up to the requested number of items at once, in any
+	 * order; ordered stages created with Async::orderedStage get the items exactly in the order of the source.
+	 *
+	 * @tparam  Capacity - maximal number of items waiting between two stages, must be a power of 2
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  Source - callable that returns std::optional<T>, an empty optional marks the end of the input
+	 * @param   pool - thread pool that runs the stages, the calling thread also runs its tasks while it waits for the pipeline to finish
+	 * @param   token - token that stops the pipeline when cancelled, e.g. the cancellation token of the pool, which waitWithAbortCheck cancels
+	 * after a user abort
+	 * @param   source - function that produces consecutive items
+	 * @param   stages - at least one stage, the result of the last stage is discarded
+	 * @throws  the first exception thrown by the source or any stage, after all running stages stop
+	 * @throws  Async::TaskCancelled - if the pipeline was stopped by \p token or by cancellation of the pool
+	 * @note    Items are moved between stages, so their types must be nothrow move constructible and default constructible.
+	 */
+	template<std::size_t Capacity = defaultChannelCapacity, typename Pool, typename Source, typename... Stages>
+	void runPipeline(Pool& pool, CancellationToken token, Source&& source, PipelineStage<Stages>... stages) {
+		static_assert(sizeof...(Stages) > 0, "A pipeline needs at least one stage.");
+		auto stageTuple = std::tie(stages...);
+		Detail::PipelineRun<Capacity, Pool, std::remove_reference_t<Source>, PipelineStage<Stages>...> pipeline {pool, std::move(token), source,
+																													stageTuple};
+		pipeline.run();
+	}
+
+	/// @copydoc runPipeline(Pool&, CancellationToken, Source&&, PipelineStage<Stages>...)
+	template<std::size_t Capacity = defaultChannelCapacity, typename Pool, typename Source, typename... Stages>
+	void runPipeline(Pool& pool, Source&& source, PipelineStage<Stages>... stages) {
+		runPipeline<Capacity>(pool, CancellationToken {}, std::forward<Source>(source), std::move(stages)...);
+	}
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_PIPELINE_H
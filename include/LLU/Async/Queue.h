@@ -7,6 +7,7 @@
 #define LLU_ASYNC_QUEUE_H
 
 #include <condition_variable>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 
@@ -43,6 +44,18 @@ namespace LLU::Async {
 		 */
 		bool tryPop(value_type& value);
 
+		/**
+		 * @brief       Get up to \p maxCount elements from the queue, locking the head only once.
+		 * The nodes are unlinked under the lock and the elements are moved to \p out after it is released.
+		 * If data is not available in the queue, the calling thread will not wait.
+		 * @tparam      OutputIt - output iterator type
+		 * @param[out]  out - iterator to which the popped elements are written, in queue order
+		 * @param       maxCount - maximal number of elements to pop
+		 * @return      Number of elements popped.
+		 */
+		template<typename OutputIt>
+		std::size_t tryPopBulk(OutputIt out, std::size_t maxCount);
+
 		/**
 		 * @brief   Get data from the queue, possibly waiting for it.
 		 * @return  Shared pointer to the data from the queue's head
@@ -62,6 +75,16 @@ namespace LLU::Async {
 		 */
 		void push(value_type new_value);
 
+		/**
+		 * @brief   Push all elements from a range to the end of the queue, locking the tail only once.
+		 * All nodes are allocated before the lock is taken and waiting consumers are notified once for the whole batch.
+		 * @tparam  InputIt - input iterator type
+		 * @param   first - iterator to the first element, elements are moved from
+		 * @param   last - iterator past the last element
+		 */
+		template<typename InputIt>
+		void pushBulk(InputIt first, InputIt last);
+
 		/**
 		 * @brief   Check if the queue is empty.
 		 * @return  True iff the queue is empty i.e. has no data to be popped.
@@ -141,6 +164,30 @@ namespace LLU::Async {
 		data_cond.notify_one();
 	}
 
+	template<typename T>
+	template<typename InputIt>
+	void ThreadsafeQueue<T>::pushBulk(InputIt first, InputIt last) {
+		if (first == last) {
+			return;
+		}
+		// the first element goes to the current dummy tail node, the rest is linked into a new chain ending with a new dummy node
+		std::shared_ptr<T> first_data(std::make_shared<T>(std::move(*first)));
+		std::unique_ptr<Node> chain(new Node);
+		Node* chain_tail = chain.get();
+		for (++first; first != last; ++first) {
+			chain_tail->data = std::make_shared<T>(std::move(*first));
+			chain_tail->next.reset(new Node);
+			chain_tail = chain_tail->next.get();
+		}
+		{
+			std::lock_guard<std::mutex> tail_lock(tail_mutex);
+			tail->data = std::move(first_data);
+			tail->next = std::move(chain);
+			tail = chain_tail;
+		}
+		data_cond.notify_all();
+	}
+
 	template<typename T>
 	std::shared_ptr<T> ThreadsafeQueue<T>::waitPop() {
 		std::unique_ptr<Node> const old_head = waitPopHead();
@@ -164,6 +211,33 @@ namespace LLU::Async {
 		return static_cast<bool>(old_head);
 	}
 
+	template<typename T>
+	template<typename OutputIt>
+	std::size_t ThreadsafeQueue<T>::tryPopBulk(OutputIt out, std::size_t maxCount) {
+		std::unique_ptr<Node> chain;
+		std::size_t count = 0;
+		{
+			std::lock_guard<std::mutex> head_lock(head_mutex);
+			const Node* const current_tail = getTail();
+			if (maxCount == 0 || head.get() == current_tail) {
+				return 0;
+			}
+			// detach nodes [head, last] from the list, the dummy tail node always stays in the queue
+			Node* last = head.get();
+			for (count = 1; count < maxCount && last->next.get() != current_tail; ++count) {
+				last = last->next.get();
+			}
+			chain = std::move(head);
+			head = std::move(last->next);
+		}
+		while (chain) {
+			*out = std::move(*chain->data);
+			++out;
+			chain = std::move(chain->next);
+		}
+		return count;
+	}
+
 	template<typename T>
 	bool ThreadsafeQueue<T>::empty() const {
 		std::lock_guard<std::mutex> head_lock(head_mutex);
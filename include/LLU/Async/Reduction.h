@@ -0,0 +1,180 @@
+/**
+ * @file	Reduction.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Parallel sums and dot products of containers whose results do not depend on the number of threads or the order of tasks.
+ */
+#ifndef LLU_ASYNC_REDUCTION_H
+#define LLU_ASYNC_REDUCTION_H
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <vector>
+
+#include "LLU/Async/Algorithms.h"
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/LibraryData.h"
+
+namespace LLU::Async {
+
+	/// Number of consecutive elements summed by a single leaf of the summation tree in reproducibleSum and reproducibleDot
+	inline constexpr mint reproducibleBlockSize = 1 << 12;
+
+	/// Default number of blocks of reproducibleBlockSize elements processed by a single task in reproducibleSum and reproducibleDot
+	inline constexpr mint defaultReductionGrain = 16;
+
+	/// Algorithm used to add up floating-point numbers in reproducibleSum and reproducibleDot
+	enum class Summation {
+		Pairwise,	 ///< recursive pairwise summation, the error grows with the logarithm of the number of elements
+		Kahan		 ///< compensated summation, slower but the error does not depend on the number of elements
+	};
+
+	namespace Detail {
+		/// Number of independent accumulators in summation kernels, so that consecutive additions can run in parallel in SIMD registers
+		inline constexpr mint summationLanes = 8;
+
+		/// Ranges not longer than this are summed directly by pairwiseSum
+		inline constexpr mint pairwiseLeafSize = 128;
+
+		/// Sum term(first), ..., term(first + n - 1) with summationLanes accumulators, element i goes to accumulator i % summationLanes
+		template<typename T, typename Term>
+		T laneSum(const Term& term, mint first, mint n) {
+			std::array<T, summationLanes> acc {};
+			mint i = 0;
+			for (; i + summationLanes <= n; i += summationLanes) {
+				for (mint j = 0; j < summationLanes; ++j) {
+					acc[j] += term(first + i + j);
+				}
+			}
+			for (mint j = 0; i < n; ++i, ++j) {
+				acc[j] += term(first + i);
+			}
+			return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+		}
+
+		/// Sum term(first), ..., term(first + n - 1) by halving the range down to pairwiseLeafSize elements
+		template<typename T, typename Term>
+		T pairwiseSum(const Term& term, mint first, mint n) {
+			if (n <= pairwiseLeafSize) {
+				return laneSum<T>(term, first, n);
+			}
+			mint half = n / 2;
+			half -= half % summationLanes;
+			return pairwiseSum<T>(term, first, half) + pairwiseSum<T>(term, first + half, n - half);
+		}
+
+		/// Running compensated (Kahan) sum
+		template<typename T>
+		struct KahanAccumulator {
+			T sum {};
+			T compensation {};
+
+			void add(const T& x) {
+				const T y = x - compensation;
+				const T t = sum + y;
+				compensation = (t - sum) - y;
+				sum = t;
+			}
+		};
+
+		/// Sum term(first), ..., term(first + n - 1) with summationLanes compensated accumulators
+		template<typename T, typename Term>
+		T kahanSum(const Term& term, mint first, mint n) {
+			std::array<T, summationLanes> sum {};
+			std::array<T, summationLanes> compensation {};
+			auto addToLane = [&sum, &compensation](mint j, const T& x) {
+				const T y = x - compensation[j];
+				const T t = sum[j] + y;
+				compensation[j] = (t - sum[j]) - y;
+				sum[j] = t;
+			};
+			mint i = 0;
+			for (; i + summationLanes <= n; i += summationLanes) {
+				for (mint j = 0; j < summationLanes; ++j) {
+					addToLane(j, term(first + i + j));
+				}
+			}
+			for (mint j = 0; i < n; ++i, ++j) {
+				addToLane(j, term(first + i));
+			}
+			KahanAccumulator<T> total;
+			for (mint j = 0; j < summationLanes; ++j) {
+				total.add(sum[j]);
+				total.add(-compensation[j]);
+			}
+			return total.sum;
+		}
+
+		/**
+		 * Sum term(0), ..., term(n - 1). The range is cut into blocks of reproducibleBlockSize elements, which are summed in parallel, and the
+		 * block sums are then added up in a fixed order. Neither step depends on the pool or on \p grain, hence the result is always the same.
+		 */
+		template<typename T, typename Pool, typename Term>
+		T reproducibleReduce(Pool& pool, mint n, Summation method, mint grain, const Term& term) {
+			const mint blocks = (n + reproducibleBlockSize - 1) / reproducibleBlockSize;
+			std::vector<T> partial(static_cast<std::size_t>(blocks));
+			parallelFor(pool, mint {0}, blocks, grain, [&partial, &term, method, n](mint b) {
+				const mint first = b * reproducibleBlockSize;
+				const mint length = std::min(reproducibleBlockSize, n - first);
+				partial[b] = method == Summation::Kahan ? kahanSum<T>(term, first, length) : pairwiseSum<T>(term, first, length);
+			});
+			if (method == Summation::Kahan) {
+				KahanAccumulator<T> total;
+				for (const auto& p : partial) {
+					total.add(p);
+				}
+				return total.sum;
+			}
+			return pairwiseSum<T>([&partial](mint b) { return partial[b]; }, 0, blocks);
+		}
+	}  // namespace Detail
+
+	/**
+	 * @brief   Sum all elements of a contiguous container in parallel, with a result that is identical for every pool, thread count and grain
+	 * @details The shape of the summation tree depends only on the number of elements: blocks of reproducibleBlockSize elements are summed
+	 * in parallel with vectorizable kernels that use a fixed number of accumulators, and the block sums are combined in a fixed order.
+	 * Hence repeated runs give bit-exact results, as long as the code is compiled with the same flags.
+	 * @note    Do not compile code that calls this function with -ffast-math or similar flags that allow the compiler to reassociate additions,
+	 * as they break both reproducibility and compensated summation.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  Container - contiguous container with data() and size(), e.g. Tensor or NumericArray
+	 * @param   pool - thread pool to run the tasks
+	 * @param   c - container
+	 * @param   method - summation algorithm
+	 * @param   grain - number of blocks summed by a single task, it affects only the performance
+	 * @return  sum of all elements, of the element type of the container
+	 */
+	template<typename Pool, typename Container, typename = std::enable_if_t<Detail::has_data_and_size_v<Container>>>
+	auto reproducibleSum(Pool& pool, const Container& c, Summation method = Summation::Pairwise, mint grain = defaultReductionGrain) {
+		using T = std::remove_cv_t<std::remove_reference_t<decltype(*c.data())>>;
+		const auto* data = c.data();
+		return Detail::reproducibleReduce<T>(pool, static_cast<mint>(c.size()), method, grain, [data](mint i) { return data[i]; });
+	}
+
+	/**
+	 * @brief   Compute the dot product of two contiguous containers in parallel, with a result that is identical for every pool, thread count
+	 * and grain
+	 * @details Products of corresponding elements are summed the same way as in reproducibleSum. Complex elements are not conjugated.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @param   pool - thread pool to run the tasks
+	 * @param   a - first container with data() and size(), e.g. a Tensor of any rank
+	 * @param   b - second container with the same number of elements
+	 * @param   method - summation algorithm
+	 * @param   grain - number of blocks summed by a single task, it affects only the performance
+	 * @return  sum of a[i] * b[i]
+	 * @throws  ErrorName::DimensionsError - if the containers have different numbers of elements
+	 */
+	template<typename Pool, typename ContainerA, typename ContainerB,
+			 typename = std::enable_if_t<Detail::has_data_and_size_v<ContainerA> && Detail::has_data_and_size_v<ContainerB>>>
+	auto reproducibleDot(Pool& pool, const ContainerA& a, const ContainerB& b, Summation method = Summation::Pairwise, mint grain = defaultReductionGrain) {
+		if (a.size() != b.size()) {
+			ErrorManager::throwException(ErrorName::DimensionsError);
+		}
+		const auto* x = a.data();
+		const auto* y = b.data();
+		using T = std::remove_cv_t<decltype(x[0] * y[0])>;
+		return Detail::reproducibleReduce<T>(pool, static_cast<mint>(a.size()), method, grain, [x, y](mint i) { return x[i] * y[i]; });
+	}
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_REDUCTION_H
@@ -0,0 +1,58 @@
+/**
+ * @file	SharedPool.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Lazily started thread pool shared by all code in the library.
+ */
+#ifndef LLU_ASYNC_SHAREDPOOL_H
+#define LLU_ASYNC_SHAREDPOOL_H
+
+#include "LLU/Async/ThreadPool.h"
+
+namespace LLU::Async {
+
+	/**
+	 * Name of the environment variable with the number of worker threads of the shared pool. It is read when the pool starts, so it can be set
+	 * from the Wolfram Language with SetEnvironment before the first parallel evaluation, e.g. to split the cores between several paclets.
+	 * Values that are not positive integers or that exceed 16 threads per logical CPU are ignored.
+	 */
+	inline constexpr const char* sharedPoolThreadsVariable = "LLU_SHARED_POOL_THREADS";
+
+	/**
+	 * @brief   Get the thread pool shared by all code in the library, starting it on first use.
+	 * @details Worker threads are spawned only when this function is called for the first time, so paclets that never take their parallel code
+	 * paths pay nothing for the pool, neither in WolframLibrary_initialize nor later. Prefer this pool over creating new pools in library functions.
+	 * @return  reference to the shared pool, valid until shutdownSharedPool is called
+	 */
+	LLU::ThreadPool& sharedPool();
+
+	/**
+	 * Get the number of worker threads the shared pool has or will have when it starts.
+	 * This is the value passed to setSharedPoolThreadCount, or the value of LLU_SHARED_POOL_THREADS, or the number of logical CPUs, in that order.
+	 * @return number of threads, at least 1
+	 */
+	unsigned sharedPoolThreadCount();
+
+	/**
+	 * Request given number of worker threads for the shared pool. This overrides the environment variable but has no effect on a pool that is
+	 * already running.
+	 * @param threadCount - number of threads, 0 restores the default
+	 * @return true iff the pool has not started yet, so the request will be honoured
+	 */
+	bool setSharedPoolThreadCount(unsigned threadCount);
+
+	/**
+	 * Check if the shared pool is running
+	 * @return true iff sharedPool() was called and the pool has not been shut down since
+	 */
+	bool sharedPoolStarted() noexcept;
+
+	/**
+	 * Stop the shared pool, waiting for its worker threads to finish. Call it from WolframLibrary_uninitialize if the pool may have been used,
+	 * because joining threads from static destructors during library unloading can deadlock on some platforms.
+	 * No other thread may use the pool at that time. A later call to sharedPool() starts a new pool.
+	 */
+	void shutdownSharedPool();
+
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_SHAREDPOOL_H
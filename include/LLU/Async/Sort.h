@@ -0,0 +1,412 @@
+/**
+ * @file	Sort.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Parallel sorting, prefix sums and stable partitioning of contiguous containers, built on top of the thread pools from LLU::Async.
+ *
+ * All algorithms cut the container into chunks of grain elements, process the chunks with parallelFor and only combine per-chunk results
+ * (counts or partial sums) sequentially, so they scale with the number of threads as long as the grain is big enough to amortize the tasks.
+ */
+#ifndef LLU_ASYNC_SORT_H
+#define LLU_ASYNC_SORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "LLU/Async/Algorithms.h"
+#include "LLU/ErrorLog/ErrorManager.h"
+
+namespace LLU::Async {
+
+	namespace Detail {
+		/// Type of elements of a contiguous container, without const
+		template<typename Container>
+		using element_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<Container&>().data())>>;
+
+		/// Sorting algorithms use at most this many chunks, so that the per-chunk histograms stay small for very large containers
+		inline constexpr std::ptrdiff_t maxSortChunks = 1024;
+
+		/// Integer types that can be sorted with radixSort
+		template<typename T>
+		inline constexpr bool is_radix_sortable_v = std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+		/// Number of chunks of \p chunk elements that cover \p n elements
+		inline std::ptrdiff_t chunkCount(std::ptrdiff_t n, std::ptrdiff_t chunk) {
+			return (n + chunk - 1) / chunk;
+		}
+
+		/// Size of chunks for sorting algorithms: at least \p grain elements and at most maxSortChunks chunks
+		inline std::ptrdiff_t sortChunkSize(std::ptrdiff_t n, std::ptrdiff_t grain) {
+			return std::max({grain, std::ptrdiff_t {1}, chunkCount(n, maxSortChunks)});
+		}
+
+		/// Allocate an uninitialized buffer for n elements of trivial types, the scatter passes overwrite every element anyway
+		template<typename T>
+		std::unique_ptr<T[]> makeBuffer(std::ptrdiff_t n) {
+			return std::unique_ptr<T[]>(new T[static_cast<std::size_t>(n)]);
+		}
+
+		/// Move [0, n) from \p src to \p dst in parallel
+		template<typename Pool, typename T>
+		void parallelMove(Pool& pool, T* src, T* dst, std::ptrdiff_t n, std::ptrdiff_t chunk) {
+			parallelFor(pool, std::ptrdiff_t {0}, chunkCount(n, chunk), 1, [=](std::ptrdiff_t k) {
+				const auto first = k * chunk;
+				std::move(src + first, src + std::min(n, first + chunk), dst + first);
+			});
+		}
+
+		/// Reduce every chunk of [0, n) except for the last one, which does not contribute to the prefix of any other chunk
+		template<typename T, typename Pool, typename In, typename Op>
+		std::vector<T> chunkSums(Pool& pool, const In* in, std::ptrdiff_t n, std::ptrdiff_t chunk, Op& op) {
+			std::vector<T> sums(static_cast<std::size_t>(chunkCount(n, chunk) - 1));
+			parallelFor(pool, std::ptrdiff_t {0}, static_cast<std::ptrdiff_t>(sums.size()), 1, [&sums, in, chunk, &op](std::ptrdiff_t k) {
+				const auto first = k * chunk;
+				T acc = in[first];
+				for (auto i = first + 1; i < first + chunk; ++i) {
+					acc = op(std::move(acc), in[i]);
+				}
+				sums[k] = std::move(acc);
+			});
+			return sums;
+		}
+
+		/// Map an integer to an unsigned key with the same order, by flipping the sign bit of signed types
+		template<typename T>
+		std::make_unsigned_t<T> radixKey(T x) noexcept {
+			using U = std::make_unsigned_t<T>;
+			if constexpr (std::is_signed_v<T>) {
+				return static_cast<U>(static_cast<U>(x) ^ (U {1} << (std::numeric_limits<U>::digits - 1)));
+			} else {
+				return x;
+			}
+		}
+
+		/// Sort a contiguous range with a comparison sort: classify elements into buckets delimited by sampled splitters, then sort buckets in parallel
+		template<typename Pool, typename T, typename Compare>
+		void sampleSort(Pool& pool, T* data, std::ptrdiff_t n, std::ptrdiff_t grain, Compare& comp) {
+			const auto chunk = sortChunkSize(n, grain);
+			const auto chunks = chunkCount(n, chunk);
+			if (chunks < 2) {
+				std::sort(data, data + n, comp);
+				return;
+			}
+
+			// Sample oversampling * (splitters + 1) elements at pseudo-random, but reproducible, positions and take evenly spaced splitters.
+			// Equal splitters are merged and every splitter gets a bucket of its own for equal elements, so inputs with few distinct values
+			// do not end up in one huge bucket. With at most 127 splitters bucket indices fit in a byte.
+			constexpr std::ptrdiff_t oversampling = 16;
+			const auto splitterCount = std::min<std::ptrdiff_t>(chunks - 1, 127);
+			std::vector<T> samples;
+			samples.reserve(static_cast<std::size_t>(oversampling * (splitterCount + 1)));
+			std::minstd_rand rng {static_cast<std::minstd_rand::result_type>(n)};
+			std::uniform_int_distribution<std::ptrdiff_t> position {0, n - 1};
+			for (std::ptrdiff_t i = 0; i < oversampling * (splitterCount + 1); ++i) {
+				samples.push_back(data[position(rng)]);
+			}
+			std::sort(samples.begin(), samples.end(), comp);
+			std::vector<T> splitters;
+			for (std::ptrdiff_t j = 1; j <= splitterCount; ++j) {
+				const auto& s = samples[static_cast<std::size_t>(j * oversampling)];
+				if (splitters.empty() || comp(splitters.back(), s)) {
+					splitters.push_back(s);
+				}
+			}
+			// bucket 2k holds elements between splitters k - 1 and k, bucket 2k + 1 holds elements equal to splitter k
+			const auto buckets = static_cast<std::ptrdiff_t>(2 * splitters.size() + 1);
+			auto bucketOf = [&splitters, &comp](const T& x) {
+				const auto k = std::upper_bound(splitters.begin(), splitters.end(), x, comp) - splitters.begin();
+				return static_cast<std::uint8_t>(k > 0 && !comp(splitters[k - 1], x) ? 2 * k - 1 : 2 * k);
+			};
+
+			auto ids = makeBuffer<std::uint8_t>(n);
+			std::vector<std::ptrdiff_t> offsets(static_cast<std::size_t>(chunks * buckets));
+			parallelFor(pool, std::ptrdiff_t {0}, chunks, 1, [&, chunk, buckets](std::ptrdiff_t k) {
+				auto* histogram = offsets.data() + k * buckets;
+				for (auto i = k * chunk; i < std::min(n, (k + 1) * chunk); ++i) {
+					ids[i] = bucketOf(data[i]);
+					++histogram[ids[i]];
+				}
+			});
+			std::vector<std::ptrdiff_t> bucketStart(static_cast<std::size_t>(buckets + 1));
+			std::ptrdiff_t running = 0;
+			for (std::ptrdiff_t b = 0; b < buckets; ++b) {
+				bucketStart[b] = running;
+				for (std::ptrdiff_t k = 0; k < chunks; ++k) {
+					running += std::exchange(offsets[k * buckets + b], running);
+				}
+			}
+			bucketStart[buckets] = n;
+
+			auto buffer = makeBuffer<T>(n);
+			parallelFor(pool, std::ptrdiff_t {0}, chunks, 1, [&, chunk, buckets](std::ptrdiff_t k) {
+				auto* next = offsets.data() + k * buckets;
+				for (auto i = k * chunk; i < std::min(n, (k + 1) * chunk); ++i) {
+					buffer[next[ids[i]]++] = std::move(data[i]);
+				}
+			});
+			ids.reset();
+			parallelFor(pool, std::ptrdiff_t {0}, buckets, 1, [&](std::ptrdiff_t b) {
+				auto* first = buffer.get() + bucketStart[b];
+				auto* last = buffer.get() + bucketStart[b + 1];
+				if (b % 2 == 0) {
+					std::sort(first, last, comp);
+				}
+				std::move(first, last, data + bucketStart[b]);
+			});
+		}
+	}  // namespace Detail
+
+	/**
+	 * @brief   Sort integers in a contiguous container in ascending order with a parallel LSD radix sort.
+	 * @details Every pass sorts by one byte of the keys: chunks of the container are counted and scattered to a buffer in parallel, and their
+	 * offsets are computed in between. One sweep before the first pass finds bytes that are the same in all elements, e.g. high bytes of small
+	 * non-negative mints, and passes over them are skipped, so the running time depends on the range of values rather than on the size of the type. The sort is stable.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  Container - contiguous container of integers with data() and size(), e.g. Tensor<mint> or NumericArray<std::int32_t>
+	 * @param   pool - thread pool to run the tasks
+	 * @param   c - container to sort
+	 * @param   grain - number of elements counted and scattered by a single task, for very large containers it is increased so that a pass
+	 * is split into at most 1024 tasks
+	 * @note    Requires a temporary buffer of the same size as the container. If the pool gets cancelled, radixSort throws Async::TaskCancelled
+	 * and the order of elements in the container is unspecified.
+	 */
+	template<typename Pool, typename Container, typename = std::enable_if_t<Detail::has_data_and_size_v<Container>>>
+	void radixSort(Pool& pool, Container& c, std::ptrdiff_t grain) {
+		using T = Detail::element_t<Container>;
+		static_assert(Detail::is_radix_sortable_v<T>, "radixSort requires a container of integers.");
+		constexpr std::ptrdiff_t radix = 256;
+		const auto n = static_cast<std::ptrdiff_t>(c.size());
+		if (n < 2) {
+			return;
+		}
+		const auto chunk = Detail::sortChunkSize(n, grain);
+		const auto chunks = Detail::chunkCount(n, chunk);
+		auto buffer = Detail::makeBuffer<T>(n);
+		T* src = c.data();
+		T* dst = buffer.get();
+		// bits in which some element differs from the first one, passes over bytes without such bits would not move anything
+		using U = std::make_unsigned_t<T>;
+		const U first = Detail::radixKey(src[0]);
+		const U varying = parallelReduce(
+			pool, std::ptrdiff_t {0}, n, chunk, U {0},
+			[src, first](std::ptrdiff_t i, std::ptrdiff_t last, U acc) {
+				for (; i < last; ++i) {
+					acc |= static_cast<U>(Detail::radixKey(src[i]) ^ first);
+				}
+				return acc;
+			},
+			[](U a, U b) { return static_cast<U>(a | b); });
+		std::vector<std::ptrdiff_t> offsets(static_cast<std::size_t>(chunks * radix));
+		for (unsigned shift = 0; shift < 8 * sizeof(T); shift += 8) {
+			if (((varying >> shift) & 0xFF) == 0) {
+				continue;
+			}
+			auto digit = [shift](T x) { return static_cast<std::ptrdiff_t>((Detail::radixKey(x) >> shift) & 0xFF); };
+			parallelFor(pool, std::ptrdiff_t {0}, chunks, 1, [&, chunk](std::ptrdiff_t k) {
+				auto* histogram = offsets.data() + k * radix;
+				std::fill_n(histogram, radix, 0);
+				for (auto i = k * chunk; i < std::min(n, (k + 1) * chunk); ++i) {
+					++histogram[digit(src[i])];
+				}
+			});
+			// offsets are ordered by digit first and chunk second, which keeps the sort stable
+			std::ptrdiff_t running = 0;
+			for (std::ptrdiff_t d = 0; d < radix; ++d) {
+				for (std::ptrdiff_t k = 0; k < chunks; ++k) {
+					running += std::exchange(offsets[k * radix + d], running);
+				}
+			}
+			parallelFor(pool, std::ptrdiff_t {0}, chunks, 1, [&, chunk](std::ptrdiff_t k) {
+				auto* next = offsets.data() + k * radix;
+				for (auto i = k * chunk; i < std::min(n, (k + 1) * chunk); ++i) {
+					dst[next[digit(src[i])]++] = src[i];
+				}
+			});
+			std::swap(src, dst);
+		}
+		if (src != c.data()) {
+			Detail::parallelMove(pool, src, c.data(), n, chunk);
+		}
+	}
+
+	/**
+	 * @brief   Sort elements of a contiguous container in parallel.
+	 * @details Integers compared with std::less are sorted with radixSort. Other element types and comparators use a parallel sample sort:
+	 * elements are distributed into up to 255 buckets delimited by splitters sampled from the container, and the buckets are sorted
+	 * concurrently with std::sort. Like std::sort, the sample sort is not stable.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  Container - contiguous container with data() and size() whose elements are default constructible, e.g. any IterableContainer
+	 * @tparam  Compare - strict weak ordering of elements
+	 * @param   pool - thread pool to run the tasks
+	 * @param   c - container to sort
+	 * @param   grain - number of elements processed by a single task when elements are distributed into buckets, containers that are not longer
+	 * than grain are sorted sequentially in the calling thread
+	 * @param   comp - comparator, by default elements are sorted in ascending order
+	 * @note    Requires a temporary buffer of the same size as the container. If the pool gets cancelled, parallelSort throws Async::TaskCancelled
+	 * and the order of elements in the container is unspecified.
+	 */
+	template<typename Pool, typename Container, typename Compare = std::less<>, typename = std::enable_if_t<Detail::has_data_and_size_v<Container>>>
+	void parallelSort(Pool& pool, Container& c, std::ptrdiff_t grain, Compare comp = {}) {
+		using T = Detail::element_t<Container>;
+		if constexpr (Detail::is_radix_sortable_v<T> && (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>>)) {
+			radixSort(pool, c, grain);
+		} else {
+			Detail::sampleSort(pool, c.data(), static_cast<std::ptrdiff_t>(c.size()), grain, comp);
+		}
+	}
+
+	/**
+	 * @brief   Compute inclusive prefix sums of a contiguous container in parallel, out[i] = in[0] op in[1] op ... op in[i].
+	 * @details Chunks of \p grain elements are first reduced in parallel, then the chunk sums are accumulated sequentially and finally every
+	 * chunk is scanned in parallel starting from the sum of all preceding chunks. The operation must be associative, but for floating-point
+	 * addition the results may differ from a sequential scan in the last bits.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  InContainer - contiguous container with data() and size(), e.g. Tensor or NumericArray
+	 * @tparam  OutContainer - contiguous container with the same number of elements, it can be the same object as the input
+	 * @tparam  Op - associative binary operation on the elements
+	 * @param   pool - thread pool to run the tasks
+	 * @param   in - input container
+	 * @param   out - container for the results
+	 * @param   grain - number of elements processed by a single task
+	 * @param   op - binary operation, by default addition
+	 * @throws  ErrorName::DimensionsError - if the containers have different numbers of elements
+	 */
+	template<typename Pool, typename InContainer, typename OutContainer, typename Op = std::plus<>,
+			 typename = std::enable_if_t<Detail::has_data_and_size_v<InContainer> && Detail::has_data_and_size_v<OutContainer>>>
+	void inclusiveScan(Pool& pool, const InContainer& in, OutContainer& out, std::ptrdiff_t grain, Op op = {}) {
+		if (in.size() != out.size()) {
+			ErrorManager::throwException(ErrorName::DimensionsError);
+		}
+		using T = Detail::element_t<const InContainer>;
+		const auto n = static_cast<std::ptrdiff_t>(in.size());
+		if (n == 0) {
+			return;
+		}
+		const auto* x = in.data();
+		auto* y = out.data();
+		const auto chunk = std::max(grain, std::ptrdiff_t {1});
+		auto sums = Detail::chunkSums<T>(pool, x, n, chunk, op);
+		for (std::size_t k = 1; k < sums.size(); ++k) {
+			sums[k] = op(sums[k - 1], sums[k]);
+		}
+		parallelFor(pool, std::ptrdiff_t {0}, Detail::chunkCount(n, chunk), 1, [&sums, x, y, n, chunk, &op](std::ptrdiff_t k) {
+			const auto first = k * chunk;
+			T acc = (k == 0) ? T(x[0]) : op(sums[k - 1], x[first]);
+			y[first] = acc;
+			for (auto i = first + 1; i < std::min(n, first + chunk); ++i) {
+				acc = op(std::move(acc), x[i]);
+				y[i] = acc;
+			}
+		});
+	}
+
+	/**
+	 * @brief   Compute exclusive prefix sums of a contiguous container in parallel, out[0] = init and out[i] = init op in[0] op ... op in[i - 1].
+	 * @details Works in the same way as inclusiveScan.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  InContainer - contiguous container with data() and size(), e.g. Tensor or NumericArray
+	 * @tparam  OutContainer - contiguous container with the same number of elements, it can be the same object as the input
+	 * @tparam  T - type of the accumulated values
+	 * @tparam  Op - associative binary operation
+	 * @param   pool - thread pool to run the tasks
+	 * @param   in - input container
+	 * @param   out - container for the results
+	 * @param   grain - number of elements processed by a single task
+	 * @param   init - initial value
+	 * @param   op - binary operation, by default addition
+	 * @throws  ErrorName::DimensionsError - if the containers have different numbers of elements
+	 */
+	template<typename Pool, typename InContainer, typename OutContainer, typename T, typename Op = std::plus<>,
+			 typename = std::enable_if_t<Detail::has_data_and_size_v<InContainer> && Detail::has_data_and_size_v<OutContainer>>>
+	void exclusiveScan(Pool& pool, const InContainer& in, OutContainer& out, std::ptrdiff_t grain, T init, Op op = {}) {
+		if (in.size() != out.size()) {
+			ErrorManager::throwException(ErrorName::DimensionsError);
+		}
+		const auto n = static_cast<std::ptrdiff_t>(in.size());
+		if (n == 0) {
+			return;
+		}
+		const auto* x = in.data();
+		auto* y = out.data();
+		const auto chunk = std::max(grain, std::ptrdiff_t {1});
+		auto sums = Detail::chunkSums<T>(pool, x, n, chunk, op);
+		// turn chunk sums into the initial values of the chunks
+		sums.insert(sums.begin(), std::move(init));
+		for (std::size_t k = 1; k < sums.size(); ++k) {
+			sums[k] = op(sums[k - 1], sums[k]);
+		}
+		parallelFor(pool, std::ptrdiff_t {0}, static_cast<std::ptrdiff_t>(sums.size()), 1, [&sums, x, y, n, chunk, &op](std::ptrdiff_t k) {
+			T acc = sums[k];
+			for (auto i = k * chunk; i < std::min(n, (k + 1) * chunk); ++i) {
+				// read the element before writing the result, the output may alias the input
+				T value = x[i];
+				y[i] = acc;
+				acc = op(std::move(acc), std::move(value));
+			}
+		});
+	}
+
+	/**
+	 * @brief   Reorder a contiguous container in parallel, so that elements satisfying \p pred precede the others, preserving the relative
+	 * order within both groups.
+	 * @details The predicate is evaluated once per element, in parallel for chunks of \p grain elements. Then elements of every chunk are moved
+	 * to their final positions in a temporary buffer concurrently with other chunks, and the buffer is moved back to the container.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  Container - contiguous container with data() and size() whose elements are default constructible, e.g. any IterableContainer
+	 * @tparam  Predicate - callable that takes a const reference to the element and returns a value convertible to bool
+	 * @param   pool - thread pool to run the tasks
+	 * @param   c - container to partition
+	 * @param   grain - number of elements processed by a single task
+	 * @param   pred - predicate, it may be called concurrently from multiple threads
+	 * @return  number of elements that satisfy the predicate, i.e. the index of the first element of the second group
+	 */
+	template<typename Pool, typename Container, typename Predicate, typename = std::enable_if_t<Detail::has_data_and_size_v<Container>>>
+	std::ptrdiff_t stablePartition(Pool& pool, Container& c, std::ptrdiff_t grain, Predicate&& pred) {
+		using T = Detail::element_t<Container>;
+		const auto n = static_cast<std::ptrdiff_t>(c.size());
+		if (n == 0) {
+			return 0;
+		}
+		auto* data = c.data();
+		const auto chunk = std::max(grain, std::ptrdiff_t {1});
+		const auto chunks = Detail::chunkCount(n, chunk);
+		auto flags = Detail::makeBuffer<bool>(n);
+		std::vector<std::ptrdiff_t> selected(static_cast<std::size_t>(chunks));
+		parallelFor(pool, std::ptrdiff_t {0}, chunks, 1, [&, data, n, chunk](std::ptrdiff_t k) {
+			std::ptrdiff_t count = 0;
+			for (auto i = k * chunk; i < std::min(n, (k + 1) * chunk); ++i) {
+				flags[i] = static_cast<bool>(pred(std::as_const(data[i])));
+				count += flags[i] ? 1 : 0;
+			}
+			selected[k] = count;
+		});
+		// first position of the selected and of the remaining elements of every chunk
+		std::vector<std::ptrdiff_t> rejected(static_cast<std::size_t>(chunks));
+		std::ptrdiff_t total = 0;
+		for (std::ptrdiff_t k = 0; k < chunks; ++k) {
+			total += std::exchange(selected[k], total);
+		}
+		for (std::ptrdiff_t k = 0; k < chunks; ++k) {
+			rejected[k] = total + k * chunk - selected[k];
+		}
+		auto buffer = Detail::makeBuffer<T>(n);
+		parallelFor(pool, std::ptrdiff_t {0}, chunks, 1, [&, data, n, chunk](std::ptrdiff_t k) {
+			auto yes = selected[k];
+			auto no = rejected[k];
+			for (auto i = k * chunk; i < std::min(n, (k + 1) * chunk); ++i) {
+				buffer[flags[i] ? yes++ : no++] = std::move(data[i]);
+			}
+		});
+		Detail::parallelMove(pool, buffer.get(), data, n, chunk);
+		return total;
+	}
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_SORT_H
@@ -0,0 +1,150 @@
+/**
+ * @file	SparseMatrix.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Assembly, conversions and products of sparse matrices distributed among threads of a pool from LLU::Async.
+ */
+#ifndef LLU_ASYNC_SPARSEMATRIX_H
+#define LLU_ASYNC_SPARSEMATRIX_H
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "LLU/Async/Algorithms.h"
+#include "LLU/Containers/SparseArrayBuilder.hpp"
+#include "LLU/Containers/Views/SparseMatrix.hpp"
+
+namespace LLU::Async {
+
+	/// Default number of rows of the sparse matrix processed by a single task in Async::dot
+	inline constexpr mint defaultSparseRowGrain = 1 << 10;
+
+	/**
+	 * @brief   Multiply a sparse matrix by a dense vector or matrix, distributing rows of the result among threads of the pool
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @param   pool - thread pool to run the tasks
+	 * @param   a - sparse matrix
+	 * @param   b - Tensor of rank 1 with a.columns() elements, or of rank 2 with a.columns() rows
+	 * @param   grain - number of rows of \p a processed by a single task
+	 * @return  Tensor of the same rank as \p b, with a.rows() rows
+	 * @throws  see LLU::Sparse::dot
+	 */
+	template<typename Pool, typename T>
+	Tensor<T> dot(Pool& pool, const SparseMatrixView<T>& a, const Tensor<T>& b, mint grain = defaultSparseRowGrain) {
+		auto result = Sparse::Detail::productResult(a, b);
+		const bool vector = b.rank() == 1;
+		const mint n = vector ? 1 : b.dimension(1);
+		std::vector<T> sums;
+		if (a.implicitValue() != T {}) {
+			sums = Sparse::Detail::columnSums(b.data(), a.columns(), n);
+		}
+		const T* in = b.data();
+		T* out = result.data();
+		const T* bSums = sums.data();
+		const mint chunk = std::max(grain, mint {1});
+		const mint rows = a.rows();
+		parallelFor(pool, mint {0}, (rows + chunk - 1) / chunk, 1, [&a, in, out, n, bSums, vector, chunk, rows](mint k) {
+			const mint first = k * chunk;
+			const mint last = std::min(rows, first + chunk);
+			if (vector) {
+				Sparse::multiplyRows(a, in, out, first, last, bSums ? bSums[0] : T {});
+			} else {
+				Sparse::multiplyRows(a, in, n, out, first, last, bSums);
+			}
+		});
+		return result;
+	}
+
+	/**
+	 * @brief   Compress all triplets collected by a SparseArrayBuilder into CSR form, sorting and merging rows in parallel
+	 * @details Distribution of triplets into rows is a single linear pass, sorting by column and merging duplicates is done by tasks of
+	 * \p grain rows each. The builder is emptied in the process.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @param   pool - thread pool to run the tasks
+	 * @param   builder - builder with collected triplets
+	 * @param   grain - number of rows processed by a single task
+	 */
+	template<typename Pool, typename T>
+	CompressedRows<T> compress(Pool& pool, SparseArrayBuilder<T>& builder, mint grain = defaultSparseRowGrain) {
+		const mint chunk = std::max(grain, mint {1});
+		return builder.compress([&pool, chunk](mint rows, auto&& rowRange) {
+			parallelFor(pool, mint {0}, (rows + chunk - 1) / chunk, 1, [&rowRange, chunk, rows](mint k) {
+				rowRange(k * chunk, std::min(rows, (k + 1) * chunk));
+			});
+		});
+	}
+
+	/**
+	 * @brief   Convert a sparse matrix to a dense Tensor, distributing rows among threads of the pool
+	 * @details Parallel counterpart of SparseArray::toTensor, each task fills \p grain rows of the result with the implicit value and
+	 * scatters the explicit elements of these rows.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @param   pool - thread pool to run the tasks
+	 * @param   a - sparse matrix
+	 * @param   grain - number of rows processed by a single task
+	 * @return  Tensor with a.rows() rows and a.columns() columns
+	 */
+	template<typename Pool, typename T>
+	Tensor<T> toTensor(Pool& pool, const SparseMatrixView<T>& a, mint grain = defaultSparseRowGrain) {
+		Tensor<T> result(Uninitialized, {a.rows(), a.columns()});
+		T* out = result.data();
+		const mint chunk = std::max(grain, mint {1});
+		const mint rows = a.rows();
+		parallelFor(pool, mint {0}, (rows + chunk - 1) / chunk, 1, [&a, out, chunk, rows](mint k) {
+			Sparse::densifyRows(a, out, k * chunk, std::min(rows, (k + 1) * chunk));
+		});
+		return result;
+	}
+
+	/**
+	 * @brief   Convert a SparseArray of rank 2 to a dense Tensor, distributing rows among threads of the pool
+	 * @throws  ErrorName::RankError - if the rank of \p sa is not 2
+	 */
+	template<typename Pool, typename T>
+	Tensor<T> toTensor(Pool& pool, const SparseArray<T>& sa, mint grain = defaultSparseRowGrain) {
+		return toTensor(pool, SparseMatrixView<T> {sa}, grain);
+	}
+
+	/**
+	 * @brief   Create a SparseArray from a dense matrix, scanning rows in parallel
+	 * @details Parallel counterpart of the SparseArray(const Tensor<T>&, T) constructor. Explicit elements of every row are counted in a first
+	 * parallel pass, each row then knows from the prefix sums of the counts where its elements go, so the second pass writes positions and
+	 * values of disjoint rows without synchronization. Positions are passed to MSparseArray_fromExplicitPositions already sorted.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @param   pool - thread pool to run the tasks
+	 * @param   dense - Tensor of rank 2
+	 * @param   implicitValue - value of elements which are not stored explicitly
+	 * @param   grain - number of rows processed by a single task
+	 * @throws  ErrorName::RankError - if the rank of \p dense is not 2
+	 */
+	template<typename Pool, typename T>
+	SparseArray<T> toSparseArray(Pool& pool, const Tensor<T>& dense, T implicitValue = T {}, mint grain = defaultSparseRowGrain) {
+		if (dense.rank() != 2) {
+			ErrorManager::throwException(ErrorName::RankError);
+		}
+		const mint rows = dense.dimension(0);
+		const mint columns = dense.dimension(1);
+		const T* in = dense.data();
+		const mint chunk = std::max(grain, mint {1});
+		const mint chunks = (rows + chunk - 1) / chunk;
+		std::vector<mint> rowPointers(static_cast<std::size_t>(rows) + 1);
+		mint* counts = rowPointers.data();
+		parallelFor(pool, mint {0}, chunks, 1, [in, columns, implicitValue, counts, chunk, rows](mint k) {
+			for (mint i = k * chunk; i < std::min(rows, (k + 1) * chunk); ++i) {
+				counts[i + 1] = Sparse::countExplicit(in + i * columns, columns, implicitValue);
+			}
+		});
+		std::partial_sum(rowPointers.begin(), rowPointers.end(), rowPointers.begin());
+		const mint nnz = rowPointers.back();
+		Tensor<mint> positions(Uninitialized, {nnz, 2});
+		Tensor<T> values(Uninitialized, {nnz});
+		mint* pos = positions.data();
+		T* vals = values.data();
+		parallelFor(pool, mint {0}, chunks, 1, [in, columns, implicitValue, counts, pos, vals, chunk, rows](mint k) {
+			Sparse::sparsifyRows(in, columns, implicitValue, counts, pos, vals, k * chunk, std::min(rows, (k + 1) * chunk));
+		});
+		return {positions, values, Tensor<mint> {rows, columns}, implicitValue};
+	}
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_SPARSEMATRIX_H
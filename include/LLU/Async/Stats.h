@@ -0,0 +1,222 @@
+/**
+ * @file	Stats.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Optional instrumentation of thread pools: per-worker counters, queue high-water marks and queueing latency histograms.
+ */
+#ifndef LLU_ASYNC_STATS_H
+#define LLU_ASYNC_STATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace LLU::Async {
+
+	/**
+	 * Whether thread pools collect statistics. Define LLU_ASYNC_STATS to enable them, otherwise all instrumentation is compiled out
+	 * and stats() returns empty PoolStats.
+	 * @note The flag must have the same value in all translation units of a paclet.
+	 */
+#ifdef LLU_ASYNC_STATS
+	inline constexpr bool statsEnabled = true;
+#else
+	inline constexpr bool statsEnabled = false;
+#endif
+
+	/// Clock used to measure how long tasks wait in the queues
+	using StatsClock = std::chrono::steady_clock;
+
+	/**
+	 * @brief   Histogram of latencies with power-of-two buckets.
+	 * @details Bucket 0 counts latencies below 1 microsecond, bucket k > 0 counts latencies in [2^(k-1), 2^k) microseconds and the last bucket
+	 * collects everything above.
+	 */
+	struct LatencyHistogram {
+		/// Number of buckets
+		static constexpr std::size_t bucketCount = 32;
+
+		/// Counts of samples in each bucket
+		std::array<std::uint64_t, bucketCount> buckets {};
+
+		/**
+		 * Find the bucket for given latency
+		 * @param latency - measured duration
+		 * @return bucket index
+		 */
+		static std::size_t bucketOf(StatsClock::duration latency) noexcept {
+			auto us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+			std::size_t bucket = 0;
+			while (us > 0 && bucket < bucketCount - 1) {
+				us >>= 1;
+				++bucket;
+			}
+			return bucket;
+		}
+
+		/// Get the total number of samples
+		[[nodiscard]] std::uint64_t count() const noexcept {
+			std::uint64_t total = 0;
+			for (auto b : buckets) {
+				total += b;
+			}
+			return total;
+		}
+
+		/// Add samples from another histogram
+		LatencyHistogram& operator+=(const LatencyHistogram& other) noexcept {
+			for (std::size_t i = 0; i < bucketCount; ++i) {
+				buckets[i] += other.buckets[i];
+			}
+			return *this;
+		}
+	};
+
+	/// Snapshot of statistics of a single worker thread
+	struct WorkerStats {
+		/// Number of tasks run by the worker
+		std::uint64_t tasksExecuted = 0;
+		/// Number of tasks taken from the worker's local queue
+		std::uint64_t localPops = 0;
+		/// Number of tasks taken from the pool queue
+		std::uint64_t poolPops = 0;
+		/// Number of attempts to steal a task from another worker's queue
+		std::uint64_t stealAttempts = 0;
+		/// Number of tasks successfully stolen (including those taken in batches)
+		std::uint64_t steals = 0;
+		/// Number of rounds of spinning or yielding without work
+		std::uint64_t idleSpins = 0;
+		/// Number of times the worker went to sleep
+		std::uint64_t parks = 0;
+		/// Maximal number of tasks in the worker's local queue
+		std::uint64_t localQueueHighWater = 0;
+		/// Time between enqueuing and starting the tasks run by this worker
+		LatencyHistogram queueLatency;
+
+		/// Add statistics of another worker
+		WorkerStats& operator+=(const WorkerStats& other) noexcept {
+			tasksExecuted += other.tasksExecuted;
+			localPops += other.localPops;
+			poolPops += other.poolPops;
+			stealAttempts += other.stealAttempts;
+			steals += other.steals;
+			idleSpins += other.idleSpins;
+			parks += other.parks;
+			localQueueHighWater = localQueueHighWater > other.localQueueHighWater ? localQueueHighWater : other.localQueueHighWater;
+			queueLatency += other.queueLatency;
+			return *this;
+		}
+	};
+
+	/// Snapshot of statistics of a thread pool
+	struct PoolStats {
+		/// Whether the statistics were collected at all, i.e. whether LLU_ASYNC_STATS was defined
+		bool enabled = statsEnabled;
+		/// Maximal number of tasks waiting in the pool queue
+		std::uint64_t poolQueueHighWater = 0;
+		/// Statistics of each worker
+		std::vector<WorkerStats> workers;
+
+		/// Get statistics summed over all workers
+		[[nodiscard]] WorkerStats total() const noexcept {
+			WorkerStats res;
+			for (const auto& w : workers) {
+				res += w;
+			}
+			return res;
+		}
+	};
+
+	namespace Detail {
+		/// Relaxed atomic counter, cheap to bump and safe to read from other threads
+		class Counter {
+		public:
+			void add(std::uint64_t n = 1) noexcept {
+				value.fetch_add(n, std::memory_order_relaxed);
+			}
+			[[nodiscard]] std::uint64_t get() const noexcept {
+				return value.load(std::memory_order_relaxed);
+			}
+			void reset() noexcept {
+				value.store(0, std::memory_order_relaxed);
+			}
+
+		private:
+			std::atomic<std::uint64_t> value = 0;
+		};
+
+		/// Tracks the current depth of a queue and the maximal depth seen so far
+		class DepthGauge {
+		public:
+			void add(std::int64_t n = 1) noexcept {
+				auto current = depth.fetch_add(n, std::memory_order_relaxed) + n;
+				auto high = highWater.load(std::memory_order_relaxed);
+				while (current > high && !highWater.compare_exchange_weak(high, current, std::memory_order_relaxed)) {
+				}
+			}
+			void remove(std::int64_t n = 1) noexcept {
+				depth.fetch_sub(n, std::memory_order_relaxed);
+			}
+			[[nodiscard]] std::uint64_t maxDepth() const noexcept {
+				auto high = highWater.load(std::memory_order_relaxed);
+				return high > 0 ? static_cast<std::uint64_t>(high) : 0;
+			}
+			/// Forget the high-water mark, the current depth is kept so that the gauge stays consistent
+			void reset() noexcept {
+				highWater.store(depth.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+
+		private:
+			std::atomic<std::int64_t> depth = 0;
+			std::atomic<std::int64_t> highWater = 0;
+		};
+
+		/// Live counters of a single worker, aligned to a cache line so that workers do not disturb each other
+		struct alignas(64) WorkerCounters {
+			Counter tasksExecuted;
+			Counter localPops;
+			Counter poolPops;
+			Counter stealAttempts;
+			Counter steals;
+			Counter idleSpins;
+			Counter parks;
+			DepthGauge localDepth;
+			std::array<Counter, LatencyHistogram::bucketCount> latency;
+
+			void recordLatency(StatsClock::duration d) noexcept {
+				latency[LatencyHistogram::bucketOf(d)].add();
+			}
+
+			[[nodiscard]] WorkerStats snapshot() const noexcept {
+				WorkerStats s;
+				s.tasksExecuted = tasksExecuted.get();
+				s.localPops = localPops.get();
+				s.poolPops = poolPops.get();
+				s.stealAttempts = stealAttempts.get();
+				s.steals = steals.get();
+				s.idleSpins = idleSpins.get();
+				s.parks = parks.get();
+				s.localQueueHighWater = localDepth.maxDepth();
+				for (std::size_t i = 0; i < LatencyHistogram::bucketCount; ++i) {
+					s.queueLatency.buckets[i] = latency[i].get();
+				}
+				return s;
+			}
+
+			void reset() noexcept {
+				for (auto* c : {&tasksExecuted, &localPops, &poolPops, &stealAttempts, &steals, &idleSpins, &parks}) {
+					c->reset();
+				}
+				for (auto& c : latency) {
+					c.reset();
+				}
+				localDepth.reset();
+			}
+		};
+	}  // namespace Detail
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_STATS_H
@@ -0,0 +1,66 @@
+/**
+ * @file	StatsWSTP.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Sending thread pool statistics to the Wolfram Language via WSStream.
+ */
+#ifndef LLU_ASYNC_STATSWSTP_H
+#define LLU_ASYNC_STATSWSTP_H
+
+#include <vector>
+
+#include "LLU/Async/Stats.h"
+#include "LLU/WSTP/WSStream.hpp"
+
+namespace LLU::Async {
+
+	/**
+	 * Send statistics of a single worker as an Association with keys "TasksExecuted", "LocalPops", "PoolPops", "StealAttempts", "Steals",
+	 * "IdleSpins", "Parks", "LocalQueueHighWater" and "QueueLatencyHistogram". The histogram is a list of counts in power-of-two buckets,
+	 * see LatencyHistogram.
+	 * @param ms - WSStream
+	 * @param w - worker statistics
+	 * @return reference to the stream
+	 */
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	WSStream<EIn, EOut>& operator<<(WSStream<EIn, EOut>& ms, const WorkerStats& w) {
+		auto count = [](std::uint64_t c) { return static_cast<wsint64>(c); };
+		std::vector<wsint64> histogram;
+		histogram.reserve(LatencyHistogram::bucketCount);
+		for (auto b : w.queueLatency.buckets) {
+			histogram.push_back(count(b));
+		}
+		ms << WS::Association(9);
+		ms << WS::Rule << "TasksExecuted" << count(w.tasksExecuted);
+		ms << WS::Rule << "LocalPops" << count(w.localPops);
+		ms << WS::Rule << "PoolPops" << count(w.poolPops);
+		ms << WS::Rule << "StealAttempts" << count(w.stealAttempts);
+		ms << WS::Rule << "Steals" << count(w.steals);
+		ms << WS::Rule << "IdleSpins" << count(w.idleSpins);
+		ms << WS::Rule << "Parks" << count(w.parks);
+		ms << WS::Rule << "LocalQueueHighWater" << count(w.localQueueHighWater);
+		ms << WS::Rule << "QueueLatencyHistogram" << histogram;
+		return ms;
+	}
+
+	/**
+	 * Send pool statistics as an Association with keys "Enabled", "PoolQueueHighWater", "Total" and "Workers",
+	 * where "Total" is the Association of summed worker statistics and "Workers" is a list of such Associations, one per worker.
+	 * @param ms - WSStream
+	 * @param s - pool statistics
+	 * @return reference to the stream
+	 */
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	WSStream<EIn, EOut>& operator<<(WSStream<EIn, EOut>& ms, const PoolStats& s) {
+		ms << WS::Association(4);
+		ms << WS::Rule << "Enabled" << s.enabled;
+		ms << WS::Rule << "PoolQueueHighWater" << static_cast<wsint64>(s.poolQueueHighWater);
+		ms << WS::Rule << "Total" << s.total();
+		ms << WS::Rule << "Workers" << WS::List(static_cast<int>(s.workers.size()));
+		for (const auto& w : s.workers) {
+			ms << w;
+		}
+		return ms;
+	}
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_STATSWSTP_H
@@ -0,0 +1,147 @@
+/**
+ * @file	Stealing.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Victim selection policies for work stealing in GenericThreadPool.
+ */
+#ifndef LLU_ASYNC_STEALING_H
+#define LLU_ASYNC_STEALING_H
+
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "LLU/Async/Topology.h"
+
+namespace LLU::Async {
+
+	/**
+	 * @brief   Steal policy that scans other workers in a fixed order starting from the thief's right neighbour.
+	 * @details Every steal policy provides:
+	 *  - init(workerCpus) - called once before the workers start, with the logical CPU of each worker or -1 for workers that are not pinned
+	 *  - forEachVictim(thief, workerCount, tryVictim) - calls tryVictim on worker indices in the order in which they should be robbed,
+	 *    until it returns true. \c thief is equal to \c workerCount when the thief is not a worker of the pool.
+	 *  - stealHalf - whether a successful thief should take half of the victim's tasks instead of a single one
+	 */
+	struct SequentialSteal {
+		/// Steal a single task at a time
+		static constexpr bool stealHalf = false;
+
+		/// No state to initialize
+		void init(const std::vector<int>& /*workerCpus*/) {}
+
+		/// Try victims thief+1, thief+2, ... modulo the number of workers
+		template<typename F>
+		bool forEachVictim(unsigned thief, unsigned workerCount, F&& tryVictim) const {
+			for (unsigned i = 1; i <= workerCount; ++i) {
+				if (tryVictim((thief + i) % workerCount)) {
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
+	/**
+	 * @brief   Steal policy that starts scanning at a random worker, so that idle workers do not all hammer the queues of their neighbours.
+	 */
+	struct RandomSteal {
+		/// Steal a single task at a time
+		static constexpr bool stealHalf = false;
+
+		/// No state to initialize
+		void init(const std::vector<int>& /*workerCpus*/) {}
+
+		/// Try all workers in a cyclic order starting from a random one
+		template<typename F>
+		bool forEachVictim(unsigned /*thief*/, unsigned workerCount, F&& tryVictim) const {
+			return tryRotated(workerCount, [&](unsigned i) { return tryVictim(i); });
+		}
+
+	protected:
+		/// Cheap per-thread pseudo-random number generator (xorshift32), seeded from the thread id
+		static std::uint32_t random() noexcept {
+			thread_local std::uint32_t state = static_cast<std::uint32_t>(std::hash<std::thread::id> {}(std::this_thread::get_id())) | 1U;
+			state ^= state << 13U;
+			state ^= state >> 17U;
+			state ^= state << 5U;
+			return state;
+		}
+
+		/// Call f(0), ..., f(count - 1) rotated by a random offset until f returns true
+		template<typename F>
+		static bool tryRotated(unsigned count, F&& f) {
+			if (count == 0) {
+				return false;
+			}
+			const auto start = random() % count;
+			for (unsigned i = 0; i < count; ++i) {
+				if (f((start + i) % count)) {
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
+	/**
+	 * @brief   Steal policy that prefers victims sharing the last-level cache with the thief, and only then tries the remaining workers.
+	 * @details Stolen tasks usually touch data that the victim has just used, so taking them from a sibling core is cheaper than from another
+	 * socket or core complex. Cache information is only available for pinned workers; unpinned workers fall back to RandomSteal.
+	 */
+	struct CacheAwareSteal : RandomSteal {
+		/// Steal a single task at a time
+		static constexpr bool stealHalf = false;
+
+		/// Split the other workers into those sharing the cache with each worker and the rest
+		void init(const std::vector<int>& workerCpus) {
+			std::vector<int> groups;
+			groups.reserve(workerCpus.size());
+			for (auto cpu : workerCpus) {
+				groups.push_back(Topology::cacheGroup(cpu));
+			}
+			near.assign(workerCpus.size(), {});
+			far.assign(workerCpus.size(), {});
+			for (unsigned thief = 0; thief < workerCpus.size(); ++thief) {
+				for (unsigned victim = 0; victim < workerCpus.size(); ++victim) {
+					if (victim == thief) {
+						continue;
+					}
+					bool sameCache = groups[thief] >= 0 && groups[thief] == groups[victim];
+					(sameCache ? near : far)[thief].push_back(victim);
+				}
+			}
+		}
+
+		/// Try the siblings first, then all the other workers, each group in a random cyclic order
+		template<typename F>
+		bool forEachVictim(unsigned thief, unsigned workerCount, F&& tryVictim) const {
+			if (thief >= near.size()) {
+				return RandomSteal::forEachVictim(thief, workerCount, tryVictim);
+			}
+			const auto& siblings = near[thief];
+			const auto& others = far[thief];
+			return tryRotated(static_cast<unsigned>(siblings.size()), [&](unsigned i) { return tryVictim(siblings[i]); }) ||
+				   tryRotated(static_cast<unsigned>(others.size()), [&](unsigned i) { return tryVictim(others[i]); });
+		}
+
+	private:
+		std::vector<std::vector<unsigned>> near;
+		std::vector<std::vector<unsigned>> far;
+	};
+
+	/**
+	 * @brief   Wrapper over another steal policy which makes a successful thief take half of the victim's tasks at once.
+	 * @details This reduces the number of steals when a single worker spawns a lot of tasks, because the thief moves a batch of them
+	 * into its own queue from which other idle workers can steal in turn.
+	 * @tparam  Base - policy that selects the victims
+	 */
+	template<typename Base = RandomSteal>
+	struct StealHalf : Base {
+		/// Steal half of the tasks from the victim
+		static constexpr bool stealHalf = true;
+	};
+
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_STEALING_H
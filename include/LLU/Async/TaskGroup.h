@@ -0,0 +1,164 @@
+/**
+ * @file	TaskGroup.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Definition of TaskGroup - a lightweight completion counter for batches of fire-and-forget tasks.
+ */
+#ifndef LLU_ASYNC_TASKGROUP_H
+#define LLU_ASYNC_TASKGROUP_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <utility>
+
+#include "LLU/Async/Cancellation.h"
+
+namespace LLU::Async {
+
+	/**
+	 * @class   TaskGroup
+	 * @brief   Counts tasks that have not finished yet and lets other threads wait until all of them complete.
+	 * @details TaskGroup is a reusable latch. Unlike a std::future per task, it costs one atomic decrement per completed task and a single
+	 * condition variable for the whole batch. Tasks are usually added with run(), which posts a task to a thread pool and takes care of
+	 * counting, but the counter can also be managed manually with add() and arrive().
+	 * The first exception thrown from a task started with run() is stored and rethrown from wait(). Tasks that a pool discards without running them
+	 * (see GenericThreadPool::cancel) count as completed with a TaskCancelled exception.
+	 *
+	 * New tasks may be added to the group from other tasks of the same group (e.g. recursively) or from any thread before the call to wait().
+	 */
+	class TaskGroup {
+	public:
+		TaskGroup() = default;
+		TaskGroup(const TaskGroup&) = delete;
+		TaskGroup& operator=(const TaskGroup&) = delete;
+		TaskGroup(TaskGroup&&) = delete;
+		TaskGroup& operator=(TaskGroup&&) = delete;
+		~TaskGroup() = default;
+
+		/**
+		 * Register new tasks in the group
+		 * @param count - number of tasks to add
+		 */
+		void add(std::size_t count = 1) {
+			if (pending.fetch_add(count, std::memory_order_relaxed) == 0) {
+				std::lock_guard<std::mutex> lock(waitMutex);
+				completed = false;
+			}
+		}
+
+		/**
+		 * Mark tasks as completed and wake up waiting threads if this was the last pending task
+		 * @param count - number of tasks that completed
+		 */
+		void arrive(std::size_t count = 1) noexcept {
+			if (pending.fetch_sub(count, std::memory_order_acq_rel) == count) {
+				// waiters only return after they see the flag set under the lock, so the group cannot be destroyed while we still use it
+				std::lock_guard<std::mutex> lock(waitMutex);
+				completed = true;
+				allDone.notify_all();
+			}
+		}
+
+		/**
+		 * Post a task to the pool as part of this group. The task is counted as pending until it finishes, either normally or by throwing.
+		 * @tparam Pool - thread pool class with a post method, like BasicThreadPool or GenericThreadPool
+		 * @tparam FunctionType - type of the function to be called in a worker thread
+		 * @param pool - thread pool that will run the task
+		 * @param f - function to be called as the task, its result is discarded
+		 */
+		template<typename Pool, typename FunctionType>
+		void run(Pool& pool, FunctionType&& f) {
+			add();
+			Arrival arrival {this};
+			pool.post([arrival = std::move(arrival), task = std::forward<FunctionType>(f)]() mutable {
+				try {
+					task();
+				} catch (...) {
+					arrival.group->storeException(std::current_exception());
+				}
+				arrival.arrive();
+			});
+		}
+
+		/**
+		 * Check if all tasks in the group have finished
+		 * @return true iff there are no pending tasks
+		 */
+		[[nodiscard]] bool done() const noexcept {
+			return pending.load(std::memory_order_acquire) == 0;
+		}
+
+		/**
+		 * Block the calling thread until all tasks in the group finish. Rethrows the first exception thrown by a task started with run().
+		 * @note Do not call this function from a pool worker if the pool may need that worker to run the tasks, use wait(Pool&) instead.
+		 */
+		void wait() {
+			std::exception_ptr e;
+			{
+				std::unique_lock<std::mutex> lock(waitMutex);
+				allDone.wait(lock, [this] { return completed && done(); });
+				e = std::exchange(firstException, nullptr);
+			}
+			if (e) {
+				std::rethrow_exception(e);
+			}
+		}
+
+		/**
+		 * Wait until all tasks in the group finish, running pending tasks from the pool in the meantime.
+		 * This is safe to call from a worker thread of a pool with work stealing.
+		 * @tparam Pool - thread pool class with a non-blocking runPendingTask method, like GenericThreadPool
+		 * @param pool - thread pool whose tasks will be run while waiting
+		 */
+		template<typename Pool>
+		void wait(Pool& pool) {
+			while (!done()) {
+				pool.runPendingTask();
+			}
+			wait();
+		}
+
+	private:
+		/**
+		 * Move-only guard carried by every task started with run(). If the task is destroyed without running, for instance when the pool
+		 * discards it after cancellation or when posting fails, the guard records TaskCancelled and still marks the task as completed.
+		 */
+		struct Arrival {
+			TaskGroup* group;
+
+			explicit Arrival(TaskGroup* g) noexcept : group(g) {}
+			Arrival(const Arrival&) = delete;
+			Arrival& operator=(const Arrival&) = delete;
+			Arrival(Arrival&& other) noexcept : group(std::exchange(other.group, nullptr)) {}
+			Arrival& operator=(Arrival&&) = delete;
+
+			void arrive() noexcept {
+				std::exchange(group, nullptr)->arrive();
+			}
+
+			~Arrival() {
+				if (group) {
+					group->storeException(std::make_exception_ptr(TaskCancelled {}));
+					group->arrive();
+				}
+			}
+		};
+
+		std::atomic<std::size_t> pending = 0;
+		std::mutex waitMutex;
+		std::condition_variable allDone;
+		bool completed = true;
+		std::exception_ptr firstException = nullptr;
+
+		void storeException(std::exception_ptr e) noexcept {
+			std::lock_guard<std::mutex> lock(waitMutex);
+			if (!firstException) {
+				firstException = std::move(e);
+			}
+		}
+	};
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_TASKGROUP_H
@@ -7,17 +7,31 @@
 #ifndef LLU_ASYNC_THREADPOOL_H
 #define LLU_ASYNC_THREADPOOL_H
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <deque>
 #include <functional>
 #include <future>
+#include <iterator>
+#include <limits>
 #include <thread>
 #include <type_traits>
 #include <vector>
 
+#include "LLU/Async/BoundedQueue.h"
+#include "LLU/Async/Cancellation.h"
+#include "LLU/Async/ChaseLevQueue.h"
+#include "LLU/Async/Idle.h"
+#include "LLU/Async/LaneQueue.h"
 #include "LLU/Async/Queue.h"
+#include "LLU/Async/Stats.h"
+#include "LLU/Async/Stealing.h"
+#include "LLU/Async/Topology.h"
 #include "LLU/Async/Utilities.h"
 #include "LLU/Async/WorkStealingQueue.h"
+#include "LLU/Async/WorkerContext.h"
+#include "LLU/Tracing.h"
 
 namespace LLU::Async {
 
@@ -41,8 +55,13 @@ namespace LLU::Async {
 		 */
 		explicit BasicThreadPool(unsigned threadCount) : joiner(threads) {
 			try {
+				if constexpr (statsEnabled) {
+					for (unsigned i = 0; i < threadCount; ++i) {
+						counters.emplace_back(std::make_unique<Detail::WorkerCounters>());
+					}
+				}
 				for (unsigned i = 0; i < threadCount; ++i) {
-					threads.emplace_back(&BasicThreadPool::workerThread, this);
+					threads.emplace_back(&BasicThreadPool::workerThread, this, i);
 				}
 			} catch (...) {
 				done = true;
@@ -63,7 +82,7 @@ namespace LLU::Async {
 		~BasicThreadPool() {
 			done = true;
 			for ([[maybe_unused]] auto& t : threads) {
-				workQueue.push(TaskType {[] {}});
+				pushWakeUpTask();
 			}
 		}
 
@@ -80,36 +99,138 @@ namespace LLU::Async {
 		std::future<std::invoke_result_t<FunctionType, Args...>> submit(FunctionType&& f, Args&&... args) {
 			auto task = Async::getPackagedTask(std::forward<FunctionType>(f), std::forward<Args>(args)...);
 			auto res = task.get_future();
-			workQueue.push(TaskType {std::move(task)});
+			enqueue(TaskType {std::move(task)});
 			return res;
 		}
 
+		/**
+		 * Enqueue a task without creating a std::future for its result. This is the cheapest way to run a function in a worker thread.
+		 * Use Async::TaskGroup to wait for a batch of tasks submitted this way.
+		 * @tparam FunctionType - type of the function to be called in a worker thread
+		 * @tparam Args - argument types of the submitted task
+		 * @param f - function to be called as the task, its result is discarded
+		 * @param args - argument to the function call
+		 * @note The task must not throw, because there is no future to propagate the exception to.
+		 */
+		template<typename FunctionType, typename... Args>
+		void post(FunctionType&& f, Args&&... args) {
+			enqueue(TaskType {std::forward<FunctionType>(f), std::forward<Args>(args)...});
+		}
+
+		/// Synonym for post
+		template<typename FunctionType, typename... Args>
+		void execute(FunctionType&& f, Args&&... args) {
+			post(std::forward<FunctionType>(f), std::forward<Args>(args)...);
+		}
+
+		/**
+		 * Get an awaitable which resumes the awaiting coroutine in a worker thread, i.e. <tt>co_await pool.schedule()</tt>
+		 * @see Async::ScheduleAwaiter
+		 */
+		ScheduleAwaiter<BasicThreadPool> schedule() noexcept {
+			return ScheduleAwaiter<BasicThreadPool> {*this};
+		}
+
 		/// This is the function that each worker thread runs in a loop
 		void runPendingTask() {
 			TaskType task;
 			workQueue.waitPop(task);
+			if constexpr (statsEnabled) {
+				queueDepth.remove();
+				if (auto* c = ownCounters()) {
+					c->tasksExecuted.add();
+					c->poolPops.add();
+				}
+			}
+			LLU_TRACE_SCOPE("ThreadPool", "Task");
+			const Async::Detail::TaskScratchScope scratch;
 			task();
 		}
 
+		/**
+		 * Get a snapshot of the pool statistics. With LLU_ASYNC_STATS undefined the result is empty and has the \c enabled flag set to false.
+		 * @return statistics of the pool and of all its workers
+		 */
+		[[nodiscard]] PoolStats stats() const {
+			PoolStats res;
+			res.poolQueueHighWater = queueDepth.maxDepth();
+			for (const auto& c : counters) {
+				res.workers.push_back(c->snapshot());
+			}
+			return res;
+		}
+
+		/// Reset all counters and histograms to zero
+		void resetStats() {
+			queueDepth.reset();
+			for (auto& c : counters) {
+				c->reset();
+			}
+		}
+
 	private:
 		std::atomic_bool done = false;
 		Queue workQueue;
+		std::vector<std::unique_ptr<Detail::WorkerCounters>> counters;
+		Detail::DepthGauge queueDepth;
 		std::vector<std::thread> threads;
 		Async::ThreadJoiner joiner;
+		inline static thread_local const BasicThreadPool* currentPool = nullptr;
+		inline static thread_local unsigned myIndex = 0;
 
-		void workerThread() {
+		void workerThread(unsigned my_index_) {
+			currentPool = this;
+			myIndex = my_index_;
 			while (!done) {
 				runPendingTask();
 			}
 		}
+
+		/// Get the counters of the calling thread if it is a worker of this pool
+		Detail::WorkerCounters* ownCounters() const {
+			return currentPool == this ? counters[myIndex].get() : nullptr;
+		}
+
+		/// Put a task in the queue, stamping it with the enqueue time when statistics are enabled
+		void enqueue(TaskType&& task) {
+			if constexpr (statsEnabled) {
+				queueDepth.add();
+				workQueue.push(TaskType {[this, enqueued = StatsClock::now(), t = std::move(task)]() mutable {
+					if (auto* c = ownCounters()) {
+						c->recordLatency(StatsClock::now() - enqueued);
+					}
+					t();
+				}});
+			} else {
+				workQueue.push(std::move(task));
+			}
+		}
+
+		/// Push an empty task that unblocks one worker, a queue that may reject new elements is retried until the task gets in
+		void pushWakeUpTask() {
+			if constexpr (statsEnabled) {
+				queueDepth.add();
+			}
+			if constexpr (std::is_same_v<decltype(workQueue.push(std::declval<TaskType>())), bool>) {
+				while (!workQueue.push(TaskType {[] {}})) {
+					std::this_thread::yield();
+				}
+			} else {
+				workQueue.push(TaskType {[] {}});
+			}
+		}
 	};
 
 	/**
 	 * @brief Thread pool class with support of per-thread queues and work stealing. Based on A. Williams "C++ Concurrency in Action" 2nd Edition, chapter 9.
-	 * @tparam PoolQueue - any threadsafe queue class that provides push and tryPop methods
+	 * Tasks can take temporary memory from Async::thisWorker().scratch(), which the pool reclaims when the task returns.
+	 * @tparam PoolQueue - any threadsafe queue class that provides push and tryPop methods, tasks rejected by push (see FullQueuePolicy::Reject) are
+	 *                   destroyed without being counted in drain()
 	 * @tparam LocalQueue - any threadsafe queue class that provides push, tryPop and trySteal methods
+	 * @tparam IdlePolicy - what workers do when they find no work, one of Async::AdaptiveIdle, Async::YieldIdle or Async::SpinIdle
+	 * @tparam StealPolicy - how workers choose the queues to steal from, one of the policies from LLU/Async/Stealing.h
 	 */
-	template<typename PoolQueue, typename LocalQueue>
+	template<typename PoolQueue, typename LocalQueue, typename IdlePolicy = Async::AdaptiveIdle<>, typename StealPolicy = Async::RandomSteal>
 	class GenericThreadPool : public Async::Pausable {
 	public:
 		/// Type of the tasks processed by the Queue
@@ -123,11 +244,24 @@ namespace LLU::Async {
 		 * Create a GenericThreadPool with given number of threads
 		 * @param threadCount - requested number of threads in the pool
 		 */
-		explicit GenericThreadPool(unsigned threadCount) : joiner(threads) {
+		explicit GenericThreadPool(unsigned threadCount) : GenericThreadPool(threadCount, {}) {}
+
+		/**
+		 * Create a GenericThreadPool with given number of threads, pinning each worker thread to a logical CPU
+		 * @param threadCount - requested number of threads in the pool
+		 * @param cpus - logical CPUs for the workers, i-th worker runs on cpus[i % cpus.size()]; empty list means no pinning
+		 * @see Async::Topology::compactCpuOrder
+		 */
+		GenericThreadPool(unsigned threadCount, const std::vector<int>& cpus) : joiner(threads) {
 			try {
 				for (unsigned i = 0; i < threadCount; ++i) {
 					queues.emplace_back(std::make_unique<LocalQueue>());
+					workerCpus.push_back(cpus.empty() ? -1 : cpus[i % cpus.size()]);
+					if constexpr (statsEnabled) {
+						counters.emplace_back(std::make_unique<Detail::WorkerCounters>());
+					}
 				}
+				stealPolicy.init(workerCpus);
 				for (unsigned i = 0; i < threadCount; ++i) {
 					threads.emplace_back(&GenericThreadPool::workerThread, this, i);
 				}
@@ -150,6 +284,7 @@ namespace LLU::Async {
 		~GenericThreadPool() {
 			done = true;
 			resume();
+			idleWorkers.notifyAll();
 		}
 
 		/**
@@ -165,55 +300,605 @@ namespace LLU::Async {
 		std::future<std::invoke_result_t<FunctionType, Args...>> submit(FunctionType&& f, Args&&... args) {
 			auto task = Async::getPackagedTask(std::forward<FunctionType>(f), std::forward<Args>(args)...);
 			auto res = task.get_future();
-			if (localWorkQueue) {
-				localWorkQueue->push(TaskType {std::move(task)});
-			} else {
-				poolWorkQueue.push(TaskType {std::move(task)});
+			pushTask(TaskType {std::move(task)});
+			return res;
+		}
+
+		/**
+		 * Enqueue a task without creating a std::future for its result. This is the cheapest way to run a function in a worker thread.
+		 * Use Async::TaskGroup to wait for a batch of tasks submitted this way.
+		 * @tparam FunctionType - type of the function to be called in a worker thread
+		 * @tparam Args - argument types of the submitted task
+		 * @param f - function to be called as the task, its result is discarded
+		 * @param args - argument to the function call
+		 * @note The task must not throw, because there is no future to propagate the exception to.
+		 */
+		template<typename FunctionType, typename... Args>
+		void post(FunctionType&& f, Args&&... args) {
+			pushTask(TaskType {std::forward<FunctionType>(f), std::forward<Args>(args)...});
+		}
+
+		/// Synonym for post
+		template<typename FunctionType, typename... Args>
+		void execute(FunctionType&& f, Args&&... args) {
+			post(std::forward<FunctionType>(f), std::forward<Args>(args)...);
+		}
+
+		/**
+		 * Get an awaitable which resumes the awaiting coroutine in a worker thread, i.e. <tt>co_await pool.schedule()</tt>.
+		 * Awaited from a worker thread, the coroutine goes to the local queue of the worker.
+		 * @see Async::ScheduleAwaiter
+		 */
+		ScheduleAwaiter<GenericThreadPool> schedule() noexcept {
+			return ScheduleAwaiter<GenericThreadPool> {*this};
+		}
+
+		/**
+		 * Submit a whole range of tasks at once. Each queue involved is locked only once and idle workers are woken up once for the batch.
+		 * If the LocalQueue supports bulk push from any thread (like WorkStealingQueue), the range is split into contiguous chunks that are dealt out
+		 * round-robin to the local queues of the workers so they can start without stealing. Otherwise the tasks go to the pool queue.
+		 * @tparam InputIt - input iterator type, the elements must be callable with no arguments
+		 * @param first - iterator to the first callable, callables are moved from
+		 * @param last - iterator past the last callable
+		 * @return futures of the results of all callables, in the order of the range
+		 */
+		template<typename InputIt>
+		auto submitBulk(InputIt first, InputIt last) {
+			using FunctionType = std::decay_t<typename std::iterator_traits<InputIt>::value_type>;
+			using R = std::invoke_result_t<FunctionType&>;
+			std::vector<std::future<R>> res;
+			std::vector<TaskType> tasks;
+			for (; first != last; ++first) {
+				std::packaged_task<R()> task {std::move(*first)};
+				res.push_back(task.get_future());
+				tasks.emplace_back(std::move(task));
 			}
+			pushTasks(tasks);
 			return res;
 		}
 
-		/// This is the function that each worker thread runs in a loop
-		void runPendingTask() {
+		/**
+		 * Submit \p n tasks, the i-th task calls f(i) for i in [0, n).
+		 * @tparam FunctionType - type of the function, each task gets its own copy
+		 * @param n - number of tasks
+		 * @param f - function taking the task index
+		 * @return futures of the results of all tasks, ordered by index
+		 * @see submitBulk
+		 */
+		template<typename FunctionType>
+		auto submitN(std::size_t n, const FunctionType& f) {
+			using R = std::invoke_result_t<const FunctionType&, std::size_t>;
+			std::vector<std::future<R>> res;
+			std::vector<TaskType> tasks;
+			res.reserve(n);
+			tasks.reserve(n);
+			for (std::size_t i = 0; i < n; ++i) {
+				std::packaged_task<R()> task {[f, i] { return f(i); }};
+				res.push_back(task.get_future());
+				tasks.emplace_back(std::move(task));
+			}
+			pushTasks(tasks);
+			return res;
+		}
+
+		/**
+		 * Submit a task with given priority. Only available when the PoolQueue has priority lanes, like Async::LaneQueue.
+		 * Unlike regular submit, the task always goes to the pool queue, also when submitted from a worker thread, so that its priority is respected.
+		 * High priority tasks are picked by workers even before the tasks from their local queues.
+		 * @tparam FunctionType - type of the function to be called in a worker thread
+		 * @tparam Args - argument types of the submitted task
+		 * @param priority - priority of the task
+		 * @param f - function to be called as the task
+		 * @param args - argument to the function call
+		 * @return a future result of calling \p f on \p args
+		 */
+		template<typename FunctionType, typename... Args>
+		std::future<std::invoke_result_t<FunctionType, Args...>> submit(TaskPriority priority, FunctionType&& f, Args&&... args) {
+			static_assert(has_priority_lanes_v<PoolQueue>, "Task priorities require a pool queue with priority lanes, e.g. Async::LaneQueue.");
+			auto task = Async::getPackagedTask(std::forward<FunctionType>(f), std::forward<Args>(args)...);
+			auto res = task.get_future();
+			pushTask(priority, TaskType {std::move(task)});
+			return res;
+		}
+
+		/**
+		 * Enqueue a task with given priority without creating a std::future for its result.
+		 * @see submit(TaskPriority, FunctionType&&, Args&&...)
+		 */
+		template<typename FunctionType, typename... Args>
+		void post(TaskPriority priority, FunctionType&& f, Args&&... args) {
+			static_assert(has_priority_lanes_v<PoolQueue>, "Task priorities require a pool queue with priority lanes, e.g. Async::LaneQueue.");
+			pushTask(priority, TaskType {std::forward<FunctionType>(f), std::forward<Args>(args)...});
+		}
+
+		/**
+		 * Run a single task from the pool, if there is any. Does not block and does not yield.
+		 * @return true iff a task was run
+		 */
+		bool tryRunPendingTask() {
 			TaskType task;
-			if (popTaskFromLocalQueue(task) || popTaskFromPoolQueue(task) || popTaskFromOtherThreadQueue(task)) {
-				task();
-			} else {
+			if (popUrgentTask(task) || popTaskFromLocalQueue(task) || popTaskFromPoolQueue(task) || popTaskFromOtherThreadQueue(task)) {
+				if (cancellation.cancelled()) {
+					// destroying the task breaks its promise, so whoever waits for it is released
+					TaskType discarded {std::move(task)};
+				} else {
+					withStats([](auto& c) { c.tasksExecuted.add(); });
+					LLU_TRACE_SCOPE("ThreadPool", "Task");
+					const Async::Detail::TaskScratchScope scratch;
+					task();
+				}
+				finished();
+				return true;
+			}
+			return false;
+		}
+
+		/**
+		 * Get a token that tasks can poll to stop early after cancel() was called.
+		 * Tokens obtained before resetCancellation() stay cancelled, so a long task from an abandoned computation never sees the flag cleared.
+		 * @return cancellation token of the pool
+		 */
+		[[nodiscard]] CancellationToken cancellationToken() const {
+			return cancellation.token();
+		}
+
+		/// Check if cancel() was called and the pool was not reset since then
+		[[nodiscard]] bool cancelled() const noexcept {
+			return cancellation.cancelled();
+		}
+
+		/**
+		 * @brief   Request cooperative cancellation of all work in the pool.
+		 * @details Tasks already running are not interrupted, but their cancellation tokens report the cancellation. All waiting tasks are
+		 * discarded without running, and so are tasks submitted later, until resetCancellation() is called. Discarding a task destroys it, so the
+		 * corresponding std::future and Async::Future get a broken_promise error and Async::TaskGroup records TaskCancelled.
+		 * This function can be called from any thread, including the worker threads.
+		 */
+		void cancel() {
+			cancellation.cancel();
+			TaskType discarded;
+			while (poolWorkQueue.tryPop(discarded)) {
+				poppedFromPool();
+				discarded = TaskType {};
+				finished();
+			}
+			for (unsigned i = 0; i < queues.size(); ++i) {
+				while (queues[i]->trySteal(discarded)) {
+					if constexpr (statsEnabled) {
+						counters[i]->localDepth.remove();
+					}
+					discarded = TaskType {};
+					finished();
+				}
+			}
+			idleWorkers.notifyAll();
+		}
+
+		/// Accept new tasks again after cancel(). Call it once the cancelled computation is over and nobody waits for its results.
+		void resetCancellation() noexcept {
+			cancellation.reset();
+		}
+
+		/**
+		 * @brief   Block until all queues of the pool are empty and no task is running.
+		 * @details Every submitted task is counted from the moment it is enqueued until it finishes, including the tasks it submits itself,
+		 * so when drain() returns, all side effects of the tasks are visible in the calling thread. The waiting thread sleeps, it does not poll.
+		 * @note    Do not call it from a worker thread of this pool, and do not call it on a paused pool with waiting tasks, because it would never return.
+		 */
+		void drain() {
+			for (;;) {
+				auto key = drained.prepareWait();
+				if (outstanding.load(std::memory_order_acquire) == 0) {
+					drained.cancelWait();
+					return;
+				}
+				drained.commitWait(key);
+			}
+		}
+
+		/**
+		 * @brief   Pause the pool and block until every worker thread has stopped.
+		 * @details Tasks that are running when quiesce() is called are finished first, tasks waiting in the queues stay there.
+		 * When quiesce() returns true, no worker touches any data until resume() is called.
+		 * @return  true iff all workers stopped, false if another thread resumed the pool in the meantime
+		 * @note    Do not call it from a worker thread of this pool.
+		 */
+		bool quiesce() {
+			pause();
+			idleWorkers.notifyAll();
+			return waitForStoppedWorkers(threads.size());
+		}
+
+		/// Run a single task from the pool or yield if there is no work. Threads waiting for results of their tasks can call it in a loop.
+		void runPendingTask() {
+			if (!tryRunPendingTask()) {
 				std::this_thread::yield();
 			}
 		}
 
+		/**
+		 * Get a snapshot of the pool statistics. With LLU_ASYNC_STATS undefined the result is empty and has the \c enabled flag set to false.
+		 * @return statistics of the pool and of all its workers
+		 */
+		[[nodiscard]] PoolStats stats() const {
+			PoolStats res;
+			res.poolQueueHighWater = poolDepth.maxDepth();
+			for (const auto& c : counters) {
+				res.workers.push_back(c->snapshot());
+			}
+			return res;
+		}
+
+		/// Reset all counters and histograms to zero
+		void resetStats() {
+			poolDepth.reset();
+			for (auto& c : counters) {
+				c->reset();
+			}
+		}
+
 	private:
+		/// Maximal number of tasks a worker takes from the pool queue at once, when the pool queue supports bulk pop
+		static constexpr std::size_t poolRefillBatch = 8;
+
 		std::atomic_bool done = false;
 		PoolQueue poolWorkQueue;
 		std::vector<std::unique_ptr<LocalQueue>> queues;
+		std::vector<std::unique_ptr<Detail::WorkerCounters>> counters;
+		Detail::DepthGauge poolDepth;
+		std::vector<int> workerCpus;
+		StealPolicy stealPolicy;
+		std::atomic<std::size_t> nextBulkQueue = 0;
+		CancellationSource cancellation;
+		std::atomic<std::size_t> outstanding = 0;
+		Async::EventCount drained;
+		Async::EventCount idleWorkers;
 		std::vector<std::thread> threads;
 		Async::ThreadJoiner joiner;
 		inline static thread_local LocalQueue* localWorkQueue = nullptr;
 		inline static thread_local unsigned myIndex = 0;
 
+		/**
+		 * Get the local queue of the calling thread if it is a worker of this pool. The thread-local pointer is shared by all pools of the same type,
+		 * so a worker of another pool that submits tasks to this one, e.g. in parallelFor on Async::sharedPool(), must use the pool queue.
+		 */
+		LocalQueue* ownLocalQueue() const noexcept {
+			return (localWorkQueue && myIndex < queues.size() && queues[myIndex].get() == localWorkQueue) ? localWorkQueue : nullptr;
+		}
+
+		/// Get the counters of the calling thread if it is a worker of this pool
+		Detail::WorkerCounters* ownCounters() const {
+			return ownLocalQueue() ? counters[myIndex].get() : nullptr;
+		}
+
+		/// Update the statistics of the calling worker, compiles to nothing unless LLU_ASYNC_STATS is defined
+		template<typename F>
+		void withStats(F&& f) const {
+			if constexpr (statsEnabled) {
+				if (auto* c = ownCounters()) {
+					f(*c);
+				}
+			}
+		}
+
+		/// Wrap the task so that it records how long it waited in the queue, when statistics are enabled
+		TaskType stamp(TaskType&& task) {
+			if constexpr (statsEnabled) {
+				return TaskType {[this, enqueued = StatsClock::now(), t = std::move(task)]() mutable {
+					withStats([&enqueued](auto& c) { c.recordLatency(StatsClock::now() - enqueued); });
+					t();
+				}};
+			} else {
+				return std::move(task);
+			}
+		}
+
+		/**
+		 * Counts tasks as outstanding before they are pushed, so that a worker that runs them immediately never drives the count below zero.
+		 * If pushing fails, the tasks are not counted.
+		 */
+		class Enqueuing {
+		public:
+			explicit Enqueuing(GenericThreadPool& p, std::size_t n = 1) : pool(p), count(n) {
+				pool.outstanding.fetch_add(count, std::memory_order_relaxed);
+			}
+			Enqueuing(const Enqueuing&) = delete;
+			Enqueuing& operator=(const Enqueuing&) = delete;
+			~Enqueuing() {
+				if (count > 0) {
+					pool.finished(count);
+				}
+			}
+			void commit() noexcept {
+				count = 0;
+			}
+			/// Commit only \p n of the tasks, e.g. when the queue rejected the rest
+			void commit(std::size_t n) noexcept {
+				count -= n;
+			}
+
+		private:
+			GenericThreadPool& pool;
+			std::size_t count;
+		};
+
+		/// Record that \p n outstanding tasks were run or discarded, waking up threads in drain() when there is nothing left
+		void finished(std::size_t n = 1) {
+			if (outstanding.fetch_sub(n, std::memory_order_acq_rel) == n) {
+				drained.notifyAll();
+			}
+		}
+
+		/// Push to the pool queue, a queue with push that returns void never rejects the task
+		template<typename... Args>
+		bool pushToPoolQueue(Args&&... args) {
+			if constexpr (std::is_same_v<decltype(poolWorkQueue.push(std::forward<Args>(args)...)), bool>) {
+				return poolWorkQueue.push(std::forward<Args>(args)...);
+			} else {
+				poolWorkQueue.push(std::forward<Args>(args)...);
+				return true;
+			}
+		}
+
+		/// Tasks submitted from worker threads go to their local queues, other threads use the pool queue
+		void pushTask(TaskType&& task) {
+			task = stamp(std::move(task));
+			Enqueuing enqueuing {*this};
+			if (auto* local = ownLocalQueue()) {
+				withStats([](auto& c) { c.localDepth.add(); });
+				local->push(std::move(task));
+			} else {
+				if constexpr (statsEnabled) {
+					poolDepth.add();
+				}
+				if (!pushToPoolQueue(std::move(task))) {
+					if constexpr (statsEnabled) {
+						poolDepth.remove();
+					}
+					return;
+				}
+			}
+			enqueuing.commit();
+			if constexpr (IdlePolicy::parks) {
+				idleWorkers.notifyOne();
+			}
+		}
+
+		/// Enqueue a batch of tasks with as few lock acquisitions as possible, the tasks are moved from
+		void pushTasks(std::vector<TaskType>& tasks) {
+			if (tasks.empty()) {
+				return;
+			}
+			if constexpr (statsEnabled) {
+				for (auto& task : tasks) {
+					task = stamp(std::move(task));
+				}
+			}
+			auto begin = std::make_move_iterator(tasks.begin());
+			auto end = std::make_move_iterator(tasks.end());
+			Enqueuing enqueuing {*this, tasks.size()};
+			if constexpr (has_bulk_push_v<LocalQueue>) {
+				if (!queues.empty()) {
+					const auto workerCount = queues.size();
+					const auto chunk = (tasks.size() + workerCount - 1) / workerCount;
+					const auto start = nextBulkQueue.fetch_add(1, std::memory_order_relaxed);
+					for (std::size_t k = 0; k * chunk < tasks.size(); ++k) {
+						auto chunkBegin = std::next(begin, static_cast<std::ptrdiff_t>(k * chunk));
+						auto chunkEnd = std::next(begin, static_cast<std::ptrdiff_t>(std::min(tasks.size(), (k + 1) * chunk)));
+						if constexpr (statsEnabled) {
+							counters[(start + k) % workerCount]->localDepth.add(std::distance(chunkBegin, chunkEnd));
+						}
+						queues[(start + k) % workerCount]->pushBulk(chunkBegin, chunkEnd);
+					}
+					enqueuing.commit();
+					notifyBatch();
+					return;
+				}
+			}
+			if constexpr (statsEnabled) {
+				poolDepth.add(static_cast<std::int64_t>(tasks.size()));
+			}
+			std::size_t accepted = tasks.size();
+			if constexpr (has_bulk_push_v<PoolQueue>) {
+				poolWorkQueue.pushBulk(begin, end);
+			} else {
+				// tasks rejected by the queue are destroyed (their futures report broken_promise) and must not stay outstanding
+				accepted = 0;
+				for (auto& task : tasks) {
+					accepted += pushToPoolQueue(std::move(task)) ? 1 : 0;
+				}
+				if constexpr (statsEnabled) {
+					poolDepth.remove(static_cast<std::int64_t>(tasks.size() - accepted));
+				}
+			}
+			enqueuing.commit(accepted);
+			if (accepted > 0) {
+				notifyBatch();
+			}
+		}
+
+		void notifyBatch() {
+			if constexpr (IdlePolicy::parks) {
+				idleWorkers.notifyAll();
+			}
+		}
+
+		void pushTask(TaskPriority priority, TaskType&& task) {
+			if constexpr (statsEnabled) {
+				poolDepth.add();
+			}
+			Enqueuing enqueuing {*this};
+			if (!pushToPoolQueue(priority, stamp(std::move(task)))) {
+				if constexpr (statsEnabled) {
+					poolDepth.remove();
+				}
+				return;
+			}
+			enqueuing.commit();
+			if constexpr (IdlePolicy::parks) {
+				idleWorkers.notifyOne();
+			}
+		}
+
 		void workerThread(unsigned my_index_) {
 			myIndex = my_index_;
 			localWorkQueue = queues[myIndex].get();
+			Async::Topology::pinCurrentThread(workerCpus[myIndex]);
+			unsigned idleRounds = 0;
 			while (!done) {
-				runPendingTask();
+				if (tryRunPendingTask()) {
+					idleRounds = 0;
+				} else {
+					idle(idleRounds);
+				}
 				checkPause();
 			}
 		}
+
+		/// Wait for work according to the IdlePolicy, \p idleRounds is the number of consecutive unsuccessful attempts to find a task
+		void idle(unsigned& idleRounds) {
+			if (idleRounds < IdlePolicy::spinRounds) {
+				withStats([](auto& c) { c.idleSpins.add(); });
+				++idleRounds;
+				Async::cpuRelax();
+			} else if (!IdlePolicy::parks || idleRounds - IdlePolicy::spinRounds < IdlePolicy::yieldRounds) {
+				if (idleRounds < std::numeric_limits<unsigned>::max()) {
+					++idleRounds;
+				}
+				withStats([](auto& c) { c.idleSpins.add(); });
+				std::this_thread::yield();
+			} else {
+				park();
+				idleRounds = 0;
+			}
+		}
+
+		/// Put the worker thread to sleep until a new task is pushed to any queue of the pool, until the pool is paused or until it is destroyed
+		void park() {
+			auto key = idleWorkers.prepareWait();
+			if (done || paused() || hasWork()) {
+				idleWorkers.cancelWait();
+				return;
+			}
+			withStats([](auto& c) { c.parks.add(); });
+			idleWorkers.commitWait(key);
+		}
+
+		bool hasWork() const {
+			if (!poolWorkQueue.empty()) {
+				return true;
+			}
+			return std::any_of(queues.cbegin(), queues.cend(), [](const auto& q) { return !q->empty(); });
+		}
+		bool popUrgentTask(TaskType& task) {
+			if constexpr (has_priority_lanes_v<PoolQueue>) {
+				return poolWorkQueue.tryPopUrgent(task) && poppedFromPool();
+			} else {
+				return false;
+			}
+		}
 		bool popTaskFromLocalQueue(TaskType& task) {
-			return localWorkQueue && localWorkQueue->tryPop(task);
+			auto* local = ownLocalQueue();
+			if (!local || !local->tryPop(task)) {
+				return false;
+			}
+			withStats([](auto& c) {
+				c.localPops.add();
+				c.localDepth.remove();
+			});
+			return true;
 		}
 		bool popTaskFromPoolQueue(TaskType& task) {
-			return poolWorkQueue.tryPop(task);
+			if constexpr (has_bulk_pop_v<PoolQueue>) {
+				if (auto* local = ownLocalQueue()) {
+					return refillFromPoolQueue(*local, task);
+				}
+			}
+			return poolWorkQueue.tryPop(task) && poppedFromPool();
+		}
+		/// Take a batch of tasks from the pool queue with a single lock, the first one is returned and the rest go to the local queue of the worker
+		bool refillFromPoolQueue(LocalQueue& local, TaskType& task) {
+			std::array<TaskType, poolRefillBatch> batch;
+			const auto count = poolWorkQueue.tryPopBulk(batch.begin(), batch.size());
+			if (count == 0) {
+				return false;
+			}
+			poppedFromPool(count);
+			task = std::move(batch[0]);
+			if (count > 1) {
+				withStats([count](auto& c) { c.localDepth.add(static_cast<std::int64_t>(count - 1)); });
+				// reversed, so that the local queue hands the tasks out in the order in which they were submitted
+				auto first = std::make_move_iterator(std::make_reverse_iterator(std::next(batch.begin(), static_cast<std::ptrdiff_t>(count))));
+				auto last = std::make_move_iterator(std::make_reverse_iterator(std::next(batch.begin())));
+				if constexpr (has_bulk_push_v<LocalQueue>) {
+					local.pushBulk(first, last);
+				} else {
+					for (; first != last; ++first) {
+						local.push(*first);
+					}
+				}
+				// let a sleeping worker come and steal a part of the batch
+				if constexpr (IdlePolicy::parks) {
+					idleWorkers.notifyOne();
+				}
+			}
+			return true;
+		}
+		/// Record that \p n tasks were taken from the pool queue, always returns true
+		bool poppedFromPool([[maybe_unused]] std::size_t n = 1) {
+			if constexpr (statsEnabled) {
+				poolDepth.remove(static_cast<std::int64_t>(n));
+				withStats([n](auto& c) { c.poolPops.add(n); });
+			}
+			return true;
 		}
 		bool popTaskFromOtherThreadQueue(TaskType& task) {
-			for (unsigned i = 0; i < queues.size(); ++i) {
-				unsigned const index = (myIndex + i + 1) % queues.size();
-				if (queues[index]->trySteal(task)) {
-					return true;
+			const auto workerCount = static_cast<unsigned>(queues.size());
+			auto* local = ownLocalQueue();
+			const auto thief = local ? myIndex : workerCount;
+			return stealPolicy.forEachVictim(thief, workerCount, [&](unsigned victim) {
+				auto& victimQueue = *queues[victim];
+				withStats([](auto& c) { c.stealAttempts.add(); });
+				if (!victimQueue.trySteal(task)) {
+					return false;
+				}
+				stolenFrom(victim);
+				if constexpr (StealPolicy::stealHalf) {
+					if (local && local != &victimQueue) {
+						stealMore(*local, victim);
+					}
+				}
+				return true;
+			});
+		}
+
+		/// Move half of the tasks remaining in the queue of the \p victim to the local queue of the calling worker
+		void stealMore(LocalQueue& local, unsigned victim) {
+			auto& victimQueue = *queues[victim];
+			if constexpr (has_steal_half_v<LocalQueue> && has_bulk_push_v<LocalQueue>) {
+				// one critical section on each side instead of one per task
+				std::vector<TaskType> stolen;
+				if (victimQueue.tryStealHalf(std::back_inserter(stolen)) > 0) {
+					stolenFrom(victim, stolen.size());
+					withStats([n = stolen.size()](auto& c) { c.localDepth.add(static_cast<std::int64_t>(n)); });
+					local.pushBulk(std::make_move_iterator(stolen.begin()), std::make_move_iterator(stolen.end()));
+				}
+			} else {
+				TaskType stolen;
+				for (auto toSteal = victimQueue.size() / 2; toSteal > 0 && victimQueue.trySteal(stolen); --toSteal) {
+					stolenFrom(victim);
+					withStats([](auto& c) { c.localDepth.add(); });
+					local.push(std::move(stolen));
 				}
 			}
-			return false;
+		}
+
+		/// Record \p n successful steals from the queue of given worker
+		void stolenFrom([[maybe_unused]] unsigned victim, [[maybe_unused]] std::size_t n = 1) {
+			if constexpr (statsEnabled) {
+				counters[victim]->localDepth.remove(static_cast<std::int64_t>(n));
+				withStats([n](auto& c) { c.steals.add(n); });
+			}
 		}
 	};
 
@@ -224,9 +909,22 @@ namespace LLU {
 	/// Good default choice for a thread pool for any paclet.
 	using BasicPool = Async::BasicThreadPool<Async::ThreadsafeQueue<Async::FunctionWrapper>>;
 
+	/// Alias for BasicThreadPool with a fixed-capacity BoundedQueue storing Async::FunctionWrappers.
+	/// Submitting a task does not allocate any queue nodes and submit blocks when there are already 1024 tasks waiting.
+	using BoundedBasicPool = Async::BasicThreadPool<Async::BoundedQueue<Async::FunctionWrapper>>;
+
 	/// Alias for GenericThreadPool with ThreadsafeQueue and WorkStealingQueue storing Async::FunctionWrappers.
 	/// Good choice for a thread pool if the tasks that will be executed involve submitting new tasks for the pool.
 	using ThreadPool = Async::GenericThreadPool<Async::ThreadsafeQueue<Async::FunctionWrapper>, Async::WorkStealingQueue<std::deque<Async::FunctionWrapper>>>;
+
+	/// Alias for GenericThreadPool with ThreadsafeQueue and lock-free ChaseLevQueue storing Async::FunctionWrappers.
+	/// Same as ThreadPool, but the per-thread queues do not use locks, which reduces contention with many workers and fine-grained tasks.
+	using LockFreeThreadPool = Async::GenericThreadPool<Async::ThreadsafeQueue<Async::FunctionWrapper>, Async::ChaseLevQueue<Async::FunctionWrapper>>;
+
+	/// Alias for GenericThreadPool with a separate pool queue for each Async::TaskPriority.
+	/// Use it when latency-sensitive tasks share the pool with bulk work, submitting them with submit(TaskPriority::High, f, args...).
+	using PriorityThreadPool = Async::GenericThreadPool<Async::LaneQueue<Async::ThreadsafeQueue<Async::FunctionWrapper>>,
+														Async::WorkStealingQueue<std::deque<Async::FunctionWrapper>>>;
 }// namespace LLU
 
 #endif	  // LLU_ASYNC_THREADPOOL_H
@@ -0,0 +1,44 @@
+/**
+ * @file	Tiling.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Parallel processing of Image tiles and frames on thread pools from LLU::Async.
+ */
+#ifndef LLU_ASYNC_TILING_H
+#define LLU_ASYNC_TILING_H
+
+#include "LLU/Async/Algorithms.h"
+#include "LLU/Containers/Views/Pixels.hpp"
+#include "LLU/Containers/Views/Tiles.hpp"
+
+namespace LLU::Async {
+
+	/**
+	 * @brief   Call \p f on every tile of the grid, distributing the tiles among threads of the pool
+	 * @details Each tile is processed as a separate task, so tiles should be big enough to amortize the cost of a task, see TileGrid::forCache.
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  F - callable that takes const ImageTile&
+	 * @param   pool - thread pool to run the tasks
+	 * @param   grid - tiles to be processed
+	 * @param   f - function to be called on each tile, calls for different tiles may run concurrently
+	 */
+	template<typename Pool, typename F>
+	void forEachTile(Pool& pool, const TileGrid& grid, F&& f) {
+		parallelFor(pool, mint {0}, grid.size(), 1, [&grid, &f](mint i) { f(grid[i]); });
+	}
+
+	/**
+	 * @brief   Call \p f on every frame of a 3D image (or on the only frame of a 2D image), distributing the frames among threads of the pool
+	 * @tparam  Pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @tparam  T - type of image data
+	 * @tparam  F - callable that takes PixelAccessor<T> of a single frame and the index of the frame
+	 * @param   pool - thread pool to run the tasks
+	 * @param   pixels - accessor for the whole image
+	 * @param   f - function to be called on each frame, calls for different frames may run concurrently
+	 */
+	template<typename Pool, typename T, typename F>
+	void forEachFrame(Pool& pool, const PixelAccessor<T>& pixels, F&& f) {
+		parallelFor(pool, mint {0}, pixels.layout().slices, 1, [&pixels, &f](mint slice) { f(pixels.frame(slice), slice); });
+	}
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_TILING_H
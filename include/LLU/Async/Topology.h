@@ -0,0 +1,56 @@
+/**
+ * @file	Topology.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Basic queries about the CPU topology and pinning threads to logical CPUs.
+ */
+#ifndef LLU_ASYNC_TOPOLOGY_H
+#define LLU_ASYNC_TOPOLOGY_H
+
+#include <vector>
+
+namespace LLU::Async::Topology {
+
+	/**
+	 * Get the number of logical CPUs in the system
+	 * @return number of logical CPUs, at least 1
+	 */
+	unsigned cpuCount();
+
+	/**
+	 * Find out which last-level cache is used by given logical CPU. Logical CPUs that share the cache have the same group id.
+	 * @param cpu - logical CPU index
+	 * @return non-negative id of the cache, or -1 if the platform does not provide this information
+	 */
+	int cacheGroup(int cpu);
+
+	/**
+	 * Get all logical CPUs ordered so that CPUs which share the last-level cache are next to each other.
+	 * Pinning consecutive workers of a thread pool to CPUs in this order keeps them close together.
+	 * @return list of logical CPU indices
+	 */
+	std::vector<int> compactCpuOrder();
+
+	/**
+	 * Find out which NUMA node given logical CPU belongs to
+	 * @param cpu - logical CPU index
+	 * @return non-negative id of the node, or -1 if the platform does not provide this information
+	 */
+	int numaNode(int cpu);
+
+	/**
+	 * Get logical CPUs grouped by NUMA node, in the order of node ids. Nodes without CPUs, e.g. memory-only nodes, are skipped.
+	 * If the platform does not provide NUMA information the result is a single group of all CPUs in compactCpuOrder.
+	 * @return list of non-empty CPU groups, one per node
+	 */
+	std::vector<std::vector<int>> numaNodeCpus();
+
+	/**
+	 * Restrict the calling thread to run only on given logical CPU
+	 * @param cpu - logical CPU index
+	 * @return true iff the thread was pinned, pinning is not supported for instance on macOS
+	 */
+	bool pinCurrentThread(int cpu) noexcept;
+
+}  // namespace LLU::Async::Topology
+
+#endif	  // LLU_ASYNC_TOPOLOGY_H
@@ -6,10 +6,17 @@
 #ifndef LLU_ASYNC_UTILITIES_H
 #define LLU_ASYNC_UTILITIES_H
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
 #include <functional>
 #include <future>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace LLU::Async {
@@ -18,26 +25,71 @@ namespace LLU::Async {
 	 * @class FunctionWrapper
 	 * @brief Wraps an arbitrary callable object (possibly binding its arguments) to be evaluated later.
 	 * The callable object, when called on provided arguments, must return void.
+	 *
+	 * Callables that fit in the internal buffer (FunctionWrapper::BufferSize bytes) and are nothrow move constructible are stored inline,
+	 * so wrapping a small lambda or a std::packaged_task does not allocate. Bigger callables are stored on the heap.
+	 * Instead of a virtual function table, each FunctionWrapper holds a pointer to a static function that invokes the stored callable
+	 * and a pointer to a static function that moves or destroys it.
 	 */
 	class FunctionWrapper {
-		/// Abstract interface for type-erased callable classes
-		struct TypeErasedCallableBase {
-			virtual void call() = 0;
-			virtual ~TypeErasedCallableBase() = default;
+	public:
+		/// Size of the inline buffer for small callables
+		static constexpr std::size_t BufferSize = 48;
+
+	private:
+		/// Raw storage for the callable object or for a pointer to the heap-allocated callable
+		struct Storage {
+			alignas(std::max_align_t) std::byte buffer[BufferSize];
 		};
 
-		/**
-		 * @brief   Internal structure that represents type-erased callable objects
-		 * @tparam  F - any callable type (function, lambda, member function, etc)
-		 */
+		/// Operations that the manager function can perform on the stored callable
+		enum class Operation { Move, Destroy };
+
+		/// Type of the trampoline function that calls the stored callable
+		using Invoker = void (*)(Storage&);
+
+		/// Type of the function that moves the callable from \c src to \c dst or destroys the callable in \c dst
+		using Manager = void (*)(Operation, Storage& dst, Storage* src) noexcept;
+
+		/// Check if a callable of type F will be stored inline
+		template<typename F>
+		static constexpr bool storedInline = sizeof(F) <= BufferSize && alignof(std::max_align_t) % alignof(F) == 0 && std::is_nothrow_move_constructible_v<F>;
+
+		/// Static functions dealing with callables stored in the inline buffer
 		template<typename F>
-		struct TypeErasedCallable : TypeErasedCallableBase {
-			explicit TypeErasedCallable(F&& f) : callable(std::forward<F>(f)) {}
+		struct InlineCallable {
+			static F& get(Storage& s) noexcept {
+				return *std::launder(reinterpret_cast<F*>(&s.buffer));
+			}
+			static void call(Storage& s) {
+				get(s)();
+			}
+			static void manage(Operation op, Storage& dst, Storage* src) noexcept {
+				if (op == Operation::Move) {
+					new (&dst.buffer) F(std::move(get(*src)));
+					get(*src).~F();
+				} else {
+					get(dst).~F();
+				}
+			}
+		};
 
-			void call() override {
-				callable();
+		/// Static functions dealing with callables stored on the heap
+		template<typename F>
+		struct HeapCallable {
+			static F*& get(Storage& s) noexcept {
+				return *std::launder(reinterpret_cast<F**>(&s.buffer));
+			}
+			static void call(Storage& s) {
+				(*get(s))();
+			}
+			static void manage(Operation op, Storage& dst, Storage* src) noexcept {
+				if (op == Operation::Move) {
+					new (&dst.buffer) F*(get(*src));
+				} else {
+					delete get(dst);
+				}
 			}
-			F callable;
 		};
 
 	public:
@@ -46,8 +98,10 @@ namespace LLU::Async {
 		 * @tparam  F - any callable type (function, lambda, member function, etc)
 		 * @param   f - a callable object of type \p F
 		 */
-		template<typename F, typename = std::enable_if_t<!std::is_same_v<std::remove_cv<F>, FunctionWrapper>>>
-		explicit FunctionWrapper(F&& f) : impl {std::make_unique<TypeErasedCallable<F>>(std::forward<F>(f))} {}
+		template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, FunctionWrapper>>>
+		explicit FunctionWrapper(F&& f) {
+			emplace<std::decay_t<F>>(std::forward<F>(f));
+		}
 
 		/**
 		 * @brief   Create a FunctionWrapper from a callable object and arguments for the call
@@ -58,27 +112,78 @@ namespace LLU::Async {
 		 */
 		template<typename F, typename... Args>
 		explicit FunctionWrapper(F&& f, Args&&... args) {
+			// NOLINTNEXTLINE(modernize-avoid-bind): perfect forwarding capture of a parameter pack in a lambda is not trivial
 			auto boundF = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
-			impl = std::make_unique<TypeErasedCallable<F>>(std::move(boundF));
+			emplace<decltype(boundF)>(std::move(boundF));
 		}
 
 		/// @cond
 		FunctionWrapper() = default;
-		FunctionWrapper(FunctionWrapper&& other) noexcept = default;
-		FunctionWrapper& operator=(FunctionWrapper&& other) noexcept = default;
+		FunctionWrapper(FunctionWrapper&& other) noexcept {
+			moveFrom(other);
+		}
+		FunctionWrapper& operator=(FunctionWrapper&& other) noexcept {
+			if (this != &other) {
+				reset();
+				moveFrom(other);
+			}
+			return *this;
+		}
 		FunctionWrapper(const FunctionWrapper&) = delete;
 		FunctionWrapper& operator=(const FunctionWrapper&) = delete;
-		~FunctionWrapper() = default;
+		~FunctionWrapper() {
+			reset();
+		}
 		/// @endcond
 
 		/// Call the internal callable object
 		void operator()() {
-			impl->call();
+			invoker(storage);
+		}
+
+		/// Check if the FunctionWrapper holds a callable object
+		explicit operator bool() const noexcept {
+			return invoker != nullptr;
 		}
 
 	private:
-		/// Internal pointer to the type-erased callable object
-		std::unique_ptr<TypeErasedCallableBase> impl = nullptr;
+		/// Storage for the type-erased callable object
+		Storage storage {};
+
+		/// Trampoline that calls the stored callable, nullptr if the wrapper is empty
+		Invoker invoker = nullptr;
+
+		/// Function that moves or destroys the stored callable, nullptr if the wrapper is empty
+		Manager manager = nullptr;
+
+		template<typename F, typename Arg>
+		void emplace(Arg&& f) {
+			if constexpr (storedInline<F>) {
+				new (&storage.buffer) F(std::forward<Arg>(f));
+				invoker = &InlineCallable<F>::call;
+				manager = &InlineCallable<F>::manage;
+			} else {
+				new (&storage.buffer) F*(new F(std::forward<Arg>(f)));
+				invoker = &HeapCallable<F>::call;
+				manager = &HeapCallable<F>::manage;
+			}
+		}
+
+		void moveFrom(FunctionWrapper& other) noexcept {
+			if (other.manager) {
+				other.manager(Operation::Move, storage, &other.storage);
+				invoker = std::exchange(other.invoker, nullptr);
+				manager = std::exchange(other.manager, nullptr);
+			}
+		}
+
+		void reset() noexcept {
+			if (manager) {
+				manager(Operation::Destroy, storage, nullptr);
+				invoker = nullptr;
+				manager = nullptr;
+			}
+		}
 	};
 
 	/**
@@ -129,6 +234,48 @@ namespace LLU::Async {
 		return std::packaged_task<result_type()> {std::move(boundF)};
 	}
 
+	/// Type trait that checks whether a queue can push a whole range of elements at once with a pushBulk(first, last) method
+	template<typename Queue, typename = void>
+	struct has_bulk_push : std::false_type {};
+
+	/// @cond
+	template<typename Queue>
+	struct has_bulk_push<Queue, std::void_t<decltype(std::declval<Queue&>().pushBulk(std::declval<typename Queue::value_type*>(),
+																				 std::declval<typename Queue::value_type*>()))>> : std::true_type {};
+	/// @endcond
+
+	/// Convenience variable template for has_bulk_push
+	template<typename Queue>
+	inline constexpr bool has_bulk_push_v = has_bulk_push<Queue>::value;
+
+	/// Type trait that checks whether a queue can pop several elements at once with a tryPopBulk(out, maxCount) method
+	template<typename Queue, typename = void>
+	struct has_bulk_pop : std::false_type {};
+
+	/// @cond
+	template<typename Queue>
+	struct has_bulk_pop<Queue, std::void_t<decltype(std::declval<Queue&>().tryPopBulk(std::declval<typename Queue::value_type*>(), std::size_t {}))>>
+		: std::true_type {};
+	/// @endcond
+
+	/// Convenience variable template for has_bulk_pop
+	template<typename Queue>
+	inline constexpr bool has_bulk_pop_v = has_bulk_pop<Queue>::value;
+
+	/// Type trait that checks whether a queue can give away half of its elements at once with a tryStealHalf(out) method
+	template<typename Queue, typename = void>
+	struct has_steal_half : std::false_type {};
+
+	/// @cond
+	template<typename Queue>
+	struct has_steal_half<Queue, std::void_t<decltype(std::declval<Queue&>().tryStealHalf(std::declval<typename Queue::value_type*>()))>>
+		: std::true_type {};
+	/// @endcond
+
+	/// Convenience variable template for has_steal_half
+	template<typename Queue>
+	inline constexpr bool has_steal_half_v = has_steal_half<Queue>::value;
+
 	/**
 	 * @class Pausable
 	 * @brief Utility class for pausable task queues.
@@ -137,6 +284,8 @@ namespace LLU::Async {
 		std::atomic_bool pausedQ = false;
 		std::mutex workersMutex;
 		std::condition_variable pausedWorkers;
+		std::condition_variable workerStopped;
+		std::size_t stoppedCount = 0;
 	public:
 
 		/// This is the function worker threads will call to see if the work has been paused.
@@ -144,7 +293,10 @@ namespace LLU::Async {
 		void checkPause() {
 			if (pausedQ) {
 				std::unique_lock lck {workersMutex};
+				++stoppedCount;
+				workerStopped.notify_all();
 				pausedWorkers.wait(lck, [&]() -> bool { return !pausedQ; });
+				--stoppedCount;
 			}
 		}
 
@@ -155,9 +307,63 @@ namespace LLU::Async {
 
 		/// Signal to resume work and notify waiting worker threads
 		void resume() noexcept {
-			pausedQ = false;
+			{
+				std::lock_guard lck {workersMutex};
+				pausedQ = false;
+			}
 			pausedWorkers.notify_all();
+			workerStopped.notify_all();
+		}
+
+		/// Check if the work is paused
+		[[nodiscard]] bool paused() const noexcept {
+			return pausedQ;
 		}
+
+	protected:
+		/**
+		 * Block until \p workerCount threads are waiting in checkPause or until the work is resumed
+		 * @param workerCount - number of worker threads to wait for
+		 * @return true iff all workers stopped, false if resume was called in the meantime
+		 */
+		bool waitForStoppedWorkers(std::size_t workerCount) {
+			std::unique_lock lck {workersMutex};
+			workerStopped.wait(lck, [&]() -> bool { return !pausedQ || stoppedCount >= workerCount; });
+			return pausedQ;
+		}
+	};
+
+	/**
+	 * @class   ScheduleAwaiter
+	 * @brief   Awaitable returned by the schedule() method of thread pools, <tt>co_await pool.schedule()</tt> moves a coroutine to a worker thread.
+	 * @details The coroutine is suspended and a task that resumes it is posted to the pool, so from a worker thread of a pool with local queues
+	 * it goes to the local queue of that worker, where other workers can steal it. The class only needs C++17, the coroutine handle is a
+	 * template parameter, see LLU/Async/Coroutine.h for coroutine tasks.
+	 * @note    Tasks discarded by a cancelled pool do not resume their coroutines, so coroutines should not be suspended on a pool that is
+	 * cancelled or destroyed.
+	 * @tparam  Pool - thread pool with a post method
+	 */
+	template<typename Pool>
+	class ScheduleAwaiter {
+	public:
+		/// Create an awaiter for given pool
+		explicit ScheduleAwaiter(Pool& p) noexcept : pool(p) {}
+
+		/// The coroutine is always suspended
+		[[nodiscard]] bool await_ready() const noexcept {
+			return false;
+		}
+
+		/// Post the resumption of the coroutine to the pool, if posting throws the coroutine is resumed with the exception
+		template<typename Handle>
+		void await_suspend(Handle h) {
+			pool.post([h]() mutable { h.resume(); });
+		}
+
+		void await_resume() const noexcept {}
+
+	private:
+		Pool& pool;
 	};
 } // namespace LLU::Async
 
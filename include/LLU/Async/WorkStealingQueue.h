@@ -6,6 +6,7 @@
 #ifndef LLU_ASYNC_WORKSTEALINGQUEUE_H
 #define LLU_ASYNC_WORKSTEALINGQUEUE_H
 
+#include <cstddef>
 #include <mutex>
 
 namespace LLU::Async {
@@ -24,6 +25,9 @@ namespace LLU::Async {
 		mutable std::mutex theMutex;
 
 	public:
+		/// Value type of queue elements
+		using value_type = DataType;
+
 		/**
 		 * Push new element to the beginning of the queue
 		 * @param data - new element
@@ -33,6 +37,20 @@ namespace LLU::Async {
 			theQueue.push_front(std::move(data));
 		}
 
+		/**
+		 * Push all elements from a range to the beginning of the queue under a single lock. Can be called by any thread.
+		 * @tparam InputIt - input iterator type
+		 * @param first - iterator to the first element, elements are moved from
+		 * @param last - iterator past the last element
+		 */
+		template<typename InputIt>
+		void pushBulk(InputIt first, InputIt last) {
+			std::lock_guard<std::mutex> lock(theMutex);
+			for (; first != last; ++first) {
+				theQueue.push_front(std::move(*first));
+			}
+		}
+
 		/**
 		 * Check if the queue is empty
 		 * @return true iff the queue is empty
@@ -42,6 +60,15 @@ namespace LLU::Async {
 			return theQueue.empty();
 		}
 
+		/**
+		 * Get the number of elements in the queue
+		 * @return current size of the queue
+		 */
+		[[nodiscard]] std::size_t size() const {
+			std::lock_guard<std::mutex> lock(theMutex);
+			return theQueue.size();
+		}
+
 		/**
 		 * Try to pop a task from the beginning of the queue in a non-blocking way
 		 * @param[out] res - reference to which the new task should be assigned
@@ -71,6 +98,41 @@ namespace LLU::Async {
 			theQueue.pop_back();
 			return true;
 		}
+
+		/**
+		 * Pop up to \p maxCount tasks from the beginning of the queue under a single lock
+		 * @tparam OutputIt - output iterator type
+		 * @param[out] out - iterator to which the tasks are written, starting with the one at the front of the queue
+		 * @param maxCount - maximal number of tasks to pop
+		 * @return number of tasks popped
+		 */
+		template<typename OutputIt>
+		std::size_t tryPopBulk(OutputIt out, std::size_t maxCount) {
+			std::lock_guard<std::mutex> lock(theMutex);
+			std::size_t count = 0;
+			for (; count < maxCount && !theQueue.empty(); ++count, ++out) {
+				*out = std::move(theQueue.front());
+				theQueue.pop_front();
+			}
+			return count;
+		}
+
+		/**
+		 * Steal half of the tasks (rounded up) from the end of the queue under a single lock
+		 * @tparam OutputIt - output iterator type
+		 * @param[out] out - iterator to which the tasks are written, starting with the one at the back of the queue
+		 * @return number of tasks stolen
+		 */
+		template<typename OutputIt>
+		std::size_t tryStealHalf(OutputIt out) {
+			std::lock_guard<std::mutex> lock(theMutex);
+			const auto toSteal = (theQueue.size() + 1) / 2;
+			for (std::size_t i = 0; i < toSteal; ++i, ++out) {
+				*out = std::move(theQueue.back());
+				theQueue.pop_back();
+			}
+			return toSteal;
+		}
 	};
 } // namespace LLU::Async
 
@@ -0,0 +1,111 @@
+/**
+ * @file	WorkerContext.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Per-thread scratch memory for tasks executed by thread pools, reclaimed after every task.
+ */
+#ifndef LLU_ASYNC_WORKERCONTEXT_H
+#define LLU_ASYNC_WORKERCONTEXT_H
+
+#include <atomic>
+#include <cstddef>
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+
+namespace LLU {
+	class ScratchArena;
+}  // namespace LLU
+
+namespace LLU::Async {
+
+	/**
+	 * @class   WorkerContext
+	 * @brief   Gives the task that is currently running on a thread access to the scratch arena of that thread.
+	 *
+	 * Thread pools reclaim all scratch memory allocated by a task when the task returns, so tasks can get temporary buffers with a pointer increment
+	 * instead of going through the global allocator, which becomes a contention point when many workers allocate at the same time:
+	 * @code
+	 * 	pool.post([n] {
+	 * 		auto& arena = LLU::Async::thisWorker().scratch();
+	 * 		auto* tmp = arena.allocateArray<double>(n);
+	 * 		std::pmr::vector<int> ids {&LLU::Async::thisWorker().memoryResource()};
+	 * 		...
+	 * 	});	 // tmp and the storage of ids are reclaimed here
+	 * @endcode
+	 * Tasks that a worker runs while waiting inside another task, e.g. for a future, get their own part of the arena, which is reclaimed when they
+	 * return, so they never release memory of the task that waits. Outside of a pool task the scratch memory is only reclaimed by the caller,
+	 * e.g. with a ScratchScope.
+	 */
+	class WorkerContext {
+	public:
+		/// Get the scratch arena of the calling thread, the same one as ScratchArena::forThread()
+		[[nodiscard]] ScratchArena& scratch() const;
+
+#if __has_include(<memory_resource>)
+		/// Get a memory resource that allocates from the scratch arena of the calling thread, for std::pmr containers
+		[[nodiscard]] std::pmr::memory_resource& memoryResource() const;
+#endif
+
+		/// Reclaim all scratch memory allocated by the current task so far, or the whole arena outside of a pool task
+		void releaseScratch() const noexcept;
+
+		/// Check whether the calling thread is running a task of a thread pool
+		[[nodiscard]] bool inTask() const noexcept;
+	};
+
+	/// Get the context of the task running on the calling thread
+	inline WorkerContext thisWorker() noexcept {
+		return {};
+	}
+
+	namespace Detail {
+		/// Access to the scratch arena of the calling thread, so that thread pools stay header-only and independent of the Wolfram Language
+		struct ScratchHooks {
+			/// Store the current state of the arena
+			void (*mark)(std::size_t& block, std::size_t& offset) noexcept;
+			/// Restore the arena to a state obtained from mark
+			void (*rewind)(std::size_t block, std::size_t offset) noexcept;
+		};
+
+		/// Set by ScratchArena::forThread() when the first arena is created, until then there is no scratch memory to reclaim
+		inline std::atomic<const ScratchHooks*> scratchHooks {nullptr};
+
+		class TaskScratchScope;
+
+		/// Innermost task running on the calling thread
+		inline thread_local TaskScratchScope* currentTask = nullptr;
+
+		/// Created by thread pools around every task they run, reclaims the scratch memory that the task allocated
+		class TaskScratchScope {
+		public:
+			TaskScratchScope() noexcept : outer {currentTask} {
+				if (const auto* hooks = scratchHooks.load(std::memory_order_acquire)) {
+					hooks->mark(block, offset);
+				}
+				currentTask = this;
+			}
+
+			TaskScratchScope(const TaskScratchScope&) = delete;
+			TaskScratchScope& operator=(const TaskScratchScope&) = delete;
+
+			~TaskScratchScope() {
+				rewind();
+				currentTask = outer;
+			}
+
+			/// Rewind the arena to the state from before the task started, which is the empty arena if no arena existed at that time
+			void rewind() const noexcept {
+				if (const auto* hooks = scratchHooks.load(std::memory_order_acquire)) {
+					hooks->rewind(block, offset);
+				}
+			}
+
+		private:
+			TaskScratchScope* outer;
+			std::size_t block = 0;
+			std::size_t offset = 0;
+		};
+	}  // namespace Detail
+}  // namespace LLU::Async
+
+#endif	  // LLU_ASYNC_WORKERCONTEXT_H
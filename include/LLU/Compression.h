@@ -0,0 +1,230 @@
+/**
+ * @file	Compression.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief	Block compression of raw data with pluggable codecs and a byte-shuffle filter, and sending compressed arrays over WSTP.
+ */
+#ifndef LLU_COMPRESSION_H
+#define LLU_COMPRESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "LLU/Containers/NumericArray.h"
+#include "LLU/Containers/Tensor.h"
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/Utilities.hpp"
+#include "LLU/WSTP/WSStream.hpp"
+
+namespace LLU::Compression {
+
+	/// Compressed bytes of a whole buffer: a frame header, the sizes of all blocks and the blocks
+	using Frame = std::vector<std::uint8_t>;
+
+	/**
+	 * @class	Codec
+	 * @brief	Abstract compression algorithm that compresses independent blocks of data.
+	 *
+	 * LLU comes with two codecs: the "store" codec (id 0) that copies the data, and a fast LZ codec (id 1) that writes blocks in the LZ4 block
+	 * format. Other algorithms, for instance Zstandard from libzstd, can be plugged in by deriving from Codec and calling registerCodec.
+	 * Implementations must be thread-safe, because blocks are compressed in parallel.
+	 */
+	class Codec {
+	public:
+		Codec() = default;
+		Codec(const Codec&) = delete;
+		Codec& operator=(const Codec&) = delete;
+		Codec(Codec&&) = delete;
+		Codec& operator=(Codec&&) = delete;
+		virtual ~Codec() = default;
+
+		/// Get the id of the codec, which is stored in every frame
+		[[nodiscard]] virtual std::uint32_t id() const noexcept = 0;
+
+		/**
+		 * @brief	Compress a single block
+		 * @param 	in - data to compress
+		 * @param 	size - number of bytes to compress
+		 * @param 	out - output buffer
+		 * @param 	capacity - size of the output buffer, blocks are only stored compressed if they get smaller
+		 * @return	number of bytes written to \p out, or 0 if the compressed block would not fit in \p capacity bytes, then the block is stored as is
+		 * @throw 	ErrorName::CompressionFailed if the codec failed for another reason
+		 */
+		virtual std::size_t compress(const std::uint8_t* in, std::size_t size, std::uint8_t* out, std::size_t capacity) const = 0;
+
+		/**
+		 * @brief	Decompress a single block
+		 * @param 	in - compressed block
+		 * @param 	size - size of the compressed block in bytes
+		 * @param 	out - output buffer
+		 * @param 	outSize - exact size of the decompressed block
+		 * @throw 	ErrorName::InvalidCompressedData if the block is corrupted or does not decompress to exactly \p outSize bytes
+		 */
+		virtual void decompress(const std::uint8_t* in, std::size_t size, std::uint8_t* out, std::size_t outSize) const = 0;
+	};
+
+	/// Id of the codec that stores the data without compressing it
+	inline constexpr std::uint32_t storeCodecId = 0;
+
+	/// Id of the built-in LZ codec, which writes blocks in the LZ4 block format
+	inline constexpr std::uint32_t lzCodecId = 1;
+
+	/**
+	 * @brief	Make a codec available to compress and decompress, replacing a previous codec with the same id
+	 * @param 	codec - the codec, ids 0 and 1 are reserved for the built-in codecs
+	 * @throw 	ErrorName::CompressionFailed if \p codec is null or uses a reserved id
+	 */
+	void registerCodec(std::shared_ptr<const Codec> codec);
+
+	/**
+	 * @brief	Get a registered codec
+	 * @throw 	ErrorName::UnknownCodec if no codec is registered with given id
+	 */
+	std::shared_ptr<const Codec> getCodec(std::uint32_t id);
+
+	/// Options of compress
+	struct Options {
+		/// Id of a registered codec
+		std::uint32_t codec = lzCodecId;
+		/// Size of the elements of the data, if larger than 1 bytes are shuffled (first bytes of all elements first, then the second ones...),
+		/// 0 means the size of the array elements when compressing Tensors and NumericArrays, and no shuffling when compressing a raw buffer
+		std::size_t elementSize = 0;
+		/// Number of bytes compressed by a single task, rounded down to a multiple of elementSize
+		std::size_t blockSize = std::size_t {1} << 20U;
+		/// Whether blocks are compressed and decompressed in parallel on Async::sharedPool()
+		bool parallel = true;
+	};
+
+	/**
+	 * @brief	Rearrange the bytes of \p count elements of \p elementSize bytes each, so that the k-th bytes of all elements are next to each other.
+	 * @details Numbers of similar magnitude usually share their leading bytes, so shuffled data compresses much better.
+	 */
+	void shuffle(const std::uint8_t* in, std::uint8_t* out, std::size_t count, std::size_t elementSize) noexcept;
+
+	/// Reverse shuffle
+	void unshuffle(const std::uint8_t* in, std::uint8_t* out, std::size_t count, std::size_t elementSize) noexcept;
+
+	/**
+	 * @brief	Compress a buffer in independent blocks
+	 * @param 	data - data to compress
+	 * @param 	bytes - size of the data
+	 * @param 	opts - codec, shuffle filter, block size and parallelism
+	 * @return	frame that can be decompressed with decompress, also on another machine with the same byte order
+	 * @throw 	ErrorName::UnknownCodec if the codec is not registered
+	 */
+	Frame compress(const void* data, std::size_t bytes, const Options& opts = {});
+
+	/**
+	 * @brief	Get the size of the data stored in a frame
+	 * @throw 	ErrorName::InvalidCompressedData if the frame header is invalid
+	 */
+	std::uint64_t decompressedSize(const std::uint8_t* frame, std::size_t frameSize);
+
+	/**
+	 * @brief	Decompress a frame
+	 * @param 	frame - compressed data
+	 * @param 	frameSize - size of the frame in bytes
+	 * @param 	out - output buffer
+	 * @param 	outSize - size of the output buffer, must be equal to decompressedSize(frame, frameSize)
+	 * @param 	parallel - whether to decompress blocks in parallel on Async::sharedPool()
+	 * @throw 	ErrorName::InvalidCompressedData if the frame is corrupted or its size does not match \p outSize
+	 * @throw 	ErrorName::UnknownCodec if the codec used to compress the frame is not registered
+	 */
+	void decompress(const std::uint8_t* frame, std::size_t frameSize, void* out, std::size_t outSize, bool parallel = true);
+
+	/// Head of the expression that carries a compressed array over WSTP
+	inline constexpr const char* compressedArrayHead = "LLU`CompressedArray";
+}  // namespace LLU::Compression
+
+namespace LLU::WS {
+
+	/**
+	 * @struct 	Compressed
+	 * @brief	Wrapper that makes WSStream send or receive a Tensor or a NumericArray in compressed form.
+	 *
+	 * The array is sent as LLU`CompressedArray[dims, type, bytes], where type is the MType or numericarray_data_t of the elements and bytes is
+	 * a list of UnsignedInteger8 with a Compression::Frame. Use it on links between two libraries, for example to reduce the amount of data sent between
+	 * kernels on different machines. Elements are shuffled before compression unless Options::elementSize is set explicitly, set it to 1 to disable shuffling.
+	 * @tparam 	Container - Tensor<T> or NumericArray<T>, possibly const when sending
+	 */
+	template<typename Container>
+	struct Compressed {
+		/// Array to be sent or received
+		Container& array;
+		/// Compression options, only used when sending
+		Compression::Options options;
+	};
+
+	/// Create a WS::Compressed wrapper, e.g. ms << WS::compressed(na) or ms >> WS::compressed(na)
+	template<typename Container>
+	Compressed<Container> compressed(Container& array, Compression::Options opts = {}) {
+		return {array, opts};
+	}
+
+	namespace Detail {
+		template<typename Container>
+		constexpr mint compressedElementType() {
+			using T = typename remove_cv_ref<Container>::value_type;
+			if constexpr (std::is_base_of_v<GenericTensor, remove_cv_ref<Container>>) {
+				return TensorType<T>;
+			} else {
+				return NumericArrayType<T>;
+			}
+		}
+	}  // namespace Detail
+}  // namespace LLU::WS
+
+namespace LLU {
+	/**
+	 * Sends a Tensor or NumericArray in compressed form, see WS::Compressed
+	 * @tparam 	EIn - WSStream input encoding
+	 * @tparam 	EOut - WSStream output encoding
+	 * @tparam 	Container - Tensor<T> or NumericArray<T>
+	 * @param 	ms - reference to the WSStream object
+	 * @param 	c - wrapper over the array
+	 * @return	reference to the stream
+	 */
+	template<WS::Encoding EIn, WS::Encoding EOut, typename Container>
+	WSStream<EIn, EOut>& operator<<(WSStream<EIn, EOut>& ms, const WS::Compressed<Container>& c) {
+		using T = typename remove_cv_ref<Container>::value_type;
+		auto opts = c.options;
+		if (opts.elementSize == 0) {
+			opts.elementSize = sizeof(T);
+		}
+		const auto* dims = c.array.getDimensions();
+		std::vector<mint> dimensions(dims, dims + c.array.getRank());
+		auto frame = Compression::compress(c.array.data(), static_cast<std::size_t>(c.array.size()) * sizeof(T), opts);
+		ms << WS::Function(Compression::compressedArrayHead, 3) << dimensions << WS::Detail::compressedElementType<Container>() << frame;
+		return ms;
+	}
+
+	/**
+	 * Receives a Tensor or NumericArray sent in compressed form, see WS::Compressed
+	 * @tparam 	EIn - WSStream input encoding
+	 * @tparam 	EOut - WSStream output encoding
+	 * @tparam 	Container - Tensor<T> or NumericArray<T>
+	 * @param 	ms - reference to the WSStream object
+	 * @param 	c - wrapper over the array that will receive the data
+	 * @return	reference to the stream
+	 * @throw 	ErrorName::InvalidCompressedData if the elements of the received array have a different type
+	 */
+	template<WS::Encoding EIn, WS::Encoding EOut, typename Container>
+	WSStream<EIn, EOut>& operator>>(WSStream<EIn, EOut>& ms, WS::Compressed<Container> c) {
+		std::vector<mint> dimensions;
+		mint type {};
+		Compression::Frame frame;
+		ms >> WS::Function(Compression::compressedArrayHead, 3) >> dimensions >> type >> frame;
+		if (type != WS::Detail::compressedElementType<Container>()) {
+			ErrorManager::throwException(ErrorName::InvalidCompressedData, "element type " + std::to_string(type) + " does not match");
+		}
+		Container result {Uninitialized, MArrayDimensions {dimensions}};
+		auto bytes = static_cast<std::size_t>(result.size()) * sizeof(typename Container::value_type);
+		Compression::decompress(frame.data(), frame.size(), result.data(), bytes, c.options.parallel);
+		c.array = std::move(result);
+		return ms;
+	}
+}  // namespace LLU
+
+#endif	  // LLU_COMPRESSION_H
@@ -0,0 +1,394 @@
+/**
+ * @file	ConcurrentManagedExpression.hpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Definition of the ConcurrentManagedExpressionStore class template, a thread-safe variant of ManagedExpressionStore
+ */
+#ifndef LLU_CONCURRENTMANAGEDEXPRESSION_HPP
+#define LLU_CONCURRENTMANAGEDEXPRESSION_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/InstancePool.h"
+#include "LLU/LibraryData.h"
+#include "LLU/ManagedExpression.hpp"
+
+/**
+ * @brief Use this macro to define an instance of ConcurrentManagedExpressionStore corresponding to your class
+ * and a template specialization of manageInstanceCallback for the managed class.
+ */
+#define DEFINE_CONCURRENT_MANAGED_STORE_AND_SPECIALIZATION(ClassName)                             \
+	LLU::ConcurrentManagedExpressionStore<ClassName> ClassName##Store;                            \
+                                                                                                  \
+	template<>                                                                                    \
+	inline void LLU::manageInstanceCallback<ClassName>(WolframLibraryData, mbool mode, mint id) { \
+		ClassName##Store.manageInstance(mode, id);                                                \
+	}
+
+namespace LLU {
+
+	/**
+	 * @brief   Thread-safe ManagedExpressionStore, in which instances can be looked up by ID from any thread, e.g. from tasks run in a ThreadPool.
+	 *
+	 * Instances are kept in an open-addressing hash table. Lookups (hasInstance, getInstance and getInstancePointer, and therefore
+	 * MArgumentManager::getManagedExpression) never take a lock and finish in a bounded number of steps. Modifications of the store are serialized
+	 * with a mutex. Entries removed from the table are freed only when no lookup is in progress, so a lookup running concurrently with a removal
+	 * never reads freed memory.
+	 *
+	 * As with ManagedExpressionStore, a reference obtained from getInstance is valid only until the instance is released. Tasks that may outlive
+	 * the Managed Expression should hold the pointer returned by getInstancePointer instead.
+	 *
+	 * @tparam T - managed class
+	 */
+	template<typename T>
+	class ConcurrentManagedExpressionStore : public ManagedExpressionStoreBase<ConcurrentManagedExpressionStore<T>, T> {
+		using Base = ManagedExpressionStoreBase<ConcurrentManagedExpressionStore<T>, T>;
+
+	public:
+		/// Size type of the Store
+		using size_type = std::size_t;
+
+	public:
+		ConcurrentManagedExpressionStore() : current(std::make_unique<Table>(minCapacity)), table(current.get()) {}
+
+		ConcurrentManagedExpressionStore(const ConcurrentManagedExpressionStore&) = delete;
+		ConcurrentManagedExpressionStore& operator=(const ConcurrentManagedExpressionStore&) = delete;
+		ConcurrentManagedExpressionStore(ConcurrentManagedExpressionStore&&) = delete;
+		ConcurrentManagedExpressionStore& operator=(ConcurrentManagedExpressionStore&&) = delete;
+
+		/// Free all entries, no other thread may access the store at this point
+		~ConcurrentManagedExpressionStore() {
+			for (auto& slot : current->slots) {
+				if (auto* e = slot.load(); e && e != &deleted) {
+					delete e;
+				}
+			}
+		}
+
+		/**
+		 * Function that will actually be called by LibraryLink when an instance of Managed Expression is created or deleted
+		 *
+		 * Notice that this function does not actually create a new object of class T. This is because there is no way to pass constructor arguments here.
+		 *
+		 * @param mode - are we deleting existing instance (True) or creating new one (False)
+		 * @param id - id of the instance of interest
+		 */
+		void manageInstance(mbool mode, mint id) {
+			Garbage garbage;
+			std::lock_guard<std::mutex> lock {writeMutex};
+			if (mode == False /* create new instance */) {
+				assign(id, nullptr, false);
+			} else {
+				remove(id);
+			}
+			garbage = collect();
+		}
+
+		/**
+		 * Create new object of class T that will be managed from Wolfram Language and place it in the store
+		 * @tparam  DynamicType - actual type of the constructed object, it allows Store to keep objects of subclasses of T
+		 * @tparam  Args - constructor arguments types
+		 * @param   id - id of the newly created managed object
+		 * @param   args - constructor arguments
+		 * @return  reference to the newly created object
+		 */
+		template<class DynamicType = T, typename... Args>
+		T& createInstance(mint id, Args&&... args) {
+			std::optional<InstancePool> instancePool;
+			{
+				// the object is constructed without holding the lock, from a copy of the pool taken under the lock
+				std::lock_guard<std::mutex> lock {writeMutex};
+				instancePool = this->instancePool();
+			}
+			return createInstance(id, Base::template makeInstanceIn<DynamicType>(instancePool, std::forward<Args>(args)...));
+		}
+
+		/**
+		 * Create instance in the store from a pointer to the managed class object.
+		 * @param   id - id of the newly created managed object
+		 * @param   ptr - pointer to an instance of T or a subclass
+		 * @return  reference to the object just added to the store
+		 */
+		T& createInstance(mint id, std::shared_ptr<T> ptr) {
+			if (!ptr) {
+				ErrorManager::throwException(ErrorName::MLENullInstance);
+			}
+			T& instance = *ptr;
+			Garbage garbage;
+			std::lock_guard<std::mutex> lock {writeMutex};
+			assign(id, std::move(ptr), true);	 // at this point instance must already exist in store
+			garbage = collect();
+			return instance;
+		}
+
+		/**
+		 * Create instance in the store from a unique pointer to the managed class object. The store will claim shared ownership of the managed object.
+		 * @param   id - id of the newly created managed object
+		 * @param   ptr - pointer to an instance of T or a subclass
+		 * @return  reference to the object just added to the store
+		 */
+		T& createInstance(mint id, std::unique_ptr<T> ptr) {
+			return createInstance(id, std::shared_ptr<T> {std::move(ptr)});
+		}
+
+		/**
+		 * Check if instance with given \p id is present in the store. This function does not block.
+		 * @param id - id to be checked
+		 * @return true iff the instance with given id is in the store
+		 */
+		[[nodiscard]] bool hasInstance(mint id) const {
+			ReadGuard guard {readers};
+			return find(id) != nullptr;
+		}
+
+		/**
+		 * Get managed instance with given \p id. Throw if the \p id is invalid or if there is no corresponding instance. This function does not block.
+		 * @param id - id of instance of interest
+		 * @return reference to the managed object
+		 */
+		T& getInstance(mint id) {
+			T* instance = nullptr;
+			{
+				ReadGuard guard {readers};
+				instance = checkedFind(id)->instance.get();
+			}
+			if (!instance) {
+				ErrorManager::throwException(ErrorName::MLENullInstance);
+			}
+			return *instance;
+		}
+
+		/**
+		 * Get a shared pointer to a managed instance with given \p id. Throw if the \p id is invalid. This function does not block.
+		 * @param id - id of instance of interest
+		 * @return shared pointer to the managed object
+		 */
+		std::shared_ptr<T> getInstancePointer(mint id) {
+			ReadGuard guard {readers};
+			return checkedFind(id)->instance;
+		}
+
+		/**
+		 * Get the number of currently managed expressions.
+		 * @return size of the store
+		 */
+		size_type size() const noexcept {
+			return count.load();
+		}
+
+		/**
+		 * Call \p f with the id and the pointer to every instance in the store, in unspecified order.
+		 * @note Modifications of the store are blocked while \p f runs, so \p f must not create or release instances. The same holds for snapshot(),
+		 * which uses forEach, so the objects from a snapshot can be processed e.g. with Async::parallelForEach while other threads modify the store.
+		 */
+		template<typename F>
+		void forEach(F&& f) const {
+			std::lock_guard<std::mutex> lock {writeMutex};
+			for (const auto& slot : current->slots) {
+				if (const auto* e = slot.load(); e && e != &deleted) {
+					f(e->id, e->instance);
+				}
+			}
+		}
+
+		/**
+		 * Allocate objects created with createInstance and createInstances from given pool instead of with std::make_shared.
+		 * Unlike other stores, the pool may be replaced while other threads create instances.
+		 * @param instancePool - pool of memory for objects of class T
+		 */
+		void setInstancePool(InstancePool instancePool) {
+			std::lock_guard<std::mutex> lock {writeMutex};
+			Base::setInstancePool(std::move(instancePool));
+		}
+
+	private:
+		/// Entries are immutable once published, assigning a new instance to an ID replaces the whole entry
+		struct Entry {
+			mint id;
+			std::shared_ptr<T> instance;
+		};
+
+		struct Table {
+			explicit Table(size_type capacity) : slots(capacity) {}
+
+			size_type mask() const noexcept {
+				return slots.size() - 1;
+			}
+
+			std::vector<std::atomic<Entry*>> slots;
+		};
+
+		/// Entries and tables removed from the store, which may still be read by lookups in progress
+		struct Garbage {
+			std::vector<std::unique_ptr<Entry>> entries;
+			std::vector<std::unique_ptr<Table>> tables;
+		};
+
+		/// Marks the beginning and the end of a lookup, so that writers know when it is safe to free removed entries
+		struct ReadGuard {
+			explicit ReadGuard(std::atomic<size_type>& r) noexcept : readers(r) {
+				readers.fetch_add(1);
+			}
+			ReadGuard(const ReadGuard&) = delete;
+			ReadGuard& operator=(const ReadGuard&) = delete;
+			ReadGuard(ReadGuard&&) = delete;
+			ReadGuard& operator=(ReadGuard&&) = delete;
+			~ReadGuard() {
+				readers.fetch_sub(1);
+			}
+
+			std::atomic<size_type>& readers;
+		};
+
+		/// Initial capacity of the table, must be a power of 2
+		static constexpr size_type minCapacity = 64;
+
+		/// IDs handed out by the kernel are mostly consecutive, so they are used as hashes directly and occupy consecutive slots
+		static size_type slotOf(mint id, size_type mask) noexcept {
+			return static_cast<size_type>(id) & mask;
+		}
+
+		/// Find the entry with given id or return nullptr, must be called within a ReadGuard or by a writer
+		const Entry* find(mint id) const noexcept {
+			const Table* t = table.load();
+			const auto mask = t->mask();
+			for (size_type i = slotOf(id, mask), probes = 0; probes <= mask; ++probes, i = (i + 1) & mask) {
+				const Entry* e = t->slots[i].load();
+				if (!e) {
+					return nullptr;
+				}
+				if (e != &deleted && e->id == id) {
+					return e;
+				}
+			}
+			return nullptr;
+		}
+
+		const Entry* checkedFind(mint id) const {
+			const auto* e = find(id);
+			if (!e) {
+				ErrorManager::throwException(ErrorName::ManagedExprInvalidID);
+			}
+			return e;
+		}
+
+		/// Insert or replace the entry for given id, the caller must hold the writeMutex
+		void assign(mint id, std::shared_ptr<T> instance, bool mustExist) {
+			auto& slots = current->slots;
+			const auto mask = current->mask();
+			std::atomic<Entry*>* freeSlot = nullptr;
+			for (size_type i = slotOf(id, mask), probes = 0; probes <= mask; ++probes, i = (i + 1) & mask) {
+				Entry* e = slots[i].load();
+				if (!e) {
+					break;
+				}
+				if (e == &deleted) {
+					freeSlot = freeSlot ? freeSlot : &slots[i];
+				} else if (e->id == id) {
+					slots[i].store(new Entry {id, std::move(instance)});
+					retired.entries.emplace_back(e);
+					return;
+				}
+			}
+			if (mustExist) {
+				ErrorManager::throwException(ErrorName::ManagedExprInvalidID);
+			}
+			if (freeSlot) {
+				--tombstones;
+			} else {
+				if (2 * (count.load() + tombstones + 1) > slots.size()) {
+					rehash();
+				}
+				freeSlot = &emptySlotFor(*current, id);
+			}
+			freeSlot->store(new Entry {id, std::move(instance)});
+			++count;
+		}
+
+		/// Remove the entry for given id if present, the caller must hold the writeMutex
+		void remove(mint id) {
+			auto& slots = current->slots;
+			const auto mask = current->mask();
+			for (size_type i = slotOf(id, mask), probes = 0; probes <= mask; ++probes, i = (i + 1) & mask) {
+				Entry* e = slots[i].load();
+				if (!e) {
+					return;
+				}
+				if (e != &deleted && e->id == id) {
+					slots[i].store(&deleted);
+					retired.entries.emplace_back(e);
+					--count;
+					++tombstones;
+					return;
+				}
+			}
+		}
+
+		static std::atomic<Entry*>& emptySlotFor(Table& t, mint id) noexcept {
+			auto i = slotOf(id, t.mask());
+			while (t.slots[i].load()) {
+				i = (i + 1) & t.mask();
+			}
+			return t.slots[i];
+		}
+
+		/// Move all entries to a new table with at most a quarter of slots occupied, lookups in progress keep reading the old table
+		void rehash() {
+			auto capacity = minCapacity;
+			while (capacity < 4 * (count.load() + 1)) {
+				capacity *= 2;
+			}
+			auto next = std::make_unique<Table>(capacity);
+			for (const auto& slot : current->slots) {
+				if (auto* e = slot.load(); e && e != &deleted) {
+					emptySlotFor(*next, e->id).store(e);
+				}
+			}
+			table.store(next.get());
+			retired.tables.push_back(std::exchange(current, std::move(next)));
+			tombstones = 0;
+		}
+
+		/// Hand over everything removed from the store if no lookup is in progress, so that it can be freed after the writeMutex is released
+		Garbage collect() noexcept {
+			if (readers.load() != 0) {
+				return {};
+			}
+			return std::exchange(retired, {});
+		}
+
+	private:
+		/// Table owned by the store, only accessed by writers
+		std::unique_ptr<Table> current;
+
+		/// Table read by lookups
+		std::atomic<Table*> table;
+
+		/// Number of lookups in progress
+		mutable std::atomic<size_type> readers {0};
+
+		/// Number of instances in the store
+		std::atomic<size_type> count {0};
+
+		/// Number of slots marked as deleted in the current table
+		size_type tombstones = 0;
+
+		/// Shared marker of deleted slots
+		Entry deleted {0, nullptr};
+
+		/// Entries and tables removed since the last time no lookup was in progress
+		Garbage retired;
+
+		/// Serializes modifications of the store and access to the instance pool
+		mutable std::mutex writeMutex;
+	};
+
+}	 // namespace LLU
+
+#endif	  // LLU_CONCURRENTMANAGEDEXPRESSION_HPP
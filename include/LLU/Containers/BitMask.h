@@ -0,0 +1,323 @@
+/**
+ * @file	BitMask.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Bit-packed binary masks, a scratch representation of "Bit" images that needs 8 times less memory than one byte per pixel.
+ */
+#ifndef LLU_CONTAINERS_BITMASK_H
+#define LLU_CONTAINERS_BITMASK_H
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/LibraryData.h"
+
+namespace LLU {
+
+	/**
+	 * @class   BitMask
+	 * @brief   Binary mask with rows of bits packed into 64-bit words.
+	 *
+	 * LibraryLink stores "Bit" images with one byte per pixel. Masks that are combined, counted, dilated or eroded many times are cheaper to
+	 * process in packed form, where a single word operation handles 64 pixels. Each row starts at a new word and the unused bits at the end
+	 * of every row are always 0. Masks are built from pixel data with pack() and written back with unpack(), see also Kernels::thresholdMask.
+	 */
+	class BitMask {
+	public:
+		/// Type of the words holding the bits
+		using word_type = std::uint64_t;
+
+		/// Number of bits in a word
+		static constexpr mint wordBits = std::numeric_limits<word_type>::digits;
+
+	public:
+		BitMask() = default;
+
+		/// Create a mask with all bits cleared
+		BitMask(mint rows, mint columns)
+			: rowCount(rows), columnCount(columns), rowWords((columns + wordBits - 1) / wordBits) {
+			if (rows < 0 || columns < 0) {
+				ErrorManager::throwException(ErrorName::DimensionsError);
+			}
+			bits.resize(static_cast<std::size_t>(rows * rowWords));
+		}
+
+		/**
+		 * @brief   Create a mask from pixel values
+		 * @param   in - pointer to the value of the first pixel
+		 * @param   rows - number of rows
+		 * @param   columns - number of columns
+		 * @param   rowStride - distance between values of the same column in consecutive rows
+		 * @param   columnStride - distance between values of neighboring pixels in a row
+		 * @param   isSet - predicate that decides whether the bit of a pixel with given value is set
+		 */
+		template<typename T, typename Predicate>
+		static BitMask pack(const T* in, mint rows, mint columns, mint rowStride, mint columnStride, Predicate&& isSet) {
+			BitMask m {rows, columns};
+			for (mint i = 0; i < rows; ++i) {
+				const T* row = in + i * rowStride;
+				word_type* out = m.row(i);
+				for (mint w = 0; w < m.rowWords; ++w) {
+					const mint first = w * wordBits;
+					const mint last = std::min(m.columnCount, first + wordBits);
+					word_type word = 0;
+					for (mint c = first; c < last; ++c) {
+						word |= static_cast<word_type>(isSet(row[c * columnStride]) ? 1 : 0) << (c - first);
+					}
+					out[w] = word;
+				}
+			}
+			return m;
+		}
+
+		/// Create a mask from pixel values, with bits set for non-zero values
+		template<typename T>
+		static BitMask pack(const T* in, mint rows, mint columns, mint rowStride, mint columnStride) {
+			return pack(in, rows, columns, rowStride, columnStride, [](T v) { return v != T {}; });
+		}
+
+		/**
+		 * @brief   Write the mask as pixel values
+		 * @param   out - pointer to the value of the first pixel
+		 * @param   rowStride - distance between values of the same column in consecutive rows
+		 * @param   columnStride - distance between values of neighboring pixels in a row
+		 * @param   one - value written for set bits, cleared bits are written as 0
+		 */
+		template<typename T>
+		void unpack(T* out, mint rowStride, mint columnStride, T one) const noexcept {
+			for (mint i = 0; i < rowCount; ++i) {
+				T* rowOut = out + i * rowStride;
+				const word_type* in = row(i);
+				for (mint c = 0; c < columnCount; ++c) {
+					rowOut[c * columnStride] = ((in[c / wordBits] >> (c % wordBits)) & 1U) ? one : T {};
+				}
+			}
+		}
+
+		/// Get the number of rows
+		mint rows() const noexcept {
+			return rowCount;
+		}
+
+		/// Get the number of columns
+		mint columns() const noexcept {
+			return columnCount;
+		}
+
+		/// Get the number of words in every row
+		mint wordsPerRow() const noexcept {
+			return rowWords;
+		}
+
+		/// Get the number of bytes used to store the bits
+		std::size_t sizeInBytes() const noexcept {
+			return bits.size() * sizeof(word_type);
+		}
+
+		/// Get the words of row \p i
+		word_type* row(mint i) noexcept {
+			return bits.data() + i * rowWords;
+		}
+
+		/// Get the words of row \p i
+		const word_type* row(mint i) const noexcept {
+			return bits.data() + i * rowWords;
+		}
+
+		/// Get the bit at given 0-based position, without bound checking
+		bool get(mint r, mint c) const noexcept {
+			return ((row(r)[c / wordBits] >> (c % wordBits)) & 1U) != 0;
+		}
+
+		/// Set the bit at given 0-based position, without bound checking
+		void set(mint r, mint c, bool value = true) noexcept {
+			const word_type bit = word_type {1} << (c % wordBits);
+			word_type& w = row(r)[c / wordBits];
+			w = value ? (w | bit) : (w & ~bit);
+		}
+
+		/// Count the set bits
+		mint count() const noexcept {
+			mint n = 0;
+			for (auto w : bits) {
+				n += static_cast<mint>(std::bitset<wordBits>(w).count());
+			}
+			return n;
+		}
+
+		/**
+		 * @brief   Bitwise AND with a mask of the same size
+		 * @throws  ErrorName::DimensionsError - if the sizes of the masks differ
+		 */
+		BitMask& operator&=(const BitMask& other) {
+			combine(other, [](word_type a, word_type b) { return a & b; });
+			return *this;
+		}
+
+		/**
+		 * @brief   Bitwise OR with a mask of the same size
+		 * @throws  ErrorName::DimensionsError - if the sizes of the masks differ
+		 */
+		BitMask& operator|=(const BitMask& other) {
+			combine(other, [](word_type a, word_type b) { return a | b; });
+			return *this;
+		}
+
+		/**
+		 * @brief   Bitwise XOR with a mask of the same size
+		 * @throws  ErrorName::DimensionsError - if the sizes of the masks differ
+		 */
+		BitMask& operator^=(const BitMask& other) {
+			combine(other, [](word_type a, word_type b) { return a ^ b; });
+			return *this;
+		}
+
+		/**
+		 * @brief   Clear all bits that are set in \p other
+		 * @throws  ErrorName::DimensionsError - if the sizes of the masks differ
+		 */
+		BitMask& subtract(const BitMask& other) {
+			combine(other, [](word_type a, word_type b) { return a & ~b; });
+			return *this;
+		}
+
+		/// Flip all bits
+		BitMask& invert() noexcept {
+			for (auto& w : bits) {
+				w = ~w;
+			}
+			clearPadding();
+			return *this;
+		}
+
+		/**
+		 * @brief   Dilate the mask with a square structuring element of (2 * radius + 1) x (2 * radius + 1) pixels
+		 * @details The window is clipped at the borders, i.e. pixels outside of the mask are treated as cleared. Each direction takes
+		 * about log2(radius) passes of shifts and ORs over whole words.
+		 */
+		BitMask dilate(mint radius) const {
+			BitMask res = *this;
+			if (radius <= 0) {
+				return res;
+			}
+			using Words = std::vector<word_type>;
+			res.bits = spread(bits, radius, [this](const Words& in, Words& out, mint k) { shiftColumns(in, out, k); });
+			res.clearPadding();
+			res.bits = spread(res.bits, radius, [this](const Words& in, Words& out, mint k) { shiftRows(in, out, k); });
+			return res;
+		}
+
+		/**
+		 * @brief   Erode the mask with a square structuring element of (2 * radius + 1) x (2 * radius + 1) pixels
+		 * @details The window is clipped at the borders, i.e. pixels outside of the mask do not clear bits near the borders.
+		 */
+		BitMask erode(mint radius) const {
+			BitMask complement = *this;
+			return complement.invert().dilate(radius).invert();
+		}
+
+		/// Compare sizes and bits of two masks
+		friend bool operator==(const BitMask& lhs, const BitMask& rhs) noexcept {
+			return lhs.rowCount == rhs.rowCount && lhs.columnCount == rhs.columnCount && lhs.bits == rhs.bits;
+		}
+
+		/// Compare sizes and bits of two masks
+		friend bool operator!=(const BitMask& lhs, const BitMask& rhs) noexcept {
+			return !(lhs == rhs);
+		}
+
+	private:
+		template<typename Op>
+		void combine(const BitMask& other, Op&& op) {
+			if (other.rowCount != rowCount || other.columnCount != columnCount) {
+				ErrorManager::throwException(ErrorName::DimensionsError);
+			}
+			for (std::size_t i = 0; i < bits.size(); ++i) {
+				bits[i] = op(bits[i], other.bits[i]);
+			}
+		}
+
+		/// Mask of the bits of the last word in a row that belong to the mask
+		word_type lastWordMask() const noexcept {
+			const auto used = columnCount % wordBits;
+			return used == 0 ? ~word_type {0} : (word_type {1} << used) - 1;
+		}
+
+		void clearPadding() noexcept {
+			if (rowWords == 0) {
+				return;
+			}
+			const auto keep = lastWordMask();
+			for (mint i = 0; i < rowCount; ++i) {
+				row(i)[rowWords - 1] &= keep;
+			}
+		}
+
+		/// out[r][c] = in[r][c + k] in every row, bits shifted in from outside of the row are 0
+		void shiftColumns(const std::vector<word_type>& in, std::vector<word_type>& out, mint k) const noexcept {
+			const mint q = (k >= 0 ? k : -k) / wordBits;
+			const mint s = (k >= 0 ? k : -k) % wordBits;
+			for (mint i = 0; i < rowCount; ++i) {
+				const word_type* src = in.data() + i * rowWords;
+				word_type* dst = out.data() + i * rowWords;
+				auto at = [src, this](mint w) { return (w >= 0 && w < rowWords) ? src[w] : word_type {0}; };
+				for (mint w = 0; w < rowWords; ++w) {
+					if (k >= 0) {
+						dst[w] = (at(w + q) >> s) | (s ? at(w + q + 1) << (wordBits - s) : word_type {0});
+					} else {
+						dst[w] = (at(w - q) << s) | (s ? at(w - q - 1) >> (wordBits - s) : word_type {0});
+					}
+				}
+			}
+		}
+
+		/// out[r] = in[r + k], rows shifted in from outside of the mask are 0
+		void shiftRows(const std::vector<word_type>& in, std::vector<word_type>& out, mint k) const noexcept {
+			for (mint i = 0; i < rowCount; ++i) {
+				const mint src = i + k;
+				if (src >= 0 && src < rowCount) {
+					std::copy_n(in.data() + src * rowWords, rowWords, out.data() + i * rowWords);
+				} else {
+					std::fill_n(out.data() + i * rowWords, rowWords, word_type {0});
+				}
+			}
+		}
+
+		/**
+		 * OR of shift(in, k) for all k in [-radius, radius]. Offsets are covered by doubling: after OR-ing a copy shifted by the number of
+		 * offsets covered so far, twice as many are covered.
+		 */
+		template<typename Shift>
+		static std::vector<word_type> spread(const std::vector<word_type>& in, mint radius, Shift&& shift) {
+			std::vector<word_type> result(in.size());
+			std::vector<word_type> acc;
+			std::vector<word_type> tmp(in.size());
+			for (mint sign : {1, -1}) {
+				acc = in;
+				for (mint covered = 1; covered < radius + 1;) {
+					const mint step = std::min(covered, radius + 1 - covered);
+					shift(acc, tmp, sign * step);
+					for (std::size_t i = 0; i < acc.size(); ++i) {
+						acc[i] |= tmp[i];
+					}
+					covered += step;
+				}
+				for (std::size_t i = 0; i < acc.size(); ++i) {
+					result[i] |= acc[i];
+				}
+			}
+			return result;
+		}
+
+		mint rowCount = 0;
+		mint columnCount = 0;
+		mint rowWords = 0;
+		std::vector<word_type> bits;
+	};
+
+}  // namespace LLU
+
+#endif	  // LLU_CONTAINERS_BITMASK_H
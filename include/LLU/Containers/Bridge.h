@@ -0,0 +1,122 @@
+/**
+ * @file	Bridge.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Direct conversions between Tensors, NumericArrays and Images that allocate the result once and copy the data in a single pass.
+ */
+#ifndef LLU_CONTAINERS_BRIDGE_H
+#define LLU_CONTAINERS_BRIDGE_H
+
+#include <algorithm>
+#include <type_traits>
+
+#include "LLU/Containers/Conversion.hpp"
+#include "LLU/Containers/Image.h"
+#include "LLU/Containers/MArray.hpp"
+#include "LLU/Containers/NumericArray.h"
+#include "LLU/Containers/Tensor.h"
+#include "LLU/ErrorLog/ErrorManager.h"
+
+namespace LLU {
+
+	namespace Detail {
+		/// Copy \p n elements, converting them to U with NA::convertRange unless the types are the same
+		template<typename U, typename T>
+		void bridgeData(const T* in, U* out, mint n, NA::ConversionMethod method, double tolerance) {
+			if constexpr (std::is_same_v<U, T>) {
+				std::copy_n(in, n, out);
+			} else {
+				NA::convertRange(in, out, n, method, tolerance);
+			}
+		}
+
+		/// Create an uninitialized Image<U> that holds the data of an array with given dimensions, see toImage
+		template<typename U>
+		Image<U> imageForDimensions(const MArrayDimensions& dims, bool image3D, colorspace_t colorSpace) {
+			const auto rank = dims.rank();
+			const mint spatialRank = image3D ? 3 : 2;
+			if (rank != spatialRank && rank != spatialRank + 1) {
+				ErrorManager::throwException(ErrorName::DimensionsError);
+			}
+			const mint channels = rank == spatialRank ? 1 : dims.get(spatialRank);
+			const mint rows = dims.get(spatialRank - 2);
+			const mint columns = dims.get(spatialRank - 1);
+			if (image3D) {
+				return Image<U> {Uninitialized, dims.get(0), columns, rows, channels, colorSpace, true};
+			}
+			return Image<U> {Uninitialized, columns, rows, channels, colorSpace, true};
+		}
+	}  // namespace Detail
+
+	/**
+	 * @brief   Copy the data of a Tensor, a NumericArray or an Image to a new NumericArray with the same dimensions
+	 * @details The result is allocated once and filled in a single pass. Data of the same type is copied as a block, other types are converted
+	 * with NA::convertRange, which runs vectorizable loops for the common conversions instead of calling MNumericArray_convertType.
+	 * Images keep their memory layout, i.e. the result has dimensions {rows, columns, channels} for interleaved images and
+	 * {channels, rows, columns} otherwise, with the channel dimension omitted for single-channel images.
+	 * @tparam  U - element type of the result
+	 * @tparam  T - element type of the source
+	 * @param   source - Tensor, NumericArray or Image
+	 * @param   method - conversion method used when U differs from T
+	 * @param   tolerance - tolerance used by the Check method
+	 * @return  new NumericArray owned by the library
+	 * @throws  ErrorName::NumericArrayConversionError - if some element cannot be converted to U with given method
+	 */
+	template<typename U, typename T>
+	NumericArray<U> toNumericArray(const MArray<T>& source, NA::ConversionMethod method = NA::ConversionMethod::ClipRound, double tolerance = 0.0) {
+		NumericArray<U> result {Uninitialized, source.dimensions()};
+		Detail::bridgeData(source.data(), result.data(), source.size(), method, tolerance);
+		return result;
+	}
+
+	/**
+	 * @brief   Copy the data of a Tensor, a NumericArray or an Image to a new Tensor with the same dimensions
+	 * @tparam  U - element type of the result, one of mint, double and std::complex<double>
+	 * @tparam  T - element type of the source
+	 * @param   source - Tensor, NumericArray or Image
+	 * @param   method - conversion method used when U differs from T
+	 * @param   tolerance - tolerance used by the Check method
+	 * @return  new Tensor owned by the library
+	 * @throws  ErrorName::NumericArrayConversionError - if some element cannot be converted to U with given method
+	 * @see     toNumericArray
+	 */
+	template<typename U, typename T>
+	Tensor<U> toTensor(const MArray<T>& source, NA::ConversionMethod method = NA::ConversionMethod::ClipRound, double tolerance = 0.0) {
+		Tensor<U> result {Uninitialized, source.dimensions()};
+		Detail::bridgeData(source.data(), result.data(), source.size(), method, tolerance);
+		return result;
+	}
+
+	/**
+	 * @brief   Copy the data of a Tensor or a NumericArray to a new interleaved 2D Image
+	 * @details Dimensions of the source are interpreted the same way as by Image in the Wolfram Language: {rows, columns} for single-channel
+	 * images and {rows, columns, channels} otherwise. Use NA::ConversionMethod::Scale to map real values in [0, 1] onto the range of integer types.
+	 * @tparam  U - element type of the Image
+	 * @tparam  T - element type of the source
+	 * @param   source - Tensor or NumericArray of rank 2 or 3
+	 * @param   colorSpace - color space of the Image
+	 * @param   method - conversion method used when U differs from T
+	 * @return  new Image owned by the library
+	 * @throws  ErrorName::DimensionsError - if the rank of the source is not 2 or 3
+	 * @throws  ErrorName::NumericArrayConversionError - if some element cannot be converted to U with given method
+	 */
+	template<typename U, typename T>
+	Image<U> toImage(const MArray<T>& source, colorspace_t colorSpace = MImage_CS_Automatic, NA::ConversionMethod method = NA::ConversionMethod::ClipRound) {
+		auto result = Detail::imageForDimensions<U>(source.dimensions(), false, colorSpace);
+		Detail::bridgeData(source.data(), result.data(), source.size(), method, 0.0);
+		return result;
+	}
+
+	/**
+	 * @brief   Copy the data of a Tensor or a NumericArray of dimensions {slices, rows, columns} or {slices, rows, columns, channels}
+	 * to a new interleaved 3D Image
+	 * @see     toImage
+	 */
+	template<typename U, typename T>
+	Image<U> toImage3D(const MArray<T>& source, colorspace_t colorSpace = MImage_CS_Automatic, NA::ConversionMethod method = NA::ConversionMethod::ClipRound) {
+		auto result = Detail::imageForDimensions<U>(source.dimensions(), true, colorSpace);
+		Detail::bridgeData(source.data(), result.data(), source.size(), method, 0.0);
+		return result;
+	}
+}  // namespace LLU
+
+#endif	  // LLU_CONTAINERS_BRIDGE_H
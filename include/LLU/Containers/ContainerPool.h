@@ -0,0 +1,229 @@
+/**
+ * @file	ContainerPool.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Opt-in pool of library-owned MTensors and MNumericArrays that can be reused across library function calls.
+ */
+#ifndef LLU_CONTAINERS_CONTAINERPOOL_H
+#define LLU_CONTAINERS_CONTAINERPOOL_H
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "LLU/Containers/NumericArray.h"
+#include "LLU/Containers/Tensor.h"
+
+namespace LLU {
+
+	class ContainerPool;
+
+	/**
+	 * @class   Pooled
+	 * @brief   Container leased from a ContainerPool, which goes back to the pool when the lease ends.
+	 *
+	 * A leased container is recycled only if the library still owns it when the lease is destroyed. In particular, a container passed to
+	 * MArgumentManager::set becomes owned by LibraryLink and is simply forgotten by the pool.
+	 *
+	 * @tparam  Wrapper - Tensor<T> or NumericArray<T>
+	 */
+	template<class Wrapper>
+	class Pooled {
+	public:
+		/**
+		 * @brief   Create a lease
+		 * @param   pool - pool to return the container to
+		 * @param   container - leased container
+		 */
+		Pooled(ContainerPool& pool, Wrapper container) : pool(&pool), container(std::move(container)) {}
+
+		Pooled(const Pooled&) = delete;
+		Pooled& operator=(const Pooled&) = delete;
+
+		Pooled(Pooled&& other) noexcept : pool(std::exchange(other.pool, nullptr)), container(std::move(other.container)) {}
+
+		Pooled& operator=(Pooled&& other) noexcept {
+			if (this != &other) {
+				giveBack();
+				pool = std::exchange(other.pool, nullptr);
+				container = std::move(other.container);
+			}
+			return *this;
+		}
+
+		/// Return the container to the pool, unless it has been passed to LibraryLink in the meantime
+		~Pooled() {
+			giveBack();
+		}
+
+		/// Access the container
+		Wrapper& operator*() noexcept {
+			return container;
+		}
+
+		/// Access the container
+		const Wrapper& operator*() const noexcept {
+			return container;
+		}
+
+		/// Access the container
+		Wrapper* operator->() noexcept {
+			return &container;
+		}
+
+		/// Access the container
+		const Wrapper* operator->() const noexcept {
+			return &container;
+		}
+
+		/// End the lease without returning the container to the pool
+		Wrapper release() noexcept {
+			pool = nullptr;
+			return std::move(container);
+		}
+
+	private:
+		void giveBack() noexcept;
+
+		ContainerPool* pool;
+		Wrapper container;
+	};
+
+	/**
+	 * @class   ContainerPool
+	 * @brief   Keeps library-owned MTensors and MNumericArrays of recently used shapes, so that they can be reused instead of allocated again.
+	 *
+	 * Containers are grouped by data type and dimensions. A reused container is not zero-filled, it keeps the contents from its previous
+	 * use unless an initial value is requested. The pool is thread-safe.
+	 *
+	 * Only containers owned by the library can be recycled. Once a container is handed to LibraryLink, e.g. returned as the result of a
+	 * library function, LibraryLink owns it and never gives it back, so the pool is useful for intermediate results and for output
+	 * buffers which are copied or shared rather than returned. Pools must be cleared before the library is unloaded, e.g. in
+	 * WolframLibrary_uninitialize.
+	 */
+	class ContainerPool {
+	public:
+		/// Default maximal number of idle containers of the same type and dimensions
+		static constexpr std::size_t defaultMaxPerShape = 4;
+
+		/**
+		 * @brief   Create an empty pool
+		 * @param   maxPerShape - maximal number of idle containers of the same type and dimensions kept by the pool
+		 */
+		explicit ContainerPool(std::size_t maxPerShape = defaultMaxPerShape) : maxPerShape(maxPerShape) {}
+
+		ContainerPool(const ContainerPool&) = delete;
+		ContainerPool& operator=(const ContainerPool&) = delete;
+		ContainerPool(ContainerPool&&) = delete;
+		ContainerPool& operator=(ContainerPool&&) = delete;
+
+		/// Free all idle containers
+		~ContainerPool() {
+			clear();
+		}
+
+		/**
+		 * @brief   Get a Tensor of given dimensions, reused from the pool if possible, with unspecified contents
+		 * @param   dims - dimensions of the Tensor
+		 */
+		template<typename T>
+		Pooled<Tensor<T>> tensor(const MArrayDimensions& dims) {
+			if (auto t = take(tensors, {TensorType<T>, dimensionsOf(dims)})) {
+				return {*this, Tensor<T> {t, Ownership::Library}};
+			}
+			return {*this, Tensor<T> {GenericTensor {TensorType<T>, dims.rank(), dims.data()}}};
+		}
+
+		/**
+		 * @brief   Get a Tensor of given dimensions with all elements equal to \p init, reused from the pool if possible
+		 * @param   init - value of all elements
+		 * @param   dims - dimensions of the Tensor
+		 */
+		template<typename T>
+		Pooled<Tensor<T>> tensor(T init, const MArrayDimensions& dims) {
+			auto result = tensor<T>(dims);
+			std::fill(result->begin(), result->end(), init);
+			return result;
+		}
+
+		/**
+		 * @brief   Get a NumericArray of given dimensions, reused from the pool if possible, with unspecified contents
+		 * @param   dims - dimensions of the NumericArray
+		 */
+		template<typename T>
+		Pooled<NumericArray<T>> numericArray(const MArrayDimensions& dims) {
+			if (auto na = take(numericArrays, {static_cast<mint>(NumericArrayType<T>), dimensionsOf(dims)})) {
+				return {*this, NumericArray<T> {na, Ownership::Library}};
+			}
+			return {*this, NumericArray<T> {GenericNumericArray {NumericArrayType<T>, dims.rank(), dims.data()}}};
+		}
+
+		/**
+		 * @brief   Get a NumericArray of given dimensions with all elements equal to \p init, reused from the pool if possible
+		 * @param   init - value of all elements
+		 * @param   dims - dimensions of the NumericArray
+		 */
+		template<typename T>
+		Pooled<NumericArray<T>> numericArray(T init, const MArrayDimensions& dims) {
+			auto result = numericArray<T>(dims);
+			std::fill(result->begin(), result->end(), init);
+			return result;
+		}
+
+		/**
+		 * @brief   Give a Tensor to the pool
+		 * @details The container is taken over only if it is owned by the library and there is room for another container of its shape.
+		 * Otherwise \p t is left untouched and frees its container as usual.
+		 */
+		void recycle(GenericTensor& t) noexcept;
+
+		/// @copydoc recycle(GenericTensor&)
+		void recycle(GenericNumericArray& na) noexcept;
+
+		/// Get the number of idle containers in the pool
+		std::size_t size() const;
+
+		/// Free all idle containers
+		void clear() noexcept;
+
+	private:
+		/// Containers are grouped by data type and dimensions
+		using Key = std::pair<mint, std::vector<mint>>;
+
+		template<class Container>
+		using Buckets = std::map<Key, std::vector<Container>>;
+
+		static std::vector<mint> dimensionsOf(const MArrayDimensions& dims) {
+			return {dims.data(), dims.data() + dims.rank()};
+		}
+
+		template<class Container>
+		Container take(Buckets<Container>& buckets, const Key& key) {
+			std::lock_guard<std::mutex> lock {poolMutex};
+			auto it = buckets.find(key);
+			if (it == buckets.end() || it->second.empty()) {
+				return nullptr;
+			}
+			auto c = it->second.back();
+			it->second.pop_back();
+			return c;
+		}
+
+		std::size_t maxPerShape;
+		Buckets<MTensor> tensors;
+		Buckets<MNumericArray> numericArrays;
+		mutable std::mutex poolMutex;
+	};
+
+	template<class Wrapper>
+	void Pooled<Wrapper>::giveBack() noexcept {
+		if (pool) {
+			pool->recycle(container);
+			pool = nullptr;
+		}
+	}
+
+}  // namespace LLU
+
+#endif	  // LLU_CONTAINERS_CONTAINERPOOL_H
@@ -0,0 +1,330 @@
+/**
+ * @file	Conversion.hpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Element-wise conversion between NumericArray data types, following the semantics of NA::ConversionMethod.
+ */
+#ifndef LLU_CONTAINERS_CONVERSION_HPP
+#define LLU_CONTAINERS_CONVERSION_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/Utilities.hpp"
+
+namespace LLU::NA {
+
+	namespace Detail {
+		template<typename T>
+		struct IsComplex : std::false_type {};
+
+		template<typename T>
+		struct IsComplex<std::complex<T>> : std::true_type {};
+
+		/// Check if T is a specialization of std::complex
+		template<typename T>
+		inline constexpr bool is_complex_v = IsComplex<T>::value;
+
+		/// The part of a ConversionMethod that says what to do with values that are not exactly representable in the target type
+		enum class Base { Check, Coerce, Round, Scale };
+
+		constexpr Base base(ConversionMethod method) noexcept {
+			switch (method) {
+				case ConversionMethod::Coerce:
+				case ConversionMethod::ClipCoerce: return Base::Coerce;
+				case ConversionMethod::Round:
+				case ConversionMethod::ClipRound: return Base::Round;
+				case ConversionMethod::Scale:
+				case ConversionMethod::ClipScale: return Base::Scale;
+				default: return Base::Check;
+			}
+		}
+
+		/// Check if out-of-range values should be clipped to the range of the target type
+		constexpr bool clips(ConversionMethod method) noexcept {
+			return method == ConversionMethod::ClipCheck || method == ConversionMethod::ClipCoerce || method == ConversionMethod::ClipRound ||
+				   method == ConversionMethod::ClipScale;
+		}
+
+		[[noreturn]] inline void conversionError() {
+			ErrorManager::throwException(ErrorName::NumericArrayConversionError);
+		}
+
+		/// 2^(number of value bits of U), the smallest double greater than every value of the integral type U
+		template<typename U>
+		constexpr double upperBound() noexcept {
+			double res = 1.0;
+			for (int i = 0; i < std::numeric_limits<U>::digits; ++i) {
+				res *= 2.0;
+			}
+			return res;
+		}
+
+		template<typename U, typename T>
+		U integerToInteger(T x, Base b, bool clip) {
+			constexpr auto lo = std::numeric_limits<U>::lowest();
+			constexpr auto hi = std::numeric_limits<U>::max();
+			const bool below = std::is_signed_v<T> && x < 0 && (!std::is_signed_v<U> || static_cast<std::intmax_t>(x) < static_cast<std::intmax_t>(lo));
+			const bool above = x > 0 && static_cast<std::uintmax_t>(x) > static_cast<std::uintmax_t>(hi);
+			if (!below && !above) {
+				return static_cast<U>(x);
+			}
+			if (clip) {
+				return below ? lo : hi;
+			}
+			if (b == Base::Coerce) {
+				// modular arithmetic, like the conversions of the C++ language
+				return static_cast<U>(x);
+			}
+			conversionError();
+		}
+
+		template<typename U>
+		U realToInteger(double x, Base b, bool clip, double tolerance) {
+			constexpr double lo = std::is_signed_v<U> ? -upperBound<U>() : 0.0;
+			constexpr double hi = upperBound<U>();
+			if (std::isnan(x)) {
+				if (b == Base::Coerce) {
+					return U {0};
+				}
+				conversionError();
+			}
+			if (b == Base::Scale) {
+				// [0, 1] for unsigned and [-1, 1] for signed types are mapped onto the whole range of U
+				constexpr double scaleLo = std::is_signed_v<U> ? -1.0 : 0.0;
+				if (x < scaleLo || x > 1.0) {
+					if (!clip) {
+						conversionError();
+					}
+					x = x < scaleLo ? scaleLo : 1.0;
+				}
+				const double r = std::nearbyint(x * static_cast<double>(std::numeric_limits<U>::max()));
+				if (r >= hi) {
+					return std::numeric_limits<U>::max();
+				}
+				return r <= -hi ? -std::numeric_limits<U>::max() : static_cast<U>(r);
+			}
+			// Check and Round pick the nearest integer, Coerce truncates
+			double r = (b == Base::Coerce) ? std::trunc(x) : std::nearbyint(x);
+			if (b == Base::Check && std::abs(x - r) > tolerance) {
+				conversionError();
+			}
+			if (r >= lo && r < hi) {
+				return static_cast<U>(r);
+			}
+			if (clip) {
+				return r < lo ? std::numeric_limits<U>::lowest() : std::numeric_limits<U>::max();
+			}
+			if (b == Base::Coerce && std::isfinite(r)) {
+				// wrap around modulo 2^bits, where bits is the width of U
+				constexpr double modulus = std::is_signed_v<U> ? 2.0 * hi : hi;
+				r = std::fmod(r, modulus);
+				if (r < 0) {
+					r += modulus;
+				}
+				return static_cast<U>(static_cast<std::uint64_t>(r));
+			}
+			conversionError();
+		}
+
+		template<typename U, typename T>
+		U integerToReal(T x, Base b) noexcept {
+			if (b == Base::Scale) {
+				// the whole range of T is mapped onto [0, 1] for unsigned and [-1, 1] for signed types
+				return static_cast<U>(static_cast<double>(x) / static_cast<double>(std::numeric_limits<T>::max()));
+			}
+			return static_cast<U>(x);
+		}
+
+		template<typename U, typename T>
+		U realToReal(T x, Base b, bool clip) {
+			// the limits are compared in the wider of the two types, when U can hold every value of T there is nothing to clip
+			using Wide = std::common_type_t<T, U>;
+			constexpr auto hi = static_cast<Wide>(std::numeric_limits<U>::max());
+			if constexpr (hi >= static_cast<Wide>(std::numeric_limits<T>::max())) {
+				return static_cast<U>(x);
+			}
+			if (!std::isfinite(x) || (x <= hi && x >= -hi)) {
+				return static_cast<U>(x);
+			}
+			if (clip) {
+				return x > 0 ? std::numeric_limits<U>::max() : std::numeric_limits<U>::lowest();
+			}
+			if (b == Base::Coerce) {
+				return x > 0 ? std::numeric_limits<U>::infinity() : -std::numeric_limits<U>::infinity();
+			}
+			conversionError();
+		}
+
+		/// Convert \p n elements with a method fixed at compile time, so that checks that do not apply to the method are folded away
+		template<ConversionMethod M, typename U, typename T>
+		void convertEach(const T* in, U* out, mint n, double tolerance);
+
+		/// Conversions from T to U, which are a plain cast for every method except Scale
+		template<typename U, typename T>
+		inline constexpr bool is_plain_cast_v = std::is_same_v<U, T> || (std::is_arithmetic_v<T> && std::is_floating_point_v<U> &&
+																		   (std::is_integral_v<T> || sizeof(U) >= sizeof(T)));
+
+		/// Conversions from reals to integers narrow enough for their whole range to be represented exactly in double
+		template<typename U, typename T>
+		inline constexpr bool is_exact_clip_v =
+			std::is_floating_point_v<T> && std::is_integral_v<U> && (std::numeric_limits<U>::digits <= std::numeric_limits<double>::digits);
+	}  // namespace Detail
+
+	/**
+	 * @brief   Convert a single value to a different NumericArray data type.
+	 *
+	 * The result is the same as what MNumericArray_convertType would produce for a single-element NumericArray:
+	 *  - values exactly representable in U are converted exactly, with every method,
+	 *  - Clip* methods replace out-of-range values with the closest value of U, other methods throw, except for Coerce,
+	 *  - Coerce truncates reals to integers and wraps out-of-range integers around modulo 2^bits, it never throws,
+	 *  - Check accepts reals that are within \p tolerance from an integer and Round rounds reals to the nearest integer (ties to even),
+	 *  - Scale maps [0, 1] (or [-1, 1] for signed types) onto the whole range of an integer type and vice versa,
+	 *  - complex values can be converted to real types only with Coerce, or when the imaginary part is within \p tolerance from 0.
+	 *
+	 * @tparam  U - target type
+	 * @tparam  T - source type
+	 * @param   value - value to be converted
+	 * @param   method - conversion method
+	 * @param   tolerance - tolerance used by the Check method
+	 * @return  \p value converted to U
+	 * @throws  ErrorName::NumericArrayConversionError - if \p value cannot be converted to U with given method
+	 */
+	template<typename U, typename T>
+	U convertValue(T value, ConversionMethod method, double tolerance = 0.0) {
+		if constexpr (std::is_same_v<U, T>) {
+			return value;
+		} else if constexpr (Detail::is_complex_v<U>) {
+			using R = typename U::value_type;
+			if constexpr (Detail::is_complex_v<T>) {
+				return U {convertValue<R>(value.real(), method, tolerance), convertValue<R>(value.imag(), method, tolerance)};
+			} else {
+				return U {convertValue<R>(value, method, tolerance), R {0}};
+			}
+		} else if constexpr (Detail::is_complex_v<T>) {
+			if (Detail::base(method) != Detail::Base::Coerce && std::abs(value.imag()) > tolerance) {
+				Detail::conversionError();
+			}
+			return convertValue<U>(value.real(), method, tolerance);
+		} else if constexpr (std::is_integral_v<U>) {
+			if constexpr (std::is_integral_v<T>) {
+				return Detail::integerToInteger<U>(value, Detail::base(method), Detail::clips(method));
+			} else {
+				return Detail::realToInteger<U>(static_cast<double>(value), Detail::base(method), Detail::clips(method), tolerance);
+			}
+		} else {
+			if constexpr (std::is_integral_v<T>) {
+				return Detail::integerToReal<U>(value, Detail::base(method));
+			} else {
+				return Detail::realToReal<U>(value, Detail::base(method), Detail::clips(method));
+			}
+		}
+	}
+
+	/**
+	 * @brief   Check if converting from T to U with given method can fail for some values
+	 * @tparam  U - target type
+	 * @tparam  T - source type
+	 * @param   method - conversion method
+	 */
+	template<typename U, typename T>
+	constexpr bool conversionMayFail(ConversionMethod method) noexcept {
+		if constexpr (std::is_same_v<U, T>) {
+			return false;
+		} else {
+			const auto b = Detail::base(method);
+			if (b == Detail::Base::Coerce) {
+				return false;
+			}
+			if constexpr (Detail::is_complex_v<T> && !Detail::is_complex_v<U>) {
+				return true;
+			} else if constexpr (std::is_integral_v<U> && !std::is_integral_v<T>) {
+				// NaN cannot be clipped, and Check can be violated by non-integer values
+				return true;
+			} else if constexpr (std::is_integral_v<T> && !std::is_integral_v<U>) {
+				return false;
+			} else {
+				return !Detail::clips(method);
+			}
+		}
+	}
+
+	/**
+	 * @brief   Convert a contiguous range of values to a different type.
+	 *
+	 * This is the sequential kernel used by the LLU-native NumericArray conversion. The conversion method is dispatched once per range
+	 * and the common cases (casts to wider real types and clipping conversions from reals to narrow integers) run in branch-free loops
+	 * that the compiler can vectorize. The result is the same as calling convertValue on every element.
+	 *
+	 * @param   in - pointer to the first of \p n values to be converted
+	 * @param   out - pointer to a buffer of at least \p n elements for the results, must not overlap with the input
+	 * @param   n - number of values
+	 * @param   method - conversion method
+	 * @param   tolerance - tolerance used by the Check method
+	 * @throws  ErrorName::NumericArrayConversionError - if any value cannot be converted to U, some results may be already written
+	 */
+	template<typename U, typename T>
+	void convertRange(const T* in, U* out, mint n, ConversionMethod method, double tolerance = 0.0) {
+		if constexpr (Detail::is_plain_cast_v<U, T>) {
+			if (Detail::base(method) != Detail::Base::Scale || std::is_same_v<U, T>) {
+				for (mint i = 0; i < n; ++i) {
+					out[i] = static_cast<U>(in[i]);
+				}
+				return;
+			}
+		}
+		if constexpr (Detail::is_exact_clip_v<U, T>) {
+			if (method == ConversionMethod::ClipRound || method == ConversionMethod::ClipCoerce) {
+				constexpr auto lo = static_cast<double>(std::numeric_limits<U>::lowest());
+				constexpr auto hi = static_cast<double>(std::numeric_limits<U>::max());
+				if (method == ConversionMethod::ClipRound) {
+					// like convertValue, ClipRound rejects NaN
+					bool hasNaN = false;
+					for (mint i = 0; i < n; ++i) {
+						hasNaN |= (in[i] != in[i]);
+					}
+					if (hasNaN) {
+						Detail::conversionError();
+					}
+					for (mint i = 0; i < n; ++i) {
+						out[i] = static_cast<U>(std::nearbyint(std::min(std::max(static_cast<double>(in[i]), lo), hi)));
+					}
+				} else {
+					// ClipCoerce maps NaN to 0, like convertValue
+					for (mint i = 0; i < n; ++i) {
+						const auto x = static_cast<double>(in[i]);
+						out[i] = static_cast<U>((x != x) ? 0.0 : std::min(std::max(x, lo), hi));
+					}
+				}
+				return;
+			}
+		}
+		switch (method) {
+			case ConversionMethod::Check: Detail::convertEach<ConversionMethod::Check>(in, out, n, tolerance); break;
+			case ConversionMethod::ClipCheck: Detail::convertEach<ConversionMethod::ClipCheck>(in, out, n, tolerance); break;
+			case ConversionMethod::Coerce: Detail::convertEach<ConversionMethod::Coerce>(in, out, n, tolerance); break;
+			case ConversionMethod::ClipCoerce: Detail::convertEach<ConversionMethod::ClipCoerce>(in, out, n, tolerance); break;
+			case ConversionMethod::Round: Detail::convertEach<ConversionMethod::Round>(in, out, n, tolerance); break;
+			case ConversionMethod::ClipRound: Detail::convertEach<ConversionMethod::ClipRound>(in, out, n, tolerance); break;
+			case ConversionMethod::Scale: Detail::convertEach<ConversionMethod::Scale>(in, out, n, tolerance); break;
+			case ConversionMethod::ClipScale: Detail::convertEach<ConversionMethod::ClipScale>(in, out, n, tolerance); break;
+			default: Detail::conversionError();
+		}
+	}
+
+	/// @cond
+	template<ConversionMethod M, typename U, typename T>
+	void Detail::convertEach(const T* in, U* out, mint n, double tolerance) {
+		for (mint i = 0; i < n; ++i) {
+			out[i] = convertValue<U>(in[i], M, tolerance);
+		}
+	}
+	/// @endcond
+
+}  // namespace LLU::NA
+
+#endif	  // LLU_CONTAINERS_CONVERSION_HPP
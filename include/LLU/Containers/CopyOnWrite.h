@@ -0,0 +1,153 @@
+/**
+ * @file	CopyOnWrite.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Lazy clone of a container, which shares the data of the original until it is first modified.
+ */
+#ifndef LLU_CONTAINERS_COPYONWRITE_H
+#define LLU_CONTAINERS_COPYONWRITE_H
+
+#include <type_traits>
+#include <utility>
+
+#include "LLU/Containers/Generic/Base.hpp"
+
+namespace LLU {
+
+	/**
+	 * @class   CopyOnWrite
+	 * @brief   Clone of a container that makes the deep copy only when the clone is accessed for writing.
+	 *
+	 * Reading through CopyOnWrite (const member functions, get()) uses the data of the original container. The first mutable access
+	 * (non-const data(), begin(), end(), operator[] or mutate()) replaces the shared data with a deep copy owned by the library, so the original
+	 * is never modified. Functions that clone defensively and then only read the copy thus never pay for it.
+	 *
+	 * A CopyOnWrite created from an lvalue must not outlive the original, which must not be modified while the data is shared.
+	 * A CopyOnWrite created from an rvalue takes the container over and copies it only if someone else may still see the data, i.e. if the library
+	 * does not own it or if it is shared with the Wolfram Language.
+	 *
+	 * @tparam  Container - any container wrapper, e.g. Tensor<T>, NumericArray<T>, GenericTensor or GenericNumericArray; element access is only
+	 * available for typed containers
+	 */
+	template<class Container>
+	class CopyOnWrite {
+	public:
+		/**
+		 * @brief   Create a lazy clone of \p source
+		 * @param   source - container to share the data with; it must stay alive and unmodified as long as the data is shared
+		 */
+		explicit CopyOnWrite(const Container& source) : value {source.getContainer(), Ownership::LibraryLink} {}
+
+		/**
+		 * @brief   Take over a container and copy it on the first write only if its data may be visible elsewhere
+		 * @param   source - container to take over
+		 */
+		explicit CopyOnWrite(Container&& source) : value {std::move(source)} {
+			owned = value.getOwner() == Ownership::Library && value.shareCount() == 0;
+		}
+
+		/// Check whether the data is still shared with the original, i.e. the deep copy has not been made yet
+		[[nodiscard]] bool sharedQ() const noexcept {
+			return !owned;
+		}
+
+		/// Get read-only access to the container, this never copies
+		[[nodiscard]] const Container& get() const noexcept {
+			return value;
+		}
+
+		/**
+		 * @brief   Get mutable access to the container, making the deep copy if the data is still shared
+		 * @return  reference to a container owned by the library
+		 */
+		Container& mutate() {
+			if (!owned) {
+				value = value.clone();
+				owned = true;
+			}
+			return value;
+		}
+
+		/**
+		 * @brief   Get the container, e.g. to pass it to MArgumentManager::set
+		 * @return  the container owned by the library, deep-copied now if the data was still shared
+		 */
+		Container release() && {
+			return std::move(mutate());
+		}
+
+		/// Get the number of elements
+		[[nodiscard]] mint size() const noexcept {
+			return value.size();
+		}
+
+		/// Get a read-only pointer to the data, this never copies
+		[[nodiscard]] auto data() const noexcept {
+			return std::as_const(value).data();
+		}
+
+		/// Get a pointer to the data for writing, this makes the deep copy if the data is still shared
+		[[nodiscard]] auto data() {
+			return mutate().data();
+		}
+
+		/// Get a constant iterator to the first element
+		[[nodiscard]] auto begin() const noexcept {
+			return std::as_const(value).begin();
+		}
+
+		/// Get an iterator to the first element for writing, this makes the deep copy if the data is still shared
+		[[nodiscard]] auto begin() {
+			return mutate().begin();
+		}
+
+		/// Get a constant iterator past the last element
+		[[nodiscard]] auto end() const noexcept {
+			return std::as_const(value).end();
+		}
+
+		/// Get an iterator past the last element for writing, this makes the deep copy if the data is still shared
+		[[nodiscard]] auto end() {
+			return mutate().end();
+		}
+
+		/// Get a constant iterator to the first element
+		[[nodiscard]] auto cbegin() const noexcept {
+			return value.cbegin();
+		}
+
+		/// Get a constant iterator past the last element
+		[[nodiscard]] auto cend() const noexcept {
+			return value.cend();
+		}
+
+		/// Read the element at given flat index
+		[[nodiscard]] decltype(auto) operator[](mint index) const {
+			return std::as_const(value)[index];
+		}
+
+		/// Get a reference to the element at given flat index for writing, this makes the deep copy if the data is still shared
+		[[nodiscard]] decltype(auto) operator[](mint index) {
+			return mutate()[index];
+		}
+
+	private:
+		/// Either a non-owning wrapper over the original data or a container owned by the library
+		Container value;
+
+		/// Whether the library owns the data exclusively, so that it can be modified in place
+		bool owned = false;
+	};
+
+	/**
+	 * @brief   Create a lazy clone of a container, the deep copy is made only when the clone is first modified
+	 * @tparam  Container - container type, see CopyOnWrite
+	 * @param   source - container to clone
+	 * @return  CopyOnWrite sharing the data with \p source
+	 */
+	template<class Container>
+	CopyOnWrite<std::remove_cv_t<Container>> lazyClone(const Container& source) {
+		return CopyOnWrite<std::remove_cv_t<Container>> {source};
+	}
+}  // namespace LLU
+
+#endif	  // LLU_CONTAINERS_COPYONWRITE_H
@@ -9,8 +9,11 @@
 #define LLU_CONTAINERS_DATALIST_H
 
 #include <initializer_list>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -31,6 +34,8 @@ namespace LLU {
 	 * @details Designed to be strongly typed i.e. to wrap only homogeneous DataStores but by passing NodeType::Any as template parameter it will
 	 *          work with arbitrary DataStores.
 	 * @tparam  T - type of data stored in each node, see the \c NodeType namespace for possible node types
+	 * @note    Lookups by name or index (find, operator[], at) build an index of nodes on first use, which is then extended as new nodes are added.
+	 *          Because of that, lookups on the same DataList must not run concurrently with each other.
 	 */
 	template<typename T>
 	class DataList : public MContainer<MArgumentType::DataStore> {
@@ -59,6 +64,16 @@ namespace LLU {
 		 */
 		explicit DataList(GenericDataList gds);
 
+		/**
+		 * @brief	Create DataList wrapping around an existing GenericDataList without checking the types of its nodes
+		 * @param 	gds - GenericDataList whose nodes are all of type T, e.g. built by the library itself or received from a trusted producer
+		 * @warning If a node has a different type, reading its value results in undefined behavior.
+		 * @return  new DataList
+		 */
+		static DataList fromTrusted(GenericDataList gds) {
+			return DataList {std::move(gds), TrustedTag {}};
+		}
+
 		/**
 		 * @brief	Create DataList from list of values. Keys will be set to empty strings.
 		 * @param 	initList - list of values to put in the DataList
@@ -149,9 +164,98 @@ namespace LLU {
 		 */
 		void push_back(std::string_view name, value_type nodeData);
 
+		/**
+		 * @brief   Add new nodes with values from range [first, last) to the DataList. Keys will be set to empty strings.
+		 * @details Unless value_type is NodeType::Any, the LibraryLink function that adds nodes is looked up only once for the whole range.
+		 *          Values are copied, use move iterators to move containers to the DataList instead. NodeType::Any values cannot be copied, so they
+		 *          must always be moved.
+		 * @param   first - iterator to the first value
+		 * @param   last - iterator past the last value
+		 */
+		template<class InputIt, typename = enable_if_input_iterator<InputIt>>
+		void append(InputIt first, InputIt last);
+
+		/**
+		 * @brief   Add new named nodes to the DataList.
+		 * @param   namesFirst - iterator to the first name, names must be convertible to std::string_view and null-terminated
+		 * @param   namesLast - iterator past the last name
+		 * @param   valuesFirst - iterator to the first value, there must be at least as many values as names
+		 */
+		template<class NameIt, class InputIt, typename = enable_if_input_iterator<NameIt>>
+		void append(NameIt namesFirst, NameIt namesLast, InputIt valuesFirst);
+
+		/**
+		 * @brief   Find the first node with given name
+		 * @param   name - name of the node
+		 * @return  iterator to the node, or end() if there is no node with that name
+		 * @note    The first lookup takes linear time, subsequent lookups take constant time on average
+		 */
+		iterator find(std::string_view name) const;
+
+		/**
+		 * @brief   Check if the DataList has a node with given name
+		 * @param   name - name of the node
+		 */
+		bool contains(std::string_view name) const {
+			return find(name) != end();
+		}
+
+		/**
+		 * @brief   Get the value of the first node with given name
+		 * @param   name - name of the node
+		 * @throws  ErrorName::DLNodeNotFound - if there is no node with that name
+		 */
+		value_type operator[](std::string_view name) const;
+
+		/**
+		 * @brief   Get a node by its position in the DataList
+		 * @param   index - 0-based index of the node
+		 * @return  proxy DataNode<T> object of the node
+		 * @throws  ErrorName::DLNodeNotFound - if the index is out of range
+		 * @note    The first call takes linear time, subsequent calls take constant time
+		 */
+		DataNode<T> at(mint index) const;
+
+		/**
+		 * @brief   Get a lazy range of node values, which makes no copies.
+		 * @details For DataLists of strings the values are std::string_views into the DataStore, and containers are wrappers that do not own
+		 *          their data, so no value may outlive this DataList.
+		 */
+		NodeRange<value_iterator> valueViews() const {
+			return {valueBegin(), valueEnd()};
+		}
+
+		/**
+		 * @brief   Get a lazy range of node names, which makes no copies.
+		 * @details Names are std::string_views into the DataStore, so they must not outlive this DataList, use names() to get copies.
+		 */
+		NodeRange<name_iterator> nameViews() const {
+			return {nameBegin(), nameEnd()};
+		}
+
+		/**
+		 * @brief   Check the types of all nodes once and get a range of their values that are then read without any per-node type dispatch.
+		 * @details This is mostly useful for DataList<NodeType::Any> whose nodes are expected to share a single type, e.g. all Real.
+		 *          Values in the range are views, same as in valueViews().
+		 * @tparam  U - expected type of all node values, see the \c NodeType namespace
+		 * @return  a lazy range of node values of type U, or std::nullopt if some node holds a value of a different type
+		 */
+		template<typename U = T>
+		std::optional<NodeRange<TypedValueIterator<U>>> tryAsHomogeneous() const;
+
+		/**
+		 * @brief   Copy the values of all nodes to a contiguous vector in a single walk over the DataList, if all nodes hold values of type U.
+		 * @details Use it for numeric records, e.g. DataList<NodeType::Any> with only Real nodes, to process the values as a plain array afterwards.
+		 * @tparam  U - expected type of all node values, see the \c NodeType namespace
+		 * @return  vector of node values, or std::nullopt if some node holds a value of a different type
+		 */
+		template<typename U = T>
+		std::optional<std::vector<U>> tryPackHomogeneous() const;
+
 		/**
 		 * @brief   Return a vector of DataList node values.
 		 * @return  a std::vector of node values
+		 * @note    Use valueViews() to iterate over the values without copying them to a vector
 		 */
 		std::vector<T> values() const {
 			return {valueBegin(), valueEnd()};
@@ -160,6 +264,7 @@ namespace LLU {
 		/**
 		 * @brief   Return a vector of DataList node names.
 		 * @return  a std::vector of node names
+		 * @note    Every name is copied to a new string, use nameViews() to iterate over the names without making copies
 		 */
 		std::vector<std::string> names() const {
 			return {nameBegin(), nameEnd()};
@@ -172,6 +277,23 @@ namespace LLU {
 		std::vector<DataNode<T>> toVector() const {
 			return {cbegin(), cend()};
 		}
+
+	private:
+		/// Selects the constructor that skips validation of node types
+		struct TrustedTag {};
+
+		DataList(GenericDataList gds, TrustedTag /*tag*/) : GenericDataList(std::move(gds)) {}
+
+		/// Random access to nodes and positions of the first node with each name
+		struct NodeIndex {
+			std::vector<DataStoreNode> nodes;
+			std::unordered_map<std::string_view, mint> byName;
+		};
+
+		/// Get the index, adding nodes appended since the last lookup
+		const NodeIndex& nodeIndex() const;
+
+		mutable std::unique_ptr<NodeIndex> index;
 	};
 
 	/* Definitions od DataList methods */
@@ -179,25 +301,30 @@ namespace LLU {
 	template<typename T>
 	DataList<T>::DataList(GenericDataList gds) : GenericDataList(std::move(gds)) {
 		if constexpr (!std::is_same_v<T, LLU::NodeType::Any>) {
-			std::for_each(GenericDataList::cbegin(), GenericDataList::cend(), [](auto node) {
-				if (node.type() != Argument::WrapperIndex<T>) {
-					ErrorManager::throwException(ErrorName::DLInvalidNodeType);
-				}
-			});
+			if (!hasNodesOfType(Argument::WrapperIndex<T>)) {
+				ErrorManager::throwException(ErrorName::DLInvalidNodeType);
+			}
 		}
 	}
 
 	template<typename T>
 	DataList<T>::DataList(std::initializer_list<value_type> initList) : DataList() {
-		for (auto&& elem : initList) {
-			push_back(std::move(elem));
-		}
+		append(initList.begin(), initList.end());
 	}
 
 	template<typename T>
 	DataList<T>::DataList(std::initializer_list<std::pair<std::string, value_type>> initList) : DataList() {
-		for (auto&& elem : initList) {
-			push_back(elem.first, std::move(elem.second));
+		if constexpr (std::is_same_v<T, LLU::NodeType::Any>) {
+			for (auto&& elem : initList) {
+				push_back(elem.first, elem.second);
+			}
+		} else {
+			constexpr MArgumentType Type = Argument::WrapperIndex<T>;
+			auto addNode = PrimitiveWrapper<Type>::namedDataStoreNodeAdder();
+			for (auto&& elem : initList) {
+				// NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast): LibraryLink will not modify the name
+				addNode(getContainer(), const_cast<char*>(elem.first.c_str()), toNodeValue<Type>(elem.second));
+			}
 		}
 	}
 
@@ -216,6 +343,101 @@ namespace LLU {
 		GenericDataList::push_back(name, std::move(nodeData));
 	}
 
+	template<typename T>
+	template<class InputIt, typename>
+	void DataList<T>::append(InputIt first, InputIt last) {
+		if constexpr (std::is_same_v<T, LLU::NodeType::Any>) {
+			for (; first != last; ++first) {
+				push_back(*first);
+			}
+		} else {
+			GenericDataList::append<Argument::WrapperIndex<T>>(first, last);
+		}
+	}
+
+	template<typename T>
+	template<class NameIt, class InputIt, typename>
+	void DataList<T>::append(NameIt namesFirst, NameIt namesLast, InputIt valuesFirst) {
+		if constexpr (std::is_same_v<T, LLU::NodeType::Any>) {
+			for (; namesFirst != namesLast; ++namesFirst, ++valuesFirst) {
+				push_back(*namesFirst, *valuesFirst);
+			}
+		} else {
+			GenericDataList::append<Argument::WrapperIndex<T>>(namesFirst, namesLast, valuesFirst);
+		}
+	}
+
+
+	template<typename T>
+	template<typename U>
+	auto DataList<T>::tryAsHomogeneous() const -> std::optional<NodeRange<TypedValueIterator<U>>> {
+		constexpr MArgumentType Type = Argument::WrapperIndex<U>;
+		for (auto node = GenericDataNode {front()}; node; node = node.next()) {
+			if (node.type() != Type) {
+				return std::nullopt;
+			}
+		}
+		return NodeRange<TypedValueIterator<U>> {TypedValueIterator<U> {front()}, TypedValueIterator<U> {nullptr}};
+	}
+
+	template<typename T>
+	template<typename U>
+	auto DataList<T>::tryPackHomogeneous() const -> std::optional<std::vector<U>> {
+		static_assert(!std::is_same_v<U, LLU::NodeType::Any>, "tryPackHomogeneous requires a concrete node type.");
+		constexpr MArgumentType Type = Argument::WrapperIndex<U>;
+		std::vector<U> result;
+		result.reserve(static_cast<std::size_t>(length()));
+		for (auto node = GenericDataNode {front()}; node; node = node.next()) {
+			if (node.type() != Type) {
+				return std::nullopt;
+			}
+			result.push_back(node.valueAs<Type>());
+		}
+		return result;
+	}
+
+	template<typename T>
+	auto DataList<T>::nodeIndex() const -> const NodeIndex& {
+		if (!index) {
+			index = std::make_unique<NodeIndex>();
+		}
+		auto& nodes = index->nodes;
+		const auto count = static_cast<std::size_t>(length());
+		if (nodes.size() < count) {
+			nodes.reserve(count);
+			auto node = nodes.empty() ? GenericDataNode {front()} : GenericDataNode {nodes.back()}.next();
+			for (; node; node = node.next()) {
+				index->byName.emplace(node.name(), static_cast<mint>(nodes.size()));
+				nodes.push_back(node.node);
+			}
+		}
+		return *index;
+	}
+
+	template<typename T>
+	auto DataList<T>::find(std::string_view name) const -> iterator {
+		const auto& idx = nodeIndex();
+		auto it = idx.byName.find(name);
+		return it == idx.byName.end() ? end() : iterator {idx.nodes[static_cast<std::size_t>(it->second)]};
+	}
+
+	template<typename T>
+	auto DataList<T>::operator[](std::string_view name) const -> value_type {
+		auto it = find(name);
+		if (it == end()) {
+			ErrorManager::throwException(ErrorName::DLNodeNotFound, std::string {name});
+		}
+		return std::move((*it).value());
+	}
+
+	template<typename T>
+	DataNode<T> DataList<T>::at(mint index) const {
+		const auto& nodes = nodeIndex().nodes;
+		if (index < 0 || index >= static_cast<mint>(nodes.size())) {
+			ErrorManager::throwException(ErrorName::DLNodeNotFound, index);
+		}
+		return DataNode<T> {nodes[static_cast<std::size_t>(index)]};
+	}
 
 	namespace Detail {
 		template<typename T, typename IteratorType>
@@ -0,0 +1,255 @@
+/**
+ * @file	FixedRank.hpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Tensor and NumericArray wrappers with the rank known at compile time.
+ */
+#ifndef LLU_CONTAINERS_FIXEDRANK_HPP
+#define LLU_CONTAINERS_FIXEDRANK_HPP
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "LLU/Containers/MArrayDimensions.h"
+#include "LLU/Containers/NumericArray.h"
+#include "LLU/Containers/Tensor.h"
+#include "LLU/ErrorLog/ErrorManager.h"
+
+namespace LLU {
+
+	/**
+	 * @class   FixedRankDimensions
+	 * @brief   Dimensions and offsets of a container whose rank is known at compile time.
+	 * @details All loops over dimensions have a constant trip count, so index computations are fully unrolled by the compiler.
+	 * @tparam  R - rank of the container
+	 */
+	template<std::size_t R>
+	class FixedRankDimensions {
+	public:
+		/// Rank of the container
+		static constexpr std::size_t rank = R;
+
+		/// Create dimensions of a "hollow" container, all dimensions are 0
+		FixedRankDimensions() = default;
+
+		/**
+		 * @brief   Copy dimensions from a runtime-rank MArrayDimensions
+		 * @param   d - dimensions of the container
+		 * @throws  ErrorName::RankError - if the rank of \p d is not R
+		 */
+		explicit FixedRankDimensions(const MArrayDimensions& d) {
+			if (d.rank() != static_cast<mint>(R)) {
+				ErrorManager::throwException(ErrorName::RankError);
+			}
+			for (std::size_t i = 0; i < R; ++i) {
+				dims[i] = d.data()[i];
+			}
+			mint offset = 1;
+			for (std::size_t i = R; i > 0; --i) {
+				offsets[i - 1] = offset;
+				offset *= dims[i - 1];
+			}
+		}
+
+		/// Get the dimension \p D, checked at compile time
+		template<std::size_t D>
+		mint get() const noexcept {
+			static_assert(D < R, "Dimension index out of range.");
+			return dims[D];
+		}
+
+		/// Get all dimensions
+		const std::array<mint, R>& get() const noexcept {
+			return dims;
+		}
+
+		/// Get all offsets, i.e. distances between consecutive elements along each dimension
+		const std::array<mint, R>& getOffsets() const noexcept {
+			return offsets;
+		}
+
+		/**
+		 * @brief   Convert coordinates of an element to the corresponding index in a flat list of elements, without bound checking
+		 * @param   indices - exactly R coordinates
+		 */
+		template<typename... Indices>
+		mint getIndex(Indices... indices) const noexcept {
+			static_assert(sizeof...(Indices) == R, "Number of indices must be equal to the rank.");
+			static_assert((std::is_integral_v<Indices> && ...), "Indices must be integral.");
+			return getIndex(std::index_sequence_for<Indices...> {}, static_cast<mint>(indices)...);
+		}
+
+		/**
+		 * @brief   Check if given coordinates are valid and convert them to the corresponding index in a flat list of elements
+		 * @param   indices - exactly R coordinates
+		 * @throws  ErrorName::MArrayElementIndexError - if any of the coordinates is out-of-bounds
+		 */
+		template<typename... Indices>
+		mint getIndexChecked(Indices... indices) const {
+			static_assert(sizeof...(Indices) == R, "Number of indices must be equal to the rank.");
+			const std::array<mint, R> idx {{static_cast<mint>(indices)...}};
+			for (std::size_t i = 0; i < R; ++i) {
+				if (idx[i] < 0 || idx[i] >= dims[i]) {
+					ErrorManager::throwException(ErrorName::MArrayElementIndexError, idx[i]);
+				}
+			}
+			return getIndex(indices...);
+		}
+
+	private:
+		std::array<mint, R> dims {};
+		std::array<mint, R> offsets {};
+
+		template<std::size_t... Is, typename... Indices>
+		mint getIndex(std::index_sequence<Is...> /*unused*/, Indices... indices) const noexcept {
+			return ((indices * offsets[Is]) + ... + mint {0});
+		}
+	};
+
+	/**
+	 * @class   FixedRankMArray
+	 * @brief   Wrapper over a Tensor or NumericArray, which validates the rank once, at construction, and then provides element access with
+	 * index arithmetic unrolled at compile time.
+	 *
+	 * FixedRankMArray has all constructors and member functions of the wrapped container type, so it can be passed to MArgumentManager::set like
+	 * any other Tensor or NumericArray. It adds operator() and at() taking exactly R coordinates, which compile to the same code as manual
+	 * pointer arithmetic. The data pointer is obtained from LibraryLink once and cached.
+	 *
+	 * @tparam  Container - Tensor<T> or NumericArray<T>
+	 * @tparam  R - rank of the container
+	 * @see     FixedRankTensor, FixedRankNumericArray
+	 */
+	template<class Container, std::size_t R>
+	class FixedRankMArray : public Container {
+	public:
+		/// Type of elements stored
+		using value_type = typename Container::value_type;
+
+		/// Rank of the container
+		static constexpr std::size_t fixedRank = R;
+
+		/**
+		 * @brief   Constructors of the wrapped container type are inherited.
+		 * @throws  ErrorName::RankError - if the rank of the newly created container is not R
+		 */
+		using Container::Container;
+
+		/**
+		 * @brief   Create a FixedRankMArray from a container of the wrapped type
+		 * @param   c - Tensor or NumericArray to take over
+		 * @throws  ErrorName::RankError - if the rank of \p c is not R
+		 */
+		explicit FixedRankMArray(Container c) : Container(std::move(c)) {}
+
+		/// Default constructor, creates a "hollow" container
+		FixedRankMArray() = default;
+
+		/// Get the dimension \p D, checked at compile time
+		template<std::size_t D>
+		mint extent() const noexcept {
+			return fixedDims.template get<D>();
+		}
+
+		/// Get the dimensions with compile-time rank
+		const FixedRankDimensions<R>& fixedDimensions() const noexcept {
+			return fixedDims;
+		}
+
+		/// Get raw pointer to the data, cached at construction
+		value_type* data() noexcept {
+			return elements;
+		}
+
+		/// Get raw pointer to the const data, cached at construction
+		const value_type* data() const noexcept {
+			return elements;
+		}
+
+		/**
+		 * @brief   Get a reference to the element at given coordinates, without bound checking
+		 * @param   indices - exactly R coordinates
+		 */
+		template<typename... Indices>
+		value_type& operator()(Indices... indices) noexcept {
+			return elements[fixedDims.getIndex(indices...)];
+		}
+
+		/**
+		 * @brief   Get a constant reference to the element at given coordinates, without bound checking
+		 * @param   indices - exactly R coordinates
+		 */
+		template<typename... Indices>
+		const value_type& operator()(Indices... indices) const noexcept {
+			return elements[fixedDims.getIndex(indices...)];
+		}
+
+		/**
+		 * @brief   Get a reference to the element at given position in the flat list of elements, with bound checking
+		 * @param   index - position of desired data element
+		 * @throws  ErrorName::MArrayElementIndexError - if \p index is out-of-bounds
+		 */
+		value_type& at(mint index) {
+			return elements[this->dimensions().getIndexChecked(index)];
+		}
+
+		/**
+		 * @brief   Get a constant reference to the element at given position in the flat list of elements, with bound checking
+		 * @param   index - position of desired data element
+		 * @throws  ErrorName::MArrayElementIndexError - if \p index is out-of-bounds
+		 */
+		const value_type& at(mint index) const {
+			return elements[this->dimensions().getIndexChecked(index)];
+		}
+
+		/**
+		 * @brief   Get a reference to the element at given coordinates, with bound checking
+		 * @param   indices - exactly R coordinates, R > 1
+		 * @throws  ErrorName::MArrayElementIndexError - if any of the coordinates is out-of-bounds
+		 */
+		template<typename... Indices, typename = std::enable_if_t<(sizeof...(Indices) == R && R > 1)>>
+		value_type& at(Indices... indices) {
+			return elements[fixedDims.getIndexChecked(indices...)];
+		}
+
+		/**
+		 * @brief   Get a constant reference to the element at given coordinates, with bound checking
+		 * @param   indices - exactly R coordinates, R > 1
+		 * @throws  ErrorName::MArrayElementIndexError - if any of the coordinates is out-of-bounds
+		 */
+		template<typename... Indices, typename = std::enable_if_t<(sizeof...(Indices) == R && R > 1)>>
+		const value_type& at(Indices... indices) const {
+			return elements[fixedDims.getIndexChecked(indices...)];
+		}
+
+	private:
+		/// Dimensions with compile-time rank, computed once from the runtime dimensions of the wrapped container
+		FixedRankDimensions<R> fixedDims = fixedRankDimensions();
+
+		/// Cached pointer to the data, it does not change during the lifetime of the underlying container
+		value_type* elements = this->getContainer() ? Container::data() : nullptr;
+
+		FixedRankDimensions<R> fixedRankDimensions() const {
+			return this->getContainer() ? FixedRankDimensions<R> {this->dimensions()} : FixedRankDimensions<R> {};
+		}
+	};
+
+	/**
+	 * Tensor with rank known at compile time
+	 * @tparam  T - type of data in Tensor
+	 * @tparam  R - rank
+	 */
+	template<typename T, std::size_t R>
+	using FixedRankTensor = FixedRankMArray<Tensor<T>, R>;
+
+	/**
+	 * NumericArray with rank known at compile time
+	 * @tparam  T - type of data in NumericArray
+	 * @tparam  R - rank
+	 */
+	template<typename T, std::size_t R>
+	using FixedRankNumericArray = FixedRankMArray<NumericArray<T>, R>;
+
+}  // namespace LLU
+
+#endif	  // LLU_CONTAINERS_FIXEDRANK_HPP
@@ -14,6 +14,7 @@
 #include "LLU/Utilities.hpp"
 
 #include "LLU/Containers/Interfaces.h"
+#include "LLU/Containers/MemoryStats.h"
 
 namespace LLU {
 
@@ -52,6 +53,9 @@ namespace LLU {
 			if (!c) {
 				ErrorManager::throwException(ErrorName::CreateFromNullError);
 			}
+			if (owner == Ownership::Library) {
+				account(true);
+			}
 		}
 
 		/// Container wrappers are non-copyable, they act somewhat like unique_ptr around the raw container
@@ -105,6 +109,9 @@ namespace LLU {
 		 * @return a handle to the internal container
 		 */
 		Container abandonContainer() const noexcept {
+			if (owner == Ownership::Library) {
+				account(false);
+			}
 			owner = Ownership::LibraryLink;
 			return container;
 		}
@@ -130,6 +137,7 @@ namespace LLU {
 			// Per LibraryLink documentation: returning a Shared container does not affect the memory management, so we only need to cover
 			// the case where the library owns the container. In such case the ownership is passed to the LibraryLink
 			if (owner == Ownership::Library) {
+				account(false);
 				owner = Ownership::LibraryLink;
 			}
 		}
@@ -162,13 +170,13 @@ namespace LLU {
 			if constexpr (Type == MArgumentType::DataStore) {
 				// Disowning does nothing for DataStore as it cannot be shared.
 			} else if constexpr (Type == MArgumentType::Image) {
-				LibraryData::ImageAPI()->MImage_disown(container);
+				LibraryData::uncheckedImageAPI()->MImage_disown(container);
 			} else if constexpr (Type == MArgumentType::NumericArray) {
-				LibraryData::NumericArrayAPI()->MNumericArray_disown(container);
+				LibraryData::uncheckedNumericArrayAPI()->MNumericArray_disown(container);
 			} else if constexpr (Type == MArgumentType::SparseArray) {
-				LibraryData::SparseArrayAPI()->MSparseArray_disown(container);
+				LibraryData::uncheckedSparseArrayAPI()->MSparseArray_disown(container);
 			} else if constexpr (Type == MArgumentType::Tensor) {
-				LibraryData::API()->MTensor_disown(container);
+				LibraryData::uncheckedAPI()->MTensor_disown(container);
 			} else {
 				static_assert(alwaysFalse<Type>, "Unsupported MContainer type.");
 			}
@@ -176,19 +184,20 @@ namespace LLU {
 
 		/// Free internal container if present
 		void free() const noexcept {
+			account(false);
 			if (!container || !LibraryData::hasLibraryData()) {
 				return;
 			}
 			if constexpr (Type == MArgumentType::DataStore) {
-				LibraryData::DataStoreAPI()->deleteDataStore(container);
+				LibraryData::uncheckedDataStoreAPI()->deleteDataStore(container);
 			} else if constexpr (Type == MArgumentType::Image) {
-				LibraryData::ImageAPI()->MImage_free(container);
+				LibraryData::uncheckedImageAPI()->MImage_free(container);
 			} else if constexpr (Type == MArgumentType::NumericArray) {
-				LibraryData::NumericArrayAPI()->MNumericArray_free(container);
+				LibraryData::uncheckedNumericArrayAPI()->MNumericArray_free(container);
 			} else if constexpr (Type == MArgumentType::SparseArray) {
-				LibraryData::SparseArrayAPI()->MSparseArray_free(container);
+				LibraryData::uncheckedSparseArrayAPI()->MSparseArray_free(container);
 			} else if constexpr (Type == MArgumentType::Tensor) {
-				LibraryData::API()->MTensor_free(container);
+				LibraryData::uncheckedAPI()->MTensor_free(container);
 			} else {
 				static_assert(alwaysFalse<Type>, "Unsupported MContainer type.");
 			}
@@ -211,11 +220,30 @@ namespace LLU {
 					case Ownership::LibraryLink: break;
 				}
 				container = newCont;
+				if (newOwnerMode == Ownership::Library) {
+					account(true);
+				}
+			} else if ((owner == Ownership::Library) != (newOwnerMode == Ownership::Library)) {
+				account(newOwnerMode == Ownership::Library);
 			}
 			owner = newOwnerMode;
 		}
 
 	private:
+		/// Register the container as held by the library or remove it from the registry, only when LLU_MEMORY_STATS is defined
+		void account(bool acquired) const noexcept {
+			if constexpr (memoryStatsEnabled) {
+				if (!container) {
+					return;
+				}
+				if (acquired) {
+					MemoryStats::acquire(Type, container);
+				} else {
+					MemoryStats::release(container);
+				}
+			}
+		}
+
 		/// Make a deep copy of the raw container
 		virtual Container cloneImpl() const = 0;
 
@@ -65,15 +65,23 @@ namespace LLU {
 		 * @return  total number of nodes in the DataStore
 		 */
 		mint length() const {
-			return LibraryData::DataStoreAPI()->DataStore_getLength(this->getContainer());
+			return LibraryData::uncheckedDataStoreAPI()->DataStore_getLength(this->getContainer());
 		}
 
+		/**
+		 * @brief   Check if all nodes of the DataStore have given type.
+		 * @details The DataStore functions are looked up once for the whole list, which makes this much cheaper than checking node.type() per node.
+		 * @param   type - expected type of the nodes
+		 * @return  true iff the DataStore is empty or every node has type \p type
+		 */
+		bool hasNodesOfType(MArgumentType type) const noexcept;
+
 		/**
 		 * @brief   Get the first node of the DataStore.
 		 * @return  first node, if it doesn't exist the behavior is undefined
 		 */
 		DataStoreNode front() const {
-			return LibraryData::DataStoreAPI()->DataStore_getFirstNode(this->getContainer());
+			return LibraryData::uncheckedDataStoreAPI()->DataStore_getFirstNode(this->getContainer());
 		};
 
 		/**
@@ -81,7 +89,7 @@ namespace LLU {
 		 * @return  last node, if it doesn't exist the behavior is undefined
 		 */
 		DataStoreNode back() const {
-			return LibraryData::DataStoreAPI()->DataStore_getLastNode(this->getContainer());
+			return LibraryData::uncheckedDataStoreAPI()->DataStore_getLastNode(this->getContainer());
 		};
 
 		/// Proxy iterator to the first element of the DataStore
@@ -181,6 +189,43 @@ namespace LLU {
 		 */
 		void push_back(std::string_view name, const Argument::Typed::Any& node);
 
+		/**
+		 * @brief   Add new nameless nodes with values from range [first, last) at the end of the underlying DataStore
+		 * @details The LibraryLink function that adds nodes is looked up only once for the whole range, which makes this function much faster
+		 *          than push_back in a loop when many nodes are added. Values are copied as if they were passed to push_back, use move iterators
+		 *          to move containers to the DataStore instead.
+		 * @tparam  Type - type of all new nodes expressed via the MArgumentType enum
+		 * @param   first - iterator to the first value, values must be convertible to either Argument::WrapperType<Type> or Argument::CType<Type>
+		 * @param   last - iterator past the last value
+		 */
+		template<MArgumentType Type, class InputIt, typename = enable_if_input_iterator<InputIt>>
+		void append(InputIt first, InputIt last);
+
+		/**
+		 * @brief   Add new named nodes at the end of the underlying DataStore
+		 * @details The LibraryLink function that adds nodes is looked up only once for the whole range.
+		 * @tparam  Type - type of all new nodes expressed via the MArgumentType enum
+		 * @param   namesFirst - iterator to the first name, names must be convertible to std::string_view and null-terminated
+		 * @param   namesLast - iterator past the last name
+		 * @param   valuesFirst - iterator to the first value, there must be at least as many values as names
+		 */
+		template<MArgumentType Type, class NameIt, class InputIt, typename = enable_if_input_iterator<NameIt>>
+		void append(NameIt namesFirst, NameIt namesLast, InputIt valuesFirst);
+
+	protected:
+		/**
+		 * @brief   Convert a value to the type that LibraryLink stores in DataStore nodes of type \p Type
+		 * @details Containers are copied and the copy is abandoned, so that the DataStore can take ownership of it.
+		 */
+		template<MArgumentType Type, typename V>
+		static Argument::CType<Type> toNodeValue(V&& value) {
+			if constexpr (std::is_convertible_v<V&&, Argument::CType<Type>>) {
+				return std::forward<V>(value);
+			} else {
+				return Argument::toPrimitiveType<Type>(Argument::WrapperType<Type> {std::forward<V>(value)});
+			}
+		}
+
 	private:
 		/// Make a deep copy of the raw container
 		Container cloneImpl() const override {
@@ -229,6 +274,28 @@ namespace LLU {
 		}
 	}
 
+	template<MArgumentType Type, class InputIt, typename>
+	void GenericDataList::append(InputIt first, InputIt last) {
+		static_assert(Type != MArgumentType::MArgument, "Type of the new nodes must be known.");
+		auto addNode = PrimitiveWrapper<Type>::dataStoreNodeAdder();
+		auto* ds = getContainer();
+		for (; first != last; ++first) {
+			addNode(ds, toNodeValue<Type>(*first));
+		}
+	}
+
+	template<MArgumentType Type, class NameIt, class InputIt, typename>
+	void GenericDataList::append(NameIt namesFirst, NameIt namesLast, InputIt valuesFirst) {
+		static_assert(Type != MArgumentType::MArgument, "Type of the new nodes must be known.");
+		auto addNode = PrimitiveWrapper<Type>::namedDataStoreNodeAdder();
+		auto* ds = getContainer();
+		for (; namesFirst != namesLast; ++namesFirst, ++valuesFirst) {
+			const auto& name = *namesFirst;
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast): LibraryLink will not modify the name
+			addNode(ds, const_cast<char*>(std::string_view {name}.data()), toNodeValue<Type>(*valuesFirst));
+		}
+	}
+
 	template<typename T>
 	T GenericDataNode::as() const {
 		auto v = value();
@@ -238,6 +305,15 @@ namespace LLU {
 		}
 		return std::move(*ptr);
 	}
+
+	template<MArgumentType Type>
+	Argument::WrapperType<Type> GenericDataNode::valueAs() const {
+		MArgument m;
+		if (LibraryData::uncheckedDataStoreAPI()->DataStoreNode_getData(node, &m) != 0) {
+			ErrorManager::throwException(ErrorName::DLGetNodeDataError);
+		}
+		return Argument::toWrapperType<Type>(PrimitiveWrapper<Type> {m}.get());
+	}
 }  // namespace LLU
 
 #endif	  // LLU_CONTAINERS_GENERIC_DATASTORE_HPP
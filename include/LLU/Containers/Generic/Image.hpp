@@ -82,62 +82,62 @@ namespace LLU {
 
 		/// @copydoc ImageInterface::colorspace()
 		colorspace_t colorspace() const override {
-			return LibraryData::ImageAPI()->MImage_getColorSpace(this->getContainer());
+			return LibraryData::uncheckedImageAPI()->MImage_getColorSpace(this->getContainer());
 		}
 
 		/// @copydoc ImageInterface::rows()
 		mint rows() const override {
-			return LibraryData::ImageAPI()->MImage_getRowCount(this->getContainer());
+			return LibraryData::uncheckedImageAPI()->MImage_getRowCount(this->getContainer());
 		}
 
 		/// @copydoc ImageInterface::columns()
 		mint columns() const override {
-			return LibraryData::ImageAPI()->MImage_getColumnCount(this->getContainer());
+			return LibraryData::uncheckedImageAPI()->MImage_getColumnCount(this->getContainer());
 		}
 
 		/// @copydoc ImageInterface::slices()
 		mint slices() const override {
-			return LibraryData::ImageAPI()->MImage_getSliceCount(this->getContainer());
+			return LibraryData::uncheckedImageAPI()->MImage_getSliceCount(this->getContainer());
 		}
 
 		/// @copydoc ImageInterface::channels()
 		mint channels() const override {
-			return LibraryData::ImageAPI()->MImage_getChannels(this->getContainer());
+			return LibraryData::uncheckedImageAPI()->MImage_getChannels(this->getContainer());
 		}
 
 		/// @copydoc ImageInterface::alphaChannelQ()
 		bool alphaChannelQ() const override {
-			return LibraryData::ImageAPI()->MImage_alphaChannelQ(this->getContainer()) != 0;
+			return LibraryData::uncheckedImageAPI()->MImage_alphaChannelQ(this->getContainer()) != 0;
 		}
 
 		/// @copydoc ImageInterface::interleavedQ()
 		bool interleavedQ() const override {
-			return LibraryData::ImageAPI()->MImage_interleavedQ(this->getContainer()) != 0;
+			return LibraryData::uncheckedImageAPI()->MImage_interleavedQ(this->getContainer()) != 0;
 		}
 
 		/// @copydoc ImageInterface::is3D()
 		bool is3D() const override {
-			return LibraryData::ImageAPI()->MImage_getRank(this->getContainer()) == 3;
+			return LibraryData::uncheckedImageAPI()->MImage_getRank(this->getContainer()) == 3;
 		}
 
 		/// @copydoc ImageInterface::getRank()
 		mint getRank() const override {
-			return LibraryData::ImageAPI()->MImage_getRank(this->getContainer());
+			return LibraryData::uncheckedImageAPI()->MImage_getRank(this->getContainer());
 		}
 
 		/// @copydoc ImageInterface::getFlattenedLength()
 		mint getFlattenedLength() const override {
-			return LibraryData::ImageAPI()->MImage_getFlattenedLength(this->getContainer());
+			return LibraryData::uncheckedImageAPI()->MImage_getFlattenedLength(this->getContainer());
 		}
 
 		/// @copydoc ImageInterface::type()
 		imagedata_t type() const override {
-			return LibraryData::ImageAPI()->MImage_getDataType(this->getContainer());
+			return LibraryData::uncheckedImageAPI()->MImage_getDataType(this->getContainer());
 		}
 
 		/// @copydoc ImageInterface::rawData()
 		void* rawData() const override {
-			return LibraryData::ImageAPI()->MImage_getRawData(this->getContainer());
+			return LibraryData::uncheckedImageAPI()->MImage_getRawData(this->getContainer());
 		}
 	private:
 
@@ -152,7 +152,7 @@ namespace LLU {
 		 * @see 	<http://reference.wolfram.com/language/LibraryLink/ref/callback/MImage_shareCount.html>
 		 */
 		mint shareCountImpl() const noexcept override {
-			return LibraryData::ImageAPI()->MImage_shareCount(this->getContainer());
+			return LibraryData::uncheckedImageAPI()->MImage_shareCount(this->getContainer());
 		}
 
 		/// @copydoc   MContainer<MArgumentType::DataStore>::pass
@@ -60,27 +60,27 @@ namespace LLU {
 
 		/// @copydoc NumericArrayInterface::getRank()
 		mint getRank() const override {
-			return LibraryData::NumericArrayAPI()->MNumericArray_getRank(this->getContainer());
+			return LibraryData::uncheckedNumericArrayAPI()->MNumericArray_getRank(this->getContainer());
 		}
 
 		/// @copydoc NumericArrayInterface::getDimensions()
 		mint const* getDimensions() const override {
-			return LibraryData::NumericArrayAPI()->MNumericArray_getDimensions(this->getContainer());
+			return LibraryData::uncheckedNumericArrayAPI()->MNumericArray_getDimensions(this->getContainer());
 		}
 
 		/// @copydoc NumericArrayInterface::getFlattenedLength()
 		mint getFlattenedLength() const override {
-			return LibraryData::NumericArrayAPI()->MNumericArray_getFlattenedLength(this->getContainer());
+			return LibraryData::uncheckedNumericArrayAPI()->MNumericArray_getFlattenedLength(this->getContainer());
 		}
 
 		/// @copydoc NumericArrayInterface::type()
 		numericarray_data_t type() const override {
-			return LibraryData::NumericArrayAPI()->MNumericArray_getType(this->getContainer());
+			return LibraryData::uncheckedNumericArrayAPI()->MNumericArray_getType(this->getContainer());
 		}
 
 		/// @copydoc NumericArrayInterface::rawData()
 		void* rawData() const noexcept override {
-			return LibraryData::NumericArrayAPI()->MNumericArray_getData(this->getContainer());
+			return LibraryData::uncheckedNumericArrayAPI()->MNumericArray_getData(this->getContainer());
 		}
 
 	private:
@@ -96,7 +96,7 @@ namespace LLU {
 		 * @see 	<http://reference.wolfram.com/language/LibraryLink/ref/callback/MNumericArray_shareCount.html>
 		 */
 		mint shareCountImpl() const noexcept override {
-			return LibraryData::NumericArrayAPI()->MNumericArray_shareCount(this->getContainer());
+			return LibraryData::uncheckedNumericArrayAPI()->MNumericArray_shareCount(this->getContainer());
 		}
 
 		///@copydoc   MContainer<MArgumentType::DataStore>::pass
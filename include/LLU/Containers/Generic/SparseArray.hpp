@@ -86,7 +86,7 @@ namespace LLU {
 		 * @see     <https://reference.wolfram.com/language/LibraryLink/ref/callback/MSparseArray_getRank.html>
 		 */
 		mint getRank() const {
-			return LibraryData::SparseArrayAPI()->MSparseArray_getRank(this->getContainer());
+			return LibraryData::uncheckedSparseArrayAPI()->MSparseArray_getRank(this->getContainer());
 		}
 
 		/**
@@ -95,7 +95,7 @@ namespace LLU {
 		 * @see     <https://reference.wolfram.com/language/LibraryLink/ref/callback/MSparseArray_getDimensions.html>
 		 */
 		mint const* getDimensions() const {
-			return LibraryData::SparseArrayAPI()->MSparseArray_getDimensions(this->getContainer());
+			return LibraryData::uncheckedSparseArrayAPI()->MSparseArray_getDimensions(this->getContainer());
 		}
 
 		/**
@@ -160,7 +160,7 @@ namespace LLU {
 		 * @see 	<http://reference.wolfram.com/language/LibraryLink/ref/callback/MSparseArray_shareCount.html>
 		 */
 		mint shareCountImpl() const noexcept override {
-			return LibraryData::SparseArrayAPI()->MSparseArray_shareCount(this->getContainer());
+			return LibraryData::uncheckedSparseArrayAPI()->MSparseArray_shareCount(this->getContainer());
 		}
 
 		///@copydoc   MContainer<MArgumentType::DataStore>::pass
@@ -49,22 +49,22 @@ namespace LLU {
 
 		/// @copydoc TensorInterface::getRank()
 		mint getRank() const override {
-			return LibraryData::API()->MTensor_getRank(this->getContainer());
+			return LibraryData::uncheckedAPI()->MTensor_getRank(this->getContainer());
 		}
 
 		/// @copydoc TensorInterface::getDimensions()
 		mint const* getDimensions() const override {
-			return LibraryData::API()->MTensor_getDimensions(this->getContainer());
+			return LibraryData::uncheckedAPI()->MTensor_getDimensions(this->getContainer());
 		}
 
 		/// @copydoc TensorInterface::getFlattenedLength()
 		mint getFlattenedLength() const override {
-			return LibraryData::API()->MTensor_getFlattenedLength(this->getContainer());
+			return LibraryData::uncheckedAPI()->MTensor_getFlattenedLength(this->getContainer());
 		}
 
 		/// @copydoc TensorInterface::type()
 		mint type() const override {
-			return LibraryData::API()->MTensor_getType(this->getContainer());
+			return LibraryData::uncheckedAPI()->MTensor_getType(this->getContainer());
 		}
 
 		/// @copydoc TensorInterface::rawData()
@@ -77,7 +77,7 @@ namespace LLU {
 		 * @see 	<http://reference.wolfram.com/language/LibraryLink/ref/callback/MTensor_shareCount.html>
 		 */
 		mint shareCountImpl() const noexcept override {
-			return LibraryData::API()->MTensor_shareCount(this->getContainer());
+			return LibraryData::uncheckedAPI()->MTensor_shareCount(this->getContainer());
 		}
 
 		/// @copydoc   MContainer<MArgumentType::DataStore>::pass
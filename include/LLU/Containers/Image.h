@@ -20,6 +20,7 @@ namespace LLU {
 	 *  @brief  Typed interface for Image.
 	 *
 	 *  Provides iterators, data access and info about dimensions.
+	 *  get() and set() make a LibraryLink call for every value, use PixelAccessor (see LLU::pixels) to access many pixels directly.
 	 *  @tparam T - type of data in Image
 	 */
 	template<typename T>
@@ -86,7 +87,7 @@ namespace LLU {
 		 * @see     <http://reference.wolfram.com/language/LibraryLink/ref/callback/MImage_getRawData.html>
 		 */
 		T* getData() const noexcept override {
-			return static_cast<T*>(LibraryData::ImageAPI()->MImage_getRawData(this->getInternal()));
+			return static_cast<T*>(LibraryData::uncheckedImageAPI()->MImage_getRawData(this->getInternal()));
 		}
 
 		/// Get the raw MImage, must be implemented in subclasses.
@@ -148,6 +149,19 @@ namespace LLU {
 		 **/
 		Image(mint nFrames, mint w, mint h, mint channels, colorspace_t cs, bool interleavingQ);
 
+		/**
+		 *   @brief         Constructs new 2D Image without initializing the pixels
+		 *   @note			Image constructors never write to the pixels, this overload makes the intent explicit and matches Tensor and NumericArray.
+		 **/
+		Image(Uninitialized_t, mint w, mint h, mint channels, colorspace_t cs, bool interleavingQ) : Image(w, h, channels, cs, interleavingQ) {}
+
+		/**
+		 *   @brief         Constructs new 3D Image without initializing the pixels
+		 *   @note			Image constructors never write to the pixels, this overload makes the intent explicit and matches Tensor and NumericArray.
+		 **/
+		Image(Uninitialized_t, mint nFrames, mint w, mint h, mint channels, colorspace_t cs, bool interleavingQ)
+			: Image(nFrames, w, h, channels, cs, interleavingQ) {}
+
 		/**
 		 *   @brief         Create new Image from a GenericImage
 		 *   @param[in]     im - generic image to be wrapped into Image class
@@ -245,27 +259,26 @@ namespace LLU {
 
 	template<typename T>
 	MArrayDimensions Image<T>::dimensionsFromGenericImage(const GenericBase& im) {
-		std::vector<mint> dims;
 		if (!im.getContainer()) {
-			return MArrayDimensions {dims};
+			return {};
 		}
+		DimensionsVector dims;
 		mint depth = im.getRank() + (im.channels() == 1 ? 0 : 1);
+		if (im.channels() > 1 && !im.interleavedQ()) {
+			dims.push_back(im.channels());
+		}
 		if (im.is3D()) {
-			dims = {im.slices(), im.rows(), im.columns()};
-		} else {
-			dims = {im.rows(), im.columns()};
+			dims.push_back(im.slices());
 		}
-		if (im.channels() > 1) {
-			if (im.interleavedQ()) {
-				dims.push_back(im.channels());
-			} else {
-				dims.insert(dims.begin(), im.channels());
-			}
+		dims.push_back(im.rows());
+		dims.push_back(im.columns());
+		if (im.channels() > 1 && im.interleavedQ()) {
+			dims.push_back(im.channels());
 		}
 		if (dims.size() != static_cast<std::make_unsigned_t<mint>>(depth)) {
 			sizeError();
 		}
-		return MArrayDimensions {dims};
+		return MArrayDimensions {dims.begin(), dims.end()};
 	}
 } /* namespace LLU */
 
@@ -0,0 +1,138 @@
+/**
+ * @file	Interleaving.hpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Transforms between interleaved and planar layout of Image data, writing into caller-provided images.
+ */
+#ifndef LLU_CONTAINERS_INTERLEAVING_HPP
+#define LLU_CONTAINERS_INTERLEAVING_HPP
+
+#include <algorithm>
+
+#include "LLU/Containers/Interfaces.h"
+#include "LLU/ErrorLog/ErrorManager.h"
+
+namespace LLU {
+
+	namespace Detail {
+		/// Deinterleave pixels [first, last) with the number of channels known at compile time, so that the inner loop is fully unrolled
+		template<mint C, typename T>
+		void deinterleaveFixed(const T* __restrict src, T* __restrict dst, mint planeSize, mint first, mint last) noexcept {
+			for (mint p = first; p < last; ++p) {
+				for (mint c = 0; c < C; ++c) {
+					dst[c * planeSize + p] = src[p * C + c];
+				}
+			}
+		}
+
+		/// Interleave pixels [first, last) with the number of channels known at compile time
+		template<mint C, typename T>
+		void interleaveFixed(const T* __restrict src, T* __restrict dst, mint planeSize, mint first, mint last) noexcept {
+			for (mint p = first; p < last; ++p) {
+				for (mint c = 0; c < C; ++c) {
+					dst[p * C + c] = src[c * planeSize + p];
+				}
+			}
+		}
+
+		/**
+		 * @brief   Check that \p src and \p dst have the same shape and type, and the expected layouts
+		 * @return  number of pixels in a single channel plane
+		 * @throws  ErrorName::ImageTypeError - if the images have different types
+		 * @throws  ErrorName::ImageSizeError - if the images have different shapes or their layouts do not match the transform
+		 */
+		inline mint checkLayoutTransform(const ImageInterface& src, const ImageInterface& dst, bool fromInterleaved) {
+			if (src.type() != dst.type()) {
+				ErrorManager::throwException(ErrorName::ImageTypeError);
+			}
+			if (src.rows() != dst.rows() || src.columns() != dst.columns() || src.slices() != dst.slices() || src.channels() != dst.channels() ||
+				src.interleavedQ() != fromInterleaved || dst.interleavedQ() == fromInterleaved) {
+				ErrorManager::throwException(ErrorName::ImageSizeError);
+			}
+			return std::max(src.slices(), mint {1}) * src.rows() * src.columns();
+		}
+	}  // namespace Detail
+
+	/**
+	 * @brief   Move pixels [first, last) from interleaved to planar layout.
+	 * @details Images with 1 to 4 channels use loops specialized for the number of channels, which compilers turn into vector shuffles.
+	 * @param   src - interleaved data, i.e. channels of each pixel are adjacent
+	 * @param   dst - planar data, i.e. each channel is a contiguous plane of \p planeSize values, must not overlap with \p src
+	 * @param   planeSize - total number of pixels
+	 * @param   channels - number of channels
+	 * @param   first - index of the first pixel to be moved
+	 * @param   last - index past the last pixel to be moved
+	 */
+	template<typename T>
+	void deinterleaveRange(const T* src, T* dst, mint planeSize, mint channels, mint first, mint last) noexcept {
+		switch (channels) {
+			case 1: std::copy(src + first, src + last, dst + first); break;
+			case 2: Detail::deinterleaveFixed<2>(src, dst, planeSize, first, last); break;
+			case 3: Detail::deinterleaveFixed<3>(src, dst, planeSize, first, last); break;
+			case 4: Detail::deinterleaveFixed<4>(src, dst, planeSize, first, last); break;
+			default:
+				for (mint c = 0; c < channels; ++c) {
+					for (mint p = first; p < last; ++p) {
+						dst[c * planeSize + p] = src[p * channels + c];
+					}
+				}
+		}
+	}
+
+	/**
+	 * @brief   Move pixels [first, last) from planar to interleaved layout.
+	 * @param   src - planar data, i.e. each channel is a contiguous plane of \p planeSize values
+	 * @param   dst - interleaved data, i.e. channels of each pixel are adjacent, must not overlap with \p src
+	 * @param   planeSize - total number of pixels
+	 * @param   channels - number of channels
+	 * @param   first - index of the first pixel to be moved
+	 * @param   last - index past the last pixel to be moved
+	 */
+	template<typename T>
+	void interleaveRange(const T* src, T* dst, mint planeSize, mint channels, mint first, mint last) noexcept {
+		switch (channels) {
+			case 1: std::copy(src + first, src + last, dst + first); break;
+			case 2: Detail::interleaveFixed<2>(src, dst, planeSize, first, last); break;
+			case 3: Detail::interleaveFixed<3>(src, dst, planeSize, first, last); break;
+			case 4: Detail::interleaveFixed<4>(src, dst, planeSize, first, last); break;
+			default:
+				for (mint p = first; p < last; ++p) {
+					for (mint c = 0; c < channels; ++c) {
+						dst[p * channels + c] = src[c * planeSize + p];
+					}
+				}
+		}
+	}
+
+	/**
+	 * @brief   Copy an interleaved image to a planar image of the same shape and type.
+	 * @tparam  ImageIn - Image<T> or ImageTypedView<T>
+	 * @tparam  ImageOut - Image<T> or ImageTypedView<T>
+	 * @param   src - interleaved image
+	 * @param   dst - planar image, allocated by the caller, can be reused for every frame
+	 * @throws  ErrorName::ImageTypeError - if the images have different types
+	 * @throws  ErrorName::ImageSizeError - if the images have different shapes, \p src is not interleaved or \p dst is interleaved
+	 */
+	template<class ImageIn, class ImageOut>
+	void deinterleave(const ImageIn& src, ImageOut& dst) {
+		const auto planeSize = Detail::checkLayoutTransform(src, dst, true);
+		deinterleaveRange(src.data(), dst.data(), planeSize, src.channels(), 0, planeSize);
+	}
+
+	/**
+	 * @brief   Copy a planar image to an interleaved image of the same shape and type.
+	 * @tparam  ImageIn - Image<T> or ImageTypedView<T>
+	 * @tparam  ImageOut - Image<T> or ImageTypedView<T>
+	 * @param   src - planar image
+	 * @param   dst - interleaved image, allocated by the caller, can be reused for every frame
+	 * @throws  ErrorName::ImageTypeError - if the images have different types
+	 * @throws  ErrorName::ImageSizeError - if the images have different shapes, \p src is interleaved or \p dst is not interleaved
+	 */
+	template<class ImageIn, class ImageOut>
+	void interleave(const ImageIn& src, ImageOut& dst) {
+		const auto planeSize = Detail::checkLayoutTransform(src, dst, false);
+		interleaveRange(src.data(), dst.data(), planeSize, src.channels(), 0, planeSize);
+	}
+
+}  // namespace LLU
+
+#endif	  // LLU_CONTAINERS_INTERLEAVING_HPP
@@ -198,6 +198,81 @@ namespace LLU {
 		}
 	};
 
+
+	/**
+	 * @brief   Proxy input iterator over a DataList whose nodes are all known to hold values of type T, see DataList::tryAsHomogeneous
+	 * @details Values are read directly from the LibraryLink nodes, they never go through the TypedArgument variant and their types are not checked.
+	 * @tparam  T - data node type, see LLU::NodeType namespace for supported node types, must not be NodeType::Any
+	 */
+	template<typename T>
+	struct TypedValueIterator : Detail::DataListIteratorPrimitive {
+		static_assert(!std::is_same_v<T, Argument::Typed::Any>, "TypedValueIterator requires a concrete node type.");
+
+		/// This iterator iterates over node values of type T
+		using value_type = T;
+
+		/// TypedValueIterator is a proxy iterator and so the reference type is the same as value_type
+		using reference = value_type;
+
+		using DataListIteratorPrimitive::DataListIteratorPrimitive;
+
+		/**
+		 * Get value of the currently pointed to node
+		 * @return value of the currently pointed to node
+		 */
+		reference operator*() const {
+			return node.valueAs<Argument::WrapperIndex<T>>();
+		}
+
+		/**
+		 * Pre-increment operator
+		 * @return this
+		 */
+		TypedValueIterator& operator++() {
+			node = node.next();
+			return *this;
+		}
+
+		/**
+		 * Post-increment operator
+		 * @return "old" copy of the iterator object
+		 */
+		TypedValueIterator operator++(int) {
+			TypedValueIterator tmp {node.node};
+			++(*this);
+			return tmp;
+		}
+	};
+
+	/**
+	 * @brief   Non-owning, lazily evaluated range of DataList nodes, names or values, given by a pair of proxy iterators
+	 * @details Nothing is copied when the range is created or iterated over. Names and string values are returned as std::string_view
+	 *          pointing to memory owned by the DataStore, so they must not outlive the DataList.
+	 * @tparam  Iterator - one of the DataList proxy iterators
+	 */
+	template<typename Iterator>
+	struct NodeRange {
+		/// Iterator to the first element of the range
+		Iterator first;
+
+		/// Iterator past the last element of the range
+		Iterator last;
+
+		/// Get iterator to the first element of the range
+		Iterator begin() const {
+			return first;
+		}
+
+		/// Get iterator past the last element of the range
+		Iterator end() const {
+			return last;
+		}
+
+		/// Check if the range is empty
+		bool empty() const {
+			return first == last;
+		}
+	};
 }	 // namespace LLU
 
 #endif	  // LLU_CONTAINERS_ITERATORS_DATALIST_HPP
@@ -56,6 +56,15 @@ namespace LLU {
 		template<typename T>
 		T as() const;
 
+		// defined in Containers/Generic/DataStore.hpp
+		/**
+		 * Get node value assuming that it is of type Type, without checking the type and without creating a TypedArgument.
+		 * @tparam Type - type of the node value, it must be the actual type of the node
+		 * @return node value converted to its wrapper type, containers are wrappers that do not own their data
+		 */
+		template<MArgumentType Type>
+		Argument::WrapperType<Type> valueAs() const;
+
 		/**
 		 * Bool conversion operator
 		 * @return true iff the node is not null
@@ -115,7 +124,7 @@ namespace LLU {
 		 * @return this
 		 */
 		DataStoreIterator& operator++() {
-			node = LLU::LibraryData::DataStoreAPI()->DataStoreNode_getNextNode(node);
+			node = LLU::LibraryData::uncheckedDataStoreAPI()->DataStoreNode_getNextNode(node);
 			return *this;
 		}
 
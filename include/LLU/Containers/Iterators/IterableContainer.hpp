@@ -6,6 +6,9 @@
 #ifndef LLU_CONTAINERS_ITERATORS_ITERABLECONTAINER_HPP
 #define LLU_CONTAINERS_ITERATORS_ITERABLECONTAINER_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <vector>
 
@@ -14,6 +17,10 @@
 namespace LLU {
 	/**
 	 * @brief   Abstract class that provides iterators (c/r/begin and c/r/end methods) and subscript operator for any contiguous container
+	 *
+	 * The data pointer and the number of elements are obtained from the derived class (which typically asks LibraryLink for them) on first
+	 * use and then cached, so that element access and iteration in tight loops do not perform any virtual calls.
+	 *
 	 * @tparam  T - underlying data type
 	 */
 	template<typename T>
@@ -42,69 +49,95 @@ namespace LLU {
 
 	public:
 		// Provide special member functions
+		IterableContainer() = default;
+
+		/// Copies do not share the cache, the data of a copy is obtained from the derived class again
+		IterableContainer(const IterableContainer& /*other*/) noexcept {}
+
+		/// Moving transfers the cache together with the data, the moved-from container forgets it
+		IterableContainer(IterableContainer&& other) noexcept : dataCache {other.dataCache}, sizeCache {other.sizeCache} {
+			other.invalidateCache();
+		}
+
+		/// Copy-assignment invalidates the cache, because the derived class replaces the data
+		IterableContainer& operator=(const IterableContainer& /*other*/) noexcept {
+			invalidateCache();
+			return *this;
+		}
+
+		/// Move-assignment transfers the cache together with the data, the moved-from container forgets it
+		IterableContainer& operator=(IterableContainer&& other) noexcept {
+			if (this != &other) {
+				dataCache = other.dataCache;
+				sizeCache = other.sizeCache;
+				other.invalidateCache();
+			}
+			return *this;
+		}
+
 		virtual ~IterableContainer() = default;
 
 		/**
 		 *	@brief Get raw pointer to underlying data
 		 **/
 		value_type* data() noexcept {
-			return getData();
+			return cachedData();
 		}
 
 		/**
 		 *	@brief Get raw pointer to const underlying data
 		 **/
 		const value_type* data() const noexcept {
-			return getData();
+			return cachedData();
 		}
 
 		/**
 		 *	@brief Get total number of elements in the container
 		 **/
 		mint size() const noexcept {
-			return getSize();
+			return cachedSize();
 		}
 
 		/**
 		 *	@brief Get iterator at the beginning of underlying data
 		 **/
 		iterator begin() noexcept {
-			return getData();
+			return cachedData();
 		}
 
 		/**
 		 *	@brief Get constant iterator at the beginning of underlying data
 		 **/
 		const_iterator begin() const noexcept {
-			return getData();
+			return cachedData();
 		}
 
 		/**
 		 *	@brief Get constant iterator at the beginning of underlying data
 		 **/
 		const_iterator cbegin() const noexcept {
-			return getData();
+			return cachedData();
 		}
 
 		/**
 		 *	@brief Get iterator after the end of underlying data
 		 **/
 		iterator end() noexcept {
-			return std::next(begin(), getSize());
+			return std::next(begin(), cachedSize());
 		}
 
 		/**
 		 *	@brief Get constant iterator after the end of underlying data
 		 **/
 		const_iterator end() const noexcept {
-			return std::next(begin(), getSize());
+			return std::next(begin(), cachedSize());
 		}
 
 		/**
 		 *	@brief Get constant iterator after the end of underlying data
 		 **/
 		const_iterator cend() const noexcept {
-			return std::next(cbegin(), getSize());
+			return std::next(cbegin(), cachedSize());
 		}
 
 		/**
@@ -197,6 +230,59 @@ namespace LLU {
 			return *(cend() - 1);
 		}
 
+		/**
+		 * @brief   Get the actual alignment of the data, i.e. the largest power of 2 that divides the address of the first element
+		 * @return  alignment in bytes, or 0 for containers without data
+		 * @note    LibraryLink allocates the memory of Tensors, NumericArrays and Images, so LLU cannot guarantee any alignment beyond alignof(T).
+		 */
+		[[nodiscard]] std::size_t alignment() const noexcept {
+			auto address = reinterpret_cast<std::uintptr_t>(cachedData());
+			return static_cast<std::size_t>(address & (~address + 1));
+		}
+
+		/// Check whether the data is aligned to \p Alignment bytes
+		template<std::size_t Alignment>
+		[[nodiscard]] bool alignedQ() const noexcept {
+			static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2.");
+			return reinterpret_cast<std::uintptr_t>(cachedData()) % Alignment == 0;
+		}
+
+		/**
+		 * @brief   Get the number of leading elements that have to be processed before the first element aligned to \p Alignment bytes
+		 * @return  number of elements to peel, or size() if no element is aligned
+		 */
+		template<std::size_t Alignment>
+		[[nodiscard]] mint peelCount() const noexcept {
+			static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2.");
+			auto misalignment = reinterpret_cast<std::uintptr_t>(cachedData()) % Alignment;
+			if (misalignment == 0) {
+				return 0;
+			}
+			auto gap = Alignment - misalignment;
+			if (gap % sizeof(T) != 0) {
+				return cachedSize();
+			}
+			return std::min(static_cast<mint>(gap / sizeof(T)), cachedSize());
+		}
+
+		/**
+		 * @brief   Get raw pointer to underlying data and tell the compiler that it is aligned to \p Alignment bytes, which allows aligned vector loads
+		 * @pre     alignedQ<Alignment>() must be true, otherwise the behavior is undefined
+		 */
+		template<std::size_t Alignment>
+		[[nodiscard]] value_type* assumeAligned() noexcept {
+			return assumeAlignedImpl<Alignment>(cachedData());
+		}
+
+		/**
+		 * @brief   Get raw pointer to const underlying data and tell the compiler that it is aligned to \p Alignment bytes
+		 * @pre     alignedQ<Alignment>() must be true, otherwise the behavior is undefined
+		 */
+		template<std::size_t Alignment>
+		[[nodiscard]] const value_type* assumeAligned() const noexcept {
+			return assumeAlignedImpl<Alignment>(cachedData());
+		}
+
 		/**
 		 * Copy contents of the data to a std::vector of matching type
 		 * @return	std::vector with the copy of the data
@@ -205,7 +291,48 @@ namespace LLU {
 			return std::vector<value_type> {cbegin(), cend()};
 		}
 
+	protected:
+		/**
+		 *	@brief	Forget the cached data pointer and length, derived classes must call it whenever they replace the underlying data
+		 **/
+		void invalidateCache() const noexcept {
+			dataCache = nullptr;
+			sizeCache = -1;
+		}
+
 	private:
+		/// Data pointer obtained from getData(), nullptr if not known yet
+		mutable T* dataCache = nullptr;
+
+		/// Number of elements obtained from getSize(), negative if not known yet
+		mutable mint sizeCache = -1;
+
+		template<std::size_t Alignment>
+		static T* assumeAlignedImpl(T* p) noexcept {
+			static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2.");
+#if defined(__GNUC__) || defined(__clang__)
+			return static_cast<T*>(__builtin_assume_aligned(p, Alignment));
+#else
+			return p;
+#endif
+		}
+
+		/// Get the data pointer, asking the derived class only if it is not cached
+		T* cachedData() const noexcept {
+			if (!dataCache) {
+				dataCache = getData();
+			}
+			return dataCache;
+		}
+
+		/// Get the number of elements, asking the derived class only if it is not cached
+		mint cachedSize() const noexcept {
+			if (sizeCache < 0) {
+				sizeCache = getSize();
+			}
+			return sizeCache;
+		}
+
 		/**
 		 *	@brief	Get raw pointer to underlying data
 		 **/
@@ -9,6 +9,8 @@
 #ifndef LLU_CONTAINERS_MARRAY_HPP_
 #define LLU_CONTAINERS_MARRAY_HPP_
 
+#include <array>
+#include <cstddef>
 #include <initializer_list>
 #include <ostream>
 #include <type_traits>
@@ -17,11 +19,44 @@
 
 #include "LLU/Containers/Iterators/IterableContainer.hpp"
 #include "LLU/Containers/MArrayDimensions.h"
+#include "LLU/Containers/Views/Strided.hpp"
 #include "LLU/LibraryData.h"
 #include "LLU/Utilities.hpp"
 
 namespace LLU {
 
+	/// Tag type for constructors of Tensor, NumericArray and Image which do not initialize the elements
+	struct Uninitialized_t {
+		explicit Uninitialized_t() = default;
+	};
+
+	/**
+	 * @brief   Tag for constructors of Tensor, NumericArray and Image which do not initialize the elements.
+	 * @details LLU does not write to the memory at all. Use it when every element is going to be overwritten anyway, for instance with
+	 * Async::fill, which touches the memory from worker threads.
+	 */
+	inline constexpr Uninitialized_t Uninitialized {};
+
+	/// A type trait to check whether \p F can fill a buffer of \p T, either as f(T* data, mint length) or element-wise as T f(mint index)
+	template<typename F, typename T>
+	inline constexpr bool is_producer_v = std::is_invocable_v<F&, T*, mint> || std::is_invocable_r_v<T, F&, mint>;
+
+	/// @cond
+	namespace Detail {
+		/// Write \p length elements produced by \p f to \p data
+		template<typename T, typename F>
+		void produceInto(T* data, mint length, F& f) {
+			if constexpr (std::is_invocable_v<F&, T*, mint>) {
+				f(data, length);
+			} else {
+				for (mint i = 0; i < length; ++i) {
+					data[i] = f(i);
+				}
+			}
+		}
+	}  // namespace Detail
+	/// @endcond
+
 	/**
 	 * @class MArray
 	 * @brief This is a class template, where template parameter T is the type of data elements. MArray is the base class for NumericArray, Tensor and Image.
@@ -100,6 +135,43 @@ namespace LLU {
 			return (*this)[dims.getIndex(indices)];
 		}
 
+		/**
+		 *	@brief 		Get a reference to the data element at given position in a multidimensional container, e.g. \c t(i, j, k)
+		 *	@details	Unlike operator[] with a vector of indices, this does not allocate memory, so it is well suited for inner loops.
+		 *	@param[in]	indices - coordinates of desired data element
+		 **/
+		template<typename... Indices, typename = enable_if_integral_indices<Indices...>>
+		T& operator()(Indices... indices) {
+			return (*this)[dims.getIndex(indices...)];
+		}
+
+		/**
+		 *	@brief 		Get a constant reference to the data element at given position in a multidimensional container, e.g. \c t(i, j, k)
+		 *	@param[in]	indices - coordinates of desired data element
+		 **/
+		template<typename... Indices, typename = enable_if_integral_indices<Indices...>>
+		const T& operator()(Indices... indices) const {
+			return (*this)[dims.getIndex(indices...)];
+		}
+
+		/**
+		 *	@brief 		Get a reference to the data element at given position in a multidimensional container
+		 *	@param[in]	indices - array with coordinates of desired data element
+		 **/
+		template<std::size_t N>
+		T& operator[](const std::array<mint, N>& indices) {
+			return (*this)[dims.getIndex(indices)];
+		}
+
+		/**
+		 *	@brief 		Get a constant reference to the data element at given position in a multidimensional container
+		 *	@param[in]	indices - array with coordinates of desired data element
+		 **/
+		template<std::size_t N>
+		const T& operator[](const std::array<mint, N>& indices) const {
+			return (*this)[dims.getIndex(indices)];
+		}
+
 		/**
 		 *	@brief 		Get a reference to the data element at given position with bound checking
 		 *	@param[in]	index - position of desired data element
@@ -128,6 +200,61 @@ namespace LLU {
 		 **/
 		const T& at(const std::vector<mint>& indices) const;
 
+		/**
+		 *	@brief 		Get a reference to the data element at given coordinates with bound checking, e.g. \c t.at(i, j, k)
+		 *	@param[in]	indices - at least two coordinates of desired data element, a single index is treated as a position in the flat list of elements
+		 *	@throws		indexError() - if \p indices are out-of-bounds
+		 **/
+		template<typename... Indices, typename = std::enable_if_t<(sizeof...(Indices) > 1)>, typename = enable_if_integral_indices<Indices...>>
+		T& at(Indices... indices) {
+			return (*this)[dims.getIndexChecked(indices...)];
+		}
+
+		/**
+		 *	@brief 		Get a constant reference to the data element at given coordinates with bound checking, e.g. \c t.at(i, j, k)
+		 *	@param[in]	indices - at least two coordinates of desired data element, a single index is treated as a position in the flat list of elements
+		 *	@throws		indexError() - if \p indices are out-of-bounds
+		 **/
+		template<typename... Indices, typename = std::enable_if_t<(sizeof...(Indices) > 1)>, typename = enable_if_integral_indices<Indices...>>
+		const T& at(Indices... indices) const {
+			return (*this)[dims.getIndexChecked(indices...)];
+		}
+
+		/**
+		 *	@brief 		Get a reference to the data element at given position in a multidimensional container with bound checking
+		 *	@param[in]	indices - array with coordinates of desired data element
+		 *	@throws		indexError() - if \p indices are out-of-bounds
+		 **/
+		template<std::size_t N>
+		T& at(const std::array<mint, N>& indices) {
+			return (*this)[dims.getIndexChecked(indices)];
+		}
+
+		/**
+		 *	@brief 		Get a constant reference to the data element at given position in a multidimensional container with bound checking
+		 *	@param[in]	indices - array with coordinates of desired data element
+		 *	@throws		indexError() - if \p indices are out-of-bounds
+		 **/
+		template<std::size_t N>
+		const T& at(const std::array<mint, N>& indices) const {
+			return (*this)[dims.getIndexChecked(indices)];
+		}
+
+		/**
+		 *	@brief 		Get a non-owning strided view of the whole container, which can be sliced, restricted or transposed without copying data
+		 *	@note		The view is invalidated when the container is destroyed or its data is reallocated.
+		 **/
+		StridedView<T> view() {
+			return StridedView<T> {this->data(), dims};
+		}
+
+		/**
+		 *	@brief 		Get a read-only non-owning strided view of the whole container
+		 **/
+		StridedView<const T> view() const {
+			return StridedView<const T> {this->data(), dims};
+		}
+
 	private:
 		/// Dimensions of the array
 		MArrayDimensions dims;
@@ -6,16 +6,25 @@
 #ifndef LLU_CONTAINERS_MARRAYDIMENSIONS_H_
 #define LLU_CONTAINERS_MARRAYDIMENSIONS_H_
 
+#include <array>
+#include <cstddef>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
+#include <numeric>
 #include <type_traits>
 #include <vector>
 
+#include "LLU/Containers/SmallVector.hpp"
 #include "LLU/ErrorLog/ErrorManager.h"
 #include "LLU/LibraryData.h"
 #include "LLU/Utilities.hpp"
 
 namespace LLU {
 
+	/// Storage for a list of dimensions, offsets or strides of a container. Containers of rank up to 4 do not need heap memory.
+	using DimensionsVector = SmallVector<mint, 4>;
+
 	/**
 	 * @class MArrayDimensions
 	 * @brief Helper class that carries meta-information about container's size and dimensions.
@@ -81,9 +90,18 @@ namespace LLU {
 		}
 
 		/**
-		 *	@brief Get container dimensions in the form of const& to \b std::vector
+		 *	@brief 		Get a copy of container dimensions in the form of \b std::vector
+		 *	@deprecated	Unlike in previous versions, this returns a copy and allocates memory. Use getDimensionsVector() to avoid the copy,
+		 *				or data() and rank().
+		 **/
+		[[deprecated("MArrayDimensions::get() returns a copy, use getDimensionsVector() instead")]] std::vector<mint> get() const {
+			return dims.asVector();
+		}
+
+		/**
+		 *	@brief Get container dimensions without copying them
 		 **/
-		const std::vector<mint>& get() const noexcept {
+		const DimensionsVector& getDimensionsVector() const noexcept {
 			return dims;
 		}
 
@@ -112,6 +130,60 @@ namespace LLU {
 		 **/
 		mint getIndexChecked(const std::vector<mint>& indices) const;
 
+		/**
+		 *	@brief 		Convert coordinates of an element to the corresponding index in a flat list of elements, without allocating memory
+		 *	@tparam		N - number of coordinates, known at compile time so that the computation can be fully unrolled
+		 *	@param[in]	indices - array with coordinates of desired data element
+		 **/
+		template<std::size_t N>
+		mint getIndex(const std::array<mint, N>& indices) const noexcept {
+			mint flatIndex = 0;
+			for (std::size_t d = 0; d < N; ++d) {
+				flatIndex += indices[d] * offsets[d];
+			}
+			return flatIndex;
+		}
+
+		/**
+		 *	@brief 		Convert coordinates of an element to the corresponding index in a flat list of elements, e.g. \c getIndex(i, j, k)
+		 *	@tparam		Indices - integral types of the coordinates
+		 *	@param[in]	indices - coordinates of desired data element
+		 **/
+		template<typename... Indices, typename = enable_if_integral_indices<Indices...>>
+		mint getIndex(Indices... indices) const noexcept {
+			return getIndex(std::array<mint, sizeof...(Indices)> {{static_cast<mint>(indices)...}});
+		}
+
+		/**
+		 *	@brief 		Check if given coordinates are valid for this container and convert them to the index in a flat list of elements
+		 *	@tparam		N - number of coordinates
+		 *	@param[in]	indices - array with coordinates of desired data element
+		 *	@throws		indexError() - if \c indices are out-of-bounds
+		 **/
+		template<std::size_t N>
+		mint getIndexChecked(const std::array<mint, N>& indices) const {
+			if (N > dims.size()) {
+				ErrorManager::throwException(ErrorName::MArrayDimensionIndexError, static_cast<wsint64>(N));
+			}
+			for (std::size_t d = 0; d < N; ++d) {
+				if (indices[d] < 0 || indices[d] >= dims[d]) {
+					ErrorManager::throwException(ErrorName::MArrayElementIndexError, indices[d]);
+				}
+			}
+			return getIndex(indices);
+		}
+
+		/**
+		 *	@brief 		Check if given coordinates are valid for this container and convert them to the index in a flat list of elements
+		 *	@tparam		Indices - integral types of the coordinates, at least two of them (a single index is a position in the flat list of elements)
+		 *	@param[in]	indices - coordinates of desired data element
+		 *	@throws		indexError() - if \c indices are out-of-bounds
+		 **/
+		template<typename... Indices, typename = std::enable_if_t<(sizeof...(Indices) > 1)>, typename = enable_if_integral_indices<Indices...>>
+		mint getIndexChecked(Indices... indices) const {
+			return getIndexChecked(std::array<mint, sizeof...(Indices)> {{static_cast<mint>(indices)...}});
+		}
+
 		/**
 		 * @brief   Check if given index is valid i.e. it does not exceed container bounds
 		 * @param   index - index of the desired element
@@ -132,10 +204,10 @@ namespace LLU {
 		mint flattenedLength = 1;
 
 		/// Container dimensions
-		std::vector<mint> dims;
+		DimensionsVector dims;
 
 		/// This helps to convert coordinates \f$ (x_1, \ldots, x_n) \f$ in multidimensional MArray to the corresponding index in a flat list of elements
-		std::vector<mint> offsets;
+		DimensionsVector offsets;
 
 		/// Populate \c offsets member
 		void fillOffsets();
@@ -155,6 +227,74 @@ namespace LLU {
 		static constexpr std::size_t MAX_DIM = static_cast<std::size_t>((std::numeric_limits<mint>::max)());
 	};
 
+	/**
+	 * @brief   Non-owning view of the dimensions of a container, e.g. of the array returned by MNumericArray_getDimensions.
+	 *
+	 * Unlike MArrayDimensions it neither copies the dimensions nor computes offsets, so it is free to create. It provides the read-only part
+	 * of the MArrayDimensions interface, so generic code can work with both. The view is valid as long as the container it was taken from.
+	 */
+	class DimensionsView {
+	public:
+		DimensionsView() = default;
+
+		/**
+		 * @brief   Create a view of \p rank dimensions starting at \p dimensions
+		 * @param   dimensions - pointer to the first dimension, may be nullptr if \p rank is 0
+		 * @param   rank - number of dimensions
+		 */
+		DimensionsView(const mint* dimensions, mint rank) noexcept : dims {dimensions}, count {rank} {}
+
+		/// Get the number of dimensions
+		mint rank() const noexcept {
+			return count;
+		}
+
+		/// Get a pointer to the first dimension
+		const mint* data() const noexcept {
+			return dims;
+		}
+
+		/// Get an iterator to the first dimension
+		const mint* begin() const noexcept {
+			return dims;
+		}
+
+		/// Get an iterator past the last dimension
+		const mint* end() const noexcept {
+			return std::next(dims, count);
+		}
+
+		/// Get the dimension at position \p dim without bounds checking
+		mint operator[](mint dim) const noexcept {
+			return dims[dim];
+		}
+
+		/**
+		 * @brief   Get the dimension at position \p dim
+		 * @throws  ErrorName::MArrayDimensionIndexError - if \p dim is out of range
+		 */
+		mint get(mint dim) const {
+			if (dim >= rank() || dim < 0) {
+				ErrorManager::throwException(ErrorName::MArrayDimensionIndexError, dim);
+			}
+			return dims[dim];
+		}
+
+		/// Get the total number of elements, computed on every call
+		mint flatCount() const noexcept {
+			return std::accumulate(begin(), end(), mint {1}, std::multiplies<> {});
+		}
+
+		/// Copy the dimensions to MArrayDimensions, e.g. to create a new container of the same shape
+		MArrayDimensions toDimensions() const {
+			return MArrayDimensions {dims, count};
+		}
+
+	private:
+		const mint* dims = nullptr;
+		mint count = 0;
+	};
+
 	template<typename T, typename>
 	MArrayDimensions::MArrayDimensions(const T* dimensions, mint rank) : MArrayDimensions(dimensions, std::next(dimensions, rank)) {}
 
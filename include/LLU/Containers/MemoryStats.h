@@ -0,0 +1,121 @@
+/**
+ * @file	MemoryStats.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Optional accounting of memory held in containers owned by the library.
+ */
+#ifndef LLU_CONTAINERS_MEMORYSTATS_H
+#define LLU_CONTAINERS_MEMORYSTATS_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "LLU/MArgument.h"
+
+namespace LLU {
+
+	/**
+	 * Whether LLU counts the memory of containers owned by the library. Define LLU_MEMORY_STATS to enable the accounting, otherwise it is
+	 * compiled out and getMemoryStats only reports zeros.
+	 * @note The flag must have the same value in all translation units of a paclet.
+	 */
+#ifdef LLU_MEMORY_STATS
+	inline constexpr bool memoryStatsEnabled = true;
+#else
+	inline constexpr bool memoryStatsEnabled = false;
+#endif
+
+	/// Memory held in a group of containers
+	struct MemoryUsage {
+		/// Bytes of data in containers currently owned by the library
+		std::int64_t liveBytes = 0;
+		/// Highest value of liveBytes since the statistics were reset
+		std::int64_t peakBytes = 0;
+		/// Number of containers currently owned by the library
+		std::int64_t liveCount = 0;
+		/// Number of containers that the library took ownership of since the statistics were reset
+		std::int64_t totalCount = 0;
+	};
+
+	/// Snapshot of the memory accounting
+	struct MemoryStatsSnapshot {
+		/// Usage summed over all containers, its peak is the peak of the sum, not the sum of the peaks
+		MemoryUsage total;
+		/// Usage per container type: "Tensor", "NumericArray", "Image", "SparseArray" and "DataStore"
+		std::map<std::string, MemoryUsage> containers;
+		/// Usage per allocation-site tag, see MemoryStats::Tag, containers created outside of any tag are under "Untagged"
+		std::map<std::string, MemoryUsage> tags;
+	};
+
+	/**
+	 * @class   MemoryStats
+	 * @brief   Registry of containers owned by the library, with the number of bytes that each of them holds.
+	 *
+	 * When LLU_MEMORY_STATS is defined, MContainerBase registers every container the library takes ownership of, by creating it or with reset,
+	 * and removes it when the container is freed or the ownership passes to LibraryLink, e.g. when it is returned from a library function.
+	 * The size of a container is measured when it is registered. DataStores are measured again when they are released and when a snapshot
+	 * is taken, because nodes can be added to them, so the peak may miss the moments when a DataList was largest before it was released.
+	 * Only the data of the containers is counted, not the headers kept by LibraryLink.
+	 */
+	class MemoryStats {
+	public:
+		/**
+		 * @class   Tag
+		 * @brief   Attributes containers that the current thread acquires during the lifetime of the Tag to an allocation site, e.g. a stage of the paclet.
+		 * @note    The name is not copied, it must stay valid until the library is unloaded, like a string literal. Tags can be nested,
+		 * the innermost one applies.
+		 */
+		class Tag {
+		public:
+			explicit Tag(const char* name) noexcept;
+			Tag(const Tag&) = delete;
+			Tag& operator=(const Tag&) = delete;
+			~Tag();
+
+		private:
+			const char* previous;
+		};
+
+		/**
+		 * Register a container owned by the library, called by MContainerBase
+		 * @param type - type of the container
+		 * @param container - raw LibraryLink container (MTensor, MNumericArray, etc.)
+		 */
+		static void acquire(MArgumentType type, const void* container) noexcept;
+
+		/**
+		 * Remove a container from the registry, called by MContainerBase. Containers that are not registered are ignored.
+		 * @param container - raw LibraryLink container (MTensor, MNumericArray, etc.)
+		 */
+		static void release(const void* container) noexcept;
+
+		/// Get the current and peak usage
+		static MemoryStatsSnapshot snapshot();
+
+		/// Set all peaks to the current usage and the total counts to the current counts, to find the peak of the next stage
+		static void reset() noexcept;
+
+		/**
+		 * Get the number of bytes of data in a LibraryLink container, nested containers in a DataStore are included
+		 * @param type - type of the container
+		 * @param container - raw LibraryLink container (MTensor, MNumericArray, etc.)
+		 * @return number of bytes, or 0 if the container is null or LibraryData is not available
+		 */
+		static std::int64_t bytesOf(MArgumentType type, const void* container) noexcept;
+	};
+
+}  // namespace LLU
+
+/**
+ * @def     LLU_MEMORY_TAG(name)
+ * Attribute containers acquired in the rest of the enclosing block to the allocation-site tag \p name. Expands to nothing without LLU_MEMORY_STATS.
+ */
+#ifdef LLU_MEMORY_STATS
+#define LLU_MEMORY_TAG_CONCAT_IMPL(a, b) a##b
+#define LLU_MEMORY_TAG_CONCAT(a, b) LLU_MEMORY_TAG_CONCAT_IMPL(a, b)
+#define LLU_MEMORY_TAG(name) const LLU::MemoryStats::Tag LLU_MEMORY_TAG_CONCAT(llu_memoryTag_, __LINE__) {name}
+#else
+#define LLU_MEMORY_TAG(name) static_cast<void>(0)
+#endif
+
+#endif	  // LLU_CONTAINERS_MEMORYSTATS_H
@@ -35,7 +35,7 @@ namespace LLU {
 		 *   @return  raw pointer to values of type \p T - contents of the NumericArray
 		 **/
 		T* getData() const noexcept override {
-			return static_cast<T*>(LibraryData::NumericArrayAPI()->MNumericArray_getData(this->getInternal()));
+			return static_cast<T*>(LibraryData::uncheckedNumericArrayAPI()->MNumericArray_getData(this->getInternal()));
 		}
 
 		virtual MNumericArray getInternal() const = 0;
@@ -99,6 +99,25 @@ namespace LLU {
 		 **/
 		NumericArray(T init, MArrayDimensions dims);
 
+		/**
+		 *   @brief         Constructs the NumericArray of given shape without initializing the elements
+		 *   @param[in]     dims - container with NumericArray dimensions
+		 *   @note			The contents are whatever MNumericArray_new leaves in the memory and should be overwritten before use.
+		 **/
+		NumericArray(Uninitialized_t, MArrayDimensions dims);
+
+		/**
+		 *   @brief         Constructs the NumericArray of given shape with elements written directly by \p producer
+		 *   @param[in]     dims - dimensions of the NumericArray
+		 *   @param[in]     producer - either a function f(T* data, mint length) that fills the whole buffer, or a function T f(mint index)
+		 *   				that returns the element at given flat index
+		 *   @note			Data is written once, straight into LibraryLink memory, without an intermediate container.
+		 **/
+		template<class F, typename = std::enable_if_t<is_producer_v<F, T>>>
+		NumericArray(MArrayDimensions dims, F&& producer) : NumericArray(Uninitialized, std::move(dims)) {
+			Detail::produceInto(this->data(), this->size(), producer);
+		}
+
 		/**
 		 *   @brief         Constructs the NumericArray of given shape with elements from range [first, last)
 		 *   @param[in]     first - iterator to the beginning of range
@@ -170,6 +189,10 @@ namespace LLU {
 		std::fill(this->begin(), this->end(), init);
 	}
 
+	template<typename T>
+	NumericArray<T>::NumericArray(Uninitialized_t, MArrayDimensions dims)
+		: TypedNumericArray<T>(std::move(dims)), GenericBase(NumericArrayType<T>, this->rank(), this->dimensions().data()) {}
+
 	template<typename T>
 	template<class InputIt, typename>
 	NumericArray<T>::NumericArray(InputIt first, InputIt last, MArrayDimensions dims)
@@ -0,0 +1,450 @@
+/**
+ * @file	NumericArrayIO.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief	Functions that load binary and text files of numbers directly into a NumericArray, reading the file in parallel chunks, and a streaming
+ * 			writer of container data to binary files.
+ */
+#ifndef LLU_CONTAINERS_NUMERICARRAYIO_H
+#define LLU_CONTAINERS_NUMERICARRAYIO_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "LLU/Async/Algorithms.h"
+#include "LLU/Async/SharedPool.h"
+#include "LLU/Async/TaskGroup.h"
+#include "LLU/Containers/NumericArray.h"
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/FileUtilities.h"
+
+namespace LLU {
+
+	/// Order of bytes of numbers stored in a binary file
+	enum class ByteOrder {
+		Native,			///< the same as on the machine that reads the file
+		LittleEndian,	///< least significant byte first
+		BigEndian		///< most significant byte first
+	};
+
+	/// Options of readBinaryFile
+	struct BinaryReadOptions {
+		/// Position of the first number in the file, in bytes
+		std::uint64_t offset = 0;
+		/// Byte order of numbers in the file
+		ByteOrder byteOrder = ByteOrder::Native;
+		/// Number of bytes read by a single task
+		std::size_t chunkSize = std::size_t {8} << 20U;
+		/// Whether chunks are read in parallel on Async::sharedPool()
+		bool parallel = true;
+	};
+
+	/// Options of readTextFile
+	struct TextReadOptions {
+		/// Approximate number of bytes parsed by a single task, chunks always end at a separator
+		std::size_t chunkSize = std::size_t {1} << 20U;
+		/// Whether chunks are parsed in parallel on Async::sharedPool()
+		bool parallel = true;
+	};
+
+	/// Options of BinaryFileWriter
+	struct BinaryWriteOptions {
+		/// Size of each of the two buffers in bytes, rounded up to a multiple of directIOAlignment
+		std::size_t bufferSize = std::size_t {8} << 20U;
+		/// Whether to bypass the OS page cache (O_DIRECT on Linux, F_NOCACHE on macOS, FILE_FLAG_NO_BUFFERING on Windows) if the file system allows it
+		bool directIO = false;
+		/// Whether full buffers are written to the file by a task on Async::sharedPool(), while the caller fills the other buffer
+		bool asyncFlush = true;
+		/// Whether to append to an existing file instead of truncating it
+		bool append = false;
+	};
+
+	/// Alignment of buffers, file offsets and write sizes required by unbuffered I/O
+	inline constexpr std::size_t directIOAlignment = 4096;
+
+	namespace Detail {
+		/// File opened for reading at arbitrary positions from multiple threads at the same time
+		class PositionalFile {
+		public:
+			/**
+			 * Open the file, after checking the path with validatePath
+			 * @throw ErrorName::OpenFileFailed if the file could not be opened
+			 */
+			explicit PositionalFile(std::string fileName);
+
+			PositionalFile(const PositionalFile&) = delete;
+			PositionalFile& operator=(const PositionalFile&) = delete;
+
+			~PositionalFile();
+
+			/// Get the size of the file in bytes
+			[[nodiscard]] std::uint64_t size() const;
+
+			/**
+			 * Read exactly \p count bytes starting at \p offset (pread on POSIX, ReadFile with an offset on Windows)
+			 * @throw ErrorName::ReadFileFailed if fewer bytes could be read
+			 */
+			void read(void* buffer, std::size_t count, std::uint64_t offset) const;
+
+		private:
+			std::string name;
+			std::intptr_t handle;
+		};
+
+		/// File opened for writing at arbitrary positions, optionally with unbuffered I/O
+		class OutputFile {
+		public:
+			/**
+			 * Open or create the file, after checking the path with validatePath
+			 * @throw ErrorName::OpenFileFailed if the file could not be opened
+			 */
+			OutputFile(std::string fileName, bool append, bool directIO);
+
+			OutputFile(const OutputFile&) = delete;
+			OutputFile& operator=(const OutputFile&) = delete;
+
+			~OutputFile();
+
+			/// Get the size of the file at the moment it was opened, which is where appending starts
+			[[nodiscard]] std::uint64_t initialSize() const noexcept {
+				return startSize;
+			}
+
+			/// Check if writes must be aligned to directIOAlignment, which is the case when unbuffered I/O is on and the platform requires it
+			[[nodiscard]] bool requiresAlignment() const noexcept {
+				return aligned;
+			}
+
+			/// Turn unbuffered I/O off, so that the remaining data can be written at unaligned offsets and sizes
+			void disableDirectIO();
+
+			/**
+			 * Write exactly \p count bytes starting at \p offset (pwrite on POSIX, WriteFile with an offset on Windows)
+			 * @throw ErrorName::WriteFileFailed if the data could not be written
+			 */
+			void write(const void* buffer, std::size_t count, std::uint64_t offset) const;
+
+			/**
+			 * Close the file and report errors of deferred writes
+			 * @throw ErrorName::WriteFileFailed if closing failed
+			 */
+			void close();
+
+		private:
+			std::string name;
+			std::intptr_t handle;
+			std::uint64_t startSize = 0;
+			bool aligned = false;
+			bool isOpen = true;
+		};
+
+		/// Deleter of buffers allocated with AlignedBuffer
+		struct AlignedDelete {
+			void operator()(std::byte* p) const noexcept {
+				::operator delete[](p, std::align_val_t {directIOAlignment});
+			}
+		};
+
+		/// Buffer of bytes aligned to directIOAlignment
+		using AlignedBuffer = std::unique_ptr<std::byte[], AlignedDelete>;
+
+		/// Allocate an uninitialized AlignedBuffer of \p bytes bytes
+		inline AlignedBuffer makeAlignedBuffer(std::size_t bytes) {
+			return AlignedBuffer {static_cast<std::byte*>(::operator new[](bytes, std::align_val_t {directIOAlignment}))};
+		}
+
+		/// Check if the byte order of numbers in a file differs from the byte order of the machine
+		bool needsByteSwap(ByteOrder order) noexcept;
+
+		/// Reverse the order of bytes in every element of an array
+		template<typename T>
+		void swapBytes(T* data, std::size_t count) noexcept {
+			if constexpr (sizeof(T) > 1) {
+				auto* bytes = reinterpret_cast<unsigned char*>(data);	 // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+				for (std::size_t i = 0; i < count; ++i, bytes += sizeof(T)) {
+					std::reverse(bytes, bytes + sizeof(T));
+				}
+			}
+		}
+
+		/// Call f(first, last) for consecutive ranges of at most \p chunk elements out of \p count, in parallel on the shared pool if requested
+		template<typename F>
+		void forEachChunk(std::size_t count, std::size_t chunk, bool parallel, F&& f) {
+			chunk = std::max<std::size_t>(chunk, 1);
+			const auto chunks = (count + chunk - 1) / chunk;
+			auto body = [&](std::size_t c) { f(c * chunk, std::min(count, (c + 1) * chunk)); };
+			if (parallel && chunks > 1) {
+				Async::parallelFor(Async::sharedPool(), std::size_t {0}, chunks, 1, body);
+			} else {
+				for (std::size_t c = 0; c < chunks; ++c) {
+					body(c);
+				}
+			}
+		}
+
+		/// Range of a text buffer that contains whole numbers, and how many of them
+		struct TextChunk {
+			const char* begin;
+			const char* end;
+			std::size_t count;
+		};
+
+		/// Check if a character separates numbers in a text file: whitespace, comma or semicolon
+		inline bool isSeparator(char c) noexcept {
+			return c == ' ' || c == '\n' || c == ',' || c == '\t' || c == '\r' || c == ';';
+		}
+
+		/// Split text into chunks of about \p chunkSize bytes that end at separators and count numbers in each chunk in parallel
+		std::vector<TextChunk> splitText(const char* data, std::size_t length, std::size_t chunkSize, bool parallel);
+
+		/**
+		 * Throw an exception about a token in a text file that is not a valid number
+		 * @param   token - the invalid token
+		 * @param   position - position of the token in the file in bytes
+		 */
+		[[noreturn]] void throwParseError(const std::string& token, std::size_t position);
+
+		/// Parse a number of type T which spans exactly [first, last)
+		template<typename T>
+		bool parseNumber(const char* first, const char* last, T& value) noexcept {
+			if (first != last && *first == '+') {
+				++first;
+			}
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+			auto [ptr, ec] = std::from_chars(first, last, value);
+			return ec == std::errc {} && ptr == last;
+#else
+			if constexpr (std::is_integral_v<T>) {
+				auto [ptr, ec] = std::from_chars(first, last, value);
+				return ec == std::errc {} && ptr == last;
+			} else {
+				// strtod needs a null-terminated string and the token does not have to be followed by a separator
+				constexpr std::ptrdiff_t maxLength = 64;
+				if (last - first >= maxLength) {
+					return false;
+				}
+				char buffer[maxLength] {};
+				std::memcpy(buffer, first, static_cast<std::size_t>(last - first));
+				char* end = nullptr;
+				value = static_cast<T>(std::strtod(buffer, &end));
+				return end == buffer + (last - first);
+			}
+#endif
+		}
+
+		/// Parse all numbers in a chunk of text into consecutive elements of \p out
+		template<typename T>
+		void parseChunk(const TextChunk& chunk, const char* fileBegin, T* out) {
+			const char* p = chunk.begin;
+			while (p != chunk.end) {
+				while (p != chunk.end && isSeparator(*p)) {
+					++p;
+				}
+				const char* tokenEnd = p;
+				while (tokenEnd != chunk.end && !isSeparator(*tokenEnd)) {
+					++tokenEnd;
+				}
+				if (tokenEnd != p) {
+					if (!parseNumber(p, tokenEnd, *out++)) {
+						throwParseError({p, tokenEnd}, static_cast<std::size_t>(p - fileBegin));
+					}
+				}
+				p = tokenEnd;
+			}
+		}
+
+		/// Use the dimensions given by the user or make a flat array of \p count elements
+		inline MArrayDimensions resultDimensions(MArrayDimensions dims, std::size_t count) {
+			return dims.rank() == 0 ? MArrayDimensions {static_cast<mint>(count)} : dims;
+		}
+	}  // namespace Detail
+
+	/**
+	 * @brief   Load a binary file of numbers into a new NumericArray.
+	 * @details The NumericArray is allocated once at its final size and the file is read straight into its memory in chunks, which are read in
+	 * parallel by the threads of Async::sharedPool(). When \p Source differs from \p T, every chunk is read into a temporary buffer and converted
+	 * with static_cast.
+	 * @tparam  T - type of elements of the NumericArray
+	 * @tparam  Source - type of numbers stored in the file
+	 * @param   fileName - path to the file, it is checked with validatePath
+	 * @param   dims - dimensions of the result, by default the result is a flat array of all numbers in the file (after \p opts.offset)
+	 * @param   opts - offset, byte order, chunk size and whether to read in parallel
+	 * @return  NumericArray with the numbers from the file
+	 * @throw   ErrorName::DimensionsError if the file is too short for given dimensions
+	 * @throw   ErrorName::OpenFileFailed, ErrorName::ReadFileFailed if the file could not be opened or read
+	 */
+	template<typename T, typename Source = T>
+	NumericArray<T> readBinaryFile(const std::string& fileName, MArrayDimensions dims = {}, const BinaryReadOptions& opts = {}) {
+		static_assert(std::is_arithmetic_v<Source>, "Only files of integers or floating point numbers can be read.");
+		Detail::PositionalFile file {fileName};
+		const auto fileSize = file.size();
+		const auto available = fileSize > opts.offset ? static_cast<std::size_t>((fileSize - opts.offset) / sizeof(Source)) : std::size_t {0};
+		dims = Detail::resultDimensions(std::move(dims), available);
+		const auto count = static_cast<std::size_t>(dims.flatCount());
+		if (count > available) {
+			ErrorManager::throwExceptionWithDebugInfo(ErrorName::DimensionsError, "File " + fileName + " is too short for requested dimensions.");
+		}
+		NumericArray<T> result {Uninitialized, std::move(dims)};
+		T* out = result.data();
+		const bool swap = Detail::needsByteSwap(opts.byteOrder);
+		Detail::forEachChunk(count, opts.chunkSize / sizeof(Source), opts.parallel, [&](std::size_t first, std::size_t last) {
+			const auto position = opts.offset + first * sizeof(Source);
+			if constexpr (std::is_same_v<T, Source>) {
+				file.read(out + first, (last - first) * sizeof(Source), position);
+				if (swap) {
+					Detail::swapBytes(out + first, last - first);
+				}
+			} else {
+				std::vector<Source> buffer(last - first);
+				file.read(buffer.data(), buffer.size() * sizeof(Source), position);
+				if (swap) {
+					Detail::swapBytes(buffer.data(), buffer.size());
+				}
+				std::transform(buffer.cbegin(), buffer.cend(), out + first, [](Source x) { return static_cast<T>(x); });
+			}
+		});
+		return result;
+	}
+
+	/**
+	 * @brief   Load a text file of numbers separated by whitespace, commas or semicolons into a new NumericArray.
+	 * @details The file is memory-mapped and split into chunks that are processed in two parallel passes: the first one counts numbers
+	 * in every chunk, so that the NumericArray can be allocated once at its final size, and the second one parses the numbers straight into it.
+	 * @tparam  T - type of elements of the NumericArray, numbers in the file must be valid literals of this type (e.g. "12", "-1.5e3")
+	 * @param   fileName - path to the file, it is checked with validatePath
+	 * @param   dims - dimensions of the result, by default the result is a flat array of all numbers in the file
+	 * @param   opts - chunk size and whether to parse in parallel
+	 * @return  NumericArray with the numbers from the file
+	 * @throw   ErrorName::DimensionsError if the number of numbers in the file does not match \p dims
+	 * @throw   ErrorName::NumberParseFailed if a token in the file is not a valid number of type T
+	 */
+	template<typename T>
+	NumericArray<T> readTextFile(const std::string& fileName, MArrayDimensions dims = {}, const TextReadOptions& opts = {}) {
+		static_assert(std::is_arithmetic_v<T>, "Only integers and floating point numbers can be read from text files.");
+		MappedFile file {fileName};
+		file.advise(AccessHint::Sequential);
+		const auto* text = reinterpret_cast<const char*>(file.data());	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		auto chunks = Detail::splitText(text, file.size(), opts.chunkSize, opts.parallel);
+		std::vector<std::size_t> starts(chunks.size() + 1, 0);
+		for (std::size_t c = 0; c < chunks.size(); ++c) {
+			starts[c + 1] = starts[c] + chunks[c].count;
+		}
+		dims = Detail::resultDimensions(std::move(dims), starts.back());
+		if (static_cast<std::size_t>(dims.flatCount()) != starts.back()) {
+			ErrorManager::throwExceptionWithDebugInfo(ErrorName::DimensionsError,
+													  "File " + fileName + " contains " + std::to_string(starts.back()) + " numbers.");
+		}
+		NumericArray<T> result {Uninitialized, std::move(dims)};
+		T* out = result.data();
+		Detail::forEachChunk(chunks.size(), 1, opts.parallel, [&](std::size_t first, std::size_t /*last*/) {
+			Detail::parseChunk(chunks[first], text, out + starts[first]);
+		});
+		return result;
+	}
+
+	/**
+	 * @class	BinaryFileWriter
+	 * @brief	Writes raw data of containers to a binary file with large writes and double buffering.
+	 *
+	 * Small writes are copied into one of two buffers aligned to directIOAlignment. When a buffer is full it is written to the file by a task on
+	 * Async::sharedPool() and the caller continues with the other buffer, so computing the next chunk of data overlaps with disk I/O.
+	 * Writes of at least a whole buffer that start when the current buffer is empty skip the buffers and go straight from the container memory
+	 * to the file (with unbuffered I/O only if the memory is suitably aligned).
+	 *
+	 * Data is written in the native byte order. Errors of asynchronous writes are rethrown from the next call that waits for them.
+	 * A single BinaryFileWriter must not be used from multiple threads at the same time.
+	 */
+	class BinaryFileWriter {
+	public:
+		/**
+		 * @brief	Open a file for writing
+		 * @param 	fileName - path to the file, it is checked with validatePath
+		 * @param 	opts - buffer size, unbuffered I/O, asynchronous flush and append mode
+		 * @throw 	ErrorName::OpenFileFailed if the file could not be opened
+		 */
+		explicit BinaryFileWriter(std::string fileName, const BinaryWriteOptions& opts = {});
+
+		BinaryFileWriter(const BinaryFileWriter&) = delete;
+		BinaryFileWriter& operator=(const BinaryFileWriter&) = delete;
+		BinaryFileWriter(BinaryFileWriter&&) = delete;
+		BinaryFileWriter& operator=(BinaryFileWriter&&) = delete;
+
+		/// Write the remaining data and close the file, errors are ignored so call close() explicitly to get them
+		~BinaryFileWriter();
+
+		/**
+		 * @brief	Append \p bytes bytes to the file
+		 * @throw 	ErrorName::WriteFileFailed if this or an earlier asynchronous write failed
+		 */
+		void write(const void* data, std::size_t bytes);
+
+		/// Append \p count elements of type T to the file
+		template<typename T>
+		void write(const T* data, std::size_t count) {
+			static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable elements can be written to a binary file.");
+			write(static_cast<const void*>(data), count * sizeof(T));
+		}
+
+		/// Append all elements of a container, e.g. a Tensor or a NumericArray, to the file
+		template<typename T>
+		void write(const IterableContainer<T>& c) {
+			write(c.data(), static_cast<std::size_t>(c.size()));
+		}
+
+		/**
+		 * @brief	Write all buffered data to the file and wait until all pending writes finish.
+		 * @note	When unbuffered I/O requires alignment and the buffered data is not a whole number of blocks, unbuffered I/O is turned off
+		 * 			for the rest of the file.
+		 */
+		void flush();
+
+		/// Flush and close the file, further writes are not allowed
+		void close();
+
+		/// Get the number of bytes passed to write() so far
+		[[nodiscard]] std::uint64_t bytesWritten() const noexcept {
+			return offset + fill - file.initialSize();
+		}
+
+	private:
+		/// Write the current buffer to the file, asynchronously if requested, and switch to the other buffer
+		void submitBuffer();
+
+		/// Block until the asynchronous write in progress, if any, completes
+		void waitForPending();
+
+		Detail::OutputFile file;
+		std::size_t capacity;
+		bool async;
+		bool closed = false;
+		Detail::AlignedBuffer buffers[2];
+		int current = 0;
+		std::size_t fill = 0;
+		std::uint64_t offset;
+		bool inFlight = false;
+		Async::TaskGroup pending;
+	};
+
+	/**
+	 * @brief	Write all elements of a container, e.g. a Tensor or a NumericArray, to a binary file in the native byte order
+	 * @param 	fileName - path to the file, it is checked with validatePath
+	 * @param 	c - container to write
+	 * @param 	opts - options of BinaryFileWriter
+	 */
+	template<typename T>
+	void writeBinaryFile(std::string fileName, const IterableContainer<T>& c, const BinaryWriteOptions& opts = {}) {
+		BinaryFileWriter writer {std::move(fileName), opts};
+		writer.write(c);
+		writer.close();
+	}
+}  // namespace LLU
+
+#endif	  // LLU_CONTAINERS_NUMERICARRAYIO_H
@@ -0,0 +1,374 @@
+/**
+ * @file	RecordBatch.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Columnar representation of tables passed between LibraryLink and the Wolfram Language as a DataStore with one node per column.
+ */
+#ifndef LLU_CONTAINERS_RECORDBATCH_H
+#define LLU_CONTAINERS_RECORDBATCH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "LLU/Containers/Generic/DataStore.hpp"
+#include "LLU/Containers/NumericArray.h"
+#include "LLU/Containers/Tensor.h"
+#include "LLU/Containers/Views/NumericArray.hpp"
+#include "LLU/Containers/Views/Tensor.hpp"
+#include "LLU/ErrorLog/ErrorManager.h"
+
+namespace LLU {
+
+	/**
+	 * @class   StringColumn
+	 * @brief   Block of strings stored as concatenated UTF-8 characters and offsets of consecutive strings.
+	 *
+	 * The characters are kept in a NumericArray of type "UnsignedInteger8" and the offsets in an integer Tensor with one element more than
+	 * the number of strings, where the i-th string spans characters [offsets[i], offsets[i + 1]). In the Wolfram Language such a column is
+	 * a DataStore with exactly these two nodes, e.g. <tt>Developer`DataStore[NumericArray[ToCharacterCode[StringJoin[strs], "UTF8"],
+	 * "UnsignedInteger8"], FoldList[Plus, 0, StringLength /@ strs]]</tt> for ASCII strings.
+	 */
+	class StringColumn {
+	public:
+		/**
+		 * @brief   Create a column from existing characters and offsets, no data is copied
+		 * @param   characters - concatenated strings
+		 * @param   offsets - rank 1 Tensor of non-decreasing offsets starting with 0 and ending with the number of characters
+		 * @throws  ErrorName::RankError - if any container is not of rank 1
+		 * @throws  ErrorName::DimensionsError - if offsets are not consistent with the characters
+		 */
+		StringColumn(NumericArray<std::uint8_t> characters, Tensor<mint> offsets);
+
+		/**
+		 * @brief   Create a column by copying strings from range [first, last)
+		 * @tparam  ForwardIt - iterator whose value type is convertible to std::string_view, the range is traversed twice
+		 */
+		template<class ForwardIt, typename = enable_if_same_or_derived<std::forward_iterator_tag, typename std::iterator_traits<ForwardIt>::iterator_category>>
+		StringColumn(ForwardIt first, ForwardIt last);
+
+		/**
+		 * @brief   Create a column from a DataStore with the characters and offsets as its two nodes, no data is copied
+		 * @throws  ErrorName::DLInvalidNodeType - if the DataStore does not have the layout described above
+		 */
+		explicit StringColumn(const GenericDataList& ds);
+
+		/// Get the number of strings
+		mint size() const noexcept {
+			return count;
+		}
+
+		/// Get the i-th string, the view remains valid as long as the column, no bounds checking is performed
+		std::string_view operator[](mint i) const noexcept {
+			return {chars + offs[i], static_cast<std::size_t>(offs[i + 1] - offs[i])};
+		}
+
+		/// Get the NumericArray with concatenated strings
+		const NumericArray<std::uint8_t>& characters() const noexcept {
+			return characterData;
+		}
+
+		/// Get the Tensor with offsets of consecutive strings
+		const Tensor<mint>& offsets() const noexcept {
+			return offsetData;
+		}
+
+		/// Create a DataStore with copies of the characters and offsets, in the layout expected by the Wolfram Language
+		GenericDataList toDataList() const;
+
+	private:
+		void cachePointers() noexcept;
+
+		NumericArray<std::uint8_t> characterData;
+		Tensor<mint> offsetData;
+		const char* chars = nullptr;
+		const mint* offs = nullptr;
+		mint count = 0;
+	};
+
+	/**
+	 * @class   RecordBatch
+	 * @brief   Table with named columns of equal length, where each column is a single rank 1 Tensor, NumericArray or StringColumn.
+	 *
+	 * Compared to a DataList of DataLists with one node per cell, a RecordBatch needs one DataStore node per column, so creating it from
+	 * a DataStore and converting it back takes time proportional to the number of columns and not the number of cells.
+	 *
+	 * In the Wolfram Language a RecordBatch is a DataStore with one named node per column, the name of the node is the name of the column,
+	 * e.g. <tt>Developer`DataStore["id" -> {1, 2, 3}, "score" -> NumericArray[{0.5, 0.25, 1.}, "Real32"], "name" -> strs]</tt>, where
+	 * \c strs is a string column as described in StringColumn.
+	 */
+	class RecordBatch {
+	public:
+		class Row;
+		class RowIterator;
+
+		/// Create an empty batch
+		RecordBatch() = default;
+
+		/**
+		 * @brief   Create a batch from a DataStore with one named node per column
+		 * @details Columns refer to the data in \p ds, nothing is copied, so the batch must not outlive the DataStore.
+		 * @throws  ErrorName::DLInvalidNodeType - if a node is neither a Tensor, NumericArray nor a string column
+		 * @throws  ErrorName::RankError - if a column is not of rank 1
+		 * @throws  ErrorName::DimensionsError - if columns differ in length
+		 */
+		explicit RecordBatch(const GenericDataList& ds);
+
+		/// Get the number of rows
+		mint rows() const noexcept {
+			return rowCount;
+		}
+
+		/// Get the number of columns
+		mint columns() const noexcept {
+			return static_cast<mint>(columnList.size());
+		}
+
+		/// Get the name of a column
+		std::string_view columnName(mint column) const {
+			return get(column).name;
+		}
+
+		/**
+		 * @brief   Get the position of a column with given name
+		 * @throws  ErrorName::DLNodeNotFound - if there is no such column
+		 */
+		mint columnIndex(std::string_view name) const;
+
+		/// Get the kind of a column, one of MArgumentType::Tensor, MArgumentType::NumericArray and MArgumentType::UTF8String
+		MArgumentType columnKind(mint column) const {
+			return get(column).kind;
+		}
+
+		/**
+		 * @brief   Add a column stored in a Tensor
+		 * @throws  ErrorName::RankError - if the Tensor is not of rank 1
+		 * @throws  ErrorName::DimensionsError - if the Tensor length differs from the length of other columns
+		 */
+		void addColumn(std::string name, GenericTensor data);
+
+		/// @copydoc addColumn(std::string, GenericTensor)
+		void addColumn(std::string name, GenericNumericArray data);
+
+		/// @copydoc addColumn(std::string, GenericTensor)
+		void addColumn(std::string name, StringColumn data);
+
+		/**
+		 * @brief   Get a typed view of a Tensor column
+		 * @throws  ErrorName::TypeError - if the column is not stored in a Tensor
+		 * @throws  ErrorName::TensorTypeError - if the Tensor does not hold elements of type T
+		 */
+		template<typename T>
+		TensorTypedView<T> tensorColumn(mint column) const {
+			return TensorTypedView<T> {std::get<GenericTensor>(checkedData(column, MArgumentType::Tensor))};
+		}
+
+		/**
+		 * @brief   Get a typed view of a NumericArray column
+		 * @throws  ErrorName::TypeError - if the column is not stored in a NumericArray
+		 * @throws  ErrorName::NumericArrayTypeError - if the NumericArray does not hold elements of type T
+		 */
+		template<typename T>
+		NumericArrayTypedView<T> numericArrayColumn(mint column) const {
+			return NumericArrayTypedView<T> {std::get<GenericNumericArray>(checkedData(column, MArgumentType::NumericArray))};
+		}
+
+		/**
+		 * @brief   Get a string column
+		 * @throws  ErrorName::TypeError - if the column does not hold strings
+		 */
+		const StringColumn& stringColumn(mint column) const {
+			return std::get<StringColumn>(checkedData(column, MArgumentType::UTF8String));
+		}
+
+		/// Get a proxy object for the i-th row, no bounds checking is performed
+		Row operator[](mint row) const noexcept;
+
+		/// Get iterator to the first row
+		RowIterator begin() const noexcept;
+
+		/// Get iterator past the last row
+		RowIterator end() const noexcept;
+
+		/**
+		 * @brief   Create a DataStore with one named node per column, in the layout expected by RecordBatch(const GenericDataList&)
+		 * @details Each column is copied with a single allocation (two for string columns), regardless of the number of rows.
+		 */
+		GenericDataList toDataList() const;
+
+	private:
+		struct Column {
+			std::string name;
+			MArgumentType kind;
+			/// MType_* for Tensor columns, numericarray_data_t for NumericArray columns
+			mint elementType;
+			/// raw data of Tensor and NumericArray columns, cached so that reading cells needs no calls to LibraryLink
+			const void* values;
+			std::variant<GenericTensor, GenericNumericArray, StringColumn> data;
+		};
+
+		const Column& get(mint column) const;
+		const std::variant<GenericTensor, GenericNumericArray, StringColumn>& checkedData(mint column, MArgumentType kind) const;
+		void addColumn(Column c, mint length);
+
+		template<typename T>
+		T cell(mint row, mint column) const;
+
+		mint rowCount = 0;
+		std::vector<Column> columnList;
+	};
+
+	/**
+	 * @class   RecordBatch::Row
+	 * @brief   Light-weight proxy for a single row of a RecordBatch
+	 */
+	class RecordBatch::Row {
+	public:
+		/// Create a proxy for given row of a batch
+		Row(const RecordBatch& b, mint r) noexcept : batch(&b), row(r) {}
+
+		/**
+		 * @brief   Get the value in given column of this row
+		 * @tparam  T - element type of the column, std::string_view for string columns
+		 * @throws  ErrorName::TypeError - if the column does not hold elements of type T
+		 */
+		template<typename T>
+		T get(mint column) const {
+			return batch->cell<T>(row, column);
+		}
+
+		/// @copydoc get(mint)
+		template<typename T>
+		T get(std::string_view column) const {
+			return batch->cell<T>(row, batch->columnIndex(column));
+		}
+
+		/// Get the position of this row in the batch
+		mint index() const noexcept {
+			return row;
+		}
+
+	private:
+		const RecordBatch* batch;
+		mint row;
+	};
+
+	/**
+	 * @class   RecordBatch::RowIterator
+	 * @brief   Proxy iterator over rows of a RecordBatch
+	 */
+	class RecordBatch::RowIterator {
+	public:
+		/// Rows are returned as proxy objects
+		using value_type = Row;
+
+		/// Proxy iterator, so the reference type is the same as value_type
+		using reference = value_type;
+
+		/// Proxy iterator, so the pointer type is void
+		using pointer = void;
+
+		/// Difference between positions of two rows
+		using difference_type = mint;
+
+		/// Rows can be traversed many times, but dereferencing yields a temporary
+		using iterator_category = std::input_iterator_tag;
+
+		/// Create an iterator pointing to given row of a batch
+		RowIterator(const RecordBatch& b, mint r) noexcept : batch(&b), row(r) {}
+
+		/// Get the current row
+		reference operator*() const noexcept {
+			return {*batch, row};
+		}
+
+		/// Pre-increment operator
+		RowIterator& operator++() noexcept {
+			++row;
+			return *this;
+		}
+
+		/// Post-increment operator
+		RowIterator operator++(int) noexcept {
+			RowIterator tmp {*this};
+			++row;
+			return tmp;
+		}
+
+		/// Compare two iterators
+		friend bool operator==(const RowIterator& lhs, const RowIterator& rhs) noexcept {
+			return lhs.batch == rhs.batch && lhs.row == rhs.row;
+		}
+
+		/// Compare two iterators
+		friend bool operator!=(const RowIterator& lhs, const RowIterator& rhs) noexcept {
+			return !(lhs == rhs);
+		}
+
+	private:
+		const RecordBatch* batch;
+		mint row;
+	};
+
+	template<class ForwardIt, typename>
+	StringColumn::StringColumn(ForwardIt first, ForwardIt last)
+		: characterData(Uninitialized, {std::accumulate(first, last, mint {0}, [](mint n, const auto& s) {
+			  return n + static_cast<mint>(std::string_view {s}.size());
+		  })}),
+		  offsetData(Uninitialized, {static_cast<mint>(std::distance(first, last)) + 1}) {
+		auto* out = characterData.data();
+		auto* off = offsetData.data();
+		mint pos = 0;
+		*off++ = pos;
+		for (; first != last; ++first) {
+			std::string_view s {*first};
+			std::copy(s.begin(), s.end(), out + pos);
+			pos += static_cast<mint>(s.size());
+			*off++ = pos;
+		}
+		cachePointers();
+	}
+
+	inline auto RecordBatch::operator[](mint row) const noexcept -> Row {
+		return {*this, row};
+	}
+
+	inline auto RecordBatch::begin() const noexcept -> RowIterator {
+		return {*this, 0};
+	}
+
+	inline auto RecordBatch::end() const noexcept -> RowIterator {
+		return {*this, rowCount};
+	}
+
+	template<typename T>
+	T RecordBatch::cell(mint row, mint column) const {
+		const auto& c = get(column);
+		if constexpr (std::is_same_v<T, std::string_view>) {
+			if (c.kind == MArgumentType::UTF8String) {
+				return std::get<StringColumn>(c.data)[row];
+			}
+		} else {
+			if constexpr (TensorType<T> != MType_Undef) {
+				if (c.kind == MArgumentType::Tensor && c.elementType == TensorType<T>) {
+					return static_cast<const T*>(c.values)[row];
+				}
+			}
+			if constexpr (NumericArrayType<T> != MNumericArray_Type_Undef) {
+				if (c.kind == MArgumentType::NumericArray && c.elementType == static_cast<mint>(NumericArrayType<T>)) {
+					return static_cast<const T*>(c.values)[row];
+				}
+			}
+		}
+		ErrorManager::throwException(ErrorName::TypeError, std::string {c.name});
+	}
+
+}  // namespace LLU
+
+#endif	  // LLU_CONTAINERS_RECORDBATCH_H
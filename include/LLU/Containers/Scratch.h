@@ -0,0 +1,265 @@
+/**
+ * @file	Scratch.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Arena allocator and arena-backed arrays for temporary data that never leaves a library function.
+ */
+#ifndef LLU_CONTAINERS_SCRATCH_H
+#define LLU_CONTAINERS_SCRATCH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+#include <type_traits>
+#include <vector>
+
+#include "LLU/Containers/MArray.hpp"
+#include "LLU/Containers/NumericArray.h"
+#include "LLU/Containers/Tensor.h"
+
+namespace LLU {
+
+	/**
+	 * @class   ScratchArena
+	 * @brief   Bump allocator for intermediate results of a single library function call.
+	 *
+	 * Memory is taken from large blocks owned by the arena, so an allocation is a pointer increment instead of a call to MTensor_new or
+	 * MNumericArray_new. Individual allocations are never freed, instead the whole arena (or everything allocated after a Mark) is released
+	 * at once. Blocks are kept after release and reused, so an arena that lives across calls, like the one returned by forThread(), stops
+	 * allocating from the system after the first few calls.
+	 */
+	class ScratchArena {
+	public:
+		/// Default size of a single block of memory
+		static constexpr std::size_t defaultBlockSize = std::size_t {1} << 20;
+
+		/// Alignment of memory returned by allocateArray, suitable for vector instructions
+		static constexpr std::size_t arrayAlignment = 64;
+
+		/// State of the arena that can be restored with rewind()
+		struct Mark {
+			/// Index of the current block
+			std::size_t block = 0;
+
+			/// Offset of the first free byte in the current block
+			std::size_t offset = 0;
+		};
+
+	public:
+		/**
+		 * @brief   Create an empty arena, no memory is allocated until the first request
+		 * @param   blockSize - size of blocks requested from the system, bigger allocations get a block of their own
+		 */
+		explicit ScratchArena(std::size_t blockSize = defaultBlockSize) : blockSize(blockSize) {}
+
+		ScratchArena(const ScratchArena&) = delete;
+		ScratchArena& operator=(const ScratchArena&) = delete;
+		ScratchArena(ScratchArena&&) noexcept = default;
+		ScratchArena& operator=(ScratchArena&&) noexcept = default;
+		~ScratchArena() = default;
+
+		/**
+		 * @brief   Get \p bytes of uninitialized memory aligned to \p alignment
+		 * @param   bytes - size of the requested memory
+		 * @param   alignment - power of 2
+		 * @return  pointer to memory valid until the arena is released or rewound to a mark taken before this call
+		 * @throws  std::bad_alloc - if a new block cannot be allocated
+		 */
+		void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+
+		/**
+		 * @brief   Get uninitialized memory for \p n elements of type T, aligned to arrayAlignment
+		 * @tparam  T - trivially copyable and destructible type, as no destructors are run
+		 */
+		template<typename T>
+		T* allocateArray(mint n) {
+			static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>, "Arena memory is released without running destructors.");
+			return static_cast<T*>(allocate(static_cast<std::size_t>(n) * sizeof(T), std::max(arrayAlignment, alignof(T))));
+		}
+
+		/// Get the current state of the arena
+		Mark mark() const noexcept {
+			return {current, offset};
+		}
+
+		/// Release all memory allocated after \p m was taken, blocks are kept for reuse
+		void rewind(const Mark& m) noexcept;
+
+		/// Release all memory allocated from the arena, blocks are kept for reuse
+		void release() noexcept {
+			rewind({});
+		}
+
+		/// Return all blocks to the system
+		void shrink() noexcept;
+
+		/// Get the number of bytes currently allocated from the arena, including padding
+		std::size_t bytesUsed() const noexcept;
+
+		/// Get the total size of blocks owned by the arena
+		std::size_t capacity() const noexcept;
+
+		/// Get an arena owned by the calling thread, which lives as long as the thread and can be reused by subsequent library calls
+		static ScratchArena& forThread();
+
+	private:
+		struct Block {
+			std::unique_ptr<std::byte[]> memory;
+			std::size_t size = 0;
+		};
+
+		std::size_t blockSize;
+		std::vector<Block> blocks;
+		std::size_t current = 0;
+		std::size_t offset = 0;
+	};
+
+#if __has_include(<memory_resource>)
+	/**
+	 * @class   ScratchResource
+	 * @brief   Polymorphic memory resource that allocates from a ScratchArena, so that std::pmr containers can keep their temporary data in the arena.
+	 *
+	 * Deallocation does nothing, the memory is reclaimed when the arena is released or rewound. A std::pmr::vector that grows therefore leaves its old
+	 * buffers in the arena until then, so reserve the final size up front when it is known.
+	 */
+	class ScratchResource : public std::pmr::memory_resource {
+	public:
+		/// Create a resource that allocates from given arena, which must outlive the resource and all containers using it
+		explicit ScratchResource(ScratchArena& a) noexcept : owner(&a) {}
+
+		/// Get the arena
+		ScratchArena& arena() const noexcept {
+			return *owner;
+		}
+
+	private:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+			return owner->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* /*p*/, std::size_t /*bytes*/, std::size_t /*alignment*/) override {}
+
+		[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+			const auto* o = dynamic_cast<const ScratchResource*>(&other);
+			return o && o->owner == owner;
+		}
+
+		ScratchArena* owner;
+	};
+#endif
+
+	/**
+	 * @class   ScratchScope
+	 * @brief   RAII guard that releases all arena memory allocated during its lifetime.
+	 *
+	 * Scopes can be nested and are the preferred way of using ScratchArena::forThread() in a library function:
+	 * @code
+	 * 	LLU::ScratchScope scope;
+	 * 	LLU::ScratchArray<double> tmp {scope.arena(), 0.0, {n, n}};
+	 * @endcode
+	 */
+	class ScratchScope {
+	public:
+		/// Create a scope on the arena of the calling thread
+		ScratchScope() : ScratchScope(ScratchArena::forThread()) {}
+
+		/// Create a scope on given arena
+		explicit ScratchScope(ScratchArena& a) noexcept : owner(a), start(a.mark()) {}
+
+		ScratchScope(const ScratchScope&) = delete;
+		ScratchScope& operator=(const ScratchScope&) = delete;
+		ScratchScope(ScratchScope&&) = delete;
+		ScratchScope& operator=(ScratchScope&&) = delete;
+
+		/// Rewind the arena to the state from before the scope was created
+		~ScratchScope() {
+			owner.rewind(start);
+		}
+
+		/// Get the arena
+		ScratchArena& arena() const noexcept {
+			return owner;
+		}
+
+	private:
+		ScratchArena& owner;
+		ScratchArena::Mark start;
+	};
+
+	/**
+	 * @class   ScratchArray
+	 * @brief   Multidimensional array allocated from a ScratchArena, with the same interface as Tensor<T> and NumericArray<T> via MArray<T>.
+	 *
+	 * ScratchArray is meant for intermediate results. It does not own its memory, which is valid as long as the arena is not released or
+	 * rewound past the point where the array was created. A result that must be returned to the Wolfram Language is materialized with
+	 * toTensor() or toNumericArray(), which is the only moment LibraryLink allocates memory.
+	 *
+	 * @tparam  T - trivially copyable type of elements
+	 */
+	template<typename T>
+	class ScratchArray : public MArray<T> {
+	public:
+		/**
+		 * @brief   Create an array with uninitialized elements
+		 * @param   arena - arena to allocate from
+		 * @param   dims - dimensions of the array
+		 */
+		ScratchArray(ScratchArena& arena, MArrayDimensions dims) : MArray<T>(std::move(dims)), values(arena.allocateArray<T>(this->dimensions().flatCount())) {}
+
+		/**
+		 * @brief   Create an array with all elements equal to \p init
+		 * @param   arena - arena to allocate from
+		 * @param   init - value of all elements
+		 * @param   dims - dimensions of the array
+		 */
+		ScratchArray(ScratchArena& arena, T init, MArrayDimensions dims) : ScratchArray(arena, std::move(dims)) {
+			std::fill(this->begin(), this->end(), init);
+		}
+
+		/**
+		 * @brief   Create an array with elements copied from range [first, last)
+		 * @param   arena - arena to allocate from
+		 * @param   first - iterator to the beginning of range
+		 * @param   last - iterator past the end of range
+		 * @param   dims - dimensions of the array
+		 * @throws  ErrorName::DimensionsError - if the length of the range does not match the dimensions
+		 */
+		template<class InputIt, typename = enable_if_input_iterator<InputIt>>
+		ScratchArray(ScratchArena& arena, InputIt first, InputIt last, MArrayDimensions dims) : ScratchArray(arena, std::move(dims)) {
+			if (std::distance(first, last) != this->size()) {
+				ErrorManager::throwException(ErrorName::DimensionsError);
+			}
+			std::copy(first, last, this->begin());
+		}
+
+		/// Copying would make two arrays share the same memory
+		ScratchArray(const ScratchArray&) = delete;
+		ScratchArray& operator=(const ScratchArray&) = delete;
+		ScratchArray(ScratchArray&&) noexcept = default;
+		ScratchArray& operator=(ScratchArray&&) noexcept = default;
+		~ScratchArray() override = default;
+
+		/// Copy the data to a new Tensor of the same dimensions
+		Tensor<T> toTensor() const {
+			return Tensor<T>(this->cbegin(), this->cend(), this->dimensions());
+		}
+
+		/// Copy the data to a new NumericArray of the same dimensions
+		NumericArray<T> toNumericArray() const {
+			return NumericArray<T>(this->cbegin(), this->cend(), this->dimensions());
+		}
+
+	private:
+		T* getData() const noexcept override {
+			return values;
+		}
+
+		T* values;
+	};
+
+}  // namespace LLU
+
+#endif	  // LLU_CONTAINERS_SCRATCH_H
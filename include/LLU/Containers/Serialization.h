@@ -0,0 +1,269 @@
+/**
+ * @file	Serialization.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief	Binary file format for LibraryLink containers and DataLists, which can be memory-mapped and read without copying the data.
+ */
+#ifndef LLU_CONTAINERS_SERIALIZATION_H
+#define LLU_CONTAINERS_SERIALIZATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "LLU/Compression.h"
+#include "LLU/Containers/Generic/DataStore.hpp"
+#include "LLU/Containers/Generic/Image.hpp"
+#include "LLU/Containers/Generic/NumericArray.hpp"
+#include "LLU/Containers/Generic/SparseArray.hpp"
+#include "LLU/Containers/Generic/Tensor.hpp"
+#include "LLU/Containers/MArrayDimensions.h"
+#include "LLU/Containers/Views/Strided.hpp"
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/FileUtilities.h"
+#include "LLU/TypedMArgument.h"
+#include "LLU/Utilities.hpp"
+
+/**
+ * @brief Binary serialization of LibraryLink values.
+ *
+ * A serialized file starts with a FileHeader followed by a single root node. Every node starts with a NodeHeader followed by the dimensions
+ * (one int64 per rank), the null-terminated name of the node (for elements of DataLists) and the payload. Node headers and payloads are aligned to
+ * Serialization::alignment, so that the payload can be used directly from a memory-mapped file. The payload of a DataList node is the sequence
+ * of its child nodes. Payloads of arrays can optionally be stored as Compression frames, such nodes are loaded with SerializedNode::value.
+ * All numbers are stored in the byte order of the machine that wrote the file, which is checked when the file is opened.
+ */
+namespace LLU::Serialization {
+
+	/// Identifies LLU serialized files
+	inline constexpr char magic[8] = {'L', 'L', 'U', 'S', 'E', 'R', '\0', '\0'};
+
+	/// Current version of the format
+	inline constexpr std::uint32_t version = 2;
+
+	/// Alignment of nodes and payloads in bytes, in the file and therefore also in the memory when the file is mapped
+	inline constexpr std::size_t alignment = 64;
+
+	/// Flag of a node whose payload is a Compression::Frame
+	inline constexpr std::uint16_t compressedPayloadFlag = 1;
+
+	/// Header at the beginning of every serialized file
+	struct FileHeader {
+		/// Serialization::magic
+		char magic[8];
+		/// version of the format used to write the file
+		std::uint32_t version;
+		/// 0x01020304 written in the byte order of the machine
+		std::uint32_t byteOrderMark;
+		/// sizeof(mint) on the machine that wrote the file
+		std::uint32_t mintSize;
+		/// unused, zero
+		std::uint32_t reserved0;
+		/// offset of the root node in bytes
+		std::uint64_t rootOffset;
+		/// unused, zero
+		std::uint8_t reserved[32];
+	};
+
+	/// Header of a single serialized value
+	struct NodeHeader {
+		/// MArgumentType of the value
+		std::uint32_t type;
+		/// element type: MType for Tensors and SparseArrays, numericarray_data_t for NumericArrays, imagedata_t for Images
+		std::uint32_t elementType;
+		/// number of dimensions stored after the header
+		std::uint16_t rank;
+		/// combination of node flags, e.g. compressedPayloadFlag
+		std::uint16_t flags;
+		/// length of the name stored after the dimensions, the name is followed by a zero byte
+		std::uint32_t nameLength;
+		/// size of the whole node in bytes, including the header and padding, a multiple of alignment
+		std::uint64_t nodeSize;
+		/// offset of the payload from the beginning of the node
+		std::uint64_t payloadOffset;
+		/// size of the payload in bytes
+		std::uint64_t payloadSize;
+		/// type-specific fields: Image - channels, color space, interleaving; SparseArray - number of explicit values; DataList - length
+		std::int64_t extra[3];
+	};
+
+	static_assert(sizeof(FileHeader) == alignment && sizeof(NodeHeader) == alignment, "Serialization headers must span exactly one aligned block.");
+
+	/// Options of serialize
+	struct SerializeOptions {
+		/// Whether to compress the data of Tensors, NumericArrays and Images, scalars and SparseArrays are always stored as is
+		bool compress = false;
+		/// Compression options, elements are shuffled according to their size unless compression.elementSize is set explicitly, 1 disables shuffling
+		Compression::Options compression {};
+	};
+
+	/**
+	 * @brief	Write a value, e.g. a Tensor or a DataList with nested containers, to a serialized file.
+	 * @param 	fileName - path to the file, it is checked with validatePath
+	 * @param 	value - value to write, must not be empty (std::monostate)
+	 * @param 	opts - whether and how to compress the data of arrays
+	 * @throw 	ErrorName::DLInvalidNodeType if the value or one of the DataList nodes is empty
+	 * @throw 	ErrorName::OpenFileFailed, ErrorName::WriteFileFailed if the file could not be written
+	 */
+	void serialize(const std::string& fileName, const Argument::TypedArgument& value, const SerializeOptions& opts = {});
+
+	/// Write a Tensor to a serialized file, see serialize(const std::string&, const Argument::TypedArgument&)
+	void serialize(const std::string& fileName, const GenericTensor& t, const SerializeOptions& opts = {});
+
+	/// Write a NumericArray to a serialized file, see serialize(const std::string&, const Argument::TypedArgument&)
+	void serialize(const std::string& fileName, const GenericNumericArray& na, const SerializeOptions& opts = {});
+
+	/// Write an Image to a serialized file, see serialize(const std::string&, const Argument::TypedArgument&)
+	void serialize(const std::string& fileName, const GenericImage& im, const SerializeOptions& opts = {});
+
+	/// Write a SparseArray to a serialized file, see serialize(const std::string&, const Argument::TypedArgument&)
+	void serialize(const std::string& fileName, const GenericSparseArray& sa, const SerializeOptions& opts = {});
+
+	/// Write a DataList with all its nodes to a serialized file, see serialize(const std::string&, const Argument::TypedArgument&)
+	void serialize(const std::string& fileName, const GenericDataList& dl, const SerializeOptions& opts = {});
+
+	class SerializedFile;
+
+	/**
+	 * @class	SerializedNode
+	 * @brief	Read-only handle to a single value in a memory-mapped serialized file.
+	 *
+	 * Uncompressed array payloads can be viewed without copying with view().
+	 * value() copies or decompresses the data into new LibraryLink containers owned by the library.
+	 * A node keeps the mapping alive, so it stays valid also after the SerializedFile it came from is destroyed.
+	 */
+	class SerializedNode {
+	public:
+		/// Get the type of the value
+		[[nodiscard]] MArgumentType type() const noexcept {
+			return static_cast<MArgumentType>(header().type);
+		}
+
+		/// Get the raw element type: MType for Tensors and SparseArrays, numericarray_data_t for NumericArrays, imagedata_t for Images, 0 otherwise
+		[[nodiscard]] std::uint32_t elementType() const noexcept {
+			return header().elementType;
+		}
+
+		/// Get the name of the node in its DataList, empty for the root and for nameless nodes
+		[[nodiscard]] std::string_view name() const noexcept;
+
+		/// Get the dimensions of a Tensor, NumericArray or SparseArray, or {[slices,] rows, columns} of an Image
+		[[nodiscard]] MArrayDimensions dimensions() const;
+
+		/// Get the number of channels of an Image node
+		[[nodiscard]] mint channels() const noexcept {
+			return header().extra[0];
+		}
+
+		/// Get the color space of an Image node
+		[[nodiscard]] colorspace_t colorspace() const noexcept {
+			return static_cast<colorspace_t>(header().extra[1]);
+		}
+
+		/// Check if the channels of an Image node are interleaved
+		[[nodiscard]] bool interleavedQ() const noexcept {
+			return header().extra[2] != 0;
+		}
+
+		/// Get the number of child nodes of a DataList node, 0 for other nodes
+		[[nodiscard]] mint length() const noexcept {
+			return type() == MArgumentType::DataStore ? header().extra[0] : 0;
+		}
+
+		/// Check if the payload of the node is compressed, then it cannot be viewed and must be loaded with value()
+		[[nodiscard]] bool compressedQ() const noexcept {
+			return (header().flags & compressedPayloadFlag) != 0;
+		}
+
+		/// Get the child nodes of a DataList node, in order
+		[[nodiscard]] std::vector<SerializedNode> children() const;
+
+		/**
+		 * @brief	Get a read-only view of the data of a Tensor, NumericArray or Image node, straight from the mapped file.
+		 * @details Tensors and NumericArrays are viewed with their dimensions, Images as a flat array of all pixel values in their native layout.
+		 * @tparam 	T - element type, it must match the element type of the node
+		 * @throw 	ErrorName::InvalidSerializedData if the node is not an array of elements of type T or if it is compressed
+		 */
+		template<typename T>
+		[[nodiscard]] StridedView<const T> view() const {
+			if (!holdsElements<T>()) {
+				throwInvalid("the node is not an array of requested type");
+			}
+			if (compressedQ()) {
+				throwInvalid("a compressed node cannot be viewed");
+			}
+			auto dims = type() == MArgumentType::Image ? MArrayDimensions {static_cast<mint>(header().payloadSize / sizeof(T))} : dimensions();
+			return file->view<T>(dims, offset + static_cast<std::size_t>(header().payloadOffset));
+		}
+
+		/**
+		 * @brief	Load the value into new LibraryLink containers owned by the library; DataLists are loaded recursively.
+		 * @note	UTF8String values are views of the mapped file, the string is only copied when the node is added to a DataList.
+		 */
+		[[nodiscard]] Argument::TypedArgument value() const;
+
+	private:
+		friend class SerializedFile;
+
+		SerializedNode(std::shared_ptr<const MappedFile> mapping, std::shared_ptr<const std::string> path, std::size_t position);
+
+		[[nodiscard]] const NodeHeader& header() const noexcept {
+			return *reinterpret_cast<const NodeHeader*>(file->data() + offset);	// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		}
+
+		[[nodiscard]] const std::byte* payload() const noexcept {
+			return file->data() + offset + header().payloadOffset;
+		}
+
+		template<typename T>
+		[[nodiscard]] bool holdsElements() const noexcept {
+			switch (type()) {
+				case MArgumentType::Tensor: return TensorType<T> != MType_Undef && elementType() == static_cast<std::uint32_t>(TensorType<T>);
+				case MArgumentType::NumericArray:
+					return NumericArrayType<T> != MNumericArray_Type_Undef && elementType() == static_cast<std::uint32_t>(NumericArrayType<T>);
+				case MArgumentType::Image: return ImageType<T> != MImage_Type_Undef && elementType() == static_cast<std::uint32_t>(ImageType<T>);
+				default: return false;
+			}
+		}
+
+		[[noreturn]] void throwInvalid(const std::string& reason) const;
+
+		/// Check that the node fits in the mapped range and that its parts fit in the node
+		void validate() const;
+
+		std::shared_ptr<const MappedFile> file;
+		std::shared_ptr<const std::string> fileName;
+		std::size_t offset;
+	};
+
+	/**
+	 * @class	SerializedFile
+	 * @brief	Serialized file mapped into memory.
+	 */
+	class SerializedFile {
+	public:
+		/**
+		 * @brief	Map a serialized file and check its header
+		 * @param 	fileName - path to the file, it is checked with validatePath
+		 * @throw 	ErrorName::InvalidSerializedData if the file was not written by serialize, by a different version or on a different architecture
+		 */
+		explicit SerializedFile(const std::string& fileName);
+
+		/// Get the root node
+		[[nodiscard]] SerializedNode root() const;
+
+	private:
+		std::shared_ptr<const MappedFile> mapping;
+		std::shared_ptr<const std::string> name;
+	};
+
+	/**
+	 * @brief	Read a serialized file into new LibraryLink containers, see SerializedNode::value
+	 * @throw 	ErrorName::InvalidSerializedData if the file is invalid or if the root is a UTF8String, which cannot outlive the mapping
+	 */
+	Argument::TypedArgument deserialize(const std::string& fileName);
+}  // namespace LLU::Serialization
+
+#endif	  // LLU_CONTAINERS_SERIALIZATION_H
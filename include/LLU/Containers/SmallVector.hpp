@@ -0,0 +1,374 @@
+/**
+ * @file	SmallVector.hpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Definition and implementation of SmallVector, a vector of trivial elements that stores a few of them without heap allocation.
+ */
+#ifndef LLU_CONTAINERS_SMALLVECTOR_HPP
+#define LLU_CONTAINERS_SMALLVECTOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "LLU/Utilities.hpp"
+
+namespace LLU {
+
+	/**
+	 * @brief   Sequence container with the interface of a (very) reduced std::vector, which keeps up to N elements inline.
+	 *
+	 * Dimensions and strides of containers have only a few elements, so storing them in std::vector costs a heap allocation per container
+	 * wrapper. SmallVector stores the first N elements inside the object and switches to a heap buffer only when it grows beyond that.
+	 *
+	 * @tparam  T - type of elements, must be trivially copyable (e.g. mint)
+	 * @tparam  N - number of elements stored inline
+	 */
+	template<typename T, std::size_t N>
+	class SmallVector {
+		static_assert(std::is_trivially_copyable_v<T>, "SmallVector only supports trivially copyable elements.");
+		static_assert(N > 0, "SmallVector must have room for at least one inline element.");
+
+	public:
+		/// Type of elements stored
+		using value_type = T;
+
+		/// Type of the size of the container
+		using size_type = std::size_t;
+
+		/// Iterator type
+		using iterator = T*;
+
+		/// Constant iterator type
+		using const_iterator = const T*;
+
+		/// Reverse iterator type
+		using reverse_iterator = std::reverse_iterator<iterator>;
+
+		/// Constant reverse iterator type
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		/// Reference type
+		using reference = T&;
+
+		/// Constant reference type
+		using const_reference = const T&;
+
+	public:
+		SmallVector() = default;
+
+		/**
+		 * @brief   Create a SmallVector with \p count copies of \p value
+		 * @param   count - number of elements
+		 * @param   value - value of each element
+		 */
+		SmallVector(size_type count, const T& value) {
+			assign(count, value);
+		}
+
+		/**
+		 * @brief   Create a SmallVector with elements copied from a range
+		 * @param   first - range begin
+		 * @param   last - range end
+		 */
+		template<typename InputIter, typename = enable_if_input_iterator<InputIter>>
+		SmallVector(InputIter first, InputIter last) {
+			assign(first, last);
+		}
+
+		/**
+		 * @brief   Create a SmallVector from a list of values
+		 * @param   values - initial elements
+		 */
+		SmallVector(std::initializer_list<T> values) : SmallVector(values.begin(), values.end()) {}
+
+		/**
+		 * @brief   Create a SmallVector with elements copied from a std::vector
+		 * @param   values - initial elements
+		 */
+		explicit SmallVector(const std::vector<T>& values) : SmallVector(values.cbegin(), values.cend()) {}
+
+		/// Copy constructor
+		SmallVector(const SmallVector& other) : SmallVector(other.begin(), other.end()) {}
+
+		/// Move constructor, steals the heap buffer if there is one
+		SmallVector(SmallVector&& other) noexcept {
+			moveFrom(other);
+		}
+
+		/// Copy-assignment operator
+		SmallVector& operator=(const SmallVector& other) {
+			if (this != &other) {
+				assign(other.begin(), other.end());
+			}
+			return *this;
+		}
+
+		/// Move-assignment operator
+		SmallVector& operator=(SmallVector&& other) noexcept {
+			if (this != &other) {
+				heap.reset();
+				moveFrom(other);
+			}
+			return *this;
+		}
+
+		~SmallVector() = default;
+
+		/// Get the number of elements
+		size_type size() const noexcept {
+			return count;
+		}
+
+		/// Check if there are no elements
+		[[nodiscard]] bool empty() const noexcept {
+			return count == 0;
+		}
+
+		/// Get the number of elements that can be stored without reallocation
+		size_type capacity() const noexcept {
+			return heap ? heapCapacity : N;
+		}
+
+		/// Check if the elements are stored inline, i.e. no heap memory is used
+		bool isInline() const noexcept {
+			return !heap;
+		}
+
+		/// Get raw pointer to the elements
+		T* data() noexcept {
+			return heap ? heap.get() : inlineBuffer.data();
+		}
+
+		/// Get raw pointer to the const elements
+		const T* data() const noexcept {
+			return heap ? heap.get() : inlineBuffer.data();
+		}
+
+		/// Get a reference to the element at position \p pos, without bound checking
+		T& operator[](size_type pos) noexcept {
+			return data()[pos];
+		}
+
+		/// Get a const reference to the element at position \p pos, without bound checking
+		const T& operator[](size_type pos) const noexcept {
+			return data()[pos];
+		}
+
+		/// Get a reference to the first element
+		T& front() noexcept {
+			return data()[0];
+		}
+
+		/// Get a const reference to the first element
+		const T& front() const noexcept {
+			return data()[0];
+		}
+
+		/// Get a reference to the last element
+		T& back() noexcept {
+			return data()[count - 1];
+		}
+
+		/// Get a const reference to the last element
+		const T& back() const noexcept {
+			return data()[count - 1];
+		}
+
+		/// Get iterator to the first element
+		iterator begin() noexcept {
+			return data();
+		}
+
+		/// Get const iterator to the first element
+		const_iterator begin() const noexcept {
+			return data();
+		}
+
+		/// Get const iterator to the first element
+		const_iterator cbegin() const noexcept {
+			return data();
+		}
+
+		/// Get iterator past the last element
+		iterator end() noexcept {
+			return data() + count;
+		}
+
+		/// Get const iterator past the last element
+		const_iterator end() const noexcept {
+			return data() + count;
+		}
+
+		/// Get const iterator past the last element
+		const_iterator cend() const noexcept {
+			return data() + count;
+		}
+
+		/// Get reverse iterator to the last element
+		reverse_iterator rbegin() noexcept {
+			return reverse_iterator {end()};
+		}
+
+		/// Get const reverse iterator to the last element
+		const_reverse_iterator rbegin() const noexcept {
+			return const_reverse_iterator {end()};
+		}
+
+		/// Get const reverse iterator to the last element
+		const_reverse_iterator crbegin() const noexcept {
+			return const_reverse_iterator {cend()};
+		}
+
+		/// Get reverse iterator before the first element
+		reverse_iterator rend() noexcept {
+			return reverse_iterator {begin()};
+		}
+
+		/// Get const reverse iterator before the first element
+		const_reverse_iterator rend() const noexcept {
+			return const_reverse_iterator {begin()};
+		}
+
+		/// Get const reverse iterator before the first element
+		const_reverse_iterator crend() const noexcept {
+			return const_reverse_iterator {cbegin()};
+		}
+
+		/**
+		 * @brief   Make sure that at least \p newCapacity elements can be stored without reallocation
+		 * @param   newCapacity - requested capacity
+		 */
+		void reserve(size_type newCapacity) {
+			if (newCapacity <= capacity()) {
+				return;
+			}
+			auto newBuffer = std::make_unique<T[]>(newCapacity);
+			std::copy(begin(), end(), newBuffer.get());
+			heap = std::move(newBuffer);
+			heapCapacity = newCapacity;
+		}
+
+		/**
+		 * @brief   Replace the contents with \p newCount copies of \p value
+		 * @param   newCount - number of elements
+		 * @param   value - value of each element
+		 */
+		void assign(size_type newCount, const T& value) {
+			count = 0;
+			reserve(newCount);
+			std::fill_n(data(), newCount, value);
+			count = newCount;
+		}
+
+		/**
+		 * @brief   Replace the contents with elements copied from a range
+		 * @param   first - range begin
+		 * @param   last - range end
+		 */
+		template<typename InputIter, typename = enable_if_input_iterator<InputIter>>
+		void assign(InputIter first, InputIter last) {
+			count = 0;
+			if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIter>::iterator_category>) {
+				reserve(static_cast<size_type>(std::distance(first, last)));
+			}
+			std::copy(first, last, std::back_inserter(*this));
+		}
+
+		/**
+		 * @brief   Append an element at the end
+		 * @param   value - new element
+		 */
+		void push_back(const T& value) {
+			if (count == capacity()) {
+				auto copy = value;	  // value may refer to an element of this container
+				reserve(2 * capacity());
+				data()[count++] = copy;
+				return;
+			}
+			data()[count++] = value;
+		}
+
+		/// Remove the last element
+		void pop_back() noexcept {
+			--count;
+		}
+
+		/**
+		 * @brief   Change the number of elements, new elements are set to \p value
+		 * @param   newCount - new number of elements
+		 * @param   value - value of appended elements
+		 */
+		void resize(size_type newCount, const T& value = T {}) {
+			reserve(newCount);
+			if (newCount > count) {
+				std::fill(end(), data() + newCount, value);
+			}
+			count = newCount;
+		}
+
+		/**
+		 * @brief   Remove the element at position \p pos
+		 * @param   pos - iterator to the element to be removed
+		 * @return  iterator following the removed element
+		 */
+		iterator erase(const_iterator pos) noexcept {
+			auto it = begin() + (pos - cbegin());
+			std::copy(it + 1, end(), it);
+			--count;
+			return it;
+		}
+
+		/// Remove all elements, the capacity is not changed
+		void clear() noexcept {
+			count = 0;
+		}
+
+		/// Copy the elements to a std::vector
+		std::vector<T> asVector() const {
+			return {begin(), end()};
+		}
+
+		/// Compare contents of two SmallVectors
+		friend bool operator==(const SmallVector& lhs, const SmallVector& rhs) noexcept {
+			return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+
+		/// Compare contents of two SmallVectors
+		friend bool operator!=(const SmallVector& lhs, const SmallVector& rhs) noexcept {
+			return !(lhs == rhs);
+		}
+
+	private:
+		/// Inline storage, used as long as heap is empty
+		std::array<T, N> inlineBuffer {};
+
+		/// Heap storage for more than N elements
+		std::unique_ptr<T[]> heap;
+
+		/// Capacity of the heap buffer
+		size_type heapCapacity = 0;
+
+		/// Number of elements
+		size_type count = 0;
+
+		void moveFrom(SmallVector& other) noexcept {
+			if (other.heap) {
+				heap = std::move(other.heap);
+				heapCapacity = other.heapCapacity;
+			} else {
+				std::copy(other.begin(), other.end(), inlineBuffer.begin());
+			}
+			count = other.count;
+			other.heapCapacity = 0;
+			other.count = 0;
+		}
+	};
+
+}  // namespace LLU
+
+#endif	  // LLU_CONTAINERS_SMALLVECTOR_HPP
@@ -0,0 +1,269 @@
+/**
+ * @file	SparseArrayBuilder.hpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Incremental assembly of rank 2 SparseArrays from (row, column, value) triplets.
+ */
+#ifndef LLU_CONTAINERS_SPARSEARRAYBUILDER_HPP
+#define LLU_CONTAINERS_SPARSEARRAYBUILDER_HPP
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "LLU/Containers/SparseArray.h"
+#include "LLU/Containers/Tensor.h"
+#include "LLU/Containers/Views/SparseMatrix.hpp"
+#include "LLU/ErrorLog/ErrorManager.h"
+
+namespace LLU {
+
+	/**
+	 * @brief   Compressed sparse row representation of a matrix, owned by LLU
+	 * @details Column indices are 1-based like in MSparseArray, so the data can be viewed with SparseMatrixView or turned into a SparseArray.
+	 * @tparam  T - type of the values
+	 */
+	template<typename T>
+	struct CompressedRows {
+		/// Number of rows
+		mint rows = 0;
+
+		/// Number of columns
+		mint columns = 0;
+
+		/// Value of elements which are not stored explicitly
+		T implicitValue {};
+
+		/// rows + 1 cumulative counts of explicit elements, starting with 0
+		std::vector<mint> rowPointers;
+
+		/// 1-based column indices of explicit elements, sorted within each row
+		std::vector<mint> columnIndices;
+
+		/// Explicit values
+		std::vector<T> values;
+
+		/// Get a view over the data, valid as long as this object is alive and not modified
+		SparseMatrixView<T> view() const noexcept {
+			return {rows, columns, rowPointers.data(), columnIndices.data(), values.data(), implicitValue};
+		}
+
+		/**
+		 * @brief   Create a SparseArray with the same elements
+		 * @details Positions are passed to MSparseArray_fromExplicitPositions already sorted and without duplicates.
+		 */
+		SparseArray<T> toSparseArray() const {
+			const auto nnz = static_cast<mint>(values.size());
+			Tensor<mint> positions(mint {0}, {nnz, 2});
+			auto* pos = positions.data();
+			for (mint i = 0; i < rows; ++i) {
+				for (mint k = rowPointers[i]; k < rowPointers[i + 1]; ++k) {
+					pos[2 * k] = i + 1;
+					pos[2 * k + 1] = columnIndices[k];
+				}
+			}
+			return {positions, Tensor<T> {values}, Tensor<mint> {rows, columns}, implicitValue};
+		}
+	};
+
+	/**
+	 * @class   SparseArrayBuilder
+	 * @brief   Accumulates (row, column, value) triplets of a sparse matrix in any order and compresses them into CSR form in linear time.
+	 *
+	 * Triplets are collected in buffers. Each thread that produces triplets should fill its own buffer obtained from newBuffer(), so that no
+	 * synchronization is needed while adding elements. compress() then sorts all triplets by row with a counting sort, sorts each row by column
+	 * and sums values with equal positions, which is what finite-element style assembly expects.
+	 *
+	 * @tparam  T - type of the values (mint, double or std::complex<double>)
+	 */
+	template<typename T>
+	class SparseArrayBuilder {
+	public:
+		/**
+		 * @brief   Triplets added by a single thread
+		 */
+		class Buffer {
+		public:
+			/**
+			 * @brief   Add an element, if an element at the same position is added more than once, the values are summed
+			 * @param   row - 0-based row index
+			 * @param   column - 0-based column index
+			 * @param   value - value of the element
+			 * @throws  ErrorName::MArrayElementIndexError - if the position is outside of the matrix
+			 */
+			void add(mint row, mint column, const T& value) {
+				if (row < 0 || row >= rows || column < 0 || column >= columns) {
+					ErrorManager::throwException(ErrorName::MArrayElementIndexError, row, column);
+				}
+				entries.push_back({row, column, value});
+			}
+
+			/// Reserve memory for \p n triplets
+			void reserve(mint n) {
+				entries.reserve(static_cast<std::size_t>(n));
+			}
+
+			/// Get the number of triplets in the buffer
+			mint size() const noexcept {
+				return static_cast<mint>(entries.size());
+			}
+
+		private:
+			friend class SparseArrayBuilder;
+
+			struct Triplet {
+				mint row;
+				mint column;
+				T value;
+			};
+
+			Buffer(mint rows, mint columns) : rows(rows), columns(columns) {}
+
+			mint rows;
+			mint columns;
+			std::vector<Triplet> entries;
+		};
+
+	public:
+		/**
+		 * @brief   Create a builder for a matrix of given size
+		 * @param   rows - number of rows
+		 * @param   columns - number of columns
+		 * @param   implicitValue - value of elements which are not added explicitly
+		 * @throws  ErrorName::DimensionsError - if any dimension is negative
+		 */
+		SparseArrayBuilder(mint rows, mint columns, T implicitValue = T {}) : rowCount(rows), columnCount(columns), implicit(implicitValue) {
+			if (rows < 0 || columns < 0) {
+				ErrorManager::throwException(ErrorName::DimensionsError);
+			}
+		}
+
+		/**
+		 * @brief   Create a new, empty buffer
+		 * @details This function is thread-safe. The buffer is owned by the builder and must only be filled by one thread at a time.
+		 * References to buffers become invalid when the builder is compressed.
+		 */
+		Buffer& newBuffer() {
+			std::lock_guard<std::mutex> lock {buffersMutex};
+			return buffers.emplace_back(Buffer {rowCount, columnCount});
+		}
+
+		/**
+		 * @brief   Add an element to the default buffer, this function is not thread-safe
+		 * @see     Buffer::add
+		 */
+		void add(mint row, mint column, const T& value) {
+			if (!defaultBuffer) {
+				defaultBuffer = &newBuffer();
+			}
+			defaultBuffer->add(row, column, value);
+		}
+
+		/// Get the total number of triplets added so far, including duplicates
+		mint size() const {
+			std::lock_guard<std::mutex> lock {buffersMutex};
+			return std::accumulate(buffers.cbegin(), buffers.cend(), mint {0}, [](mint n, const Buffer& b) { return n + b.size(); });
+		}
+
+		/**
+		 * @brief   Compress all triplets into CSR form, using \p forRows to run the per-row part of the work
+		 * @details The builder is emptied in the process, so that peak memory usage stays close to the size of the result.
+		 * @param   forRows - callable that takes the number of rows and a function of a range of rows [first, last) and calls that function
+		 * on ranges covering all rows, possibly in parallel
+		 */
+		template<typename RowExecutor>
+		CompressedRows<T> compress(RowExecutor&& forRows);
+
+		/// Compress all triplets into CSR form sequentially, the builder is emptied in the process
+		CompressedRows<T> compress() {
+			return compress([](mint rows, auto&& rowRange) { rowRange(mint {0}, rows); });
+		}
+
+		/// Compress all triplets and create a SparseArray, the builder is emptied in the process
+		SparseArray<T> finalize() {
+			return compress().toSparseArray();
+		}
+
+	private:
+		mint rowCount;
+		mint columnCount;
+		T implicit;
+		std::deque<Buffer> buffers;
+		Buffer* defaultBuffer = nullptr;
+		mutable std::mutex buffersMutex;
+	};
+
+	template<typename T>
+	template<typename RowExecutor>
+	CompressedRows<T> SparseArrayBuilder<T>::compress(RowExecutor&& forRows) {
+		std::deque<Buffer> input;
+		{
+			std::lock_guard<std::mutex> lock {buffersMutex};
+			input.swap(buffers);
+			defaultBuffer = nullptr;
+		}
+
+		// counting sort of all triplets by row
+		std::vector<mint> rowStart(static_cast<std::size_t>(rowCount) + 1, 0);
+		for (const auto& b : input) {
+			for (const auto& t : b.entries) {
+				++rowStart[t.row + 1];
+			}
+		}
+		std::partial_sum(rowStart.begin(), rowStart.end(), rowStart.begin());
+		std::vector<std::pair<mint, T>> sorted(static_cast<std::size_t>(rowStart.back()));
+		{
+			std::vector<mint> cursor(rowStart.begin(), rowStart.end() - 1);
+			for (auto& b : input) {
+				for (const auto& t : b.entries) {
+					sorted[cursor[t.row]++] = {t.column, t.value};
+				}
+				b.entries = {};
+			}
+		}
+
+		// sort each row by column and merge duplicates in place
+		std::vector<mint> uniqueCount(static_cast<std::size_t>(rowCount) + 1, 0);
+		forRows(rowCount, [&sorted, &rowStart, &uniqueCount](mint first, mint last) {
+			for (mint i = first; i < last; ++i) {
+				auto rowBegin = sorted.begin() + rowStart[i];
+				auto rowEnd = sorted.begin() + rowStart[i + 1];
+				std::sort(rowBegin, rowEnd, [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+				auto out = rowBegin;
+				for (auto it = rowBegin; it != rowEnd; ++it) {
+					if (out != rowBegin && std::prev(out)->first == it->first) {
+						std::prev(out)->second += it->second;
+					} else {
+						*out++ = *it;
+					}
+				}
+				uniqueCount[i + 1] = out - rowBegin;
+			}
+		});
+
+		CompressedRows<T> result;
+		result.rows = rowCount;
+		result.columns = columnCount;
+		result.implicitValue = implicit;
+		result.rowPointers = std::move(uniqueCount);
+		std::partial_sum(result.rowPointers.begin(), result.rowPointers.end(), result.rowPointers.begin());
+		result.columnIndices.resize(static_cast<std::size_t>(result.rowPointers.back()));
+		result.values.resize(static_cast<std::size_t>(result.rowPointers.back()));
+		forRows(rowCount, [&sorted, &rowStart, &result](mint first, mint last) {
+			for (mint i = first; i < last; ++i) {
+				auto in = rowStart[i];
+				for (mint k = result.rowPointers[i]; k < result.rowPointers[i + 1]; ++k, ++in) {
+					result.columnIndices[k] = sorted[in].first + 1;
+					result.values[k] = sorted[in].second;
+				}
+			}
+		});
+		return result;
+	}
+
+}  // namespace LLU
+
+#endif	  // LLU_CONTAINERS_SPARSEARRAYBUILDER_HPP
@@ -98,6 +98,25 @@ namespace LLU {
 		 **/
 		Tensor(T init, MArrayDimensions dims);
 
+		/**
+		 *   @brief         Constructs the Tensor of given shape without initializing the elements
+		 *   @param[in]     dims - MArrayDimensions object with Tensor dimensions
+		 *   @note			The contents are whatever MTensor_new leaves in the memory and should be overwritten before use.
+		 **/
+		Tensor(Uninitialized_t, MArrayDimensions dims);
+
+		/**
+		 *   @brief         Constructs the Tensor of given shape with elements written directly by \p producer
+		 *   @param[in]     dims - dimensions of the Tensor
+		 *   @param[in]     producer - either a function f(T* data, mint length) that fills the whole buffer, or a function T f(mint index)
+		 *   				that returns the element at given flat index
+		 *   @note			Data is written once, straight into LibraryLink memory, without an intermediate container.
+		 **/
+		template<class F, typename = std::enable_if_t<is_producer_v<F, T>>>
+		Tensor(MArrayDimensions dims, F&& producer) : Tensor(Uninitialized, std::move(dims)) {
+			Detail::produceInto(this->data(), this->size(), producer);
+		}
+
 		/**
 		 *   @brief         Constructs the Tensor of given shape with elements from range [first, last)
 		 *   @param[in]     first - iterator to the beginning of range
@@ -159,6 +178,10 @@ namespace LLU {
 		std::fill(this->begin(), this->end(), init);
 	}
 
+	template<typename T>
+	Tensor<T>::Tensor(Uninitialized_t, MArrayDimensions dims)
+		: TypedTensor<T>(std::move(dims)), GenericBase(TensorType<T>, this->rank(), this->dimensions().data()) {}
+
 	template<typename T>
 	template<class InputIt, typename>
 	Tensor<T>::Tensor(InputIt first, InputIt last, MArrayDimensions dims)
@@ -0,0 +1,188 @@
+/**
+ * @file	Transpose.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Cache-blocked transposition and permutation of dimensions of Tensors and NumericArrays, and zero-copy reshape.
+ */
+#ifndef LLU_CONTAINERS_TRANSPOSE_H
+#define LLU_CONTAINERS_TRANSPOSE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+
+#include "LLU/Containers/MArray.hpp"
+#include "LLU/Containers/MArrayDimensions.h"
+#include "LLU/Containers/Views/Strided.hpp"
+
+namespace LLU {
+
+	namespace Detail {
+		/// Size of the square tiles in which planes are copied, chosen so that a row of a tile fills one 64-byte cache line
+		template<typename T>
+		inline constexpr mint transposeTile = std::max<mint>(64 / static_cast<mint>(sizeof(T)), 4);
+
+		/**
+		 * @brief   Copy a full Tile x Tile block, rows of the destination are contiguous
+		 * @details Loop bounds are compile-time constants, so for 4- and 8-byte elements the compiler unrolls the loops and uses vector
+		 * registers for the contiguous side of the block.
+		 */
+		template<mint Tile, typename T>
+		void copyFullTile(const T* src, mint srcRowStep, mint srcColStep, std::remove_cv_t<T>* dst, mint dstRowStep) noexcept {
+			for (mint j = 0; j < Tile; ++j) {
+				const T* in = src + j * srcColStep;
+				auto* out = dst + j;
+				for (mint i = 0; i < Tile; ++i) {
+					out[i * dstRowStep] = in[i * srcRowStep];
+				}
+			}
+		}
+
+		/// Copy a partial block of \p rows x \p cols elements at the edge of a plane
+		template<typename T>
+		void copyTile(const T* src, mint srcRowStep, mint srcColStep, std::remove_cv_t<T>* dst, mint dstRowStep, mint rows, mint cols) noexcept {
+			for (mint j = 0; j < cols; ++j) {
+				for (mint i = 0; i < rows; ++i) {
+					dst[i * dstRowStep + j] = src[i * srcRowStep + j * srcColStep];
+				}
+			}
+		}
+
+		/// Copy a \p rows x \p cols plane tile by tile
+		template<typename T>
+		void copyPlane(const T* src, mint srcRowStep, mint srcColStep, std::remove_cv_t<T>* dst, mint dstRowStep, mint rows, mint cols) noexcept {
+			constexpr mint tile = transposeTile<std::remove_cv_t<T>>;
+			for (mint i0 = 0; i0 < rows; i0 += tile) {
+				for (mint j0 = 0; j0 < cols; j0 += tile) {
+					const T* in = src + i0 * srcRowStep + j0 * srcColStep;
+					auto* out = dst + i0 * dstRowStep + j0;
+					if (i0 + tile <= rows && j0 + tile <= cols) {
+						copyFullTile<tile>(in, srcRowStep, srcColStep, out, dstRowStep);
+					} else {
+						copyTile(in, srcRowStep, srcColStep, out, dstRowStep, std::min(tile, rows - i0), std::min(tile, cols - j0));
+					}
+				}
+			}
+		}
+	}  // namespace Detail
+
+	/**
+	 * @brief   Copy the elements of a view, in row-major order of the view, into a contiguous buffer
+	 * @details When the last dimension of the view has unit stride this is a plain sequential copy. Otherwise the copy runs over planes spanned
+	 * by the last dimension and by the dimension with the smallest stride in memory, in square tiles that fit in the L1 cache. Thus both reads and
+	 * writes touch each cache line only once, even for a transposed matrix.
+	 * @param   src - view to copy
+	 * @param   out - buffer for src.size() elements
+	 */
+	template<typename T>
+	void copyView(const StridedView<T>& src, std::remove_cv_t<T>* out) {
+		const auto rank = src.rank();
+		if (src.empty()) {
+			return;
+		}
+		const auto& dims = src.dimensions();
+		const auto& steps = src.strides();
+		const auto last = static_cast<std::size_t>(rank - 1);
+		if (rank < 2 || std::abs(steps[last]) <= 1) {
+			src.forEach([&out](const T& x) { *out++ = x; });
+			return;
+		}
+		// the dimension along which reads are the most local is the other side of the tiled planes
+		std::size_t inner = 0;
+		for (std::size_t d = 1; d < last; ++d) {
+			if (std::abs(steps[d]) < std::abs(steps[inner])) {
+				inner = d;
+			}
+		}
+		if (std::abs(steps[inner]) >= std::abs(steps[last])) {
+			src.forEach([&out](const T& x) { *out++ = x; });
+			return;
+		}
+		DimensionsVector outSteps(dims.size(), 1);
+		for (auto d = last; d > 0; --d) {
+			outSteps[d - 1] = outSteps[d] * dims[d];
+		}
+		// odometer over all dimensions except the two that span the planes
+		DimensionsVector index(dims.size(), 0);
+		const T* in = src.data();
+		auto* dst = out;
+		for (;;) {
+			Detail::copyPlane(in, steps[inner], steps[last], dst, outSteps[inner], dims[inner], dims[last]);
+			auto d = static_cast<std::ptrdiff_t>(last) - 1;
+			for (; d >= 0; --d) {
+				auto ud = static_cast<std::size_t>(d);
+				if (ud == inner) {
+					continue;
+				}
+				if (++index[ud] < dims[ud]) {
+					in += steps[ud];
+					dst += outSteps[ud];
+					break;
+				}
+				in -= steps[ud] * (dims[ud] - 1);
+				dst -= outSteps[ud] * (dims[ud] - 1);
+				index[ud] = 0;
+			}
+			if (d < 0) {
+				break;
+			}
+		}
+	}
+
+	/**
+	 * @brief   Create a new array with a copy of the elements of a view
+	 * @tparam  Array - Tensor or NumericArray with elements of type std::remove_cv_t<T>
+	 * @param   src - view to copy, e.g. a transposed view or a sub-block of another array
+	 * @return  new array owned by the library, with the dimensions of the view
+	 */
+	template<class Array, typename T>
+	Array copyToArray(const StridedView<T>& src) {
+		static_assert(std::is_same_v<typename Array::value_type, std::remove_cv_t<T>>, "Array element type must match the element type of the view.");
+		const auto& dims = src.dimensions();
+		return Array {MArrayDimensions {dims.begin(), dims.end()}, [&src](typename Array::value_type* out, mint /*length*/) { copyView(src, out); }};
+	}
+
+	/**
+	 * @brief   Permute the dimensions of an array, copying the data in cache-friendly tiles
+	 * @tparam  Array - Tensor or NumericArray
+	 * @param   a - array to permute
+	 * @param   order - permutation of {0, ..., rank - 1}, dimension i of the result is dimension order[i] of \p a
+	 * @return  new array owned by the library
+	 * @throws  ErrorName::DimensionsError - if \p order is not a permutation
+	 */
+	template<class Array>
+	Array permuteDimensions(const Array& a, const std::vector<mint>& order) {
+		return copyToArray<Array>(a.view().permuted(order));
+	}
+
+	/**
+	 * @brief   Reverse the order of dimensions of an array, e.g. transpose a matrix, copying the data in cache-friendly tiles
+	 * @tparam  Array - Tensor or NumericArray
+	 * @param   a - array to transpose
+	 * @return  new array owned by the library
+	 */
+	template<class Array>
+	Array transpose(const Array& a) {
+		return copyToArray<Array>(a.view().transposed());
+	}
+
+	/**
+	 * @brief   Get a view of the data of an array with different dimensions, without copying anything
+	 * @param   a - array, which must outlive the view
+	 * @param   dims - new dimensions, with the same total number of elements
+	 * @throws  ErrorName::DimensionsError - if the number of elements does not match
+	 */
+	template<typename T>
+	StridedView<T> reshape(MArray<T>& a, const MArrayDimensions& dims) {
+		return a.view().reshaped(dims);
+	}
+
+	/// @copydoc reshape(MArray<T>&, const MArrayDimensions&)
+	template<typename T>
+	StridedView<const T> reshape(const MArray<T>& a, const MArrayDimensions& dims) {
+		return a.view().reshaped(dims);
+	}
+}  // namespace LLU
+
+#endif	  // LLU_CONTAINERS_TRANSPOSE_H
@@ -0,0 +1,210 @@
+/**
+ * @file	Converting.hpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Conversion of NumericArray data to a different type without allocating a new MNumericArray.
+ */
+#ifndef LLU_CONTAINERS_VIEWS_CONVERTING_HPP
+#define LLU_CONTAINERS_VIEWS_CONVERTING_HPP
+
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+#include "LLU/Containers/Conversion.hpp"
+#include "LLU/Containers/MArrayDimensions.h"
+#include "LLU/Containers/Views/NumericArray.hpp"
+#include "LLU/Containers/Views/Strided.hpp"
+
+namespace LLU {
+
+	/**
+	 * @brief   Read-only view over a contiguous range of elements of type T, which yields them converted to type U.
+	 *
+	 * Values are converted on the fly, when they are accessed, so no memory is allocated for the result. The view does not own the data,
+	 * it is only valid as long as the viewed container is alive.
+	 *
+	 * @tparam  U - type of elements yielded by the view
+	 * @tparam  T - type of elements of the viewed container
+	 * @see     NA::convertValue for the semantics of each conversion method
+	 */
+	template<typename U, typename T>
+	class ConvertingView {
+	public:
+		/// Type of elements yielded by the view
+		using value_type = U;
+
+		/// Iterator type
+		class iterator;
+
+	public:
+		/**
+		 * @brief   Create a view over a raw array
+		 * @param   data - pointer to the first element
+		 * @param   length - number of elements
+		 * @param   method - conversion method
+		 * @param   tolerance - tolerance used by the Check method
+		 */
+		ConvertingView(const T* data, mint length, NA::ConversionMethod method, double tolerance = 0.0)
+			: source(data), length(length), method(method), tolerance(tolerance) {}
+
+		/**
+		 * @brief   Create a view over a container of T, i.e. a NumericArrayTypedView<T> or NumericArray<T>
+		 * @param   c - container, must outlive the view
+		 * @param   method - conversion method
+		 * @param   tolerance - tolerance used by the Check method
+		 */
+		template<class Container, typename = std::enable_if_t<std::is_same_v<typename std::decay_t<Container>::value_type, T>>>
+		ConvertingView(const Container& c, NA::ConversionMethod method, double tolerance = 0.0)
+			: ConvertingView(c.data(), static_cast<mint>(c.size()), method, tolerance) {}
+
+		/// Get the number of elements
+		mint size() const noexcept {
+			return length;
+		}
+
+		/**
+		 * @brief   Get the element at position \p index converted to U, without bound checking
+		 * @throws  ErrorName::NumericArrayConversionError - if the element cannot be converted to U
+		 */
+		U operator[](mint index) const {
+			return NA::convertValue<U>(source[index], method, tolerance);
+		}
+
+		/// Get iterator to the first element
+		iterator begin() const noexcept {
+			return iterator {this, 0};
+		}
+
+		/// Get iterator past the last element
+		iterator end() const noexcept {
+			return iterator {this, length};
+		}
+
+		/**
+		 * @brief   Convert all elements and write the results to \p out
+		 * @param   out - pointer to a buffer of at least size() elements
+		 * @throws  ErrorName::NumericArrayConversionError - if any element cannot be converted to U
+		 */
+		void copyTo(U* out) const {
+			for (mint i = 0; i < length; ++i) {
+				out[i] = NA::convertValue<U>(source[i], method, tolerance);
+			}
+		}
+
+	private:
+		const T* source = nullptr;
+		mint length = 0;
+		NA::ConversionMethod method;
+		double tolerance = 0.0;
+	};
+
+	/**
+	 * @brief   Iterator over the elements of a ConvertingView, dereferencing yields a converted value
+	 */
+	template<typename U, typename T>
+	class ConvertingView<U, T>::iterator {
+	public:
+		/// @cond
+		using iterator_category = std::input_iterator_tag;
+		using value_type = U;
+		using difference_type = mint;
+		using pointer = void;
+		using reference = U;
+		/// @endcond
+
+		iterator() = default;
+
+		/// Convert and get the current element
+		U operator*() const {
+			return (*owner)[pos];
+		}
+
+		/// Pre-increment
+		iterator& operator++() noexcept {
+			++pos;
+			return *this;
+		}
+
+		/// Post-increment
+		iterator operator++(int) noexcept {
+			auto tmp = *this;
+			++pos;
+			return tmp;
+		}
+
+		/// Get the number of elements between two iterators of the same view
+		friend difference_type operator-(const iterator& lhs, const iterator& rhs) noexcept {
+			return lhs.pos - rhs.pos;
+		}
+
+		/// Compare two iterators
+		friend bool operator==(const iterator& lhs, const iterator& rhs) noexcept {
+			return lhs.owner == rhs.owner && lhs.pos == rhs.pos;
+		}
+
+		/// Compare two iterators
+		friend bool operator!=(const iterator& lhs, const iterator& rhs) noexcept {
+			return !(lhs == rhs);
+		}
+
+	private:
+		friend class ConvertingView<U, T>;
+
+		iterator(const ConvertingView* view, mint position) noexcept : owner(view), pos(position) {}
+
+		const ConvertingView* owner = nullptr;
+		mint pos = 0;
+	};
+
+	namespace NA {
+		/**
+		 * @brief   Create a lazy view over \p c that yields elements converted to U
+		 * @tparam  U - type of elements yielded by the view
+		 * @param   c - a NumericArrayTypedView<T>, NumericArray<T> or any other contiguous container, must outlive the view
+		 * @param   method - conversion method
+		 * @param   tolerance - tolerance used by the Check method
+		 */
+		template<typename U, class Container>
+		auto convertingView(const Container& c, ConversionMethod method, double tolerance = 0.0) {
+			return ConvertingView<U, typename Container::value_type> {c, method, tolerance};
+		}
+
+		/**
+		 * @brief   Convert the data of a NumericArray to U in place, reusing the memory of the original elements.
+		 *
+		 * LibraryLink does not allow to change the type of an existing MNumericArray, so the NumericArray keeps reporting type T and must not
+		 * be passed back to the Wolfram Language after the conversion. The converted data is accessible through the returned view, whose
+		 * dimensions are the same as those of \p na. All elements are validated before any of them is overwritten, so if the conversion
+		 * fails, the data is left unchanged.
+		 *
+		 * @tparam  U - new element type, must have the same size and alignment as the current one
+		 * @tparam  Container - NumericArrayTypedView<T> or NumericArray<T>
+		 * @param   na - NumericArray to be converted
+		 * @param   method - conversion method
+		 * @param   tolerance - tolerance used by the Check method
+		 * @return  view over the converted data
+		 * @throws  ErrorName::NumericArrayConversionError - if any element cannot be converted to U
+		 */
+		template<typename U, class Container>
+		StridedView<U> convertInPlace(Container& na, ConversionMethod method, double tolerance = 0.0) {
+			using T = typename Container::value_type;
+			static_assert(sizeof(U) == sizeof(T) && alignof(U) == alignof(T), "In-place conversion requires types of the same size and alignment.");
+			auto* elements = na.data();
+			const auto length = na.size();
+			if (conversionMayFail<U, T>(method)) {
+				for (mint i = 0; i < length; ++i) {
+					(void)convertValue<U>(elements[i], method, tolerance);
+				}
+			}
+			auto* out = reinterpret_cast<U*>(elements);	   // NOLINT: the storage is reused for objects of a different type
+			for (mint i = 0; i < length; ++i) {
+				const U converted = convertValue<U>(elements[i], method, tolerance);
+				std::memcpy(out + i, &converted, sizeof(U));
+			}
+			return StridedView<U> {out, MArrayDimensions {na.getDimensions(), na.getRank()}};
+		}
+	}  // namespace NA
+
+}  // namespace LLU
+
+#endif	  // LLU_CONTAINERS_VIEWS_CONVERTING_HPP
@@ -37,62 +37,62 @@ namespace LLU {
 
 		/// @copydoc ImageInterface::colorspace()
 		colorspace_t colorspace() const override {
-			return LibraryData::ImageAPI()->MImage_getColorSpace(m);
+			return LibraryData::uncheckedImageAPI()->MImage_getColorSpace(m);
 		}
 
 		/// @copydoc ImageInterface::rows()
 		mint rows() const override {
-			return LibraryData::ImageAPI()->MImage_getRowCount(m);
+			return LibraryData::uncheckedImageAPI()->MImage_getRowCount(m);
 		}
 
 		/// @copydoc ImageInterface::columns()
 		mint columns() const override {
-			return LibraryData::ImageAPI()->MImage_getColumnCount(m);
+			return LibraryData::uncheckedImageAPI()->MImage_getColumnCount(m);
 		}
 
 		/// @copydoc ImageInterface::slices()
 		mint slices() const override {
-			return LibraryData::ImageAPI()->MImage_getSliceCount(m);
+			return LibraryData::uncheckedImageAPI()->MImage_getSliceCount(m);
 		}
 
 		/// @copydoc ImageInterface::channels()
 		mint channels() const override {
-			return LibraryData::ImageAPI()->MImage_getChannels(m);
+			return LibraryData::uncheckedImageAPI()->MImage_getChannels(m);
 		}
 
 		/// @copydoc ImageInterface::alphaChannelQ()
 		bool alphaChannelQ() const override {
-			return LibraryData::ImageAPI()->MImage_alphaChannelQ(m) == True;
+			return LibraryData::uncheckedImageAPI()->MImage_alphaChannelQ(m) == True;
 		}
 
 		/// @copydoc ImageInterface::interleavedQ()
 		bool interleavedQ() const override {
-			return LibraryData::ImageAPI()->MImage_interleavedQ(m) == True;
+			return LibraryData::uncheckedImageAPI()->MImage_interleavedQ(m) == True;
 		}
 
 		/// @copydoc ImageInterface::is3D()
 		bool is3D() const override {
-			return LibraryData::ImageAPI()->MImage_getRank(m) == 3;
+			return LibraryData::uncheckedImageAPI()->MImage_getRank(m) == 3;
 		}
 
 		/// @copydoc ImageInterface::getRank()
 		mint getRank() const override {
-			return LibraryData::ImageAPI()->MImage_getRank(m);
+			return LibraryData::uncheckedImageAPI()->MImage_getRank(m);
 		}
 
 		/// @copydoc ImageInterface::getFlattenedLength()
 		mint getFlattenedLength() const override {
-			return LibraryData::ImageAPI()->MImage_getFlattenedLength(m);
+			return LibraryData::uncheckedImageAPI()->MImage_getFlattenedLength(m);
 		}
 
 		/// @copydoc ImageInterface::type()
 		imagedata_t type() const final {
-			return LibraryData::ImageAPI()->MImage_getDataType(m);
+			return LibraryData::uncheckedImageAPI()->MImage_getDataType(m);
 		}
 
 		/// @copydoc ImageInterface::rawData()
 		void* rawData() const override {
-			return LibraryData::ImageAPI()->MImage_getRawData(m);
+			return LibraryData::uncheckedImageAPI()->MImage_getRawData(m);
 		}
 
 	private:
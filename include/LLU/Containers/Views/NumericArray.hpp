@@ -8,6 +8,7 @@
 
 #include "LLU/Containers/Generic/NumericArray.hpp"
 #include "LLU/Containers/Interfaces.h"
+#include "LLU/Containers/MArrayDimensions.h"
 #include "LLU/Containers/Iterators/IterableContainer.hpp"
 
 namespace LLU {
@@ -36,27 +37,32 @@ namespace LLU {
 
 		/// @copydoc NumericArrayInterface::getRank()
 		mint getRank() const override {
-			return LibraryData::NumericArrayAPI()->MNumericArray_getRank(na);
+			return LibraryData::uncheckedNumericArrayAPI()->MNumericArray_getRank(na);
 		}
 
 		/// @copydoc NumericArrayInterface::getDimensions()
 		mint const* getDimensions() const override {
-			return LibraryData::NumericArrayAPI()->MNumericArray_getDimensions(na);
+			return LibraryData::uncheckedNumericArrayAPI()->MNumericArray_getDimensions(na);
+		}
+
+		/// Get a view of the dimensions, read directly from LibraryLink without copying
+		DimensionsView dimensions() const {
+			return {getDimensions(), getRank()};
 		}
 
 		/// @copydoc NumericArrayInterface::getFlattenedLength()
 		mint getFlattenedLength() const override {
-			return LibraryData::NumericArrayAPI()->MNumericArray_getFlattenedLength(na);
+			return LibraryData::uncheckedNumericArrayAPI()->MNumericArray_getFlattenedLength(na);
 		}
 
 		/// @copydoc NumericArrayInterface::type()
 		numericarray_data_t type() const final {
-			return LibraryData::NumericArrayAPI()->MNumericArray_getType(na);
+			return LibraryData::uncheckedNumericArrayAPI()->MNumericArray_getType(na);
 		}
 
 		/// @copydoc NumericArrayInterface::rawData()
 		void* rawData() const noexcept override {
-			return LibraryData::NumericArrayAPI()->MNumericArray_getData(na);
+			return LibraryData::uncheckedNumericArrayAPI()->MNumericArray_getData(na);
 		}
 
 	private:
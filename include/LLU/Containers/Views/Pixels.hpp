@@ -0,0 +1,388 @@
+/**
+ * @file	Pixels.hpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Direct access to Image pixels through a raw data pointer and precomputed strides.
+ */
+#ifndef LLU_CONTAINERS_VIEWS_PIXELS_HPP
+#define LLU_CONTAINERS_VIEWS_PIXELS_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+#include "LLU/Containers/Interfaces.h"
+#include "LLU/ErrorLog/ErrorManager.h"
+
+namespace LLU {
+
+	/**
+	 * @brief   Shape of an Image together with distances (in elements) between neighboring values along each coordinate.
+	 *
+	 * Interleaved images store all channels of a pixel next to each other, so the data is laid out as [slices][rows][columns][channels].
+	 * Planar images store each channel as a separate plane, i.e. [channels][slices][rows][columns]. 2D images have a single slice.
+	 */
+	struct ImageLayout {
+		/// Number of slices, 1 for 2D images
+		mint slices = 0;
+
+		/// Number of rows
+		mint rows = 0;
+
+		/// Number of columns
+		mint columns = 0;
+
+		/// Number of channels
+		mint channels = 0;
+
+		/// Distance between values of the same pixel in consecutive slices
+		mint sliceStride = 0;
+
+		/// Distance between values of the same pixel in consecutive rows
+		mint rowStride = 0;
+
+		/// Distance between values of neighboring pixels in a row
+		mint columnStride = 0;
+
+		/// Distance between consecutive channels of a pixel
+		mint channelStride = 0;
+
+		/**
+		 * @brief   Read the layout of an Image, this is the only place where LibraryLink is queried
+		 * @param   im - any Image-like object, e.g. GenericImage, Image<T> or ImageTypedView<T>
+		 */
+		static ImageLayout of(const ImageInterface& im) {
+			ImageLayout l;
+			l.slices = std::max(im.slices(), mint {1});
+			l.rows = im.rows();
+			l.columns = im.columns();
+			l.channels = im.channels();
+			if (im.interleavedQ()) {
+				l.channelStride = 1;
+				l.columnStride = l.channels;
+				l.rowStride = l.columns * l.channels;
+				l.sliceStride = l.rows * l.rowStride;
+			} else {
+				l.columnStride = 1;
+				l.rowStride = l.columns;
+				l.sliceStride = l.rows * l.columns;
+				l.channelStride = l.slices * l.sliceStride;
+			}
+			return l;
+		}
+
+		/// Check if given 0-based coordinates point to a valid value in the image
+		bool contains(mint slice, mint row, mint column, mint channel) const noexcept {
+			return slice >= 0 && slice < slices && row >= 0 && row < rows && column >= 0 && column < columns && channel >= 0 && channel < channels;
+		}
+	};
+
+	/**
+	 * @brief   Non-owning, one-dimensional view over image values that are equally spaced in memory, e.g. one channel of a row or all channels of a pixel
+	 * @tparam  T - type of image data, use const T for read-only spans
+	 */
+	template<typename T>
+	class PixelSpan {
+	public:
+		/// Type of the values
+		using value_type = std::remove_cv_t<T>;
+
+		/// Random access iterator over values of the span
+		class iterator;
+
+	public:
+		PixelSpan() = default;
+
+		/**
+		 * @brief   Create a span
+		 * @param   first - pointer to the first value
+		 * @param   length - number of values
+		 * @param   stride - distance between consecutive values
+		 */
+		PixelSpan(T* first, mint length, mint stride) noexcept : first(first), length(length), step(stride) {}
+
+		/// Get the number of values
+		mint size() const noexcept {
+			return length;
+		}
+
+		/// Get the distance between consecutive values
+		mint stride() const noexcept {
+			return step;
+		}
+
+		/// Get the pointer to the first value
+		T* data() const noexcept {
+			return first;
+		}
+
+		/// Get the value at position \p i, without bound checking
+		T& operator[](mint i) const noexcept {
+			return first[i * step];
+		}
+
+		/// Get iterator to the first value
+		iterator begin() const noexcept {
+			return iterator {first, step};
+		}
+
+		/// Get iterator past the last value
+		iterator end() const noexcept {
+			return iterator {first + length * step, step};
+		}
+
+	private:
+		T* first = nullptr;
+		mint length = 0;
+		mint step = 1;
+	};
+
+	/**
+	 * @brief   Iterator over the values of a PixelSpan, moving it is a single pointer increment by the stride of the span
+	 */
+	template<typename T>
+	class PixelSpan<T>::iterator {
+	public:
+		/// @cond
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = std::remove_cv_t<T>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = T*;
+		using reference = T&;
+		/// @endcond
+
+		iterator() = default;
+
+		reference operator*() const noexcept {
+			return *current;
+		}
+
+		pointer operator->() const noexcept {
+			return current;
+		}
+
+		reference operator[](difference_type n) const noexcept {
+			return current[n * step];
+		}
+
+		iterator& operator++() noexcept {
+			current += step;
+			return *this;
+		}
+
+		iterator operator++(int) noexcept {
+			auto tmp = *this;
+			current += step;
+			return tmp;
+		}
+
+		iterator& operator--() noexcept {
+			current -= step;
+			return *this;
+		}
+
+		iterator operator--(int) noexcept {
+			auto tmp = *this;
+			current -= step;
+			return tmp;
+		}
+
+		iterator& operator+=(difference_type n) noexcept {
+			current += n * step;
+			return *this;
+		}
+
+		iterator& operator-=(difference_type n) noexcept {
+			current -= n * step;
+			return *this;
+		}
+
+		friend iterator operator+(iterator it, difference_type n) noexcept {
+			return it += n;
+		}
+
+		friend iterator operator+(difference_type n, iterator it) noexcept {
+			return it += n;
+		}
+
+		friend iterator operator-(iterator it, difference_type n) noexcept {
+			return it -= n;
+		}
+
+		friend difference_type operator-(const iterator& lhs, const iterator& rhs) noexcept {
+			return (lhs.current - rhs.current) / lhs.step;
+		}
+
+		friend bool operator==(const iterator& lhs, const iterator& rhs) noexcept {
+			return lhs.current == rhs.current;
+		}
+
+		friend bool operator!=(const iterator& lhs, const iterator& rhs) noexcept {
+			return lhs.current != rhs.current;
+		}
+
+		friend bool operator<(const iterator& lhs, const iterator& rhs) noexcept {
+			return lhs - rhs < 0;
+		}
+
+		friend bool operator>(const iterator& lhs, const iterator& rhs) noexcept {
+			return rhs < lhs;
+		}
+
+		friend bool operator<=(const iterator& lhs, const iterator& rhs) noexcept {
+			return !(rhs < lhs);
+		}
+
+		friend bool operator>=(const iterator& lhs, const iterator& rhs) noexcept {
+			return !(lhs < rhs);
+		}
+
+	private:
+		friend class PixelSpan<T>;
+
+		iterator(T* position, mint stride) noexcept : current(position), step(stride) {}
+
+		T* current = nullptr;
+		mint step = 1;
+	};
+
+	/**
+	 * @brief   Direct, allocation-free access to the values of an Image, both interleaved and planar.
+	 *
+	 * Unlike TypedImage::get and TypedImage::set, which go through LibraryLink for every value, PixelAccessor reads the image layout once
+	 * and then computes positions of values with plain integer arithmetic. All coordinates are 0-based. Element access with operator() is
+	 * not bound-checked, use at() for checked access. PixelAccessor does not own the data, so the Image must outlive it.
+	 *
+	 * @tparam  T - type of image data, use const T for read-only access
+	 */
+	template<typename T>
+	class PixelAccessor {
+	public:
+		/// Type of the values
+		using value_type = std::remove_cv_t<T>;
+
+	public:
+		PixelAccessor() = default;
+
+		/**
+		 * @brief   Create an accessor over raw image data
+		 * @param   data - pointer to the first value of the image
+		 * @param   layout - shape and strides of the image
+		 */
+		PixelAccessor(T* data, const ImageLayout& layout) noexcept : origin(data), shape(layout) {}
+
+		/**
+		 * @brief   Create an accessor for an Image<T> or ImageTypedView<T>
+		 * @param   im - image, must outlive the accessor
+		 */
+		template<class ImageT, typename = std::enable_if_t<std::is_base_of_v<ImageInterface, std::remove_cv_t<ImageT>>>>
+		explicit PixelAccessor(ImageT& im) : PixelAccessor(im.data(), ImageLayout::of(im)) {}
+
+		/// Get the layout of the image
+		const ImageLayout& layout() const noexcept {
+			return shape;
+		}
+
+		/// Get the pointer to the first value of the image
+		T* data() const noexcept {
+			return origin;
+		}
+
+		/// Get the value of a channel of a pixel in 2D image (or in the first slice of a 3D image), without bound checking
+		T& operator()(mint row, mint column, mint channel) const noexcept {
+			return origin[row * shape.rowStride + column * shape.columnStride + channel * shape.channelStride];
+		}
+
+		/// Get the value of a channel of a pixel in 3D image, without bound checking
+		T& operator()(mint slice, mint row, mint column, mint channel) const noexcept {
+			return origin[slice * shape.sliceStride + row * shape.rowStride + column * shape.columnStride + channel * shape.channelStride];
+		}
+
+		/**
+		 * @brief   Get the value of a channel of a pixel in 2D image, with bound checking
+		 * @throws  ErrorName::ImageIndexError - if the specified coordinates are out-of-bound
+		 */
+		T& at(mint row, mint column, mint channel) const {
+			return at(0, row, column, channel);
+		}
+
+		/**
+		 * @brief   Get the value of a channel of a pixel in 3D image, with bound checking
+		 * @throws  ErrorName::ImageIndexError - if the specified coordinates are out-of-bound
+		 */
+		T& at(mint slice, mint row, mint column, mint channel) const {
+			if (!shape.contains(slice, row, column, channel)) {
+				ErrorManager::throwException(ErrorName::ImageIndexError);
+			}
+			return (*this)(slice, row, column, channel);
+		}
+
+		/**
+		 * @brief   Get an accessor for a single frame of a 3D image, which behaves like an accessor for a 2D image
+		 * @param   slice - slice index, without bound checking
+		 */
+		PixelAccessor frame(mint slice) const noexcept {
+			ImageLayout frameShape = shape;
+			frameShape.slices = 1;
+			return {origin + slice * shape.sliceStride, frameShape};
+		}
+
+		/**
+		 * @brief   Get the values of a single channel along a row of pixels, without bound checking
+		 * @param   row - row index
+		 * @param   channel - channel index
+		 * @param   slice - slice index, 0 for 2D images
+		 */
+		PixelSpan<T> row(mint row, mint channel, mint slice = 0) const noexcept {
+			return {&(*this)(slice, row, 0, channel), shape.columns, shape.columnStride};
+		}
+
+		/**
+		 * @brief   Get the values of all channels of a single pixel, without bound checking
+		 * @param   row - row index
+		 * @param   column - column index
+		 * @param   slice - slice index, 0 for 2D images
+		 */
+		PixelSpan<T> pixel(mint row, mint column, mint slice = 0) const noexcept {
+			return {&(*this)(slice, row, column, 0), shape.channels, shape.channelStride};
+		}
+
+		/**
+		 * @brief   Call \p f on every pixel of the image, in the order of slices, rows and columns.
+		 * @details \p f is called either with a PixelSpan over channels of a pixel or, if it accepts more arguments, with the span followed
+		 * by slice, row and column index of the pixel. The layout is read once, the loop itself does no checks and no library calls.
+		 * @param   f - function to be called on every pixel
+		 */
+		template<typename F>
+		void forEachPixel(F&& f) const {
+			for (mint s = 0; s < shape.slices; ++s) {
+				for (mint r = 0; r < shape.rows; ++r) {
+					T* p = &(*this)(s, r, 0, 0);
+					for (mint c = 0; c < shape.columns; ++c, p += shape.columnStride) {
+						PixelSpan<T> channels {p, shape.channels, shape.channelStride};
+						if constexpr (std::is_invocable_v<F&, PixelSpan<T>>) {
+							f(channels);
+						} else {
+							f(channels, s, r, c);
+						}
+					}
+				}
+			}
+		}
+
+	private:
+		T* origin = nullptr;
+		ImageLayout shape;
+	};
+
+	/**
+	 * @brief   Create a PixelAccessor for given image
+	 * @param   im - Image<T> or ImageTypedView<T>, use a const reference for read-only access
+	 */
+	template<class ImageT>
+	auto pixels(ImageT& im) {
+		return PixelAccessor<std::remove_pointer_t<decltype(im.data())>> {im};
+	}
+
+}  // namespace LLU
+
+#endif	  // LLU_CONTAINERS_VIEWS_PIXELS_HPP
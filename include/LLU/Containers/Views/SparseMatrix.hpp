@@ -0,0 +1,491 @@
+/**
+ * @file	SparseMatrix.hpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Zero-copy CSR view over a rank 2 SparseArray and sparse matrix products built on top of it.
+ */
+#ifndef LLU_CONTAINERS_VIEWS_SPARSEMATRIX_HPP
+#define LLU_CONTAINERS_VIEWS_SPARSEMATRIX_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+#include "LLU/Containers/SparseArray.h"
+#include "LLU/Containers/Tensor.h"
+#include "LLU/ErrorLog/ErrorManager.h"
+
+namespace LLU {
+
+	/**
+	 * @brief   Single explicitly stored element of a sparse matrix
+	 * @tparam  T - type of the value
+	 */
+	template<typename T>
+	struct SparseEntry {
+		/// 0-based column index
+		mint column;
+
+		/// Value of the element
+		T value;
+	};
+
+	/**
+	 * @brief   Explicitly stored elements of a single row of a sparse matrix, in the order of increasing column indices
+	 * @tparam  T - type of the values
+	 */
+	template<typename T>
+	class SparseRow {
+	public:
+		/// Iterator over entries of the row, dereferencing yields SparseEntry<T>
+		class iterator;
+
+	public:
+		SparseRow() = default;
+
+		/**
+		 * @brief   Create a row from raw CSR data
+		 * @param   columns - 1-based column indices, as stored by MSparseArray
+		 * @param   values - explicit values
+		 * @param   length - number of explicit elements in the row
+		 */
+		SparseRow(const mint* columns, const T* values, mint length) noexcept : cols(columns), vals(values), length(length) {}
+
+		/// Get the number of explicitly stored elements
+		mint size() const noexcept {
+			return length;
+		}
+
+		/// Check if there are no explicitly stored elements in the row
+		[[nodiscard]] bool empty() const noexcept {
+			return length == 0;
+		}
+
+		/// Get the 0-based column index of the \p k-th explicit element, without bound checking
+		mint column(mint k) const noexcept {
+			return cols[k] - 1;
+		}
+
+		/// Get the value of the \p k-th explicit element, without bound checking
+		const T& value(mint k) const noexcept {
+			return vals[k];
+		}
+
+		/// Get the explicit values of the row as a contiguous array of size() elements
+		const T* values() const noexcept {
+			return vals;
+		}
+
+		/// Get iterator to the first entry
+		iterator begin() const noexcept {
+			return iterator {this, 0};
+		}
+
+		/// Get iterator past the last entry
+		iterator end() const noexcept {
+			return iterator {this, length};
+		}
+
+	private:
+		const mint* cols = nullptr;
+		const T* vals = nullptr;
+		mint length = 0;
+	};
+
+	/**
+	 * @brief   Iterator over entries of a SparseRow
+	 */
+	template<typename T>
+	class SparseRow<T>::iterator {
+	public:
+		/// @cond
+		using iterator_category = std::input_iterator_tag;
+		using value_type = SparseEntry<T>;
+		using difference_type = mint;
+		using pointer = void;
+		using reference = SparseEntry<T>;
+		/// @endcond
+
+		iterator() = default;
+
+		/// Get the current entry
+		SparseEntry<T> operator*() const noexcept {
+			return {row->column(pos), row->value(pos)};
+		}
+
+		/// Pre-increment
+		iterator& operator++() noexcept {
+			++pos;
+			return *this;
+		}
+
+		/// Post-increment
+		iterator operator++(int) noexcept {
+			auto tmp = *this;
+			++pos;
+			return tmp;
+		}
+
+		/// Compare two iterators
+		friend bool operator==(const iterator& lhs, const iterator& rhs) noexcept {
+			return lhs.row == rhs.row && lhs.pos == rhs.pos;
+		}
+
+		/// Compare two iterators
+		friend bool operator!=(const iterator& lhs, const iterator& rhs) noexcept {
+			return !(lhs == rhs);
+		}
+
+	private:
+		friend class SparseRow<T>;
+
+		iterator(const SparseRow* r, mint position) noexcept : row(r), pos(position) {}
+
+		const SparseRow* row = nullptr;
+		mint pos = 0;
+	};
+
+	/**
+	 * @class   SparseMatrixView
+	 * @brief   Non-owning view over the compressed sparse row (CSR) representation of a rank 2 SparseArray.
+	 *
+	 * Row pointers, column indices and explicit values are obtained from LibraryLink once, at construction, and accessed directly afterwards.
+	 * No data is copied, so the SparseArray must outlive the view and must not be modified while the view is in use.
+	 *
+	 * @tparam  T - type of the values (mint, double or std::complex<double>)
+	 */
+	template<typename T>
+	class SparseMatrixView {
+	public:
+		/// Type of the values
+		using value_type = T;
+
+		/// Iterator over rows of the matrix, dereferencing yields SparseRow<T>
+		class iterator;
+
+	public:
+		SparseMatrixView() = default;
+
+		/**
+		 * @brief   Create a view over raw CSR arrays laid out like in MSparseArray
+		 * @param   rows - number of rows
+		 * @param   columns - number of columns
+		 * @param   rowPointers - rows + 1 cumulative counts of explicit elements, starting with 0
+		 * @param   columnIndices - 1-based column indices of explicit elements, sorted within each row
+		 * @param   values - explicit values
+		 * @param   implicitValue - value of elements which are not stored explicitly
+		 */
+		SparseMatrixView(mint rows, mint columns, const mint* rowPointers, const mint* columnIndices, const T* values, T implicitValue = T {}) noexcept
+			: rowCount(rows), columnCount(columns), rowPtr(rowPointers), cols(columnIndices), vals(values), implicit(implicitValue) {}
+
+		/**
+		 * @brief   Create a CSR view over a SparseArray
+		 * @param   sa - SparseArray of rank 2
+		 * @throws  ErrorName::RankError - if the rank of \p sa is not 2
+		 */
+		explicit SparseMatrixView(const SparseArray<T>& sa) {
+			if (sa.rank() != 2) {
+				ErrorManager::throwException(ErrorName::RankError);
+			}
+			rowCount = sa.getDimensions()[0];
+			columnCount = sa.getDimensions()[1];
+			rowPtr = sa.rowPointers().data();
+			cols = sa.columnIndices().data();
+			vals = sa.explicitValues().data();
+			implicit = sa.implicitValue();
+		}
+
+		/// Get the number of rows
+		mint rows() const noexcept {
+			return rowCount;
+		}
+
+		/// Get the number of columns
+		mint columns() const noexcept {
+			return columnCount;
+		}
+
+		/// Get the total number of explicitly stored elements
+		mint nonzeros() const noexcept {
+			return rowCount > 0 ? rowPtr[rowCount] : 0;
+		}
+
+		/// Get the value of elements which are not stored explicitly
+		T implicitValue() const noexcept {
+			return implicit;
+		}
+
+		/// Get the explicitly stored elements of row \p i, without bound checking
+		SparseRow<T> operator[](mint i) const noexcept {
+			return {cols + rowPtr[i], vals + rowPtr[i], rowPtr[i + 1] - rowPtr[i]};
+		}
+
+		/**
+		 * @brief   Get the explicitly stored elements of row \p i, with bound checking
+		 * @throws  ErrorName::MArrayElementIndexError - if \p i is out-of-bounds
+		 */
+		SparseRow<T> row(mint i) const {
+			if (i < 0 || i >= rowCount) {
+				ErrorManager::throwException(ErrorName::MArrayElementIndexError, i);
+			}
+			return (*this)[i];
+		}
+
+		/// Get iterator to the first row
+		iterator begin() const noexcept {
+			return iterator {this, 0};
+		}
+
+		/// Get iterator past the last row
+		iterator end() const noexcept {
+			return iterator {this, rowCount};
+		}
+
+	private:
+		mint rowCount = 0;
+		mint columnCount = 0;
+		const mint* rowPtr = nullptr;
+		const mint* cols = nullptr;
+		const T* vals = nullptr;
+		T implicit {};
+	};
+
+	/**
+	 * @brief   Iterator over rows of a SparseMatrixView
+	 */
+	template<typename T>
+	class SparseMatrixView<T>::iterator {
+	public:
+		/// @cond
+		using iterator_category = std::input_iterator_tag;
+		using value_type = SparseRow<T>;
+		using difference_type = mint;
+		using pointer = void;
+		using reference = SparseRow<T>;
+		/// @endcond
+
+		iterator() = default;
+
+		/// Get the current row
+		SparseRow<T> operator*() const noexcept {
+			return (*matrix)[pos];
+		}
+
+		/// Pre-increment
+		iterator& operator++() noexcept {
+			++pos;
+			return *this;
+		}
+
+		/// Post-increment
+		iterator operator++(int) noexcept {
+			auto tmp = *this;
+			++pos;
+			return tmp;
+		}
+
+		/// Compare two iterators
+		friend bool operator==(const iterator& lhs, const iterator& rhs) noexcept {
+			return lhs.matrix == rhs.matrix && lhs.pos == rhs.pos;
+		}
+
+		/// Compare two iterators
+		friend bool operator!=(const iterator& lhs, const iterator& rhs) noexcept {
+			return !(lhs == rhs);
+		}
+
+	private:
+		friend class SparseMatrixView<T>;
+
+		iterator(const SparseMatrixView* m, mint position) noexcept : matrix(m), pos(position) {}
+
+		const SparseMatrixView* matrix = nullptr;
+		mint pos = 0;
+	};
+
+	namespace Sparse {
+		/**
+		 * @brief   Compute rows [firstRow, lastRow) of the product of a sparse matrix and a dense vector
+		 * @param   a - sparse matrix
+		 * @param   x - dense vector of a.columns() elements
+		 * @param   y - output vector of a.rows() elements, only the requested rows are written
+		 * @param   firstRow - first row to be computed
+		 * @param   lastRow - row past the last row to be computed
+		 * @param   xSum - sum of all elements of \p x, only used when the implicit value of \p a is not 0
+		 */
+		template<typename T>
+		void multiplyRows(const SparseMatrixView<T>& a, const T* x, T* y, mint firstRow, mint lastRow, T xSum = T {}) noexcept {
+			const T implicit = a.implicitValue();
+			for (mint i = firstRow; i < lastRow; ++i) {
+				const auto row = a[i];
+				T acc {};
+				T covered {};
+				for (mint k = 0; k < row.size(); ++k) {
+					const T xk = x[row.column(k)];
+					acc += row.value(k) * xk;
+					covered += xk;
+				}
+				y[i] = (implicit == T {}) ? acc : acc + implicit * (xSum - covered);
+			}
+		}
+
+		/**
+		 * @brief   Compute rows [firstRow, lastRow) of the product of a sparse matrix and a dense row-major matrix
+		 * @param   a - sparse matrix
+		 * @param   b - dense matrix with a.columns() rows and \p n columns
+		 * @param   n - number of columns of \p b
+		 * @param   c - output matrix with a.rows() rows and \p n columns, only the requested rows are written
+		 * @param   firstRow - first row to be computed
+		 * @param   lastRow - row past the last row to be computed
+		 * @param   bColumnSums - sums of columns of \p b, only used when the implicit value of \p a is not 0
+		 */
+		template<typename T>
+		void multiplyRows(const SparseMatrixView<T>& a, const T* b, mint n, T* c, mint firstRow, mint lastRow, const T* bColumnSums = nullptr) {
+			const T implicit = a.implicitValue();
+			std::vector<T> covered;
+			if (implicit != T {}) {
+				covered.resize(static_cast<std::size_t>(n));
+			}
+			for (mint i = firstRow; i < lastRow; ++i) {
+				T* out = c + i * n;
+				std::fill_n(out, n, T {});
+				std::fill(covered.begin(), covered.end(), T {});
+				const auto row = a[i];
+				for (mint k = 0; k < row.size(); ++k) {
+					const T v = row.value(k);
+					const T* bRow = b + row.column(k) * n;
+					for (mint j = 0; j < n; ++j) {
+						out[j] += v * bRow[j];
+					}
+					if (implicit != T {}) {
+						for (mint j = 0; j < n; ++j) {
+							covered[j] += bRow[j];
+						}
+					}
+				}
+				if (implicit != T {}) {
+					for (mint j = 0; j < n; ++j) {
+						out[j] += implicit * (bColumnSums[j] - covered[j]);
+					}
+				}
+			}
+		}
+
+		/**
+		 * @brief   Write rows [firstRow, lastRow) of the dense form of a sparse matrix
+		 * @param   a - sparse matrix
+		 * @param   out - output row-major matrix with a.rows() rows and a.columns() columns, only the requested rows are written
+		 * @param   firstRow - first row to be written
+		 * @param   lastRow - row past the last row to be written
+		 */
+		template<typename T>
+		void densifyRows(const SparseMatrixView<T>& a, T* out, mint firstRow, mint lastRow) noexcept {
+			const mint n = a.columns();
+			for (mint i = firstRow; i < lastRow; ++i) {
+				T* rowOut = out + i * n;
+				std::fill_n(rowOut, n, a.implicitValue());
+				const auto row = a[i];
+				for (mint k = 0; k < row.size(); ++k) {
+					rowOut[row.column(k)] = row.value(k);
+				}
+			}
+		}
+
+		/**
+		 * @brief   Count elements of a dense row that differ from the implicit value
+		 * @details The loop has no branches, so that it can be vectorized.
+		 */
+		template<typename T>
+		mint countExplicit(const T* row, mint n, T implicitValue) noexcept {
+			mint count = 0;
+			for (mint j = 0; j < n; ++j) {
+				count += static_cast<mint>(row[j] != implicitValue);
+			}
+			return count;
+		}
+
+		/**
+		 * @brief   Collect explicit elements of rows [firstRow, lastRow) of a dense row-major matrix
+		 * @param   dense - dense matrix with \p columns columns
+		 * @param   columns - number of columns of \p dense
+		 * @param   implicitValue - value of elements which are not stored explicitly
+		 * @param   rowPointers - cumulative counts of explicit elements, e.g. prefix sums of countExplicit for every row
+		 * @param   positions - output 1-based {row, column} pairs ordered like in MSparseArray_fromExplicitPositions, only the requested rows are written
+		 * @param   values - output explicit values, only the requested rows are written
+		 * @param   firstRow - first row to be processed
+		 * @param   lastRow - row past the last row to be processed
+		 */
+		template<typename T>
+		void sparsifyRows(const T* dense, mint columns, T implicitValue, const mint* rowPointers, mint* positions, T* values, mint firstRow,
+						  mint lastRow) noexcept {
+			for (mint i = firstRow; i < lastRow; ++i) {
+				const T* row = dense + i * columns;
+				mint k = rowPointers[i];
+				for (mint j = 0; j < columns; ++j) {
+					if (row[j] != implicitValue) {
+						positions[2 * k] = i + 1;
+						positions[2 * k + 1] = j + 1;
+						values[k] = row[j];
+						++k;
+					}
+				}
+			}
+		}
+
+		/// @cond
+		namespace Detail {
+			/// Check dimensions of the dense operand and create the result of a sparse-dense product
+			template<typename T>
+			Tensor<T> productResult(const SparseMatrixView<T>& a, const Tensor<T>& b) {
+				const auto rank = b.rank();
+				if (rank != 1 && rank != 2) {
+					ErrorManager::throwException(ErrorName::RankError);
+				}
+				if (b.dimension(0) != a.columns()) {
+					ErrorManager::throwException(ErrorName::DimensionsError);
+				}
+				return rank == 1 ? Tensor<T>(T {}, {a.rows()}) : Tensor<T>(T {}, {a.rows(), b.dimension(1)});
+			}
+
+			/// Sums of columns of a dense row-major matrix, or the sum of a vector for n == 1
+			template<typename T>
+			std::vector<T> columnSums(const T* b, mint m, mint n) {
+				std::vector<T> sums(static_cast<std::size_t>(n));
+				for (mint i = 0; i < m; ++i) {
+					for (mint j = 0; j < n; ++j) {
+						sums[j] += b[i * n + j];
+					}
+				}
+				return sums;
+			}
+		}  // namespace Detail
+		/// @endcond
+
+		/**
+		 * @brief   Multiply a sparse matrix by a dense vector or matrix
+		 * @param   a - sparse matrix
+		 * @param   b - Tensor of rank 1 with a.columns() elements, or of rank 2 with a.columns() rows
+		 * @return  Tensor of the same rank as \p b, with a.rows() rows
+		 * @throws  ErrorName::RankError - if the rank of \p b is not 1 or 2
+		 * @throws  ErrorName::DimensionsError - if the dimensions of \p a and \p b do not match
+		 */
+		template<typename T>
+		Tensor<T> dot(const SparseMatrixView<T>& a, const Tensor<T>& b) {
+			auto result = Detail::productResult(a, b);
+			const mint n = b.rank() == 1 ? 1 : b.dimension(1);
+			std::vector<T> sums;
+			if (a.implicitValue() != T {}) {
+				sums = Detail::columnSums(b.data(), a.columns(), n);
+			}
+			if (b.rank() == 1) {
+				multiplyRows(a, b.data(), result.data(), 0, a.rows(), sums.empty() ? T {} : sums[0]);
+			} else {
+				multiplyRows(a, b.data(), n, result.data(), 0, a.rows(), sums.data());
+			}
+			return result;
+		}
+	}  // namespace Sparse
+
+}  // namespace LLU
+
+#endif	  // LLU_CONTAINERS_VIEWS_SPARSEMATRIX_HPP
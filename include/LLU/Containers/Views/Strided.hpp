@@ -0,0 +1,437 @@
+/**
+ * @file
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Definition and implementation of StridedView, a non-owning multidimensional view with arbitrary strides.
+ */
+#ifndef LLU_CONTAINERS_VIEWS_STRIDED_HPP
+#define LLU_CONTAINERS_VIEWS_STRIDED_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "LLU/Containers/MArrayDimensions.h"
+#include "LLU/ErrorLog/ErrorManager.h"
+
+namespace LLU {
+
+	/**
+	 * @brief   Non-owning view over a multidimensional array of elements laid out with arbitrary strides, similar to std::mdspan.
+	 *
+	 * A StridedView is cheap to create from any MArray (see MArray::view) and lets you work on rows, columns, sub-blocks or transposed arrays
+	 * without copying the data. All operations that produce new views (slice, subarray, transposed, permuted) only manipulate dimensions
+	 * and strides. Elements are visited in row-major order of the view, and the innermost loop of forEach runs over the last dimension
+	 * with a plain pointer increment, so it can be vectorized when the last stride is 1.
+	 *
+	 * @tparam  T - type of the elements, use const T for read-only views
+	 */
+	template<typename T>
+	class StridedView {
+		template<typename>
+		friend class StridedView;
+
+	public:
+		/// Type of elements in the view, may be const-qualified
+		using element_type = T;
+
+		/// Type of element values
+		using value_type = std::remove_cv_t<T>;
+
+		/// Reference type
+		using reference = T&;
+
+		/// Pointer type
+		using pointer = T*;
+
+		/// Forward iterator over all elements of the view in row-major order
+		class iterator;
+
+		/// All iterators of a view give access to the same elements
+		using const_iterator = iterator;
+
+	public:
+		StridedView() = default;
+
+		/**
+		 * @brief   Create a view of a contiguous row-major array
+		 * @param   data - pointer to the first element
+		 * @param   dimensions - dimensions of the array
+		 */
+		StridedView(T* data, const MArrayDimensions& dimensions) : origin(data), dims(dimensions.getDimensionsVector()), steps(dims.size(), 1) {
+			for (auto d = rank() - 1; d > 0; --d) {
+				steps[d - 1] = steps[d] * dims[d];
+			}
+		}
+
+		/**
+		 * @brief   Create a view with explicitly given dimensions and strides
+		 * @param   data - pointer to the element with all coordinates equal to 0
+		 * @param   dimensions - dimensions of the view
+		 * @param   strides - distance (in elements) between consecutive elements along each dimension
+		 * @throws  ErrorName::DimensionsError - if \p dimensions and \p strides have different lengths or any dimension is negative
+		 */
+		StridedView(T* data, const std::vector<mint>& dimensions, const std::vector<mint>& strides) : origin(data), dims(dimensions), steps(strides) {
+			if (dims.size() != steps.size() || std::any_of(dims.cbegin(), dims.cend(), [](mint d) { return d < 0; })) {
+				ErrorManager::throwException(ErrorName::DimensionsError);
+			}
+		}
+
+		/**
+		 * @brief   Convert a view of mutable elements to a read-only view
+		 * @param   other - view of non-const elements
+		 */
+		template<typename U, typename = std::enable_if_t<std::is_same_v<T, const U>>>
+		StridedView(const StridedView<U>& other) : origin(other.origin), dims(other.dims), steps(other.steps) {}	// NOLINT: implicit like T* to const T*
+
+		/// Get the number of dimensions
+		mint rank() const noexcept {
+			return static_cast<mint>(dims.size());
+		}
+
+		/**
+		 * @brief   Get a single dimension
+		 * @param   dim - index of the dimension
+		 * @throws  ErrorName::MArrayDimensionIndexError - if \p dim is out-of-bounds
+		 */
+		mint dimension(mint dim) const {
+			return dims[checkDimensionIndex(dim)];
+		}
+
+		/**
+		 * @brief   Get the stride along a single dimension
+		 * @param   dim - index of the dimension
+		 * @throws  ErrorName::MArrayDimensionIndexError - if \p dim is out-of-bounds
+		 */
+		mint stride(mint dim) const {
+			return steps[checkDimensionIndex(dim)];
+		}
+
+		/// Get all dimensions of the view
+		const DimensionsVector& dimensions() const noexcept {
+			return dims;
+		}
+
+		/// Get all strides of the view
+		const DimensionsVector& strides() const noexcept {
+			return steps;
+		}
+
+		/// Get the total number of elements in the view
+		mint size() const noexcept {
+			return std::accumulate(dims.cbegin(), dims.cend(), mint {1}, std::multiplies<>());
+		}
+
+		/// Check if the view has no elements
+		[[nodiscard]] bool empty() const noexcept {
+			return size() == 0;
+		}
+
+		/// Get the pointer to the element with all coordinates equal to 0
+		T* data() const noexcept {
+			return origin;
+		}
+
+		/// Check if the elements of the view occupy a contiguous block of memory in row-major order, so that data() can be used as a flat array
+		bool isContiguous() const noexcept {
+			mint expected = 1;
+			for (auto d = rank(); d > 0; --d) {
+				if (dims[d - 1] != 1 && steps[d - 1] != expected) {
+					return false;
+				}
+				expected *= dims[d - 1];
+			}
+			return true;
+		}
+
+		/**
+		 * @brief   Get an element given its coordinates, without any bound checking
+		 * @param   indices - coordinates of the element, one for each dimension
+		 */
+		template<typename... Indices>
+		T& operator()(Indices... indices) const {
+			static_assert((std::is_integral_v<Indices> && ...), "Indices must be integral.");
+			mint offset = 0;
+			std::size_t d = 0;
+			((offset += static_cast<mint>(indices) * steps[d++]), ...);
+			return origin[offset];
+		}
+
+		/**
+		 * @brief   Get an element given its coordinates, without any bound checking
+		 * @param   indices - coordinates of the element
+		 */
+		T& operator[](const std::vector<mint>& indices) const {
+			return origin[std::inner_product(indices.cbegin(), indices.cend(), steps.cbegin(), mint {0})];
+		}
+
+		/**
+		 * @brief   Get an element given its coordinates, with bound checking
+		 * @param   indices - coordinates of the element
+		 * @throws  ErrorName::MArrayDimensionIndexError - if the number of coordinates is different from the rank
+		 * @throws  ErrorName::MArrayElementIndexError - if any coordinate is out of bounds
+		 */
+		T& at(const std::vector<mint>& indices) const {
+			if (static_cast<mint>(indices.size()) != rank()) {
+				ErrorManager::throwException(ErrorName::MArrayDimensionIndexError, static_cast<mint>(indices.size()));
+			}
+			for (std::size_t d = 0; d < dims.size(); ++d) {
+				checkElementIndex(indices[d], dims[d]);
+			}
+			return (*this)[indices];
+		}
+
+		/**
+		 * @brief   Fix one coordinate, obtaining a view of rank one less, e.g. a row (dim = 0) or a column (dim = 1) of a matrix
+		 * @param   dim - dimension to fix
+		 * @param   index - value of the coordinate along \p dim
+		 * @throws  ErrorName::MArrayDimensionIndexError - if \p dim is out-of-bounds
+		 * @throws  ErrorName::MArrayElementIndexError - if \p index is out-of-bounds
+		 */
+		StridedView slice(mint dim, mint index) const {
+			auto d = checkDimensionIndex(dim);
+			checkElementIndex(index, dims[d]);
+			StridedView res {*this};
+			res.origin += index * steps[d];
+			res.dims.erase(std::next(res.dims.begin(), static_cast<std::ptrdiff_t>(d)));
+			res.steps.erase(std::next(res.steps.begin(), static_cast<std::ptrdiff_t>(d)));
+			return res;
+		}
+
+		/**
+		 * @brief   Restrict the view to a rectangular block [lo, hi)
+		 * @param   lo - first coordinate of the block along each dimension
+		 * @param   hi - coordinate past the end of the block along each dimension
+		 * @throws  ErrorName::DimensionsError - if \p lo or \p hi have wrong length
+		 * @throws  ErrorName::MArrayElementIndexError - if the bounds do not satisfy 0 <= lo <= hi <= dimension
+		 */
+		StridedView subarray(const std::vector<mint>& lo, const std::vector<mint>& hi) const {
+			if (lo.size() != dims.size() || hi.size() != dims.size()) {
+				ErrorManager::throwException(ErrorName::DimensionsError);
+			}
+			StridedView res {*this};
+			for (std::size_t d = 0; d < dims.size(); ++d) {
+				if (lo[d] < 0 || lo[d] > hi[d]) {
+					ErrorManager::throwException(ErrorName::MArrayElementIndexError, lo[d]);
+				}
+				if (hi[d] > dims[d]) {
+					ErrorManager::throwException(ErrorName::MArrayElementIndexError, hi[d]);
+				}
+				res.origin += lo[d] * steps[d];
+				res.dims[d] = hi[d] - lo[d];
+			}
+			return res;
+		}
+
+		/// Get a view with the order of dimensions reversed, e.g. the transposed matrix
+		StridedView transposed() const {
+			StridedView res {*this};
+			std::reverse(res.dims.begin(), res.dims.end());
+			std::reverse(res.steps.begin(), res.steps.end());
+			return res;
+		}
+
+		/**
+		 * @brief   Get a view with dimensions reordered
+		 * @param   order - permutation of {0, ..., rank - 1}, dimension i of the new view is dimension order[i] of this view
+		 * @throws  ErrorName::DimensionsError - if \p order is not a permutation
+		 */
+		StridedView permuted(const std::vector<mint>& order) const {
+			DimensionsVector seen(dims.size(), 0);
+			if (order.size() != dims.size()) {
+				ErrorManager::throwException(ErrorName::DimensionsError);
+			}
+			StridedView res {*this};
+			for (std::size_t d = 0; d < order.size(); ++d) {
+				auto from = order[d];
+				if (from < 0 || from >= rank() || seen[static_cast<std::size_t>(from)]) {
+					ErrorManager::throwException(ErrorName::DimensionsError);
+				}
+				seen[static_cast<std::size_t>(from)] = 1;
+				res.dims[d] = dims[static_cast<std::size_t>(from)];
+				res.steps[d] = steps[static_cast<std::size_t>(from)];
+			}
+			return res;
+		}
+
+		/**
+		 * @brief   Get a view of the same elements with different dimensions, without copying
+		 * @param   newDims - new dimensions, with the same total number of elements
+		 * @throws  ErrorName::DimensionsError - if the number of elements differs or the view is not contiguous
+		 */
+		StridedView reshaped(const MArrayDimensions& newDims) const {
+			if (newDims.flatCount() != size() || !isContiguous()) {
+				ErrorManager::throwException(ErrorName::DimensionsError);
+			}
+			return StridedView {origin, newDims};
+		}
+
+		/**
+		 * @brief   Call \p f on every element of the view in row-major order.
+		 * @details This is the fastest way to visit all elements. The innermost loop runs over the last dimension and for unit stride it is
+		 * a plain loop over consecutive memory.
+		 * @param   f - function taking a reference to an element
+		 */
+		template<typename F>
+		void forEach(F&& f) const {
+			if (empty()) {
+				return;
+			}
+			if (dims.empty()) {
+				f(*origin);
+				return;
+			}
+			const auto inner = dims.back();
+			const auto innerStep = steps.back();
+			DimensionsVector index(dims.size() - 1, 0);
+			T* line = origin;
+			for (;;) {
+				if (innerStep == 1) {
+					for (mint i = 0; i < inner; ++i) {
+						f(line[i]);
+					}
+				} else {
+					for (mint i = 0; i < inner; ++i) {
+						f(line[i * innerStep]);
+					}
+				}
+				auto d = static_cast<mint>(index.size()) - 1;
+				for (; d >= 0; --d) {
+					line += steps[d];
+					if (++index[d] < dims[d]) {
+						break;
+					}
+					line -= steps[d] * dims[d];
+					index[d] = 0;
+				}
+				if (d < 0) {
+					return;
+				}
+			}
+		}
+
+		/// Get iterator to the first element
+		iterator begin() const {
+			return iterator {this, 0};
+		}
+
+		/// Get iterator past the last element
+		iterator end() const {
+			return iterator {this, size()};
+		}
+
+	private:
+		T* origin = nullptr;
+		DimensionsVector dims;
+		DimensionsVector steps;
+
+		std::size_t checkDimensionIndex(mint dim) const {
+			if (dim < 0 || dim >= rank()) {
+				ErrorManager::throwException(ErrorName::MArrayDimensionIndexError, dim);
+			}
+			return static_cast<std::size_t>(dim);
+		}
+
+		static void checkElementIndex(mint index, mint dimension) {
+			if (index < 0 || index >= dimension) {
+				ErrorManager::throwException(ErrorName::MArrayElementIndexError, index);
+			}
+		}
+
+		/// Get the pointer to the element at position \p pos in the row-major order of the view
+		T* elementAt(mint pos) const noexcept {
+			mint offset = 0;
+			for (auto d = rank(); d > 0 && pos > 0; --d) {
+				offset += (pos % dims[d - 1]) * steps[d - 1];
+				pos /= dims[d - 1];
+			}
+			return origin + offset;
+		}
+	};
+
+	/**
+	 * @brief   Iterator over elements of a StridedView.
+	 * @details Moving along the last dimension is a single pointer increment, the position in the outer dimensions is recomputed only when
+	 * the iterator moves to the next line. The iterator does not allocate, but it refers to the view it was created from, so the view must
+	 * outlive it.
+	 */
+	template<typename T>
+	class StridedView<T>::iterator {
+	public:
+		/// @cond
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::remove_cv_t<T>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = T*;
+		using reference = T&;
+		/// @endcond
+
+		iterator() = default;
+
+		/// Access the element
+		reference operator*() const noexcept {
+			return *current;
+		}
+
+		/// Access the element
+		pointer operator->() const noexcept {
+			return current;
+		}
+
+		/// Move to the next element
+		iterator& operator++() noexcept {
+			++pos;
+			if (--lineLeft > 0) {
+				current += innerStep;
+			} else {
+				startLine();
+			}
+			return *this;
+		}
+
+		/// Move to the next element, returning the previous state
+		iterator operator++(int) noexcept {
+			auto tmp = *this;
+			++(*this);
+			return tmp;
+		}
+
+		/// Iterators are equal if they point to the same position of the same view
+		friend bool operator==(const iterator& lhs, const iterator& rhs) noexcept {
+			return lhs.pos == rhs.pos && lhs.view == rhs.view;
+		}
+
+		/// Iterators are different if they point to different positions or views
+		friend bool operator!=(const iterator& lhs, const iterator& rhs) noexcept {
+			return !(lhs == rhs);
+		}
+
+	private:
+		friend class StridedView<T>;
+
+		const StridedView<T>* view = nullptr;
+		mint pos = 0;
+		mint count = 0;
+		T* current = nullptr;
+		mint lineLeft = 0;
+		mint innerStep = 0;
+
+		iterator(const StridedView<T>* v, mint position)
+			: view(v), pos(position), count(v->size()), innerStep(v->dims.empty() ? 0 : v->steps.back()) {
+			startLine();
+		}
+
+		void startLine() noexcept {
+			if (pos >= count) {
+				return;
+			}
+			current = view->elementAt(pos);
+			lineLeft = view->dims.empty() ? 1 : view->dims.back() - pos % view->dims.back();
+		}
+	};
+
+}  // namespace LLU
+
+#endif	  // LLU_CONTAINERS_VIEWS_STRIDED_HPP
@@ -8,6 +8,7 @@
 
 #include "LLU/Containers/Generic/Tensor.hpp"
 #include "LLU/Containers/Interfaces.h"
+#include "LLU/Containers/MArrayDimensions.h"
 #include "LLU/Containers/Iterators/IterableContainer.hpp"
 
 namespace LLU {
@@ -36,30 +37,35 @@ namespace LLU {
 
 		/// @copydoc TensorInterface::getRank()
 		mint getRank() const override {
-			return LibraryData::API()->MTensor_getRank(t);
+			return LibraryData::uncheckedAPI()->MTensor_getRank(t);
 		}
 
 		/// @copydoc TensorInterface::getDimensions()
 		mint const* getDimensions() const override {
-			return LibraryData::API()->MTensor_getDimensions(t);
+			return LibraryData::uncheckedAPI()->MTensor_getDimensions(t);
+		}
+
+		/// Get a view of the dimensions, read directly from LibraryLink without copying
+		DimensionsView dimensions() const {
+			return {getDimensions(), getRank()};
 		}
 
 		/// @copydoc TensorInterface::getFlattenedLength()
 		mint getFlattenedLength() const override {
-			return LibraryData::API()->MTensor_getFlattenedLength(t);
+			return LibraryData::uncheckedAPI()->MTensor_getFlattenedLength(t);
 		}
 
 		/// @copydoc TensorInterface::type()
 		mint type() const final {
-			return LibraryData::API()->MTensor_getType(t);
+			return LibraryData::uncheckedAPI()->MTensor_getType(t);
 		}
 
 		/// @copydoc TensorInterface::rawData()
 		void* rawData() const override {
 			switch (type()) {
-				case MType_Integer: return LibraryData::API()->MTensor_getIntegerData(t);
-				case MType_Real: return LibraryData::API()->MTensor_getRealData(t);
-				case MType_Complex: return LibraryData::API()->MTensor_getComplexData(t);
+				case MType_Integer: return LibraryData::uncheckedAPI()->MTensor_getIntegerData(t);
+				case MType_Real: return LibraryData::uncheckedAPI()->MTensor_getRealData(t);
+				case MType_Complex: return LibraryData::uncheckedAPI()->MTensor_getComplexData(t);
 				default: return nullptr;
 			}
 		}
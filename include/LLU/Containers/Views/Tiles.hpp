@@ -0,0 +1,158 @@
+/**
+ * @file	Tiles.hpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Partitioning of Image frames into rectangular tiles, optionally with halo borders for stencil computations.
+ */
+#ifndef LLU_CONTAINERS_VIEWS_TILES_HPP
+#define LLU_CONTAINERS_VIEWS_TILES_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "LLU/Containers/Views/Pixels.hpp"
+#include "LLU/ErrorLog/ErrorManager.h"
+
+namespace LLU {
+
+	/**
+	 * @brief   Rectangular part of a single image frame.
+	 *
+	 * The interior of a tile is the region that a tile-processing function is responsible for. Interiors of all tiles of a TileGrid
+	 * cover every pixel of the image exactly once. The halo extends the interior by a fixed number of pixels in each direction, clipped
+	 * to the image, and is the region that can be read, e.g. by a convolution stencil.
+	 */
+	struct ImageTile {
+		/// Index of the frame, 0 for 2D images
+		mint slice = 0;
+
+		/// First row of the interior
+		mint row = 0;
+
+		/// First column of the interior
+		mint column = 0;
+
+		/// Number of rows of the interior
+		mint rows = 0;
+
+		/// Number of columns of the interior
+		mint columns = 0;
+
+		/// First row of the interior extended by the halo
+		mint haloRow = 0;
+
+		/// First column of the interior extended by the halo
+		mint haloColumn = 0;
+
+		/// Number of rows of the interior extended by the halo
+		mint haloRows = 0;
+
+		/// Number of columns of the interior extended by the halo
+		mint haloColumns = 0;
+	};
+
+	/**
+	 * @class   TileGrid
+	 * @brief   Regular grid of tiles covering all frames of an image.
+	 *
+	 * Tiles are numbered frame by frame and in row-major order within a frame. Tiles in the last row and column of the grid may be smaller
+	 * than the nominal tile size.
+	 */
+	class TileGrid {
+	public:
+		/// Default size of the working set of a single tile, it should fit in the L2 cache of a core
+		static constexpr std::size_t defaultCacheBytes = 256 * 1024;
+
+		TileGrid() = default;
+
+		/**
+		 * @brief   Create a grid with given tile size
+		 * @param   layout - layout of the image
+		 * @param   tileRows - number of rows in a tile, without the halo
+		 * @param   tileColumns - number of columns in a tile, without the halo
+		 * @param   halo - width of the halo border
+		 * @throws  ErrorName::ImageSizeError - if the tile size is not positive or the halo is negative
+		 */
+		TileGrid(const ImageLayout& layout, mint tileRows, mint tileColumns, mint halo = 0)
+			: frames(layout.slices), imageRows(layout.rows), imageColumns(layout.columns), tileRows(tileRows), tileColumns(tileColumns), halo(halo) {
+			if (tileRows <= 0 || tileColumns <= 0 || halo < 0) {
+				ErrorManager::throwException(ErrorName::ImageSizeError);
+			}
+			gridRows = (imageRows + tileRows - 1) / tileRows;
+			gridColumns = (imageColumns + tileColumns - 1) / tileColumns;
+		}
+
+		/**
+		 * @brief   Create a grid of square tiles such that a tile with its halo, in the input and in an output image of the same layout, fits in
+		 * \p cacheBytes of memory
+		 * @param   layout - layout of the image
+		 * @param   elementSize - size of a single channel value in bytes
+		 * @param   halo - width of the halo border
+		 * @param   cacheBytes - memory budget of a single tile
+		 */
+		static TileGrid forCache(const ImageLayout& layout, std::size_t elementSize, mint halo = 0, std::size_t cacheBytes = defaultCacheBytes) {
+			const auto pixelBytes = static_cast<double>(2 * elementSize * static_cast<std::size_t>(std::max(layout.channels, mint {1})));
+			const auto side = static_cast<mint>(std::sqrt(static_cast<double>(cacheBytes) / pixelBytes)) - 2 * halo;
+			const auto tile = std::max(side, mint {8});
+			return {layout, std::min(tile, std::max(layout.rows, mint {1})), std::min(tile, std::max(layout.columns, mint {1})), halo};
+		}
+
+		/// Get the total number of tiles in all frames
+		mint size() const noexcept {
+			return frames * tilesPerFrame();
+		}
+
+		/// Get the number of tiles in a single frame
+		mint tilesPerFrame() const noexcept {
+			return gridRows * gridColumns;
+		}
+
+		/// Get the nominal number of rows of a tile, without the halo
+		mint rowsPerTile() const noexcept {
+			return tileRows;
+		}
+
+		/// Get the nominal number of columns of a tile, without the halo
+		mint columnsPerTile() const noexcept {
+			return tileColumns;
+		}
+
+		/// Get the width of the halo border
+		mint haloWidth() const noexcept {
+			return halo;
+		}
+
+		/**
+		 * @brief   Get the tile with given index, without bound checking
+		 * @param   index - index of the tile, in [0, size())
+		 */
+		ImageTile operator[](mint index) const noexcept {
+			ImageTile t;
+			const auto perFrame = tilesPerFrame();
+			t.slice = index / perFrame;
+			const auto inFrame = index % perFrame;
+			t.row = (inFrame / gridColumns) * tileRows;
+			t.column = (inFrame % gridColumns) * tileColumns;
+			t.rows = std::min(tileRows, imageRows - t.row);
+			t.columns = std::min(tileColumns, imageColumns - t.column);
+			t.haloRow = std::max(t.row - halo, mint {0});
+			t.haloColumn = std::max(t.column - halo, mint {0});
+			t.haloRows = std::min(t.row + t.rows + halo, imageRows) - t.haloRow;
+			t.haloColumns = std::min(t.column + t.columns + halo, imageColumns) - t.haloColumn;
+			return t;
+		}
+
+	private:
+		mint frames = 0;
+		mint imageRows = 0;
+		mint imageColumns = 0;
+		mint tileRows = 1;
+		mint tileColumns = 1;
+		mint halo = 0;
+		mint gridRows = 0;
+		mint gridColumns = 0;
+	};
+
+}  // namespace LLU
+
+#endif	  // LLU_CONTAINERS_VIEWS_TILES_HPP
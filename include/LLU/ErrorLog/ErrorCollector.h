@@ -0,0 +1,159 @@
+/**
+ * @file	ErrorCollector.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief	Definition of the ErrorCollector class, which accumulates errors of individual elements processed by a batched library function.
+ */
+#ifndef LLU_ERRORLOG_ERRORCOLLECTOR_H
+#define LLU_ERRORLOG_ERRORCOLLECTOR_H
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "LLU/Containers/Tensor.h"
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/ErrorLog/LibraryLinkError.h"
+#include "LLU/LibraryData.h"
+
+namespace LLU {
+
+	/**
+	 * @class	ErrorCollector
+	 * @brief	Accumulates errors of individual elements in C++ memory and passes all of them to top-level at the end of a library function call.
+	 *
+	 * A library function that processes many elements and wants to report failures of single elements without failing as a whole records
+	 * (error id, element index, message parameters) triples in an ErrorCollector. No WSTP communication happens until the end of the call,
+	 * when the errors are either returned as a packed Integer matrix (see toTensor) or sent to top-level in a single packet (see sendFailures)
+	 * and turned into a list of Failure objects with LLU`LastCollectedFailures[].
+	 *
+	 * Errors can be added from multiple threads at the same time.
+	 */
+	class ErrorCollector {
+	public:
+		/// Single collected error
+		struct Record {
+			/// id of the registered error
+			LibraryLinkError::IdType errorId;
+			/// index of the element that caused the error
+			mint index;
+			/// message parameters, may be null
+			std::shared_ptr<const Detail::ErrorParameters> params;
+		};
+
+		/**
+		 * @brief	Create an empty collector
+		 * @param 	maxRecords - maximal number of errors to store, further errors are only counted
+		 */
+		explicit ErrorCollector(std::size_t maxRecords = std::numeric_limits<std::size_t>::max()) : limit {maxRecords} {}
+
+		/**
+		 * @brief	Record an error of the element with given index
+		 * @tparam 	T - any type(s) that WSStream supports, they must be copy or move constructible
+		 * @param 	errorId - id of a registered error, see ErrorManager::getErrorId
+		 * @param 	index - index of the element, in the convention of the caller (e.g. 1-based if it is to be used in top-level)
+		 * @param 	params - any number of arguments that will replace TemplateSlots in the message text in top-level
+		 */
+		template<typename... T>
+		void add(ErrorManager::ErrorId errorId, mint index, T&&... params);
+
+		/**
+		 * @brief	Record an error with given name, see add(ErrorManager::ErrorId, mint, T&&...)
+		 * @throws 	ErrorName::ErrorManagerThrowNameError - if there is no error with given name
+		 */
+		template<typename... T>
+		void add(const std::string& errorName, mint index, T&&... params) {
+			add(ErrorManager::getErrorId(errorName), index, std::forward<T>(params)...);
+		}
+
+		/**
+		 * @brief	Record a caught exception as the error of the element with given index, together with its message parameters
+		 * @param 	e - caught exception
+		 * @param 	index - index of the element
+		 */
+		void add(const LibraryLinkError& e, mint index);
+
+		/// Get the number of stored errors
+		[[nodiscard]] std::size_t size() const;
+
+		/// Check if there are no stored errors
+		[[nodiscard]] bool empty() const {
+			return size() == 0;
+		}
+
+		/// Get the number of errors that were not stored because the collector was full
+		[[nodiscard]] std::size_t droppedCount() const;
+
+		/// Get a copy of the stored errors
+		[[nodiscard]] std::vector<Record> records() const;
+
+		/// Remove all errors
+		void clear();
+
+		/**
+		 * @brief	Get the stored errors as a packed n x 2 matrix of error codes and element indices. Message parameters are omitted.
+		 * @return	Tensor that can be returned to top-level, where LLU`CollectedFailures turns it into a list of Failures
+		 */
+		[[nodiscard]] Tensor<mint> toTensor() const;
+
+		/**
+		 * @brief	Send the stored errors to top-level as a List of {error code, element index, {params...}} triples.
+		 * @param 	link - WSTP link, on which the expression is put
+		 */
+		void put(WSLINK link) const;
+
+		/**
+		 * @brief	Assign the stored errors to the WL symbol read by LLU`LastCollectedFailures[], in a single packet.
+		 * @param 	libData - WolframLibraryData, if nullptr nothing is sent
+		 * @return	error code, because this function is noexcept
+		 */
+		LibraryLinkError::IdType sendFailures(WolframLibraryData libData) const noexcept;
+
+		/// Send the stored errors using the WolframLibraryData stored in LibraryData
+		LibraryLinkError::IdType sendFailures() const noexcept {
+			return sendFailures(LibraryData::uncheckedAPI());
+		}
+
+		/// Get the WL symbol, to which sendFailures assigns the errors
+		static std::string getCollectedFailuresSymbol();
+
+	private:
+		void push(Record record);
+
+		/// A WL symbol that will hold the errors sent by sendFailures, in the same context as the details of exceptions
+		static constexpr const char* collectedFailuresSymbol = "$LastCollectedFailures";
+
+		std::size_t limit;
+		std::size_t dropped = 0;
+		mutable std::mutex mutex;
+		std::vector<Record> errors;
+	};
+
+	template<typename... T>
+	void ErrorCollector::add(ErrorManager::ErrorId errorId, mint index, T&&... params) {
+		std::shared_ptr<const Detail::ErrorParameters> p;
+		if constexpr (sizeof...(T) > 0) {
+			p = std::make_shared<Detail::ErrorParametersOf<Detail::ErrorParameter<T>...>>(std::forward<T>(params)...);
+		}
+		push(Record {static_cast<LibraryLinkError::IdType>(errorId), index, std::move(p)});
+	}
+
+	/**
+	 * Sends the errors stored in an ErrorCollector via WSStream, see ErrorCollector::put
+	 * @tparam 	EIn - WSStream input encoding
+	 * @tparam 	EOut - WSStream output encoding
+	 * @param 	ms - reference to the WSStream object
+	 * @param 	errors - collected errors
+	 * @return	reference to the input stream
+	 */
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	WSStream<EIn, EOut>& operator<<(WSStream<EIn, EOut>& ms, const ErrorCollector& errors) {
+		errors.put(ms.get());
+		return ms;
+	}
+}  // namespace LLU
+
+#endif	  // LLU_ERRORLOG_ERRORCOLLECTOR_H
@@ -32,6 +32,26 @@ namespace LLU {
 		/// A type representing registered error in the form of 2 strings: short error name and longer error description
 		using ErrorStringData = std::pair<std::string, std::string>;
 
+		/// Strongly typed id of a registered error. Obtain it once with getErrorId and use it to throw the error without looking up its name.
+		enum class ErrorId : LibraryLinkError::IdType {};
+
+		/**
+		 * @brief   While an object of this class exists, exceptions thrown by the current thread do not send their parameters to top-level immediately.
+		 * @details Library functions defined with LLU macros create such an object and call sendPendingParameters when they catch an exception,
+		 * so that parameters are sent only if the exception actually reaches the Wolfram Language and not when it is caught in the C++ code.
+		 */
+		class DeferredParameters {
+		public:
+			DeferredParameters() noexcept {
+				++deferralDepth;
+			}
+			DeferredParameters(const DeferredParameters&) = delete;
+			DeferredParameters& operator=(const DeferredParameters&) = delete;
+			~DeferredParameters() {
+				--deferralDepth;
+			}
+		};
+
 	public:
 		/**
 		 * @brief Default constructor is deleted since ErrorManager is supposed to be completely static
@@ -41,8 +61,9 @@ namespace LLU {
 		/**
 		 * @brief 	Function used to register paclet-specific errors.
 		 * @param 	errors - a list of pairs: {"ErrorName", "Short string with error description"}
+		 * @return	ids of the errors, in the same order, which can be stored and used to throw the errors without looking up their names
 		 */
-		static void registerPacletErrors(const std::vector<ErrorStringData>& errors);
+		static std::vector<ErrorId> registerPacletErrors(const std::vector<ErrorStringData>& errors);
 
 		/**
 		 * @brief	Throw exception with given name.
@@ -75,6 +96,25 @@ namespace LLU {
 		template<typename... T>
 		[[noreturn]] static void throwException(WolframLibraryData libData, const std::string& errorName, T&&... args);
 
+		/**
+		 * @brief	Throw exception with given id, which is faster than throwing it by name.
+		 * @tparam 	T - type template parameter pack
+		 * @param 	errorId - id of a registered error, see getErrorId
+		 * @param 	args - any number of arguments that will replace TemplateSlots (``, `1`, `xx`, etd) in the message text in top-level
+		 */
+		template<typename... T>
+		[[noreturn]] static void throwException(ErrorId errorId, T&&... args);
+
+		/**
+		 * @brief	Throw exception with given id and additional information that might be helpful in debugging.
+		 * @tparam 	T - type template parameter pack
+		 * @param 	errorId - id of a registered error, see getErrorId
+		 * @param	debugInfo - additional message with debug info, this message will not be passed to top-level Failure object
+		 * @param 	args - any number of arguments that will replace TemplateSlots (``, `1`, `xx`, etd) in the message text in top-level
+		 */
+		template<typename... T>
+		[[noreturn]] static void throwExceptionWithDebugInfo(ErrorId errorId, const std::string& debugInfo, T&&... args);
+
 		/**
 		 * @brief 	Throw exception of given class that carries the error with given name.
 		 *
@@ -144,6 +184,28 @@ namespace LLU {
 			return sendParametersImmediately;
 		}
 
+		/**
+		 * @brief   Get the id of a registered error. Ids do not change once the error is registered, so they can be stored, e.g. in static variables.
+		 * @param   errorName - name of a registered error
+		 * @return  id of the error
+		 * @throws  ErrorName::ErrorManagerThrowNameError - if there is no error with given name
+		 */
+		static ErrorId getErrorId(const std::string& errorName) {
+			return static_cast<ErrorId>(findError(errorName).id());
+		}
+
+		/**
+		 * @brief   Send message parameters of an exception that reached the boundary of a library function, unless they were sent already.
+		 * @details Parameters are only sent if sendParametersImmediately is true, otherwise the exception is left untouched.
+		 * @param   libData - WolframLibraryData, if nullptr no parameters are sent
+		 * @param   e - caught exception
+		 */
+		static void sendPendingParameters(WolframLibraryData libData, const LibraryLinkError& e) noexcept {
+			if (sendParametersImmediately && e.hasPendingParameters()) {
+				e.sendParameters(libData);
+			}
+		}
+
 		/**
 		 * @brief Function used to send all registered errors to top-level Mathematica code.
 		 *
@@ -157,12 +219,19 @@ namespace LLU {
 		/// Errors are stored in a map with elements of the form { "ErrorName", immutable LibraryLinkError object }
 		using ErrorMap = std::unordered_map<std::string, const LibraryLinkError>;
 
+		/// Error predefined in LLU, the name refers to one of the constants from LLU::ErrorName
+		struct BuiltinError {
+			const std::string& name;
+			const char* message;
+		};
+
 	private:
 		/**
 		 * @brief 	Use this function to add new entry to the map of registered errors.
 		 * @param 	errorData - a pair of strings: error name + error description
+		 * @return	id of the error
 		 */
-		static void set(const ErrorStringData& errorData);
+		static ErrorId set(const ErrorStringData& errorData);
 
 		/**
 		 * @brief Find error by id.
@@ -172,27 +241,46 @@ namespace LLU {
 		static const LibraryLinkError& findError(int errorId);
 
 		/**
-		 * @brief Find error by name.
+		 * @brief Find error by name. Constants from LLU::ErrorName are recognized by their address, so the name is only hashed for other strings.
 		 * @param errorName - error name
 		 * @return const& to the desired error
 		 */
 		static const LibraryLinkError& findError(const std::string& errorName);
 
+		/**
+		 * @brief Throw a copy of a registered error with given debug info and message parameters
+		 */
+		template<typename... T>
+		[[noreturn]] static void
+		throwRegistered(WolframLibraryData libData, const LibraryLinkError& error, const std::string& debugInfo, T&&... args);
+
 		/***
 		 * @brief Initialization of static error map
 		 * @param initList - list of errors used internally by LLU
 		 * @return reference to static error map
 		 */
-		static ErrorMap registerLLUErrors(std::initializer_list<ErrorStringData> initList);
+		static ErrorMap registerLLUErrors(std::initializer_list<BuiltinError> initList);
 
 		/// Static map of registered errors
 		static ErrorMap& errors();
 
+		/// Ids of errors predefined in LLU, indexed by the addresses of their names in LLU::ErrorName
+		static std::unordered_map<const std::string*, int>& internedErrors();
+
+		/// Registered errors indexed by ErrorCode::VersionError - id, so that errors can be found by id in constant time
+		static std::vector<const LibraryLinkError*>& errorIndex();
+
+		/// Add an error to the index of errors by id
+		static void addToIndex(std::vector<const LibraryLinkError*>& index, const LibraryLinkError& error);
+
 		/// Id that will be assigned to the next registered error.
 		static int& nextErrorId();
 
 		/// Boolean flag that determines whether ErrorManager should trigger the transfer of message parameters to top-level for LibraryLinkErrors it throws.
 		static bool sendParametersImmediately;
+
+		/// Number of DeferredParameters objects alive in the current thread
+		static thread_local int deferralDepth;
 	};
 
 	template<typename... T>
@@ -205,6 +293,16 @@ namespace LLU {
 		throwExceptionWithDebugInfo(libData, errorName, "", std::forward<T>(args)...);
 	}
 
+	template<typename... T>
+	[[noreturn]] void ErrorManager::throwException(ErrorId errorId, T&&... args) {
+		throwRegistered(LibraryData::uncheckedAPI(), findError(static_cast<LibraryLinkError::IdType>(errorId)), "", std::forward<T>(args)...);
+	}
+
+	template<typename... T>
+	[[noreturn]] void ErrorManager::throwExceptionWithDebugInfo(ErrorId errorId, const std::string& debugInfo, T&&... args) {
+		throwRegistered(LibraryData::uncheckedAPI(), findError(static_cast<LibraryLinkError::IdType>(errorId)), debugInfo, std::forward<T>(args)...);
+	}
+
 	template<class Error, typename... Args>
 	[[noreturn]] void ErrorManager::throwCustomException(const std::string& errorName, Args&&... args) {
 		throw Error(findError(errorName), std::forward<Args>(args)...);
@@ -218,15 +316,23 @@ namespace LLU {
 	template<typename... T>
 	[[noreturn]] void
 	ErrorManager::throwExceptionWithDebugInfo(WolframLibraryData libData, const std::string& errorName, const std::string& debugInfo, T&&... args) {
-		auto e = findError(errorName);
-		e.setDebugInfo(debugInfo);
-		if (libData && sizeof...(args) > 0) {
-			e.setMessageParameters(libData, std::forward<T>(args)...);
-			if (sendParametersImmediately) {
-				e.sendParameters(libData);
+		throwRegistered(libData, findError(errorName), debugInfo, std::forward<T>(args)...);
+	}
+
+	template<typename... T>
+	[[noreturn]] void
+	ErrorManager::throwRegistered(WolframLibraryData libData, const LibraryLinkError& error, const std::string& debugInfo, T&&... args) {
+		if constexpr (sizeof...(T) > 0) {
+			if (libData) {
+				LibraryLinkError e {error, debugInfo,
+									std::make_shared<Detail::ErrorParametersOf<Detail::ErrorParameter<T>...>>(std::forward<T>(args)...)};
+				if (sendParametersImmediately && deferralDepth == 0) {
+					e.sendParameters(libData);
+				}
+				throw e;
 			}
 		}
-		throw std::move(e);
+		throw LibraryLinkError {error, debugInfo, nullptr};
 	}
 
 } /* namespace LLU */
@@ -125,6 +125,7 @@ namespace LLU {
 		extern const std::string DLGetNodeDataError;	 ///< DataStoreNode_getData failed
 		extern const std::string DLSharedDataStore;	 	 ///< Trying to create a Shared DataStore. DataStore can only be passed as Automatic or Manual.
 		extern const std::string DLPushBackTypeError;	 ///< Element to be added to the DataList has incorrect type
+		extern const std::string DLNodeNotFound;		 ///< DataList has no node with requested name or index
 
 		// MArgument errors:
 		extern const std::string ArgumentCreateNull;		  ///< Trying to create PrimitiveWrapper object from nullptr
@@ -142,6 +143,20 @@ namespace LLU {
 		extern const std::string PathNotValidated;		///< Given file path could not be validated under desired open mode
 		extern const std::string InvalidOpenMode;		///< Specified open mode is invalid
 		extern const std::string OpenFileFailed;		///< Could not open file
+		extern const std::string InvalidEncoding;		///< String is not valid in the Unicode encoding it was declared to have
+		extern const std::string MapFileFailed;			///< Could not map file into memory
+		extern const std::string ReadFileFailed;		///< Could not read from file
+		extern const std::string NumberParseFailed;		///< Token in a text file is not a valid number
+		extern const std::string WriteFileFailed;		///< Could not write to file
+		extern const std::string InvalidSerializedData;	///< File is not a valid LLU serialized file
+
+		// Compression errors:
+		extern const std::string UnknownCodec;			///< No compression codec is registered under given id
+		extern const std::string CompressionFailed;		///< Codec could not compress a block of data
+		extern const std::string InvalidCompressedData;	///< Compressed data is corrupted or does not match the expected size
+
+		// Background task errors:
+		extern const std::string AsyncTaskCreateError;	///< LibraryLink could not create an asynchronous task
 	}  // namespace ErrorName
 
 }  // namespace LLU
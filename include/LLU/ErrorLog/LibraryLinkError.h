@@ -8,8 +8,13 @@
 #ifndef LLU_ERRORLOG_LIBRARYLINKERROR_H_
 #define LLU_ERRORLOG_LIBRARYLINKERROR_H_
 
+#include <atomic>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 #include "LLU/WSTP/WSStream.hpp"
 
@@ -22,6 +27,40 @@
  */
 namespace LLU {
 
+	namespace Detail {
+		/// Message parameters of an exception, kept in C++ memory until they are sent to top-level
+		class ErrorParameters {
+		public:
+			virtual ~ErrorParameters() = default;
+
+			/// Send the parameters as a List
+			virtual void send(WSStream<WS::Encoding::UTF8>& mls) const = 0;
+
+			/// Whether the parameters have already been sent
+			mutable std::atomic<bool> sent {false};
+		};
+
+		/// Stores copies of message parameters, C strings are copied to std::string because they may not outlive the exception
+		template<typename... T>
+		class ErrorParametersOf : public ErrorParameters {
+		public:
+			template<typename... U>
+			explicit ErrorParametersOf(U&&... p) : params {std::forward<U>(p)...} {}
+
+			void send(WSStream<WS::Encoding::UTF8>& mls) const override {
+				mls << WS::List(static_cast<int>(sizeof...(T)));
+				std::apply([&mls](const auto&... p) { Unused((mls << ... << p)); }, params);
+			}
+
+		private:
+			std::tuple<T...> params;
+		};
+
+		/// Type in which an exception parameter of type T is stored
+		template<typename T>
+		using ErrorParameter = std::conditional_t<std::is_convertible_v<T, const char*>, std::string, std::decay_t<T>>;
+	}  // namespace Detail
+
 	/**
 	 * @class	LibraryLinkError
 	 * @brief	Class representing an exception in paclet code
@@ -31,25 +70,26 @@ namespace LLU {
 	 **/
 	class LibraryLinkError : public std::runtime_error {
 		friend class ErrorManager;
+		friend class ErrorCollector;
 
 	public:
 		/// A type that holds error id numbers
 		using IdType = int;
 
-		/// Copy-constructor. If there are any messages parameters on the WSLINK, a deep copy is performed.
-		LibraryLinkError(const LibraryLinkError& e) noexcept;
+		/// Copy-constructor. Message parameters are shared with \p e, they are never modified after being set.
+		LibraryLinkError(const LibraryLinkError& e) noexcept = default;
 
 		/// Copy-assignment operator.
-		LibraryLinkError& operator=(const LibraryLinkError& e) noexcept;
+		LibraryLinkError& operator=(const LibraryLinkError& e) noexcept = default;
 
 		/// Move-constructor. Steals messagesParams from \p e.
-		LibraryLinkError(LibraryLinkError&& e) noexcept;
+		LibraryLinkError(LibraryLinkError&& e) noexcept = default;
 
 		/// Move-assignment operator.
-		LibraryLinkError& operator=(LibraryLinkError&& e) noexcept;
+		LibraryLinkError& operator=(LibraryLinkError&& e) noexcept = default;
 
-		/// The destructor closes the link that was used to send message parameters, if any
-		~LibraryLinkError() override;
+		/// Default destructor
+		~LibraryLinkError() override = default;
 
 		/**
 		 * Set debug info
@@ -95,17 +135,17 @@ namespace LLU {
 		}
 
 		/**
-		 * @brief	Store arbitrary number of message parameters in a List expression on a loopback link.
-		 * 			They will travel with the exception until \c sendParameters is called on the exception.
-		 * @tparam 	T - any type(s) that WSStream supports
-		 * @param 	libData - WolframLibraryData, if nullptr, the parameters will not be send
+		 * @brief	Store copies of arbitrary number of message parameters in the exception.
+		 * 			They will travel with the exception until \c sendParameters is called on the exception, no WSTP communication happens before that.
+		 * @tparam 	T - any type(s) that WSStream supports, they must be copy or move constructible
+		 * @param 	libData - WolframLibraryData, if nullptr, the parameters will not be set
 		 * @param 	params - any number of message parameters
 		 */
 		template<typename... T>
 		void setMessageParameters(WolframLibraryData libData, T&&... params);
 
 		/**
-		 * @brief	Send parameters stored in the loopback link to top-level.
+		 * @brief	Send the stored message parameters to top-level.
 		 * 			They will be assigned as a List to symbol passed in \p WLSymbol parameter.
 		 * @param 	libData - WolframLibraryData, if nullptr, the parameters will not be send
 		 * @param	WLSymbol - symbol to assign parameters to in top-level
@@ -113,6 +153,11 @@ namespace LLU {
 		 */
 		IdType sendParameters(WolframLibraryData libData, const std::string& WLSymbol = getExceptionDetailsSymbol()) const noexcept;
 
+		/// Check if the exception carries message parameters that have not been sent to top-level yet
+		[[nodiscard]] bool hasPendingParameters() const noexcept {
+			return messageParams && !messageParams->sent.load(std::memory_order_relaxed);
+		}
+
 		/**
 		 * @brief	Get symbol that will hold details of last thrown exception.
 		 * @return	a WL symbol
@@ -143,11 +188,14 @@ namespace LLU {
 			: std::runtime_error(t), errorId(which), messageTemplate(msg.c_str()) {}
 
 		/**
-		 * @brief	Helper functions that opens a loopback link given a WSTP environment
-		 * @param 	env - WSTP environment
-		 * @return 	a loopback link (may be nullptr if function failed to create the link)
-		 */
-		static WSLINK openLoopback(WSENV env);
+		 *   @brief         Constructs a copy of a registered error with given debug info and message parameters
+		 *   @param[in]     registered - error registered in the ErrorManager
+		 *   @param[in]		dbg - debug info, if empty no new string is allocated
+		 *   @param[in]		params - message parameters, may be null
+		 **/
+		LibraryLinkError(const LibraryLinkError& registered, const std::string& dbg, std::shared_ptr<const Detail::ErrorParameters> params)
+			: std::runtime_error(registered), errorId(registered.errorId), messageTemplate(registered.messageTemplate),
+			  debugInfo(dbg.empty() ? registered.debugInfo : std::runtime_error {dbg}), messageParams(std::move(params)) {}
 
 		/// A WL symbol that will hold the details of last thrown exception. It cannot be modified directly, you can only change its context.
 		static constexpr const char* exceptionDetailsSymbol = "$LastFailureParameters";
@@ -158,19 +206,15 @@ namespace LLU {
 		IdType errorId;
 		std::runtime_error messageTemplate;
 		std::runtime_error debugInfo {""};
-		WSLINK messageParams = nullptr;
+		std::shared_ptr<const Detail::ErrorParameters> messageParams;
 	};
 
 	template<typename... T>
 	void LibraryLinkError::setMessageParameters(WolframLibraryData libData, T&&... params) {
-		messageParams = openLoopback(libData->getWSLINKEnvironment(libData));
-		if (!messageParams) {
+		if (!libData) {
 			return;
 		}
-		WSStream<WS::Encoding::UTF8> loopback {messageParams};
-		constexpr auto messageParamsCount = sizeof...(T);
-		loopback << WS::List(static_cast<int>(messageParamsCount));
-		Unused((loopback << ... << params));
+		messageParams = std::make_shared<Detail::ErrorParametersOf<Detail::ErrorParameter<T>...>>(std::forward<T>(params)...);
 	}
 } /* namespace LLU */
 
@@ -6,12 +6,21 @@
 #ifndef LLU_ERRORLOG_LOGGER_H
 #define LLU_ERRORLOG_LOGGER_H
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <initializer_list>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 #include "LLU/LibraryData.h"
+#include "LLU/Tracing.h"
 #include "LLU/WSTP/WSStream.hpp"
 
 // Configuration macros to set desired level of logging at build time:
@@ -45,28 +54,77 @@
 
 // Convenience macros to use in the code:
 
+/// @cond
+#define LLU_LOG_IMPL(level, ...) \
+	(LLU::Logger::isEnabled(level) ? LLU::Logger::log<level>(__LINE__, __FILE__, __func__, __VA_ARGS__) : static_cast<void>(0))
+
+#define LLU_LOG_EVERY_N_IMPL(level, n, ...)                                          \
+	do {                                                                             \
+		static LLU::Logger::Sampler llu_logSampler {n};                              \
+		if (LLU::Logger::isEnabled(level) && llu_logSampler.sample()) {              \
+			LLU::Logger::log<level>(__LINE__, __FILE__, __func__, __VA_ARGS__);      \
+		}                                                                            \
+	} while (false)
+
+#define LLU_LOG_RATE_LIMITED_IMPL(level, maxPerSecond, ...)                          \
+	do {                                                                             \
+		static LLU::Logger::RateLimiter llu_logRateLimiter {maxPerSecond};           \
+		if (LLU::Logger::isEnabled(level) && llu_logRateLimiter.allow()) {           \
+			LLU::Logger::log<level>(__LINE__, __FILE__, __func__, __VA_ARGS__);      \
+		}                                                                            \
+	} while (false)
+/// @endcond
+
 #ifdef LLU_LOG_LEVEL_DEBUG
 /**
  * Log a message (arbitrary sequence of arguments that can be passed via WSTP) as debug information, the log will consist of the line number, file name,
  * function name and user-provided args.
- * Formatting can be customized on the Wolfram Language side.
+ * Formatting can be customized on the Wolfram Language side. The arguments are not evaluated if debug logs are disabled with Logger::setThreshold.
+ * @note This macro is only active with LLU_LOG_DEBUG compilation flag.
+ */
+#define LLU_DEBUG(...) LLU_LOG_IMPL(LLU::Logger::Level::Debug, __VA_ARGS__)
+
+/**
+ * Log a debug message like LLU_DEBUG, but only on the first and then every \p n -th evaluation of this line.
+ * @note This macro is only active with LLU_LOG_DEBUG compilation flag.
+ */
+#define LLU_DEBUG_EVERY_N(n, ...) LLU_LOG_EVERY_N_IMPL(LLU::Logger::Level::Debug, n, __VA_ARGS__)
+
+/**
+ * Log a debug message like LLU_DEBUG, but not more than \p maxPerSecond times per second from this line, other logs are discarded.
  * @note This macro is only active with LLU_LOG_DEBUG compilation flag.
  */
-#define LLU_DEBUG(...) LLU::Logger::log<LLU::Logger::Level::Debug>(__LINE__, __FILE__, __func__, __VA_ARGS__)
+#define LLU_DEBUG_RATE_LIMITED(maxPerSecond, ...) LLU_LOG_RATE_LIMITED_IMPL(LLU::Logger::Level::Debug, maxPerSecond, __VA_ARGS__)
 #else
 #define LLU_DEBUG(...) ((void)0)
+#define LLU_DEBUG_EVERY_N(n, ...) ((void)0)
+#define LLU_DEBUG_RATE_LIMITED(maxPerSecond, ...) ((void)0)
 #endif
 
 #ifdef LLU_LOG_LEVEL_WARNING
 /**
  * Log a message (arbitrary sequence of arguments that can be passed via WSTP) as warning, the log will consist of the line number, file name,
  * function name and user-provided args.
- * Formatting can be customized on the Wolfram Language side.
+ * Formatting can be customized on the Wolfram Language side. The arguments are not evaluated if warnings are disabled with Logger::setThreshold.
+ * @note This macro is only active with LLU_LOG_DEBUG or LLU_LOG_WARNING compilation flag.
+ */
+#define LLU_WARNING(...) LLU_LOG_IMPL(LLU::Logger::Level::Warning, __VA_ARGS__)
+
+/**
+ * Log a warning like LLU_WARNING, but only on the first and then every \p n -th evaluation of this line.
  * @note This macro is only active with LLU_LOG_DEBUG or LLU_LOG_WARNING compilation flag.
  */
-#define LLU_WARNING(...) LLU::Logger::log<LLU::Logger::Level::Warning>(__LINE__, __FILE__, __func__, __VA_ARGS__)
+#define LLU_WARNING_EVERY_N(n, ...) LLU_LOG_EVERY_N_IMPL(LLU::Logger::Level::Warning, n, __VA_ARGS__)
+
+/**
+ * Log a warning like LLU_WARNING, but not more than \p maxPerSecond times per second from this line, other logs are discarded.
+ * @note This macro is only active with LLU_LOG_DEBUG or LLU_LOG_WARNING compilation flag.
+ */
+#define LLU_WARNING_RATE_LIMITED(maxPerSecond, ...) LLU_LOG_RATE_LIMITED_IMPL(LLU::Logger::Level::Warning, maxPerSecond, __VA_ARGS__)
 #else
 #define LLU_WARNING(...) ((void)0)
+#define LLU_WARNING_EVERY_N(n, ...) ((void)0)
+#define LLU_WARNING_RATE_LIMITED(maxPerSecond, ...) ((void)0)
 #endif
 
 #ifdef LLU_LOG_LEVEL_ERROR
@@ -76,9 +134,23 @@
  * Formatting can be customized on the Wolfram Language side.
  * @note This macro is only active with LLU_LOG_DEBUG, LLU_LOG_WARNING or LLU_LOG_ERROR compilation flag.
  */
-#define LLU_ERROR(...) LLU::Logger::log<LLU::Logger::Level::Error>(__LINE__, __FILE__, __func__, __VA_ARGS__)
+#define LLU_ERROR(...) LLU_LOG_IMPL(LLU::Logger::Level::Error, __VA_ARGS__)
+
+/**
+ * Log an error like LLU_ERROR, but only on the first and then every \p n -th evaluation of this line.
+ * @note This macro is only active with LLU_LOG_DEBUG, LLU_LOG_WARNING or LLU_LOG_ERROR compilation flag.
+ */
+#define LLU_ERROR_EVERY_N(n, ...) LLU_LOG_EVERY_N_IMPL(LLU::Logger::Level::Error, n, __VA_ARGS__)
+
+/**
+ * Log an error like LLU_ERROR, but not more than \p maxPerSecond times per second from this line, other logs are discarded.
+ * @note This macro is only active with LLU_LOG_DEBUG, LLU_LOG_WARNING or LLU_LOG_ERROR compilation flag.
+ */
+#define LLU_ERROR_RATE_LIMITED(maxPerSecond, ...) LLU_LOG_RATE_LIMITED_IMPL(LLU::Logger::Level::Error, maxPerSecond, __VA_ARGS__)
 #else
 #define LLU_ERROR(...) ((void)0)
+#define LLU_ERROR_EVERY_N(n, ...) ((void)0)
+#define LLU_ERROR_RATE_LIMITED(maxPerSecond, ...) ((void)0)
 #endif
 
 namespace LLU {
@@ -86,12 +158,61 @@ namespace LLU {
 	/**
 	 * Logger class is responsible for sending log messages via WSTP to Mathematica.
 	 * It may be more convenient to use one of the LLU_DEBUG/WARNING/ERROR macros instead of calling Logger methods directly.
+	 *
+	 * By default every log is sent to the Kernel immediately, which takes a full round-trip and must happen on the main thread.
+	 * In the asynchronous mode (see setAsync) logs are copied into records that are pushed to a lock-free queue, so logging is cheap and can be
+	 * done from any thread. Pending records are sent as a single expression by flush, which library functions defined with LLU_LIBRARY_FUNCTION and
+	 * related macros call automatically when they finish.
 	 */
 	class Logger {
 	public:
 		/// Possible log severity levels
 		enum class Level { Debug, Warning, Error };
 
+		/// Maximal number of log records waiting to be flushed in the asynchronous mode, records logged when the queue is full are dropped
+		static constexpr std::size_t asyncQueueCapacity = 4096;
+
+		/// Per-callsite state of the LLU_*_EVERY_N macros, lets through the first and then every n-th log
+		class Sampler {
+		public:
+			explicit Sampler(std::uint64_t n) noexcept : period {n > 0 ? n : 1} {}
+
+			/// Check if the current log should be sent
+			bool sample() noexcept {
+				return counter.fetch_add(1, std::memory_order_relaxed) % period == 0;
+			}
+
+		private:
+			std::uint64_t period;
+			std::atomic<std::uint64_t> counter {0};
+		};
+
+		/// Function that returns the current time in whole seconds, used by RateLimiter
+		using SecondsClock = std::int64_t (*)() noexcept;
+
+		/// Per-callsite state of the LLU_*_RATE_LIMITED macros, lets through at most a given number of logs in every second of the rate limiter clock
+		class RateLimiter {
+		public:
+			explicit RateLimiter(std::uint64_t maxPerSecond) noexcept : limit {maxPerSecond} {}
+
+			/// Check if the current log should be sent. Threads that race at the start of a new second may let through a few extra logs.
+			bool allow() noexcept {
+				const auto clock = rateLimiterClock.load(std::memory_order_relaxed);
+				const std::int64_t now =
+					clock ? clock() : std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+				auto current = second.load(std::memory_order_relaxed);
+				if (current != now && second.compare_exchange_strong(current, now, std::memory_order_relaxed)) {
+					count.store(0, std::memory_order_relaxed);
+				}
+				return count.fetch_add(1, std::memory_order_relaxed) < limit;
+			}
+
+		private:
+			std::uint64_t limit;
+			std::atomic<std::int64_t> second {std::numeric_limits<std::int64_t>::min()};
+			std::atomic<std::uint64_t> count {0};
+		};
+
 		/**
 		 * @brief	Send a log message of given severity.
 		 * @tparam 	L - log level, severity of the log
@@ -144,11 +265,98 @@ namespace LLU {
 			return logSymbolContext + topLevelLogCallback;
 		}
 
+		/**
+		 * @brief   Set the lowest severity of logs that are sent, less severe logs are discarded before their arguments are evaluated.
+		 * @details This only affects log levels that are compiled in, e.g. with LLU_LOG_WARNING debug logs are never sent regardless of the threshold.
+		 * By default all compiled in logs are sent.
+		 * @param   level - new threshold
+		 */
+		static void setThreshold(Level level) noexcept {
+			threshold.store(level, std::memory_order_relaxed);
+		}
+
+		/// Get the lowest severity of logs that are sent
+		static Level getThreshold() noexcept {
+			return threshold.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief   Replace the clock used by the LLU_*_RATE_LIMITED macros, e.g. to make tests independent of the wall-clock time.
+		 * @param   clock - function returning the current second, or nullptr to go back to std::chrono::steady_clock
+		 */
+		static void setRateLimiterClock(SecondsClock clock) noexcept {
+			rateLimiterClock.store(clock, std::memory_order_relaxed);
+		}
+
+		/// Check if logs of given severity are sent, which takes a single relaxed atomic load
+		static bool isEnabled(Level level) noexcept {
+			return level >= threshold.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief   Switch between sending every log immediately and queueing logs to be sent in batches.
+		 * @param   async - whether logs should be queued
+		 * @note    Pending logs are flushed when the asynchronous mode is turned off, so this function must be called on the main thread.
+		 */
+		static void setAsync(bool async);
+
+		/// Check if logs are queued instead of being sent immediately
+		static bool isAsync() noexcept {
+			return asyncMode.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief   Send all queued logs to the Kernel as a single expression. Does nothing if there are no queued logs.
+		 * @param   libData - WolframLibraryData, if nullptr - queued logs are kept
+		 * @note    Must be called on the main thread. Errors in the communication with the Kernel are ignored and the logs that were
+		 *          being sent are lost.
+		 */
+		static void flush(WolframLibraryData libData) noexcept;
+
+		/// Send all queued logs using the WolframLibraryData stored in LibraryData
+		static void flush() noexcept;
+
+		/// Send all queued logs if the Logger is in the asynchronous mode, this is what library functions defined with LLU macros call on exit
+		static void flushIfAsync(WolframLibraryData libData) noexcept {
+			if (isAsync()) {
+				flush(libData);
+			}
+		}
+
+		/// Get the number of logs dropped so far because the queue was full
+		static std::uint64_t droppedCount() noexcept;
+
 	private:
+		/// Log stored in the queue until it is flushed
+		class Record {
+		public:
+			virtual ~Record() = default;
+
+			/// Send the log as a call to the log handler
+			virtual void send(WSStream<WS::Encoding::UTF8>& mls) const = 0;
+		};
+
+		template<Level L, typename... T>
+		class RecordOf;
+
+		/// Type in which a log argument of type T is stored, C strings are copied to std::string because they may not outlive the record
+		template<typename T>
+		using RecordArg = std::conditional_t<std::is_convertible_v<T, const char*>, std::string, std::decay_t<T>>;
+
+		/// Lock-free queue of records waiting to be flushed
+		struct Queue;
+		static Queue& pendingLogs();
+
+		/// Push a record to the queue, or drop it if the queue is full
+		static void enqueue(std::unique_ptr<Record> record) noexcept;
+
 		/// Name of the WL function, to which log elements will be sent as arguments via WSTP.
 		static constexpr const char* topLevelLogCallback = "Logger`LogHandler";
 		static std::mutex mlinkGuard;
 		static std::string logSymbolContext;
+		static std::atomic<bool> asyncMode;
+		static std::atomic<Level> threshold;
+		static std::atomic<SecondsClock> rateLimiterClock;
 	};
 
 	/**
@@ -164,11 +372,36 @@ namespace LLU {
 		return ms << Logger::to_string(l);
 	}
 
+	template<Logger::Level L, typename... T>
+	class Logger::RecordOf : public Logger::Record {
+	public:
+		template<typename... U>
+		RecordOf(int line, std::string fileName, std::string function, U&&... args)
+			: line {line}, fileName {std::move(fileName)}, function {std::move(function)}, args {std::forward<U>(args)...} {}
+
+		void send(WSStream<WS::Encoding::UTF8>& mls) const override {
+			mls << WS::Function(getSymbol(), 4 + sizeof...(T));
+			mls << L << line << fileName << function;
+			std::apply([&mls](const auto&... a) { Unused((mls << ... << a)); }, args);
+		}
+
+	private:
+		int line;
+		std::string fileName;
+		std::string function;
+		std::tuple<T...> args;
+	};
+
 	template<Logger::Level L, typename... T>
 	void Logger::log(WolframLibraryData libData, int line, const std::string& fileName, const std::string& function, T&&... args) {
 		if (!libData) {
 			return;
 		}
+		LLU_TRACE_SCOPE("Logger", "log");
+		if (isAsync()) {
+			enqueue(std::make_unique<RecordOf<L, RecordArg<T>...>>(line, fileName, function, std::forward<T>(args)...));
+			return;
+		}
 		std::lock_guard<std::mutex> lock(mlinkGuard);
 
 		WSStream<WS::Encoding::UTF8> mls {libData->getWSLINK(libData)};
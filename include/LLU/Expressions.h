@@ -0,0 +1,373 @@
+/**
+ * @file	Expressions.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Lazy element-wise expressions over Tensors, NumericArrays and Images that are evaluated in a single fused pass.
+ *
+ * Arithmetic operators applied to containers derived from IterableContainer do not compute anything, they build an expression object
+ * that refers to the operands. Elements are computed only when the expression is evaluated with Expr::assign or passed as a producer
+ * to a constructor of Tensor or NumericArray, and then every element of the result is computed from the corresponding elements
+ * of the operands in one loop, without temporary containers for intermediate results. After inlining, the loop body is a plain formula
+ * over raw pointers, like the loops in LLU/Kernels.h.
+ */
+#ifndef LLU_EXPRESSIONS_H
+#define LLU_EXPRESSIONS_H
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "LLU/Async/Algorithms.h"
+#include "LLU/Containers/Iterators/IterableContainer.hpp"
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/Kernels.h"
+
+namespace LLU::Expr {
+
+	/// Default number of elements evaluated by a single task in the parallel version of Expr::assign
+	inline constexpr mint defaultExpressionGrain = 1 << 14;
+
+	template<typename Op, typename... Operands>
+	class Expression;
+
+	/// @cond
+	namespace Detail {
+		/// Size reported by operands that fit expressions of any size, i.e. by scalars
+		inline constexpr mint anySize = -1;
+
+		template<typename T>
+		using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+		template<typename T>
+		struct is_expression : std::false_type {};
+
+		template<typename Op, typename... Operands>
+		struct is_expression<Expression<Op, Operands...>> : std::true_type {};
+
+		template<typename T>
+		std::true_type iterableBase(const IterableContainer<T>*);
+
+		std::false_type iterableBase(...);
+
+		/// Whether T is derived from IterableContainer, e.g. Tensor<T>, NumericArray<T> or Image<T>
+		template<typename T>
+		inline constexpr bool is_container_v = decltype(iterableBase(std::declval<remove_cvref_t<T>*>()))::value;
+
+		/// Whether T refers to a sequence of elements, i.e. it is an expression or a container
+		template<typename T>
+		inline constexpr bool is_operand_v = is_expression<remove_cvref_t<T>>::value || is_container_v<T>;
+
+		/// Whether T is a number that is combined with every element of the other operands
+		template<typename T>
+		inline constexpr bool is_scalar_v = std::is_arithmetic_v<remove_cvref_t<T>> || Kernels::Detail::is_complex_v<remove_cvref_t<T>>;
+
+		/// Enable operators and functions only if at least one argument is an operand and all other arguments are operands or scalars
+		template<typename... Ts>
+		using enable_if_expression = std::enable_if_t<(is_operand_v<Ts> || ...) && ((is_operand_v<Ts> || is_scalar_v<Ts>) && ...)>;
+
+		/// Leaf of an expression that reads the elements of a container
+		template<typename T>
+		class ContainerLeaf {
+		public:
+			explicit ContainerLeaf(const IterableContainer<T>& c) noexcept : elems(c.data()), length(c.size()) {}
+
+			T operator[](mint i) const noexcept {
+				return elems[i];
+			}
+
+			[[nodiscard]] mint size() const noexcept {
+				return length;
+			}
+
+		private:
+			const T* elems;
+			mint length;
+		};
+
+		/// Leaf of an expression that has the same value at every position
+		template<typename T>
+		class ScalarLeaf {
+		public:
+			explicit ScalarLeaf(T v) noexcept : value(v) {}
+
+			T operator[](mint /*i*/) const noexcept {
+				return value;
+			}
+
+			[[nodiscard]] static constexpr mint size() noexcept {
+				return anySize;
+			}
+
+		private:
+			T value;
+		};
+
+		template<typename T>
+		ContainerLeaf<T> makeLeaf(const IterableContainer<T>& c) noexcept {
+			return ContainerLeaf<T> {c};
+		}
+
+		template<typename Op, typename... Operands>
+		const Expression<Op, Operands...>& makeLeaf(const Expression<Op, Operands...>& e) noexcept {
+			return e;
+		}
+
+		template<typename T, typename = std::enable_if_t<is_scalar_v<T>>>
+		ScalarLeaf<T> makeLeaf(T value) noexcept {
+			return ScalarLeaf<T> {value};
+		}
+
+		/// Type under which an argument of an operator is stored in the expression, sub-expressions are stored by value
+		template<typename T>
+		using leaf_t = remove_cvref_t<decltype(makeLeaf(std::declval<const remove_cvref_t<T>&>()))>;
+
+		/// Get the common size of operands, throw DimensionsError if two operands have different sizes
+		template<typename... Operands>
+		mint commonSize(const Operands&... operands) {
+			mint n = anySize;
+			auto merge = [&n](mint s) {
+				if (s == anySize) {
+					return;
+				}
+				if (n != anySize && n != s) {
+					ErrorManager::throwException(ErrorName::DimensionsError);
+				}
+				n = s;
+			};
+			(merge(operands.size()), ...);
+			return n;
+		}
+
+		template<typename Op, typename... Args>
+		auto makeExpression(Op op, const Args&... args) {
+			return Expression<Op, leaf_t<Args>...> {op, makeLeaf(args)...};
+		}
+
+		/// Compute elements [first, last) of an expression into \p out
+		template<typename T, typename E>
+		void evaluateRange(T* out, const E& e, mint first, mint last) {
+			for (mint i = first; i < last; ++i) {
+				out[i] = static_cast<T>(e[i]);
+			}
+		}
+
+		/// Get the data pointer of the destination container, throw DimensionsError unless it has as many elements as the expression
+		template<class Out, typename E>
+		auto* destination(Out& out, const E& e) {
+			if (Kernels::Detail::sizeOf(out) != e.size()) {
+				ErrorManager::throwException(ErrorName::DimensionsError);
+			}
+			return Kernels::Detail::dataOf(out);
+		}
+
+		template<typename U>
+		struct CastTo {
+			template<typename T>
+			U operator()(const T& x) const {
+				return static_cast<U>(x);
+			}
+		};
+
+		struct Min {
+			template<typename T, typename U>
+			auto operator()(const T& x, const U& y) const {
+				using R = std::common_type_t<T, U>;
+				return static_cast<R>(y) < static_cast<R>(x) ? static_cast<R>(y) : static_cast<R>(x);
+			}
+		};
+
+		struct Max {
+			template<typename T, typename U>
+			auto operator()(const T& x, const U& y) const {
+				using R = std::common_type_t<T, U>;
+				return static_cast<R>(x) < static_cast<R>(y) ? static_cast<R>(y) : static_cast<R>(x);
+			}
+		};
+
+		struct Pow {
+			template<typename T, typename U>
+			auto operator()(const T& x, const U& y) const {
+				using std::pow;
+				return pow(x, y);
+			}
+		};
+	}  // namespace Detail
+	/// @endcond
+
+	/**
+	 * @class   Expression
+	 * @brief   Lazy element-wise operation on containers, scalars and other expressions
+	 * @details Expressions are created by operators and functions from this namespace, not directly. They store references to the data of
+	 * containers, so the containers must stay alive and keep their size until the expression is evaluated. The destination of the evaluation
+	 * may be one of the operands, since every element depends only on the elements of the operands at the same position.
+	 * @tparam  Op - function object that computes a single element from the elements of operands
+	 * @tparam  Operands - types of the operands: container and scalar leaves or other expressions
+	 */
+	template<typename Op, typename... Operands>
+	class Expression {
+	public:
+		/// Type of the elements of the expression
+		using value_type = Detail::remove_cvref_t<std::invoke_result_t<const Op&, decltype(std::declval<const Operands&>()[mint {}])...>>;
+
+		/**
+		 * Create an expression from the operation and its operands
+		 * @throws ErrorName::DimensionsError - if the operands that are not scalars have different numbers of elements
+		 */
+		explicit Expression(Op operation, Operands... ops) : op(std::move(operation)), operands(std::move(ops)...) {
+			length = std::apply([](const auto&... o) { return Detail::commonSize(o...); }, operands);
+		}
+
+		/// Compute the element at given flat index
+		value_type operator[](mint i) const {
+			return element(i, std::index_sequence_for<Operands...> {});
+		}
+
+		/// Compute the element at given flat index, so that the expression can be used as a producer in constructors of Tensor and NumericArray
+		value_type operator()(mint i) const {
+			return element(i, std::index_sequence_for<Operands...> {});
+		}
+
+		/// Get the number of elements
+		[[nodiscard]] mint size() const noexcept {
+			return length;
+		}
+
+	private:
+		template<std::size_t... I>
+		value_type element(mint i, std::index_sequence<I...> /*unused*/) const {
+			return op(std::get<I>(operands)[i]...);
+		}
+
+		Op op;
+		std::tuple<Operands...> operands;
+		mint length = 0;
+	};
+
+	/**
+	 * @brief   Evaluate an expression into a container
+	 * @param   out - container with data() and size(), e.g. Tensor, NumericArray or std::vector, it may be one of the operands
+	 * @param   e - expression
+	 * @throws  ErrorName::DimensionsError - if \p out does not have as many elements as the expression
+	 */
+	template<class Out, typename Op, typename... Operands>
+	void assign(Out& out, const Expression<Op, Operands...>& e) {
+		auto* data = Detail::destination(out, e);
+		Detail::evaluateRange(data, e, 0, e.size());
+	}
+
+	/**
+	 * @brief   Evaluate an expression into a container in parallel, each task computing a contiguous chunk of elements
+	 * @param   pool - thread pool with post and non-blocking runPendingTask, like LLU::ThreadPool
+	 * @param   out - container with data() and size(), e.g. Tensor, NumericArray or std::vector, it may be one of the operands
+	 * @param   e - expression
+	 * @param   grain - number of elements computed by a single task
+	 * @throws  ErrorName::DimensionsError - if \p out does not have as many elements as the expression
+	 */
+	template<class Pool, class Out, typename Op, typename... Operands>
+	void assign(Pool& pool, Out& out, const Expression<Op, Operands...>& e, mint grain = defaultExpressionGrain) {
+		auto* data = Detail::destination(out, e);
+		const mint n = e.size();
+		const mint chunk = std::max(grain, mint {1});
+		Async::parallelFor(pool, mint {0}, (n + chunk - 1) / chunk, 1, [data, &e, n, chunk](mint k) {
+			Detail::evaluateRange(data, e, k * chunk, std::min(n, (k + 1) * chunk));
+		});
+	}
+
+	/// Element-wise sum
+	template<typename A, typename B, typename = Detail::enable_if_expression<A, B>>
+	auto operator+(const A& a, const B& b) {
+		return Detail::makeExpression(std::plus<> {}, a, b);
+	}
+
+	/// Element-wise difference
+	template<typename A, typename B, typename = Detail::enable_if_expression<A, B>>
+	auto operator-(const A& a, const B& b) {
+		return Detail::makeExpression(std::minus<> {}, a, b);
+	}
+
+	/// Element-wise product
+	template<typename A, typename B, typename = Detail::enable_if_expression<A, B>>
+	auto operator*(const A& a, const B& b) {
+		return Detail::makeExpression(std::multiplies<> {}, a, b);
+	}
+
+	/// Element-wise quotient
+	template<typename A, typename B, typename = Detail::enable_if_expression<A, B>>
+	auto operator/(const A& a, const B& b) {
+		return Detail::makeExpression(std::divides<> {}, a, b);
+	}
+
+	/// Element-wise negation
+	template<typename A, typename = Detail::enable_if_expression<A>>
+	auto operator-(const A& a) {
+		return Detail::makeExpression(std::negate<> {}, a);
+	}
+
+	/// Element-wise minimum
+	template<typename A, typename B, typename = Detail::enable_if_expression<A, B>>
+	auto min(const A& a, const B& b) {
+		return Detail::makeExpression(Detail::Min {}, a, b);
+	}
+
+	/// Element-wise maximum
+	template<typename A, typename B, typename = Detail::enable_if_expression<A, B>>
+	auto max(const A& a, const B& b) {
+		return Detail::makeExpression(Detail::Max {}, a, b);
+	}
+
+	/// Element-wise power
+	template<typename A, typename B, typename = Detail::enable_if_expression<A, B>>
+	auto pow(const A& a, const B& b) {
+		return Detail::makeExpression(Detail::Pow {}, a, b);
+	}
+
+	/// Element-wise conversion to type U with static_cast
+	template<typename U, typename A, typename = Detail::enable_if_expression<A>>
+	auto cast(const A& a) {
+		return Detail::makeExpression(Detail::CastTo<U> {}, a);
+	}
+
+/// Define a function object that calls the given function from <cmath> or <complex> and a lazy version of the function
+#define LLU_EXPRESSION_UNARY_FUNCTION(name)                                              \
+	namespace Detail {                                                                   \
+		struct name##Function {                                                          \
+			template<typename T>                                                         \
+			auto operator()(const T& x) const {                                          \
+				using std::name;                                                         \
+				return name(x);                                                          \
+			}                                                                            \
+		};                                                                               \
+	}                                                                                    \
+	template<typename A, typename = Detail::enable_if_expression<A>>                     \
+	auto name(const A& a) {                                                              \
+		return Detail::makeExpression(Detail::name##Function {}, a);                     \
+	}
+
+	/* Lazy element-wise versions of common math functions, e.g. Expr::sqrt(a * a + b * b). Subexpressions are found by argument-dependent
+	 * lookup, so Expr:: may be omitted when the argument is already an expression. */
+	LLU_EXPRESSION_UNARY_FUNCTION(abs)
+	LLU_EXPRESSION_UNARY_FUNCTION(sqrt)
+	LLU_EXPRESSION_UNARY_FUNCTION(exp)
+	LLU_EXPRESSION_UNARY_FUNCTION(log)
+	LLU_EXPRESSION_UNARY_FUNCTION(sin)
+	LLU_EXPRESSION_UNARY_FUNCTION(cos)
+	LLU_EXPRESSION_UNARY_FUNCTION(tan)
+	LLU_EXPRESSION_UNARY_FUNCTION(tanh)
+
+#undef LLU_EXPRESSION_UNARY_FUNCTION
+
+}  // namespace LLU::Expr
+
+namespace LLU {
+	// Make the operators visible to argument-dependent lookup for Tensors, NumericArrays and Images, without qualification or using-directives.
+	// Functions like Expr::sqrt are not brought in, so that they do not hide the functions from <cmath> inside namespace LLU.
+	using Expr::operator+;
+	using Expr::operator-;
+	using Expr::operator*;
+	using Expr::operator/;
+}  // namespace LLU
+
+#endif	  // LLU_EXPRESSIONS_H
@@ -6,13 +6,18 @@
 #ifndef LLU_FILEUTILITIES_H
 #define LLU_FILEUTILITIES_H
 
-#include <codecvt>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <ios>
-#include <locale>
 #include <memory>
 #include <string>
+#include <type_traits>
+
+#include "LLU/Containers/MArrayDimensions.h"
+#include "LLU/Containers/Views/Strided.hpp"
 
 namespace LLU {
 	/// Smart pointer type around std::FILE
@@ -33,28 +38,265 @@ namespace LLU {
 	 */
 	void validatePath(const std::string& fileName, std::ios::openmode mode);
 
+	/// Outcome of a conversion between Unicode encodings
+	enum class ConversionStatus {
+		Ok,				///< whole input was converted
+		InvalidInput,	///< input contains an invalid code unit sequence
+		BufferTooSmall	///< output buffer is full, conversion can be resumed in a new buffer
+	};
+
+	/// Result of a conversion between Unicode encodings into a caller-provided buffer
+	struct ConversionResult {
+		/// Whether the conversion succeeded
+		ConversionStatus status;
+		/// Number of input code units consumed, on failure this is the position of the first code unit that was not converted
+		std::size_t read;
+		/// Number of code units written to the output buffer
+		std::size_t written;
+	};
+
+	namespace Detail {
+		/// Get the value of a code unit of any character type as an unsigned number
+		template<typename T>
+		constexpr std::uint32_t codeUnit(T c) noexcept {
+			return static_cast<std::uint32_t>(static_cast<std::make_unsigned_t<T>>(c));
+		}
+
+		/// Bit mask for checking if any of 8 bytes in a word is not an ASCII character
+		inline constexpr std::uint64_t nonASCIIBits = 0x8080808080808080ULL;
+
+		/**
+		 * Decode UTF8 string into UTF16 (when \p SurrogatePairs is true) or UTF32.
+		 * Runs of ASCII characters are checked 8 bytes at a time and widened in simple loops that compilers vectorize.
+		 */
+		template<bool SurrogatePairs, typename T>
+		ConversionResult decodeUTF8(const char* source, std::size_t length, T* out, std::size_t capacity) noexcept {
+			const auto* src = reinterpret_cast<const unsigned char*>(source);	 // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+			std::size_t i = 0;
+			std::size_t o = 0;
+			while (i < length) {
+				if (src[i] < 0x80) {
+					constexpr std::size_t wordSize = sizeof(std::uint64_t);
+					while (i + wordSize <= length && o + wordSize <= capacity) {
+						std::uint64_t word {};
+						std::memcpy(&word, src + i, wordSize);
+						if ((word & nonASCIIBits) != 0) {
+							break;
+						}
+						for (std::size_t k = 0; k < wordSize; ++k) {
+							out[o + k] = static_cast<T>(src[i + k]);
+						}
+						i += wordSize;
+						o += wordSize;
+					}
+					if (i < length && src[i] < 0x80) {
+						if (o == capacity) {
+							return {ConversionStatus::BufferTooSmall, i, o};
+						}
+						out[o++] = static_cast<T>(src[i++]);
+					}
+					continue;
+				}
+				std::uint32_t lead = src[i];
+				std::size_t trailing {};
+				std::uint32_t cp {};
+				if (lead < 0xC2) {
+					// a continuation byte without a lead byte, or an overlong encoding of an ASCII character
+					return {ConversionStatus::InvalidInput, i, o};
+				} else if (lead < 0xE0) {
+					trailing = 1;
+					cp = lead & 0x1FU;
+				} else if (lead < 0xF0) {
+					trailing = 2;
+					cp = lead & 0x0FU;
+				} else if (lead < 0xF5) {
+					trailing = 3;
+					cp = lead & 0x07U;
+				} else {
+					return {ConversionStatus::InvalidInput, i, o};
+				}
+				if (length - i <= trailing) {
+					return {ConversionStatus::InvalidInput, i, o};
+				}
+				for (std::size_t k = 1; k <= trailing; ++k) {
+					std::uint32_t next = src[i + k];
+					if ((next & 0xC0U) != 0x80U) {
+						return {ConversionStatus::InvalidInput, i, o};
+					}
+					cp = (cp << 6U) | (next & 0x3FU);
+				}
+				bool overlong = (trailing == 2 && cp < 0x800) || (trailing == 3 && cp < 0x10000);
+				if (overlong || (cp >= 0xD800 && cp <= 0xDFFF) || cp > 0x10FFFF) {
+					return {ConversionStatus::InvalidInput, i, o};
+				}
+				if constexpr (SurrogatePairs) {
+					if (cp >= 0x10000) {
+						if (capacity - o < 2) {
+							return {ConversionStatus::BufferTooSmall, i, o};
+						}
+						cp -= 0x10000;
+						out[o++] = static_cast<T>(0xD800 + (cp >> 10U));
+						out[o++] = static_cast<T>(0xDC00 + (cp & 0x3FFU));
+						i += trailing + 1;
+						continue;
+					}
+				}
+				if (o == capacity) {
+					return {ConversionStatus::BufferTooSmall, i, o};
+				}
+				out[o++] = static_cast<T>(cp);
+				i += trailing + 1;
+			}
+			return {ConversionStatus::Ok, i, o};
+		}
+
+		/**
+		 * Encode UTF16 (when \p SurrogatePairs is true) or UTF32 string as UTF8.
+		 * Runs of ASCII characters are narrowed 4 code units at a time.
+		 */
+		template<bool SurrogatePairs, typename T>
+		ConversionResult encodeUTF8(const T* source, std::size_t length, char* out, std::size_t capacity) noexcept {
+			std::size_t i = 0;
+			std::size_t o = 0;
+			while (i < length) {
+				constexpr std::size_t blockSize = 4;
+				while (i + blockSize <= length && o + blockSize <= capacity
+					   && (codeUnit(source[i]) | codeUnit(source[i + 1]) | codeUnit(source[i + 2]) | codeUnit(source[i + 3])) < 0x80) {
+					for (std::size_t k = 0; k < blockSize; ++k) {
+						out[o + k] = static_cast<char>(source[i + k]);
+					}
+					i += blockSize;
+					o += blockSize;
+				}
+				if (i == length) {
+					break;
+				}
+				std::uint32_t cp = codeUnit(source[i]);
+				std::size_t consumed = 1;
+				if constexpr (SurrogatePairs) {
+					if (cp > 0xFFFF || (cp >= 0xDC00 && cp <= 0xDFFF)) {
+						return {ConversionStatus::InvalidInput, i, o};
+					}
+					if (cp >= 0xD800 && cp <= 0xDBFF) {
+						std::uint32_t low = (i + 1 < length) ? codeUnit(source[i + 1]) : 0;
+						if (low < 0xDC00 || low > 0xDFFF) {
+							return {ConversionStatus::InvalidInput, i, o};
+						}
+						cp = 0x10000 + ((cp - 0xD800) << 10U) + (low - 0xDC00);
+						consumed = 2;
+					}
+				} else {
+					if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+						return {ConversionStatus::InvalidInput, i, o};
+					}
+				}
+				std::size_t bytes = (cp < 0x80) ? 1 : (cp < 0x800) ? 2 : (cp < 0x10000) ? 3 : 4;
+				if (capacity - o < bytes) {
+					return {ConversionStatus::BufferTooSmall, i, o};
+				}
+				switch (bytes) {
+					case 1: out[o] = static_cast<char>(cp); break;
+					case 2:
+						out[o] = static_cast<char>(0xC0U | (cp >> 6U));
+						out[o + 1] = static_cast<char>(0x80U | (cp & 0x3FU));
+						break;
+					case 3:
+						out[o] = static_cast<char>(0xE0U | (cp >> 12U));
+						out[o + 1] = static_cast<char>(0x80U | ((cp >> 6U) & 0x3FU));
+						out[o + 2] = static_cast<char>(0x80U | (cp & 0x3FU));
+						break;
+					default:
+						out[o] = static_cast<char>(0xF0U | (cp >> 18U));
+						out[o + 1] = static_cast<char>(0x80U | ((cp >> 12U) & 0x3FU));
+						out[o + 2] = static_cast<char>(0x80U | ((cp >> 6U) & 0x3FU));
+						out[o + 3] = static_cast<char>(0x80U | (cp & 0x3FU));
+				}
+				i += consumed;
+				o += bytes;
+			}
+			return {ConversionStatus::Ok, i, o};
+		}
+
+		/**
+		 * Throw an exception about invalid input of a conversion between Unicode encodings.
+		 * @param   encoding - name of the encoding of the input
+		 * @param   position - position of the first invalid code unit in the input
+		 */
+		[[noreturn]] void throwConversionError(const std::string& encoding, std::size_t position);
+	}  // namespace Detail
+
+	/**
+	 * Convert UTF8 string to UTF16 in a buffer provided by the caller.
+	 * @tparam  T - character type of the output, e.g. char16_t or wchar_t
+	 * @param   source - string in UTF8 encoding
+	 * @param   length - length of the \p source in bytes
+	 * @param   out - output buffer
+	 * @param   capacity - size of the output buffer, a buffer of \p length code units is always large enough
+	 * @return  status of the conversion together with the number of bytes read and code units written
+	 */
+	template<typename T>
+	ConversionResult convertUTF8toUTF16(const char* source, std::size_t length, T* out, std::size_t capacity) noexcept {
+		return Detail::decodeUTF8<true>(source, length, out, capacity);
+	}
+
+	/**
+	 * Convert UTF16 string to UTF8 in a buffer provided by the caller.
+	 * @tparam  T - character type of the input, e.g. char16_t or wchar_t
+	 * @param   source - string in UTF16 encoding
+	 * @param   length - length of the \p source in code units
+	 * @param   out - output buffer
+	 * @param   capacity - size of the output buffer in bytes, a buffer of 3 * \p length bytes is always large enough
+	 * @return  status of the conversion together with the number of code units read and bytes written
+	 */
+	template<typename T>
+	ConversionResult convertUTF16toUTF8(const T* source, std::size_t length, char* out, std::size_t capacity) noexcept {
+		return Detail::encodeUTF8<true>(source, length, out, capacity);
+	}
+
+	/**
+	 * Convert UTF8 string to UTF32 in a buffer provided by the caller.
+	 * @tparam  T - character type of the output, e.g. char32_t
+	 * @param   source - string in UTF8 encoding
+	 * @param   length - length of the \p source in bytes
+	 * @param   out - output buffer
+	 * @param   capacity - size of the output buffer, a buffer of \p length code units is always large enough
+	 * @return  status of the conversion together with the number of bytes read and code units written
+	 */
+	template<typename T>
+	ConversionResult convertUTF8toUTF32(const char* source, std::size_t length, T* out, std::size_t capacity) noexcept {
+		return Detail::decodeUTF8<false>(source, length, out, capacity);
+	}
+
+	/**
+	 * Convert UTF32 string to UTF8 in a buffer provided by the caller.
+	 * @tparam  T - character type of the input, e.g. char32_t
+	 * @param   source - string in UTF32 encoding
+	 * @param   length - length of the \p source in code units
+	 * @param   out - output buffer
+	 * @param   capacity - size of the output buffer in bytes, a buffer of 4 * \p length bytes is always large enough
+	 * @return  status of the conversion together with the number of code units read and bytes written
+	 */
+	template<typename T>
+	ConversionResult convertUTF32toUTF8(const T* source, std::size_t length, char* out, std::size_t capacity) noexcept {
+		return Detail::encodeUTF8<false>(source, length, out, capacity);
+	}
+
 	/**
 	 * Convert string from UTF8 to UTF16.
 	 * @tparam	T - character type for the result, supported types are char16_t, char32_t, or wchar_t
 	 * @param	source - string in UTF8 encoding
 	 * @return  copy of the input string converted to UTF16
-	 * @note    char16_t and char32_t strings on Windows will be converted to a temporary std::wstring first due to a bug in VS2017
+	 * @throw   ErrorName::InvalidEncoding if \p source is not a valid UTF8 string
 	 */
 	template<typename T>
 	std::basic_string<T> fromUTF8toUTF16(const std::string& source) {
-#ifdef _WIN32
-		// On Windows with VS2017 only conversion to wchar_t is supported, so we have no choice here
-		std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> convertor;
-		if constexpr (!std::is_same_v<T, wchar_t>) {
-			std::wstring tmp = convertor.from_bytes(source);
-			return std::basic_string<T> { std::begin(tmp), std::end(tmp) };
-		} else {
-			return convertor.from_bytes(source);
+		std::basic_string<T> result(source.size(), T {});
+		auto conversion = convertUTF8toUTF16(source.data(), source.size(), result.data(), result.size());
+		if (conversion.status != ConversionStatus::Ok) {
+			Detail::throwConversionError("UTF8", conversion.read);
 		}
-#else
-		std::wstring_convert<std::codecvt_utf8_utf16<T>, T> convertor;
-		return convertor.from_bytes(source);
-#endif
+		result.resize(conversion.written);
+		return result;
 	}
 
 	/**
@@ -62,22 +304,17 @@ namespace LLU {
 	 * @tparam  T - character type of the UTF16 string, supported types are char16_t, char32_t, or wchar_t
 	 * @param   source - string in UTF16 encoding
 	 * @return  copy of the input string converted to UTF8
-	 * @note    char16_t and char32_t strings on Windows will be converted to std::wstring before encoding conversion due to a bug in VS2017
+	 * @throw   ErrorName::InvalidEncoding if \p source is not a valid UTF16 string
 	 */
 	template<typename T>
 	std::string fromUTF16toUTF8(const std::basic_string<T>& source) {
-#ifdef _WIN32
-		// On Windows with VS2017 only conversion from wchar_t is supported, so we have no choice here
-		std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> convertor;
-		if constexpr (!std::is_same_v<T, wchar_t>) {
-			return convertor.to_bytes(std::wstring { std::begin(source), std::end(source) });
-		} else {
-			return convertor.to_bytes(source);
+		std::string result(3 * source.size(), '\0');
+		auto conversion = convertUTF16toUTF8(source.data(), source.size(), result.data(), result.size());
+		if (conversion.status != ConversionStatus::Ok) {
+			Detail::throwConversionError("UTF16", conversion.read);
 		}
-#else
-		std::wstring_convert<std::codecvt_utf8_utf16<T>, T> convertor;
-		return convertor.to_bytes(source);
-#endif
+		result.resize(conversion.written);
+		return result;
 	}
 
 	/**
@@ -85,22 +322,17 @@ namespace LLU {
 	 * @tparam  T - character type for the result
 	 * @param   source - string in UTF8 encoding
 	 * @return  copy of the input string converted to UTF32
+	 * @throw   ErrorName::InvalidEncoding if \p source is not a valid UTF8 string
 	 */
 	template<typename T>
 	std::basic_string<T> fromUTF8toUTF32(const std::string& source) {
-#ifdef _WIN32
-		// On Windows with VS2017 we always convert to uint32_t
-		std::wstring_convert<std::codecvt_utf8<uint32_t>, uint32_t> convertor;
-		if constexpr (!std::is_same_v<T, uint32_t>) {
-			std::basic_string<uint32_t> tmp = convertor.from_bytes(source);
-			return std::basic_string<T> { std::begin(tmp), std::end(tmp) };
-		} else {
-			return convertor.from_bytes(source);
+		std::basic_string<T> result(source.size(), T {});
+		auto conversion = convertUTF8toUTF32(source.data(), source.size(), result.data(), result.size());
+		if (conversion.status != ConversionStatus::Ok) {
+			Detail::throwConversionError("UTF8", conversion.read);
 		}
-#else
-		std::wstring_convert<std::codecvt_utf8<T>, T> convertor;
-		return convertor.from_bytes(source);
-#endif
+		result.resize(conversion.written);
+		return result;
 	}
 
 	/**
@@ -108,21 +340,17 @@ namespace LLU {
 	 * @tparam  T - character type of the UTF32 string
 	 * @param   source - string in UTF32 encoding
 	 * @return  copy of the input string converted to UTF8
+	 * @throw   ErrorName::InvalidEncoding if \p source is not a valid UTF32 string
 	 */
 	template<typename T>
 	std::string fromUTF32toUTF8(const std::basic_string<T>& source) {
-#ifdef _WIN32
-		// On Windows with VS2017 we always convert from uint32_t
-		std::wstring_convert<std::codecvt_utf8<uint32_t>, uint32_t> convertor;
-		if constexpr (!std::is_same_v<T, uint32_t>) {
-			return convertor.to_bytes(std::basic_string<uint32_t> { std::begin(source), std::end(source) });
-		} else {
-			return convertor.to_bytes(source);
+		std::string result(4 * source.size(), '\0');
+		auto conversion = convertUTF32toUTF8(source.data(), source.size(), result.data(), result.size());
+		if (conversion.status != ConversionStatus::Ok) {
+			Detail::throwConversionError("UTF32", conversion.read);
 		}
-#else
-		std::wstring_convert<std::codecvt_utf8<T>, T> convertor;
-		return convertor.to_bytes(source.data());
-#endif
+		result.resize(conversion.written);
+		return result;
 	}
 
 	/**
@@ -171,6 +399,120 @@ namespace LLU {
 	 * @throw   ErrorName::OpenFileFailed if the file could not be opened
 	 */
 	std::fstream openFileStream(const std::string& fileName, std::ios::openmode mode, const SharePolicy& shp = AlwaysReadExclusiveWrite {});
+
+	/// Expected pattern of access to a memory-mapped file, passed to the OS to tune read-ahead
+	enum class AccessHint {
+		Normal,		   ///< no special treatment
+		Sequential,	   ///< pages will be read in order, read ahead aggressively and drop pages after they are read
+		Random,		   ///< pages will be read in random order, do not read ahead
+		WillNeed	   ///< pages will be needed soon, start reading them now
+	};
+
+	/**
+	 * @brief   Read-only or read-write memory mapping of a whole file.
+	 *
+	 * Mapping a file lets the OS page its contents in on demand directly from the page cache, so large inputs can be processed without
+	 * reading them into a separate buffer. Typed views of the mapped bytes can be obtained with view(), they stay valid as long as the
+	 * MappedFile object lives.
+	 */
+	class MappedFile {
+	public:
+		/// Create an empty mapping
+		MappedFile() = default;
+
+		/**
+		 * Map given file into memory.
+		 * Checks with WolframLibraryData if the path is "valid", in the same way as openFile does.
+		 * @param   fileName - path to an existing file
+		 * @param   mode - std::ios::in for a read-only mapping or std::ios::in | std::ios::out for a read-write mapping, other flags are invalid
+		 * @param   shp - shared access policy, only used on Windows
+		 * @throw   ErrorName::InvalidOpenMode if \p mode is not supported
+		 * @throw   ErrorName::OpenFileFailed if the file could not be opened
+		 * @throw   ErrorName::MapFileFailed if the file could not be mapped
+		 */
+		explicit MappedFile(const std::string& fileName, std::ios::openmode mode = std::ios::in, const SharePolicy& shp = AlwaysReadExclusiveWrite {});
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		/// Move-constructor, \p other becomes empty
+		MappedFile(MappedFile&& other) noexcept;
+
+		/// Move-assignment operator, unmaps the current file and takes over the mapping of \p other
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		/// Unmap the file
+		~MappedFile();
+
+		/// Get pointer to the first mapped byte, nullptr for empty files
+		[[nodiscard]] const std::byte* data() const noexcept {
+			return address;
+		}
+
+		/// Get pointer to the first mapped byte of a writable mapping
+		/// @throw ErrorName::InvalidOpenMode if the file was mapped read-only
+		[[nodiscard]] std::byte* writableData();
+
+		/// Get size of the mapped file in bytes
+		[[nodiscard]] std::size_t size() const noexcept {
+			return length;
+		}
+
+		/// Check if the mapping is empty
+		[[nodiscard]] bool empty() const noexcept {
+			return length == 0;
+		}
+
+		/// Check if the mapping allows writing
+		[[nodiscard]] bool isWritable() const noexcept {
+			return writable;
+		}
+
+		/**
+		 * Tell the OS how given range of the file will be accessed. The hint is ignored where the OS does not support it.
+		 * @param   hint - expected access pattern
+		 * @param   offset - beginning of the range in bytes
+		 * @param   count - length of the range in bytes, by default until the end of the file
+		 */
+		void advise(AccessHint hint, std::size_t offset = 0, std::size_t count = static_cast<std::size_t>(-1)) const noexcept;
+
+		/// Write modified pages of a writable mapping back to the file
+		void flush() const;
+
+		/**
+		 * Get a read-only typed view of the mapped bytes, e.g. of a packed array of numbers stored in the file.
+		 * @tparam  T - type of elements
+		 * @param   dims - dimensions of the array, elements are laid out in row-major order
+		 * @param   offset - position of the first element in bytes, must be a multiple of alignof(T)
+		 * @return  view of the array, valid as long as this MappedFile
+		 * @throw   ErrorName::DimensionsError if the array does not fit in the file or the offset is misaligned
+		 */
+		template<typename T>
+		StridedView<const T> view(const MArrayDimensions& dims, std::size_t offset = 0) const {
+			static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be read from a mapped file.");
+			checkRange(offset, static_cast<std::size_t>(dims.flatCount()) * sizeof(T), alignof(T));
+			return StridedView<const T> {reinterpret_cast<const T*>(address + offset), dims};	// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		}
+
+		/**
+		 * Get a read-only view of the whole file (starting at \p offset) as a flat array of elements of type T.
+		 * Trailing bytes that do not form a whole element are not included in the view.
+		 */
+		template<typename T>
+		StridedView<const T> view(std::size_t offset = 0) const {
+			auto count = offset < length ? (length - offset) / sizeof(T) : 0;
+			return view<T>(MArrayDimensions {static_cast<mint>(count)}, offset);
+		}
+
+	private:
+		void checkRange(std::size_t offset, std::size_t bytes, std::size_t alignment) const;
+
+		void unmap() noexcept;
+
+		std::byte* address = nullptr;
+		std::size_t length = 0;
+		bool writable = false;
+	};
 } // namespace LLU
 
 #endif	  // LLU_FILEUTILITIES_H
@@ -0,0 +1,97 @@
+/**
+ * @file	FunctionRegistry.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Registry of library functions defined in a paclet, which lets the Wolfram Language layer get the whole function table in one call.
+ */
+#ifndef LLU_FUNCTIONREGISTRY_H
+#define LLU_FUNCTIONREGISTRY_H
+
+#include <atomic>
+#include <string_view>
+#include <vector>
+
+#include "LLU/LibraryData.h"
+
+namespace LLU {
+
+	/// Type of a pointer to a LibraryLink function that uses MArguments
+	using LibraryLinkFunction = int (*)(WolframLibraryData, mint, MArgument*, MArgument);
+
+	/**
+	 * @class   FunctionRegistry
+	 * @brief   Static table of library functions defined with LLU macros, in the order in which they were registered.
+	 *
+	 * Functions defined with LLU_LIBRARY_FUNCTION, LLU_TYPED_FUNCTION or any of the listable macros, and functions passed to
+	 * LLU_REGISTER_FUNCTION, are added to the registry when the paclet library is loaded. The position of a function in the registry is its ID.
+	 * IDs are only valid for a single build of the library, so the Wolfram Language layer always reads them with the exported function
+	 * getFunctionTable, which sends an Association of function names and IDs.
+	 */
+	class FunctionRegistry {
+	public:
+		/// Registered function
+		struct Entry {
+			/// Name of the function as exported from the library
+			const char* name;
+			/// Pointer to the function
+			LibraryLinkFunction function;
+		};
+
+		/**
+		 * Function that the dispatcher calls instead of the registered function, for example to count, time or log calls in a uniform way.
+		 * It receives the registry entry and the arguments of the call and must call entry.function itself.
+		 */
+		using DispatchInterceptor = int (*)(const Entry& entry, WolframLibraryData libData, mint Argc, MArgument* Args, MArgument Res);
+
+		FunctionRegistry() = delete;
+
+		/**
+		 * @brief   Add a function to the registry, this is done by LLU macros during static initialization of the library
+		 * @param   name - name of the exported function
+		 * @param   function - pointer to the function
+		 * @return  ID of the function
+		 */
+		static mint add(const char* name, LibraryLinkFunction function);
+
+		/// Get all registered functions, ordered by ID
+		static const std::vector<Entry>& functions();
+
+		/**
+		 * @brief   Find the ID of a function with given name
+		 * @param   name - name of the exported function
+		 * @return  ID of the function or -1 if there is no such function in the registry
+		 */
+		static mint find(std::string_view name);
+
+		/**
+		 * @brief   Call the function with given ID, this is what the exported function dispatchLibraryFunction does
+		 * @param   id - ID of the function
+		 * @param   libData - WolframLibraryData
+		 * @param   Argc - number of arguments of the function
+		 * @param   Args - arguments of the function
+		 * @param   Res - result of the function
+		 * @return  error code returned by the function, or ErrorCode::FunctionError if there is no function with given ID
+		 */
+		static int dispatch(mint id, WolframLibraryData libData, mint Argc, MArgument* Args, MArgument Res);
+
+		/**
+		 * @brief   Set the function that will be called by dispatch instead of the registered functions.
+		 * @param   interceptor - new interceptor, nullptr removes the current one
+		 * @note    Only calls made through the dispatcher are intercepted, functions loaded directly with LibraryFunctionLoad are called as usual.
+		 */
+		static void setInterceptor(DispatchInterceptor interceptor) noexcept;
+
+		/**
+		 * @brief   Send an Association of function names and IDs via WSTP
+		 * @param   mlp - active WSTP connection
+		 */
+		static void sendFunctionTable(WSLINK mlp);
+
+	private:
+		static std::vector<Entry>& table();
+
+		static std::atomic<DispatchInterceptor> interceptor;
+	};
+
+}  // namespace LLU
+
+#endif	  // LLU_FUNCTIONREGISTRY_H
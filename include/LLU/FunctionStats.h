@@ -0,0 +1,187 @@
+/**
+ * @file	FunctionStats.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Optional instrumentation of library functions: call and exception counts and latency statistics per function.
+ */
+#ifndef LLU_FUNCTIONSTATS_H
+#define LLU_FUNCTIONSTATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "LLU/LibraryData.h"
+
+namespace LLU {
+
+	/**
+	 * Whether library functions defined with LLU macros collect statistics. Define LLU_FUNCTION_STATS to enable them, otherwise the
+	 * instrumentation is compiled out. The library exports getFunctionStats and resetFunctionStats either way, without the flag they report no functions.
+	 * @note The flag must have the same value in all translation units of a paclet.
+	 */
+#ifdef LLU_FUNCTION_STATS
+	inline constexpr bool functionStatsEnabled = true;
+#else
+	inline constexpr bool functionStatsEnabled = false;
+#endif
+
+	/// Snapshot of statistics of a single library function, summed over all threads
+	struct FunctionCallStats {
+		/// Number of buckets of the latency histogram
+		static constexpr std::size_t bucketCount = 48;
+
+		/// Name of the function
+		std::string name;
+		/// Number of calls
+		std::uint64_t calls = 0;
+		/// Number of calls that ended with an exception
+		std::uint64_t exceptions = 0;
+		/// Total time spent in the function, in nanoseconds
+		std::uint64_t totalNs = 0;
+		/// Shortest call, in nanoseconds, or 0 if there were no calls
+		std::uint64_t minNs = 0;
+		/// Longest call, in nanoseconds
+		std::uint64_t maxNs = 0;
+		/// Bucket 0 counts calls shorter than 1 ns, bucket k > 0 counts calls in [2^(k-1), 2^k) ns and the last bucket collects everything above
+		std::array<std::uint64_t, bucketCount> histogram {};
+
+		/// Find the histogram bucket for given latency in nanoseconds
+		static std::size_t bucketOf(std::uint64_t ns) noexcept {
+			std::size_t bucket = 0;
+			while (ns > 0 && bucket < bucketCount - 1) {
+				ns >>= 1;
+				++bucket;
+			}
+			return bucket;
+		}
+
+		/**
+		 * Estimate a percentile of the latency from the histogram
+		 * @param q - percentile as a fraction in [0, 1]
+		 * @return upper bound of the bucket in which the percentile falls, in nanoseconds, but not more than maxNs
+		 */
+		[[nodiscard]] std::uint64_t percentileNs(double q) const noexcept;
+
+		/// Add statistics of the same function collected by another thread
+		FunctionCallStats& operator+=(const FunctionCallStats& other) noexcept;
+	};
+
+	/**
+	 * @class   FunctionStats
+	 * @brief   Live statistics of a single library function.
+	 *
+	 * Every thread that calls the function gets its own cache-line aligned set of counters, which only this thread writes with relaxed
+	 * atomic stores, so recording a call takes no locks and no read-modify-write operations. Counters of all threads are summed when
+	 * a snapshot is taken. Instances are created by LLU macros when LLU_FUNCTION_STATS is defined and live until the library is unloaded.
+	 */
+	class FunctionStats {
+	public:
+		/// Clock used to measure calls
+		using Clock = std::chrono::steady_clock;
+
+		/// Counters of a single thread
+		struct alignas(64) Shard {
+			std::atomic<std::uint64_t> calls {0};
+			std::atomic<std::uint64_t> exceptions {0};
+			std::atomic<std::uint64_t> totalNs {0};
+			std::atomic<std::uint64_t> minNs {std::numeric_limits<std::uint64_t>::max()};
+			std::atomic<std::uint64_t> maxNs {0};
+			std::array<std::atomic<std::uint64_t>, FunctionCallStats::bucketCount> histogram {};
+
+			/// Record a call, must only be called by the thread that owns the shard
+			void record(std::uint64_t ns, bool failed) noexcept {
+				bump(calls, 1);
+				bump(totalNs, ns);
+				if (failed) {
+					bump(exceptions, 1);
+				}
+				if (ns < minNs.load(std::memory_order_relaxed)) {
+					minNs.store(ns, std::memory_order_relaxed);
+				}
+				if (ns > maxNs.load(std::memory_order_relaxed)) {
+					maxNs.store(ns, std::memory_order_relaxed);
+				}
+				bump(histogram[FunctionCallStats::bucketOf(ns)], 1);
+			}
+
+		private:
+			static void bump(std::atomic<std::uint64_t>& c, std::uint64_t n) noexcept {
+				c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+			}
+		};
+
+		/// Measures a single call from construction to destruction, a call during which an exception propagates is counted as failed
+		class Scope {
+		public:
+			explicit Scope(Shard& s) noexcept : shard {s}, exceptions {std::uncaught_exceptions()}, start {Clock::now()} {}
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+			~Scope() {
+				auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+				shard.record(static_cast<std::uint64_t>(ns), std::uncaught_exceptions() > exceptions);
+			}
+
+		private:
+			Shard& shard;
+			int exceptions;
+			Clock::time_point start;
+		};
+
+		/**
+		 * Create statistics for a function and add them to the list of all instrumented functions
+		 * @param name - name of the library function
+		 */
+		explicit FunctionStats(const char* name);
+
+		FunctionStats(const FunctionStats&) = delete;
+		FunctionStats& operator=(const FunctionStats&) = delete;
+
+		/// Create counters for the calling thread, they stay valid as long as this object
+		Shard* newShard();
+
+		/// Get statistics summed over all threads
+		[[nodiscard]] FunctionCallStats snapshot() const;
+
+		/// Reset all counters. Calls that are recorded at the same time by other threads may be partially lost.
+		void reset() noexcept;
+
+		/// Get snapshots of all instrumented functions
+		static std::vector<FunctionCallStats> snapshotAll();
+
+		/// Reset counters of all instrumented functions
+		static void resetAll() noexcept;
+
+	private:
+		const char* functionName;
+		mutable std::mutex mutex;
+		std::vector<std::unique_ptr<Shard>> shards;
+	};
+
+}  // namespace LLU
+
+/**
+ * @def     LLU_FUNCTION_STATS_DEFINE(name)
+ * Define statistics for the library function with given name, must be used at namespace scope. Expands to nothing useful without LLU_FUNCTION_STATS.
+ *
+ * @def     LLU_FUNCTION_STATS_SCOPE(name)
+ * Measure the rest of the enclosing block as a call of the library function with given name. Expands to nothing without LLU_FUNCTION_STATS.
+ */
+#ifdef LLU_FUNCTION_STATS
+#define LLU_FUNCTION_STATS_DEFINE(name) static LLU::FunctionStats llu_functionStats_##name {#name}
+#define LLU_FUNCTION_STATS_SCOPE(name)                                                                                   \
+	static thread_local LLU::FunctionStats::Shard* const llu_functionStatsShard = llu_functionStats_##name.newShard(); \
+	const LLU::FunctionStats::Scope llu_functionStatsScope {*llu_functionStatsShard}
+#else
+#define LLU_FUNCTION_STATS_DEFINE(name) static_assert(true)
+#define LLU_FUNCTION_STATS_SCOPE(name) static_cast<void>(0)
+#endif
+
+#endif	  // LLU_FUNCTIONSTATS_H
@@ -0,0 +1,323 @@
+/**
+ * @file	ImageKernels.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Histograms, thresholds, counting and morphological filters working directly on the pixel data of "Bit", "Byte" and "Bit16" Images.
+ *
+ * Like in Kernels.h, every kernel has a form working on raw pointers and a form working on containers. None of them goes through
+ * MImage_getBit / MImage_getByte / MImage_getBit16 for individual pixels, loops run over raw memory and are written so that compilers
+ * vectorize them. Binary masks can be converted to the bit-packed BitMask and processed there with 64 pixels per word operation.
+ */
+#ifndef LLU_IMAGEKERNELS_H
+#define LLU_IMAGEKERNELS_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "LLU/Containers/BitMask.h"
+#include "LLU/Containers/Image.h"
+#include "LLU/Containers/Scratch.h"
+#include "LLU/Containers/Views/Pixels.hpp"
+#include "LLU/Kernels.h"
+
+namespace LLU::Kernels {
+
+	namespace Detail {
+		/// Pixel types of "Bit", "Byte" and "Bit16" Images
+		template<typename T>
+		inline constexpr bool is_integer_pixel_v = std::is_same_v<T, std::int8_t> || std::is_same_v<T, std::uint8_t> || std::is_same_v<T, std::uint16_t>;
+
+		template<typename T>
+		using enable_if_integer_pixel = std::enable_if_t<is_integer_pixel_v<T>>;
+
+		/**
+		 * Filter a rows x columns plane with the (2 * radius + 1) x (2 * radius + 1) window, combining values with \p op (min or max).
+		 * The window is clipped at the borders. Each direction takes log2(radius) passes: after combining every value with the one \p step
+		 * positions away, the values cover twice as many positions.
+		 */
+		template<typename T, typename Op>
+		void windowFilter(const T* in, T* out, mint rows, mint columns, mint rowStride, mint columnStride, mint radius, Op&& op) {
+			const ScratchScope scope;
+			const mint n = rows * columns;
+			T* fwd = scope.arena().allocateArray<T>(n);
+			T* bwd = scope.arena().allocateArray<T>(n);
+			for (mint i = 0; i < rows; ++i) {
+				T* f = fwd + i * columns;
+				T* b = bwd + i * columns;
+				for (mint c = 0; c < columns; ++c) {
+					f[c] = b[c] = in[i * rowStride + c * columnStride];
+				}
+				for (mint covered = 1; covered < radius + 1;) {
+					const mint step = std::min(covered, radius + 1 - covered);
+					for (mint c = 0; c + step < columns; ++c) {
+						f[c] = op(f[c], f[c + step]);
+					}
+					for (mint c = columns - 1; c >= step; --c) {
+						b[c] = op(b[c], b[c - step]);
+					}
+					covered += step;
+				}
+				for (mint c = 0; c < columns; ++c) {
+					f[c] = op(f[c], b[c]);
+				}
+			}
+			std::copy_n(fwd, n, bwd);
+			for (mint covered = 1; covered < radius + 1;) {
+				const mint step = std::min(covered, radius + 1 - covered);
+				for (mint i = 0; i + step < rows; ++i) {
+					T* f = fwd + i * columns;
+					const T* g = f + step * columns;
+					for (mint c = 0; c < columns; ++c) {
+						f[c] = op(f[c], g[c]);
+					}
+				}
+				for (mint i = rows - 1; i >= step; --i) {
+					T* b = bwd + i * columns;
+					const T* g = b - step * columns;
+					for (mint c = 0; c < columns; ++c) {
+						b[c] = op(b[c], g[c]);
+					}
+				}
+				covered += step;
+			}
+			for (mint i = 0; i < rows; ++i) {
+				for (mint c = 0; c < columns; ++c) {
+					out[i * rowStride + c * columnStride] = op(fwd[i * columns + c], bwd[i * columns + c]);
+				}
+			}
+		}
+
+		/// Layout of an Image, throws ImageSizeError unless both Images have the same one
+		template<typename T, typename U>
+		ImageLayout commonLayout(const Image<T>& a, const Image<U>& b) {
+			const auto l = ImageLayout::of(a);
+			const auto lb = ImageLayout::of(b);
+			if (l.slices != lb.slices || l.rows != lb.rows || l.columns != lb.columns || l.channels != lb.channels ||
+				l.columnStride != lb.columnStride) {
+				ErrorManager::throwException(ErrorName::ImageSizeError);
+			}
+			return l;
+		}
+
+		/// Layout of a 2D Image, throws ImageSizeError for 3D Images and ImageIndexError if the Image has no channel with given index
+		inline ImageLayout planeLayout(const ImageInterface& im, mint channel) {
+			const auto l = ImageLayout::of(im);
+			if (l.slices != 1 || im.is3D()) {
+				ErrorManager::throwException(ErrorName::ImageSizeError);
+			}
+			if (channel < 0 || channel >= l.channels) {
+				ErrorManager::throwException(ErrorName::ImageIndexError, channel);
+			}
+			return l;
+		}
+	}  // namespace Detail
+
+	/// Number of distinct values of a pixel of type T: 2 for "Bit", 256 for "Byte" and 65536 for "Bit16"
+	template<typename T, typename = Detail::enable_if_integer_pixel<T>>
+	inline constexpr mint histogramBins = std::is_same_v<T, std::int8_t> ? 2 : mint {(std::numeric_limits<T>::max)()} + 1;
+
+	/// Value of a white pixel of type T, 1 for "Bit" and the largest value of T otherwise
+	template<typename T, typename = Detail::enable_if_integer_pixel<T>>
+	inline constexpr T pixelMax = std::is_same_v<T, std::int8_t> ? T {1} : (std::numeric_limits<T>::max)();
+
+	/* Raw memory */
+
+	/**
+	 * Add the number of occurrences of every value among a[0], a[stride], ..., a[(n - 1) * stride] to counts[value]
+	 * @param   a - pixel values, "Bit" pixels must be 0 or 1
+	 * @param   n - number of values
+	 * @param   stride - distance between consecutive values, e.g. the number of channels to count a single channel of an interleaved Image
+	 * @param   counts - histogramBins<T> counters
+	 */
+	template<typename T, typename = Detail::enable_if_integer_pixel<T>>
+	void histogram(const T* a, mint n, mint stride, mint* counts) noexcept {
+		if constexpr (std::is_same_v<T, std::int8_t>) {
+			const mint ones = Detail::blockedSum<mint>(n, [a, stride](mint i) { return static_cast<mint>(a[i * stride] != 0); });
+			counts[0] += n - ones;
+			counts[1] += ones;
+		} else if constexpr (sizeof(T) == 1) {
+			// consecutive pixels increment different tables, so runs of equal values do not wait for the previous increment to complete
+			constexpr mint tables = 4;
+			constexpr mint block = mint {1} << 30;
+			std::array<std::array<std::uint32_t, 256>, tables> partial {};
+			for (mint start = 0; start < n; start += block) {
+				const mint end = std::min(n, start + block);
+				mint i = start;
+				for (; i + tables <= end; i += tables) {
+					for (mint t = 0; t < tables; ++t) {
+						++partial[t][a[(i + t) * stride]];
+					}
+				}
+				for (; i < end; ++i) {
+					++partial[0][a[i * stride]];
+				}
+				for (auto& table : partial) {
+					for (mint v = 0; v < 256; ++v) {
+						counts[v] += table[v];
+					}
+					table.fill(0);
+				}
+			}
+		} else {
+			for (mint i = 0; i < n; ++i) {
+				++counts[a[i * stride]];
+			}
+		}
+	}
+
+	/// @copydoc histogram(const T*, mint, mint, mint*)
+	template<typename T, typename = Detail::enable_if_integer_pixel<T>>
+	void histogram(const T* a, mint n, mint* counts) noexcept {
+		histogram(a, n, 1, counts);
+	}
+
+	/// Number of elements equal to \p value
+	template<typename T, typename = Detail::enable_if_ordered<T>>
+	mint count(const T* a, mint n, T value) noexcept {
+		return Detail::blockedSum<mint>(n, [a, value](mint i) { return static_cast<mint>(a[i] == value); });
+	}
+
+	/// Number of elements greater than \p level
+	template<typename T, typename = Detail::enable_if_ordered<T>>
+	mint countAbove(const T* a, mint n, T level) noexcept {
+		return Detail::blockedSum<mint>(n, [a, level](mint i) { return static_cast<mint>(a[i] > level); });
+	}
+
+	/// out[i] = 1 if in[i] > level and 0 otherwise, \p out can be the data of a "Bit" Image
+	template<typename T, typename = Detail::enable_if_ordered<T>>
+	void threshold(const T* in, T level, std::int8_t* out, mint n) noexcept {
+		for (mint i = 0; i < n; ++i) {
+			out[i] = static_cast<std::int8_t>(in[i] > level);
+		}
+	}
+
+	/**
+	 * @brief   Dilation of a single-channel plane with a (2 * radius + 1) x (2 * radius + 1) square, i.e. the maximum over the window around each pixel
+	 * @details The window is clipped at the borders. Temporary rows are allocated in the scratch arena of the calling thread, \p out may be
+	 * the same as \p in.
+	 * @param   in - value of the first pixel
+	 * @param   out - value of the first pixel of the result, with the same strides as \p in
+	 * @param   rows - number of rows
+	 * @param   columns - number of columns
+	 * @param   rowStride - distance between values of the same column in consecutive rows
+	 * @param   columnStride - distance between values of neighboring pixels in a row
+	 * @param   radius - radius of the square
+	 */
+	template<typename T, typename = Detail::enable_if_ordered<T>>
+	void dilate(const T* in, T* out, mint rows, mint columns, mint rowStride, mint columnStride, mint radius) {
+		Detail::windowFilter(in, out, rows, columns, rowStride, columnStride, radius, [](T x, T y) { return std::max(x, y); });
+	}
+
+	/// Erosion of a single-channel plane with a (2 * radius + 1) x (2 * radius + 1) square, i.e. the minimum over the window, see dilate
+	template<typename T, typename = Detail::enable_if_ordered<T>>
+	void erode(const T* in, T* out, mint rows, mint columns, mint rowStride, mint columnStride, mint radius) {
+		Detail::windowFilter(in, out, rows, columns, rowStride, columnStride, radius, [](T x, T y) { return std::min(x, y); });
+	}
+
+	/* Containers */
+
+	/// Histogram of all values of an Image, in all channels
+	template<typename T, typename = Detail::enable_if_integer_pixel<T>>
+	std::vector<mint> histogram(const Image<T>& im) {
+		std::vector<mint> counts(static_cast<std::size_t>(histogramBins<T>));
+		histogram(im.data(), Detail::sizeOf(im), 1, counts.data());
+		return counts;
+	}
+
+	/**
+	 * @brief   Histogram of a single channel of an Image
+	 * @throws  ErrorName::ImageIndexError - if the Image has no channel with given index
+	 */
+	template<typename T, typename = Detail::enable_if_integer_pixel<T>>
+	std::vector<mint> histogram(const Image<T>& im, mint channel) {
+		const auto l = ImageLayout::of(im);
+		if (channel < 0 || channel >= l.channels) {
+			ErrorManager::throwException(ErrorName::ImageIndexError, channel);
+		}
+		std::vector<mint> counts(static_cast<std::size_t>(histogramBins<T>));
+		histogram(im.data() + channel * l.channelStride, l.slices * l.rows * l.columns, l.columnStride, counts.data());
+		return counts;
+	}
+
+	/// @copydoc count(const T*, mint, T)
+	template<class C, typename T>
+	mint count(const C& c, T value) {
+		auto* p = Detail::dataOf(c);
+		return count(p, Detail::sizeOf(c), static_cast<std::remove_const_t<std::remove_pointer_t<decltype(p)>>>(value));
+	}
+
+	/// @copydoc countAbove(const T*, mint, T)
+	template<class C, typename T>
+	mint countAbove(const C& c, T level) {
+		auto* p = Detail::dataOf(c);
+		return countAbove(p, Detail::sizeOf(c), static_cast<std::remove_const_t<std::remove_pointer_t<decltype(p)>>>(level));
+	}
+
+	/// @copydoc threshold(const T*, T, std::int8_t*, mint)
+	template<class In, typename T, class Out>
+	void threshold(const In& in, T level, Out& out) {
+		auto* p = Detail::dataOf(in);
+		threshold(p, static_cast<std::remove_const_t<std::remove_pointer_t<decltype(p)>>>(level), Detail::dataOf(out), Detail::commonSize(in, out));
+	}
+
+	/**
+	 * @brief   Dilate every channel of every slice of an Image, see dilate(const T*, T*, mint, mint, mint, mint, mint)
+	 * @throws  ErrorName::ImageSizeError - if the dimensions or interleaving of \p in and \p out differ
+	 */
+	template<typename T>
+	void dilate(const Image<T>& in, Image<T>& out, mint radius) {
+		const auto l = Detail::commonLayout(in, out);
+		for (mint s = 0; s < l.slices; ++s) {
+			for (mint ch = 0; ch < l.channels; ++ch) {
+				const mint offset = s * l.sliceStride + ch * l.channelStride;
+				dilate(in.data() + offset, out.data() + offset, l.rows, l.columns, l.rowStride, l.columnStride, radius);
+			}
+		}
+	}
+
+	/**
+	 * @brief   Erode every channel of every slice of an Image, see erode(const T*, T*, mint, mint, mint, mint, mint)
+	 * @throws  ErrorName::ImageSizeError - if the dimensions or interleaving of \p in and \p out differ
+	 */
+	template<typename T>
+	void erode(const Image<T>& in, Image<T>& out, mint radius) {
+		const auto l = Detail::commonLayout(in, out);
+		for (mint s = 0; s < l.slices; ++s) {
+			for (mint ch = 0; ch < l.channels; ++ch) {
+				const mint offset = s * l.sliceStride + ch * l.channelStride;
+				erode(in.data() + offset, out.data() + offset, l.rows, l.columns, l.rowStride, l.columnStride, radius);
+			}
+		}
+	}
+
+	/**
+	 * @brief   Create a bit-packed mask of pixels of a 2D Image whose value in given channel is greater than \p level
+	 * @throws  ErrorName::ImageSizeError - if \p im is a 3D Image
+	 * @throws  ErrorName::ImageIndexError - if the Image has no channel with given index
+	 */
+	template<typename T>
+	BitMask thresholdMask(const Image<T>& im, T level, mint channel = 0) {
+		const auto l = Detail::planeLayout(im, channel);
+		return BitMask::pack(im.data() + channel * l.channelStride, l.rows, l.columns, l.rowStride, l.columnStride, [level](T v) { return v > level; });
+	}
+
+	/**
+	 * @brief   Write a mask to given channel of a 2D Image, set bits become pixelMax<T> and cleared bits become 0
+	 * @throws  ErrorName::ImageSizeError - if \p im is a 3D Image or its size differs from the size of the mask
+	 * @throws  ErrorName::ImageIndexError - if the Image has no channel with given index
+	 */
+	template<typename T>
+	void writeMask(const BitMask& mask, Image<T>& im, mint channel = 0) {
+		const auto l = Detail::planeLayout(im, channel);
+		if (l.rows != mask.rows() || l.columns != mask.columns()) {
+			ErrorManager::throwException(ErrorName::ImageSizeError);
+		}
+		mask.unpack(im.data() + channel * l.channelStride, l.rowStride, l.columnStride, pixelMax<T>);
+	}
+
+}  // namespace LLU::Kernels
+
+#endif	  // LLU_IMAGEKERNELS_H
@@ -0,0 +1,144 @@
+/**
+ * @file	InstancePool.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Pooled allocator for objects managed by Managed Expression stores.
+ */
+#ifndef LLU_INSTANCEPOOL_H
+#define LLU_INSTANCEPOOL_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace LLU {
+
+	/**
+	 * @class   InstancePool
+	 * @brief   Allocator of memory for Managed Expression instances, which hands out blocks of equal size carved from large chunks.
+	 *
+	 * An instance created with make() is placed in the same block as the control block of its shared_ptr, so creating an instance takes one
+	 * block from the pool and destroying it puts the block back on a free list. The block size is fixed by the first allocation, so a pool
+	 * should be used for a single dynamic type. Requests of any other size are passed to the global operator new.
+	 *
+	 * Copies of InstancePool share the same memory, which is freed when the last copy of the pool and the last instance allocated from it
+	 * are gone. The pool is thread-safe, so instances may be released on any thread.
+	 */
+	class InstancePool {
+		class State;
+
+	public:
+		/// Default number of blocks in a chunk
+		static constexpr std::size_t defaultChunkSize = 1024;
+
+		/**
+		 * @brief   Standard allocator that takes memory from an InstancePool
+		 * @tparam  U - type of allocated objects
+		 */
+		template<typename U>
+		class Allocator {
+		public:
+			using value_type = U;
+
+			/// Create an allocator for given pool
+			explicit Allocator(std::shared_ptr<State> s) noexcept : state(std::move(s)) {}
+
+			/// Rebind constructor, required from standard allocators
+			template<typename V>
+			Allocator(const Allocator<V>& other) noexcept : state(other.state) {}	 // NOLINT(google-explicit-constructor)
+
+			/// Allocate memory for \p n objects of type U
+			U* allocate(std::size_t n) {
+				return static_cast<U*>(state->allocate(n * sizeof(U), alignof(U)));
+			}
+
+			/// Deallocate memory obtained from allocate(n)
+			void deallocate(U* p, std::size_t n) noexcept {
+				state->deallocate(p, n * sizeof(U), alignof(U));
+			}
+
+			template<typename V>
+			bool operator==(const Allocator<V>& other) const noexcept {
+				return state == other.state;
+			}
+
+			template<typename V>
+			bool operator!=(const Allocator<V>& other) const noexcept {
+				return !(*this == other);
+			}
+
+		private:
+			template<typename V>
+			friend class Allocator;
+
+			std::shared_ptr<State> state;
+		};
+
+	public:
+		/**
+		 * @brief   Create an empty pool, no memory is allocated until the first instance is created
+		 * @param   blocksPerChunk - number of blocks allocated at once when the pool runs out of free blocks
+		 */
+		explicit InstancePool(std::size_t blocksPerChunk = defaultChunkSize);
+
+		/**
+		 * @brief   Create an object of type U in memory taken from the pool
+		 * @tparam  U - type of the object
+		 * @param   args - constructor arguments
+		 * @return  shared pointer owning the new object
+		 */
+		template<typename U, typename... Args>
+		std::shared_ptr<U> make(Args&&... args) const {
+			return std::allocate_shared<U>(Allocator<U> {state}, std::forward<Args>(args)...);
+		}
+
+		/// Get the size of blocks handed out by the pool, or 0 if nothing has been allocated yet
+		std::size_t blockSize() const;
+
+		/// Get the number of blocks currently in use
+		std::size_t blocksInUse() const;
+
+		/// Get the total number of blocks owned by the pool
+		std::size_t capacity() const;
+
+	private:
+		/// Memory of the pool, shared by all copies of the pool and all allocators
+		class State {
+		public:
+			explicit State(std::size_t blocksPerChunk) noexcept : blocksPerChunk(blocksPerChunk) {}
+
+			void* allocate(std::size_t bytes, std::size_t alignment);
+
+			void deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept;
+
+		private:
+			friend class InstancePool;
+
+			/// Free blocks form a singly linked list threaded through the blocks themselves
+			struct FreeBlock {
+				FreeBlock* next;
+			};
+
+			bool fromPool(std::size_t bytes, std::size_t alignment) const noexcept {
+				return bytes == requestSize && alignment <= alignof(std::max_align_t);
+			}
+
+			void addChunk();
+
+			std::size_t blocksPerChunk;
+			std::size_t requestSize = 0;
+			std::size_t size = 0;
+			std::size_t used = 0;
+			FreeBlock* freeList = nullptr;
+			std::vector<std::unique_ptr<std::byte[]>> chunks;
+			mutable std::mutex mutex;
+		};
+
+		std::shared_ptr<State> state;
+	};
+
+}  // namespace LLU
+
+#endif	  // LLU_INSTANCEPOOL_H
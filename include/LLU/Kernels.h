@@ -0,0 +1,358 @@
+/**
+ * @file	Kernels.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Dense element-wise operations and reductions over contiguous containers (Tensor, NumericArray, Image, std::vector, ...).
+ *
+ * Every kernel exists in two forms: working on raw pointers with explicit length, and working on containers. Container overloads
+ * read the data pointer and the length once and then run a plain loop over raw memory, avoiding the virtual calls of IterableContainer
+ * iterators in the loop body. Loops are written so that compilers vectorize them for the instruction set selected at compile time,
+ * reductions use several independent accumulators to break the dependency chain between consecutive iterations.
+ */
+#ifndef LLU_KERNELS_H
+#define LLU_KERNELS_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/LibraryData.h"
+
+namespace LLU::Kernels {
+
+	/// Number of independent accumulators used by reductions, enough to fill one 512-bit register with 64-bit values
+	inline constexpr mint reductionLanes = 8;
+
+	namespace Detail {
+		template<typename T>
+		struct is_complex : std::false_type {};
+
+		template<typename T>
+		struct is_complex<std::complex<T>> : std::true_type {};
+
+		template<typename T>
+		inline constexpr bool is_complex_v = is_complex<T>::value;
+
+		/// Real type corresponding to T, e.g. double for std::complex<double>
+		template<typename T, typename = void>
+		struct real_type {
+			using type = T;
+		};
+
+		template<typename T>
+		struct real_type<T, std::enable_if_t<is_complex_v<T>>> {
+			using type = typename T::value_type;
+		};
+
+		/// Type used to accumulate sums of elements of type T, integers are summed in 64 bits to avoid overflows
+		template<typename T>
+		using accumulator_t = std::conditional_t<std::is_integral_v<T>, std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>, T>;
+
+		/// Type used to accumulate absolute values of elements of type T
+		template<typename T>
+		using abs_accumulator_t = std::conditional_t<std::is_integral_v<T>, std::uint64_t, typename real_type<T>::type>;
+
+		template<typename T>
+		using enable_if_ordered = std::enable_if_t<std::is_arithmetic_v<T>>;
+
+		template<typename T>
+		abs_accumulator_t<T> magnitude(T x) noexcept {
+			if constexpr (std::is_unsigned_v<T>) {
+				return x;
+			} else if constexpr (std::is_integral_v<T>) {
+				// computed in unsigned arithmetic so that the magnitude of the lowest value does not overflow
+				return x < 0 ? std::uint64_t {0} - static_cast<std::uint64_t>(x) : static_cast<std::uint64_t>(x);
+			} else {
+				return std::abs(x);
+			}
+		}
+
+		template<typename T>
+		abs_accumulator_t<T> squaredMagnitude(T x) noexcept {
+			if constexpr (is_complex_v<T>) {
+				return std::norm(x);
+			} else {
+				auto m = magnitude(x);
+				return m * m;
+			}
+		}
+
+		/**
+		 * Sum term(i) for i in [0, n) using reductionLanes independent accumulators
+		 * @tparam  Acc - type of the accumulators
+		 * @param   n - number of terms
+		 * @param   term - function computing single term
+		 */
+		template<typename Acc, typename Term>
+		Acc blockedSum(mint n, Term&& term) {
+			std::array<Acc, reductionLanes> acc {};
+			mint i = 0;
+			for (; i + reductionLanes <= n; i += reductionLanes) {
+				for (mint k = 0; k < reductionLanes; ++k) {
+					acc[k] += term(i + k);
+				}
+			}
+			Acc total {};
+			for (auto a : acc) {
+				total += a;
+			}
+			for (; i < n; ++i) {
+				total += term(i);
+			}
+			return total;
+		}
+
+		template<typename Container>
+		auto* dataOf(Container& c) {
+			return std::data(c);
+		}
+
+		template<typename Container>
+		mint sizeOf(const Container& c) {
+			return static_cast<mint>(std::size(c));
+		}
+
+		/// Throw DimensionsError unless all containers have the same number of elements
+		template<typename Container, typename... Containers>
+		mint commonSize(const Container& c, const Containers&... cs) {
+			auto n = sizeOf(c);
+			if (((sizeOf(cs) != n) || ...)) {
+				ErrorManager::throwException(ErrorName::DimensionsError);
+			}
+			return n;
+		}
+	}  // namespace Detail
+
+	/* Element-wise operations on raw memory. Output may alias any of the inputs. */
+
+	/// out[i] = a[i] + b[i]
+	template<typename T>
+	void add(const T* a, const T* b, T* out, mint n) noexcept {
+		for (mint i = 0; i < n; ++i) {
+			out[i] = a[i] + b[i];
+		}
+	}
+
+	/// out[i] = a[i] - b[i]
+	template<typename T>
+	void subtract(const T* a, const T* b, T* out, mint n) noexcept {
+		for (mint i = 0; i < n; ++i) {
+			out[i] = a[i] - b[i];
+		}
+	}
+
+	/// out[i] = a[i] * b[i]
+	template<typename T>
+	void multiply(const T* a, const T* b, T* out, mint n) noexcept {
+		for (mint i = 0; i < n; ++i) {
+			out[i] = a[i] * b[i];
+		}
+	}
+
+	/// out[i] = alpha * in[i]
+	template<typename T>
+	void scale(const T* in, T alpha, T* out, mint n) noexcept {
+		for (mint i = 0; i < n; ++i) {
+			out[i] = alpha * in[i];
+		}
+	}
+
+	/// y[i] += alpha * x[i]
+	template<typename T>
+	void axpy(T alpha, const T* x, T* y, mint n) noexcept {
+		for (mint i = 0; i < n; ++i) {
+			y[i] += alpha * x[i];
+		}
+	}
+
+	/// out[i] = a[i] * b[i] + c[i]
+	template<typename T>
+	void fma(const T* a, const T* b, const T* c, T* out, mint n) noexcept {
+		for (mint i = 0; i < n; ++i) {
+			out[i] = a[i] * b[i] + c[i];
+		}
+	}
+
+	/// out[i] = in[i] clamped to the range [lo, hi]
+	template<typename T, typename = Detail::enable_if_ordered<T>>
+	void clamp(const T* in, T lo, T hi, T* out, mint n) noexcept {
+		for (mint i = 0; i < n; ++i) {
+			out[i] = std::min(std::max(in[i], lo), hi);
+		}
+	}
+
+	/* Reductions on raw memory */
+
+	/// Sum of all elements
+	template<typename T>
+	Detail::accumulator_t<T> sum(const T* a, mint n) noexcept {
+		return Detail::blockedSum<Detail::accumulator_t<T>>(n, [a](mint i) { return static_cast<Detail::accumulator_t<T>>(a[i]); });
+	}
+
+	/// Sum of a[i] * b[i], complex elements are not conjugated
+	template<typename T>
+	Detail::accumulator_t<T> dot(const T* a, const T* b, mint n) noexcept {
+		using Acc = Detail::accumulator_t<T>;
+		return Detail::blockedSum<Acc>(n, [a, b](mint i) { return static_cast<Acc>(a[i]) * static_cast<Acc>(b[i]); });
+	}
+
+	/// Sum of absolute values of all elements
+	template<typename T>
+	Detail::abs_accumulator_t<T> norm1(const T* a, mint n) noexcept {
+		return Detail::blockedSum<Detail::abs_accumulator_t<T>>(n, [a](mint i) { return Detail::magnitude(a[i]); });
+	}
+
+	/// Euclidean norm, for integers the result is a double
+	template<typename T>
+	auto norm2(const T* a, mint n) noexcept {
+		using Acc = std::conditional_t<std::is_integral_v<T>, double, Detail::abs_accumulator_t<T>>;
+		return std::sqrt(Detail::blockedSum<Acc>(n, [a](mint i) { return static_cast<Acc>(Detail::squaredMagnitude(a[i])); }));
+	}
+
+	/// Maximal absolute value of an element, 0 for empty input
+	template<typename T>
+	Detail::abs_accumulator_t<T> normInf(const T* a, mint n) noexcept {
+		Detail::abs_accumulator_t<T> res {};
+		for (mint i = 0; i < n; ++i) {
+			res = std::max(res, Detail::magnitude(a[i]));
+		}
+		return res;
+	}
+
+	/// Smallest element, std::numeric_limits<T>::max() for empty input
+	template<typename T, typename = Detail::enable_if_ordered<T>>
+	T minValue(const T* a, mint n) noexcept {
+		T res = (std::numeric_limits<T>::max)();
+		for (mint i = 0; i < n; ++i) {
+			res = std::min(res, a[i]);
+		}
+		return res;
+	}
+
+	/// Largest element, std::numeric_limits<T>::lowest() for empty input
+	template<typename T, typename = Detail::enable_if_ordered<T>>
+	T maxValue(const T* a, mint n) noexcept {
+		T res = std::numeric_limits<T>::lowest();
+		for (mint i = 0; i < n; ++i) {
+			res = std::max(res, a[i]);
+		}
+		return res;
+	}
+
+	/// Smallest and largest element computed in a single pass
+	template<typename T, typename = Detail::enable_if_ordered<T>>
+	std::pair<T, T> minMax(const T* a, mint n) noexcept {
+		T lo = (std::numeric_limits<T>::max)();
+		T hi = std::numeric_limits<T>::lowest();
+		for (mint i = 0; i < n; ++i) {
+			lo = std::min(lo, a[i]);
+			hi = std::max(hi, a[i]);
+		}
+		return {lo, hi};
+	}
+
+	/* Container overloads, they accept any contiguous containers with data() and size(), e.g. Tensor<T>, NumericArray<T> or std::vector<T>.
+	 * Binary and ternary operations throw ErrorName::DimensionsError when the containers have different numbers of elements. */
+
+	/// @copydoc add(const T*, const T*, T*, mint)
+	template<class A, class B, class Out>
+	void add(const A& a, const B& b, Out& out) {
+		add(Detail::dataOf(a), Detail::dataOf(b), Detail::dataOf(out), Detail::commonSize(a, b, out));
+	}
+
+	/// @copydoc subtract(const T*, const T*, T*, mint)
+	template<class A, class B, class Out>
+	void subtract(const A& a, const B& b, Out& out) {
+		subtract(Detail::dataOf(a), Detail::dataOf(b), Detail::dataOf(out), Detail::commonSize(a, b, out));
+	}
+
+	/// @copydoc multiply(const T*, const T*, T*, mint)
+	template<class A, class B, class Out>
+	void multiply(const A& a, const B& b, Out& out) {
+		multiply(Detail::dataOf(a), Detail::dataOf(b), Detail::dataOf(out), Detail::commonSize(a, b, out));
+	}
+
+	/// In-place scaling, c[i] *= alpha
+	template<class C, typename T>
+	void scale(C& c, T alpha) {
+		auto* p = Detail::dataOf(c);
+		scale(p, static_cast<std::remove_pointer_t<decltype(p)>>(alpha), p, Detail::sizeOf(c));
+	}
+
+	/// @copydoc axpy(T, const T*, T*, mint)
+	template<typename T, class X, class Y>
+	void axpy(T alpha, const X& x, Y& y) {
+		auto* py = Detail::dataOf(y);
+		axpy(static_cast<std::remove_pointer_t<decltype(py)>>(alpha), Detail::dataOf(x), py, Detail::commonSize(x, y));
+	}
+
+	/// @copydoc fma(const T*, const T*, const T*, T*, mint)
+	template<class A, class B, class C, class Out>
+	void fma(const A& a, const B& b, const C& c, Out& out) {
+		fma(Detail::dataOf(a), Detail::dataOf(b), Detail::dataOf(c), Detail::dataOf(out), Detail::commonSize(a, b, c, out));
+	}
+
+	/// In-place clamping of all elements to the range [lo, hi]
+	template<class C, typename T>
+	void clamp(C& c, T lo, T hi) {
+		auto* p = Detail::dataOf(c);
+		using Elem = std::remove_pointer_t<decltype(p)>;
+		clamp(p, static_cast<Elem>(lo), static_cast<Elem>(hi), p, Detail::sizeOf(c));
+	}
+
+	/// @copydoc sum(const T*, mint)
+	template<class C>
+	auto sum(const C& c) {
+		return sum(Detail::dataOf(c), Detail::sizeOf(c));
+	}
+
+	/// @copydoc dot(const T*, const T*, mint)
+	template<class A, class B>
+	auto dot(const A& a, const B& b) {
+		return dot(Detail::dataOf(a), Detail::dataOf(b), Detail::commonSize(a, b));
+	}
+
+	/// @copydoc norm1(const T*, mint)
+	template<class C>
+	auto norm1(const C& c) {
+		return norm1(Detail::dataOf(c), Detail::sizeOf(c));
+	}
+
+	/// @copydoc norm2(const T*, mint)
+	template<class C>
+	auto norm2(const C& c) {
+		return norm2(Detail::dataOf(c), Detail::sizeOf(c));
+	}
+
+	/// @copydoc normInf(const T*, mint)
+	template<class C>
+	auto normInf(const C& c) {
+		return normInf(Detail::dataOf(c), Detail::sizeOf(c));
+	}
+
+	/// @copydoc minValue(const T*, mint)
+	template<class C>
+	auto minValue(const C& c) {
+		return minValue(Detail::dataOf(c), Detail::sizeOf(c));
+	}
+
+	/// @copydoc maxValue(const T*, mint)
+	template<class C>
+	auto maxValue(const C& c) {
+		return maxValue(Detail::dataOf(c), Detail::sizeOf(c));
+	}
+
+	/// @copydoc minMax(const T*, mint)
+	template<class C>
+	auto minMax(const C& c) {
+		return minMax(Detail::dataOf(c), Detail::sizeOf(c));
+	}
+
+}  // namespace LLU::Kernels
+
+#endif	  // LLU_KERNELS_H
@@ -10,15 +10,31 @@
 #define LLU_LLU_H
 
 /* Containers */
+#include "LLU/Containers/BitMask.h"
+#include "LLU/Containers/Bridge.h"
+#include "LLU/Containers/ContainerPool.h"
+#include "LLU/Containers/CopyOnWrite.h"
 #include "LLU/Containers/DataList.h"
+#include "LLU/Containers/FixedRank.hpp"
 #include "LLU/Containers/Image.h"
+#include "LLU/Containers/Interleaving.hpp"
 #include "LLU/Containers/NumericArray.h"
+#include "LLU/Containers/NumericArrayIO.h"
+#include "LLU/Containers/RecordBatch.h"
+#include "LLU/Containers/Scratch.h"
+#include "LLU/Containers/Serialization.h"
 #include "LLU/Containers/SparseArray.h"
+#include "LLU/Containers/SparseArrayBuilder.hpp"
 #include "LLU/Containers/Tensor.h"
+#include "LLU/Containers/Transpose.h"
+#include "LLU/Containers/Views/Converting.hpp"
 #include "LLU/Containers/Views/Image.hpp"
 #include "LLU/Containers/Views/NumericArray.hpp"
+#include "LLU/Containers/Views/Pixels.hpp"
+#include "LLU/Containers/Views/SparseMatrix.hpp"
 
 /* Error reporting */
+#include "LLU/ErrorLog/ErrorCollector.h"
 #include "LLU/ErrorLog/ErrorManager.h"
 #include "LLU/ErrorLog/Errors.h"
 
@@ -29,6 +45,10 @@
 #include "LLU/WSTP/WSStream.hpp"
 
 /* Others */
+#include "LLU/Compression.h"
+#include "LLU/Expressions.h"
 #include "LLU/FileUtilities.h"
+#include "LLU/ImageKernels.h"
+#include "LLU/Kernels.h"
 
 #endif // LLU_LLU_H
@@ -44,6 +44,11 @@ namespace LLU {
 	/**
 	 * @struct 	LibraryData
 	 * @brief	This structure offers a static copy of WolframLibData accessible throughout the whole life of the DLL.
+	 *
+	 * Pointers to the function tables of all LibraryLink APIs are cached when WolframLibraryData is set, so all accessors are inline.
+	 * The checked accessors (API, NumericArrayAPI, etc.) throw when WolframLibraryData has not been set. The unchecked ones skip this branch
+	 * and are meant for code that can only run after initialization, for instance member functions of containers that already hold
+	 * an MTensor, MNumericArray or MImage, which could not exist without LibraryLink.
 	 */
 	struct LibraryData {
 		/**
@@ -52,54 +57,114 @@ namespace LLU {
 		 *   @warning	This function must be called before constructing the first MArgumentManager
 		 *   unless you use a constructor that takes WolframLibraryData as argument
 		 **/
-		static void setLibraryData(WolframLibraryData ld);
+		static void setLibraryData(WolframLibraryData ld) noexcept {
+			libData = ld;
+			numericArrayFunctions = ld ? ld->numericarrayLibraryFunctions : nullptr;
+			sparseArrayFunctions = ld ? ld->sparseLibraryFunctions : nullptr;
+			imageFunctions = ld ? ld->imageLibraryFunctions : nullptr;
+			dataStoreFunctions = ld ? ld->ioLibraryFunctions : nullptr;
+		}
 
 		/**
 		 * @brief   Check if libData is populated
 		 * @return  true iff the libData is not a nullptr
 		 */
-		static bool hasLibraryData();
+		static bool hasLibraryData() noexcept {
+			return libData != nullptr;
+		}
 
 		/**
 		 *   @brief     Get currently owned WolframLibraryData, if any.
 		 *   @return    a non-owning pointer to current instance of st_WolframLibraryData statically stored by LibraryData
 		 *   @throws    ErrorName::LibDataError - if libData is nullptr
 		 **/
-		static WolframLibraryData API();
+		static WolframLibraryData API() {
+			if (!libData) {
+				libDataError();
+			}
+			return libData;
+		}
 
 		/**
 		 * @brief   Get a pointer to structure with function pointers to MNumericArray API
 		 * @return  a pointer to raw LibraryLink MNumericArray API
+		 * @throws  ErrorName::LibDataError - if libData is nullptr
 		 */
-		static const st_WolframNumericArrayLibrary_Functions* NumericArrayAPI();
+		static const st_WolframNumericArrayLibrary_Functions* NumericArrayAPI() {
+			API();
+			return numericArrayFunctions;
+		}
 
 		/**
 		 * @brief   Get a pointer to structure with function pointers to MSparseArray API
 		 * @return  a pointer to raw LibraryLink MSparseArray API
+		 * @throws  ErrorName::LibDataError - if libData is nullptr
 		 */
-		static const st_WolframSparseLibrary_Functions* SparseArrayAPI();
+		static const st_WolframSparseLibrary_Functions* SparseArrayAPI() {
+			API();
+			return sparseArrayFunctions;
+		}
 
 		/**
 		 * @brief   Get a pointer to structure with function pointers to MImage API
 		 * @return  a pointer to raw LibraryLink MImage API
+		 * @throws  ErrorName::LibDataError - if libData is nullptr
 		 */
-		static const st_WolframImageLibrary_Functions* ImageAPI();
+		static const st_WolframImageLibrary_Functions* ImageAPI() {
+			API();
+			return imageFunctions;
+		}
 
 		/**
 		 * @brief   Get a pointer to structure with function pointers to DataStore API
 		 * @return  a pointer to raw LibraryLink DataStore API
+		 * @throws  ErrorName::LibDataError - if libData is nullptr
 		 */
-		static const st_WolframIOLibrary_Functions* DataStoreAPI();
+		static const st_WolframIOLibrary_Functions* DataStoreAPI() {
+			API();
+			return dataStoreFunctions;
+		}
 
 		/**
 		 * @brief   Get currently owned WolframLibraryData, even if it is a nullptr.
 		 * @return  raw pointer to st_WolframLibraryData statically stored by LibraryData
 		 */
-		static WolframLibraryData uncheckedAPI() noexcept;
+		static WolframLibraryData uncheckedAPI() noexcept {
+			return libData;
+		}
+
+		/// Get the cached MNumericArray API, nullptr before WolframLibraryData is set
+		static const st_WolframNumericArrayLibrary_Functions* uncheckedNumericArrayAPI() noexcept {
+			return numericArrayFunctions;
+		}
+
+		/// Get the cached MSparseArray API, nullptr before WolframLibraryData is set
+		static const st_WolframSparseLibrary_Functions* uncheckedSparseArrayAPI() noexcept {
+			return sparseArrayFunctions;
+		}
+
+		/// Get the cached MImage API, nullptr before WolframLibraryData is set
+		static const st_WolframImageLibrary_Functions* uncheckedImageAPI() noexcept {
+			return imageFunctions;
+		}
+
+		/// Get the cached DataStore API, nullptr before WolframLibraryData is set
+		static const st_WolframIOLibrary_Functions* uncheckedDataStoreAPI() noexcept {
+			return dataStoreFunctions;
+		}
 
 	private:
+		/// Throw ErrorName::LibDataError, kept out of line so that the checked accessors stay small
+		[[noreturn]] static void libDataError();
+
 		/// A copy of WolframLibraryData that will be accessible to all parts of LLU
-		static WolframLibraryData libData;
+		inline static WolframLibraryData libData = nullptr;
+
+		/// Function tables cached from libData
+		inline static const st_WolframNumericArrayLibrary_Functions* numericArrayFunctions = nullptr;
+		inline static const st_WolframSparseLibrary_Functions* sparseArrayFunctions = nullptr;
+		inline static const st_WolframImageLibrary_Functions* imageFunctions = nullptr;
+		inline static const st_WolframIOLibrary_Functions* dataStoreFunctions = nullptr;
 	};
 
 } // namespace LLU
@@ -13,6 +13,12 @@
 #ifndef LLU_LIBRARYLINKFUNCTIONMACRO_H
 #define LLU_LIBRARYLINKFUNCTIONMACRO_H
 
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/ErrorLog/Logger.h"
+#include "LLU/FunctionRegistry.h"
+#include "LLU/FunctionStats.h"
+#include "LLU/Tracing.h"
+
 /**
  * @brief   This macro forward declares and begins the definition of an extern "C" LibraryLink function with given name.
  * @details For input parameter and return type explanation see the official LibraryLink guide.
@@ -33,6 +39,15 @@
 	EXTERN_C DLLEXPORT int name(WolframLibraryData, WSLINK); \
 	int name([[maybe_unused]] WolframLibraryData libData, WSLINK wsl)
 
+/**
+ * @brief   This macro adds a LibraryLink function with given name to LLU::FunctionRegistry when the library is loaded.
+ * @details Functions defined with LLU_LIBRARY_FUNCTION, LLU_TYPED_FUNCTION and the listable macros are registered automatically,
+ * use this macro for functions defined with LIBRARY_LINK_FUNCTION or written by hand. It must be used at namespace scope.
+ */
+#define LLU_REGISTER_FUNCTION(name)                                               \
+	EXTERN_C DLLEXPORT int name(WolframLibraryData, mint, MArgument*, MArgument); \
+	[[maybe_unused]] static const mint llu_functionId_##name = LLU::FunctionRegistry::add(#name, name)
+
 /**
  * @brief   This macro provides all the boilerplate code needed for a typical exception-safe LibraryLink function.
  * @details LLU_LIBRARY_FUNCTION(MyFunction) defines a LibraryLink function MyFunction and a regular function impl_MyFunction of type
@@ -43,33 +58,114 @@
  */
 #define LLU_LIBRARY_FUNCTION(name)                                      \
 	void impl_##name(LLU::MArgumentManager&); /* forward declaration */ \
+	LLU_REGISTER_FUNCTION(name);                                        \
+	LLU_FUNCTION_STATS_DEFINE(name);                                    \
 	LIBRARY_LINK_FUNCTION(name) {                                       \
 		auto err = LLU::ErrorCode::NoError;                             \
+		const LLU::ErrorManager::DeferredParameters llu_deferral;       \
 		try {                                                           \
+			LLU_FUNCTION_STATS_SCOPE(name);                             \
+			LLU_TRACE_SCOPE("LibraryFunction", #name);                  \
 			LLU::MArgumentManager mngr {libData, Argc, Args, Res};      \
 			impl_##name(mngr);                                          \
 		} catch (const LLU::LibraryLinkError& e) {                      \
 			err = e.which();                                            \
+			LLU::ErrorManager::sendPendingParameters(libData, e);       \
 		} catch (...) {                                                 \
 			err = LLU::ErrorCode::FunctionError;                        \
 		}                                                               \
+		LLU::Logger::flushIfAsync(libData);                             \
 		return err;                                                     \
 	}                                                                   \
 	void impl_##name(LLU::MArgumentManager& mngr)
 
-#define LLU_WSTP_FUNCTION(name)                                \
-	void impl_##name(WSLINK&); /* forward declaration */       \
-	LIBRARY_WSTP_FUNCTION(name) {                              \
-		auto err = LLU::ErrorCode::NoError;                    \
-		try {                                                  \
-			impl_##name(wsl);                                  \
-		} catch (const LLU::LibraryLinkError& e) {             \
-			err = e.which();                                   \
-		} catch (...) {                                        \
-			err = LLU::ErrorCode::FunctionError;               \
-		}                                                      \
-		return err;                                            \
-	}                                                          \
+/**
+ * @brief   This macro defines a LibraryLink function with given name that reads its arguments, calls \p function and returns its result.
+ * @details The argument and result types are deduced from the signature of \p function (see LLU::MArgumentManager::call), so a function like
+ * @code
+ *     LLU::Tensor<double> scale(const LLU::Tensor<double>& t, double factor);
+ *     LLU_TYPED_FUNCTION(Scale, scale)
+ * @endcode
+ * needs no other boilerplate. Exceptions are handled in the same way as in LLU_LIBRARY_FUNCTION.
+ */
+#define LLU_TYPED_FUNCTION(name, function)                         \
+	LLU_REGISTER_FUNCTION(name);                                   \
+	LLU_FUNCTION_STATS_DEFINE(name);                               \
+	LIBRARY_LINK_FUNCTION(name) {                                  \
+		auto err = LLU::ErrorCode::NoError;                        \
+		const LLU::ErrorManager::DeferredParameters llu_deferral;  \
+		try {                                                      \
+			LLU_FUNCTION_STATS_SCOPE(name);                        \
+			LLU_TRACE_SCOPE("LibraryFunction", #name);             \
+			LLU::MArgumentManager mngr {libData, Argc, Args, Res}; \
+			mngr.call<&function>();                                \
+		} catch (const LLU::LibraryLinkError& e) {                 \
+			err = e.which();                                       \
+			LLU::ErrorManager::sendPendingParameters(libData, e);  \
+		} catch (...) {                                            \
+			err = LLU::ErrorCode::FunctionError;                   \
+		}                                                          \
+		LLU::Logger::flushIfAsync(libData);                        \
+		return err;                                                \
+	}
+
+/**
+ * @brief   This macro defines a listable LibraryLink function with given name that evaluates a scalar \p function on whole Tensors of arguments.
+ * @details The library function takes one Tensor per parameter of \p function and returns a Tensor of results of the same shape, see
+ * LLU::callListable. Load it with the "Listable" -> True option of PacletFunctionSet, which packs lists of arguments into Tensors, so that
+ * mapping the function over a list of inputs takes a single LibraryLink call. Include <LLU/Listable.h> before using this macro.
+ * Exceptions are handled in the same way as in LLU_LIBRARY_FUNCTION.
+ */
+#define LLU_LISTABLE_FUNCTION(name, function) LLU_LISTABLE_FUNCTION_WITH_GRAIN(name, function, 0)
+
+/**
+ * @brief   This macro defines a listable LibraryLink function like LLU_LISTABLE_FUNCTION, which evaluates \p function in parallel
+ * on the shared thread pool when given more than LLU::listableGrain elements.
+ * @note    \p function must be safe to call from multiple threads at the same time.
+ */
+#define LLU_PARALLEL_LISTABLE_FUNCTION(name, function) LLU_LISTABLE_FUNCTION_WITH_GRAIN(name, function, LLU::listableGrain)
+
+/// @cond
+#define LLU_LISTABLE_FUNCTION_WITH_GRAIN(name, function, grain)    \
+	LLU_REGISTER_FUNCTION(name);                                   \
+	LLU_FUNCTION_STATS_DEFINE(name);                               \
+	LIBRARY_LINK_FUNCTION(name) {                                  \
+		auto err = LLU::ErrorCode::NoError;                        \
+		const LLU::ErrorManager::DeferredParameters llu_deferral;  \
+		try {                                                      \
+			LLU_FUNCTION_STATS_SCOPE(name);                        \
+			LLU_TRACE_SCOPE("LibraryFunction", #name);             \
+			LLU::MArgumentManager mngr {libData, Argc, Args, Res}; \
+			LLU::callListable<&function>(mngr, grain);             \
+		} catch (const LLU::LibraryLinkError& e) {                 \
+			err = e.which();                                       \
+			LLU::ErrorManager::sendPendingParameters(libData, e);  \
+		} catch (...) {                                            \
+			err = LLU::ErrorCode::FunctionError;                   \
+		}                                                          \
+		LLU::Logger::flushIfAsync(libData);                        \
+		return err;                                                \
+	}
+/// @endcond
+
+#define LLU_WSTP_FUNCTION(name)                                   \
+	void impl_##name(WSLINK&); /* forward declaration */          \
+	LLU_FUNCTION_STATS_DEFINE(name);                              \
+	LIBRARY_WSTP_FUNCTION(name) {                                 \
+		auto err = LLU::ErrorCode::NoError;                       \
+		const LLU::ErrorManager::DeferredParameters llu_deferral; \
+		try {                                                     \
+			LLU_FUNCTION_STATS_SCOPE(name);                       \
+			LLU_TRACE_SCOPE("LibraryFunction", #name);            \
+			impl_##name(wsl);                                     \
+		} catch (const LLU::LibraryLinkError& e) {                \
+			err = e.which();                                      \
+			LLU::ErrorManager::sendPendingParameters(libData, e); \
+		} catch (...) {                                           \
+			err = LLU::ErrorCode::FunctionError;                  \
+		}                                                         \
+		return err;                                               \
+	}                                                             \
 	void impl_##name(WSLINK& wsl)
 	
 #endif // LLU_LIBRARYLINKFUNCTIONMACRO_H
@@ -0,0 +1,118 @@
+/**
+ * @file	Listable.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Evaluation of scalar C++ functions over whole Tensors of arguments, which is the C++ side of listable library functions.
+ */
+#ifndef LLU_LISTABLE_H
+#define LLU_LISTABLE_H
+
+#include <algorithm>
+#include <complex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "LLU/Async/Algorithms.h"
+#include "LLU/Async/SharedPool.h"
+#include "LLU/MArgumentManager.h"
+
+namespace LLU {
+
+	/// Default number of elements processed by a single task when a listable function runs in parallel
+	inline constexpr mint listableGrain = 4096;
+
+	namespace Detail {
+		/**
+		 * @brief   Element type of the Tensor through which values of type T are passed to and from a listable library function.
+		 * @details Integral types (including bool) are passed as \b mint, floating point types as \b double and complex numbers as std::complex<double>.
+		 */
+		template<typename T, typename = void>
+		struct ListableElement {
+			static_assert(dependent_false_v<T>, "Listable library functions can only take and return integral, floating point and complex values.");
+		};
+
+		/// @cond
+		template<typename T>
+		struct ListableElement<T, std::enable_if_t<std::is_integral_v<T>>> {
+			using type = mint;
+		};
+
+		template<typename T>
+		struct ListableElement<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+			using type = double;
+		};
+
+		template<typename T>
+		struct ListableElement<std::complex<T>> {
+			using type = std::complex<double>;
+		};
+		/// @endcond
+
+		/// Convenience alias for ListableElement<T>::type, with cv-qualifiers and references removed from T
+		template<typename T>
+		using ListableElementType = typename ListableElement<remove_cv_ref<T>>::type;
+
+		template<typename R, typename... Params, std::size_t... Is>
+		void callListableImpl(R (*function)(Params...), MArgumentManager& mngr, mint grain, std::index_sequence<Is...> /*seq*/) {
+			static_assert(sizeof...(Params) > 0, "Listable library functions must take at least one argument.");
+			const auto columns = mngr.getTuple<TensorTypedView<ListableElementType<Params>>...>();
+			const auto dims = std::get<0>(columns).dimensions();
+			const bool sameShape = ((std::get<Is>(columns).getRank() == dims.rank() &&
+									 std::equal(dims.begin(), dims.end(), std::get<Is>(columns).dimensions().begin())) && ...);
+			if (!sameShape) {
+				ErrorManager::throwExceptionWithDebugInfo(ErrorName::DimensionsError, "Arguments of a listable function must have the same dimensions.");
+			}
+
+			// take the data pointers once, so that the loop does not go through the virtual functions of IterableContainer
+			const auto data = std::make_tuple(std::get<Is>(columns).data()...);
+			const mint length = std::get<0>(columns).size();
+			auto run = [grain, length](auto&& body) {
+				if (grain > 0 && length > grain) {
+					Async::parallelFor(Async::sharedPool(), mint {0}, length, grain, body);
+				} else {
+					for (mint i = 0; i < length; ++i) {
+						body(i);
+					}
+				}
+			};
+			if constexpr (std::is_void_v<R>) {
+				run([function, &data](mint i) { function(static_cast<remove_cv_ref<Params>>(std::get<Is>(data)[i])...); });
+			} else {
+				using ResultType = ListableElementType<R>;
+				Tensor<ResultType> result {Uninitialized, dims.toDimensions()};
+				auto* out = result.data();
+				run([function, &data, out](mint i) {
+					out[i] = static_cast<ResultType>(function(static_cast<remove_cv_ref<Params>>(std::get<Is>(data)[i])...));
+				});
+				mngr.set(result);
+			}
+		}
+
+		template<typename R, typename... Params>
+		void callListableImpl(R (*function)(Params...), MArgumentManager& mngr, mint grain) {
+			callListableImpl(function, mngr, grain, std::index_sequence_for<Params...> {});
+		}
+	}  // namespace Detail
+
+	/**
+	 * @brief   Call a scalar function on corresponding elements of Tensor arguments and return the results as a Tensor of the same shape.
+	 * @details The library function receives one Tensor for every parameter of \p Function, all with the same dimensions. Integral parameters
+	 * are read from Integer Tensors, floating point parameters from Real Tensors and complex parameters from Complex Tensors. The Tensors are
+	 * only viewed, so they should be passed as "Constant". Unless \p Function returns void, the results are stored in a new Tensor whose element
+	 * type is determined by the result type of \p Function in the same way.
+	 * @tparam  Function - pointer to a free function with integral, floating point or complex parameters and result, e.g. \c &myFunction
+	 * @param   mngr - the MArgumentManager of the library function
+	 * @param   grain - if positive and smaller than the number of elements, the elements are split into pieces of at most \p grain elements processed
+	 * in parallel on Async::sharedPool(), otherwise all elements are processed sequentially in the calling thread
+	 * @throws  ErrorName::DimensionsError - if the arguments do not all have the same dimensions
+	 * @throws  ErrorName::TensorTypeError - if an argument is not a Tensor of the expected type
+	 * @note    Exceptions thrown by \p Function stop the evaluation and the first one is rethrown, also when the elements are processed in parallel.
+	 * @see     LLU_LISTABLE_FUNCTION, LLU_PARALLEL_LISTABLE_FUNCTION
+	 */
+	template<auto Function>
+	void callListable(MArgumentManager& mngr, mint grain = 0) {
+		Detail::callListableImpl(Function, mngr, grain);
+	}
+}  // namespace LLU
+
+#endif	  // LLU_LISTABLE_H
@@ -135,6 +135,26 @@ namespace LLU {
 		 */
 		static void addDataStoreNode(DataStore ds, value_type val);
 
+		/// Type of the LibraryLink function that adds an unnamed node of type T to a DataStore
+		using NodeAdder = void (*)(DataStore, value_type);
+
+		/// Type of the LibraryLink function that adds a named node of type T to a DataStore
+		using NamedNodeAdder = void (*)(DataStore, char*, value_type);
+
+		/**
+		 * @brief 	Get the LibraryLink function that adds unnamed nodes of type T to a DataStore
+		 * Useful when many nodes are added at once, because the function needs to be looked up only once.
+		 * @return 	pointer to a function from the DataStore API of LibraryLink
+		 */
+		static NodeAdder dataStoreNodeAdder();
+
+		/**
+		 * @brief 	Get the LibraryLink function that adds named nodes of type T to a DataStore
+		 * Useful when many nodes are added at once, because the function needs to be looked up only once.
+		 * @return 	pointer to a function from the DataStore API of LibraryLink
+		 */
+		static NamedNodeAdder namedDataStoreNodeAdder();
+
 	private:
 		MArgument& arg;
 	};
@@ -156,6 +176,10 @@ namespace LLU {
 	template<>                                                                                                    \
 	void PrimitiveWrapper<MArgumentType::ArgType>::addDataStoreNode(DataStore ds, value_type val);                        \
 	template<>                                                                                                    \
+	auto PrimitiveWrapper<MArgumentType::ArgType>::dataStoreNodeAdder()->NodeAdder;                                        \
+	template<>                                                                                                    \
+	auto PrimitiveWrapper<MArgumentType::ArgType>::namedDataStoreNodeAdder()->NamedNodeAdder;                              \
+	template<>                                                                                                    \
 	auto PrimitiveWrapper<MArgumentType::ArgType>::getAddress() const->typename PrimitiveWrapper::value_type*;                    \
 	template<>                                                                                                    \
 	void PrimitiveWrapper<MArgumentType::ArgType>::set(typename PrimitiveWrapper::value_type newValue);
@@ -180,6 +204,10 @@ namespace LLU {
 	template<>
 	void PrimitiveWrapper<MArgumentType::MArgument>::addDataStoreNode(DataStore ds, value_type val) = delete;
 	template<>
+	auto PrimitiveWrapper<MArgumentType::MArgument>::dataStoreNodeAdder() -> NodeAdder = delete;
+	template<>
+	auto PrimitiveWrapper<MArgumentType::MArgument>::namedDataStoreNodeAdder() -> NamedNodeAdder = delete;
+	template<>
 	auto PrimitiveWrapper<MArgumentType::MArgument>::getAddress() const -> typename PrimitiveWrapper::value_type*;
 	template<>
 	void PrimitiveWrapper<MArgumentType::MArgument>::set(typename PrimitiveWrapper::value_type newValue);
@@ -14,15 +14,20 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "LLU/Containers/ContainerPool.h"
 #include "LLU/Containers/DataList.h"
 #include "LLU/Containers/Image.h"
 #include "LLU/Containers/NumericArray.h"
 #include "LLU/Containers/SparseArray.h"
 #include "LLU/Containers/Tensor.h"
+#include "LLU/Containers/Views/NumericArray.hpp"
+#include "LLU/Containers/Views/Tensor.hpp"
 #include "LLU/ErrorLog/ErrorManager.h"
 #include "LLU/LibraryData.h"
 #include "LLU/MArgument.h"
@@ -126,6 +131,17 @@ namespace LLU {
 		 **/
 		std::string getString(size_type index) const;
 
+		/**
+		 *   @brief         Get value of MArgument of type \b "UTF8String" at position \c index without copying it
+		 *   @param[in]     index - position of desired MArgument in \c Args
+		 *   @returns       \b std::string_view of the string which was received from LibraryLink
+		 *   @throws        LLErrorCode::MArgumentIndexError - if \c index is out-of-bounds
+		 *
+		 *   @note			The view is valid as long as the MArgumentManager exists, because MArgumentManager owns string arguments.
+		 *   				The length of the string is computed on first access, so it does not reflect later changes made via getCString().
+		 **/
+		std::string_view getStringView(size_type index) const;
+
 		/**
 		 *   @brief         Get MArgument of type MNumericArray at position \p index and wrap it into NumericArray
 		 *   @tparam		T - type of data stored in NumericArray
@@ -274,23 +290,25 @@ namespace LLU {
 		 * @brief   Get a reference to an instance of Managed Expression that was sent from Wolfram Language as argument to a library function
 		 * @tparam  ManagedExpr - registered Managed Expression class
 		 * @tparam  DynamicType - actual type of Managed Expression, this must be ManagedExpr or its subclass
+		 * @tparam  Store - ManagedExpressionStore or any other store with the same interface, e.g. ConcurrentManagedExpressionStore
 		 * @param   index - position of desired argument in \c Args
 		 * @param   store - Managed Expression store that manages expressions of type ManagedExpr
 		 * @return  a reference to the Managed Expression
 		 */
-		template<class ManagedExpr, class DynamicType = ManagedExpr>
-		DynamicType& getManagedExpression(size_type index, ManagedExpressionStore<ManagedExpr>& store) const;
+		template<class ManagedExpr, class DynamicType = ManagedExpr, template<typename> class Store = ManagedExpressionStore>
+		DynamicType& getManagedExpression(size_type index, Store<ManagedExpr>& store) const;
 
 		/**
 		 * @brief   Get a shared pointer to an instance of Managed Expression that was sent from Wolfram Language as argument to a library function
 		 * @tparam  ManagedExpr - registered Managed Expression class
 		 * @tparam  DynamicType - actual type of Managed Expression, this must be ManagedExpr or its subclass
+		 * @tparam  Store - ManagedExpressionStore or any other store with the same interface, e.g. ConcurrentManagedExpressionStore
 		 * @param   index - position of desired argument in \c Args
 		 * @param   store - Managed Expression store that manages expressions of type ManagedExpr
 		 * @return  a shared pointer to the Managed Expression
 		 */
-		template<class ManagedExpr, class DynamicType = ManagedExpr>
-		std::shared_ptr<DynamicType> getManagedExpressionPtr(size_type index, ManagedExpressionStore<ManagedExpr>& store) const;
+		template<class ManagedExpr, class DynamicType = ManagedExpr, template<typename> class Store = ManagedExpressionStore>
+		std::shared_ptr<DynamicType> getManagedExpressionPtr(size_type index, Store<ManagedExpr>& store) const;
 
 		/************************************ MArgument generic "getters" ************************************/
 
@@ -355,6 +373,21 @@ namespace LLU {
 			return MArgPackGetter<ArgTypes...>::template getImpl(*this, indices, std::index_sequence_for<ArgTypes...>{});
 		}
 
+		/**
+		 * @brief   Read arguments for a function, call it and set its return value as the result of the library function.
+		 * @details Arguments are read exactly as with getTuple, where the argument types are the parameter types of \p Function stripped of
+		 *          cv-qualifiers and references. Parameters taken by value or by rvalue reference get the arguments moved, parameters taken by
+		 *          lvalue reference refer to the objects created by the Manager. Integral results are returned as \b mint, other results are passed
+		 *          to set(), and nothing is returned if \p Function returns void.
+		 * @tparam  Function - pointer to a function that implements the library function, e.g. \c &myFunction, or to a const member function,
+		 *          in which case the object is read as the first argument
+		 * @see     LLU_TYPED_FUNCTION
+		 */
+		template<auto Function>
+		void call() {
+			callImpl(Function);
+		}
+
 		/************************************ MArgument "setters" ************************************/
 
 		/**
@@ -394,15 +427,28 @@ namespace LLU {
 		/**
 		 *   @brief         Set \c str as output MArgument
 		 *   @param[in]     str - reference to \b std::string to be returned to LibraryLink
+		 *   @note			The string is copied to a result buffer owned by the calling thread, which keeps it alive until LibraryLink reads it.
 		 **/
 		void setString(const std::string& str);
 
 		///  @overload
 		void setString(const char* str);
 
-		///  @overload
+		/**
+		 *   @brief         Set \c str as output MArgument, without copying it
+		 *   @param[in]     str - \b std::string to be returned to LibraryLink, it is moved to the result buffer of the calling thread
+		 **/
 		void setString(std::string&& str);
 
+		/**
+		 *   @brief         Set the string viewed by \c str as output MArgument, without copying it
+		 *   @param[in]     str - view of a null-terminated string to be returned to LibraryLink
+		 *   @warning		The string must stay alive and unchanged after the library function returns, until LibraryLink copies it to the kernel,
+		 *   				for example it can be a static string or a string owned by a Managed Expression. The character after the view
+		 *   				must be the null terminator.
+		 **/
+		void setStringView(std::string_view str);
+
 		/**
 		 *   @brief         Set MNumericArray wrapped by \c na as output MArgument
 		 *   @tparam		T - NumericArray data type
@@ -411,6 +457,17 @@ namespace LLU {
 		template<typename T>
 		void setNumericArray(const NumericArray<T>& na);
 
+		/**
+		 *   @brief         Create a NumericArray with elements written by \p producer and set it as output MArgument
+		 *   @tparam		T - NumericArray data type
+		 *   @param[in]     dims - dimensions of the NumericArray
+		 *   @param[in]     producer - see NumericArray<T>::NumericArray(MArrayDimensions, F&&)
+		 **/
+		template<typename T, class F>
+		void setNumericArray(MArrayDimensions dims, F&& producer) {
+			setNumericArray(NumericArray<T>(std::move(dims), std::forward<F>(producer)));
+		}
+
 		/**
 		 *   @brief         Set MNumericArray as output MArgument
 		 *   @param[in]     na - MNumericArray to be passed to LibraryLink
@@ -425,6 +482,17 @@ namespace LLU {
 		template<typename T>
 		void setTensor(const Tensor<T>& ten);
 
+		/**
+		 *   @brief         Create a Tensor with elements written by \p producer and set it as output MArgument
+		 *   @tparam		T - Tensor data type
+		 *   @param[in]     dims - dimensions of the Tensor
+		 *   @param[in]     producer - see Tensor<T>::Tensor(MArrayDimensions, F&&)
+		 **/
+		template<typename T, class F>
+		void setTensor(MArrayDimensions dims, F&& producer) {
+			setTensor(Tensor<T>(std::move(dims), std::forward<F>(producer)));
+		}
+
 		/**
 		 *   @brief         Set MTensor as output MArgument
 		 *   @param[in]     t - MTensor to be passed to LibraryLink
@@ -552,6 +620,15 @@ namespace LLU {
 			t.pass(res);
 		}
 
+		/**
+		 *  Set the container leased from a ContainerPool as output MArgument
+		 *  @param[in]  p - lease, its container is passed to LibraryLink and will not be recycled
+		 */
+		template<class Wrapper>
+		void set(const Pooled<Wrapper>& p) {
+			set(*p);
+		}
+
 		/// @copydoc setImage
 		template<typename T>
 		void set(const Image<T>& im) {
@@ -666,6 +743,46 @@ namespace LLU {
 		template<Passing Mode = Passing::Automatic, class Operator>
 		decltype(auto) operateOnTensor(size_type index, Operator&& op);
 
+		/**
+		 *   @brief         Perform operation on one or more NumericArrays created from MNumericArray arguments at given positions in \c Args
+		 *   @details       Element types are dispatched with a table built at compile time, and \p op is only instantiated for the types in \p Types,
+		 *                  or for every combination of them if more than one index is given. For example
+		 *                  @code
+		 *                      mngr.visitNumericArrays<LLU::TypeList<float, double>, LLU::Passing::Constant>(
+		 *                          [](const auto& x, const auto& y) { return std::inner_product(x.begin(), x.end(), y.begin(), 0.0); }, 0, 1);
+		 *                  @endcode
+		 *                  is instantiated 4 times instead of 144 times.
+		 *   @tparam		Types - TypeList of supported element types, by default all NumericArray types
+		 *   @tparam		Mode - passing mode of the NumericArrays that will be processed
+		 *   @tparam		Operator - any callable class
+		 *   @param[in]     op - callable object (possibly a generic lambda) that takes one NumericArray per index, it must return the same type
+		 *                  for all element types
+		 *   @param[in]     index - position of the first MNumericArray in \c Args
+		 *   @param[in]     indices - positions of other MNumericArrays in \c Args
+		 *   @returns       Forwards the return value of \p op
+		 *   @throws        ErrorName::MArgumentIndexError - if any index is out-of-bounds
+		 *   @throws        ErrorName::MArgumentNumericArrayError - if any NumericArray has an element type not listed in \p Types
+		 **/
+		template<class Types = NumericArrayTypes, Passing Mode = Passing::Automatic, class Operator, typename... Indices>
+		decltype(auto) visitNumericArrays(Operator&& op, size_type index, Indices... indices);
+
+		/**
+		 *   @brief         Perform operation on one or more Tensors created from MTensor arguments at given positions in \c Args
+		 *   @details       Works in the same way as visitNumericArrays.
+		 *   @tparam		Types - TypeList of supported element types, by default all Tensor types
+		 *   @tparam		Mode - passing mode of the Tensors that will be processed
+		 *   @tparam		Operator - any callable class
+		 *   @param[in]     op - callable object (possibly a generic lambda) that takes one Tensor per index, it must return the same type
+		 *                  for all element types
+		 *   @param[in]     index - position of the first MTensor in \c Args
+		 *   @param[in]     indices - positions of other MTensors in \c Args
+		 *   @returns       Forwards the return value of \p op
+		 *   @throws        ErrorName::MArgumentIndexError - if any index is out-of-bounds
+		 *   @throws        ErrorName::MArgumentTensorError - if any Tensor has an element type not listed in \p Types
+		 **/
+		template<class Types = TensorTypes, Passing Mode = Passing::Automatic, class Operator, typename... Indices>
+		decltype(auto) visitTensors(Operator&& op, size_type index, Indices... indices);
+
 		/**
 		 *   @brief         Get type of MImage at position \c index in \c Args
 		 *   @param[in]     index - position of desired MArgument in \c Args
@@ -768,11 +885,44 @@ namespace LLU {
 		};
 
 	private:
+		template<typename R, typename... Params>
+		void callImpl(R (*function)(Params...)) {
+			auto args = getTuple<remove_cv_ref<Params>...>();
+			invokeAndSetResult<R>([function](auto&... arg) -> R { return function(passArgument<Params>(arg)...); }, args);
+		}
+
+		template<typename R, class C, typename... Params>
+		void callImpl(R (C::*function)(Params...) const) {
+			auto args = getTuple<C, remove_cv_ref<Params>...>();
+			invokeAndSetResult<R>([function](const C& obj, auto&... arg) -> R { return (obj.*function)(passArgument<Params>(arg)...); }, args);
+		}
+
+		template<typename R, class Invoke, class ArgTuple>
+		void invokeAndSetResult(Invoke&& invoke, ArgTuple& args) {
+			if constexpr (std::is_void_v<R>) {
+				std::apply(invoke, args);
+			} else if constexpr (std::is_integral_v<R> && !std::is_same_v<R, bool>) {
+				setInteger(static_cast<mint>(std::apply(invoke, args)));
+			} else {
+				set(std::apply(invoke, args));
+			}
+		}
+
+		template<typename Param, typename T>
+		static decltype(auto) passArgument(T& arg) noexcept {
+			if constexpr (std::is_lvalue_reference_v<Param>) {
+				return (arg);
+			} else {
+				return std::move(arg);
+			}
+		}
+
 		template<typename... ArgTypes>
 		struct MArgPackGetter {
 			template<size_type... Indices>
 			static std::tuple<ArgTypes...>
-			getImpl(const MArgumentManager& mngr, std::array<size_type, sizeof...(ArgTypes)> inds, std::index_sequence<Indices...> /*seq*/) {
+			getImpl(const MArgumentManager& mngr, [[maybe_unused]] std::array<size_type, sizeof...(ArgTypes)> inds,
+					std::index_sequence<Indices...> /*seq*/) {
 				if (sizeof...(ArgTypes) > static_cast<size_type>(mngr.argc)) {
 					ErrorManager::throwException(ErrorName::MArgumentIndexError);
 				}
@@ -837,20 +987,25 @@ namespace LLU {
 		 **/
 		MArgument getArgs(size_type index) const;
 
-		/**
-		 * @brief Helper function to initialize string arguments vector
-		 */
-		void initStringArgs();
+		/// String argument taken over from LibraryLink together with its length
+		struct StringArg {
+			size_type index;
+			LLStringPtr data;
+			std::size_t length;
+		};
 
 		/**
 		 * @brief Take ownership of UTF8String argument passed via LibraryLink.
 		 *
 		 * This wraps the raw char* into unique_ptr and all further accesses to the argument happen via the unique_ptr.
 		 * The string argument is automatically deallocated when MArgumentManager instance is destroyed.
+		 * Slots for string arguments are only created for the arguments that are actually read, so library functions without string arguments
+		 * do not allocate anything.
 		 *
 		 * @param index - position of desired MArgument in \c Args
+		 * @return the string argument and its length
 		 */
-		void acquireUTF8String(size_type index) const;
+		const StringArg& acquireUTF8String(size_type index) const;
 
 		/**
 		 * @brief   Convert passing mode to ownership info
@@ -867,10 +1022,10 @@ namespace LLU {
 			return Ownership::LibraryLink;
 		}
 
-		/// Here we store a string that was most recently returned to LibraryLink
+		/// Here we store a string that was most recently returned to LibraryLink from the current thread
 		/// [LLDocs]: https://reference.wolfram.com/language/LibraryLink/tutorial/InteractionWithMathematica.html#262826223 "LibraryLink docs"
 		/// @see [LibraryLink docs][LLDocs]
-		static std::string stringResultBuffer;
+		static thread_local std::string stringResultBuffer;
 
 		/// Max \b mint value
 		static constexpr mint MINT_MAX = (std::numeric_limits<mint>::max)();
@@ -887,10 +1042,10 @@ namespace LLU {
 		/// Output argument for LibraryLink
 		MArgument& res;
 
-		/// Structure to manage string arguments after taking their ownership from LibraryLink
+		/// Structure to manage string arguments after taking their ownership from LibraryLink, filled on first access to each argument
 		/// [LLDocs]: https://reference.wolfram.com/language/LibraryLink/tutorial/InteractionWithMathematica.html#262826223 "LibraryLink docs"
 		/// @see [LibraryLink docs][LLDocs]
-		mutable std::vector<LLStringPtr> stringArgs;
+		mutable std::vector<StringArg> stringArgs;
 	};
 
 /// @cond
@@ -908,6 +1063,7 @@ namespace LLU {
 	LLU_MARGUMENTMANAGER_GENERATE_GET_SPECIALIZATION(bool, getBoolean)
 	LLU_MARGUMENTMANAGER_GENERATE_GET_SPECIALIZATION(double, getReal)
 	LLU_MARGUMENTMANAGER_GENERATE_GET_SPECIALIZATION(std::string, getString)
+	LLU_MARGUMENTMANAGER_GENERATE_GET_SPECIALIZATION(std::string_view, getStringView)
 	LLU_MARGUMENTMANAGER_GENERATE_GET_SPECIALIZATION(const char*, getCString)
 	LLU_MARGUMENTMANAGER_GENERATE_GET_SPECIALIZATION(std::complex<double>, getComplex)
 
@@ -947,6 +1103,29 @@ namespace LLU {
 
 #undef LLU_MARGUMENTMANAGER_GENERATE_GET_SPECIALIZATION_FOR_CONTAINER
 
+	/*
+	 * Views are read straight from the MArgument, without creating a container wrapper. They do not own the data, so they must not be used for
+	 * arguments passed as "Manual", and their metadata is only queried from LibraryLink when needed.
+	 */
+#define LLU_MARGUMENTMANAGER_GENERATE_GET_SPECIALIZATION_FOR_VIEW(Container)                                                         \
+	template<>                                                                                                                       \
+	struct MArgumentManager::Getter<Container##View> {                                                                               \
+		static Container##View get(const MArgumentManager& mngr, size_type index) {                                                  \
+			return mngr.getM##Container(index);                                                                                      \
+		}                                                                                                                            \
+	};                                                                                                                               \
+	template<typename T> /* NOLINTNEXTLINE(bugprone-macro-parentheses) */                                                            \
+	struct MArgumentManager::Getter<Container##TypedView<T>> {                                                                       \
+		static Container##TypedView<T> get(const MArgumentManager& mngr, size_type index) { /* NOLINT(bugprone-macro-parentheses) */ \
+			return mngr.getM##Container(index);                                                                                      \
+		}                                                                                                                            \
+	};
+
+	LLU_MARGUMENTMANAGER_GENERATE_GET_SPECIALIZATION_FOR_VIEW(NumericArray)
+	LLU_MARGUMENTMANAGER_GENERATE_GET_SPECIALIZATION_FOR_VIEW(Tensor)
+
+#undef LLU_MARGUMENTMANAGER_GENERATE_GET_SPECIALIZATION_FOR_VIEW
+
 	template<typename T>
 	bool MArgumentManager::setMintAndCheck(T result) noexcept {
 		if (result >= MINT_MAX) {
@@ -974,44 +1153,33 @@ namespace LLU {
 	template<Passing Mode, class Operator, class... Args>
 	decltype(auto) MArgumentManager::operateOnNumericArray(size_type index, Args&&... opArgs) {
 		Operator op;
-		switch (getNumericArrayType(index)) {
-			case MNumericArray_Type_Bit8: return std::invoke(op, this->getNumericArray<int8_t, Mode>(index), std::forward<Args>(opArgs)...);
-			case MNumericArray_Type_UBit8: return std::invoke(op, this->getNumericArray<uint8_t, Mode>(index), std::forward<Args>(opArgs)...);
-			case MNumericArray_Type_Bit16: return std::invoke(op, this->getNumericArray<int16_t, Mode>(index), std::forward<Args>(opArgs)...);
-			case MNumericArray_Type_UBit16: return std::invoke(op, this->getNumericArray<uint16_t, Mode>(index), std::forward<Args>(opArgs)...);
-			case MNumericArray_Type_Bit32: return std::invoke(op, this->getNumericArray<int32_t, Mode>(index), std::forward<Args>(opArgs)...);
-			case MNumericArray_Type_UBit32: return std::invoke(op, this->getNumericArray<uint32_t, Mode>(index), std::forward<Args>(opArgs)...);
-			case MNumericArray_Type_Bit64: return std::invoke(op, this->getNumericArray<int64_t, Mode>(index), std::forward<Args>(opArgs)...);
-			case MNumericArray_Type_UBit64: return std::invoke(op, this->getNumericArray<uint64_t, Mode>(index), std::forward<Args>(opArgs)...);
-			case MNumericArray_Type_Real32: return std::invoke(op, this->getNumericArray<float, Mode>(index), std::forward<Args>(opArgs)...);
-			case MNumericArray_Type_Real64: return std::invoke(op, this->getNumericArray<double, Mode>(index), std::forward<Args>(opArgs)...);
-			case MNumericArray_Type_Complex_Real32: return std::invoke(op, this->getNumericArray<std::complex<float>, Mode>(index), std::forward<Args>(opArgs)...);
-			case MNumericArray_Type_Complex_Real64: return std::invoke(op, this->getNumericArray<std::complex<double>, Mode>(index), std::forward<Args>(opArgs)...);
-			default:
-				ErrorManager::throwExceptionWithDebugInfo(ErrorName::MArgumentNumericArrayError,
-														  "Incorrect type of NumericArray argument. Argument index: " + std::to_string(index));
-		}
+		return visitNumericArrays<NumericArrayTypes, Mode>(
+			[&](auto&& na) -> decltype(auto) { return std::invoke(op, std::forward<decltype(na)>(na), std::forward<Args>(opArgs)...); }, index);
 	}
 
 	template<Passing Mode, class Operator>
 	decltype(auto) MArgumentManager::operateOnNumericArray(size_type index, Operator&& op) {
-		switch (getNumericArrayType(index)) {
-			case MNumericArray_Type_Bit8: return std::invoke(op, this->getNumericArray<int8_t, Mode>(index));
-			case MNumericArray_Type_UBit8: return std::invoke(op, this->getNumericArray<uint8_t, Mode>(index));
-			case MNumericArray_Type_Bit16: return std::invoke(op, this->getNumericArray<int16_t, Mode>(index));
-			case MNumericArray_Type_UBit16: return std::invoke(op, this->getNumericArray<uint16_t, Mode>(index));
-			case MNumericArray_Type_Bit32: return std::invoke(op, this->getNumericArray<int32_t, Mode>(index));
-			case MNumericArray_Type_UBit32: return std::invoke(op, this->getNumericArray<uint32_t, Mode>(index));
-			case MNumericArray_Type_Bit64: return std::invoke(op, this->getNumericArray<int64_t, Mode>(index));
-			case MNumericArray_Type_UBit64: return std::invoke(op, this->getNumericArray<uint64_t, Mode>(index));
-			case MNumericArray_Type_Real32: return std::invoke(op, this->getNumericArray<float, Mode>(index));
-			case MNumericArray_Type_Real64: return std::invoke(op, this->getNumericArray<double, Mode>(index));
-			case MNumericArray_Type_Complex_Real32: return std::invoke(op, this->getNumericArray<std::complex<float>, Mode>(index));
-			case MNumericArray_Type_Complex_Real64: return std::invoke(op, this->getNumericArray<std::complex<double>, Mode>(index));
-			default:
-				ErrorManager::throwExceptionWithDebugInfo(ErrorName::MArgumentNumericArrayError,
-														  "Incorrect type of NumericArray argument. Argument index: " + std::to_string(index));
-		}
+		return visitNumericArrays<NumericArrayTypes, Mode>(std::forward<Operator>(op), index);
+	}
+
+	template<class Types, Passing Mode, class Operator, typename... Indices>
+	decltype(auto) MArgumentManager::visitNumericArrays(Operator&& op, size_type index, Indices... indices) {
+		auto withType = [&](auto tag) -> decltype(auto) {
+			using T = typename decltype(tag)::type;
+			if constexpr (sizeof...(Indices) == 0) {
+				return std::invoke(op, this->getNumericArray<T, Mode>(index));
+			} else {
+				return this->visitNumericArrays<Types, Mode>(
+					[&](auto&&... others) -> decltype(auto) {
+						return std::invoke(op, this->getNumericArray<T, Mode>(index), std::forward<decltype(others)>(others)...);
+					},
+					static_cast<size_type>(indices)...);
+			}
+		};
+		return Detail::TypeDispatcher<Detail::NumericArrayTypeCode, Types>::dispatch(getNumericArrayType(index), withType, [index] {
+			ErrorManager::throwExceptionWithDebugInfo(ErrorName::MArgumentNumericArrayError,
+													  "Incorrect type of NumericArray argument. Argument index: " + std::to_string(index));
+		});
 	}
 
 	template<typename T, Passing Mode>
@@ -1027,26 +1195,33 @@ namespace LLU {
 	template<Passing Mode, class Operator, class... Args>
 	decltype(auto) MArgumentManager::operateOnTensor(size_type index, Args&&... opArgs) {
 		Operator op;
-		switch (getTensorType(index)) {
-			case MType_Integer: return std::invoke(op, this->getTensor<mint, Mode>(index), std::forward<Args>(opArgs)...);
-			case MType_Real: return std::invoke(op, this->getTensor<double, Mode>(index), std::forward<Args>(opArgs)...);
-			case MType_Complex: return std::invoke(op, this->getTensor<std::complex<double>, Mode>(index), std::forward<Args>(opArgs)...);
-			default:
-				ErrorManager::throwExceptionWithDebugInfo(ErrorName::MArgumentTensorError,
-														  "Incorrect type of Tensor argument. Argument index: " + std::to_string(index));
-		}
+		return visitTensors<TensorTypes, Mode>(
+			[&](auto&& t) -> decltype(auto) { return std::invoke(op, std::forward<decltype(t)>(t), std::forward<Args>(opArgs)...); }, index);
 	}
 
 	template<Passing Mode, class Operator>
 	decltype(auto) MArgumentManager::operateOnTensor(size_type index, Operator&& op) {
-		switch (getTensorType(index)) {
-			case MType_Integer: return std::invoke(op, this->getTensor<mint, Mode>(index));
-			case MType_Real: return std::invoke(op, this->getTensor<double, Mode>(index));
-			case MType_Complex: return std::invoke(op, this->getTensor<std::complex<double>, Mode>(index));
-			default:
-				ErrorManager::throwExceptionWithDebugInfo(ErrorName::MArgumentTensorError,
-														  "Incorrect type of Tensor argument. Argument index: " + std::to_string(index));
-		}
+		return visitTensors<TensorTypes, Mode>(std::forward<Operator>(op), index);
+	}
+
+	template<class Types, Passing Mode, class Operator, typename... Indices>
+	decltype(auto) MArgumentManager::visitTensors(Operator&& op, size_type index, Indices... indices) {
+		auto withType = [&](auto tag) -> decltype(auto) {
+			using T = typename decltype(tag)::type;
+			if constexpr (sizeof...(Indices) == 0) {
+				return std::invoke(op, this->getTensor<T, Mode>(index));
+			} else {
+				return this->visitTensors<Types, Mode>(
+					[&](auto&&... others) -> decltype(auto) {
+						return std::invoke(op, this->getTensor<T, Mode>(index), std::forward<decltype(others)>(others)...);
+					},
+					static_cast<size_type>(indices)...);
+			}
+		};
+		return Detail::TypeDispatcher<Detail::TensorTypeCode, Types>::dispatch(getTensorType(index), withType, [index] {
+			ErrorManager::throwExceptionWithDebugInfo(ErrorName::MArgumentTensorError,
+													  "Incorrect type of Tensor argument. Argument index: " + std::to_string(index));
+		});
 	}
 
 	template<typename T, Passing Mode>
@@ -1147,17 +1322,17 @@ namespace LLU {
 		}
 	}
 
-	template<class ManagedExpr, class DynamicType>
-	DynamicType& MArgumentManager::getManagedExpression(size_type index, ManagedExpressionStore<ManagedExpr>& store) const {
-		auto ptr = getManagedExpressionPtr<ManagedExpr, DynamicType>(index, store);
+	template<class ManagedExpr, class DynamicType, template<typename> class Store>
+	DynamicType& MArgumentManager::getManagedExpression(size_type index, Store<ManagedExpr>& store) const {
+		auto ptr = getManagedExpressionPtr<ManagedExpr, DynamicType, Store>(index, store);
 		if (!ptr) {
 			ErrorManager::throwException(ErrorName::MLEDynamicTypeError);
 		}
 		return *ptr;
 	}
 
-	template<class ManagedExpr, class DynamicType>
-	std::shared_ptr<DynamicType> MArgumentManager::getManagedExpressionPtr(size_type index, ManagedExpressionStore<ManagedExpr>& store) const {
+	template<class ManagedExpr, class DynamicType, template<typename> class Store>
+	std::shared_ptr<DynamicType> MArgumentManager::getManagedExpressionPtr(size_type index, Store<ManagedExpr>& store) const {
 		auto exprID = getInteger<mint>(index);
 		auto baseClassPtr = store.getInstancePointer(exprID);
 		return std::dynamic_pointer_cast<DynamicType>(baseClassPtr);
@@ -8,9 +8,12 @@
 #define LLU_MANAGEDEXPRESSION_HPP
 
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "LLU/InstancePool.h"
 #include "LLU/LibraryData.h"
 #include "LLU/Utilities.hpp"
 
@@ -42,12 +45,163 @@ namespace LLU {
 		static_assert(dependent_false_v<T>, "Use of unspecialized ManageInstance function.");
 	}
 
+	/**
+	 * @brief   Members common to all stores of Managed Expressions: registration of the managed type, batch creation and release of instances,
+	 * snapshots and the optional InstancePool.
+	 *
+	 * The derived store provides createInstance, size and either iterators over (id, pointer) pairs or its own forEach.
+	 *
+	 * @tparam  Derived - store class that derives from this class
+	 * @tparam  T - managed class
+	 */
+	template<class Derived, typename T>
+	class ManagedExpressionStoreBase {
+	public:
+		/**
+		 * Create objects of class T for all IDs in given range, e.g. IDs of Managed Expressions created with NewManagedExpressions in the Wolfram Language
+		 * @tparam  DynamicType - actual type of the constructed objects
+		 * @param   ids - range of ids of the newly created managed objects
+		 * @param   args - constructor arguments, the same for every object
+		 */
+		template<class DynamicType = T, class IDRange, typename... Args>
+		void createInstances(const IDRange& ids, const Args&... args) {
+			for (auto id : ids) {
+				derived().template createInstance<DynamicType>(static_cast<mint>(id), args...);
+			}
+		}
+
+		/**
+		 * Release an instance managed by this Store.
+		 * @param id - id of the instance to be released
+		 * @return 0 if the id was correct and the operation succeeded, non-negative integer otherwise
+		 * @note Normally, every instance in the Store has a corresponding WL expression and the instance is released as soon as the corresponding expression
+		 * goes out of scope (its reference count hits 0). This function can be used to force immediate release of a managed instance.
+		 * It calls LibraryLink and therefore must be called from the main thread.
+		 * @see https://reference.wolfram.com/language/LibraryLink/ref/callback/releaseManagedLibraryExpression.html
+		 */
+		int releaseInstance(mint id) {
+			return LibraryData::API()->releaseManagedLibraryExpression(expressionName.c_str(), id);
+		}
+
+		/**
+		 * Release many instances managed by this Store at once.
+		 * @param ids - range of ids of the instances to be released
+		 * @return the number of ids that could not be released
+		 */
+		template<class IDRange>
+		mint releaseInstances(const IDRange& ids) {
+			mint failed = 0;
+			for (auto id : ids) {
+				failed += (releaseInstance(static_cast<mint>(id)) != 0) ? 1 : 0;
+			}
+			return failed;
+		}
+
+		/**
+		 * Get symbol name that is used in the WL to represent Managed Expressions stored in this Store
+		 * @return symbol name
+		 */
+		const std::string& getExpressionName() const noexcept {
+			return expressionName;
+		}
+
+		/**
+		 * Call \p f with the id and the pointer to every instance in the store, in unspecified order.
+		 */
+		template<typename F>
+		void forEach(F&& f) const {
+			for (const auto& [id, instance] : derived()) {
+				f(id, instance);
+			}
+		}
+
+		/**
+		 * Take a snapshot of all instances in the store, in unspecified order. IDs created with manageInstance but without an object yet are skipped.
+		 * @return pointers to the managed objects, which keep them alive even if they are released from the store in the meantime
+		 */
+		std::vector<std::shared_ptr<T>> snapshot() const {
+			std::vector<std::shared_ptr<T>> instances;
+			instances.reserve(derived().size());
+			derived().forEach([&instances](mint /*id*/, const std::shared_ptr<T>& instance) {
+				if (instance) {
+					instances.push_back(instance);
+				}
+			});
+			return instances;
+		}
+
+		/**
+		 * Allocate objects created with createInstance and createInstances from given pool instead of with std::make_shared.
+		 * @param instancePool - pool of memory for objects of class T
+		 * @note This function should typically be called in \c WolframLibrary_initialize, before any instance is created
+		 */
+		void setInstancePool(InstancePool instancePool) {
+			pool = std::move(instancePool);
+		}
+
+		/**
+		 * Register class T as managed expression under given \p name.
+		 * @param name - name of the Wolfram Language symbol that will be used to manage class T
+		 * @param libData - optionally specify WolframLibraryData instance
+		 * @note This function should typically be called in \c WolframLibrary_initialize
+		 */
+		void registerType(std::string name, WolframLibraryData libData = LibraryData::API()) noexcept {
+			expressionName = std::move(name);
+			libData->registerLibraryExpressionManager(expressionName.c_str(), manageInstanceCallback<T>);
+		}
+
+		/**
+		 * Unregister class T as managed expression
+		 * @param libData - optionally specify WolframLibraryData instance
+		 * @note This function should typically be called in \c WolframLibrary_uninitialize
+		 */
+		void unregisterType(WolframLibraryData libData = LibraryData::API()) const noexcept {
+			libData->unregisterLibraryExpressionManager(expressionName.c_str());
+		}
+
+	protected:
+		/// Create a new object, from the pool if one is set
+		template<class DynamicType, typename... Args>
+		std::shared_ptr<T> makeInstance(Args&&... args) const {
+			return makeInstanceIn<DynamicType>(pool, std::forward<Args>(args)...);
+		}
+
+		/// Create a new object, from given pool if there is one
+		template<class DynamicType, typename... Args>
+		static std::shared_ptr<T> makeInstanceIn(const std::optional<InstancePool>& instancePool, Args&&... args) {
+			if (instancePool) {
+				return instancePool->template make<DynamicType>(std::forward<Args>(args)...);
+			}
+			return std::make_shared<DynamicType>(std::forward<Args>(args)...);
+		}
+
+		/// Get the pool set with setInstancePool, if any
+		const std::optional<InstancePool>& instancePool() const noexcept {
+			return pool;
+		}
+
+	private:
+		const Derived& derived() const noexcept {
+			return static_cast<const Derived&>(*this);
+		}
+
+		Derived& derived() noexcept {
+			return static_cast<Derived&>(*this);
+		}
+
+		/// Optional pool of memory for managed objects
+		std::optional<InstancePool> pool;
+
+		/// Symbol name which is used in WolframLanguage to represent managed instances of class T
+		std::string expressionName;
+	};
+
 	/**
 	 * @brief ManagedExpressionStore will keep track of instances of managed class T and will provide safe access to them
 	 * @tparam T - managed class
 	 */
 	template<typename T>
-	class ManagedExpressionStore {
+	class ManagedExpressionStore : public ManagedExpressionStoreBase<ManagedExpressionStore<T>, T> {
 	public:
 		/// Iterator over ManagedExpressionStore - it iterates over the underlying hash map
 		using iterator = typename std::unordered_map<mint, std::shared_ptr<T>>::iterator;
@@ -85,7 +239,7 @@ namespace LLU {
 		template<class DynamicType = T, typename... Args>
 		T& createInstance(mint id, Args&&... args) {
 			checkID(id);	// at this point instance must already exist in store
-			store[id] = std::make_shared<DynamicType>(std::forward<Args>(args)...);
+			store[id] = this->template makeInstance<DynamicType>(std::forward<Args>(args)...);
 			return *store[id];
 		}
 
@@ -112,18 +266,6 @@ namespace LLU {
 			return createInstance(id, std::shared_ptr<T> {std::move(ptr)});
 		}
 
-		/**
-		 * Release an instance managed by this Store.
-		 * @param id - id of the instance to be released
-		 * @return 0 if the id was correct and the operation succeeded, non-negative integer otherwise
-		 * @note Normally, every instance in the Store has a corresponding WL expression and the instance is released as soon as the corresponding expression
-		 * goes out of scope (its reference count hits 0). This function can be used to force immediate release of a managed instance.
-		 * @see https://reference.wolfram.com/language/LibraryLink/ref/callback/releaseManagedLibraryExpression.html
-		 */
-		int releaseInstance(mint id) {
-			return LibraryData::API()->releaseManagedLibraryExpression(expressionName.c_str(), id);
-		}
-
 		/**
 		 * Check if instance with given \p id is present in the store.
 		 * @param id - id to be checked
@@ -153,14 +295,6 @@ namespace LLU {
 			return store[id];
 		}
 
-		/**
-		 * Get symbol name that is used in the WL to represent Managed Expressions stored in this Store
-		 * @return symbol name
-		 */
-		const std::string& getExpressionName() const noexcept {
-			return expressionName;
-		}
-
 		/**
 		 * Get the number of currently managed expressions.
 		 * @return size of the store
@@ -211,26 +345,6 @@ namespace LLU {
 			return store.cend();
 		}
 
-		/**
-		 * Register class T as managed expression under given \p name.
-		 * @param name - name of the Wolfram Language symbol that will be used to manage class T
-		 * @param libData - optionally specify WolframLibraryData instance
-		 * @note This function should typically be called in \c WolframLibrary_initialize
-		 */
-		void registerType(std::string name, WolframLibraryData libData = LibraryData::API()) noexcept {
-			expressionName = std::move(name);
-			libData->registerLibraryExpressionManager(expressionName.c_str(), manageInstanceCallback<T>);
-		}
-
-		/**
-		 * Unregister class T as managed expression
-		 * @param libData - optionally specify WolframLibraryData instance
-		 * @note This function should typically be called in \c WolframLibrary_uninitialize
-		 */
-		void unregisterType(WolframLibraryData libData = LibraryData::API()) const noexcept {
-			libData->unregisterLibraryExpressionManager(expressionName.c_str());
-		}
-
 	private:
 		/**
 		 * Helper function that checks whether given ID is present in the store and throws otherwise
@@ -258,9 +372,6 @@ namespace LLU {
 	private:
 		/// A map that associates IDs (mints) with pointers to objects of class T which are managed by WolframLanguage
 		std::unordered_map<mint, std::shared_ptr<T>> store;
-
-		/// Symbol name which is used in WolframLanguage to represent managed instances of class T
-		std::string expressionName;
 	};
 
 }	 // namespace LLU
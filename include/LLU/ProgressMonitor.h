@@ -6,6 +6,11 @@
 #ifndef LLU_PROGRESSMONITOR_H
 #define LLU_PROGRESSMONITOR_H
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
 #include "LLU/Containers/Tensor.h"
 
 namespace LLU {
@@ -17,12 +22,144 @@ namespace LLU {
 	 * a single number of type \c double between 0. and 1.
 	 * This class offers an interface for modifying the progress value (increase/decrease by a given step or set to an arbitrary value) and
 	 * one static function for checking if a user requested to abort the computation in WL Kernel.
+	 *
+	 * The progress is accumulated in an atomic variable, so it can be modified from any thread. Only the thread that created the monitor
+	 * (the one that runs the library function) writes the value to the shared Tensor and asks the Kernel about aborts, and it does so at most
+	 * once per update interval. Other threads only read a flag, through which the abort propagates to them. In parallel loops use a
+	 * ProgressMonitor::Local in each task, which accumulates progress in a plain variable and adds it to the monitor in batches.
 	 **/
 	class ProgressMonitor {
 	public:
 		/// A type to represent a buffer shared between LLU and the Kernel which is used to report progress
 		using SharedTensor = Tensor<double>;
 
+		/// Clock used to throttle updates of the shared Tensor
+		using Clock = std::chrono::steady_clock;
+
+		class Stage;
+
+		/**
+		 * @brief	Progress accumulated by a single thread, typically a single task of a parallel loop.
+		 *
+		 * Incrementing a Local costs an addition and a counter check, every flushPeriod increments the accumulated progress is added to the
+		 * monitor or stage, which is also when an abort is detected. The rest is added when the Local is destroyed.
+		 */
+		class Local {
+		public:
+			/// Number of increments after which the accumulated progress is added to the monitor
+			static constexpr unsigned flushPeriod = 64;
+
+			/// Create an accumulator for given monitor, which must outlive it
+			explicit Local(ProgressMonitor& pm) noexcept : monitor {&pm}, step {pm.step} {}
+
+			/// Create an accumulator for given stage, which must outlive it
+			explicit Local(Stage& s) noexcept;
+
+			Local(const Local&) = delete;
+			Local& operator=(const Local&) = delete;
+
+			/// Add the accumulated progress to the monitor, without checking for aborts
+			~Local();
+
+			/// Increment the accumulated progress by the step of the monitor or stage
+			Local& operator++() {
+				return *this += step;
+			}
+
+			/// Increment the accumulated progress by a given number
+			Local& operator+=(double progress) {
+				pending += progress;
+				if (++count == flushPeriod) {
+					flush();
+				}
+				return *this;
+			}
+
+			/**
+			 * @brief	Add the accumulated progress to the monitor now.
+			 * @throws	ErrorName::Aborted - if user requested to abort the computation
+			 */
+			void flush();
+
+		private:
+			ProgressMonitor* monitor = nullptr;
+			Stage* stage = nullptr;
+			double step;
+			double pending = 0;
+			unsigned count = 0;
+		};
+
+		/**
+		 * @brief	A part of the computation that contributes a fixed fraction (weight) of the total progress.
+		 *
+		 * The progress of a stage goes from 0. to 1. independently of other stages, and every change is scaled by the weight and added
+		 * to the monitor with atomic operations, so stages can be updated from different threads (e.g. from tasks posted to
+		 * LLU::ThreadPool) without locks. Stages can be split further into sub-stages, the weight of a sub-stage is relative to its parent
+		 * and its progress is added to the progress of the parent.
+		 * A stage must not outlive the monitor or stage it was created from.
+		 */
+		class Stage {
+		public:
+			Stage(const Stage&) = delete;
+			Stage& operator=(const Stage&) = delete;
+			~Stage() = default;
+
+			/**
+			 * @brief Create a sub-stage
+			 * @param weight - fraction of this stage that the sub-stage represents
+			 * @param step - by how much to modify the progress of the sub-stage in operator++
+			 */
+			Stage stage(double weight, double step = defaultStep) {
+				return Stage {root, this, weight, step};
+			}
+
+			/// Get the progress of this stage (a \c double between 0. and 1.)
+			double get() const {
+				return progress.load(std::memory_order_relaxed);
+			}
+
+			/// Get the fraction of the total progress that this stage represents
+			double getWeight() const noexcept {
+				return parent ? parent->getWeight() * weight : weight;
+			}
+
+			/**
+			 * @brief Set the progress of this stage.
+			 * @param progressValue - progress of the stage (a \c double between 0. and 1.)
+			 * @throws ErrorName::Aborted - if user requested to abort the computation
+			 */
+			void set(double progressValue);
+
+			/// Mark this stage as finished, i.e. set its progress to 1.
+			void complete() {
+				set(1.);
+			}
+
+			/// Increment the progress of this stage by \c step.
+			Stage& operator++() {
+				return *this += step;
+			}
+
+			/// Increment the progress of this stage by a given number
+			Stage& operator+=(double progressValue);
+
+		private:
+			friend class ProgressMonitor;
+			friend class Local;
+
+			Stage(ProgressMonitor& pm, Stage* parentStage, double weightValue, double stepValue)
+				: root {pm}, parent {parentStage}, weight {weightValue}, step {stepValue} {}
+
+			/// Add to the progress of this stage and all its ancestors, return the change of the total progress
+			double propagate(double progressValue) noexcept;
+
+			ProgressMonitor& root;
+			Stage* parent;
+			double weight;
+			double step;
+			std::atomic<double> progress {0.};
+		};
+
 		/**
 		 * @brief Construct a new ProgressMonitor
 		 * @param sharedIndicator - shared Tensor of type \c double. If tensor length is smaller than 1, the behavior is undefined.
@@ -41,9 +178,9 @@ namespace LLU {
 		ProgressMonitor& operator=(ProgressMonitor&&) = default;
 
 		/**
-		 * @brief Default destructor.
+		 * @brief Destructor, writes the final progress value to the shared Tensor.
 		 */
-		~ProgressMonitor() = default;
+		~ProgressMonitor();
 
 		/**
 		 * @brief Get current value of the progress.
@@ -52,7 +189,8 @@ namespace LLU {
 		double get() const;
 
 		/**
-		 * @brief Set current progress value.
+		 * @brief Set current progress value. When called from the thread that created the monitor, the value is written to the shared Tensor
+		 * immediately, so use it to mark phases of the computation rather than in tight loops.
 		 * @param progressValue - current progress (a \c double between 0. and 1.)
 		 */
 		void set(double progressValue);
@@ -69,8 +207,38 @@ namespace LLU {
 		 */
 		void setStep(double stepValue);
 
+		/**
+		 * @brief Get the minimal time between two updates of the shared Tensor.
+		 * @return current update interval
+		 */
+		std::chrono::milliseconds getUpdateInterval() const;
+
+		/**
+		 * @brief Change the minimal time between two updates of the shared Tensor and two checks for aborts.
+		 * @param interval - new interval, 0 means that every change of progress is published
+		 */
+		void setUpdateInterval(std::chrono::milliseconds interval);
+
+		/**
+		 * @brief Write current progress to the shared Tensor and check for aborts, regardless of the update interval. Does nothing
+		 * in threads other than the one that created the monitor, except throwing if the abort has already been detected.
+		 * @throws ErrorName::Aborted - if user requested to abort the computation
+		 */
+		void publish();
+
+		/**
+		 * @brief Create a stage that represents a part of the whole computation.
+		 * @param weight - fraction of the total progress that the stage represents, weights of all stages should add up to at most 1.
+		 * @param step - by how much to modify the progress of the stage in operator++
+		 * @return a stage, which must not outlive this monitor
+		 */
+		Stage stage(double weight, double step = defaultStep) {
+			return Stage {*this, nullptr, weight, step};
+		}
+
 		/**
 		 * @brief Check whether user requested to abort the computation in WL Kernel.
+		 * @note  This function calls into the Kernel, so it must only be called from the thread that runs the library function.
 		 */
 		static void checkAbort();
 
@@ -107,15 +275,45 @@ namespace LLU {
 		static constexpr double getDefaultStep() noexcept {
 			return defaultStep;
 		}
+
+		/**
+		 * @brief   Return default update interval for the ProgressMonitor
+		 * @return  default update interval (50 ms)
+		 */
+		static constexpr std::chrono::milliseconds getDefaultUpdateInterval() noexcept {
+			return defaultUpdateInterval;
+		}
+
 	private:
+		/// Progress and abort state shared by all threads that report progress
+		struct State {
+			std::atomic<double> progress {0.};
+			std::atomic<bool> aborted {false};
+			std::thread::id owner = std::this_thread::get_id();
+			std::chrono::milliseconds interval = defaultUpdateInterval;
+			Clock::time_point nextUpdate {};
+		};
+
+		/// Add to the progress value, safe to call from multiple threads
+		void add(double progress);
+
+		/// Publish progress and check for aborts if the update interval passed, or throw if the abort was detected in another thread
+		void update(bool force);
+
 		/// By default, progress changes by .1 each time
 		static constexpr double defaultStep = .1;
 
+		/// By default, the shared Tensor is updated at most 20 times per second
+		static constexpr std::chrono::milliseconds defaultUpdateInterval {50};
+
 		/// This tensor stores current progress as the first element.
 		SharedTensor sharedIndicator;
 
 		/// Step determines by how much will ++ or -- operators modify the current progress.
 		double step;
+
+		/// Atomic state lives on the heap so that ProgressMonitor stays movable
+		std::unique_ptr<State> state;
 	};
 
 } // namespace LLU
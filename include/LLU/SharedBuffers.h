@@ -0,0 +1,322 @@
+/**
+ * @file	SharedBuffers.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Registry of Tensors and NumericArrays that stay resident in the library between calls and are referenced by Managed Expression ID,
+ * and hand-off of large results of WSTP functions as shared containers.
+ */
+#ifndef LLU_SHAREDBUFFERS_H
+#define LLU_SHAREDBUFFERS_H
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "LLU/Containers/Generic/NumericArray.hpp"
+#include "LLU/Containers/Generic/Tensor.hpp"
+#include "LLU/Containers/Views/NumericArray.hpp"
+#include "LLU/Containers/Views/Tensor.hpp"
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/ManagedExpression.hpp"
+#include "LLU/WSTP/WSStream.hpp"
+
+/**
+ * @brief Use this macro to define a SharedBufferRegistry and the specialization of manageInstanceCallback for SharedBuffer.
+ * It replaces DEFINE_MANAGED_STORE_AND_SPECIALIZATION for shared buffers, so it can be used once per library.
+ */
+#define DEFINE_SHARED_BUFFER_REGISTRY(RegistryName)                                                       \
+	LLU::SharedBufferRegistry RegistryName;                                                               \
+                                                                                                          \
+	template<>                                                                                            \
+	inline void LLU::manageInstanceCallback<LLU::SharedBuffer>(WolframLibraryData, mbool mode, mint id) { \
+		RegistryName.manageInstance(mode, id);                                                            \
+	}
+
+namespace LLU {
+
+	/**
+	 * @class   SharedBuffer
+	 * @brief   Tensor or NumericArray kept alive by the library as long as the corresponding Managed Expression exists in the Wolfram Language.
+	 *
+	 * A container passed with "Shared" mode is kept as is, so the library and the Wolfram Language see the same memory and no data is ever
+	 * copied. A container passed with any other mode is copied once, when the buffer is created. Containers created by the library are
+	 * taken over without copying.
+	 */
+	class SharedBuffer {
+	public:
+		/**
+		 * @brief   Create a buffer holding a Tensor
+		 * @param   t - Tensor, typically obtained with MArgumentManager::getGenericTensor<Passing::Shared>
+		 */
+		explicit SharedBuffer(GenericTensor t) : data(keep(std::move(t))) {}
+
+		/**
+		 * @brief   Create a buffer holding a NumericArray
+		 * @param   na - NumericArray, typically obtained with MArgumentManager::getGenericNumericArray<Passing::Shared>
+		 */
+		explicit SharedBuffer(GenericNumericArray na) : data(keep(std::move(na))) {}
+
+		/// Get the type of the container, either MArgumentType::Tensor or MArgumentType::NumericArray
+		MArgumentType type() const noexcept {
+			return std::holds_alternative<GenericTensor>(data) ? MArgumentType::Tensor : MArgumentType::NumericArray;
+		}
+
+		/**
+		 * @brief   Get a typed view of the Tensor held by the buffer
+		 * @throws  ErrorName::MLEDynamicTypeError - if the buffer holds a NumericArray
+		 * @throws  ErrorName::TensorTypeError - if the Tensor does not hold elements of type T
+		 */
+		template<typename T>
+		TensorTypedView<T> tensor() const {
+			return TensorTypedView<T> {genericTensor()};
+		}
+
+		/**
+		 * @brief   Get a typed view of the NumericArray held by the buffer
+		 * @throws  ErrorName::MLEDynamicTypeError - if the buffer holds a Tensor
+		 * @throws  ErrorName::NumericArrayTypeError - if the NumericArray does not hold elements of type T
+		 */
+		template<typename T>
+		NumericArrayTypedView<T> numericArray() const {
+			return NumericArrayTypedView<T> {genericNumericArray()};
+		}
+
+		/**
+		 * @brief   Get the Tensor held by the buffer
+		 * @throws  ErrorName::MLEDynamicTypeError - if the buffer holds a NumericArray
+		 */
+		const GenericTensor& genericTensor() const {
+			const auto* t = std::get_if<GenericTensor>(&data);
+			if (!t) {
+				ErrorManager::throwException(ErrorName::MLEDynamicTypeError);
+			}
+			return *t;
+		}
+
+		/**
+		 * @brief   Get the NumericArray held by the buffer
+		 * @throws  ErrorName::MLEDynamicTypeError - if the buffer holds a Tensor
+		 */
+		const GenericNumericArray& genericNumericArray() const {
+			const auto* na = std::get_if<GenericNumericArray>(&data);
+			if (!na) {
+				ErrorManager::throwException(ErrorName::MLEDynamicTypeError);
+			}
+			return *na;
+		}
+
+		/**
+		 * @brief   Pass the container to LibraryLink as the result of a library function, without copying it
+		 * @details If the container is owned by the library, LibraryLink takes it over and the buffer must not be used afterwards.
+		 */
+		void pass(MArgument& res) const {
+			std::visit([&res](const auto& c) { c.pass(res); }, data);
+		}
+
+	private:
+		/// Containers owned by LibraryLink are freed when the library function returns, so they must be copied
+		template<class Container>
+		static Container keep(Container c) {
+			if (c.getOwner() == Ownership::LibraryLink) {
+				return c.clone();
+			}
+			return c;
+		}
+
+		std::variant<GenericTensor, GenericNumericArray> data;
+	};
+
+	/**
+	 * @class   SharedResults
+	 * @brief   Table of Tensors and NumericArrays that WSTP library functions hand over to the Wolfram Language without sending them over WSTP.
+	 *
+	 * A WSTP function stages a container with <tt>ms << WS::shared(std::move(container))</tt>, which sends only a small expression
+	 * <tt>LLU`SharedResult[ticket, type, dims]</tt>. LibraryLinkUtilities.wl replaces it with the result of the LibraryLink function fetchSharedResult,
+	 * which passes the container created by the library to the kernel without copying. Alternatively, a staged container can be kept in the
+	 * library as a resident buffer with SharedBufferRegistry::adopt. There is one table per library and all functions are thread-safe.
+	 */
+	class SharedResults {
+	public:
+		/**
+		 * @brief   Add a buffer to the table
+		 * @return  ticket of the buffer, unique within the library
+		 */
+		static mint stage(SharedBuffer buffer);
+
+		/**
+		 * @brief   Remove a buffer from the table
+		 * @param   ticket - ticket returned by stage
+		 * @return  the buffer
+		 * @throws  ErrorName::ManagedExprInvalidID - if there is no buffer with given ticket, e.g. because it has already been claimed
+		 */
+		static SharedBuffer claim(mint ticket);
+
+		/**
+		 * @brief   Remove a buffer from the table and free it, to be used for results that are never going to be fetched
+		 * @return  whether there was a buffer with given ticket
+		 */
+		static bool release(mint ticket);
+
+		/// Get the number of staged buffers that have not been claimed nor released yet
+		static std::size_t pending();
+	};
+
+	/**
+	 * @class   SharedBufferRegistry
+	 * @brief   ManagedExpressionStore of SharedBuffers, in which buffers can also be given names.
+	 *
+	 * A buffer is created in the constructor of the Managed Expression and is released together with it, follow-up library functions
+	 * take the Managed Expression (i.e. its ID) as argument and access the data via MArgumentManager::getManagedExpression, or find
+	 * the buffer by name. Names are removed when the buffer they refer to is released.
+	 */
+	class SharedBufferRegistry : public ManagedExpressionStore<SharedBuffer> {
+	public:
+		/**
+		 * Function that will actually be called by LibraryLink when a buffer is created or deleted
+		 * @param mode - are we deleting existing instance (True) or creating new one (False)
+		 * @param id - id of the instance of interest
+		 */
+		void manageInstance(mbool mode, mint id) {
+			if (mode != False) {
+				for (auto it = names.begin(); it != names.end();) {
+					it = (it->second == id) ? names.erase(it) : std::next(it);
+				}
+			}
+			ManagedExpressionStore<SharedBuffer>::manageInstance(mode, id);
+		}
+
+		/**
+		 * @brief   Create a buffer for a Managed Expression
+		 * @param   id - id of the Managed Expression, which must already be known to the registry
+		 * @param   container - GenericTensor or GenericNumericArray
+		 * @return  reference to the new buffer
+		 */
+		template<class Container>
+		SharedBuffer& share(mint id, Container container) {
+			return createInstance(id, std::move(container));
+		}
+
+		/**
+		 * @brief   Turn a result staged by a WSTP function into the buffer of a Managed Expression, so that it stays resident in the library
+		 * @param   id - id of the Managed Expression, which must already be known to the registry
+		 * @param   ticket - ticket of the staged result, see SharedResults
+		 * @return  reference to the new buffer
+		 * @throws  ErrorName::ManagedExprInvalidID - if there is no staged result with given ticket
+		 */
+		SharedBuffer& adopt(mint id, mint ticket) {
+			return createInstance(id, SharedResults::claim(ticket));
+		}
+
+		/**
+		 * @brief   Give a name to an existing buffer, replacing any previous buffer with the same name
+		 * @throws  ErrorName::ManagedExprInvalidID - if there is no buffer with given id
+		 */
+		void setName(std::string name, mint id) {
+			if (!hasInstance(id)) {
+				ErrorManager::throwException(ErrorName::ManagedExprInvalidID);
+			}
+			names[std::move(name)] = id;
+		}
+
+		/**
+		 * @brief   Get the id of a buffer with given name
+		 * @throws  ErrorName::ManagedExprInvalidID - if there is no buffer with that name
+		 */
+		mint idOf(const std::string& name) const {
+			auto it = names.find(name);
+			if (it == names.end()) {
+				ErrorManager::throwException(ErrorName::ManagedExprInvalidID, name);
+			}
+			return it->second;
+		}
+
+		/**
+		 * @brief   Get a buffer by name
+		 * @throws  ErrorName::ManagedExprInvalidID - if there is no buffer with that name
+		 */
+		SharedBuffer& getInstance(const std::string& name) {
+			return ManagedExpressionStore<SharedBuffer>::getInstance(idOf(name));
+		}
+
+		using ManagedExpressionStore<SharedBuffer>::getInstance;
+
+	private:
+		std::unordered_map<std::string, mint> names;
+	};
+
+}  // namespace LLU
+
+namespace LLU::WS {
+
+	/// Head of the expression that WSTP functions send in place of a container staged in SharedResults
+	inline constexpr const char* sharedResultHead = "LLU`SharedResult";
+
+	/**
+	 * @struct 	Shared
+	 * @brief	Utility structure that owns a Tensor or NumericArray which is sent over WSTP as an LLU`SharedResult handle, see SharedResults
+	 * @tparam 	Container - GenericTensor, GenericNumericArray, Tensor<T> or NumericArray<T>
+	 */
+	template<typename Container>
+	struct Shared {
+		/// Container to be handed over
+		Container array;
+	};
+
+	/// Create a WS::Shared wrapper that takes over the container, e.g. ms << WS::shared(std::move(tensor))
+	template<typename Container>
+	Shared<remove_cv_ref<Container>> shared(Container&& array) {
+		return {std::forward<Container>(array)};
+	}
+
+	namespace Detail {
+		/// Element type of a Tensor (Integer, Real or Complex) or "NumericArray", which tells LLU how to load the function that fetches the result
+		inline const char* sharedResultType(const GenericTensor& t) {
+			switch (t.type()) {
+				case MType_Integer: return "Integer";
+				case MType_Real: return "Real";
+				default: return "Complex";
+			}
+		}
+
+		/// @copydoc sharedResultType(const GenericTensor&)
+		inline const char* sharedResultType(const GenericNumericArray& /*na*/) {
+			return "NumericArray";
+		}
+	}  // namespace Detail
+}  // namespace LLU::WS
+
+namespace LLU {
+	/**
+	 * Stages the container in SharedResults and sends LLU`SharedResult[ticket, type, dims] instead of the data
+	 * @tparam 	EIn - WSStream input encoding
+	 * @tparam 	EOut - WSStream output encoding
+	 * @tparam 	Container - Tensor or NumericArray type
+	 * @param 	ms - reference to the WSStream object
+	 * @param 	s - wrapper that owns the container
+	 * @return	reference to the stream
+	 */
+	template<WS::Encoding EIn, WS::Encoding EOut, typename Container>
+	WSStream<EIn, EOut>& operator<<(WSStream<EIn, EOut>& ms, WS::Shared<Container> s) {
+		using Generic = std::conditional_t<std::is_base_of_v<GenericTensor, Container>, GenericTensor, GenericNumericArray>;
+		Generic array {std::move(static_cast<Generic&>(s.array))};
+		const auto* dims = array.getDimensions();
+		std::vector<mint> dimensions(dims, dims + array.getRank());
+		const char* type = WS::Detail::sharedResultType(array);
+		const mint ticket = SharedResults::stage(SharedBuffer {std::move(array)});
+		try {
+			ms << WS::Function(WS::sharedResultHead, 3) << ticket << type << dimensions;
+		} catch (...) {
+			// nobody will ever learn the ticket
+			SharedResults::release(ticket);
+			throw;
+		}
+		return ms;
+	}
+}  // namespace LLU
+
+#endif	  // LLU_SHAREDBUFFERS_H
@@ -0,0 +1,402 @@
+/**
+ * @file	SlabManagedExpression.hpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Definition of the SlabManagedExpressionStore class template, a ManagedExpressionStore that keeps instances in an array indexed by ID
+ */
+#ifndef LLU_SLABMANAGEDEXPRESSION_HPP
+#define LLU_SLABMANAGEDEXPRESSION_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/LibraryData.h"
+#include "LLU/ManagedExpression.hpp"
+
+/**
+ * @brief Use this macro to define an instance of SlabManagedExpressionStore corresponding to your class
+ * and a template specialization of manageInstanceCallback for the managed class.
+ */
+#define DEFINE_SLAB_MANAGED_STORE_AND_SPECIALIZATION(ClassName)                                   \
+	LLU::SlabManagedExpressionStore<ClassName> ClassName##Store;                                  \
+                                                                                                  \
+	template<>                                                                                    \
+	inline void LLU::manageInstanceCallback<ClassName>(WolframLibraryData, mbool mode, mint id) { \
+		ClassName##Store.manageInstance(mode, id);                                                \
+	}
+
+namespace LLU {
+
+	/**
+	 * @brief   ManagedExpressionStore in which looking up an instance by ID is a single array access.
+	 *
+	 * IDs of Managed Expressions are assigned by the kernel from a counter, so the IDs of instances alive at the same time are usually close to
+	 * each other. The store keeps instances in a power-of-2 sized array of slots, where an instance with ID \c id occupies the slot
+	 * <tt>id mod capacity</tt>. Each slot remembers the full ID of its instance, whose higher bits act as a generation number: a lookup of an ID
+	 * that has already been released, or of an ID that maps to the same slot as a live instance, fails the comparison instead of returning
+	 * a wrong object. The array grows when IDs of live instances collide and the array is dense enough, otherwise colliding instances
+	 * are kept in a hash map on the side, so a few long-lived instances never force a huge array.
+	 *
+	 * The interface is the same as that of ManagedExpressionStore, without thread-safety. Iterators are invalidated by creating new instances.
+	 *
+	 * @tparam T - managed class
+	 */
+	template<typename T>
+	class SlabManagedExpressionStore : public ManagedExpressionStoreBase<SlabManagedExpressionStore<T>, T> {
+		/// Slot of the array, or entry of the overflow map, it holds the ID of the instance and the pointer to it
+		using Slot = std::pair<mint, std::shared_ptr<T>>;
+
+		template<bool IsConst>
+		class Iterator;
+
+	public:
+		/// Iterator over SlabManagedExpressionStore, it visits (id, pointer) pairs
+		using iterator = Iterator<false>;
+
+		/// Constant iterator over SlabManagedExpressionStore
+		using const_iterator = Iterator<true>;
+
+		/// Size type of the Store
+		using size_type = std::size_t;
+
+	public:
+		/**
+		 * Create an empty store
+		 * @param initialCapacity - initial number of slots, rounded up to a power of 2
+		 */
+		explicit SlabManagedExpressionStore(size_type initialCapacity = defaultCapacity) : slots(roundUp(initialCapacity), freeSlot()) {}
+
+		/**
+		 * Function that will actually be called by LibraryLink when an instance of Managed Expression is created or deleted
+		 *
+		 * Notice that this function does not actually create a new object of class T. This is because there is no way to pass constructor arguments here.
+		 *
+		 * @param mode - are we deleting existing instance (True) or creating new one (False)
+		 * @param id - id of the instance of interest
+		 */
+		void manageInstance(mbool mode, mint id) {
+			if (mode == False /* create new instance */) {
+				insert(id);
+			} else {
+				erase(id);
+			}
+		}
+
+		/**
+		 * Create new object of class T that will be managed from Wolfram Language and place it in the store
+		 * @tparam  DynamicType - actual type of the constructed object, it allows Store to keep objects of subclasses of T
+		 * @tparam  Args - constructor arguments types
+		 * @param   id - id of the newly created managed object
+		 * @param   args - constructor arguments
+		 * @return  reference to the newly created object
+		 */
+		template<class DynamicType = T, typename... Args>
+		T& createInstance(mint id, Args&&... args) {
+			auto& instancePtr = checkedFind(id);	// at this point instance must already exist in store
+			instancePtr = this->template makeInstance<DynamicType>(std::forward<Args>(args)...);
+			return *instancePtr;
+		}
+
+		/**
+		 * Create instance in the store from a pointer to the managed class object.
+		 * @param   id - id of the newly created managed object
+		 * @param   ptr - pointer to an instance of T or a subclass
+		 * @return  reference to the object just added to the store
+		 */
+		T& createInstance(mint id, std::shared_ptr<T> ptr) {
+			auto& instancePtr = checkedFind(id);
+			instancePtr = std::move(ptr);
+			return instanceAt(instancePtr);
+		}
+
+		/**
+		 * Create instance in the store from a unique pointer to the managed class object. The store will claim shared ownership of the managed object.
+		 * @param   id - id of the newly created managed object
+		 * @param   ptr - pointer to an instance of T or a subclass
+		 * @return  reference to the object just added to the store
+		 */
+		T& createInstance(mint id, std::unique_ptr<T> ptr) {
+			return createInstance(id, std::shared_ptr<T> {std::move(ptr)});
+		}
+
+		/**
+		 * Check if instance with given \p id is present in the store.
+		 * @param id - id to be checked
+		 * @return true iff the instance with given id is in the store
+		 */
+		[[nodiscard]] bool hasInstance(mint id) const noexcept {
+			return find(id) != nullptr;
+		}
+
+		/**
+		 * Get managed instance with given \p id. Throw if the \p id is invalid or if there is no corresponding instance.
+		 * @param id - id of instance of interest
+		 * @return reference to the managed object
+		 */
+		T& getInstance(mint id) {
+			return instanceAt(checkedFind(id));
+		}
+
+		/**
+		 * Get a shared pointer to a managed instance with given \p id. Throw if the \p id is invalid.
+		 * @param id - id of instance of interest
+		 * @return shared pointer to the managed object
+		 */
+		std::shared_ptr<T> getInstancePointer(mint id) {
+			return checkedFind(id);
+		}
+
+		/**
+		 * Get the number of currently managed expressions.
+		 * @return size of the store
+		 */
+		size_type size() const noexcept {
+			return count;
+		}
+
+		/**
+		 * Get the number of slots in the array, which does not include instances kept in the overflow map
+		 */
+		size_type capacity() const noexcept {
+			return slots.size();
+		}
+
+		/// Get the iterator to the first element of the Store
+		iterator begin() noexcept {
+			return iterator {slots.data(), slots.data() + slots.size(), overflow.begin()};
+		}
+
+		/// Get the const iterator to the first element of the Store
+		const_iterator begin() const noexcept {
+			return cbegin();
+		}
+
+		/// Get the const iterator to the first element of the Store
+		const_iterator cbegin() const noexcept {
+			return const_iterator {slots.data(), slots.data() + slots.size(), overflow.cbegin()};
+		}
+
+		/// Get the iterator past the last element of the Store
+		iterator end() noexcept {
+			return iterator {slots.data() + slots.size(), slots.data() + slots.size(), overflow.end()};
+		}
+
+		/// Get the const iterator past the last element of the Store
+		const_iterator end() const noexcept {
+			return cend();
+		}
+
+		/// Get the const iterator past the last element of the Store
+		const_iterator cend() const noexcept {
+			return const_iterator {slots.data() + slots.size(), slots.data() + slots.size(), overflow.cend()};
+		}
+
+	private:
+		using Overflow = std::unordered_map<mint, Slot>;
+
+		/// Iterator visits all occupied slots of the array and then all entries of the overflow map
+		template<bool IsConst>
+		class Iterator {
+			using SlotPtr = std::conditional_t<IsConst, const Slot*, Slot*>;
+			using MapIterator = std::conditional_t<IsConst, typename Overflow::const_iterator, typename Overflow::iterator>;
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = Slot;
+			using difference_type = std::ptrdiff_t;
+			using pointer = SlotPtr;
+			using reference = std::conditional_t<IsConst, const Slot&, Slot&>;
+
+			Iterator() = default;
+
+			Iterator(SlotPtr current, SlotPtr last, MapIterator overflowPos) : current(current), last(last), overflowPos(overflowPos) {
+				skipFree();
+			}
+
+			/// Const iterator can be created from a non-const one
+			template<bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+			Iterator(const Iterator<OtherConst>& other) : current(other.current), last(other.last), overflowPos(other.overflowPos) {}	// NOLINT
+
+			reference operator*() const {
+				return current != last ? *current : overflowPos->second;
+			}
+
+			pointer operator->() const {
+				return &**this;
+			}
+
+			Iterator& operator++() {
+				if (current != last) {
+					++current;
+					skipFree();
+				} else {
+					++overflowPos;
+				}
+				return *this;
+			}
+
+			Iterator operator++(int) {
+				auto tmp = *this;
+				++*this;
+				return tmp;
+			}
+
+			friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+				return lhs.current == rhs.current && lhs.overflowPos == rhs.overflowPos;
+			}
+
+			friend bool operator!=(const Iterator& lhs, const Iterator& rhs) {
+				return !(lhs == rhs);
+			}
+
+		private:
+			friend class Iterator<!IsConst>;
+
+			void skipFree() noexcept {
+				while (current != last && current->first == noID) {
+					++current;
+				}
+			}
+
+			SlotPtr current = nullptr;
+			SlotPtr last = nullptr;
+			MapIterator overflowPos {};
+		};
+
+		/// Default initial number of slots
+		static constexpr size_type defaultCapacity = 64;
+
+		/// Marks a free slot, IDs of Managed Expressions are positive
+		static constexpr mint noID = -1;
+
+		/// The array grows on collision only if at least 1/minDensity of the grown array would be occupied
+		static constexpr size_type minDensity = 8;
+
+		static Slot freeSlot() {
+			return {noID, nullptr};
+		}
+
+		static size_type roundUp(size_type n) noexcept {
+			size_type capacity = 1;
+			while (capacity < n) {
+				capacity *= 2;
+			}
+			return capacity;
+		}
+
+		size_type slotOf(mint id) const noexcept {
+			return static_cast<size_type>(id) & (slots.size() - 1);
+		}
+
+		/// Find the pointer stored for given ID, or return nullptr if the ID is not present in the store
+		template<class Store>
+		static auto findIn(Store& store, mint id) noexcept -> decltype(&store.slots.front().second) {
+			auto& slot = store.slots[store.slotOf(id)];
+			if (slot.first == id) {
+				return &slot.second;
+			}
+			if (store.overflow.empty()) {
+				return nullptr;
+			}
+			auto it = store.overflow.find(id);
+			return it == store.overflow.end() ? nullptr : &it->second.second;
+		}
+
+		const std::shared_ptr<T>* find(mint id) const noexcept {
+			return findIn(*this, id);
+		}
+
+		std::shared_ptr<T>* find(mint id) noexcept {
+			return findIn(*this, id);
+		}
+
+		/**
+		 * Helper function that returns the pointer stored for given ID and throws if the ID is not present in the store
+		 * @param id - id to be checked
+		 */
+		std::shared_ptr<T>& checkedFind(mint id) {
+			auto* instancePtr = find(id);
+			if (!instancePtr) {
+				ErrorManager::throwException(ErrorName::ManagedExprInvalidID);
+			}
+			return *instancePtr;
+		}
+
+		/**
+		 * Safely access an instance, throw if the instance does not exist
+		 * @param instancePtr - pointer stored in the slot
+		 * @return reference to the managed object
+		 */
+		static T& instanceAt(const std::shared_ptr<T>& instancePtr) {
+			if (!instancePtr) {
+				ErrorManager::throwException(ErrorName::MLENullInstance);
+			}
+			return *instancePtr;
+		}
+
+		void insert(mint id) {
+			if (auto* instancePtr = find(id)) {
+				*instancePtr = nullptr;
+				return;
+			}
+			while (slots[slotOf(id)].first != noID && minDensity * (count + 1) >= 2 * slots.size()) {
+				grow();
+			}
+			auto& slot = slots[slotOf(id)];
+			if (slot.first == noID) {
+				slot.first = id;
+			} else {
+				overflow.emplace(id, Slot {id, nullptr});
+			}
+			++count;
+		}
+
+		void erase(mint id) {
+			auto& slot = slots[slotOf(id)];
+			if (slot.first == id) {
+				slot = freeSlot();
+				--count;
+			} else if (overflow.erase(id) == 1) {
+				--count;
+			}
+		}
+
+		/// Double the number of slots, instances from the overflow map are moved to the array if their slot is free
+		void grow() {
+			std::vector<Slot> old(2 * slots.size(), freeSlot());
+			old.swap(slots);
+			for (auto& s : old) {
+				if (s.first != noID) {
+					slots[slotOf(s.first)] = std::move(s);
+				}
+			}
+			for (auto it = overflow.begin(); it != overflow.end();) {
+				auto& slot = slots[slotOf(it->first)];
+				if (slot.first == noID) {
+					slot = std::move(it->second);
+					it = overflow.erase(it);
+				} else {
+					++it;
+				}
+			}
+		}
+
+	private:
+		/// Array of slots, its size is always a power of 2
+		std::vector<Slot> slots;
+
+		/// Instances whose slot is occupied by another live instance
+		Overflow overflow;
+
+		/// Number of instances in the store
+		size_type count = 0;
+	};
+
+}	 // namespace LLU
+
+#endif	  // LLU_SLABMANAGEDEXPRESSION_HPP
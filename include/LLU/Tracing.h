@@ -0,0 +1,185 @@
+/**
+ * @file	Tracing.h
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Optional tracing of LLU activity: scoped spans recorded in per-thread ring buffers and exported in the Chrome trace format.
+ */
+#ifndef LLU_TRACING_H
+#define LLU_TRACING_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace LLU {
+
+	/**
+	 * Whether LLU records trace spans of library functions, thread pool tasks, expressions sent with WSStream and log calls.
+	 * Define LLU_TRACING to enable them, otherwise the instrumentation is compiled out and only the (empty) trace can be exported.
+	 * @note The flag must have the same value in all translation units of a paclet.
+	 */
+#ifdef LLU_TRACING
+	inline constexpr bool tracingEnabled = true;
+#else
+	inline constexpr bool tracingEnabled = false;
+#endif
+
+	namespace Trace {
+
+		/// Clock used to measure spans
+		using Clock = std::chrono::steady_clock;
+
+		/// Get the current time in nanoseconds since the epoch of Trace::Clock
+		inline std::int64_t now() noexcept {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+		}
+
+		/// Span copied out of a ring buffer
+		struct Event {
+			/// Category of the span, e.g. "LibraryFunction" or "ThreadPool"
+			const char* category;
+			/// Name of the span
+			const char* name;
+			/// Start of the span in nanoseconds, see Trace::now
+			std::int64_t startNs;
+			/// Duration of the span in nanoseconds
+			std::int64_t durationNs;
+			/// Number of the buffer in which the span was recorded, it is the same for all spans of a thread
+			std::uint32_t thread;
+		};
+
+		/**
+		 * @class   ThreadBuffer
+		 * @brief   Fixed-size ring buffer of spans written by a single thread.
+		 *
+		 * Recording a span takes no locks and no read-modify-write operations, only relaxed stores that the thread owning the buffer is the sole
+		 * writer of. When the buffer is full the oldest spans are overwritten. Readers copy the spans without stopping the writer and discard
+		 * every span that might have been overwritten while they were reading.
+		 */
+		class ThreadBuffer {
+		public:
+			/// Number of most recent spans kept for each thread
+			static constexpr std::size_t capacity = 4096;
+
+			explicit ThreadBuffer(std::uint32_t id) noexcept : threadId {id} {}
+			ThreadBuffer(const ThreadBuffer&) = delete;
+			ThreadBuffer& operator=(const ThreadBuffer&) = delete;
+
+			/// Record a span, must only be called by the thread that owns the buffer
+			void record(const char* category, const char* name, std::int64_t startNs, std::int64_t durationNs) noexcept {
+				const auto n = written.load(std::memory_order_relaxed);
+				// a reader that sees any of the stores below also sees that the slot is being reused
+				std::atomic_thread_fence(std::memory_order_release);
+				auto& slot = slots[n % slots.size()];
+				slot.category.store(category, std::memory_order_relaxed);
+				slot.name.store(name, std::memory_order_relaxed);
+				slot.startNs.store(startNs, std::memory_order_relaxed);
+				slot.durationNs.store(durationNs, std::memory_order_relaxed);
+				written.store(n + 1, std::memory_order_release);
+			}
+
+			/// Append copies of all spans recorded since the last clear() to \p events, oldest first
+			void collect(std::vector<Event>& events) const;
+
+			/// Forget all spans recorded so far, may be called from any thread
+			void clear() noexcept {
+				cleared.store(written.load(std::memory_order_acquire), std::memory_order_relaxed);
+			}
+
+		private:
+			struct Slot {
+				std::atomic<const char*> category {nullptr};
+				std::atomic<const char*> name {nullptr};
+				std::atomic<std::int64_t> startNs {0};
+				std::atomic<std::int64_t> durationNs {0};
+			};
+
+			alignas(64) std::atomic<std::uint64_t> written {0};
+			std::atomic<std::uint64_t> cleared {0};
+			std::uint32_t threadId;
+			/// one slot more than capacity, so that the slot being reused never holds one of the spans that a reader keeps
+			std::array<Slot, capacity + 1> slots {};
+		};
+
+		/**
+		 * Get the ring buffer of the calling thread. Buffers live until the library is unloaded, when a thread exits its buffer, together with
+		 * the spans recorded so far, is handed over to the next thread that starts recording.
+		 */
+		ThreadBuffer& threadBuffer();
+
+		/**
+		 * Get a pointer to a copy of given string that stays valid until the library is unloaded, for spans with names not known at compile time
+		 * @param name - name of a span
+		 * @return pointer to a null-terminated string, equal strings always give the same pointer
+		 */
+		const char* intern(std::string_view name);
+
+		/**
+		 * @class   Span
+		 * @brief   Records time from construction to destruction as a span in the ring buffer of the calling thread.
+		 * @note    Category and name are not copied, they must stay valid until the library is unloaded, like string literals or results of intern().
+		 */
+		class Span {
+		public:
+			Span(const char* category, const char* name) noexcept : Span(category, name, now()) {}
+
+			/// Create a span that started earlier, at \p startNs given by Trace::now
+			Span(const char* category, const char* name, std::int64_t startNs) noexcept : cat {category}, spanName {name}, start {startNs} {}
+
+			Span(const Span&) = delete;
+			Span& operator=(const Span&) = delete;
+
+			~Span() {
+				threadBuffer().record(cat, spanName, start, now() - start);
+			}
+
+		private:
+			const char* cat;
+			const char* spanName;
+			std::int64_t start;
+		};
+
+		/// Get copies of the spans recorded by all threads, ordered by start time
+		std::vector<Event> collect();
+
+		/// Forget the spans recorded by all threads so far
+		void reset() noexcept;
+
+		/**
+		 * Write the recorded spans as a JSON document in the Chrome trace event format, which chrome://tracing and ui.perfetto.dev load directly
+		 * @param out - stream to write to
+		 * @param events - spans to write, by default all recorded spans
+		 */
+		void writeChromeTrace(std::ostream& out, const std::vector<Event>& events = collect());
+
+		/// Get the recorded spans as a JSON document in the Chrome trace event format, see writeChromeTrace
+		std::string chromeTrace();
+	}  // namespace Trace
+
+}  // namespace LLU
+
+#define LLU_TRACE_CONCAT_IMPL(a, b) a##b
+#define LLU_TRACE_CONCAT(a, b) LLU_TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * @def     LLU_TRACE_SCOPE(category, name)
+ * Record the rest of the enclosing block as a span with given category and name. Expands to nothing without LLU_TRACING.
+ *
+ * @def     LLU_TRACE_SPAN_SINCE(category, name, startNs)
+ * Record a span that started at \p startNs (see LLU::Trace::now) and ends with the enclosing block. Expands to nothing without LLU_TRACING,
+ * in which case the arguments are not evaluated.
+ */
+#ifdef LLU_TRACING
+#define LLU_TRACE_SCOPE(category, name) const LLU::Trace::Span LLU_TRACE_CONCAT(llu_traceSpan_, __LINE__) {category, name}
+#define LLU_TRACE_SPAN_SINCE(category, name, startNs) const LLU::Trace::Span LLU_TRACE_CONCAT(llu_traceSpan_, __LINE__) {category, name, startNs}
+#else
+#define LLU_TRACE_SCOPE(category, name) static_cast<void>(0)
+#define LLU_TRACE_SPAN_SINCE(category, name, startNs) static_cast<void>(0)
+#endif
+
+#endif	  // LLU_TRACING_H
@@ -119,7 +119,7 @@ namespace LLU::Argument {
 	template<MArgumentType T>
 	WrapperType<T> toWrapperType(const CType<T>& value) {
 		if constexpr (T == MArgumentType::Complex) {
-			return {value->ri[0], value->ri[1]};
+			return {value.ri[0], value.ri[1]};
 		} else if constexpr (T == MArgumentType::UTF8String) {
 			return {value};
 		} else if constexpr (ContainerTypeQ<T>) {
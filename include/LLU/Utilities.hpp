@@ -9,8 +9,12 @@
 #ifndef LLU_UTILITIES_HPP
 #define LLU_UTILITIES_HPP
 
+#include <algorithm>
+#include <array>
 #include <complex>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <type_traits>
 #include <utility>
 #include <variant>
@@ -56,6 +60,13 @@ namespace LLU {
 	template<typename Container>
 	using enable_if_integral_elements = typename std::enable_if_t<std::is_integral<typename std::remove_reference_t<Container>::value_type>::value>;
 
+	/**
+	 * @brief 	Utility type that is valid only for a non-empty list of integral types (and therefore can be used as coordinates of an MArray element)
+	 * @tparam	Indices - types of the coordinates
+	 */
+	template<typename... Indices>
+	using enable_if_integral_indices = typename std::enable_if_t<(sizeof...(Indices) > 0) && (std::is_integral_v<Indices> && ...)>;
+
 	template<typename Container, typename = std::void_t<>>
 	struct has_value_type : std::false_type {};
 
@@ -75,6 +86,27 @@ namespace LLU {
 	template<typename Container>
 	inline constexpr bool has_size_v = has_size<Container>::value;
 
+	template<typename Container, typename = std::void_t<>>
+	struct has_reserve : std::false_type {};
+
+	template<typename Container>
+	struct has_reserve<Container, std::void_t<decltype(std::declval<Container&>().reserve(std::size_t {}))>> : std::true_type {};
+
+	/// A type trait to check whether type \p Container has a member function \c reserve(std::size_t)
+	template<typename Container>
+	inline constexpr bool has_reserve_v = has_reserve<Container>::value;
+
+	template<typename Container, typename = std::void_t<>>
+	struct has_emplace_back : std::false_type {};
+
+	template<typename Container>
+	struct has_emplace_back<Container, std::void_t<decltype(std::declval<Container&>().emplace_back(std::declval<typename Container::value_type>()))>>
+		: std::true_type {};
+
+	/// A type trait to check whether type \p Container has a member function \c emplace_back()
+	template<typename Container>
+	inline constexpr bool has_emplace_back_v = has_emplace_back<Container>::value;
+
 	template<typename Container, typename = std::void_t<>>
 	struct is_iterable : std::false_type {};
 
@@ -302,6 +334,86 @@ namespace LLU {
 	inline constexpr mint TensorType<std::complex<double>> = MType_Complex;
 	/// @endcond
 
+	/// Tag type that carries type T, used to call generic lambdas with a type selected at runtime
+	template<typename T>
+	struct TypeTag {
+		using type = T;
+	};
+
+	/// Compile-time list of types, used to restrict the set of element types for which an operation on containers is instantiated
+	template<typename... Ts>
+	struct TypeList {};
+
+	/// All element types of NumericArray
+	using NumericArrayTypes = TypeList<std::int8_t, std::uint8_t, std::int16_t, std::uint16_t, std::int32_t, std::uint32_t, std::int64_t, std::uint64_t,
+									   float, double, std::complex<float>, std::complex<double>>;
+
+	/// All element types of Tensor
+	using TensorTypes = TypeList<mint, double, std::complex<double>>;
+
+	namespace Detail {
+		/// Maps C++ types to MNumericArray type codes for TypeDispatcher
+		struct NumericArrayTypeCode {
+			template<typename T>
+			static constexpr std::size_t value = static_cast<std::size_t>(NumericArrayType<T>);
+		};
+
+		/// Maps C++ types to MTensor type codes for TypeDispatcher
+		struct TensorTypeCode {
+			template<typename T>
+			static constexpr std::size_t value = static_cast<std::size_t>(TensorType<T>);
+		};
+
+		/**
+		 * @brief   Table-based dispatch from a runtime type code to a function instantiated for the corresponding C++ type.
+		 * @details For each callable type F a table of function pointers indexed by type code is built at compile time, so a dispatch is a bounds
+		 *          check and an indirect call, and F is only instantiated for the types in the list.
+		 * @tparam  Codes - class with a static variable template \c value mapping types to type codes, e.g. NumericArrayTypeCode
+		 * @tparam  Types - TypeList of supported types
+		 */
+		template<class Codes, class Types>
+		struct TypeDispatcher;
+
+		template<class Codes, typename T0, typename... Ts>
+		struct TypeDispatcher<Codes, TypeList<T0, Ts...>> {
+			static_assert(Codes::template value<T0> != 0 && ((Codes::template value<Ts> != 0) && ...), "Type list contains unsupported element types.");
+
+			template<typename F>
+			using Result = std::invoke_result_t<F&, TypeTag<T0>>;
+
+			/**
+			 * @brief   Call \p f with TypeTag<T> where T is the type with given type code
+			 * @param   code - runtime type code
+			 * @param   f - callable that takes a TypeTag of any type from the list, all calls must have the same return type
+			 * @param   onUnsupported - callable invoked if \p code does not correspond to any type from the list, it must throw
+			 * @return  result of calling \p f
+			 */
+			template<typename F, typename OnUnsupported>
+			static Result<F> dispatch(std::size_t code, F& f, OnUnsupported&& onUnsupported) {
+				static_assert((std::is_same_v<Result<F>, std::invoke_result_t<F&, TypeTag<Ts>>> && ...),
+							  "Operation must return the same type for all element types.");
+				using Thunk = Result<F> (*)(F&);
+				static constexpr std::size_t size = std::max({Codes::template value<T0>, Codes::template value<Ts>...}) + 1;
+				static constexpr std::array<Thunk, size> table = [] {
+					std::array<Thunk, size> t {};
+					t[Codes::template value<T0>] = &call<F, T0>;
+					((t[Codes::template value<Ts>] = &call<F, Ts>), ...);
+					return t;
+				}();
+				if (code >= size || table[code] == nullptr) {
+					std::forward<OnUnsupported>(onUnsupported)();
+				}
+				return table[code](f);
+			}
+
+		private:
+			template<typename F, typename T>
+			static Result<F> call(F& f) {
+				return std::invoke(f, TypeTag<T> {});
+			}
+		};
+	}  // namespace Detail
+
 } /* namespace LLU */
 
 #endif	  // LLU_UTILITIES_HPP
@@ -7,9 +7,12 @@
 #ifndef LLU_WSTP_GET_H_
 #define LLU_WSTP_GET_H_
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "wstp.h"
 
@@ -32,6 +35,23 @@ namespace LLU::WS {
 	template<typename T>
 	using ArrayData = std::unique_ptr<T[], ReleaseArray<T>>;
 
+	/**
+	 * @struct 	ListSpan
+	 * @brief	Caller-provided storage for a List received with WSStream::operator>>.
+	 *
+	 * Use it to receive lists into preallocated memory, for instance a buffer reused between calls, instead of allocating a new container each time.
+	 * @tparam 	T - list element type, it must be supported by WSGet*List
+	 */
+	template<typename T>
+	struct ListSpan {
+		/// Beginning of the storage
+		T* data;
+		/// Number of elements that fit in the storage
+		std::size_t capacity;
+		/// Number of elements received, set by WSStream::operator>>
+		std::size_t length = 0;
+	};
+
 	template<typename T>
 	struct GetArray {
 		using Func = std::function<int(WSLINK, T**, int**, char***, int*)>;
@@ -45,6 +65,28 @@ namespace LLU::WS {
 			return {rawResult, ReleaseArray<T> {m, dims, heads, rank}};
 		}
 
+		/**
+		 * @brief	Receive an array into caller-provided storage, the buffer allocated by WSTP is released right after the data is copied.
+		 * @param 	m - WSTP link
+		 * @param 	out - storage for the elements
+		 * @param 	capacity - number of elements that fit in \p out
+		 * @param 	dims - vector to which the dimensions of the array will be assigned, its capacity is reused
+		 * @throws 	ErrorName::WSGetArrayError if the array could not be read or if it has more than \p capacity elements
+		 */
+		static void get(WSLINK m, T* out, std::size_t capacity, std::vector<int>& dims) {
+			auto array = get(m);
+			const auto& info = array.get_deleter();
+			dims.assign(info.getDims(), info.getDims() + info.getRank());
+			std::size_t count = 1;
+			for (auto d : dims) {
+				count *= static_cast<std::size_t>(d);
+			}
+			if (count > capacity) {
+				Detail::throwLLUException(ErrorName::WSGetArrayError, "Array of " + std::to_string(count) + " elements does not fit in the buffer");
+			}
+			std::copy_n(array.get(), count, out);
+		}
+
 	private:
 		static const std::string ArrayFName;
 		static Func ArrayF;
@@ -61,6 +103,35 @@ namespace LLU::WS {
 			return {rawResult, ReleaseList<T> {m, len}};
 		}
 
+		/**
+		 * @brief	Receive a list into caller-provided storage, the buffer allocated by WSTP is released right after the data is copied.
+		 * @param 	m - WSTP link
+		 * @param 	out - storage for the elements
+		 * @param 	capacity - number of elements that fit in \p out
+		 * @return	length of the received list
+		 * @throws 	ErrorName::WSGetListError if the list could not be read or if it is longer than \p capacity
+		 */
+		static std::size_t get(WSLINK m, T* out, std::size_t capacity) {
+			auto list = get(m);
+			auto length = static_cast<std::size_t>(list.get_deleter().getLength());
+			if (length > capacity) {
+				Detail::throwLLUException(ErrorName::WSGetListError, "List of " + std::to_string(length) + " elements does not fit in the buffer");
+			}
+			std::copy_n(list.get(), length, out);
+			return length;
+		}
+
+		/**
+		 * @brief	Receive a list into a vector, reusing the capacity of the vector, so that receiving lists of similar length repeatedly does not allocate
+		 * @param 	m - WSTP link
+		 * @param 	out - vector to which the list will be assigned
+		 * @throws 	ErrorName::WSGetListError if the list could not be read
+		 */
+		static void get(WSLINK m, std::vector<T>& out) {
+			auto list = get(m);
+			out.assign(list.get(), list.get() + list.get_deleter().getLength());
+		}
+
 	private:
 		static const std::string ListFName;
 		static Func ListF;
@@ -8,7 +8,9 @@
 #define LLU_WSTP_STRINGS_H_
 
 #include <algorithm>
+#include <cstddef>
 #include <functional>
+#include <iterator>
 #include <memory>
 
 #include "wstp.h"
@@ -34,6 +36,17 @@ namespace LLU::WS {
 		extern bool useFastUTF8;
 	} // namespace EncodingConfig
 
+	namespace Detail {
+		/**
+		 * @brief	Check if a string has only ASCII characters, i.e. none of its bytes has the highest bit set
+		 * @param 	strData - string data
+		 * @param 	len - length of the string in bytes
+		 * @return	true iff all bytes of the string are ASCII characters
+		 * @note	Large strings are scanned 64 bytes at a time with SSE2 or NEON instructions where available
+		 */
+		bool allASCIIQ(const unsigned char* strData, std::size_t len) noexcept;
+	}  // namespace Detail
+
 	template<Encoding E>
 	struct ReleaseString;
 
@@ -74,6 +87,35 @@ namespace LLU::WS {
 			Detail::checkError(m, Put(m, expectedStr, len), ErrorName::WSPutStringError, PutFName);
 		}
 
+		/**
+		 * @brief	Send a sequence of strings as a List
+		 * @tparam	Range - any range of std::basic_string with character type compatible with the encoding
+		 * @param 	m - WSTP link
+		 * @param 	strings - strings to be sent
+		 *
+		 * For UTF8 the decision between WSPutByteString and WSPutUTF8String is made directly for each string in the loop,
+		 * which saves a lot of overhead when millions of short strings are sent.
+		 */
+		template<class Range>
+		static void putList(WSLINK m, const Range& strings) {
+			auto count = static_cast<int>(std::distance(std::cbegin(strings), std::cend(strings)));
+			Detail::checkError(m, WSPutFunction(m, "List", count), ErrorName::WSPutFunctionError, "WSPutFunction");
+			for (const auto& s : strings) {
+				static_assert(CharacterTypesCompatible<E, typename remove_cv_ref<decltype(s)>::value_type>,
+							  "Character type does not match the encoding in WS::String<E>::putList");
+				// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): sorry :(
+				auto* expectedStr = reinterpret_cast<const CharT*>(s.data());
+				auto len = static_cast<int>(s.size());
+				if constexpr (E == Encoding::UTF8) {
+					auto status = (EncodingConfig::useFastUTF8 && Detail::allASCIIQ(expectedStr, s.size())) ? WSPutByteString(m, expectedStr, len)
+																											  : WSPutUTF8String(m, expectedStr, len);
+					Detail::checkError(m, status, ErrorName::WSPutStringError, PutFName);
+				} else {
+					Detail::checkError(m, Put(m, expectedStr, len), ErrorName::WSPutStringError, PutFName);
+				}
+			}
+		}
+
 		static StringData<E> get(WSLINK m) {
 			const CharT* rawResult {};
 			int bytes {};
@@ -202,18 +244,11 @@ namespace LLU::WS {
 	template<>
 	const std::string String<Encoding::Byte>::PutFName = "WSPutByteString";
 
-	namespace {
-		// Nested lambdas are too much for MSVC, so we define this helper function separately
-		bool allASCIIQ(const unsigned char* strData, int len) {
-			return std::all_of(strData, strData + len, [](unsigned char c) -> bool { return c <= 127; });
-		}
-	}
-
 	template<>
 	GetStringFuncT<CharType<Encoding::UTF8>> String<Encoding::UTF8>::Get = WSGetUTF8String;
 	template<>
 	PutStringFuncT<CharType<Encoding::UTF8>> String<Encoding::UTF8>::Put = [](WSLINK m, const unsigned char* strData, int len) -> int {
-		if (EncodingConfig::useFastUTF8 && allASCIIQ(strData, len)) {
+		if (EncodingConfig::useFastUTF8 && Detail::allASCIIQ(strData, static_cast<std::size_t>(len))) {
 			return WSPutByteString(m, strData, len);
 		} else {
 			return WSPutUTF8String(m, strData, len);
@@ -9,6 +9,8 @@
 
 #include <cstring>
 #include <string>
+#include <tuple>
+#include <utility>
 
 #include "wstp.h"
 
@@ -156,6 +158,70 @@ namespace LLU {
 			std::string reason;
 		};
 
+		/**
+		 * @struct 	Expr
+		 * @brief	Expression with a fixed shape: a head given as a string literal and arguments known at compile time.
+		 *
+		 * Sending an Expr via WSStream is a straight sequence of WSPut* calls: the argument count is computed at compile time, the head is passed
+		 * to WSPutFunction without creating a std::string and no loopback links are involved. Use WS::expr, WS::rule or WS::list to create Exprs.
+		 * Arguments passed as lvalues are stored by reference, so an Expr should normally be sent in the same statement in which it is created.
+		 *
+		 * @tparam	Args - types of arguments, any types that can be sent via WSStream, including other Exprs
+		 */
+		template<typename... Args>
+		struct Expr {
+			/// Number of arguments of the expression
+			static constexpr int argc = static_cast<int>(sizeof...(Args));
+
+			/// Head of the expression, must point to a null-terminated string that outlives the Expr, typically a string literal
+			const char* head;
+
+			/// Arguments of the expression
+			std::tuple<Args...> args;
+		};
+
+		/**
+		 * @brief	Create an expression with given head and arguments
+		 * @param 	head - head of the expression, typically a string literal
+		 * @param 	args - arguments of the expression
+		 * @return	Expr that can be sent via WSStream
+		 */
+		template<typename... Args>
+		constexpr Expr<Args...> expr(const char* head, Args&&... args) {
+			return {head, std::tuple<Args...>(std::forward<Args>(args)...)};
+		}
+
+		/**
+		 * @brief	Create a List with given elements
+		 * @param 	args - elements of the List
+		 * @return	Expr that can be sent via WSStream
+		 */
+		template<typename... Args>
+		constexpr Expr<Args...> list(Args&&... args) {
+			return expr("List", std::forward<Args>(args)...);
+		}
+
+		/**
+		 * @brief	Create a Rule
+		 * @param 	lhs - left hand side of the Rule
+		 * @param 	rhs - right hand side of the Rule
+		 * @return	Expr that can be sent via WSStream
+		 */
+		template<typename L, typename R>
+		constexpr Expr<L, R> rule(L&& lhs, R&& rhs) {
+			return expr("Rule", std::forward<L>(lhs), std::forward<R>(rhs));
+		}
+
+		/**
+		 * @brief	Create an Association from Rules, typically created with WS::rule
+		 * @param 	rules - elements of the Association
+		 * @return	Expr that can be sent via WSStream
+		 */
+		template<typename... Rules>
+		constexpr Expr<Rules...> association(Rules&&... rules) {
+			return expr("Association", std::forward<Rules>(rules)...);
+		}
+
 		namespace Detail {
 			/**
 			 * @brief 		Checks if WSTP operation was successful and throws appropriate exception otherwise
@@ -243,10 +309,11 @@ namespace LLU {
 		 */
 		template<WS::Encoding EIn, WS::Encoding EOut>
 		WSStream<EIn, EOut>& Rule(WSStream<EIn, EOut>& ms, Direction dir) {
+			static const Function rule {"Rule", 2};
 			if (dir == Direction::Put) {
-				return ms << Function("Rule", 2);
+				return ms << rule;
 			}
-			return ms >> Function("Rule", 2);
+			return ms >> rule;
 		}
 
 		/**
@@ -259,12 +326,23 @@ namespace LLU {
 		 */
 		template<WS::Encoding EIn, WS::Encoding EOut>
 		WSStream<EIn, EOut>& Null(WSStream<EIn, EOut>& ms, Direction dir) {
+			static const Symbol null {"Null"};
 			if (dir == Direction::Put) {
-				return ms << Symbol("Null");
+				return ms << null;
 			}
-			return ms >> Symbol("Null");
+			return ms >> null;
 		}
 
+		/**
+		 * @brief   Ways in which WSStream can send expressions of unknown length, i.e. expressions started with WS::BeginExpr
+		 *
+		 * In the Loopback mode every expression started with BeginExpr stores its arguments in a separate loopback link and EndExpr moves them
+		 * to the parent link. In the Buffered mode only the outermost expression uses a loopback link, all nested expressions are recorded by WSStream
+		 * as a tree of heads and argument counts, and the whole expression is sent to the parent link in a single pass when it ends. The Buffered mode is
+		 * considerably faster for deeply nested expressions of unknown length, but all arguments must be sent with WSStream::operator<<.
+		 */
+		enum class ExprMode : bool { Loopback, Buffered };
+
 		/**
 		 * @struct BeginExpr
 		 * A token for the WSStream to indicate that we will be sending an expression which length is not known beforehand
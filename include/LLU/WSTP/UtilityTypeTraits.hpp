@@ -7,7 +7,10 @@
 #ifndef LLU_WSTP_UTILITYTYPETRAITS_HPP_
 #define LLU_WSTP_UTILITYTYPETRAITS_HPP_
 
+#include <iterator>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 #include "wstp.h"
 
@@ -41,6 +44,80 @@ namespace LLU::WS {
 	template<typename T>
 	inline constexpr bool ScalarSupportedTypeQ = supportedInWSArithmeticQ<remove_cv_ref<T>>;
 
+	/// @cond
+	namespace Detail {
+		template<typename T, typename U>
+		inline constexpr bool sameIntegerRepresentationQ =
+			std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) == sizeof(U) && std::is_signed_v<T> == std::is_signed_v<U>;
+
+		template<typename T>
+		constexpr auto arrayElementType() {
+			if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+				return T {};
+			} else if constexpr (sameIntegerRepresentationQ<T, unsigned char>) {
+				return static_cast<unsigned char>(0);
+			} else if constexpr (sameIntegerRepresentationQ<T, short>) {
+				return static_cast<short>(0);
+			} else if constexpr (sameIntegerRepresentationQ<T, int>) {
+				return 0;
+			} else if constexpr (sameIntegerRepresentationQ<T, wsint64>) {
+				return static_cast<wsint64>(0);
+			}
+		}
+	}  // namespace Detail
+	/// @endcond
+
+	/**
+	 * @brief	Type supported by WSPut*Array and WSGet*Array that has the same binary representation as T, or void if WSTP cannot transfer arrays of T
+	 * 			without converting the elements. For example, ArrayElementType<std::uint8_t> is unsigned char and ArrayElementType<mint> is wsint64.
+	 * @tparam	T - any type
+	 */
+	template<typename T>
+	using ArrayElementType = decltype(Detail::arrayElementType<remove_cv_ref<T>>());
+
+	/// @cond
+	namespace Detail {
+		template<typename Iterator>
+		constexpr bool contiguousScalarIteratorQ() {
+			if constexpr (std::is_pointer_v<Iterator>) {
+				return ScalarSupportedTypeQ<std::remove_pointer_t<Iterator>>;
+			} else {
+				using V = typename std::iterator_traits<Iterator>::value_type;
+				if constexpr (ScalarSupportedTypeQ<V>) {
+					return std::is_same_v<Iterator, typename std::vector<V>::iterator> || std::is_same_v<Iterator, typename std::vector<V>::const_iterator>;
+				} else {
+					return false;
+				}
+			}
+		}
+	}  // namespace Detail
+	/// @endcond
+
+	/**
+	 * @brief	Utility trait that determines whether a range [begin, end) of iterators of type Iterator occupies contiguous memory and holds elements
+	 * 			supported by WSPut*List, so that it can be sent in a single call. This is true for pointers, in particular for iterators of LLU containers
+	 * 			and of std::array on most platforms, and for iterators of std::vector.
+	 * @tparam	Iterator - any iterator type
+	 */
+	template<typename Iterator>
+	inline constexpr bool ContiguousScalarIteratorQ = Detail::contiguousScalarIteratorQ<Iterator>();
+
+	/**
+	 * @brief	Utility trait that determines whether Container has data() and size() members and data() points to elements supported by WSPut*List,
+	 * 			e.g. std::array<double, N>, Tensor<mint> or NumericArray<float>
+	 * @tparam	Container - any type
+	 */
+	template<typename Container, typename = void>
+	inline constexpr bool ContiguousScalarContainerQ = false;
+
+	/// @cond
+	template<typename Container>
+	inline constexpr bool ContiguousScalarContainerQ<Container, std::void_t<decltype(std::declval<const Container&>().data()),
+																		   decltype(std::declval<const Container&>().size())>> =
+		std::is_pointer_v<decltype(std::declval<const Container&>().data())> &&
+		ScalarSupportedTypeQ<std::remove_pointer_t<decltype(std::declval<const Container&>().data())>>;
+	/// @endcond
+
 	/**
 	 * @brief	Utility trait that determines whether type T is a suitable character type for WSPut*String and WSGet*String
 	 * @tparam	T - any type
@@ -63,6 +140,18 @@ namespace LLU::WS {
 	template<typename T>
 	inline constexpr bool StringTypeQ = supportedInWSStringQ<remove_cv_ref<T>>;
 
+	/**
+	 * @brief	Utility trait that determines whether type T is a std::basic_string with a character type supported in WSPut*String
+	 * @tparam	T - any type
+	 */
+	template<typename T>
+	inline constexpr bool BasicStringTypeQ = false;
+
+	/// @cond
+	template<typename T>
+	inline constexpr bool BasicStringTypeQ<std::basic_string<T>> = StringTypeQ<T>;
+	/// @endcond
+
 }  // namespace LLU::WS
 
 #endif /* LLU_WSTP_UTILITYTYPETRAITS_HPP_ */
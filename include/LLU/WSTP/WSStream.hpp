@@ -8,16 +8,20 @@
 #define LLU_WSTP_WSSTREAM_HPP_
 
 #include <algorithm>
+#include <cstdint>
 #include <iterator>
+#include <limits>
 #include <map>
-#include <stack>
+#include <memory>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "wstp.h"
 
 #include "LLU/ErrorLog/Errors.h"
+#include "LLU/Tracing.h"
 #include "LLU/Utilities.hpp"
 
 #include "LLU/WSTP/Get.h"
@@ -28,6 +32,12 @@
 
 namespace LLU {
 
+	template<typename T>
+	class Tensor;
+
+	template<typename T>
+	class NumericArray;
+
 	/**
 	 * @class 	WSStream
 	 * @brief 	Wrapper class over WSTP with a stream-like interface.
@@ -72,17 +82,39 @@ namespace LLU {
 
 		/**
 		 *   @brief Returns a reference to underlying low-level WSTP handle
+		 *   @note  If an expression started with WS::BeginExpr is active, WSStream can no longer tell how many arguments it has and must count them
+		 *          when the expression ends
 		 **/
 		WSLINK& get() noexcept {
+			if (exprStack.size() > 1) {
+				exprStack.back().tracked = false;
+			}
 			return m;
 		}
 
+		/**
+		 *   @brief Get the way in which expressions of unknown length are sent
+		 **/
+		WS::ExprMode getExprMode() const noexcept {
+			return exprMode;
+		}
+
+		/**
+		 *   @brief         Set the way in which expressions started with WS::BeginExpr are sent, the new mode applies to expressions started afterwards
+		 *   @param[in]     mode - new mode
+		 *   @see           WS::ExprMode
+		 **/
+		void setExprMode(WS::ExprMode mode) noexcept {
+			exprMode = mode;
+		}
+
 		/**
 		 *   @brief			Sends any range as List
 		 *   @tparam		InputIterator - type that is an iterator
 		 *   @param[in] 	begin - iterator to the first element of the range
 		 *	 @param[in] 	end - iterator past the last element of the range
 		 *
+		 *   @note			Contiguous ranges of scalars supported by WSTP, see WS::ContiguousScalarIteratorQ, are sent with a single call to WSPut*List.
 		 **/
 		template<typename Iterator, typename = enable_if_input_iterator<Iterator>>
 		void sendRange(Iterator begin, Iterator end);
@@ -94,10 +126,42 @@ namespace LLU {
 		 *	 @param[in] 	end - iterator past the last element of the range
 		 *	 @param[in]		head - head of the top-level expression
 		 *
+		 *   @note			Contiguous ranges of scalars supported by WSTP, see WS::ContiguousScalarIteratorQ, are sent with a single call to WSPut*Array.
 		 **/
 		template<typename Iterator, typename = enable_if_input_iterator<Iterator>>
 		void sendRange(Iterator begin, Iterator end, const std::string& head);
 
+		/**
+		 *   @brief			Sends a flat array of \p length elements as a List of chunks, i.e. flat Lists of at most \p chunkSize elements each
+		 *   @tparam		T - element type, WS::ArrayElementType<T> must not be void
+		 *   @tparam		Producer - function void(T* buffer, mint offset, mint count) that writes \p count elements, starting at flat
+		 *   				position \p offset of the array, to \p buffer
+		 *   @param[in] 	length - total number of elements
+		 *   @param[in] 	chunkSize - maximal number of elements in a chunk
+		 *   @param[in] 	producer - function that computes consecutive chunks of the array
+		 *   @throws 		ErrorName::WSPutListError
+		 *
+		 *   @note			Only one chunk is held in memory at a time, so arrays of any size can be sent in constant memory. In the Wolfram Language
+		 *   				the result can be turned into a single List with Join @@ result.
+		 **/
+		template<typename T, class Producer>
+		void sendChunked(mint length, mint chunkSize, Producer&& producer);
+
+		/**
+		 *   @brief			Receives a List of flat Lists, e.g. created with Partition[data, UpTo[n]], and passes the chunks to \p consumer one by one
+		 *   @tparam		T - element type, WS::ArrayElementType<T> must not be void
+		 *   @tparam		Consumer - function void(const T* data, mint offset, mint count) that processes \p count elements starting at flat
+		 *   				position \p offset of the whole array
+		 *   @param[in] 	consumer - function that processes consecutive chunks of the array
+		 *   @return		total number of elements received
+		 *   @throws 		ErrorName::WSTestHeadError
+		 *   @throws 		ErrorName::WSGetListError
+		 *
+		 *   @note			Each chunk is released as soon as \p consumer returns.
+		 **/
+		template<typename T, class Consumer>
+		mint receiveChunked(Consumer&& consumer);
+
 	public:
 		/// Type of elements that can be sent via WSTP with no arguments, for example WS::Flush
 		using StreamToken = WSStream& (*)(WSStream&);
@@ -105,7 +169,7 @@ namespace LLU {
 		/// Type of elements that can be either sent or received via WSTP with no arguments, for example WS::Rule
 		using BidirStreamToken = WSStream& (*)(WSStream&, WS::Direction);
 
-		/// Type of data stored on the stack to facilitate sending expressions of a priori unknown length
+		/// Pair of an expression head and the loopback link that stores arguments of an expression of a priori unknown length
 		using LoopbackData = std::pair<std::string, WSLINK>;
 
 		//
@@ -148,9 +212,20 @@ namespace LLU {
 		 **/
 		WSStream& operator<<(const WS::Missing& f);
 
+		/**
+		 *   @brief			Sends an expression with a fixed shape, argument count is known at compile time
+		 *   @tparam		Args - types of the expression arguments
+		 *   @param[in] 	e - expression created with WS::expr, WS::rule, WS::list, etc.
+		 *   @see 			WS::Expr
+		 *   @throws 		ErrorName::WSPutFunctionError
+		 **/
+		template<typename... Args>
+		WSStream& operator<<(const WS::Expr<Args...>& e);
+
 		/**
 		 * @brief		Starts sending a new expression where the number of arguments is not known a priori
 		 * @param[in]	expr - object of class BeginExpr that stores expression head as string
+		 * @see         WS::ExprMode
 		 */
 		WSStream& operator<<(const WS::BeginExpr& expr);
 
@@ -193,6 +268,24 @@ namespace LLU {
 		template<typename T>
 		WSStream& operator<<(const WS::ArrayData<T>& a);
 
+		/**
+		 *   @brief			Sends a Tensor as a WSTP array, elements are passed to WSPut*Array straight from the memory of the Tensor
+		 *   @tparam		T - Tensor element type, WS::ArrayElementType<T> must not be void
+		 *   @param[in] 	t - Tensor to be sent
+		 *   @throws 		ErrorName::WSPutArrayError
+		 **/
+		template<typename T>
+		WSStream& operator<<(const Tensor<T>& t);
+
+		/**
+		 *   @brief			Sends a NumericArray as a WSTP array, elements are passed to WSPut*Array straight from the memory of the NumericArray
+		 *   @tparam		T - NumericArray element type, WS::ArrayElementType<T> must not be void
+		 *   @param[in] 	na - NumericArray to be sent
+		 *   @throws 		ErrorName::WSPutArrayError
+		 **/
+		template<typename T>
+		WSStream& operator<<(const NumericArray<T>& na);
+
 		/**
 		 *   @brief			Sends a WSTP list
 		 *   @tparam		T - list element type
@@ -215,7 +308,7 @@ namespace LLU {
 
 		/**
 		 *   @brief			Sends a std::vector via WSTP, it is interpreted as a List in Mathematica
-		 *   @tparam		T - vector element type (types supported in WSPut*List will be handled more efficiently)
+		 *   @tparam		T - vector element type (types supported in WSPut*List and strings will be handled more efficiently)
 		 *   @param[in] 	l - std::vector to be sent
 		 *
 		 *   @throws 		ErrorName::WSPutListError
@@ -298,6 +391,28 @@ namespace LLU {
 		template<typename K, typename V>
 		WSStream& operator<<(const std::map<K, V>& map);
 
+		/**
+		 *   @brief			Sends a std::unordered_map via WSTP, it is translated to an Association in Mathematica
+		 *   @tparam		K - map key type, must be supported in WSStream
+		 *   @tparam		V - map value type, must be supported in WSStream
+		 *   @param[in] 	map - map to be sent as Association
+		 *
+		 *   @throws 		ErrorName::WSPutFunctionError plus whatever can be thrown sending keys and values
+		 **/
+		template<typename K, typename V>
+		WSStream& operator<<(const std::unordered_map<K, V>& map);
+
+		/**
+		 *   @brief			Sends a flat map, i.e. a std::vector of key-value pairs, via WSTP, it is translated to an Association in Mathematica
+		 *   @tparam		K - key type, must be supported in WSStream
+		 *   @tparam		V - value type, must be supported in WSStream
+		 *   @param[in] 	map - vector of pairs to be sent as Association
+		 *
+		 *   @throws 		ErrorName::WSPutFunctionError plus whatever can be thrown sending keys and values
+		 **/
+		template<typename K, typename V>
+		WSStream& operator<<(const std::vector<std::pair<K, V>>& map);
+
 		/**
 		 *   @brief			Sends a scalar value (int, float, double, etc) if it is supported by WSTP
 		 *   If you need to send value of type not supported by WSTP (like unsigned int) you must either explicitly cast
@@ -318,11 +433,17 @@ namespace LLU {
 		 *   @throws 		ErrorName::WSPutContainerError
 		 *
 		 *   @note			Size() is not technically necessary, but needed for performance reason. Most STL containers have size() anyway.
+		 *   				Containers with data() pointing to scalars supported by WSTP, e.g. std::array<double, N>, are sent with a single call
+		 *   				to WSPut*List.
 		 **/
 		template<typename Container, typename = std::void_t<
 										 decltype(std::declval<Container>().begin(), std::declval<Container>().end(), std::declval<Container>().size())>>
 		WSStream& operator<<(const Container& c) {
-			sendRange(c.begin(), c.end());
+			if constexpr (WS::ContiguousScalarContainerQ<Container>) {
+				putContiguous(c.data(), static_cast<int>(c.size()), "List");
+			} else {
+				sendRange(c.begin(), c.end());
+			}
 			return *this;
 		}
 
@@ -408,6 +529,26 @@ namespace LLU {
 		template<typename T>
 		WSStream& operator>>(WS::ArrayData<T>& a);
 
+		/**
+		 *   @brief			Receives a WSTP array into a new Tensor, which is filled directly from the buffer returned by WSGet*Array
+		 *   @tparam		T - Tensor element type, WS::ArrayElementType<T> must not be void
+		 *   @param[out] 	t - argument to which the new Tensor will be assigned
+		 *   @throws 		ErrorName::WSGetArrayError
+		 *   @note			Tensor.h must be included to use this operator
+		 **/
+		template<typename T>
+		WSStream& operator>>(Tensor<T>& t);
+
+		/**
+		 *   @brief			Receives a WSTP array into a new NumericArray, which is filled directly from the buffer returned by WSGet*Array
+		 *   @tparam		T - NumericArray element type, WS::ArrayElementType<T> must not be void
+		 *   @param[out] 	na - argument to which the new NumericArray will be assigned
+		 *   @throws 		ErrorName::WSGetArrayError
+		 *   @note			NumericArray.h must be included to use this operator
+		 **/
+		template<typename T>
+		WSStream& operator>>(NumericArray<T>& na);
+
 		/**
 		 *   @brief			Receives a WSTP list
 		 *   @tparam		T - list element type
@@ -425,10 +566,22 @@ namespace LLU {
 		 *   @param[out] 	l - argument to which the List received from WSTP will be assigned
 		 *
 		 *   @throws 		ErrorName::WSGetListError
+		 *   @note			For element types supported by WSGet*List the capacity of \p l is reused, so receiving lists into the same vector over and over
+		 *   				does not allocate once it is large enough. Other lists are received into a new vector, \p l is not modified if receiving fails.
 		 **/
 		template<typename T>
 		WSStream& operator>>(std::vector<T>& l);
 
+		/**
+		 *   @brief			Receives a List from WSTP into caller-provided storage
+		 *   @tparam		T - list element type, must be supported by WSGet*List
+		 *   @param[in,out] l - storage for the list, its length member is set to the length of the received list
+		 *   @see 			WS::ListSpan<T>
+		 *   @throws 		ErrorName::WSGetListError if the list could not be read or if it does not fit in the storage
+		 **/
+		template<typename T>
+		WSStream& operator>>(WS::ListSpan<T>& l);
+
 		/**
 		 *   @brief			Receives a WSTP string
 		 *   @tparam		T - string character type
@@ -477,6 +630,51 @@ namespace LLU {
 		template<typename K, typename V>
 		WSStream& operator>>(std::map<K, V>& map);
 
+		/**
+		 *   @brief			Receives a std::unordered_map via WSTP, space for all elements is reserved before they are read
+		 *   @tparam		K - map key type, must be supported in WSStream
+		 *   @tparam		V - map value type, must be supported in WSStream
+		 *   @param[out] 	map - argument to which the elements of the Association received from WSTP will be added
+		 *
+		 *   @throws 		ErrorName::WSGetFunctionError plus whatever can be thrown receiving keys and values
+		 **/
+		template<typename K, typename V>
+		WSStream& operator>>(std::unordered_map<K, V>& map);
+
+		/**
+		 *   @brief			Receives an Association via WSTP as a flat map, i.e. a std::vector of key-value pairs in the order of the Association
+		 *   @tparam		K - key type, must be supported in WSStream
+		 *   @tparam		V - value type, must be supported in WSStream
+		 *   @param[out] 	map - argument to which the elements of the Association received from WSTP will be appended
+		 *
+		 *   @throws 		ErrorName::WSGetFunctionError plus whatever can be thrown receiving keys and values
+		 **/
+		template<typename K, typename V>
+		WSStream& operator>>(std::vector<std::pair<K, V>>& map);
+
+		/**
+		 *   @brief			Sends a map with scalar keys and values as AssociationThread[keys, values], where keys and values are packed Lists
+		 *   @tparam		Map - std::map, std::unordered_map or std::vector<std::pair<K, V>> where WS::ArrayElementType of both K and V is not void
+		 *   @param[in] 	map - map to be sent
+		 *
+		 *   @throws 		ErrorName::WSPutListError
+		 *   @note			The expression evaluates to an Association in the Wolfram Language, so this is the fastest way to return a large lookup table
+		 *   				from a library function.
+		 **/
+		template<class Map>
+		void sendPackedAssociation(const Map& map);
+
+		/**
+		 *   @brief			Receives a List of two packed Lists, e.g. {Keys[assoc], Values[assoc]}, and adds the key-value pairs to a map
+		 *   @tparam		Map - std::map, std::unordered_map or std::vector<std::pair<K, V>> where WS::ArrayElementType of both K and V is not void
+		 *   @param[out] 	map - map to which the pairs will be added
+		 *
+		 *   @throws 		ErrorName::WSTestHeadError - if the expression on the link is not a List of length 2
+		 *   @throws 		ErrorName::WSGetListError - if the Lists cannot be read or their lengths are different
+		 **/
+		template<class Map>
+		void receivePackedAssociation(Map& map);
+
 		/**
 		 *   @brief			Receives a scalar value (int, float, double, etc) if it is supported by WSTP
 		 *   If you need to receive value of type not supported by WSTP (like unsigned int) you must either explicitly cast
@@ -494,11 +692,13 @@ namespace LLU {
 		 *   @brief			Check if the call to WSTP API succeeded, throw an exception otherwise
 		 *   @param[in] 	statusOk - error code returned from WSTP API function, usually 0 means error
 		 *   @param[in]		errorName - which exception to throw
-		 *   @param[in]		debugInfo - additional information to include in the exception, should it be thrown
+		 *   @param[in]		debugInfo - additional information to include in the exception, either a string or a function that returns a string,
+		 *   				in which case it is only evaluated if the exception is thrown
 		 *
 		 *   @throws 		errorName
 		 **/
-		void check(int statusOk, const std::string& errorName, const std::string& debugInfo = "");
+		template<typename DebugInfo = const char (&)[1]>
+		void check(int statusOk, const std::string& errorName, DebugInfo&& debugInfo = "");
 
 		/**
 		 * 	 @brief			Test if the next expression to be read from WSTP has given head
@@ -519,18 +719,126 @@ namespace LLU {
 		void testHead(const std::string& head, int argc);
 
 		/**
-		 *	@brief	Update the value of m to point to the top of loopbackStack.
+		 *	@brief	Update the value of m to point to the top of exprStack.
 		 */
 		void refreshCurrentWSLINK();
 
+		/**
+		 *	@brief	Record that a new expression with \p argc arguments has been written to the active link.
+		 *	        Atoms (symbols, numbers, strings, arrays) have 0 arguments.
+		 */
+		void recordPut(int argc = 0) noexcept;
+
+		/**
+		 *	@brief	Record that \p count complete expressions have been transferred to the active link.
+		 */
+		void recordTransferred(int count) noexcept;
+
+		/**
+		 *	@brief	Send \p length contiguous scalars as an expression with given head, with a single call to WSPut*List or WSPut*Array.
+		 */
+		template<typename T>
+		void putContiguous(const T* data, int length, const std::string& head);
+
+		/**
+		 *	@brief	Send a map as an Association of Rules.
+		 */
+		template<class Map>
+		void putAssociation(const Map& map);
+
+		/**
+		 *	@brief	Receive an Association of Rules and add its elements to a map.
+		 */
+		template<class Map>
+		void getAssociation(Map& map);
+
+		/**
+		 *	@brief	Send elements of a Tensor or NumericArray as a WSTP array without copying them.
+		 */
+		template<class Container>
+		void putContainer(const Container& c);
+
+		/**
+		 *	@brief	Receive a WSTP array into a new Tensor or NumericArray.
+		 */
+		template<class Container>
+		Container getContainer();
+
+		/**
+		 *	@brief	Send an expression recorded in Buffered mode together with all its nested expressions to the parent link.
+		 */
+		void endBufferedExpr(int nodeIndex, WSLINK args);
+
+		/**
+		 *	@brief	Move arguments of a recorded expression from \p src to \p dst, or discard them if \p dst is null.
+		 */
+		void transferBufferedArgs(int nodeIndex, WSLINK src, WSLINK dst);
+
 	private:
+		template<WS::Encoding, WS::Encoding>
+		friend class WSStream;
+
+		/// Expression that is being sent, the bottom of exprStack corresponds to the link passed to the constructor.
+		struct ExprLevel {
+			/// Head of the expression
+			std::string head;
+
+			/// Link to which arguments of the expression are written
+			WSLINK link;
+
+			/// Index of the node in exprBuffer which describes the expression, or -1 if the expression is not recorded
+			int node = -1;
+
+			/// Whether the link has been created for this expression, nested expressions recorded in Buffered mode use the link of their parent
+			bool ownsLink = true;
+
+			/// Number of arguments started so far
+			int argc = 0;
+
+			/// Number of expressions still missing to complete the most recent argument
+			int pending = 0;
+
+			/// False if the link has been accessed directly, in which case argc may be inaccurate
+			bool tracked = true;
+
+			/// Time at which the expression was started, only measured when LLU_TRACING is defined
+			std::int64_t traceStart = 0;
+		};
+
+		/// Expression recorded in Buffered mode, its arguments are stored in the loopback link of the outermost recorded expression.
+		struct ExprNode {
+			/// Either a run of consecutive complete expressions in the loopback link or a nested recorded expression
+			struct Child {
+				int count;	  ///< number of expressions in the run
+				int node;	  ///< index of the nested expression in exprBuffer, or -1 for a run
+			};
+
+			/// Head of the expression
+			std::string head;
+
+			/// Number of arguments, known when the expression ends
+			int argc = 0;
+
+			/// Whether the expression has been dropped, in which case its arguments must be skipped
+			bool dropped = false;
+
+			/// Arguments of the expression in the order in which they were sent
+			std::vector<Child> children {};
+		};
+
 		/// Internal low-level handle to the currently active WSTP, it is assumed that the handle is valid.
 		WSLINK m {};
 
 		/// WSTP does not natively support sending expression of unknown length, so to simulate this behavior we can use a helper loopback link to store
-		/// arguments until we know how many of them there are. But to be able to send nested expressions of unknown length we need more than one helper link.
-		/// The data structure called stack seems to be the most reasonable choice.
-		std::stack<LoopbackData> loopbackStack;
+		/// arguments until we know how many of them there are. But to be able to send nested expressions of unknown length we need more than one helper link,
+		/// so the data structure called stack seems to be the most reasonable choice.
+		std::vector<ExprLevel> exprStack;
+
+		/// Expressions recorded in Buffered mode, nodes of each outermost expression are stored contiguously starting with the outermost one.
+		std::vector<ExprNode> exprBuffer;
+
+		/// The way in which expressions started with BeginExpr are sent
+		WS::ExprMode exprMode = WS::ExprMode::Loopback;
 
 		/// Boolean flag to indicate if the current expression initiated with BeginExpr has been dropped. It is needed for EndExpr to behave correctly.
 		bool currentExprDropped = false;
@@ -539,10 +847,11 @@ namespace LLU {
 /// @cond
 
 	template<WS::Encoding EIn, WS::Encoding EOut>
-	WSStream<EIn, EOut>::WSStream(WSLINK mlp) : m(mlp), loopbackStack(std::deque<LoopbackData> {{"", mlp}}) {
+	WSStream<EIn, EOut>::WSStream(WSLINK mlp) : m(mlp) {
 		if (!mlp) {
 			WS::Detail::throwLLUException(ErrorName::WSNullWSLinkError);
 		}
+		exprStack.push_back({"", mlp});
 	}
 
 	template<WS::Encoding EIn, WS::Encoding EOut>
@@ -562,19 +871,87 @@ namespace LLU {
 	template<WS::Encoding EIn, WS::Encoding EOut>
 	template<typename Iterator, typename>
 	void WSStream<EIn, EOut>::sendRange(Iterator begin, Iterator end, const std::string& head) {
-		*this << WS::Function(head, static_cast<int>(std::distance(begin, end)));
-		std::for_each(begin, end, [this](const auto& elem) { *this << elem; });
+		if constexpr (WS::ContiguousScalarIteratorQ<Iterator>) {
+			auto length = static_cast<int>(std::distance(begin, end));
+			const auto* data = length > 0 ? std::addressof(*begin) : nullptr;
+			putContiguous(data, length, head);
+		} else {
+			*this << WS::Function(head, static_cast<int>(std::distance(begin, end)));
+			std::for_each(begin, end, [this](const auto& elem) { *this << elem; });
+		}
 	}
 
 	template<WS::Encoding EIn, WS::Encoding EOut>
-	void WSStream<EIn, EOut>::check(int statusOk, const std::string& errorName, const std::string& debugInfo) {
-		WS::Detail::checkError(m, statusOk, errorName, debugInfo);
+	template<typename T>
+	void WSStream<EIn, EOut>::putContiguous(const T* data, int length, const std::string& head) {
+		using U = std::remove_cv_t<T>;
+		if (head == "List") {
+			WS::PutList<U>::put(m, data, length);
+		} else {
+			const char* heads[] = {head.c_str()};
+			WS::PutArray<U>::put(m, data, &length, heads, 1);
+		}
+		recordPut();
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<typename T, class Producer>
+	void WSStream<EIn, EOut>::sendChunked(mint length, mint chunkSize, Producer&& producer) {
+		using U = WS::ArrayElementType<T>;
+		static_assert(!std::is_void_v<U>, "WSTP cannot send lists of this element type without converting the elements.");
+		if (chunkSize <= 0 || chunkSize > (std::numeric_limits<int>::max)() || length < 0) {
+			WS::Detail::throwLLUException(ErrorName::WSPutListError,
+										  "Invalid length " + std::to_string(length) + " or chunk size " + std::to_string(chunkSize));
+		}
+		auto chunkCount = (length + chunkSize - 1) / chunkSize;
+		if (chunkCount > (std::numeric_limits<int>::max)()) {
+			WS::Detail::throwLLUException(ErrorName::WSPutListError, "Too many chunks: " + std::to_string(chunkCount));
+		}
+		*this << WS::List(static_cast<int>(chunkCount));
+		std::vector<T> buffer(static_cast<std::size_t>((std::min)(length, chunkSize)));
+		for (mint offset = 0; offset < length; offset += chunkSize) {
+			auto count = (std::min)(chunkSize, length - offset);
+			producer(buffer.data(), offset, count);
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): U has the same size and signedness as T
+			WS::PutList<U>::put(m, reinterpret_cast<const U*>(buffer.data()), static_cast<int>(count));
+			recordPut();
+		}
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<typename T, class Consumer>
+	mint WSStream<EIn, EOut>::receiveChunked(Consumer&& consumer) {
+		using U = WS::ArrayElementType<T>;
+		static_assert(!std::is_void_v<U>, "WSTP cannot receive lists of this element type without converting the elements.");
+		auto chunkCount = testHead("List");
+		mint offset = 0;
+		for (int i = 0; i < chunkCount; ++i) {
+			auto chunk = WS::GetList<U>::get(m);
+			auto count = static_cast<mint>(chunk.get_deleter().getLength());
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): U has the same size and signedness as T
+			consumer(reinterpret_cast<const T*>(chunk.get()), offset, count);
+			offset += count;
+		}
+		return offset;
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<typename DebugInfo>
+	void WSStream<EIn, EOut>::check(int statusOk, const std::string& errorName, DebugInfo&& debugInfo) {
+		if (statusOk != 0) {
+			return;
+		}
+		if constexpr (std::is_invocable_v<DebugInfo>) {
+			WS::Detail::checkError(m, statusOk, errorName, std::forward<DebugInfo>(debugInfo)());
+		} else {
+			WS::Detail::checkError(m, statusOk, errorName, std::forward<DebugInfo>(debugInfo));
+		}
 	}
 
 	template<WS::Encoding EIn, WS::Encoding EOut>
 	int WSStream<EIn, EOut>::testHead(const std::string& head) {
 		int argcount {};
-		check(WSTestHead(m, head.c_str(), &argcount), ErrorName::WSTestHeadError, "Expected \"" + head + "\"");
+		check(WSTestHead(m, head.c_str(), &argcount), ErrorName::WSTestHeadError, [&head] { return "Expected \"" + head + "\""; });
 		return argcount;
 	}
 
@@ -588,10 +965,100 @@ namespace LLU {
 
 	template<WS::Encoding EIn, WS::Encoding EOut>
 	void WSStream<EIn, EOut>::refreshCurrentWSLINK() {
-		if (loopbackStack.empty()) {
+		if (exprStack.empty()) {
 			WS::Detail::throwLLUException(ErrorName::WSLoopbackStackSizeError, "Stack is empty in refreshCurrentWSLINK()");
 		}
-		m = std::get<WSLINK>(loopbackStack.top());
+		m = exprStack.back().link;
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	void WSStream<EIn, EOut>::recordPut(int argc) noexcept {
+		auto& level = exprStack.back();
+		if (level.pending > 0) {
+			// the new expression is an argument of the most recent argument
+			level.pending += argc - 1;
+			return;
+		}
+		recordTransferred(1);
+		level.pending = argc;
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	void WSStream<EIn, EOut>::recordTransferred(int count) noexcept {
+		auto& level = exprStack.back();
+		auto completing = (std::min)(count, level.pending);
+		level.pending -= completing;
+		count -= completing;
+		level.argc += count;
+		if (count > 0 && level.node >= 0) {
+			auto& children = exprBuffer[level.node].children;
+			if (children.empty() || children.back().node >= 0) {
+				children.push_back({0, -1});
+			}
+			children.back().count += count;
+		}
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<class Container>
+	void WSStream<EIn, EOut>::putContainer(const Container& c) {
+		using T = typename Container::value_type;
+		using U = WS::ArrayElementType<T>;
+		static_assert(!std::is_void_v<U>, "WSTP cannot send arrays of this element type without converting the elements.");
+		const auto& dims = c.dimensions();
+		std::vector<int> wsDims(static_cast<std::size_t>(dims.rank()));
+		for (mint i = 0; i < dims.rank(); ++i) {
+			if (dims.get(i) > (std::numeric_limits<int>::max)()) {
+				WS::Detail::throwLLUException(ErrorName::WSPutArrayError, "Dimension " + std::to_string(dims.get(i)) + " is too large for WSTP");
+			}
+			wsDims[static_cast<std::size_t>(i)] = static_cast<int>(dims.get(i));
+		}
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): U has the same size and signedness as T
+		WS::PutArray<U>::put(m, reinterpret_cast<const U*>(c.data()), wsDims.data(), static_cast<const char**>(nullptr), static_cast<int>(wsDims.size()));
+		recordPut();
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<class Container>
+	Container WSStream<EIn, EOut>::getContainer() {
+		using T = typename Container::value_type;
+		using U = WS::ArrayElementType<T>;
+		static_assert(!std::is_void_v<U>, "WSTP cannot receive arrays of this element type without converting the elements.");
+		using Dimensions = remove_cv_ref<decltype(std::declval<const Container&>().dimensions())>;
+		auto array = WS::GetArray<U>::get(m);
+		const auto& del = array.get_deleter();
+		const U* raw = array.get();
+		return Container {Dimensions {del.getDims(), static_cast<mint>(del.getRank())},
+						  [raw](T* data, mint length) { std::copy_n(raw, length, data); }};
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	void WSStream<EIn, EOut>::endBufferedExpr(int nodeIndex, WSLINK args) {
+		const auto& node = exprBuffer[nodeIndex];
+		*this << WS::Function(node.head, node.argc);
+		transferBufferedArgs(nodeIndex, args, m);
+		recordTransferred(node.argc);
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	void WSStream<EIn, EOut>::transferBufferedArgs(int nodeIndex, WSLINK src, WSLINK dst) {
+		for (const auto& child : exprBuffer[nodeIndex].children) {
+			if (child.node < 0) {
+				for (int i = 0; i < child.count; ++i) {
+					check(WSTransferExpression(dst, src), ErrorName::WSTransferToLoopbackError, "Could not transfer expression from Loopback Link");
+				}
+				continue;
+			}
+			const auto& nested = exprBuffer[child.node];
+			if (dst && !nested.dropped) {
+				check(WSPutFunction(dst, nested.head.c_str(), nested.argc), ErrorName::WSPutFunctionError, [&nested] {
+					return "Cannot put function: \"" + nested.head + "\" with " + std::to_string(nested.argc) + " arguments";
+				});
+				transferBufferedArgs(child.node, src, dst);
+			} else {
+				transferBufferedArgs(child.node, src, nullptr);
+			}
+		}
 	}
 
 	//
@@ -610,36 +1077,66 @@ namespace LLU {
 
 	template<WS::Encoding EIn, WS::Encoding EOut>
 	auto WSStream<EIn, EOut>::operator<<(const WS::Symbol& s) -> WSStream& {
-		check(WSPutSymbol(m, s.getHead().c_str()), ErrorName::WSPutSymbolError, "Cannot put symbol: \"" + s.getHead() + "\"");
+		check(WSPutSymbol(m, s.getHead().c_str()), ErrorName::WSPutSymbolError, [&s] { return "Cannot put symbol: \"" + s.getHead() + "\""; });
+		recordPut();
 		return *this;
 	}
 
 	template<WS::Encoding EIn, WS::Encoding EOut>
 	auto WSStream<EIn, EOut>::operator<<(const WS::Function& f) -> WSStream& {
 		check(WSPutFunction(m, f.getHead().c_str(), f.getArgc()), ErrorName::WSPutFunctionError,
-			  "Cannot put function: \"" + f.getHead() + "\" with " + std::to_string(f.getArgc()) + " arguments");
+			  [&f] { return "Cannot put function: \"" + f.getHead() + "\" with " + std::to_string(f.getArgc()) + " arguments"; });
+		recordPut(f.getArgc());
 		return *this;
 	}
 
 	template<WS::Encoding EIn, WS::Encoding EOut>
 	auto WSStream<EIn, EOut>::operator<<(const WS::Missing& f) -> WSStream& {
 		check(WSPutFunction(m, f.getHead().c_str(), 1),	   // f.getArgc() could be 0 but we still want to send f.reason, even if it's an empty string
-			  ErrorName::WSPutFunctionError, "Cannot put function: \"" + f.getHead() + "\" with 1 argument");
+			  ErrorName::WSPutFunctionError, [&f] { return "Cannot put function: \"" + f.getHead() + "\" with 1 argument"; });
+		recordPut(1);
 		*this << f.why();
 		return *this;
 	}
 
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<typename... Args>
+	auto WSStream<EIn, EOut>::operator<<(const WS::Expr<Args...>& e) -> WSStream& {
+		check(WSPutFunction(m, e.head, e.argc), ErrorName::WSPutFunctionError, [&e] { return "Cannot put function: \"" + std::string(e.head) + "\""; });
+		recordPut(e.argc);
+		std::apply([this](const auto&... args) { Unused((*this << ... << args)); }, e.args);
+		return *this;
+	}
+
 	template<WS::Encoding EIn, WS::Encoding EOut>
 	auto WSStream<EIn, EOut>::operator<<(const WS::BeginExpr& expr) -> WSStream& {
 
 		// reset dropped expression flag
 		currentExprDropped = false;
 
-		// create a new LoopbackLink for the expression
-		auto* loopback = WS::Detail::getNewLoopback(m);
+		const auto& parent = exprStack.back();
+		if (exprMode == WS::ExprMode::Buffered && parent.node >= 0 && parent.tracked && parent.pending == 0) {
+			// nested expression in Buffered mode only needs a new node, its arguments go to the same loopback link as the arguments of the parent
+			auto node = static_cast<int>(exprBuffer.size());
+			exprBuffer.push_back({expr.getHead()});
+			exprBuffer[parent.node].children.push_back({0, node});
+			auto* link = parent.link;
+			exprStack.push_back({expr.getHead(), link, node, false});
+		} else {
+			// create a new LoopbackLink for the expression
+			auto* loopback = WS::Detail::getNewLoopback(m);
+			auto node = -1;
+			if (exprMode == WS::ExprMode::Buffered) {
+				node = static_cast<int>(exprBuffer.size());
+				exprBuffer.push_back({expr.getHead()});
+			}
+			// store expression head together with the link on the stack
+			exprStack.push_back({expr.getHead(), loopback, node});
+		}
 
-		// store expression head together with the link on the stack
-		loopbackStack.emplace(expr.getHead(), loopback);
+		if constexpr (tracingEnabled) {
+			exprStack.back().traceStart = Trace::now();
+		}
 
 		// active WSLINK changes
 		refreshCurrentWSLINK();
@@ -650,15 +1147,25 @@ namespace LLU {
 	template<WS::Encoding EIn, WS::Encoding EOut>
 	auto WSStream<EIn, EOut>::operator<<(const WS::DropExpr& /*tag*/) -> WSStream& {
 		// check if the stack has reasonable size
-		if (loopbackStack.size() < 2) {
+		if (exprStack.size() < 2) {
 			WS::Detail::throwLLUException(ErrorName::WSLoopbackStackSizeError,
-								  "Trying to Drop expression with loopback stack size " + std::to_string(loopbackStack.size()));
+								  "Trying to Drop expression with loopback stack size " + std::to_string(exprStack.size()));
 		}
-		// we are dropping the expression so just close the link and hope that WSTP will do the cleanup
-		WSClose(std::get<WSLINK>(loopbackStack.top()));
-		loopbackStack.pop();
+		auto current = std::move(exprStack.back());
+		exprStack.pop_back();
 		refreshCurrentWSLINK();
 
+		if (current.ownsLink) {
+			// we are dropping the expression so just close the link and hope that WSTP will do the cleanup
+			WSClose(current.link);
+			if (current.node >= 0) {
+				exprBuffer.resize(current.node);
+			}
+		} else {
+			// arguments of a dropped nested expression stay in the loopback link until the outermost expression ends, then they are skipped
+			exprBuffer[current.node].dropped = true;
+		}
+
 		// set the dropped expression flag
 		currentExprDropped = true;
 
@@ -675,24 +1182,54 @@ namespace LLU {
 		}
 
 		// check if the stack has reasonable size
-		if (loopbackStack.size() < 2) {
+		if (exprStack.size() < 2) {
 			WS::Detail::throwLLUException(ErrorName::WSLoopbackStackSizeError,
-								  "Trying to End expression with loopback stack size " + std::to_string(loopbackStack.size()));
+								  "Trying to End expression with loopback stack size " + std::to_string(exprStack.size()));
 		}
 
-		// extract active loopback link and expression head
-		auto currentPartialExpr = loopbackStack.top();
-		loopbackStack.pop();
+		// extract active expression, its link and head
+		auto current = std::move(exprStack.back());
+		exprStack.pop_back();
+		// the span covers the whole expression, from BeginExpr until it is sent to the parent link
+		LLU_TRACE_SPAN_SINCE("WSTP", Trace::intern(current.head), current.traceStart);
 
 		// active WSLINK changes
 		refreshCurrentWSLINK();
 
-		// now count the expressions accumulated in the loopback link and send them to the parent link after the head
-		auto& exprArgs = std::get<WSLINK>(currentPartialExpr);
-		auto argCnt = WS::Detail::countExpressionsInLoopbackLink(exprArgs);
-		*this << WS::Function(std::get<std::string>(currentPartialExpr), argCnt);
+		if (current.node >= 0) {
+			auto& node = exprBuffer[current.node];
+			if (!current.tracked || current.pending != 0) {
+				auto isFlat = std::none_of(node.children.cbegin(), node.children.cend(), [](const auto& child) { return child.node >= 0; });
+				if (!current.ownsLink || !isFlat) {
+					WS::Detail::throwLLUException(ErrorName::WSTransferToLoopbackError,
+												  "Arguments of a buffered expression \"" + current.head + "\" were not sent with WSStream::operator<<");
+				}
+				// arguments have been written directly to the link, so the expression must be sent like in the Loopback mode
+				exprBuffer.resize(current.node);
+				current.node = -1;
+			} else {
+				node.argc = current.argc;
+				if (!current.ownsLink) {
+					// the nested expression becomes a single argument of its parent, which is recorded in the same buffer
+					++exprStack.back().argc;
+					return *this;
+				}
+				// the outermost recorded expression is sent to the parent link together with all nested expressions in a single pass
+				endBufferedExpr(current.node, current.link);
+				WSClose(current.link);
+				exprBuffer.resize(current.node);
+				return *this;
+			}
+		}
+
+		// arguments sent with operator<< have been counted already, otherwise count the expressions accumulated in the loopback link
+		auto& exprArgs = current.link;
+		auto argCnt = (current.tracked && current.pending == 0) ? current.argc : WS::Detail::countExpressionsInLoopbackLink(exprArgs);
+		// send the arguments to the parent link after the head
+		*this << WS::Function(current.head, argCnt);
 		check(WSTransferToEndOfLoopbackLink(m, exprArgs), ErrorName::WSTransferToLoopbackError,
-			  "Could not transfer " + std::to_string(argCnt) + " expressions from Loopback Link");
+			  [argCnt] { return "Could not transfer " + std::to_string(argCnt) + " expressions from Loopback Link"; });
+		recordTransferred(argCnt);
 		// finally, close the loopback link
 		WSClose(exprArgs);
 
@@ -701,12 +1238,15 @@ namespace LLU {
 
 	template<WS::Encoding EIn, WS::Encoding EOut>
 	auto WSStream<EIn, EOut>::operator<<(bool b) -> WSStream& {
-		return *this << WS::Symbol(b ? "True" : "False");
+		static const WS::Symbol trueSymbol {"True"};
+		static const WS::Symbol falseSymbol {"False"};
+		return *this << (b ? trueSymbol : falseSymbol);
 	}
 
 	template<WS::Encoding EIn, WS::Encoding EOut>
 	auto WSStream<EIn, EOut>::operator<<(mint i) -> WSStream& {
 		WS::PutScalar<wsint64>::put(m, static_cast<wsint64>(i));
+		recordPut();
 		return *this;
 	}
 
@@ -715,6 +1255,21 @@ namespace LLU {
 	auto WSStream<EIn, EOut>::operator<<(const WS::ArrayData<T>& a) -> WSStream& {
 		const auto& del = a.get_deleter();
 		WS::PutArray<T>::put(m, a.get(), del.getDims(), del.getHeads(), del.getRank());
+		recordPut();
+		return *this;
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<typename T>
+	auto WSStream<EIn, EOut>::operator<<(const Tensor<T>& t) -> WSStream& {
+		putContainer(t);
+		return *this;
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<typename T>
+	auto WSStream<EIn, EOut>::operator<<(const NumericArray<T>& na) -> WSStream& {
+		putContainer(na);
 		return *this;
 	}
 
@@ -723,6 +1278,7 @@ namespace LLU {
 	auto WSStream<EIn, EOut>::operator<<(const WS::ListData<T>& l) -> WSStream& {
 		const auto& del = l.get_deleter();
 		WS::PutList<T>::put(m, l.get(), del.getLength());
+		recordPut();
 		return *this;
 	}
 
@@ -742,6 +1298,10 @@ namespace LLU {
 	auto WSStream<EIn, EOut>::operator<<(const std::vector<T>& l) -> WSStream& {
 		if constexpr (WS::ScalarSupportedTypeQ<T>) {
 			WS::PutList<T>::put(m, l.data(), static_cast<int>(l.size()));
+			recordPut();
+		} else if constexpr (WS::BasicStringTypeQ<T>) {
+			WS::String<EOut>::putList(m, l);
+			recordPut();
 		} else {
 			*this << WS::List(static_cast<int>(l.size()));
 			for (const auto& elem : l) {
@@ -755,6 +1315,7 @@ namespace LLU {
 	template<WS::Encoding E>
 	auto WSStream<EIn, EOut>::operator<<(const WS::StringData<E>& s) -> WSStream& {
 		WS::String<E>::put(m, s.get(), s.get_deleter().getLength());
+		recordPut();
 		return *this;
 	}
 
@@ -763,6 +1324,7 @@ namespace LLU {
 	auto WSStream<EIn, EOut>::operator<<(const std::basic_string<T>& s) -> WSStream& {
 		if constexpr (WS::StringTypeQ<T>) {
 			WS::String<EOut>::put(m, s.c_str(), static_cast<int>(s.size()));
+			recordPut();
 		} else {
 			static_assert(dependent_false_v<T>, "Calling operator<< with unsupported character type.");
 		}
@@ -773,6 +1335,7 @@ namespace LLU {
 	template<typename T, std::size_t N, typename>
 	auto WSStream<EIn, EOut>::operator<<(const T (&s)[N]) -> WSStream& {
 		WS::String<EOut>::put(m, s, N);
+		recordPut();
 		return *this;
 	}
 
@@ -780,13 +1343,23 @@ namespace LLU {
 	template<WS::Encoding E, typename T>
 	auto WSStream<EIn, EOut>::operator<<(const WS::PutAs<E, T>& wrp) -> WSStream& {
 		WSStream<EIn, E> tmpWSS {m};
+		tmpWSS.exprMode = exprMode;
+		auto& current = exprStack.back();
+		tmpWSS.exprStack.front().pending = current.pending;
 		tmpWSS << wrp.obj;
+		// expressions sent by the temporary stream count as arguments of the current expression
+		const auto& tmpLevel = tmpWSS.exprStack.front();
+		current.pending = 0;
+		recordTransferred(tmpLevel.argc);
+		current.pending = tmpLevel.pending;
+		current.tracked = current.tracked && tmpLevel.tracked;
 		return *this;
 	}
 
 	template<WS::Encoding EIn, WS::Encoding EOut>
 	auto WSStream<EIn, EOut>::operator<<(const char* s) -> WSStream& {
 		WS::String<EOut>::put(m, s, static_cast<int>(std::strlen(s)));
+		recordPut();
 		return *this;
 	}
 
@@ -795,6 +1368,7 @@ namespace LLU {
 	auto WSStream<EIn, EOut>::operator<<(T value) -> WSStream& {
 		if constexpr (WS::ScalarSupportedTypeQ<T>) {
 			WS::PutScalar<T>::put(m, value);
+			recordPut();
 		} else {
 			static_assert(dependent_false_v<T>, "Calling operator<< with unsupported scalar type.");
 		}
@@ -802,15 +1376,82 @@ namespace LLU {
 	}
 
 	template<WS::Encoding EIn, WS::Encoding EOut>
-	template<typename K, typename V>
-	auto WSStream<EIn, EOut>::operator<<(const std::map<K, V>& map) -> WSStream& {
+	template<class Map>
+	void WSStream<EIn, EOut>::putAssociation(const Map& map) {
 		*this << WS::Association(static_cast<int>(map.size()));
 		for (const auto& elem : map) {
 			*this << WS::Rule << elem.first << elem.second;
 		}
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<typename K, typename V>
+	auto WSStream<EIn, EOut>::operator<<(const std::map<K, V>& map) -> WSStream& {
+		putAssociation(map);
+		return *this;
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<typename K, typename V>
+	auto WSStream<EIn, EOut>::operator<<(const std::unordered_map<K, V>& map) -> WSStream& {
+		putAssociation(map);
+		return *this;
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<typename K, typename V>
+	auto WSStream<EIn, EOut>::operator<<(const std::vector<std::pair<K, V>>& map) -> WSStream& {
+		putAssociation(map);
 		return *this;
 	}
 
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<class Map>
+	void WSStream<EIn, EOut>::sendPackedAssociation(const Map& map) {
+		using K = remove_cv_ref<decltype(std::cbegin(map)->first)>;
+		using V = remove_cv_ref<decltype(std::cbegin(map)->second)>;
+		using KU = WS::ArrayElementType<K>;
+		using VU = WS::ArrayElementType<V>;
+		static_assert(!std::is_void_v<KU> && !std::is_void_v<VU>, "Keys and values must be scalars that WSTP can send as packed Lists.");
+		std::vector<KU> keys;
+		std::vector<VU> values;
+		keys.reserve(map.size());
+		values.reserve(map.size());
+		for (const auto& elem : map) {
+			keys.push_back(static_cast<KU>(elem.first));
+			values.push_back(static_cast<VU>(elem.second));
+		}
+		*this << WS::Function("AssociationThread", 2) << keys << values;
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<class Map>
+	void WSStream<EIn, EOut>::receivePackedAssociation(Map& map) {
+		using K = remove_cv_ref<decltype(std::cbegin(map)->first)>;
+		using V = remove_cv_ref<decltype(std::cbegin(map)->second)>;
+		using KU = WS::ArrayElementType<K>;
+		using VU = WS::ArrayElementType<V>;
+		static_assert(!std::is_void_v<KU> && !std::is_void_v<VU>, "Keys and values must be scalars that WSTP can receive as packed Lists.");
+		testHead("List", 2);
+		auto keys = WS::GetList<KU>::get(m);
+		auto values = WS::GetList<VU>::get(m);
+		auto length = keys.get_deleter().getLength();
+		if (length != values.get_deleter().getLength()) {
+			WS::Detail::throwLLUException(ErrorName::WSGetListError, "Got " + std::to_string(length) + " keys and "
+																		 + std::to_string(values.get_deleter().getLength()) + " values");
+		}
+		if constexpr (has_reserve_v<Map>) {
+			map.reserve(map.size() + static_cast<std::size_t>(length));
+		}
+		for (int i = 0; i < length; ++i) {
+			if constexpr (has_emplace_back_v<Map>) {
+				map.emplace_back(static_cast<K>(keys[i]), static_cast<V>(values[i]));
+			} else {
+				map.emplace(static_cast<K>(keys[i]), static_cast<V>(values[i]));
+			}
+		}
+	}
+
 	//
 	//	Definitions of WSStream<EIn, EOut>::operator>>
 	//
@@ -822,14 +1463,14 @@ namespace LLU {
 
 	template<WS::Encoding EIn, WS::Encoding EOut>
 	auto WSStream<EIn, EOut>::operator>>(const WS::Symbol& s) -> WSStream& {
-		check(WSTestSymbol(m, s.getHead().c_str()), ErrorName::WSTestSymbolError, "Cannot get symbol: \"" + s.getHead() + "\"");
+		check(WSTestSymbol(m, s.getHead().c_str()), ErrorName::WSTestSymbolError, [&s] { return "Cannot get symbol: \"" + s.getHead() + "\""; });
 		return *this;
 	}
 
 	template<WS::Encoding EIn, WS::Encoding EOut>
 	auto WSStream<EIn, EOut>::operator>>(WS::Symbol& s) -> WSStream& {
 		if (!s.getHead().empty()) {
-			check(WSTestSymbol(m, s.getHead().c_str()), ErrorName::WSTestSymbolError, "Cannot get symbol: \"" + s.getHead() + "\"");
+			check(WSTestSymbol(m, s.getHead().c_str()), ErrorName::WSTestSymbolError, [&s] { return "Cannot get symbol: \"" + s.getHead() + "\""; });
 		} else {
 			const char* head {};
 			check(WSGetSymbol(m, &head), ErrorName::WSGetSymbolError, "Cannot get symbol");
@@ -899,6 +1540,20 @@ namespace LLU {
 		return *this;
 	}
 
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<typename T>
+	auto WSStream<EIn, EOut>::operator>>(Tensor<T>& t) -> WSStream& {
+		t = getContainer<Tensor<T>>();
+		return *this;
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<typename T>
+	auto WSStream<EIn, EOut>::operator>>(NumericArray<T>& na) -> WSStream& {
+		na = getContainer<NumericArray<T>>();
+		return *this;
+	}
+
 	template<WS::Encoding EIn, WS::Encoding EOut>
 	template<typename T>
 	auto WSStream<EIn, EOut>::operator>>(WS::ListData<T>& l) -> WSStream& {
@@ -910,14 +1565,12 @@ namespace LLU {
 	template<typename T>
 	auto WSStream<EIn, EOut>::operator>>(std::vector<T>& l) -> WSStream& {
 		if constexpr (WS::ScalarSupportedTypeQ<T>) {
-			auto list = WS::GetList<T>::get(m);
-			T* start = list.get();
-			auto listLen = list.get_deleter().getLength();
-			l = std::vector<T> {start, std::next(start, listLen)};
+			WS::GetList<T>::get(m, l);
 		} else {
 			WS::List inList;
 			*this >> inList;
-			std::vector<T> res(inList.getArgc());
+			// elements are received into fresh objects, because e.g. maps are extended rather than replaced by operator>>
+			std::vector<T> res(static_cast<std::size_t>(inList.getArgc()));
 			for (auto& elem : res) {
 				*this >> elem;
 			}
@@ -926,6 +1579,14 @@ namespace LLU {
 		return *this;
 	}
 
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<typename T>
+	auto WSStream<EIn, EOut>::operator>>(WS::ListSpan<T>& l) -> WSStream& {
+		static_assert(WS::ScalarSupportedTypeQ<T>, "WS::ListSpan can only receive lists of types supported by WSGet*List");
+		l.length = WS::GetList<T>::get(m, l.data, l.capacity);
+		return *this;
+	}
+
 	template<WS::Encoding EIn, WS::Encoding EOut>
 	template<WS::Encoding E>
 	auto WSStream<EIn, EOut>::operator>>(WS::StringData<E>& s) -> WSStream& {
@@ -945,17 +1606,46 @@ namespace LLU {
 	}
 
 	template<WS::Encoding EIn, WS::Encoding EOut>
-	template<typename K, typename V>
-	auto WSStream<EIn, EOut>::operator>>(std::map<K, V>& map) -> WSStream& {
+	template<class Map>
+	void WSStream<EIn, EOut>::getAssociation(Map& map) {
+		using K = remove_cv_ref<decltype(std::cbegin(map)->first)>;
+		using V = remove_cv_ref<decltype(std::cbegin(map)->second)>;
 		auto elemCount = testHead("Association");
+		if constexpr (has_reserve_v<Map>) {
+			map.reserve(map.size() + static_cast<std::size_t>(elemCount));
+		}
 		for (auto i = 0; i < elemCount; ++i) {
 			*this >> WS::Rule;
 			K key;
 			*this >> key;
 			V value;
 			*this >> value;
-			map.emplace(std::move(key), std::move(value));
+			if constexpr (has_emplace_back_v<Map>) {
+				map.emplace_back(std::move(key), std::move(value));
+			} else {
+				map.emplace(std::move(key), std::move(value));
+			}
 		}
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<typename K, typename V>
+	auto WSStream<EIn, EOut>::operator>>(std::map<K, V>& map) -> WSStream& {
+		getAssociation(map);
+		return *this;
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<typename K, typename V>
+	auto WSStream<EIn, EOut>::operator>>(std::unordered_map<K, V>& map) -> WSStream& {
+		getAssociation(map);
+		return *this;
+	}
+
+	template<WS::Encoding EIn, WS::Encoding EOut>
+	template<typename K, typename V>
+	auto WSStream<EIn, EOut>::operator>>(std::vector<std::pair<K, V>>& map) -> WSStream& {
+		getAssociation(map);
 		return *this;
 	}
 
@@ -0,0 +1,166 @@
+/**
+ * @file	BackgroundTask.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Implementation of background tasks that raise LibraryLink asynchronous task events.
+ */
+
+#include "LLU/Async/BackgroundTask.h"
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/LibraryData.h"
+
+namespace LLU::Async {
+
+	namespace {
+		std::mutex registryMutex;
+		std::unordered_map<mint, std::weak_ptr<Detail::BackgroundTaskState>> registry;
+
+		/// How often emit() checks whether the task was removed in the Wolfram Language while it waits for acknowledgements
+		constexpr std::chrono::milliseconds alivePollInterval {50};
+
+		/// Find a running task with given id
+		std::shared_ptr<Detail::BackgroundTaskState> findTask(mint id) {
+			std::lock_guard<std::mutex> lock {registryMutex};
+			auto it = registry.find(id);
+			return it == registry.end() ? nullptr : it->second.lock();
+		}
+
+		/// Check whether the Wolfram Language still listens to events of the task
+		bool aliveQ(mint id) {
+			return LibraryData::DataStoreAPI()->asynchronousTaskAliveQ(id) != False;
+		}
+
+		/// Pass an event to the kernel, which becomes the owner of the payload
+		void raiseEvent(mint id, std::string eventType, GenericDataList payload) {
+			if (payload.getOwner() != Ownership::Library) {
+				payload = payload.clone();
+			}
+			LibraryData::DataStoreAPI()->raiseAsyncEvent(id, eventType.data(), payload.abandonContainer());
+		}
+	}  // namespace
+
+	namespace Detail {
+		BackgroundTaskState::~BackgroundTaskState() {
+			{
+				std::lock_guard<std::mutex> lock {registryMutex};
+				registry.erase(id);
+			}
+			if (!finished) {
+				try {
+					if (aliveQ(id)) {
+						raiseEvent(id, std::string {BackgroundTask::cancelledEvent}, GenericDataList {});
+					}
+				} catch (...) {
+					// nobody can be notified
+				}
+			}
+		}
+	}  // namespace Detail
+
+	std::shared_ptr<Detail::BackgroundTaskState> BackgroundTask::create(mint maxPendingEvents) {
+		const auto id = LibraryData::DataStoreAPI()->createAsynchronousTaskWithoutThread();
+		if (id <= 0) {
+			ErrorManager::throwException(ErrorName::AsyncTaskCreateError);
+		}
+		auto state = std::make_shared<Detail::BackgroundTaskState>();
+		state->id = id;
+		state->maxPendingEvents = maxPendingEvents;
+		std::lock_guard<std::mutex> lock {registryMutex};
+		registry[id] = state;
+		return state;
+	}
+
+	bool BackgroundTask::acknowledge(mint id, mint count) {
+		auto state = findTask(id);
+		if (!state) {
+			return false;
+		}
+		{
+			std::lock_guard<std::mutex> lock {state->mutex};
+			state->pendingEvents -= std::clamp(count, mint {0}, state->pendingEvents);
+		}
+		state->changed.notify_all();
+		return true;
+	}
+
+	bool BackgroundTask::cancel(mint id) {
+		auto state = findTask(id);
+		if (!state) {
+			return false;
+		}
+		state->cancellation.cancel();
+		{
+			// make sure that a task waiting in emit() either sees the cancellation or is already waiting for the notification
+			std::lock_guard<std::mutex> lock {state->mutex};
+		}
+		state->changed.notify_all();
+		return true;
+	}
+
+	bool BackgroundTask::cancelled() const {
+		return state->cancellation.cancelled() || !aliveQ(state->id);
+	}
+
+	void BackgroundTask::emit(std::string eventType, GenericDataList payload) {
+		{
+			std::unique_lock<std::mutex> lock {state->mutex};
+			while (state->maxPendingEvents > 0 && state->pendingEvents >= state->maxPendingEvents) {
+				if (cancelled()) {
+					throw TaskCancelled {};
+				}
+				state->changed.wait_for(lock, alivePollInterval);
+			}
+			if (cancelled()) {
+				throw TaskCancelled {};
+			}
+			++state->pendingEvents;
+		}
+		raiseEvent(state->id, std::move(eventType), std::move(payload));
+	}
+
+	void BackgroundTask::raise(std::string eventType, GenericDataList payload) const {
+		state->finished = true;
+		if (aliveQ(state->id)) {
+			raiseEvent(state->id, std::move(eventType), std::move(payload));
+		}
+	}
+
+	void BackgroundTask::finish(GenericDataList result) noexcept {
+		try {
+			raise(std::string {finishedEvent}, std::move(result));
+		} catch (...) {
+			fail(std::current_exception());
+		}
+	}
+
+	void BackgroundTask::fail(const std::exception_ptr& error) noexcept {
+		try {
+			try {
+				std::rethrow_exception(error);
+			} catch (const TaskCancelled&) {
+				raise(std::string {cancelledEvent}, GenericDataList {});
+			} catch (const LibraryLinkError& e) {
+				GenericDataList details;
+				details.push_back("Error", e.name());
+				details.push_back("Message", e.message());
+				raise(std::string {failedEvent}, std::move(details));
+			} catch (const std::exception& e) {
+				GenericDataList details;
+				details.push_back("Error", std::string {"UnknownError"});
+				details.push_back("Message", std::string {e.what()});
+				raise(std::string {failedEvent}, std::move(details));
+			} catch (...) {
+				GenericDataList details;
+				details.push_back("Error", std::string {"UnknownError"});
+				raise(std::string {failedEvent}, std::move(details));
+			}
+		} catch (...) {
+			// the final event could not be raised, there is no one else to report to
+			state->finished = true;
+		}
+	}
+}  // namespace LLU::Async
@@ -0,0 +1,117 @@
+/**
+ * @file	DataListTree.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Implementation of the flat snapshot of nested DataLists.
+ */
+
+#include "LLU/Async/DataListTree.h"
+
+#include <type_traits>
+
+namespace LLU::Async {
+
+	namespace {
+		/// Position in the node chain of a single DataList during the traversal
+		struct Cursor {
+			GenericDataNode node;
+			mint parent;
+			mint depth;
+		};
+
+		/// DataList under construction in assembleTree
+		struct OpenList {
+			GenericDataList list;
+			mint index;
+			mint end;
+		};
+
+		/// Append a value to the list, nodes without names stay unnamed
+		void appendNode(GenericDataList& list, std::string_view name, const Argument::TypedArgument& value) {
+			if (name.empty()) {
+				list.push_back(value);
+			} else {
+				list.push_back(name, value);
+			}
+		}
+
+		/// Make sure that containers which do not belong to the library are copied rather than shared with the original DataList
+		void ensureOwned(Argument::TypedArgument& value) {
+			std::visit(
+				[](auto& v) {
+					using T = std::decay_t<decltype(v)>;
+					if constexpr (std::is_base_of_v<MContainerBase<MArgumentType::Tensor>, T> ||
+								  std::is_base_of_v<MContainerBase<MArgumentType::SparseArray>, T> ||
+								  std::is_base_of_v<MContainerBase<MArgumentType::NumericArray>, T> ||
+								  std::is_base_of_v<MContainerBase<MArgumentType::Image>, T> ||
+								  std::is_base_of_v<MContainerBase<MArgumentType::DataStore>, T>) {
+						if (v.getOwner() != Ownership::Library) {
+							v = v.clone();
+						}
+					}
+				},
+				value);
+		}
+	}  // namespace
+
+	DataListTree::DataListTree(const GenericDataList& root) {
+		std::vector<Cursor> stack;
+		stack.push_back({GenericDataNode {root.front()}, -1, 0});
+		while (!stack.empty()) {
+			auto& top = stack.back();
+			if (!top.node) {
+				if (top.parent >= 0) {
+					ends[static_cast<std::size_t>(top.parent)] = size();
+				}
+				stack.pop_back();
+				continue;
+			}
+			auto current = top.node;
+			auto parent = top.parent;
+			auto depth = top.depth;
+			top.node = current.next();
+			auto index = size();
+			nodes.push_back({current, parent, depth});
+			ends.push_back(index + 1);
+			if (current.type() == MArgumentType::DataStore) {
+				stack.push_back({GenericDataNode {current.valueAs<MArgumentType::DataStore>().front()}, index, depth + 1});
+			} else {
+				leafIndices.push_back(index);
+			}
+		}
+	}
+
+	std::vector<mint> DataListTree::subLists(mint depth) const {
+		std::vector<mint> result;
+		for (mint i = 0; i < size(); ++i) {
+			if (nodes[static_cast<std::size_t>(i)].depth == depth && nodes[static_cast<std::size_t>(i)].node.type() == MArgumentType::DataStore) {
+				result.push_back(i);
+			}
+		}
+		return result;
+	}
+
+	namespace Detail {
+		GenericDataList assembleTree(const DataListTree& tree, std::vector<Argument::TypedArgument>& values) {
+			std::vector<OpenList> open;
+			open.push_back({GenericDataList {}, -1, tree.size()});
+			std::size_t leaf = 0;
+			for (mint i = 0; i < tree.size(); ++i) {
+				const auto& treeNode = tree[i];
+				if (treeNode.node.type() == MArgumentType::DataStore) {
+					open.push_back({GenericDataList {}, i, tree.subtreeEnd(i)});
+				} else {
+					ensureOwned(values[leaf]);
+					appendNode(open.back().list, treeNode.node.name(), values[leaf]);
+					++leaf;
+				}
+				// close all lists that end after this node, innermost first
+				while (open.size() > 1 && open.back().end == i + 1) {
+					auto finished = std::move(open.back());
+					open.pop_back();
+					appendNode(open.back().list, tree[finished.index].node.name(), Argument::TypedArgument {std::move(finished.list)});
+				}
+			}
+			return std::move(open.front().list);
+		}
+	}  // namespace Detail
+}  // namespace LLU::Async
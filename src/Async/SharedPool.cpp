@@ -0,0 +1,90 @@
+/**
+ * @file	SharedPool.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Implementation of the lazily started shared thread pool.
+ */
+
+#include "LLU/Async/SharedPool.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+
+#include "LLU/Async/Topology.h"
+
+namespace LLU::Async {
+
+	namespace {
+		std::mutex sharedPoolMutex;
+		unsigned requestedThreads = 0;
+		std::unique_ptr<LLU::ThreadPool> sharedPoolOwner;
+		std::atomic<LLU::ThreadPool*> sharedPoolInstance = nullptr;
+
+		/// Parse the thread count from the environment, returns 0 if the variable is not set or does not hold a positive number
+		unsigned threadsFromEnvironment() {
+			const char* value = std::getenv(sharedPoolThreadsVariable);
+			if (!value) {
+				return 0;
+			}
+			char* end = nullptr;
+			auto threads = std::strtoul(value, &end, 10);
+			if (end == value || *end != '\0' || threads > Topology::cpuCount() * 16UL) {
+				return 0;
+			}
+			return static_cast<unsigned>(threads);
+		}
+
+		/// Must be called with sharedPoolMutex locked
+		unsigned threadCountLocked() {
+			if (requestedThreads > 0) {
+				return requestedThreads;
+			}
+			if (auto fromEnv = threadsFromEnvironment(); fromEnv > 0) {
+				return fromEnv;
+			}
+			return Topology::cpuCount();
+		}
+	}  // namespace
+
+	LLU::ThreadPool& sharedPool() {
+		if (auto* pool = sharedPoolInstance.load(std::memory_order_acquire)) {
+			return *pool;
+		}
+		std::lock_guard lock {sharedPoolMutex};
+		if (!sharedPoolOwner) {
+			sharedPoolOwner = std::make_unique<LLU::ThreadPool>(threadCountLocked());
+			sharedPoolInstance.store(sharedPoolOwner.get(), std::memory_order_release);
+		}
+		return *sharedPoolOwner;
+	}
+
+	unsigned sharedPoolThreadCount() {
+		std::lock_guard lock {sharedPoolMutex};
+		return threadCountLocked();
+	}
+
+	bool setSharedPoolThreadCount(unsigned threadCount) {
+		std::lock_guard lock {sharedPoolMutex};
+		if (sharedPoolOwner) {
+			return false;
+		}
+		requestedThreads = threadCount;
+		return true;
+	}
+
+	bool sharedPoolStarted() noexcept {
+		return sharedPoolInstance.load(std::memory_order_acquire) != nullptr;
+	}
+
+	void shutdownSharedPool() {
+		std::unique_ptr<LLU::ThreadPool> pool;
+		{
+			std::lock_guard lock {sharedPoolMutex};
+			sharedPoolInstance.store(nullptr, std::memory_order_release);
+			pool = std::move(sharedPoolOwner);
+		}
+		// the workers are joined here, outside of the lock, so that tasks which are still running may call the functions above
+	}
+
+}  // namespace LLU::Async
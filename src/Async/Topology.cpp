@@ -0,0 +1,216 @@
+/**
+ * @file	Topology.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Implementation of CPU topology queries and thread pinning.
+ */
+
+#include "LLU/NoMinMaxWindows.h"
+#include "LLU/Async/Topology.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace LLU::Async::Topology {
+
+	namespace {
+#ifdef __linux__
+		/// Read the first integer from a sysfs file, e.g. "4" from "4-7,12-15"
+		int readLeadingInt(const std::string& path) {
+			std::ifstream file {path};
+			int value = -1;
+			if (!(file >> value)) {
+				return -1;
+			}
+			return value;
+		}
+
+		/// Read a list of indices in the sysfs format, e.g. {0, 1, 2, 3, 8} from "0-3,8"
+		std::vector<int> readIndexList(const std::string& path) {
+			std::ifstream file {path};
+			std::string line;
+			std::vector<int> indices;
+			if (!std::getline(file, line)) {
+				return indices;
+			}
+			std::istringstream items {line};
+			std::string item;
+			while (std::getline(items, item, ',')) {
+				try {
+					const auto dash = item.find('-');
+					const int low = std::stoi(item.substr(0, dash));
+					const int high = dash == std::string::npos ? low : std::stoi(item.substr(dash + 1));
+					for (int i = low; i <= high; ++i) {
+						indices.push_back(i);
+					}
+				} catch (const std::exception&) {
+					return {};
+				}
+			}
+			return indices;
+		}
+#endif
+
+#ifdef _WIN32
+		/// Call f(level, mask) for every cache described by the system
+		template<typename F>
+		void forEachCache(F&& f) {
+			DWORD length = 0;
+			GetLogicalProcessorInformationEx(RelationCache, nullptr, &length);
+			if (length == 0) {
+				return;
+			}
+			std::vector<char> buffer(length);
+			auto* info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data());
+			if (!GetLogicalProcessorInformationEx(RelationCache, info, &length)) {
+				return;
+			}
+			for (DWORD offset = 0; offset < length;) {
+				auto* entry = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data() + offset);
+				if (entry->Relationship == RelationCache && entry->Cache.GroupMask.Group == 0) {
+					f(entry->Cache.Level, entry->Cache.GroupMask.Mask);
+				}
+				offset += entry->Size;
+			}
+		}
+#endif
+
+		/// Get the NUMA node of every logical CPU, -1 for CPUs whose node is unknown
+		std::vector<int> nodeOfEveryCpu() {
+			std::vector<int> nodes(cpuCount(), -1);
+#if defined(__linux__)
+			for (int node : readIndexList("/sys/devices/system/node/online")) {
+				for (int cpu : readIndexList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist")) {
+					if (cpu >= 0 && cpu < static_cast<int>(nodes.size())) {
+						nodes[cpu] = node;
+					}
+				}
+			}
+#elif defined(_WIN32)
+			for (std::size_t cpu = 0; cpu < nodes.size() && cpu < sizeof(KAFFINITY) * 8; ++cpu) {
+				UCHAR node = 0;
+				if (GetNumaProcessorNode(static_cast<UCHAR>(cpu), &node) && node != 0xFF) {
+					nodes[cpu] = node;
+				}
+			}
+#endif
+			return nodes;
+		}
+	}  // namespace
+
+	unsigned cpuCount() {
+		auto count = std::thread::hardware_concurrency();
+		return count > 0 ? count : 1;
+	}
+
+	int cacheGroup(int cpu) {
+		if (cpu < 0) {
+			return -1;
+		}
+#if defined(__linux__)
+		const std::string cpuDir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+		int bestLevel = -1;
+		int group = -1;
+		for (int index = 0;; ++index) {
+			const std::string cacheDir = cpuDir + "/cache/index" + std::to_string(index);
+			auto level = readLeadingInt(cacheDir + "/level");
+			if (level < 0) {
+				break;
+			}
+			// the lowest CPU index that shares the cache identifies it
+			if (level > bestLevel) {
+				bestLevel = level;
+				group = readLeadingInt(cacheDir + "/shared_cpu_list");
+			}
+		}
+		if (group < 0) {
+			group = readLeadingInt(cpuDir + "/topology/physical_package_id");
+		}
+		return group;
+#elif defined(_WIN32)
+		if (cpu >= static_cast<int>(sizeof(KAFFINITY) * 8)) {
+			return -1;
+		}
+		int bestLevel = -1;
+		int group = -1;
+		forEachCache([&](int level, KAFFINITY mask) {
+			if (level > bestLevel && (mask & (KAFFINITY {1} << cpu)) != 0) {
+				bestLevel = level;
+				for (group = 0; (mask & (KAFFINITY {1} << group)) == 0; ++group) {
+				}
+			}
+		});
+		return group;
+#else
+		return -1;
+#endif
+	}
+
+	std::vector<int> compactCpuOrder() {
+		const auto count = static_cast<int>(cpuCount());
+		std::vector<int> cpus(count);
+		std::vector<int> groups(count);
+		for (int i = 0; i < count; ++i) {
+			cpus[i] = i;
+			groups[i] = cacheGroup(i);
+		}
+		std::stable_sort(cpus.begin(), cpus.end(), [&groups](int a, int b) { return groups[a] < groups[b]; });
+		return cpus;
+	}
+
+	int numaNode(int cpu) {
+		if (cpu < 0 || cpu >= static_cast<int>(cpuCount())) {
+			return -1;
+		}
+		return nodeOfEveryCpu()[cpu];
+	}
+
+	std::vector<std::vector<int>> numaNodeCpus() {
+		const auto nodes = nodeOfEveryCpu();
+		auto order = compactCpuOrder();
+		std::map<int, std::vector<int>> groups;
+		for (int cpu : order) {
+			if (nodes[cpu] < 0) {
+				return {std::move(order)};
+			}
+			groups[nodes[cpu]].push_back(cpu);
+		}
+		std::vector<std::vector<int>> result;
+		for (auto& group : groups) {
+			result.push_back(std::move(group.second));
+		}
+		return result;
+	}
+
+	bool pinCurrentThread(int cpu) noexcept {
+		if (cpu < 0) {
+			return false;
+		}
+#if defined(__linux__)
+		if (cpu >= CPU_SETSIZE) {
+			return false;
+		}
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(cpu, &set);
+		return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+		if (cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+			return false;
+		}
+		return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR {1} << cpu) != 0;
+#else
+		return false;
+#endif
+	}
+
+}  // namespace LLU::Async::Topology
@@ -0,0 +1,35 @@
+/**
+ * @file	WorkerContext.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Implementation of the per-thread scratch memory of thread pool tasks.
+ */
+
+#include "LLU/Async/WorkerContext.h"
+
+#include "LLU/Containers/Scratch.h"
+
+namespace LLU::Async {
+
+	ScratchArena& WorkerContext::scratch() const {
+		return ScratchArena::forThread();
+	}
+
+#if __has_include(<memory_resource>)
+	std::pmr::memory_resource& WorkerContext::memoryResource() const {
+		thread_local ScratchResource resource {ScratchArena::forThread()};
+		return resource;
+	}
+#endif
+
+	void WorkerContext::releaseScratch() const noexcept {
+		if (Detail::currentTask) {
+			Detail::currentTask->rewind();
+		} else {
+			ScratchArena::forThread().release();
+		}
+	}
+
+	bool WorkerContext::inTask() const noexcept {
+		return Detail::currentTask != nullptr;
+	}
+}  // namespace LLU::Async
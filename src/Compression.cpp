@@ -0,0 +1,414 @@
+/**
+ * @file	Compression.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief	Implementation of the codec registry, the built-in LZ codec and the block frame format.
+ */
+#include "LLU/Compression.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include "LLU/Async/Algorithms.h"
+#include "LLU/Async/SharedPool.h"
+
+namespace LLU::Compression {
+
+	namespace {
+		/// Codec that copies the data, every block ends up stored as is
+		class StoreCodec : public Codec {
+		public:
+			[[nodiscard]] std::uint32_t id() const noexcept override {
+				return storeCodecId;
+			}
+
+			std::size_t compress(const std::uint8_t* /*in*/, std::size_t /*size*/, std::uint8_t* /*out*/, std::size_t /*capacity*/) const override {
+				return 0;
+			}
+
+			void decompress(const std::uint8_t* /*in*/, std::size_t /*size*/, std::uint8_t* /*out*/, std::size_t /*outSize*/) const override {
+				ErrorManager::throwException(ErrorName::InvalidCompressedData, "stored block marked as compressed");
+			}
+		};
+
+		/**
+		 * Greedy LZ77 codec writing the LZ4 block format, so that the blocks can also be decompressed with liblz4.
+		 * Every sequence is a token (literal length << 4 | match length - 4), extra literal length bytes, literals, a 2-byte little-endian offset
+		 * and extra match length bytes. The last sequence has no match, the last 5 bytes of a block are always literals.
+		 */
+		class LZCodec : public Codec {
+			static constexpr std::size_t minMatch = 4;
+			static constexpr std::size_t lastLiterals = 5;
+			static constexpr std::size_t matchFindLimit = 12;
+			static constexpr std::size_t maxOffset = 65535;
+			static constexpr unsigned hashLog = 12;
+
+			static std::uint32_t read32(const std::uint8_t* p) noexcept {
+				std::uint32_t v = 0;
+				std::memcpy(&v, p, sizeof(v));
+				return v;
+			}
+
+			static std::uint32_t hash(std::uint32_t sequence) noexcept {
+				return (sequence * 2654435761U) >> (32U - hashLog);
+			}
+
+			/// Write a length extension, i.e. a run of 255s and the remainder
+			static void putLength(std::uint8_t*& op, std::size_t length) noexcept {
+				for (; length >= 255; length -= 255) {
+					*op++ = 255;
+				}
+				*op++ = static_cast<std::uint8_t>(length);
+			}
+
+			/// Read a length extension, returns false if the input ends in the middle
+			static bool getLength(const std::uint8_t*& ip, const std::uint8_t* end, std::size_t& length) noexcept {
+				std::uint8_t b = 255;
+				while (b == 255) {
+					if (ip == end) {
+						return false;
+					}
+					b = *ip++;
+					length += b;
+				}
+				return true;
+			}
+
+			/// Worst case size of a sequence with \p literals literals
+			static std::size_t sequenceBound(std::size_t literals, std::size_t matchLength) noexcept {
+				return 1 + literals / 255 + 1 + literals + 2 + matchLength / 255 + 1;
+			}
+
+		public:
+			[[nodiscard]] std::uint32_t id() const noexcept override {
+				return lzCodecId;
+			}
+
+			std::size_t compress(const std::uint8_t* in, std::size_t size, std::uint8_t* out, std::size_t capacity) const override {
+				std::uint8_t* op = out;
+				std::uint8_t* const outEnd = out + capacity;
+				std::size_t anchor = 0;
+
+				auto emit = [&](std::size_t literals, std::size_t offset, std::size_t matchLength) {
+					if (static_cast<std::size_t>(outEnd - op) < sequenceBound(literals, matchLength)) {
+						return false;
+					}
+					std::uint8_t* token = op++;
+					*token = static_cast<std::uint8_t>(std::min<std::size_t>(literals, 15) << 4U);
+					if (literals >= 15) {
+						putLength(op, literals - 15);
+					}
+					if (literals > 0) {
+						std::memcpy(op, in + anchor, literals);
+						op += literals;
+					}
+					if (matchLength == 0) {
+						return true;
+					}
+					*op++ = static_cast<std::uint8_t>(offset & 0xFFU);
+					*op++ = static_cast<std::uint8_t>(offset >> 8U);
+					auto code = matchLength - minMatch;
+					*token |= static_cast<std::uint8_t>(std::min<std::size_t>(code, 15));
+					if (code >= 15) {
+						putLength(op, code - 15);
+					}
+					return true;
+				};
+
+				if (size > matchFindLimit) {
+					std::array<std::uint32_t, std::size_t {1} << hashLog> table {};
+					const std::size_t matchLimit = size - lastLiterals;
+					std::size_t ip = 0;
+					while (ip + matchFindLimit <= size) {
+						auto sequence = read32(in + ip);
+						auto& slot = table[hash(sequence)];
+						std::size_t candidate = slot;
+						slot = static_cast<std::uint32_t>(ip);
+						if (candidate < ip && ip - candidate <= maxOffset && read32(in + candidate) == sequence) {
+							std::size_t length = minMatch;
+							while (ip + length < matchLimit && in[candidate + length] == in[ip + length]) {
+								++length;
+							}
+							if (!emit(ip - anchor, ip - candidate, length)) {
+								return 0;
+							}
+							ip += length;
+							anchor = ip;
+						} else {
+							// skip faster through data that does not compress
+							ip += 1 + ((ip - anchor) >> 6U);
+						}
+					}
+				}
+				if (!emit(size - anchor, 0, 0)) {
+					return 0;
+				}
+				return static_cast<std::size_t>(op - out);
+			}
+
+			void decompress(const std::uint8_t* in, std::size_t size, std::uint8_t* out, std::size_t outSize) const override {
+				auto fail = [] { ErrorManager::throwException(ErrorName::InvalidCompressedData, "corrupted LZ block"); };
+				const std::uint8_t* ip = in;
+				const std::uint8_t* const end = in + size;
+				std::size_t op = 0;
+				while (true) {
+					if (ip == end) {
+						fail();
+					}
+					auto token = *ip++;
+					std::size_t literals = token >> 4U;
+					if (literals == 15 && !getLength(ip, end, literals)) {
+						fail();
+					}
+					if (literals > static_cast<std::size_t>(end - ip) || literals > outSize - op) {
+						fail();
+					}
+					if (literals > 0) {
+						std::memcpy(out + op, ip, literals);
+						ip += literals;
+						op += literals;
+					}
+					if (ip == end) {
+						break;
+					}
+					if (end - ip < 2) {
+						fail();
+					}
+					std::size_t offset = ip[0] | (static_cast<std::size_t>(ip[1]) << 8U);
+					ip += 2;
+					std::size_t length = token & 0xFU;
+					if (length == 15 && !getLength(ip, end, length)) {
+						fail();
+					}
+					length += minMatch;
+					if (offset == 0 || offset > op || length > outSize - op) {
+						fail();
+					}
+					if (offset >= length) {
+						std::memcpy(out + op, out + op - offset, length);
+					} else {
+						// overlapping copy repeats the last offset bytes
+						for (std::size_t i = 0; i < length; ++i) {
+							out[op + i] = out[op + i - offset];
+						}
+					}
+					op += length;
+				}
+				if (op != outSize) {
+					fail();
+				}
+			}
+		};
+
+		struct Registry {
+			std::mutex mutex;
+			std::unordered_map<std::uint32_t, std::shared_ptr<const Codec>> codecs {{storeCodecId, std::make_shared<StoreCodec>()},
+																					 {lzCodecId, std::make_shared<LZCodec>()}};
+		};
+
+		Registry& registry() {
+			static Registry r;
+			return r;
+		}
+
+		constexpr std::array<char, 4> frameMagic = {'L', 'L', 'U', 'C'};
+
+		/// Header of a frame, followed by a table of block sizes (uint32 each) and the blocks
+		struct FrameHeader {
+			std::array<char, 4> magic;
+			std::uint32_t codec;
+			std::uint32_t elementSize;
+			std::uint32_t blockSize;
+			std::uint64_t originalSize;
+			std::uint64_t blockCount;
+		};
+
+		/// Blocks that did not get smaller are stored as is, which is marked by the top bit of their size
+		constexpr std::uint32_t storedBlockFlag = 0x80000000U;
+
+		/// Largest block size, so that the size of a block always fits in the remaining 31 bits
+		constexpr std::size_t maxBlockSize = std::size_t {1} << 30U;
+
+		/// Run \p f for every block, in parallel if requested and there is more than one block
+		template<typename F>
+		void forEachBlock(std::size_t blockCount, bool parallel, F&& f) {
+			if (parallel && blockCount > 1) {
+				Async::parallelFor(Async::sharedPool(), std::size_t {0}, blockCount, 1, f);
+			} else {
+				for (std::size_t i = 0; i < blockCount; ++i) {
+					f(i);
+				}
+			}
+		}
+
+		FrameHeader readHeader(const std::uint8_t* frame, std::size_t frameSize) {
+			FrameHeader header {};
+			if (frameSize < sizeof(FrameHeader)) {
+				ErrorManager::throwException(ErrorName::InvalidCompressedData, "frame is too short");
+			}
+			std::memcpy(&header, frame, sizeof(FrameHeader));
+			if (header.magic != frameMagic) {
+				ErrorManager::throwException(ErrorName::InvalidCompressedData, "not a compressed frame");
+			}
+			if (header.elementSize == 0 || header.blockSize == 0 || header.blockSize > maxBlockSize || header.blockSize % header.elementSize != 0 ||
+				header.blockCount != (header.originalSize + header.blockSize - 1) / header.blockSize ||
+				header.blockCount > (frameSize - sizeof(FrameHeader)) / sizeof(std::uint32_t)) {
+				ErrorManager::throwException(ErrorName::InvalidCompressedData, "inconsistent frame header");
+			}
+			return header;
+		}
+	}  // namespace
+
+	void registerCodec(std::shared_ptr<const Codec> codec) {
+		if (!codec) {
+			ErrorManager::throwException(ErrorName::CompressionFailed, "null");
+		}
+		auto id = codec->id();
+		if (id == storeCodecId || id == lzCodecId) {
+			ErrorManager::throwException(ErrorName::CompressionFailed, static_cast<wsint64>(id));
+		}
+		auto& r = registry();
+		std::lock_guard lock {r.mutex};
+		r.codecs[id] = std::move(codec);
+	}
+
+	std::shared_ptr<const Codec> getCodec(std::uint32_t id) {
+		auto& r = registry();
+		std::lock_guard lock {r.mutex};
+		auto it = r.codecs.find(id);
+		if (it == r.codecs.end()) {
+			ErrorManager::throwException(ErrorName::UnknownCodec, static_cast<wsint64>(id));
+		}
+		return it->second;
+	}
+
+	void shuffle(const std::uint8_t* in, std::uint8_t* out, std::size_t count, std::size_t elementSize) noexcept {
+		for (std::size_t j = 0; j < elementSize; ++j) {
+			for (std::size_t i = 0; i < count; ++i) {
+				out[j * count + i] = in[i * elementSize + j];
+			}
+		}
+	}
+
+	void unshuffle(const std::uint8_t* in, std::uint8_t* out, std::size_t count, std::size_t elementSize) noexcept {
+		for (std::size_t j = 0; j < elementSize; ++j) {
+			for (std::size_t i = 0; i < count; ++i) {
+				out[i * elementSize + j] = in[j * count + i];
+			}
+		}
+	}
+
+	Frame compress(const void* data, std::size_t bytes, const Options& opts) {
+		auto codec = getCodec(opts.codec);
+		const std::size_t elementSize = std::clamp<std::size_t>(opts.elementSize, 1, maxBlockSize);
+		const std::size_t blockSize = std::max(elementSize, std::min(opts.blockSize, maxBlockSize) / elementSize * elementSize);
+		const std::size_t blockCount = (bytes + blockSize - 1) / blockSize;
+		const auto* in = static_cast<const std::uint8_t*>(data);
+
+		std::vector<std::vector<std::uint8_t>> blocks(blockCount);
+		std::vector<std::uint32_t> sizes(blockCount);
+		forEachBlock(blockCount, opts.parallel, [&](std::size_t b) {
+			const std::size_t first = b * blockSize;
+			const std::size_t length = std::min(blockSize, bytes - first);
+			const std::uint8_t* source = in + first;
+			std::vector<std::uint8_t> shuffled;
+			if (elementSize > 1) {
+				shuffled.resize(length);
+				const std::size_t count = length / elementSize;
+				shuffle(source, shuffled.data(), count, elementSize);
+				std::memcpy(shuffled.data() + count * elementSize, source + count * elementSize, length - count * elementSize);
+				source = shuffled.data();
+			}
+			auto& block = blocks[b];
+			block.resize(length);
+			std::size_t compressedSize = length > 1 ? codec->compress(source, length, block.data(), length - 1) : 0;
+			if (compressedSize == 0 || compressedSize >= length) {
+				std::memcpy(block.data(), source, length);
+				sizes[b] = static_cast<std::uint32_t>(length) | storedBlockFlag;
+			} else {
+				block.resize(compressedSize);
+				sizes[b] = static_cast<std::uint32_t>(compressedSize);
+			}
+		});
+
+		FrameHeader header {frameMagic, codec->id(), static_cast<std::uint32_t>(elementSize), static_cast<std::uint32_t>(blockSize), bytes, blockCount};
+		std::size_t total = sizeof(FrameHeader) + blockCount * sizeof(std::uint32_t);
+		for (const auto& block : blocks) {
+			total += block.size();
+		}
+		Frame frame(total);
+		std::memcpy(frame.data(), &header, sizeof(FrameHeader));
+		auto* out = frame.data() + sizeof(FrameHeader);
+		if (blockCount > 0) {
+			std::memcpy(out, sizes.data(), blockCount * sizeof(std::uint32_t));
+			out += blockCount * sizeof(std::uint32_t);
+		}
+		for (const auto& block : blocks) {
+			std::memcpy(out, block.data(), block.size());
+			out += block.size();
+		}
+		return frame;
+	}
+
+	std::uint64_t decompressedSize(const std::uint8_t* frame, std::size_t frameSize) {
+		return readHeader(frame, frameSize).originalSize;
+	}
+
+	void decompress(const std::uint8_t* frame, std::size_t frameSize, void* out, std::size_t outSize, bool parallel) {
+		auto header = readHeader(frame, frameSize);
+		if (header.originalSize != outSize) {
+			ErrorManager::throwException(ErrorName::InvalidCompressedData, "frame holds " + std::to_string(header.originalSize) + " bytes, expected " +
+																			   std::to_string(outSize));
+		}
+		const auto blockCount = static_cast<std::size_t>(header.blockCount);
+		const std::size_t blockSize = header.blockSize;
+		const std::size_t elementSize = header.elementSize;
+		std::shared_ptr<const Codec> codec;
+
+		// locate all blocks first, so that a truncated frame is detected before any work is done
+		std::vector<std::uint32_t> sizes(blockCount);
+		std::vector<std::size_t> offsets(blockCount);
+		std::size_t position = sizeof(FrameHeader) + blockCount * sizeof(std::uint32_t);
+		if (blockCount > 0) {
+			std::memcpy(sizes.data(), frame + sizeof(FrameHeader), blockCount * sizeof(std::uint32_t));
+		}
+		for (std::size_t b = 0; b < blockCount; ++b) {
+			const std::size_t length = std::min<std::size_t>(blockSize, outSize - b * blockSize);
+			const std::size_t stored = sizes[b] & ~storedBlockFlag;
+			if (((sizes[b] & storedBlockFlag) != 0 && stored != length) || stored > frameSize - position) {
+				ErrorManager::throwException(ErrorName::InvalidCompressedData, "block " + std::to_string(b) + " is truncated");
+			}
+			if ((sizes[b] & storedBlockFlag) == 0 && !codec) {
+				codec = getCodec(header.codec);
+			}
+			offsets[b] = position;
+			position += stored;
+		}
+
+		auto* dest = static_cast<std::uint8_t*>(out);
+		forEachBlock(blockCount, parallel, [&](std::size_t b) {
+			const std::size_t first = b * blockSize;
+			const std::size_t length = std::min(blockSize, outSize - first);
+			const std::uint8_t* source = frame + offsets[b];
+			const std::size_t count = elementSize > 1 ? length / elementSize : 0;
+			std::vector<std::uint8_t> shuffled;
+			if ((sizes[b] & storedBlockFlag) == 0) {
+				if (count == 0) {
+					codec->decompress(source, sizes[b], dest + first, length);
+					return;
+				}
+				shuffled.resize(length);
+				codec->decompress(source, sizes[b], shuffled.data(), length);
+				source = shuffled.data();
+			}
+			if (count == 0) {
+				std::memcpy(dest + first, source, length);
+			} else {
+				unshuffle(source, dest + first, count, elementSize);
+				std::memcpy(dest + first + count * elementSize, source + count * elementSize, length - count * elementSize);
+			}
+		});
+	}
+}  // namespace LLU::Compression
@@ -0,0 +1,82 @@
+/**
+ * @file
+ * Definitions of non-template member functions of ContainerPool class
+ */
+
+#include "LLU/Containers/ContainerPool.h"
+
+namespace LLU {
+
+	namespace {
+		template<class Buckets, class Key, class Container>
+		bool keep(Buckets& buckets, Key key, Container c, std::size_t maxPerShape) {
+			auto& bucket = buckets[std::move(key)];
+			if (bucket.size() >= maxPerShape) {
+				return false;
+			}
+			bucket.push_back(c);
+			return true;
+		}
+	}  // namespace
+
+	void ContainerPool::recycle(GenericTensor& t) noexcept {
+		if (!t.getContainer() || t.getOwner() != Ownership::Library || !LibraryData::hasLibraryData()) {
+			return;
+		}
+		try {
+			Key key {t.type(), {t.getDimensions(), t.getDimensions() + t.getRank()}};
+			std::lock_guard<std::mutex> lock {poolMutex};
+			if (keep(tensors, std::move(key), t.getContainer(), maxPerShape)) {
+				t.abandonContainer();
+			}
+		} catch (...) {
+			// the container stays with t and is freed normally
+		}
+	}
+
+	void ContainerPool::recycle(GenericNumericArray& na) noexcept {
+		if (!na.getContainer() || na.getOwner() != Ownership::Library || !LibraryData::hasLibraryData()) {
+			return;
+		}
+		try {
+			Key key {static_cast<mint>(na.type()), {na.getDimensions(), na.getDimensions() + na.getRank()}};
+			std::lock_guard<std::mutex> lock {poolMutex};
+			if (keep(numericArrays, std::move(key), na.getContainer(), maxPerShape)) {
+				na.abandonContainer();
+			}
+		} catch (...) {
+			// the container stays with na and is freed normally
+		}
+	}
+
+	std::size_t ContainerPool::size() const {
+		std::lock_guard<std::mutex> lock {poolMutex};
+		std::size_t n = 0;
+		for (const auto& b : tensors) {
+			n += b.second.size();
+		}
+		for (const auto& b : numericArrays) {
+			n += b.second.size();
+		}
+		return n;
+	}
+
+	void ContainerPool::clear() noexcept {
+		std::lock_guard<std::mutex> lock {poolMutex};
+		if (LibraryData::hasLibraryData()) {
+			for (const auto& b : tensors) {
+				for (auto t : b.second) {
+					LibraryData::API()->MTensor_free(t);
+				}
+			}
+			for (const auto& b : numericArrays) {
+				for (auto na : b.second) {
+					LibraryData::NumericArrayAPI()->MNumericArray_free(na);
+				}
+			}
+		}
+		tensors.clear();
+		numericArrays.clear();
+	}
+
+}  // namespace LLU
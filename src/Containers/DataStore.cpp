@@ -5,6 +5,11 @@
  * @brief
  */
 
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <variant>
+
 #include "LLU/Containers/Generic/DataStore.hpp"
 
 namespace LLU {
@@ -41,76 +46,84 @@ namespace LLU {
 		}
 	}
 
-	void MContainer<MArgumentType::DataStore>::push_back(std::string_view name, const Argument::Typed::Any& node) {
-		switch (static_cast<MArgumentType>(node.index())) {
-			case MArgumentType::MArgument: ErrorManager::throwException(ErrorName::DLInvalidNodeType);
-			case MArgumentType::Boolean:
-				PrimitiveWrapper<MArgumentType::Boolean>::addDataStoreNode(getContainer(), name, static_cast<mbool>(*std::get_if<bool>(&node)));
-				break;
-			case MArgumentType::Integer: PrimitiveWrapper<MArgumentType::Integer>::addDataStoreNode(getContainer(), name, *std::get_if<mint>(&node)); break;
-			case MArgumentType::Real: PrimitiveWrapper<MArgumentType::Real>::addDataStoreNode(getContainer(), name, *std::get_if<double>(&node)); break;
-			case MArgumentType::Complex: {
-				auto c = *std::get_if<std::complex<double>>(&node);
-				mcomplex mc {c.real(), c.imag()};
-				PrimitiveWrapper<MArgumentType::Complex>::addDataStoreNode(getContainer(), name, mc);
-			} break;
-			case MArgumentType::Tensor:
-				PrimitiveWrapper<MArgumentType::Tensor>::addDataStoreNode(getContainer(), name, std::get_if<GenericTensor>(&node)->abandonContainer());
-				break;
-			case MArgumentType::SparseArray:
-				PrimitiveWrapper<MArgumentType::SparseArray>::addDataStoreNode(getContainer(), name, std::get_if<GenericSparseArray>(&node)->abandonContainer());
-				break;
-			case MArgumentType::NumericArray:
-				PrimitiveWrapper<MArgumentType::NumericArray>::addDataStoreNode(getContainer(), name,
-																				std::get_if<GenericNumericArray>(&node)->abandonContainer());
-				break;
-			case MArgumentType::Image:
-				PrimitiveWrapper<MArgumentType::Image>::addDataStoreNode(getContainer(), name, std::get_if<GenericImage>(&node)->abandonContainer());
-				break;
-			case MArgumentType::UTF8String: {
-				const auto* data = std::get_if<std::string_view>(&node)->data();
+	bool MContainer<MArgumentType::DataStore>::hasNodesOfType(MArgumentType type) const noexcept {
+		const auto* api = LibraryData::uncheckedDataStoreAPI();
+		for (auto* node = api->DataStore_getFirstNode(getContainer()); node != nullptr; node = api->DataStoreNode_getNextNode(node)) {
+			if (static_cast<MArgumentType>(api->DataStoreNode_getDataType(node)) != type) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	namespace {
+		using Argument::Typed::Any;
+
+		/// Get the value of \p node in the form stored in DataStore nodes of type \p Type, the active member of \p node must have index Type
+		template<MArgumentType Type>
+		Argument::CType<Type> nodeData(const Any& node) {
+			const auto& value = *std::get_if<static_cast<std::size_t>(Type)>(&node);
+			if constexpr (Type == MArgumentType::Boolean) {
+				return static_cast<mbool>(value);
+			} else if constexpr (Type == MArgumentType::Complex) {
+				return mcomplex {value.real(), value.imag()};
+			} else if constexpr (Type == MArgumentType::UTF8String) {
 				// NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast): required by DataStore API
-				PrimitiveWrapper<MArgumentType::UTF8String>::addDataStoreNode(getContainer(), name, const_cast<char*>(data));
-			} break;
-			case MArgumentType::DataStore:
-				PrimitiveWrapper<MArgumentType::DataStore>::addDataStoreNode(getContainer(), name, std::get_if<GenericDataList>(&node)->abandonContainer());
-				break;
+				return const_cast<char*>(value.data());
+			} else if constexpr (std::is_arithmetic_v<remove_cv_ref<decltype(value)>>) {
+				return value;
+			} else {
+				return value.abandonContainer();
+			}
+		}
+
+		using NodeAdder = void (*)(DataStore, const Any&);
+		using NamedNodeAdder = void (*)(DataStore, std::string_view, const Any&);
+
+		template<MArgumentType Type>
+		void addNode(DataStore ds, const Any& node) {
+			if constexpr (Type == MArgumentType::MArgument) {
+				ErrorManager::throwException(ErrorName::DLInvalidNodeType);
+			} else {
+				PrimitiveWrapper<Type>::addDataStoreNode(ds, nodeData<Type>(node));
+			}
+		}
+
+		template<MArgumentType Type>
+		void addNamedNode(DataStore ds, std::string_view name, const Any& node) {
+			if constexpr (Type == MArgumentType::MArgument) {
+				ErrorManager::throwException(ErrorName::DLInvalidNodeType);
+			} else {
+				PrimitiveWrapper<Type>::addDataStoreNode(ds, name, nodeData<Type>(node));
+			}
+		}
+
+		/// Functions that add a node of each type, indexed by the index of the active member of Typed::Any, so that push_back does not switch
+		template<std::size_t... Is>
+		constexpr std::array<NodeAdder, sizeof...(Is)> makeNodeAdders(std::index_sequence<Is...> /*indices*/) {
+			return {&addNode<static_cast<MArgumentType>(Is)>...};
+		}
+
+		template<std::size_t... Is>
+		constexpr std::array<NamedNodeAdder, sizeof...(Is)> makeNamedNodeAdders(std::index_sequence<Is...> /*indices*/) {
+			return {&addNamedNode<static_cast<MArgumentType>(Is)>...};
 		}
+
+		constexpr auto nodeAdders = makeNodeAdders(std::make_index_sequence<std::variant_size_v<Any>> {});
+		constexpr auto namedNodeAdders = makeNamedNodeAdders(std::make_index_sequence<std::variant_size_v<Any>> {});
+	}  // namespace
+
+	void MContainer<MArgumentType::DataStore>::push_back(std::string_view name, const Argument::Typed::Any& node) {
+		if (node.valueless_by_exception()) {
+			ErrorManager::throwException(ErrorName::DLInvalidNodeType);
+		}
+		namedNodeAdders[node.index()](getContainer(), name, node);
 	}
 
 	void MContainer<MArgumentType::DataStore>::push_back(const Argument::Typed::Any& node) {
-		switch (static_cast<MArgumentType>(node.index())) {
-			case MArgumentType::MArgument: ErrorManager::throwException(ErrorName::DLInvalidNodeType);
-			case MArgumentType::Boolean:
-				PrimitiveWrapper<MArgumentType::Boolean>::addDataStoreNode(getContainer(), static_cast<mbool>(*std::get_if<bool>(&node)));
-				break;
-			case MArgumentType::Integer: PrimitiveWrapper<MArgumentType::Integer>::addDataStoreNode(getContainer(), *std::get_if<mint>(&node)); break;
-			case MArgumentType::Real: PrimitiveWrapper<MArgumentType::Real>::addDataStoreNode(getContainer(), *std::get_if<double>(&node)); break;
-			case MArgumentType::Complex: {
-				auto c = *std::get_if<std::complex<double>>(&node);
-				mcomplex mc {c.real(), c.imag()};
-				PrimitiveWrapper<MArgumentType::Complex>::addDataStoreNode(getContainer(), mc);
-			} break;
-			case MArgumentType::Tensor:
-				PrimitiveWrapper<MArgumentType::Tensor>::addDataStoreNode(getContainer(), std::get_if<GenericTensor>(&node)->abandonContainer());
-				break;
-			case MArgumentType::SparseArray:
-				PrimitiveWrapper<MArgumentType::SparseArray>::addDataStoreNode(getContainer(), std::get_if<GenericSparseArray>(&node)->abandonContainer());
-				break;
-			case MArgumentType::NumericArray:
-				PrimitiveWrapper<MArgumentType::NumericArray>::addDataStoreNode(getContainer(), std::get_if<GenericNumericArray>(&node)->abandonContainer());
-				break;
-			case MArgumentType::Image:
-				PrimitiveWrapper<MArgumentType::Image>::addDataStoreNode(getContainer(), std::get_if<GenericImage>(&node)->abandonContainer());
-				break;
-			case MArgumentType::UTF8String: {
-				const auto* data = std::get_if<std::string_view>(&node)->data();
-				// NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast): required by DataStore API
-				PrimitiveWrapper<MArgumentType::UTF8String>::addDataStoreNode(getContainer(), const_cast<char*>(data));
-			} break;
-			case MArgumentType::DataStore:
-				PrimitiveWrapper<MArgumentType::DataStore>::addDataStoreNode(getContainer(), std::get_if<GenericDataList>(&node)->abandonContainer());
-				break;
+		if (node.valueless_by_exception()) {
+			ErrorManager::throwException(ErrorName::DLInvalidNodeType);
 		}
+		nodeAdders[node.index()](getContainer(), node);
 	}
-}	 // namespace LLU
\ No newline at end of file
+}	 // namespace LLU
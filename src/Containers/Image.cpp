@@ -48,7 +48,7 @@ namespace LLU {
 	template<>
 	int8_t TypedImage<int8_t>::getValueAt(mint* position, mint channel) const {
 		raw_t_bit res {};
-		if (0 != LibraryData::ImageAPI()->MImage_getBit(this->getInternal(), position, channel, &res)) {
+		if (0 != LibraryData::uncheckedImageAPI()->MImage_getBit(this->getInternal(), position, channel, &res)) {
 			this->indexError();
 		}
 		return res;
@@ -56,7 +56,7 @@ namespace LLU {
 
 	template<>
 	void TypedImage<int8_t>::setValueAt(mint* position, mint channel, int8_t newValue) {
-		if (0 != LibraryData::ImageAPI()->MImage_setBit(this->getInternal(), position, channel, newValue)) {
+		if (0 != LibraryData::uncheckedImageAPI()->MImage_setBit(this->getInternal(), position, channel, newValue)) {
 			this->indexError();
 		}
 	}
@@ -68,7 +68,7 @@ namespace LLU {
 	template<>
 	uint8_t TypedImage<uint8_t>::getValueAt(mint* position, mint channel) const {
 		raw_t_ubit8 res {};
-		if (0 != LibraryData::ImageAPI()->MImage_getByte(this->getInternal(), position, channel, &res)) {
+		if (0 != LibraryData::uncheckedImageAPI()->MImage_getByte(this->getInternal(), position, channel, &res)) {
 			this->indexError();
 		}
 		return res;
@@ -76,7 +76,7 @@ namespace LLU {
 
 	template<>
 	void TypedImage<uint8_t>::setValueAt(mint* position, mint channel, uint8_t newValue) {
-		if (0 != LibraryData::ImageAPI()->MImage_setByte(this->getInternal(), position, channel, newValue)) {
+		if (0 != LibraryData::uncheckedImageAPI()->MImage_setByte(this->getInternal(), position, channel, newValue)) {
 			this->indexError();
 		}
 	}
@@ -88,7 +88,7 @@ namespace LLU {
 	template<>
 	uint16_t TypedImage<uint16_t>::getValueAt(mint* position, mint channel) const {
 		raw_t_ubit16 res {};
-		if (0 != LibraryData::ImageAPI()->MImage_getBit16(this->getInternal(), position, channel, &res)) {
+		if (0 != LibraryData::uncheckedImageAPI()->MImage_getBit16(this->getInternal(), position, channel, &res)) {
 			this->indexError();
 		}
 		return res;
@@ -96,7 +96,7 @@ namespace LLU {
 
 	template<>
 	void TypedImage<uint16_t>::setValueAt(mint* position, mint channel, uint16_t newValue) {
-		if (0 != LibraryData::ImageAPI()->MImage_setBit16(this->getInternal(), position, channel, newValue)) {
+		if (0 != LibraryData::uncheckedImageAPI()->MImage_setBit16(this->getInternal(), position, channel, newValue)) {
 			this->indexError();
 		}
 	}
@@ -108,7 +108,7 @@ namespace LLU {
 	template<>
 	float TypedImage<float>::getValueAt(mint* position, mint channel) const {
 		raw_t_real32 res {};
-		if (0 != LibraryData::ImageAPI()->MImage_getReal32(this->getInternal(), position, channel, &res)) {
+		if (0 != LibraryData::uncheckedImageAPI()->MImage_getReal32(this->getInternal(), position, channel, &res)) {
 			this->indexError();
 		}
 		return res;
@@ -116,7 +116,7 @@ namespace LLU {
 
 	template<>
 	void TypedImage<float>::setValueAt(mint* position, mint channel, float newValue) {
-		if (0 != LibraryData::ImageAPI()->MImage_setReal32(this->getInternal(), position, channel, newValue)) {
+		if (0 != LibraryData::uncheckedImageAPI()->MImage_setReal32(this->getInternal(), position, channel, newValue)) {
 			this->indexError();
 		}
 	}
@@ -128,7 +128,7 @@ namespace LLU {
 	template<>
 	double TypedImage<double>::getValueAt(mint* position, mint channel) const {
 		raw_t_real64 res {};
-		if (0 != LibraryData::ImageAPI()->MImage_getReal(this->getInternal(), position, channel, &res)) {
+		if (0 != LibraryData::uncheckedImageAPI()->MImage_getReal(this->getInternal(), position, channel, &res)) {
 			this->indexError();
 		}
 		return res;
@@ -136,7 +136,7 @@ namespace LLU {
 
 	template<>
 	void TypedImage<double>::setValueAt(mint* position, mint channel, double newValue) {
-		if (0 != LibraryData::ImageAPI()->MImage_setReal(this->getInternal(), position, channel, newValue)) {
+		if (0 != LibraryData::uncheckedImageAPI()->MImage_setReal(this->getInternal(), position, channel, newValue)) {
 			this->indexError();
 		}
 	}
@@ -0,0 +1,333 @@
+/**
+ * @file	MemoryStats.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief	Implementation of the memory accounting of library-owned containers and of the interface functions getMemoryStats and resetMemoryStats.
+ */
+#include "LLU/Containers/MemoryStats.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/LibraryData.h"
+#include "LLU/WSTP/WSStream.hpp"
+
+namespace LLU {
+
+	namespace {
+		/// Name of the group of containers acquired outside of any MemoryStats::Tag
+		constexpr const char* untagged = "Untagged";
+
+		/// Innermost tag of the calling thread
+		thread_local const char* currentTag = untagged;
+
+		/// Registered container
+		struct Entry {
+			MArgumentType type;
+			std::int64_t bytes;
+			std::string_view tag;
+		};
+
+		/// All containers owned by the library and the usage of each group of them
+		struct Registry {
+			std::mutex mutex;
+			std::unordered_map<const void*, Entry> entries;
+			MemoryUsage total;
+			std::unordered_map<MArgumentType, MemoryUsage> containers;
+			std::unordered_map<std::string_view, MemoryUsage> tags;
+
+			/// Apply \p f to all groups to which given container belongs
+			template<typename F>
+			void forGroups(const Entry& e, F&& f) {
+				f(total);
+				f(containers[e.type]);
+				f(tags[e.tag]);
+			}
+
+			/// Update the size of a registered container
+			void resize(Entry& e, std::int64_t bytes) {
+				const auto delta = bytes - e.bytes;
+				e.bytes = bytes;
+				forGroups(e, [delta](MemoryUsage& u) {
+					u.liveBytes += delta;
+					u.peakBytes = std::max(u.peakBytes, u.liveBytes);
+				});
+			}
+		};
+
+		Registry& registry() {
+			static Registry r;
+			return r;
+		}
+
+		std::string containerTypeName(MArgumentType type) {
+			switch (type) {
+				case MArgumentType::Tensor: return "Tensor";
+				case MArgumentType::NumericArray: return "NumericArray";
+				case MArgumentType::Image: return "Image";
+				case MArgumentType::SparseArray: return "SparseArray";
+				case MArgumentType::DataStore: return "DataStore";
+				default: return "Unknown";
+			}
+		}
+
+		std::int64_t tensorBytes(MTensor t) {
+			if (!t) {
+				return 0;
+			}
+			const auto* api = LibraryData::API();
+			std::int64_t elementSize = 0;
+			switch (api->MTensor_getType(t)) {
+				case MType_Integer: elementSize = sizeof(mint); break;
+				case MType_Real: elementSize = sizeof(mreal); break;
+				case MType_Complex: elementSize = sizeof(mcomplex); break;
+				default: break;
+			}
+			return elementSize * api->MTensor_getFlattenedLength(t);
+		}
+
+		std::int64_t numericArrayBytes(MNumericArray na) {
+			const auto* api = LibraryData::NumericArrayAPI();
+			std::int64_t elementSize = 0;
+			switch (api->MNumericArray_getType(na)) {
+				case MNumericArray_Type_Bit8:
+				case MNumericArray_Type_UBit8: elementSize = 1; break;
+				case MNumericArray_Type_Bit16:
+				case MNumericArray_Type_UBit16: elementSize = 2; break;
+				case MNumericArray_Type_Bit32:
+				case MNumericArray_Type_UBit32:
+				case MNumericArray_Type_Real32: elementSize = 4; break;
+				case MNumericArray_Type_Bit64:
+				case MNumericArray_Type_UBit64:
+				case MNumericArray_Type_Real64:
+				case MNumericArray_Type_Complex_Real32: elementSize = 8; break;
+				case MNumericArray_Type_Complex_Real64: elementSize = 16; break;
+				default: break;
+			}
+			return elementSize * api->MNumericArray_getFlattenedLength(na);
+		}
+
+		std::int64_t imageBytes(MImage im) {
+			const auto* api = LibraryData::ImageAPI();
+			std::int64_t elementSize = 0;
+			switch (api->MImage_getDataType(im)) {
+				case MImage_Type_Bit:
+				case MImage_Type_Bit8: elementSize = 1; break;
+				case MImage_Type_Bit16: elementSize = 2; break;
+				case MImage_Type_Real32: elementSize = 4; break;
+				case MImage_Type_Real: elementSize = 8; break;
+				default: break;
+			}
+			return elementSize * api->MImage_getFlattenedLength(im);
+		}
+
+		std::int64_t sparseArrayBytes(MSparseArray sa) {
+			const auto* api = LibraryData::SparseArrayAPI();
+			std::int64_t bytes = 0;
+			for (auto* part : {api->MSparseArray_getExplicitValues(sa), api->MSparseArray_getRowPointers(sa), api->MSparseArray_getColumnIndices(sa)}) {
+				if (part) {
+					bytes += tensorBytes(*part);
+				}
+			}
+			return bytes;
+		}
+
+		std::int64_t dataStoreBytes(DataStore ds) {
+			const auto* api = LibraryData::DataStoreAPI();
+			std::int64_t bytes = 0;
+			for (auto node = api->DataStore_getFirstNode(ds); node; node = api->DataStoreNode_getNextNode(node)) {
+				MArgument m;
+				if (api->DataStoreNode_getData(node, &m) != 0) {
+					continue;
+				}
+				switch (api->DataStoreNode_getDataType(node)) {
+					case MType_Boolean: bytes += sizeof(mbool); break;
+					case MType_Integer: bytes += sizeof(mint); break;
+					case MType_Real: bytes += sizeof(mreal); break;
+					case MType_Complex: bytes += sizeof(mcomplex); break;
+					case MType_Tensor: bytes += tensorBytes(MArgument_getMTensor(m)); break;
+					case MType_SparseArray: bytes += sparseArrayBytes(MArgument_getMSparseArray(m)); break;
+					case MType_NumericArray: bytes += numericArrayBytes(MArgument_getMNumericArray(m)); break;
+					case MType_Image: bytes += imageBytes(MArgument_getMImage(m)); break;
+					case MType_UTF8String: bytes += static_cast<std::int64_t>(std::strlen(MArgument_getUTF8String(m)) + 1); break;
+					case MType_DataStore: bytes += dataStoreBytes(MArgument_getDataStore(m)); break;	 // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+					default: break;
+				}
+			}
+			return bytes;
+		}
+
+		void putUsage(WSStream<WS::Encoding::UTF8>& ms, const MemoryUsage& u) {
+			ms << WS::Association(4);
+			ms << WS::Rule << "LiveBytes" << static_cast<wsint64>(u.liveBytes);
+			ms << WS::Rule << "PeakBytes" << static_cast<wsint64>(u.peakBytes);
+			ms << WS::Rule << "LiveCount" << static_cast<wsint64>(u.liveCount);
+			ms << WS::Rule << "TotalCount" << static_cast<wsint64>(u.totalCount);
+		}
+
+		void putUsageMap(WSStream<WS::Encoding::UTF8>& ms, const std::map<std::string, MemoryUsage>& usage) {
+			ms << WS::Association(static_cast<int>(usage.size()));
+			for (const auto& [name, u] : usage) {
+				ms << WS::Rule << name;
+				putUsage(ms, u);
+			}
+		}
+	}  // namespace
+
+	MemoryStats::Tag::Tag(const char* name) noexcept : previous {currentTag} {
+		currentTag = name;
+	}
+
+	MemoryStats::Tag::~Tag() {
+		currentTag = previous;
+	}
+
+	std::int64_t MemoryStats::bytesOf(MArgumentType type, const void* container) noexcept {
+		if (!container || !LibraryData::hasLibraryData()) {
+			return 0;
+		}
+		// LibraryLink containers are opaque pointers, so the const qualifier only means that this function does not change the container
+		auto* c = const_cast<void*>(container);	   // NOLINT(cppcoreguidelines-pro-type-const-cast)
+		try {
+			switch (type) {
+				case MArgumentType::Tensor: return tensorBytes(static_cast<MTensor>(c));
+				case MArgumentType::NumericArray: return numericArrayBytes(static_cast<MNumericArray>(c));
+				case MArgumentType::Image: return imageBytes(static_cast<MImage>(c));
+				case MArgumentType::SparseArray: return sparseArrayBytes(static_cast<MSparseArray>(c));
+				case MArgumentType::DataStore: return dataStoreBytes(static_cast<DataStore>(c));
+				default: return 0;
+			}
+		} catch (...) {
+			// the API of given container type is not available
+			return 0;
+		}
+	}
+
+	void MemoryStats::acquire(MArgumentType type, const void* container) noexcept {
+		const auto bytes = bytesOf(type, container);
+		auto& r = registry();
+		try {
+			std::lock_guard<std::mutex> lock {r.mutex};
+			auto [it, inserted] = r.entries.try_emplace(container, Entry {type, 0, currentTag});
+			if (!inserted) {
+				// the container is already registered, only its size may have changed
+				r.resize(it->second, bytes);
+				return;
+			}
+			r.forGroups(it->second, [](MemoryUsage& u) {
+				++u.liveCount;
+				++u.totalCount;
+			});
+			r.resize(it->second, bytes);
+		} catch (...) {
+			// out of memory, the container is not counted
+		}
+	}
+
+	void MemoryStats::release(const void* container) noexcept {
+		auto& r = registry();
+		std::lock_guard<std::mutex> lock {r.mutex};
+		auto it = r.entries.find(container);
+		if (it == r.entries.end()) {
+			return;
+		}
+		auto& e = it->second;
+		if (e.type == MArgumentType::DataStore) {
+			r.resize(e, bytesOf(e.type, container));
+		}
+		r.forGroups(e, [&e](MemoryUsage& u) {
+			u.liveBytes -= e.bytes;
+			--u.liveCount;
+		});
+		r.entries.erase(it);
+	}
+
+	MemoryStatsSnapshot MemoryStats::snapshot() {
+		MemoryStatsSnapshot res;
+		auto& r = registry();
+		std::lock_guard<std::mutex> lock {r.mutex};
+		for (auto& [container, e] : r.entries) {
+			if (e.type == MArgumentType::DataStore) {
+				r.resize(e, bytesOf(e.type, container));
+			}
+		}
+		res.total = r.total;
+		for (const auto& [type, u] : r.containers) {
+			res.containers[containerTypeName(type)] = u;
+		}
+		for (const auto& [tag, u] : r.tags) {
+			res.tags[std::string {tag}] = u;
+		}
+		return res;
+	}
+
+	void MemoryStats::reset() noexcept {
+		auto& r = registry();
+		std::lock_guard<std::mutex> lock {r.mutex};
+		auto resetUsage = [](MemoryUsage& u) {
+			u.peakBytes = u.liveBytes;
+			u.totalCount = u.liveCount;
+		};
+		resetUsage(r.total);
+		for (auto& group : r.containers) {
+			resetUsage(group.second);
+		}
+		for (auto& group : r.tags) {
+			resetUsage(group.second);
+		}
+	}
+
+	/**
+	 * LibraryLink function that sends the memory accounting as an Association with keys "LiveBytes", "PeakBytes", "LiveCount", "TotalCount",
+	 * "Containers" (an Association from container type names to Associations with the same four keys) and "Tags" (likewise, for allocation-site tags).
+	 * Only libraries compiled with LLU_MEMORY_STATS count their containers, otherwise all numbers are zero.
+	 * @param libData - WolframLibraryData
+	 * @param mlp - WSTP link to transfer data
+	 * @return error code
+	 */
+	EXTERN_C DLLEXPORT int getMemoryStats([[maybe_unused]] WolframLibraryData libData, WSLINK mlp) {
+		auto err = ErrorCode::NoError;
+		try {
+			auto stats = MemoryStats::snapshot();
+			WSStream<WS::Encoding::UTF8> ms(mlp, "List", 0);
+			ms << WS::NewPacket << WS::Association(6);
+			ms << WS::Rule << "LiveBytes" << static_cast<wsint64>(stats.total.liveBytes);
+			ms << WS::Rule << "PeakBytes" << static_cast<wsint64>(stats.total.peakBytes);
+			ms << WS::Rule << "LiveCount" << static_cast<wsint64>(stats.total.liveCount);
+			ms << WS::Rule << "TotalCount" << static_cast<wsint64>(stats.total.totalCount);
+			ms << WS::Rule << "Containers";
+			putUsageMap(ms, stats.containers);
+			ms << WS::Rule << "Tags";
+			putUsageMap(ms, stats.tags);
+			ms << WS::EndPacket << WS::Flush;
+		} catch (LibraryLinkError& e) {
+			err = e.which();
+		} catch (...) {
+			err = ErrorCode::FunctionError;
+		}
+		return err;
+	}
+
+	/**
+	 * LibraryLink function that resets the peaks and total counts of the memory accounting to the current usage.
+	 * @param libData - WolframLibraryData
+	 * @param mlp - WSTP link to transfer data
+	 * @return error code
+	 */
+	EXTERN_C DLLEXPORT int resetMemoryStats([[maybe_unused]] WolframLibraryData libData, WSLINK mlp) {
+		auto err = ErrorCode::NoError;
+		try {
+			WSStream<WS::Encoding::UTF8> ms(mlp, "List", 0);
+			MemoryStats::reset();
+			ms << WS::NewPacket << WS::Null << WS::EndPacket << WS::Flush;
+		} catch (LibraryLinkError& e) {
+			err = e.which();
+		} catch (...) {
+			err = ErrorCode::FunctionError;
+		}
+		return err;
+	}
+}  // namespace LLU
@@ -0,0 +1,375 @@
+/**
+ * @file	NumericArrayIO.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief	Implementation of positional file reads and writes, text splitting used by the NumericArray loaders and the BinaryFileWriter class.
+ */
+#include "LLU/NoMinMaxWindows.h"
+#include "LLU/Containers/NumericArrayIO.h"
+
+#include <array>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace LLU::Detail {
+
+	namespace {
+		/// Lookup table of separators, so that counting numbers in a chunk needs no branches
+		constexpr std::array<unsigned char, 256> separatorTable() {
+			std::array<unsigned char, 256> table {};
+			for (unsigned char c : {' ', '\n', ',', '\t', '\r', ';'}) {
+				table[c] = 1;
+			}
+			return table;
+		}
+
+		constexpr auto separators = separatorTable();
+
+		/// Count tokens in [first, last) assuming that the character before \p first is a separator
+		std::size_t countTokens(const char* first, const char* last) noexcept {
+			std::size_t count = 0;
+			unsigned previous = 1;
+			for (; first != last; ++first) {
+				unsigned current = separators[static_cast<unsigned char>(*first)];
+				count += previous & (current ^ 1U);
+				previous = current;
+			}
+			return count;
+		}
+	}  // namespace
+
+	PositionalFile::PositionalFile(std::string fileName) : name {std::move(fileName)} {
+		validatePath(name, std::ios::in);
+#ifdef _WIN32
+		std::wstring fileNameUTF16 = fromUTF8toUTF16<wchar_t>(name);
+		HANDLE h = CreateFileW(fileNameUTF16.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (h == INVALID_HANDLE_VALUE) {
+			ErrorManager::throwException(ErrorName::OpenFileFailed, name);
+		}
+		handle = reinterpret_cast<std::intptr_t>(h);	// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+#else
+		int fd = ::open(name.c_str(), O_RDONLY);
+		if (fd < 0) {
+			ErrorManager::throwException(ErrorName::OpenFileFailed, name);
+		}
+		handle = fd;
+#endif
+	}
+
+	PositionalFile::~PositionalFile() {
+#ifdef _WIN32
+		CloseHandle(reinterpret_cast<HANDLE>(handle));	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+#else
+		::close(static_cast<int>(handle));
+#endif
+	}
+
+	std::uint64_t PositionalFile::size() const {
+#ifdef _WIN32
+		LARGE_INTEGER fileSize {};
+		if (GetFileSizeEx(reinterpret_cast<HANDLE>(handle), &fileSize) == 0) {	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+			ErrorManager::throwException(ErrorName::ReadFileFailed, name);
+		}
+		return static_cast<std::uint64_t>(fileSize.QuadPart);
+#else
+		struct stat fileStats {};
+		if (::fstat(static_cast<int>(handle), &fileStats) != 0) {
+			ErrorManager::throwException(ErrorName::ReadFileFailed, name);
+		}
+		return static_cast<std::uint64_t>(fileStats.st_size);
+#endif
+	}
+
+	void PositionalFile::read(void* buffer, std::size_t count, std::uint64_t offset) const {
+		auto* out = static_cast<char*>(buffer);
+		while (count > 0) {
+#ifdef _WIN32
+			// with an OVERLAPPED structure ReadFile reads from given offset and does not use the shared file pointer
+			OVERLAPPED position {};
+			position.Offset = static_cast<DWORD>(offset & 0xFFFFFFFFU);
+			position.OffsetHigh = static_cast<DWORD>(offset >> 32U);
+			DWORD bytesRead = 0;
+			auto toRead = static_cast<DWORD>(std::min<std::size_t>(count, 1U << 30U));
+			if (ReadFile(reinterpret_cast<HANDLE>(handle), out, toRead, &bytesRead, &position) == 0 || bytesRead == 0) {	// NOLINT
+				ErrorManager::throwException(ErrorName::ReadFileFailed, name);
+			}
+			auto n = static_cast<std::size_t>(bytesRead);
+#else
+			auto bytesRead = ::pread(static_cast<int>(handle), out, count, static_cast<off_t>(offset));
+			if (bytesRead < 0 && errno == EINTR) {
+				continue;
+			}
+			if (bytesRead <= 0) {
+				ErrorManager::throwException(ErrorName::ReadFileFailed, name);
+			}
+			auto n = static_cast<std::size_t>(bytesRead);
+#endif
+			out += n;
+			count -= n;
+			offset += n;
+		}
+	}
+
+	bool needsByteSwap(ByteOrder order) noexcept {
+		if (order == ByteOrder::Native) {
+			return false;
+		}
+		const std::uint16_t one = 1;
+		unsigned char firstByte {};
+		std::memcpy(&firstByte, &one, 1);
+		const bool nativeLittleEndian = firstByte == 1;
+		return nativeLittleEndian != (order == ByteOrder::LittleEndian);
+	}
+
+	std::vector<TextChunk> splitText(const char* data, std::size_t length, std::size_t chunkSize, bool parallel) {
+		std::vector<TextChunk> chunks;
+		chunkSize = std::max<std::size_t>(chunkSize, 1);
+		const char* end = data + length;
+		const char* begin = data;
+		while (begin != end) {
+			const char* chunkEnd = begin + std::min(chunkSize, static_cast<std::size_t>(end - begin));
+			while (chunkEnd != end && !isSeparator(*chunkEnd)) {
+				++chunkEnd;
+			}
+			chunks.push_back({begin, chunkEnd, 0});
+			begin = chunkEnd;
+		}
+		forEachChunk(chunks.size(), 1, parallel, [&chunks](std::size_t c, std::size_t /*last*/) {
+			chunks[c].count = countTokens(chunks[c].begin, chunks[c].end);
+		});
+		return chunks;
+	}
+
+	void throwParseError(const std::string& token, std::size_t position) {
+		ErrorManager::throwException(ErrorName::NumberParseFailed, token, static_cast<mint>(position));
+	}
+
+	OutputFile::OutputFile(std::string fileName, bool append, bool directIO) : name {std::move(fileName)} {
+		validatePath(name, std::ios::out);
+#ifdef _WIN32
+		std::wstring fileNameUTF16 = fromUTF8toUTF16<wchar_t>(name);
+		DWORD flags = directIO ? (FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH) : FILE_ATTRIBUTE_NORMAL;
+		HANDLE h = CreateFileW(fileNameUTF16.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, append ? OPEN_ALWAYS : CREATE_ALWAYS, flags, nullptr);
+		if (h == INVALID_HANDLE_VALUE) {
+			ErrorManager::throwException(ErrorName::OpenFileFailed, name);
+		}
+		handle = reinterpret_cast<std::intptr_t>(h);	// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		aligned = directIO;
+		LARGE_INTEGER fileSize {};
+		if (append && GetFileSizeEx(h, &fileSize) != 0) {
+			startSize = static_cast<std::uint64_t>(fileSize.QuadPart);
+		}
+#else
+		const int flags = O_WRONLY | O_CREAT | (append ? 0 : O_TRUNC);
+		int fd = -1;
+#ifdef O_DIRECT
+		if (directIO) {
+			fd = ::open(name.c_str(), flags | O_DIRECT, 0666);	  // NOLINT(cppcoreguidelines-pro-type-vararg)
+			aligned = fd >= 0;
+		}
+		// file systems without O_DIRECT support (e.g. tmpfs) reject the flag with EINVAL, fall back to regular I/O
+		if (fd < 0 && (!directIO || errno == EINVAL)) {
+			fd = ::open(name.c_str(), flags, 0666);	   // NOLINT(cppcoreguidelines-pro-type-vararg)
+		}
+#else
+		fd = ::open(name.c_str(), flags, 0666);	   // NOLINT(cppcoreguidelines-pro-type-vararg)
+#ifdef F_NOCACHE
+		if (fd >= 0 && directIO) {
+			::fcntl(fd, F_NOCACHE, 1);	  // NOLINT(cppcoreguidelines-pro-type-vararg)
+		}
+#endif
+#endif
+		if (fd < 0) {
+			ErrorManager::throwException(ErrorName::OpenFileFailed, name);
+		}
+		handle = fd;
+		struct stat fileStats {};
+		if (append && ::fstat(fd, &fileStats) == 0) {
+			startSize = static_cast<std::uint64_t>(fileStats.st_size);
+		}
+#endif
+		if (aligned && startSize % directIOAlignment != 0) {
+			disableDirectIO();
+		}
+	}
+
+	OutputFile::~OutputFile() {
+		if (isOpen) {
+#ifdef _WIN32
+			CloseHandle(reinterpret_cast<HANDLE>(handle));	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+#else
+			::close(static_cast<int>(handle));
+#endif
+		}
+	}
+
+	void OutputFile::disableDirectIO() {
+		if (!aligned) {
+			return;
+		}
+#ifdef _WIN32
+		// buffering mode of an open handle cannot be changed, but the file can be reopened with different flags
+		HANDLE h = ReOpenFile(reinterpret_cast<HANDLE>(handle), GENERIC_WRITE, FILE_SHARE_READ, FILE_ATTRIBUTE_NORMAL);	   // NOLINT
+		if (h == INVALID_HANDLE_VALUE) {
+			ErrorManager::throwException(ErrorName::WriteFileFailed, name);
+		}
+		CloseHandle(reinterpret_cast<HANDLE>(handle));	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		handle = reinterpret_cast<std::intptr_t>(h);	// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+#elif defined(O_DIRECT)
+		const int fd = static_cast<int>(handle);
+		const int flags = ::fcntl(fd, F_GETFL);	   // NOLINT(cppcoreguidelines-pro-type-vararg)
+		if (flags < 0 || ::fcntl(fd, F_SETFL, flags & ~O_DIRECT) < 0) {	   // NOLINT(cppcoreguidelines-pro-type-vararg)
+			ErrorManager::throwException(ErrorName::WriteFileFailed, name);
+		}
+#endif
+		aligned = false;
+	}
+
+	void OutputFile::write(const void* buffer, std::size_t count, std::uint64_t offset) const {
+		const auto* in = static_cast<const char*>(buffer);
+		while (count > 0) {
+#ifdef _WIN32
+			OVERLAPPED position {};
+			position.Offset = static_cast<DWORD>(offset & 0xFFFFFFFFU);
+			position.OffsetHigh = static_cast<DWORD>(offset >> 32U);
+			DWORD bytesWritten = 0;
+			auto toWrite = static_cast<DWORD>(std::min<std::size_t>(count, 1U << 30U));
+			if (WriteFile(reinterpret_cast<HANDLE>(handle), in, toWrite, &bytesWritten, &position) == 0 || bytesWritten == 0) {	// NOLINT
+				ErrorManager::throwException(ErrorName::WriteFileFailed, name);
+			}
+			auto n = static_cast<std::size_t>(bytesWritten);
+#else
+			auto bytesWritten = ::pwrite(static_cast<int>(handle), in, count, static_cast<off_t>(offset));
+			if (bytesWritten < 0 && errno == EINTR) {
+				continue;
+			}
+			if (bytesWritten <= 0) {
+				ErrorManager::throwException(ErrorName::WriteFileFailed, name);
+			}
+			auto n = static_cast<std::size_t>(bytesWritten);
+#endif
+			in += n;
+			count -= n;
+			offset += n;
+		}
+	}
+
+	void OutputFile::close() {
+		if (!isOpen) {
+			return;
+		}
+		isOpen = false;
+#ifdef _WIN32
+		if (CloseHandle(reinterpret_cast<HANDLE>(handle)) == 0) {	 // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+#else
+		if (::close(static_cast<int>(handle)) != 0) {
+#endif
+			ErrorManager::throwException(ErrorName::WriteFileFailed, name);
+		}
+	}
+}  // namespace LLU::Detail
+
+namespace LLU {
+
+	namespace {
+		std::size_t alignedBufferSize(std::size_t bytes) noexcept {
+			bytes = std::max(bytes, directIOAlignment);
+			return (bytes + directIOAlignment - 1) / directIOAlignment * directIOAlignment;
+		}
+
+		bool isAligned(const void* p) noexcept {
+			return reinterpret_cast<std::uintptr_t>(p) % directIOAlignment == 0;	// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		}
+	}  // namespace
+
+	BinaryFileWriter::BinaryFileWriter(std::string fileName, const BinaryWriteOptions& opts)
+		: file {std::move(fileName), opts.append, opts.directIO}, capacity {alignedBufferSize(opts.bufferSize)}, async {opts.asyncFlush},
+		  buffers {Detail::makeAlignedBuffer(capacity), async ? Detail::makeAlignedBuffer(capacity) : nullptr}, offset {file.initialSize()} {}
+
+	BinaryFileWriter::~BinaryFileWriter() {
+		try {
+			close();
+		} catch (...) {
+			// close() waits for the write in progress before it can throw, so the buffers are no longer used
+		}
+	}
+
+	void BinaryFileWriter::write(const void* data, std::size_t bytes) {
+		if (closed) {
+			ErrorManager::throwExceptionWithDebugInfo(ErrorName::WriteFileFailed, "The file has already been closed.");
+		}
+		const auto* in = static_cast<const std::byte*>(data);
+		while (bytes > 0) {
+			if (fill == 0 && bytes >= capacity && (!file.requiresAlignment() || isAligned(in))) {
+				// large write that can bypass the buffers, the data only has to be written in whole blocks for unbuffered I/O
+				const auto n = file.requiresAlignment() ? bytes - bytes % directIOAlignment : bytes;
+				waitForPending();
+				file.write(in, n, offset);
+				offset += n;
+				in += n;
+				bytes -= n;
+				continue;
+			}
+			const auto n = std::min(capacity - fill, bytes);
+			std::memcpy(buffers[current].get() + fill, in, n);
+			fill += n;
+			in += n;
+			bytes -= n;
+			if (fill == capacity) {
+				submitBuffer();
+			}
+		}
+	}
+
+	void BinaryFileWriter::submitBuffer() {
+		const std::byte* data = buffers[current].get();
+		const auto count = fill;
+		const auto position = offset;
+		offset += fill;
+		fill = 0;
+		if (async) {
+			// the other buffer may still be written to the file, it must be free before the caller starts filling it
+			waitForPending();
+			pending.run(Async::sharedPool(), [this, data, count, position] { file.write(data, count, position); });
+			inFlight = true;
+			current ^= 1;
+		} else {
+			file.write(data, count, position);
+		}
+	}
+
+	void BinaryFileWriter::waitForPending() {
+		if (inFlight) {
+			inFlight = false;
+			pending.wait(Async::sharedPool());
+		}
+	}
+
+	void BinaryFileWriter::flush() {
+		waitForPending();
+		if (fill > 0) {
+			if (fill % directIOAlignment != 0) {
+				file.disableDirectIO();
+			}
+			file.write(buffers[current].get(), fill, offset);
+			offset += fill;
+			fill = 0;
+		}
+	}
+
+	void BinaryFileWriter::close() {
+		if (closed) {
+			return;
+		}
+		closed = true;
+		flush();
+		file.close();
+	}
+}  // namespace LLU
@@ -0,0 +1,137 @@
+/**
+ * @file
+ * Definitions of non-template member functions of StringColumn and RecordBatch classes
+ */
+
+#include "LLU/Containers/RecordBatch.h"
+
+#include <algorithm>
+
+namespace LLU {
+
+	namespace {
+		GenericDataNode stringColumnNode(const GenericDataList& ds, mint index) {
+			if (ds.length() != 2) {
+				ErrorManager::throwException(ErrorName::DLInvalidNodeType);
+			}
+			auto node = ds.front();
+			return index == 0 ? GenericDataNode {node} : GenericDataNode {node}.next();
+		}
+
+		/// Get the length of a rank 1 container
+		template<class View>
+		mint columnLength(const View& v) {
+			if (v.getRank() != 1) {
+				ErrorManager::throwException(ErrorName::RankError);
+			}
+			return v.getDimensions()[0];
+		}
+	}  // namespace
+
+	StringColumn::StringColumn(NumericArray<std::uint8_t> characters, Tensor<mint> offsets)
+		: characterData(std::move(characters)), offsetData(std::move(offsets)) {
+		if (characterData.rank() != 1 || offsetData.rank() != 1) {
+			ErrorManager::throwException(ErrorName::RankError);
+		}
+		if (offsetData.empty() || offsetData.front() != 0 || offsetData.back() != characterData.size() ||
+			!std::is_sorted(offsetData.cbegin(), offsetData.cend())) {
+			ErrorManager::throwException(ErrorName::DimensionsError);
+		}
+		cachePointers();
+	}
+
+	StringColumn::StringColumn(const GenericDataList& ds)
+		: StringColumn(NumericArray<std::uint8_t> {stringColumnNode(ds, 0).as<GenericNumericArray>()},
+					   Tensor<mint> {stringColumnNode(ds, 1).as<GenericTensor>()}) {}
+
+	void StringColumn::cachePointers() noexcept {
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): UTF-8 characters are read as chars
+		chars = reinterpret_cast<const char*>(characterData.data());
+		offs = offsetData.data();
+		count = offsetData.size() - 1;
+	}
+
+	GenericDataList StringColumn::toDataList() const {
+		GenericDataList ds;
+		ds.push_back<MArgumentType::NumericArray>(characterData.clone());
+		ds.push_back<MArgumentType::Tensor>(offsetData.clone());
+		return ds;
+	}
+
+	RecordBatch::RecordBatch(const GenericDataList& ds) {
+		columnList.reserve(static_cast<std::size_t>(ds.length()));
+		for (auto node : ds) {
+			std::string name {node.name()};
+			switch (node.type()) {
+				case MArgumentType::Tensor: addColumn(std::move(name), node.as<GenericTensor>()); break;
+				case MArgumentType::NumericArray: addColumn(std::move(name), node.as<GenericNumericArray>()); break;
+				case MArgumentType::DataStore: addColumn(std::move(name), StringColumn {node.as<GenericDataList>()}); break;
+				default: ErrorManager::throwException(ErrorName::DLInvalidNodeType, std::move(name));
+			}
+		}
+	}
+
+	mint RecordBatch::columnIndex(std::string_view name) const {
+		auto it = std::find_if(columnList.cbegin(), columnList.cend(), [name](const Column& c) { return c.name == name; });
+		if (it == columnList.cend()) {
+			ErrorManager::throwException(ErrorName::DLNodeNotFound, std::string {name});
+		}
+		return static_cast<mint>(it - columnList.cbegin());
+	}
+
+	void RecordBatch::addColumn(std::string name, GenericTensor data) {
+		TensorView v {data};
+		const auto length = columnLength(v);
+		addColumn(Column {std::move(name), MArgumentType::Tensor, v.type(), v.rawData(), std::move(data)}, length);
+	}
+
+	void RecordBatch::addColumn(std::string name, GenericNumericArray data) {
+		NumericArrayView v {data};
+		const auto length = columnLength(v);
+		addColumn(Column {std::move(name), MArgumentType::NumericArray, static_cast<mint>(v.type()), v.rawData(), std::move(data)}, length);
+	}
+
+	void RecordBatch::addColumn(std::string name, StringColumn data) {
+		const auto length = data.size();
+		addColumn(Column {std::move(name), MArgumentType::UTF8String, MType_Undef, nullptr, std::move(data)}, length);
+	}
+
+	void RecordBatch::addColumn(Column c, mint length) {
+		if (columnList.empty()) {
+			rowCount = length;
+		} else if (length != rowCount) {
+			ErrorManager::throwException(ErrorName::DimensionsError, c.name);
+		}
+		columnList.push_back(std::move(c));
+	}
+
+	auto RecordBatch::get(mint column) const -> const Column& {
+		if (column < 0 || column >= columns()) {
+			ErrorManager::throwException(ErrorName::DLNodeNotFound, column);
+		}
+		return columnList[static_cast<std::size_t>(column)];
+	}
+
+	auto RecordBatch::checkedData(mint column, MArgumentType kind) const -> const std::variant<GenericTensor, GenericNumericArray, StringColumn>& {
+		const auto& c = get(column);
+		if (c.kind != kind) {
+			ErrorManager::throwException(ErrorName::TypeError, c.name);
+		}
+		return c.data;
+	}
+
+	GenericDataList RecordBatch::toDataList() const {
+		GenericDataList ds;
+		for (const auto& c : columnList) {
+			switch (c.kind) {
+				case MArgumentType::Tensor: ds.push_back<MArgumentType::Tensor>(c.name, std::get<GenericTensor>(c.data).clone()); break;
+				case MArgumentType::NumericArray:
+					ds.push_back<MArgumentType::NumericArray>(c.name, std::get<GenericNumericArray>(c.data).clone());
+					break;
+				default: ds.push_back<MArgumentType::DataStore>(c.name, std::get<StringColumn>(c.data).toDataList()); break;
+			}
+		}
+		return ds;
+	}
+
+}  // namespace LLU
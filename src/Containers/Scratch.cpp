@@ -0,0 +1,86 @@
+/**
+ * @file
+ * Definitions of non-template member functions of ScratchArena class
+ */
+
+#include "LLU/Containers/Scratch.h"
+
+#include <cstdint>
+#include <numeric>
+
+#include "LLU/Async/WorkerContext.h"
+
+namespace LLU {
+
+	void* ScratchArena::allocate(std::size_t bytes, std::size_t alignment) {
+		auto alignedOffset = [alignment](const Block& b, std::size_t off) {
+			const auto base = reinterpret_cast<std::uintptr_t>(b.memory.get());
+			return ((base + off + alignment - 1) & ~(alignment - 1)) - base;
+		};
+		// try the current block and then the blocks kept from before the last release
+		for (; current < blocks.size(); ++current, offset = 0) {
+			const auto start = alignedOffset(blocks[current], offset);
+			if (start + bytes <= blocks[current].size) {
+				offset = start + bytes;
+				return blocks[current].memory.get() + start;
+			}
+		}
+		Block b;
+		b.size = std::max(blockSize, bytes + alignment);
+		b.memory = std::make_unique<std::byte[]>(b.size);
+		blocks.push_back(std::move(b));
+		current = blocks.size() - 1;
+		const auto start = alignedOffset(blocks[current], 0);
+		offset = start + bytes;
+		return blocks[current].memory.get() + start;
+	}
+
+	void ScratchArena::rewind(const Mark& m) noexcept {
+		current = m.block;
+		offset = m.offset;
+	}
+
+	void ScratchArena::shrink() noexcept {
+		blocks.clear();
+		current = 0;
+		offset = 0;
+	}
+
+	std::size_t ScratchArena::bytesUsed() const noexcept {
+		if (blocks.empty()) {
+			return 0;
+		}
+		std::size_t used = offset;
+		for (std::size_t i = 0; i < current && i < blocks.size(); ++i) {
+			used += blocks[i].size;
+		}
+		return used;
+	}
+
+	std::size_t ScratchArena::capacity() const noexcept {
+		return std::accumulate(blocks.cbegin(), blocks.cend(), std::size_t {0}, [](std::size_t n, const Block& b) { return n + b.size; });
+	}
+
+	namespace {
+		void markThreadArena(std::size_t& block, std::size_t& offset) noexcept {
+			const auto m = ScratchArena::forThread().mark();
+			block = m.block;
+			offset = m.offset;
+		}
+
+		void rewindThreadArena(std::size_t block, std::size_t offset) noexcept {
+			ScratchArena::forThread().rewind({block, offset});
+		}
+
+		constexpr Async::Detail::ScratchHooks threadArenaHooks {&markThreadArena, &rewindThreadArena};
+	}  // namespace
+
+	ScratchArena& ScratchArena::forThread() {
+		// from now on thread pools reclaim the memory that their tasks allocate from the arenas
+		static const bool hooked = (Async::Detail::scratchHooks.store(&threadArenaHooks, std::memory_order_release), true);
+		static_cast<void>(hooked);
+		thread_local ScratchArena arena;
+		return arena;
+	}
+
+}  // namespace LLU
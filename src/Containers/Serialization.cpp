@@ -0,0 +1,544 @@
+/**
+ * @file	Serialization.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief	Implementation of writing and reading serialized LibraryLink values.
+ */
+#include "LLU/Containers/Serialization.h"
+
+#include <array>
+#include <complex>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <utility>
+
+#include "LLU/Containers/NumericArrayIO.h"
+
+namespace LLU::Serialization {
+
+	namespace {
+		constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+		constexpr std::uint64_t alignUp(std::uint64_t n) noexcept {
+			return (n + alignment - 1) / alignment * alignment;
+		}
+
+		std::size_t tensorElementSize(std::uint32_t type) {
+			switch (type) {
+				case MType_Integer: return sizeof(mint);
+				case MType_Real: return sizeof(double);
+				case MType_Complex: return sizeof(std::complex<double>);
+				default: ErrorManager::throwException(ErrorName::TensorTypeError);
+			}
+		}
+
+		std::size_t numericArrayElementSize(std::uint32_t type) {
+			switch (type) {
+				case MNumericArray_Type_Bit8:
+				case MNumericArray_Type_UBit8: return 1;
+				case MNumericArray_Type_Bit16:
+				case MNumericArray_Type_UBit16: return 2;
+				case MNumericArray_Type_Bit32:
+				case MNumericArray_Type_UBit32:
+				case MNumericArray_Type_Real32: return 4;
+				case MNumericArray_Type_Bit64:
+				case MNumericArray_Type_UBit64:
+				case MNumericArray_Type_Real64:
+				case MNumericArray_Type_Complex_Real32: return 8;
+				case MNumericArray_Type_Complex_Real64: return 16;
+				default: ErrorManager::throwException(ErrorName::NumericArrayTypeError);
+			}
+		}
+
+		std::size_t imageElementSize(std::uint32_t type) {
+			switch (type) {
+				case MImage_Type_Bit:
+				case MImage_Type_Bit8: return 1;
+				case MImage_Type_Bit16: return 2;
+				case MImage_Type_Real32: return 4;
+				case MImage_Type_Real: return 8;
+				default: ErrorManager::throwException(ErrorName::ImageTypeError);
+			}
+		}
+
+		/// Multiply \p bytes by \p factor, returning false if the factor is negative or the product does not fit in std::size_t
+		bool checkedMultiply(std::size_t& bytes, std::int64_t factor) noexcept {
+			if (factor < 0 || (factor > 0 && bytes > std::numeric_limits<std::size_t>::max() / static_cast<std::uint64_t>(factor))) {
+				return false;
+			}
+			bytes *= static_cast<std::size_t>(factor);
+			return true;
+		}
+
+		/// Contiguous part of a payload, every part starts at an aligned offset
+		struct Piece {
+			const void* data;
+			std::size_t size;
+		};
+
+		/// Layout of a node computed before anything is written, so that the size of every node is known when its header is written
+		struct Plan {
+			NodeHeader header {};
+			std::vector<std::int64_t> dims;
+			std::string_view name;
+			std::vector<Piece> pieces;
+			std::vector<Plan> children;
+			/// containers created only to get the data of a SparseArray, they must live until the data is written
+			std::vector<GenericTensor> temporaries;
+			/// compressed payloads, they must live until the data is written
+			std::vector<Compression::Frame> frames;
+			/// storage of scalar payloads, on the heap so that pieces stay valid when the plan is moved
+			std::unique_ptr<std::array<std::int64_t, 2>> scalar;
+		};
+
+		void setDimensions(Plan& p, const mint* dims, mint rank) {
+			p.dims.assign(dims, dims + rank);
+			p.header.rank = static_cast<std::uint16_t>(rank);
+		}
+
+		/// Add the contiguous data of an array as the only piece of the payload, compressing it if requested
+		void setArrayPayload(Plan& p, const void* data, std::size_t bytes, std::size_t elementSize, const SerializeOptions& opts) {
+			if (!opts.compress) {
+				p.pieces.push_back({data, bytes});
+				return;
+			}
+			auto compression = opts.compression;
+			if (compression.elementSize == 0) {
+				compression.elementSize = elementSize;
+			}
+			const auto& frame = p.frames.emplace_back(Compression::compress(data, bytes, compression));
+			p.pieces.push_back({frame.data(), frame.size()});
+			p.header.flags |= compressedPayloadFlag;
+		}
+
+		/// Compute offsets and sizes of a node whose contents have been filled
+		void finish(Plan& p, bool trailingZero = false) {
+			auto& h = p.header;
+			h.nameLength = static_cast<std::uint32_t>(p.name.size());
+			// the name is always followed by at least one zero byte, because LibraryLink expects null-terminated names of DataList nodes
+			h.payloadOffset = alignUp(sizeof(NodeHeader) + h.rank * sizeof(std::int64_t) + h.nameLength + 1);
+			std::uint64_t size = 0;
+			for (const auto& piece : p.pieces) {
+				size = alignUp(size) + piece.size;
+			}
+			for (const auto& child : p.children) {
+				size += child.header.nodeSize;
+			}
+			h.payloadSize = size;
+			h.nodeSize = alignUp(h.payloadOffset + size + (trailingZero ? 1 : 0));
+		}
+
+		Plan plan(const Argument::TypedArgument& value, std::string_view name, const SerializeOptions& opts);
+
+		template<typename T>
+		Plan planScalar(MArgumentType type, const T& value, std::string_view name) {
+			static_assert(sizeof(T) <= 2 * sizeof(std::int64_t));
+			Plan p;
+			p.header.type = static_cast<std::uint32_t>(type);
+			p.name = name;
+			p.scalar = std::make_unique<std::array<std::int64_t, 2>>();
+			std::memcpy(p.scalar->data(), &value, sizeof(T));
+			p.pieces.push_back({p.scalar->data(), sizeof(T)});
+			finish(p);
+			return p;
+		}
+
+		Plan plan(const GenericTensor& t, std::string_view name, const SerializeOptions& opts) {
+			Plan p;
+			p.header.type = static_cast<std::uint32_t>(MArgumentType::Tensor);
+			p.header.elementType = static_cast<std::uint32_t>(t.type());
+			p.name = name;
+			setDimensions(p, t.getDimensions(), t.getRank());
+			const auto elementSize = tensorElementSize(p.header.elementType);
+			setArrayPayload(p, t.rawData(), static_cast<std::size_t>(t.getFlattenedLength()) * elementSize, elementSize, opts);
+			finish(p);
+			return p;
+		}
+
+		Plan plan(const GenericNumericArray& na, std::string_view name, const SerializeOptions& opts) {
+			Plan p;
+			p.header.type = static_cast<std::uint32_t>(MArgumentType::NumericArray);
+			p.header.elementType = static_cast<std::uint32_t>(na.type());
+			p.name = name;
+			setDimensions(p, na.getDimensions(), na.getRank());
+			const auto elementSize = numericArrayElementSize(p.header.elementType);
+			setArrayPayload(p, na.rawData(), static_cast<std::size_t>(na.getFlattenedLength()) * elementSize, elementSize, opts);
+			finish(p);
+			return p;
+		}
+
+		Plan plan(const GenericImage& im, std::string_view name, const SerializeOptions& opts) {
+			Plan p;
+			p.header.type = static_cast<std::uint32_t>(MArgumentType::Image);
+			p.header.elementType = static_cast<std::uint32_t>(im.type());
+			p.name = name;
+			std::vector<mint> dims {im.rows(), im.columns()};
+			if (im.is3D()) {
+				dims.insert(dims.begin(), im.slices());
+			}
+			setDimensions(p, dims.data(), static_cast<mint>(dims.size()));
+			p.header.extra[0] = im.channels();
+			p.header.extra[1] = static_cast<std::int64_t>(im.colorspace());
+			p.header.extra[2] = im.interleavedQ() ? 1 : 0;
+			const auto elementSize = imageElementSize(p.header.elementType);
+			setArrayPayload(p, im.rawData(), static_cast<std::size_t>(im.getFlattenedLength()) * elementSize, elementSize, opts);
+			finish(p);
+			return p;
+		}
+
+		Plan plan(const GenericSparseArray& sa, std::string_view name) {
+			Plan p;
+			p.header.type = static_cast<std::uint32_t>(MArgumentType::SparseArray);
+			p.header.elementType = static_cast<std::uint32_t>(sa.type());
+			p.name = name;
+			setDimensions(p, sa.getDimensions(), sa.getRank());
+			const auto elementSize = tensorElementSize(p.header.elementType);
+			auto& implicitValue = p.temporaries.emplace_back(sa.getImplicitValueAsTensor());
+			p.pieces.push_back({implicitValue.rawData(), elementSize});
+			auto values = sa.getExplicitValues();
+			const mint count = values.getContainer() ? values.getFlattenedLength() : 0;
+			p.header.extra[0] = count;
+			if (count > 0) {
+				auto& positions = p.temporaries.emplace_back(sa.getExplicitPositions());
+				p.pieces.push_back({positions.rawData(), static_cast<std::size_t>(count * sa.getRank()) * sizeof(mint)});
+				auto& explicitValues = p.temporaries.emplace_back(std::move(values));
+				p.pieces.push_back({explicitValues.rawData(), static_cast<std::size_t>(count) * elementSize});
+			}
+			finish(p);
+			return p;
+		}
+
+		Plan plan(const GenericDataList& dl, std::string_view name, const SerializeOptions& opts) {
+			Plan p;
+			p.header.type = static_cast<std::uint32_t>(MArgumentType::DataStore);
+			p.name = name;
+			for (auto node : dl) {
+				p.children.push_back(plan(node.value(), node.name(), opts));
+			}
+			p.header.extra[0] = static_cast<std::int64_t>(p.children.size());
+			finish(p);
+			return p;
+		}
+
+		Plan plan(const Argument::TypedArgument& value, std::string_view name, const SerializeOptions& opts) {
+			switch (static_cast<MArgumentType>(value.index())) {
+				case MArgumentType::Boolean: return planScalar(MArgumentType::Boolean, std::int64_t {*std::get_if<bool>(&value) ? 1 : 0}, name);
+				case MArgumentType::Integer: return planScalar(MArgumentType::Integer, *std::get_if<mint>(&value), name);
+				case MArgumentType::Real: return planScalar(MArgumentType::Real, *std::get_if<double>(&value), name);
+				case MArgumentType::Complex: return planScalar(MArgumentType::Complex, *std::get_if<std::complex<double>>(&value), name);
+				case MArgumentType::Tensor: return plan(*std::get_if<GenericTensor>(&value), name, opts);
+				case MArgumentType::SparseArray: return plan(*std::get_if<GenericSparseArray>(&value), name);
+				case MArgumentType::NumericArray: return plan(*std::get_if<GenericNumericArray>(&value), name, opts);
+				case MArgumentType::Image: return plan(*std::get_if<GenericImage>(&value), name, opts);
+				case MArgumentType::UTF8String: {
+					Plan p;
+					auto str = *std::get_if<std::string_view>(&value);
+					p.header.type = static_cast<std::uint32_t>(MArgumentType::UTF8String);
+					p.name = name;
+					p.pieces.push_back({str.data(), str.size()});
+					finish(p, true);
+					return p;
+				}
+				case MArgumentType::DataStore: return plan(*std::get_if<GenericDataList>(&value), name, opts);
+				default: ErrorManager::throwException(ErrorName::DLInvalidNodeType);
+			}
+		}
+
+		void padTo(BinaryFileWriter& out, std::uint64_t position) {
+			static constexpr std::array<std::byte, alignment> zeros {};
+			while (out.bytesWritten() < position) {
+				out.write(zeros.data(), static_cast<std::size_t>(std::min<std::uint64_t>(zeros.size(), position - out.bytesWritten())));
+			}
+		}
+
+		void write(BinaryFileWriter& out, const Plan& p) {
+			const auto start = out.bytesWritten();
+			out.write(&p.header, 1);
+			out.write(p.dims.data(), p.dims.size());
+			out.write(p.name.data(), p.name.size());
+			padTo(out, start + p.header.payloadOffset);
+			const auto payloadStart = out.bytesWritten();
+			for (const auto& piece : p.pieces) {
+				padTo(out, payloadStart + alignUp(out.bytesWritten() - payloadStart));
+				out.write(piece.data, piece.size);
+			}
+			for (const auto& child : p.children) {
+				write(out, child);
+			}
+			padTo(out, start + p.header.nodeSize);
+		}
+
+		void serializePlan(const std::string& fileName, const Plan& root) {
+			FileHeader header {};
+			std::memcpy(header.magic, magic, sizeof(magic));
+			header.version = version;
+			header.byteOrderMark = byteOrderMark;
+			header.mintSize = sizeof(mint);
+			header.rootOffset = sizeof(FileHeader);
+			BinaryFileWriter out {fileName};
+			out.write(&header, 1);
+			write(out, root);
+			out.close();
+		}
+
+		[[noreturn]] void throwInvalidData(const std::string& fileName, const std::string& reason) {
+			ErrorManager::throwException(ErrorName::InvalidSerializedData, fileName, reason);
+		}
+	}  // namespace
+
+	void serialize(const std::string& fileName, const Argument::TypedArgument& value, const SerializeOptions& opts) {
+		serializePlan(fileName, plan(value, {}, opts));
+	}
+
+	void serialize(const std::string& fileName, const GenericTensor& t, const SerializeOptions& opts) {
+		serializePlan(fileName, plan(t, {}, opts));
+	}
+
+	void serialize(const std::string& fileName, const GenericNumericArray& na, const SerializeOptions& opts) {
+		serializePlan(fileName, plan(na, {}, opts));
+	}
+
+	void serialize(const std::string& fileName, const GenericImage& im, const SerializeOptions& opts) {
+		serializePlan(fileName, plan(im, {}, opts));
+	}
+
+	void serialize(const std::string& fileName, const GenericSparseArray& sa, const SerializeOptions& /*opts*/) {
+		serializePlan(fileName, plan(sa, {}));
+	}
+
+	void serialize(const std::string& fileName, const GenericDataList& dl, const SerializeOptions& opts) {
+		serializePlan(fileName, plan(dl, {}, opts));
+	}
+
+	SerializedNode::SerializedNode(std::shared_ptr<const MappedFile> mapping, std::shared_ptr<const std::string> path, std::size_t position)
+		: file {std::move(mapping)}, fileName {std::move(path)}, offset {position} {
+		validate();
+	}
+
+	void SerializedNode::validate() const {
+		if (offset % alignment != 0 || offset > file->size() || file->size() - offset < sizeof(NodeHeader)) {
+			throwInvalid("node header out of range");
+		}
+		const auto& h = header();
+		const auto available = file->size() - offset;
+		const auto headerEnd = sizeof(NodeHeader) + std::uint64_t {h.rank} * sizeof(std::int64_t) + h.nameLength + 1;
+		if (h.nodeSize > available || h.nodeSize % alignment != 0 || h.payloadOffset % alignment != 0 || h.payloadOffset < headerEnd ||
+			h.payloadOffset > h.nodeSize || h.payloadSize > h.nodeSize - h.payloadOffset) {
+			throwInvalid("inconsistent node header");
+		}
+		const bool arrayQ = type() == MArgumentType::Tensor || type() == MArgumentType::NumericArray || type() == MArgumentType::Image;
+		if ((h.flags & ~compressedPayloadFlag) != 0 || (compressedQ() && !arrayQ)) {
+			throwInvalid("invalid node flags");
+		}
+		if (*(file->data() + offset + headerEnd - 1) != std::byte {0}) {
+			throwInvalid("node name is not null-terminated");
+		}
+		if (type() == MArgumentType::UTF8String && h.payloadSize == h.nodeSize - h.payloadOffset) {
+			throwInvalid("string is not null-terminated");
+		}
+	}
+
+	void SerializedNode::throwInvalid(const std::string& reason) const {
+		throwInvalidData(*fileName, reason);
+	}
+
+	std::string_view SerializedNode::name() const noexcept {
+		const auto* p = file->data() + offset + sizeof(NodeHeader) + header().rank * sizeof(std::int64_t);
+		return {reinterpret_cast<const char*>(p), header().nameLength};	   // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+	}
+
+	MArrayDimensions SerializedNode::dimensions() const {
+		std::vector<std::int64_t> dims(header().rank);
+		if (dims.empty()) {
+			return {};
+		}
+		std::memcpy(dims.data(), file->data() + offset + sizeof(NodeHeader), dims.size() * sizeof(std::int64_t));
+		return MArrayDimensions {dims};
+	}
+
+	std::vector<SerializedNode> SerializedNode::children() const {
+		std::vector<SerializedNode> result;
+		if (type() != MArgumentType::DataStore) {
+			return result;
+		}
+		auto position = offset + static_cast<std::size_t>(header().payloadOffset);
+		const auto end = position + static_cast<std::size_t>(header().payloadSize);
+		for (mint i = 0; i < length(); ++i) {
+			if (position >= end) {
+				throwInvalid("DataList is shorter than its declared length");
+			}
+			SerializedNode child {file, fileName, position};
+			position += static_cast<std::size_t>(child.header().nodeSize);
+			if (position > end) {
+				throwInvalid("DataList node out of range");
+			}
+			result.push_back(std::move(child));
+		}
+		return result;
+	}
+
+	Argument::TypedArgument SerializedNode::value() const {
+		const auto& h = header();
+		auto copyPayload = [&](void* destination, std::size_t bytes, std::size_t at = 0) {
+			if (compressedQ()) {
+				Compression::decompress(reinterpret_cast<const std::uint8_t*>(payload()), static_cast<std::size_t>(h.payloadSize), destination, bytes);	// NOLINT
+				return;
+			}
+			if (at > h.payloadSize || bytes > h.payloadSize - at) {
+				throwInvalid("payload is too short");
+			}
+			if (bytes > 0) {
+				std::memcpy(destination, payload() + at, bytes);
+			}
+		};
+		// the dimensions are untrusted, so the number of elements is computed with overflow checks before MArrayDimensions multiplies them
+		// and the size of every array is checked against the payload before the array is allocated
+		std::size_t elementCount = 1;
+		for (std::size_t i = 0; i < h.rank; ++i) {
+			std::int64_t d {};
+			std::memcpy(&d, file->data() + offset + sizeof(NodeHeader) + i * sizeof(std::int64_t), sizeof(d));
+			if (!checkedMultiply(elementCount, d)) {
+				throwInvalid("array dimensions are negative or too large");
+			}
+		}
+		auto arrayBytes = [&](std::size_t elementSize, std::initializer_list<std::int64_t> factors = {}) {
+			std::size_t bytes = elementCount;
+			bool ok = checkedMultiply(bytes, static_cast<std::int64_t>(elementSize));
+			for (auto factor : factors) {
+				ok = ok && checkedMultiply(bytes, factor);
+			}
+			if (!ok) {
+				throwInvalid("array dimensions are negative or too large");
+			}
+			return bytes;
+		};
+		auto checkPayloadSize = [&](std::size_t expected) {
+			const auto actual =
+				compressedQ() ? Compression::decompressedSize(reinterpret_cast<const std::uint8_t*>(payload()), static_cast<std::size_t>(h.payloadSize))	// NOLINT
+							  : h.payloadSize;
+			if (actual != expected) {
+				throwInvalid("payload size does not match the dimensions");
+			}
+		};
+		auto dims = dimensions();
+		switch (type()) {
+			case MArgumentType::Boolean: {
+				std::int64_t b {};
+				copyPayload(&b, sizeof(b));
+				return b != 0;
+			}
+			case MArgumentType::Integer: {
+				mint i {};
+				copyPayload(&i, sizeof(i));
+				return i;
+			}
+			case MArgumentType::Real: {
+				double d {};
+				copyPayload(&d, sizeof(d));
+				return d;
+			}
+			case MArgumentType::Complex: {
+				std::complex<double> c {};
+				copyPayload(&c, sizeof(c));
+				return c;
+			}
+			case MArgumentType::UTF8String:
+				return std::string_view {reinterpret_cast<const char*>(payload()), static_cast<std::size_t>(h.payloadSize)};	// NOLINT
+			case MArgumentType::Tensor: {
+				checkPayloadSize(arrayBytes(tensorElementSize(h.elementType)));
+				GenericTensor t {static_cast<mint>(h.elementType), dims.rank(), dims.data()};
+				copyPayload(t.rawData(), static_cast<std::size_t>(t.getFlattenedLength()) * tensorElementSize(h.elementType));
+				return t;
+			}
+			case MArgumentType::NumericArray: {
+				checkPayloadSize(arrayBytes(numericArrayElementSize(h.elementType)));
+				GenericNumericArray na {static_cast<numericarray_data_t>(h.elementType), dims.rank(), dims.data()};
+				copyPayload(na.rawData(), static_cast<std::size_t>(na.getFlattenedLength()) * numericArrayElementSize(h.elementType));
+				return na;
+			}
+			case MArgumentType::Image: {
+				if (dims.rank() != 2 && dims.rank() != 3) {
+					throwInvalid("Image must have rank 2 or 3");
+				}
+				checkPayloadSize(arrayBytes(imageElementSize(h.elementType), {channels()}));
+				const mint slices = dims.rank() == 3 ? dims.get(0) : 0;
+				GenericImage im {slices,
+								 dims.get(dims.rank() - 1),
+								 dims.get(dims.rank() - 2),
+								 channels(),
+								 static_cast<imagedata_t>(h.elementType),
+								 colorspace(),
+								 static_cast<mbool>(interleavedQ())};
+				copyPayload(im.rawData(), static_cast<std::size_t>(im.getFlattenedLength()) * imageElementSize(h.elementType));
+				return im;
+			}
+			case MArgumentType::SparseArray: {
+				const auto elementSize = tensorElementSize(h.elementType);
+				const mint count = h.extra[0];
+				const mint rank = dims.rank();
+				std::size_t positionsSize = sizeof(mint);
+				std::size_t valuesSize = elementSize;
+				if (!checkedMultiply(positionsSize, count) || !checkedMultiply(positionsSize, rank) || !checkedMultiply(valuesSize, count) ||
+					valuesSize > std::numeric_limits<std::size_t>::max() - 2 * alignment ||
+					positionsSize > std::numeric_limits<std::size_t>::max() - 2 * alignment - valuesSize) {
+					throwInvalid("number of explicit values is negative or too large");
+				}
+				const auto positionsAt = alignUp(elementSize);
+				checkPayloadSize(count > 0 ? alignUp(positionsAt + positionsSize) + valuesSize : elementSize);
+				GenericTensor implicitValue {static_cast<mint>(h.elementType), 0, nullptr};
+				copyPayload(implicitValue.rawData(), elementSize);
+				std::array<mint, 2> positionDims {count, rank};
+				GenericTensor positions {MType_Integer, 2, positionDims.data()};
+				GenericTensor values {static_cast<mint>(h.elementType), 1, &count};
+				if (count > 0) {
+					copyPayload(positions.rawData(), positionsSize, positionsAt);
+					copyPayload(values.rawData(), valuesSize, alignUp(positionsAt + positionsSize));
+				}
+				GenericTensor dimensionsTensor {MType_Integer, 1, &rank};
+				std::copy(dims.data(), dims.data() + rank, static_cast<mint*>(dimensionsTensor.rawData()));
+				return GenericSparseArray {positions, values, dimensionsTensor, implicitValue};
+			}
+			case MArgumentType::DataStore: {
+				GenericDataList dl;
+				for (const auto& child : children()) {
+					dl.push_back(child.name(), child.value());
+				}
+				return dl;
+			}
+			default: throwInvalid("unknown node type");
+		}
+	}
+
+	SerializedFile::SerializedFile(const std::string& fileName)
+		: mapping {std::make_shared<const MappedFile>(fileName)}, name {std::make_shared<const std::string>(fileName)} {
+		if (mapping->size() < sizeof(FileHeader)) {
+			throwInvalidData(fileName, "file is too short");
+		}
+		FileHeader header {};
+		std::memcpy(&header, mapping->data(), sizeof(header));
+		if (std::memcmp(header.magic, magic, sizeof(magic)) != 0) {
+			throwInvalidData(fileName, "not an LLU serialized file");
+		}
+		if (header.version != version) {
+			throwInvalidData(fileName, "unsupported version " + std::to_string(header.version));
+		}
+		if (header.byteOrderMark != byteOrderMark || header.mintSize != sizeof(mint)) {
+			throwInvalidData(fileName, "file was written on an incompatible architecture");
+		}
+	}
+
+	SerializedNode SerializedFile::root() const {
+		FileHeader header {};
+		std::memcpy(&header, mapping->data(), sizeof(header));
+		return SerializedNode {mapping, name, static_cast<std::size_t>(header.rootOffset)};
+	}
+
+	Argument::TypedArgument deserialize(const std::string& fileName) {
+		SerializedFile file {fileName};
+		auto root = file.root();
+		if (root.type() == MArgumentType::UTF8String) {
+			throwInvalidData(fileName, "a string cannot be loaded outside of a DataList, use SerializedFile instead");
+		}
+		return root.value();
+	}
+}  // namespace LLU::Serialization
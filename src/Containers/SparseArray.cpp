@@ -44,7 +44,7 @@ namespace LLU {
 	}
 
 	GenericTensor GenericSparseArray::getImplicitValueAsTensor() const {
-		if (auto* implValue = LibraryData::SparseArrayAPI()->MSparseArray_getImplicitValue(this->getContainer()); implValue) {
+		if (auto* implValue = LibraryData::uncheckedSparseArrayAPI()->MSparseArray_getImplicitValue(this->getContainer()); implValue) {
 			return {*implValue, Ownership::LibraryLink};
 		}
 		ErrorManager::throwException(ErrorName::SparseArrayImplicitValueError);
@@ -59,21 +59,21 @@ namespace LLU {
 	}
 
 	GenericTensor MContainer<MArgumentType::SparseArray>::getExplicitValues() const {
-		if (auto* explicitValues = LibraryData::SparseArrayAPI()->MSparseArray_getExplicitValues(this->getContainer()); explicitValues) {
+		if (auto* explicitValues = LibraryData::uncheckedSparseArrayAPI()->MSparseArray_getExplicitValues(this->getContainer()); explicitValues) {
 			return {*explicitValues, Ownership::LibraryLink};
 		}
 		ErrorManager::throwException(ErrorName::SparseArrayExplicitValuesError);
 	}
 
 	GenericTensor MContainer<MArgumentType::SparseArray>::getRowPointers() const {
-		if (auto* rowPointers = LibraryData::SparseArrayAPI()->MSparseArray_getRowPointers(this->getContainer()); rowPointers) {
+		if (auto* rowPointers = LibraryData::uncheckedSparseArrayAPI()->MSparseArray_getRowPointers(this->getContainer()); rowPointers) {
 			return {*rowPointers, Ownership::LibraryLink};
 		}
 		ErrorManager::throwException(ErrorName::SparseArrayRowPointersError);
 	}
 
 	GenericTensor MContainer<MArgumentType::SparseArray>::getColumnIndices() const {
-		if (auto* colIndices = LibraryData::SparseArrayAPI()->MSparseArray_getColumnIndices(this->getContainer()); colIndices) {
+		if (auto* colIndices = LibraryData::uncheckedSparseArrayAPI()->MSparseArray_getColumnIndices(this->getContainer()); colIndices) {
 			return {*colIndices, Ownership::LibraryLink};
 		}
 		ErrorManager::throwException(ErrorName::SparseArrayColumnIndicesError);
@@ -81,7 +81,7 @@ namespace LLU {
 
 	GenericTensor MContainer<MArgumentType::SparseArray>::getExplicitPositions() const {
 		MTensor mt {};
-		if (0 != LibraryData::SparseArrayAPI()->MSparseArray_getExplicitPositions(getContainer(), &mt)) {
+		if (0 != LibraryData::uncheckedSparseArrayAPI()->MSparseArray_getExplicitPositions(getContainer(), &mt)) {
 			ErrorManager::throwException(ErrorName::SparseArrayExplicitPositionsError);
 		}
 		return {mt, Ownership::Library};
@@ -23,9 +23,9 @@ namespace LLU {
 
 	void* GenericTensor::rawData() const {
 		switch (type()) {
-			case MType_Integer: return LibraryData::API()->MTensor_getIntegerData(this->getContainer());
-			case MType_Real: return LibraryData::API()->MTensor_getRealData(this->getContainer());
-			case MType_Complex: return LibraryData::API()->MTensor_getComplexData(this->getContainer());
+			case MType_Integer: return LibraryData::uncheckedAPI()->MTensor_getIntegerData(this->getContainer());
+			case MType_Real: return LibraryData::uncheckedAPI()->MTensor_getRealData(this->getContainer());
+			case MType_Complex: return LibraryData::uncheckedAPI()->MTensor_getComplexData(this->getContainer());
 			default: ErrorManager::throwException(ErrorName::TensorTypeError);
 		}
 	}
@@ -41,18 +41,18 @@ namespace LLU {
 	/// @cond
 	template<>
 	mint* TypedTensor<mint>::getData() const noexcept {
-		return LibraryData::API()->MTensor_getIntegerData(this->getInternal());
+		return LibraryData::uncheckedAPI()->MTensor_getIntegerData(this->getInternal());
 	}
 
 	template<>
 	double* TypedTensor<double>::getData() const noexcept {
-		return LibraryData::API()->MTensor_getRealData(this->getInternal());
+		return LibraryData::uncheckedAPI()->MTensor_getRealData(this->getInternal());
 	}
 
 	template<>
 	std::complex<double>* TypedTensor<std::complex<double>>::getData() const noexcept {
 		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): std::complex<double> is binary compatible with mcomplex
-		return reinterpret_cast<std::complex<double>*>(LibraryData::API()->MTensor_getComplexData(this->getInternal()));
+		return reinterpret_cast<std::complex<double>*>(LibraryData::uncheckedAPI()->MTensor_getComplexData(this->getInternal()));
 	}
 	/// @endcond
 } /* namespace LLU */
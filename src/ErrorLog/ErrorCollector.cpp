@@ -0,0 +1,107 @@
+/**
+ * @file	ErrorCollector.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief	Implementation of the ErrorCollector class.
+ */
+#include "LLU/ErrorLog/ErrorCollector.h"
+
+#include "LLU/WSTP/WSStream.hpp"
+
+namespace LLU {
+
+	namespace {
+		void putRecords(WSStream<WS::Encoding::UTF8>& ms, const std::vector<ErrorCollector::Record>& records) {
+			ms << WS::List(static_cast<int>(records.size()));
+			for (const auto& r : records) {
+				ms << WS::List(3) << static_cast<wsint64>(r.errorId) << static_cast<wsint64>(r.index);
+				if (r.params) {
+					r.params->send(ms);
+				} else {
+					ms << WS::List(0);
+				}
+			}
+		}
+	}  // namespace
+
+	void ErrorCollector::add(const LibraryLinkError& e, mint index) {
+		push(Record {e.id(), index, e.messageParams});
+	}
+
+	void ErrorCollector::push(Record record) {
+		std::lock_guard<std::mutex> lock {mutex};
+		if (errors.size() < limit) {
+			errors.push_back(std::move(record));
+		} else {
+			++dropped;
+		}
+	}
+
+	std::size_t ErrorCollector::size() const {
+		std::lock_guard<std::mutex> lock {mutex};
+		return errors.size();
+	}
+
+	std::size_t ErrorCollector::droppedCount() const {
+		std::lock_guard<std::mutex> lock {mutex};
+		return dropped;
+	}
+
+	auto ErrorCollector::records() const -> std::vector<Record> {
+		std::lock_guard<std::mutex> lock {mutex};
+		return errors;
+	}
+
+	void ErrorCollector::clear() {
+		std::lock_guard<std::mutex> lock {mutex};
+		errors.clear();
+		dropped = 0;
+	}
+
+	Tensor<mint> ErrorCollector::toTensor() const {
+		std::lock_guard<std::mutex> lock {mutex};
+		Tensor<mint> res {Uninitialized, {static_cast<mint>(errors.size()), 2}};
+		auto* out = res.data();
+		for (const auto& r : errors) {
+			*out++ = r.errorId;
+			*out++ = r.index;
+		}
+		return res;
+	}
+
+	void ErrorCollector::put(WSLINK link) const {
+		WSStream<WS::Encoding::UTF8> ms {link};
+		putRecords(ms, records());
+	}
+
+	std::string ErrorCollector::getCollectedFailuresSymbol() {
+		return LibraryLinkError::getExceptionDetailsSymbolContext() + collectedFailuresSymbol;
+	}
+
+	LibraryLinkError::IdType ErrorCollector::sendFailures(WolframLibraryData libData) const noexcept {
+		try {
+			if (libData) {
+				auto collected = records();
+				WSStream<WS::Encoding::UTF8> ms {libData->getWSLINK(libData)};
+				ms << WS::Function("EvaluatePacket", 1) << WS::Function("CompoundExpression", 2);
+				ms << WS::Function("Set", 2) << WS::Symbol(getCollectedFailuresSymbol());
+				putRecords(ms, collected);
+				ms << WS::Null;
+				libData->processWSLINK(ms.get());
+				auto pkt = WSNextPacket(ms.get());
+				if (pkt == RETURNPKT) {
+					ms << WS::NewPacket;
+				}
+				for (const auto& r : collected) {
+					if (r.params) {
+						r.params->sent.store(true, std::memory_order_relaxed);
+					}
+				}
+			}
+		} catch (const LibraryLinkError& e) {
+			return e.which();
+		} catch (...) {
+			return ErrorCode::FunctionError;
+		}
+		return ErrorCode::NoError;
+	}
+}  // namespace LLU
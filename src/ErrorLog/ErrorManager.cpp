@@ -107,6 +107,7 @@ namespace LLU {
 			{ErrorName::DLGetNodeDataError, "DataStoreNode_getData failed"},
 			{ErrorName::DLSharedDataStore, "Trying to create a Shared DataStore. DataStore can only be passed as Automatic or Manual."},
 			{ErrorName::DLPushBackTypeError, "Element to be added to the DataList has incorrect type"},
+			{ErrorName::DLNodeNotFound, "DataList has no node with requested name or index"},
 
 			// MArgument errors:
 			{ErrorName::ArgumentCreateNull, "Trying to create PrimitiveWrapper object from nullptr"},
@@ -124,34 +125,83 @@ namespace LLU {
 			{ErrorName::PathNotValidated, "File path `path` could not be validated under desired open mode."},
 			{ErrorName::InvalidOpenMode, "Specified open mode is invalid."},
 			{ErrorName::OpenFileFailed,	"Could not open file `f`."},
+			{ErrorName::InvalidEncoding, "Invalid `encoding` string, conversion failed at code unit `position`."},
+			{ErrorName::MapFileFailed, "Could not map file `f` into memory."},
+			{ErrorName::ReadFileFailed, "Could not read from file `f`."},
+			{ErrorName::NumberParseFailed, "Invalid number `token` at byte `position`."},
+			{ErrorName::WriteFileFailed, "Could not write to file `f`."},
+			{ErrorName::InvalidSerializedData, "Invalid serialized data in file `f`: `reason`."},
+
+			// Compression errors:
+			{ErrorName::UnknownCodec, "No compression codec with id `id` is registered."},
+			{ErrorName::CompressionFailed, "Compression codec `id` failed."},
+			{ErrorName::InvalidCompressedData, "Invalid compressed data: `reason`."},
+
+			// Background task errors:
+			{ErrorName::AsyncTaskCreateError, "Could not create an asynchronous task."},
 		});
 		return errMap;
 	}
 
 	bool ErrorManager::sendParametersImmediately = true;
 
+	thread_local int ErrorManager::deferralDepth = 0;
+
+	std::vector<const LibraryLinkError*>& ErrorManager::errorIndex() {
+		static std::vector<const LibraryLinkError*> index = [] {
+			std::vector<const LibraryLinkError*> res;
+			for (const auto& err : errors()) {
+				addToIndex(res, err.second);
+			}
+			return res;
+		}();
+		return index;
+	}
+
+	void ErrorManager::addToIndex(std::vector<const LibraryLinkError*>& index, const LibraryLinkError& error) {
+		const auto pos = static_cast<std::size_t>(ErrorCode::VersionError - error.id());
+		if (pos >= index.size()) {
+			index.resize(pos + 1, nullptr);
+		}
+		index[pos] = &error;
+	}
+
 	int& ErrorManager::nextErrorId() {
 		static int id = ErrorCode::VersionError;
 		return id;
 	}
 
-	auto ErrorManager::registerLLUErrors(std::initializer_list<ErrorStringData> initList) -> ErrorMap {
+	std::unordered_map<const std::string*, int>& ErrorManager::internedErrors() {
+		static std::unordered_map<const std::string*, int> interned;
+		return interned;
+	}
+
+	auto ErrorManager::registerLLUErrors(std::initializer_list<BuiltinError> initList) -> ErrorMap {
 		ErrorMap e;
+		auto& interned = internedErrors();
 		for (auto&& err : initList) {
-			e.emplace(err.first, LibraryLinkError {nextErrorId()--, err.first, err.second});
+			const auto id = nextErrorId()--;
+			e.emplace(err.name, LibraryLinkError {id, err.name, err.message});
+			interned.emplace(&err.name, id);
 		}
 		return e;
 	}
 
-	void ErrorManager::registerPacletErrors(const std::vector<ErrorStringData>& errors) {
+	auto ErrorManager::registerPacletErrors(const std::vector<ErrorStringData>& errors) -> std::vector<ErrorId> {
+		std::vector<ErrorId> ids;
+		ids.reserve(errors.size());
 		for (auto&& err : errors) {
-			set(err);
+			ids.push_back(set(err));
 		}
+		return ids;
 	}
 
-	void ErrorManager::set(const ErrorStringData& errorData) {
+	auto ErrorManager::set(const ErrorStringData& errorData) -> ErrorId {
 		auto& errorMap = errors();
-		if (auto [elem, success] = errorMap.emplace(errorData.first, LibraryLinkError {nextErrorId()--, errorData.first, errorData.second}); !success) {
+		auto [elem, success] = errorMap.emplace(errorData.first, LibraryLinkError {nextErrorId()--, errorData.first, errorData.second});
+		if (success) {
+			addToIndex(errorIndex(), elem->second);
+		} else {
 			// Revert nextErrorId because nothing was inserted
 			nextErrorId()++;
 
@@ -160,18 +210,25 @@ namespace LLU {
 				throw errors().find("ErrorManagerCreateNameError")->second;
 			}
 		}
+		return static_cast<ErrorId>(elem->second.id());
 	}
 
 	const LibraryLinkError& ErrorManager::findError(int errorId) {
-		for (auto&& err : errors()) {
-			if (err.second.id() == errorId) {
-				return err.second;
+		const auto& index = errorIndex();
+		if (errorId <= ErrorCode::VersionError) {
+			const auto pos = static_cast<std::size_t>(ErrorCode::VersionError - errorId);
+			if (pos < index.size() && index[pos]) {
+				return *index[pos];
 			}
 		}
 		throw errors().find("ErrorManagerThrowIdError")->second;
 	}
 
 	const LibraryLinkError& ErrorManager::findError(const std::string& errorName) {
+		const auto& interned = internedErrors();
+		if (auto builtin = interned.find(&errorName); builtin != interned.end()) {
+			return findError(builtin->second);
+		}
 		const auto& exception = errors().find(errorName);
 		if (exception == errors().end()) {
 			throw errors().find("ErrorManagerThrowNameError")->second;
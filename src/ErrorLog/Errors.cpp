@@ -93,6 +93,7 @@ namespace LLU::ErrorName {
 	LLU_DEFINE_ERROR_NAME(DLGetNodeDataError);
 	LLU_DEFINE_ERROR_NAME(DLSharedDataStore);
 	LLU_DEFINE_ERROR_NAME(DLPushBackTypeError);
+	LLU_DEFINE_ERROR_NAME(DLNodeNotFound);
 
 	LLU_DEFINE_ERROR_NAME(ArgumentCreateNull);
 	LLU_DEFINE_ERROR_NAME(ArgumentAddNodeMArgument);
@@ -106,5 +107,17 @@ namespace LLU::ErrorName {
 	LLU_DEFINE_ERROR_NAME(PathNotValidated);
 	LLU_DEFINE_ERROR_NAME(InvalidOpenMode);
 	LLU_DEFINE_ERROR_NAME(OpenFileFailed);
+	LLU_DEFINE_ERROR_NAME(InvalidEncoding);
+	LLU_DEFINE_ERROR_NAME(MapFileFailed);
+	LLU_DEFINE_ERROR_NAME(ReadFileFailed);
+	LLU_DEFINE_ERROR_NAME(NumberParseFailed);
+	LLU_DEFINE_ERROR_NAME(WriteFileFailed);
+	LLU_DEFINE_ERROR_NAME(InvalidSerializedData);
+
+	LLU_DEFINE_ERROR_NAME(UnknownCodec);
+	LLU_DEFINE_ERROR_NAME(CompressionFailed);
+	LLU_DEFINE_ERROR_NAME(InvalidCompressedData);
+
+	LLU_DEFINE_ERROR_NAME(AsyncTaskCreateError);
 	/// @endcond
 }	 // namespace LLU::ErrorName
@@ -27,60 +27,6 @@ namespace LLU {
 		return exceptionDetailsSymbolContext + exceptionDetailsSymbol;
 	}
 
-	WSLINK LibraryLinkError::openLoopback(WSENV env) {
-		int err = WSEUNKNOWN;
-		auto* link = WSLoopbackOpen(env, &err);
-		if (err != WSEOK) {
-			link = nullptr;
-		}
-		return link;
-	}
-
-	LibraryLinkError::LibraryLinkError(const LibraryLinkError& e) noexcept
-		: std::runtime_error(e), errorId(e.errorId), messageTemplate(e.messageTemplate), debugInfo(e.debugInfo) {
-		if (e.messageParams) {
-			messageParams = openLoopback(WSLinkEnvironment(e.messageParams));
-			if (!messageParams) {
-				return;
-			}
-			auto* mark = WSCreateMark(e.messageParams);
-			WSTransferToEndOfLoopbackLink(messageParams, e.messageParams);
-			WSSeekMark(e.messageParams, mark, 0);
-			WSDestroyMark(e.messageParams, mark);
-		}
-	}
-
-	LibraryLinkError& LibraryLinkError::operator=(const LibraryLinkError& e) noexcept {
-		LibraryLinkError tmp {e};
-		*this = std::move(tmp);
-		return *this;
-	}
-
-	LibraryLinkError::LibraryLinkError(LibraryLinkError&& e) noexcept
-		// NOLINTNEXTLINE(performance-move-constructor-init) : deliberate and harmless
-		: std::runtime_error(e), errorId(e.errorId), messageTemplate(e.messageTemplate), debugInfo(e.debugInfo), messageParams(e.messageParams) {
-		e.messageParams = nullptr;
-	}
-
-	LibraryLinkError& LibraryLinkError::operator=(LibraryLinkError&& e) noexcept {
-		std::runtime_error::operator=(e);
-		errorId = e.errorId;
-		messageTemplate = e.messageTemplate;
-		debugInfo = e.debugInfo;
-		if (messageParams) {
-			WSClose(messageParams);
-		}
-		messageParams = e.messageParams;
-		e.messageParams = nullptr;
-		return *this;
-	}
-
-	LibraryLinkError::~LibraryLinkError() {
-		if (messageParams) {
-			WSClose(messageParams);
-		}
-	}
-
 	auto LibraryLinkError::sendParameters(WolframLibraryData libData, const std::string& WLSymbol) const noexcept -> IdType {
 		try {
 			if (libData) {
@@ -88,8 +34,11 @@ namespace LLU {
 				mls << WS::Function("EvaluatePacket", 1);
 				mls << WS::Function("Set", 2);
 				mls << WS::Symbol(WLSymbol);
-				if (WSTransferToEndOfLoopbackLink(mls.get(), messageParams) == 0) {
-					return ErrorCode::FunctionError;
+				if (messageParams) {
+					messageParams->sent.store(true, std::memory_order_relaxed);
+					messageParams->send(mls);
+				} else {
+					mls << WS::List(0);
 				}
 				libData->processWSLINK(mls.get());
 				auto pkt = WSNextPacket(mls.get());
@@ -5,12 +5,80 @@
  */
 #include "LLU/ErrorLog/Logger.h"
 
+#include <vector>
+
+#include "LLU/Async/BoundedQueue.h"
 #include "LLU/LibraryLinkFunctionMacro.h"
 #include "LLU/MArgumentManager.h"
 
 namespace LLU {
 	std::mutex Logger::mlinkGuard;
 	std::string Logger::logSymbolContext;
+	std::atomic<bool> Logger::asyncMode {false};
+	std::atomic<Logger::Level> Logger::threshold {Logger::Level::Debug};
+	std::atomic<Logger::SecondsClock> Logger::rateLimiterClock {nullptr};
+
+	struct Logger::Queue : Async::BoundedQueue<std::unique_ptr<Record>, asyncQueueCapacity, Async::FullQueuePolicy::Reject> {};
+
+	Logger::Queue& Logger::pendingLogs() {
+		static Queue queue;
+		return queue;
+	}
+
+	namespace {
+		std::atomic<std::uint64_t> droppedLogs {0};
+	}  // namespace
+
+	void Logger::setAsync(bool async) {
+		if (!async) {
+			flush();
+		}
+		asyncMode.store(async, std::memory_order_relaxed);
+	}
+
+	void Logger::enqueue(std::unique_ptr<Record> record) noexcept {
+		if (!pendingLogs().tryPush(record)) {
+			droppedLogs.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	std::uint64_t Logger::droppedCount() noexcept {
+		return droppedLogs.load(std::memory_order_relaxed);
+	}
+
+	void Logger::flush() noexcept {
+		flush(LibraryData::API());
+	}
+
+	void Logger::flush(WolframLibraryData libData) noexcept {
+		if (!libData || pendingLogs().empty()) {
+			return;
+		}
+		try {
+			std::lock_guard<std::mutex> lock(mlinkGuard);
+			std::vector<std::unique_ptr<Record>> batch;
+			std::unique_ptr<Record> record;
+			while (batch.size() < asyncQueueCapacity && pendingLogs().tryPop(record)) {
+				batch.push_back(std::move(record));
+			}
+			if (batch.empty()) {
+				return;
+			}
+			WSStream<WS::Encoding::UTF8> mls {libData->getWSLINK(libData)};
+			mls << WS::Function("EvaluatePacket", 1) << WS::Function("CompoundExpression", static_cast<int>(batch.size()) + 1);
+			for (const auto& r : batch) {
+				r->send(mls);
+			}
+			mls << WS::Null;
+			libData->processWSLINK(mls.get());
+			auto pkt = WSNextPacket(mls.get());
+			if (pkt == RETURNPKT) {
+				mls << WS::NewPacket;
+			}
+		} catch (...) {
+			// logging must never turn a successful library function call into a failure
+		}
+	}
 
 	std::string Logger::to_string(Level l) {
 		switch (l) {
@@ -37,4 +105,51 @@ namespace LLU {
 		}
 		return err;
 	}
+
+	/**
+	 * LibraryLink function that switches the Logger between sending logs immediately and queueing them, see Logger::setAsync.
+	 * Returns the previous mode.
+	 */
+	LIBRARY_LINK_FUNCTION(setLoggerAsync) {
+		auto err = ErrorCode::NoError;
+		try {
+			MArgumentManager mngr {libData, Argc, Args, Res};
+			auto wasAsync = Logger::isAsync();
+			Logger::setAsync(mngr.getBoolean(0));
+			mngr.setBoolean(wasAsync);
+		} catch (LibraryLinkError& e) { err = e.which(); } catch (...) {
+			err = ErrorCode::FunctionError;
+		}
+		return err;
+	}
+
+	/**
+	 * LibraryLink function that sets the lowest severity of logs that are sent, see Logger::setThreshold.
+	 * Takes and returns the previous threshold as an integer: 0 for Debug, 1 for Warning and 2 for Error.
+	 */
+	LIBRARY_LINK_FUNCTION(setLoggerThreshold) {
+		auto err = ErrorCode::NoError;
+		try {
+			MArgumentManager mngr {libData, Argc, Args, Res};
+			auto level = mngr.getInteger<mint>(0);
+			if (level < static_cast<mint>(Logger::Level::Debug) || level > static_cast<mint>(Logger::Level::Error)) {
+				ErrorManager::throwExceptionWithDebugInfo(ErrorName::FunctionError, "Invalid log level " + std::to_string(level));
+			}
+			auto previous = Logger::getThreshold();
+			Logger::setThreshold(static_cast<Logger::Level>(level));
+			mngr.setInteger(static_cast<mint>(previous));
+		} catch (LibraryLinkError& e) { err = e.which(); } catch (...) {
+			err = ErrorCode::FunctionError;
+		}
+		return err;
+	}
+
+	/**
+	 * LibraryLink function that sends all queued logs to the Kernel, see Logger::flush.
+	 */
+	LIBRARY_LINK_FUNCTION(flushLogs) {
+		Unused(Argc, Args, Res);
+		Logger::flush(libData);
+		return ErrorCode::NoError;
+	}
 }	 // namespace LLU
\ No newline at end of file
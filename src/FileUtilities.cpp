@@ -7,8 +7,17 @@
 #include "LLU/NoMinMaxWindows.h"
 #include "LLU/FileUtilities.h"
 
+#include <algorithm>
+#include <utility>
+
 #ifdef _WIN32
 #include <share.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 #include "LLU/ErrorLog/ErrorManager.h"
@@ -59,6 +68,12 @@ namespace LLU {
 		}
 	}  // namespace
 
+	namespace Detail {
+		void throwConversionError(const std::string& encoding, std::size_t position) {
+			ErrorManager::throwException(ErrorName::InvalidEncoding, encoding, static_cast<mint>(position));
+		}
+	}  // namespace Detail
+
 	FilePtr claimFile(std::FILE* f) {
 		return FilePtr(f, [](std::FILE* fp) { return fp ? std::fclose(fp) : 0; });
 	}
@@ -112,4 +127,164 @@ namespace LLU {
 		return openFileStream<char>(fileName, mode, shp);
 	}
 
+#ifdef _WIN32
+	namespace {
+		/// Translate sharing constants used by _wfsopen to the share mode of CreateFileW
+		DWORD shareMode(const SharePolicy& shp, std::ios::openmode mode) {
+			switch (shp.flag(mode)) {
+				case _SH_DENYNO: return FILE_SHARE_READ | FILE_SHARE_WRITE;
+				case _SH_DENYWR: return FILE_SHARE_READ;
+				case _SH_DENYRD: return FILE_SHARE_WRITE;
+				case _SH_DENYRW: return 0;
+				default: return (mode & std::ios::out) != 0 ? 0 : FILE_SHARE_READ;
+			}
+		}
+
+		/// Closes a Windows handle at the end of scope
+		struct HandleGuard {
+			HANDLE h;
+			~HandleGuard() {
+				if (h != nullptr && h != INVALID_HANDLE_VALUE) {
+					CloseHandle(h);
+				}
+			}
+		};
+	}  // namespace
+#endif /* _WIN32 */
+
+	MappedFile::MappedFile(const std::string& fileName, std::ios::openmode mode, const SharePolicy& shp) {
+		mode &= ~std::ios::binary;
+		if (mode != std::ios::in && mode != (std::ios::in | std::ios::out)) {
+			ErrorManager::throwException(ErrorName::InvalidOpenMode);
+		}
+		validatePath(fileName, mode);
+		writable = (mode & std::ios::out) != 0;
+#ifdef _WIN32
+		std::wstring fileNameUTF16 = fromUTF8toUTF16<wchar_t>(fileName);
+		HandleGuard file {CreateFileW(fileNameUTF16.c_str(), writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ, shareMode(shp, mode), nullptr,
+									  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr)};
+		LARGE_INTEGER fileSize {};
+		if (file.h == INVALID_HANDLE_VALUE || GetFileSizeEx(file.h, &fileSize) == 0) {
+			ErrorManager::throwException(ErrorName::OpenFileFailed, fileName);
+		}
+		length = static_cast<std::size_t>(fileSize.QuadPart);
+		if (length == 0) {
+			return;
+		}
+		HandleGuard mapping {CreateFileMappingW(file.h, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr)};
+		void* view = mapping.h ? MapViewOfFile(mapping.h, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0) : nullptr;
+		if (view == nullptr) {
+			length = 0;
+			ErrorManager::throwException(ErrorName::MapFileFailed, fileName);
+		}
+#else
+		Unused(shp);
+		int fd = ::open(fileName.c_str(), writable ? O_RDWR : O_RDONLY);
+		struct stat fileStats {};
+		if (fd < 0 || ::fstat(fd, &fileStats) != 0) {
+			if (fd >= 0) {
+				::close(fd);
+			}
+			ErrorManager::throwException(ErrorName::OpenFileFailed, fileName);
+		}
+		length = static_cast<std::size_t>(fileStats.st_size);
+		if (length == 0) {
+			::close(fd);
+			return;
+		}
+		void* view = ::mmap(nullptr, length, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+		// the mapping keeps the file open, so the descriptor is not needed anymore
+		::close(fd);
+		if (view == MAP_FAILED) {
+			length = 0;
+			ErrorManager::throwException(ErrorName::MapFileFailed, fileName);
+		}
+#endif /* _WIN32 */
+		address = static_cast<std::byte*>(view);
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+		: address {std::exchange(other.address, nullptr)}, length {std::exchange(other.length, 0)}, writable {std::exchange(other.writable, false)} {}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+		if (this != &other) {
+			unmap();
+			address = std::exchange(other.address, nullptr);
+			length = std::exchange(other.length, 0);
+			writable = std::exchange(other.writable, false);
+		}
+		return *this;
+	}
+
+	MappedFile::~MappedFile() {
+		unmap();
+	}
+
+	void MappedFile::unmap() noexcept {
+		if (address != nullptr) {
+#ifdef _WIN32
+			UnmapViewOfFile(address);
+#else
+			::munmap(address, length);
+#endif
+		}
+		address = nullptr;
+		length = 0;
+	}
+
+	std::byte* MappedFile::writableData() {
+		if (!writable) {
+			ErrorManager::throwExceptionWithDebugInfo(ErrorName::InvalidOpenMode, "The file was mapped read-only.");
+		}
+		return address;
+	}
+
+	void MappedFile::advise(AccessHint hint, std::size_t offset, std::size_t count) const noexcept {
+		if (offset >= length) {
+			return;
+		}
+		count = std::min(count, length - offset);
+#ifdef _WIN32
+		if (hint == AccessHint::WillNeed) {
+			WIN32_MEMORY_RANGE_ENTRY range {address + offset, count};
+			PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+		}
+#else
+		// madvise requires a page-aligned address
+		static const auto pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+		auto alignedOffset = offset - offset % pageSize;
+		int advice = MADV_NORMAL;
+		switch (hint) {
+			case AccessHint::Normal: advice = MADV_NORMAL; break;
+			case AccessHint::Sequential: advice = MADV_SEQUENTIAL; break;
+			case AccessHint::Random: advice = MADV_RANDOM; break;
+			case AccessHint::WillNeed: advice = MADV_WILLNEED; break;
+		}
+		::madvise(address + alignedOffset, count + (offset - alignedOffset), advice);
+#endif
+	}
+
+	void MappedFile::flush() const {
+		if (!writable || address == nullptr) {
+			return;
+		}
+#ifdef _WIN32
+		bool ok = FlushViewOfFile(address, 0) != 0;
+#else
+		bool ok = ::msync(address, length, MS_SYNC) == 0;
+#endif
+		if (!ok) {
+			ErrorManager::throwExceptionWithDebugInfo(ErrorName::MapFileFailed, "Could not write the mapped pages back to the file.");
+		}
+	}
+
+	void MappedFile::checkRange(std::size_t offset, std::size_t bytes, std::size_t alignment) const {
+		if (offset > length || bytes > length - offset) {
+			ErrorManager::throwExceptionWithDebugInfo(ErrorName::DimensionsError, "Requested view does not fit in the mapped file.");
+		}
+		if (offset % alignment != 0) {
+			ErrorManager::throwExceptionWithDebugInfo(ErrorName::DimensionsError, "Offset of the view is not aligned for its element type.");
+		}
+	}
+
 }  // namespace LLU
\ No newline at end of file
@@ -0,0 +1,99 @@
+/**
+ * @file	FunctionRegistry.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief	Implementation of the registry of library functions and of the interface functions getFunctionTable and dispatchLibraryFunction.
+ */
+#include "LLU/FunctionRegistry.h"
+
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/LibraryLinkFunctionMacro.h"
+#include "LLU/WSTP/WSStream.hpp"
+
+namespace LLU {
+
+	std::vector<FunctionRegistry::Entry>& FunctionRegistry::table() {
+		// functions register from static initializers in other translation units, so the table must be created on first use
+		static std::vector<Entry> entries;
+		return entries;
+	}
+
+	mint FunctionRegistry::add(const char* name, LibraryLinkFunction function) {
+		table().push_back({name, function});
+		return static_cast<mint>(table().size()) - 1;
+	}
+
+	const std::vector<FunctionRegistry::Entry>& FunctionRegistry::functions() {
+		return table();
+	}
+
+	mint FunctionRegistry::find(std::string_view name) {
+		const auto& entries = table();
+		for (std::size_t i = 0; i < entries.size(); ++i) {
+			if (name == entries[i].name) {
+				return static_cast<mint>(i);
+			}
+		}
+		return -1;
+	}
+
+	std::atomic<FunctionRegistry::DispatchInterceptor> FunctionRegistry::interceptor {nullptr};
+
+	int FunctionRegistry::dispatch(mint id, WolframLibraryData libData, mint Argc, MArgument* Args, MArgument Res) {
+		const auto& entries = table();
+		if (id < 0 || static_cast<std::size_t>(id) >= entries.size()) {
+			return ErrorCode::FunctionError;
+		}
+		if (auto* intercept = interceptor.load(std::memory_order_acquire)) {
+			return intercept(entries[id], libData, Argc, Args, Res);
+		}
+		return entries[id].function(libData, Argc, Args, Res);
+	}
+
+	void FunctionRegistry::setInterceptor(DispatchInterceptor newInterceptor) noexcept {
+		interceptor.store(newInterceptor, std::memory_order_release);
+	}
+
+	void FunctionRegistry::sendFunctionTable(WSLINK mlp) {
+		WSStream<WS::Encoding::UTF8> ms(mlp, "List", 0);
+
+		ms << WS::NewPacket << WS::Association(static_cast<int>(table().size()));
+
+		mint id = 0;
+		for (const auto& entry : table()) {
+			ms << WS::Rule << entry.name << id++;
+		}
+
+		ms << WS::EndPacket << WS::Flush;
+	}
+
+	/**
+	 * LibraryLink function that LLU calls to get the table of all registered library functions in one call, for example to find out which
+	 * functions can be preloaded without trying to load each of them.
+	 * @param libData - WolframLibraryData
+	 * @param mlp - WSTP link to transfer data
+	 * @return error code
+	 */
+	EXTERN_C DLLEXPORT int getFunctionTable([[maybe_unused]] WolframLibraryData libData, WSLINK mlp) {
+		auto err = ErrorCode::NoError;
+		try {
+			FunctionRegistry::sendFunctionTable(mlp);
+		} catch (LibraryLinkError& e) {
+			err = e.which();
+		} catch (...) {
+			err = ErrorCode::FunctionError;
+		}
+		return err;
+	}
+
+	/**
+	 * LibraryLink function that calls the registered function whose ID is given as the first argument, with the remaining arguments.
+	 * LLU loads it once for every signature to bind library functions through it, so functions need not be loaded one by one.
+	 * @return error code of the called function
+	 */
+	LIBRARY_LINK_FUNCTION(dispatchLibraryFunction) {
+		if (Argc < 1) {
+			return ErrorCode::FunctionError;
+		}
+		return FunctionRegistry::dispatch(MArgument_getInteger(Args[0]), libData, Argc - 1, Args + 1, Res);
+	}
+}  // namespace LLU
@@ -0,0 +1,168 @@
+/**
+ * @file	FunctionStats.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief	Implementation of the statistics of library functions and of the interface functions getFunctionStats and resetFunctionStats.
+ */
+#include "LLU/FunctionStats.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/WSTP/WSStream.hpp"
+
+namespace LLU {
+
+	namespace {
+		/// All instrumented functions, in the order of static initialization
+		std::vector<FunctionStats*>& allFunctionStats() {
+			static std::vector<FunctionStats*> stats;
+			return stats;
+		}
+
+		double toSeconds(std::uint64_t ns) {
+			return static_cast<double>(ns) * 1e-9;
+		}
+	}  // namespace
+
+	std::uint64_t FunctionCallStats::percentileNs(double q) const noexcept {
+		const auto rank = static_cast<std::uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(calls)));
+		std::uint64_t seen = 0;
+		for (std::size_t bucket = 0; bucket < bucketCount; ++bucket) {
+			seen += histogram[bucket];
+			if (seen >= rank && seen > 0) {
+				const auto upper = bucket == 0 ? std::uint64_t {1} : std::uint64_t {1} << bucket;
+				return std::min(upper, maxNs);
+			}
+		}
+		return maxNs;
+	}
+
+	FunctionCallStats& FunctionCallStats::operator+=(const FunctionCallStats& other) noexcept {
+		if (other.calls > 0) {
+			minNs = (calls == 0) ? other.minNs : std::min(minNs, other.minNs);
+		}
+		calls += other.calls;
+		exceptions += other.exceptions;
+		totalNs += other.totalNs;
+		maxNs = std::max(maxNs, other.maxNs);
+		for (std::size_t i = 0; i < bucketCount; ++i) {
+			histogram[i] += other.histogram[i];
+		}
+		return *this;
+	}
+
+	FunctionStats::FunctionStats(const char* name) : functionName {name} {
+		allFunctionStats().push_back(this);
+	}
+
+	FunctionStats::Shard* FunctionStats::newShard() {
+		std::lock_guard<std::mutex> lock {mutex};
+		shards.push_back(std::make_unique<Shard>());
+		return shards.back().get();
+	}
+
+	FunctionCallStats FunctionStats::snapshot() const {
+		FunctionCallStats res;
+		res.name = functionName;
+		std::lock_guard<std::mutex> lock {mutex};
+		for (const auto& shard : shards) {
+			FunctionCallStats s;
+			s.calls = shard->calls.load(std::memory_order_relaxed);
+			s.exceptions = shard->exceptions.load(std::memory_order_relaxed);
+			s.totalNs = shard->totalNs.load(std::memory_order_relaxed);
+			s.minNs = shard->minNs.load(std::memory_order_relaxed);
+			s.maxNs = shard->maxNs.load(std::memory_order_relaxed);
+			for (std::size_t i = 0; i < FunctionCallStats::bucketCount; ++i) {
+				s.histogram[i] = shard->histogram[i].load(std::memory_order_relaxed);
+			}
+			res += s;
+		}
+		return res;
+	}
+
+	void FunctionStats::reset() noexcept {
+		std::lock_guard<std::mutex> lock {mutex};
+		for (auto& shard : shards) {
+			for (auto* c : {&shard->calls, &shard->exceptions, &shard->totalNs, &shard->maxNs}) {
+				c->store(0, std::memory_order_relaxed);
+			}
+			shard->minNs.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+			for (auto& c : shard->histogram) {
+				c.store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	std::vector<FunctionCallStats> FunctionStats::snapshotAll() {
+		std::vector<FunctionCallStats> res;
+		res.reserve(allFunctionStats().size());
+		for (const auto* stats : allFunctionStats()) {
+			res.push_back(stats->snapshot());
+		}
+		return res;
+	}
+
+	void FunctionStats::resetAll() noexcept {
+		for (auto* stats : allFunctionStats()) {
+			stats->reset();
+		}
+	}
+
+	/**
+	 * LibraryLink function that sends statistics of all instrumented functions as an Association from function names to Associations with keys
+	 * "Calls", "Exceptions", "TotalTime", "MinTime", "MaxTime", "MeanTime", "MedianTime", "P90Time", "P99Time" (all times in seconds)
+	 * and "LatencyHistogram" (counts of calls in power-of-two buckets of nanoseconds, see FunctionCallStats::histogram).
+	 * @param libData - WolframLibraryData
+	 * @param mlp - WSTP link to transfer data
+	 * @return error code
+	 */
+	EXTERN_C DLLEXPORT int getFunctionStats([[maybe_unused]] WolframLibraryData libData, WSLINK mlp) {
+		auto err = ErrorCode::NoError;
+		try {
+			auto stats = FunctionStats::snapshotAll();
+			WSStream<WS::Encoding::UTF8> ms(mlp, "List", 0);
+			ms << WS::NewPacket << WS::Association(static_cast<int>(stats.size()));
+			for (const auto& s : stats) {
+				std::vector<wsint64> histogram {s.histogram.begin(), s.histogram.end()};
+				ms << WS::Rule << s.name << WS::Association(10);
+				ms << WS::Rule << "Calls" << static_cast<wsint64>(s.calls);
+				ms << WS::Rule << "Exceptions" << static_cast<wsint64>(s.exceptions);
+				ms << WS::Rule << "TotalTime" << toSeconds(s.totalNs);
+				ms << WS::Rule << "MinTime" << toSeconds(s.minNs);
+				ms << WS::Rule << "MaxTime" << toSeconds(s.maxNs);
+				ms << WS::Rule << "MeanTime" << (s.calls > 0 ? toSeconds(s.totalNs) / static_cast<double>(s.calls) : 0.0);
+				ms << WS::Rule << "MedianTime" << toSeconds(s.percentileNs(0.5));
+				ms << WS::Rule << "P90Time" << toSeconds(s.percentileNs(0.9));
+				ms << WS::Rule << "P99Time" << toSeconds(s.percentileNs(0.99));
+				ms << WS::Rule << "LatencyHistogram" << histogram;
+			}
+			ms << WS::EndPacket << WS::Flush;
+		} catch (LibraryLinkError& e) {
+			err = e.which();
+		} catch (...) {
+			err = ErrorCode::FunctionError;
+		}
+		return err;
+	}
+
+	/**
+	 * LibraryLink function that resets statistics of all instrumented functions.
+	 * @param libData - WolframLibraryData
+	 * @param mlp - WSTP link to transfer data
+	 * @return error code
+	 */
+	EXTERN_C DLLEXPORT int resetFunctionStats([[maybe_unused]] WolframLibraryData libData, WSLINK mlp) {
+		auto err = ErrorCode::NoError;
+		try {
+			WSStream<WS::Encoding::UTF8> ms(mlp, "List", 0);
+			FunctionStats::resetAll();
+			ms << WS::NewPacket << WS::Null << WS::EndPacket << WS::Flush;
+		} catch (LibraryLinkError& e) {
+			err = e.which();
+		} catch (...) {
+			err = ErrorCode::FunctionError;
+		}
+		return err;
+	}
+}  // namespace LLU
@@ -0,0 +1,70 @@
+/**
+ * @file
+ * Definitions of non-template member functions of InstancePool class
+ */
+
+#include "LLU/InstancePool.h"
+
+#include <algorithm>
+#include <new>
+
+namespace LLU {
+
+	InstancePool::InstancePool(std::size_t blocksPerChunk) : state(std::make_shared<State>(std::max<std::size_t>(blocksPerChunk, 1))) {}
+
+	std::size_t InstancePool::blockSize() const {
+		std::lock_guard<std::mutex> lock {state->mutex};
+		return state->size;
+	}
+
+	std::size_t InstancePool::blocksInUse() const {
+		std::lock_guard<std::mutex> lock {state->mutex};
+		return state->used;
+	}
+
+	std::size_t InstancePool::capacity() const {
+		std::lock_guard<std::mutex> lock {state->mutex};
+		return state->chunks.size() * state->blocksPerChunk;
+	}
+
+	void* InstancePool::State::allocate(std::size_t bytes, std::size_t alignment) {
+		{
+			std::lock_guard<std::mutex> lock {mutex};
+			if (requestSize == 0 && alignment <= alignof(std::max_align_t)) {
+				requestSize = bytes;
+				// round up so that every block in a chunk is suitably aligned
+				size = (std::max(bytes, sizeof(FreeBlock)) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+			}
+			if (fromPool(bytes, alignment)) {
+				if (!freeList) {
+					addChunk();
+				}
+				auto* block = freeList;
+				freeList = block->next;
+				++used;
+				return block;
+			}
+		}
+		return ::operator new(bytes, std::align_val_t {alignment});
+	}
+
+	void InstancePool::State::deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept {
+		std::unique_lock<std::mutex> lock {mutex};
+		if (fromPool(bytes, alignment)) {
+			freeList = new (p) FreeBlock {freeList};
+			--used;
+			return;
+		}
+		lock.unlock();
+		::operator delete(p, std::align_val_t {alignment});
+	}
+
+	void InstancePool::State::addChunk() {
+		chunks.push_back(std::make_unique<std::byte[]>(size * blocksPerChunk));
+		auto* chunk = chunks.back().get();
+		for (std::size_t i = blocksPerChunk; i-- > 0;) {
+			freeList = new (chunk + i * size) FreeBlock {freeList};
+		}
+	}
+
+}  // namespace LLU
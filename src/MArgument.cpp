@@ -29,6 +29,14 @@ namespace LLU {
 		LibraryData::DataStoreAPI()->DataStore_##DSAdd(ds, val);                                                           \
 	}                                                                                                                      \
 	template<>                                                                                                             \
+	auto PrimitiveWrapper<MArgumentType::ArgType>::dataStoreNodeAdder()->NodeAdder {                                       \
+		return LibraryData::DataStoreAPI()->DataStore_##DSAdd;                                                             \
+	}                                                                                                                      \
+	template<>                                                                                                             \
+	auto PrimitiveWrapper<MArgumentType::ArgType>::namedDataStoreNodeAdder()->NamedNodeAdder {                             \
+		return LibraryData::DataStoreAPI()->DataStore_##DSAddNamed;                                                        \
+	}                                                                                                                      \
+	template<>                                                                                                             \
 	auto PrimitiveWrapper<MArgumentType::ArgType>::getAddress() const->value_type* {                                       \
 		return MArgGetPrefix##ArgType##Address(arg);                                                                       \
 	}                                                                                                                      \
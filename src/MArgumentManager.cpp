@@ -10,6 +10,7 @@
 #include "LLU/MArgumentManager.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include "LLU/Containers/MArray.hpp"
 #include "LLU/LibraryData.h"
@@ -18,17 +19,14 @@ namespace LLU {
 
 	/* Static data members */
 
-	std::string MArgumentManager::stringResultBuffer;
+	thread_local std::string MArgumentManager::stringResultBuffer;
 
 	/* Constructors */
 
-	MArgumentManager::MArgumentManager(mint Argc, MArgument* Args, MArgument& Res) : argc(Argc), args(Args), res(Res) {
-		initStringArgs();
-	}
+	MArgumentManager::MArgumentManager(mint Argc, MArgument* Args, MArgument& Res) : argc(Argc), args(Args), res(Res) {}
 
 	MArgumentManager::MArgumentManager(WolframLibraryData ld, mint Argc, MArgument* Args, MArgument& Res) : argc(Argc), args(Args), res(Res) {
 		LibraryData::setLibraryData(ld);
-		initStringArgs();
 	}
 
 	/* Other member functions */
@@ -41,27 +39,39 @@ namespace LLU {
 		return static_cast<double>(MArgument_getReal(getArgs(index)));
 	}
 
-	void MArgumentManager::acquireUTF8String(size_type index) const {
-		if (!stringArgs.at(index)) {
-			char* strArg = MArgument_getUTF8String(getArgs(index));
-			stringArgs[index].reset(strArg);
+	auto MArgumentManager::acquireUTF8String(size_type index) const -> const StringArg& {
+		auto it = std::find_if(stringArgs.cbegin(), stringArgs.cend(), [index](const StringArg& s) { return s.index == index; });
+		if (it != stringArgs.cend()) {
+			return *it;
+		}
+		char* strArg = MArgument_getUTF8String(getArgs(index));
+		if (stringArgs.empty()) {
+			stringArgs.reserve(static_cast<std::size_t>(argc));
 		}
+		return stringArgs.emplace_back(StringArg {index, LLStringPtr {strArg, LibraryData::API()->UTF8String_disown}, std::strlen(strArg)});
 	}
 
 	char* MArgumentManager::getCString(size_type index) const {
-		acquireUTF8String(index);
-		return stringArgs[index].get();
+		return acquireUTF8String(index).data.get();
 	}
 
 	std::string MArgumentManager::getString(size_type index) const {
-		acquireUTF8String(index);
-		return stringArgs[index].get();
+		return std::string {getStringView(index)};
+	}
+
+	std::string_view MArgumentManager::getStringView(size_type index) const {
+		const auto& s = acquireUTF8String(index);
+		return {s.data.get(), s.length};
 	}
 
 	namespace {
-		void setStringAsMArgument(MArgument& res, const std::string& str) {
+		void setStringAsMArgument(MArgument& res, const char* str) {
 			// NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast): LibraryLink will not modify the string, so const_cast is safe here
-			MArgument_setUTF8String(res, const_cast<char*>(str.c_str()));
+			MArgument_setUTF8String(res, const_cast<char*>(str));
+		}
+
+		void setStringAsMArgument(MArgument& res, const std::string& str) {
+			setStringAsMArgument(res, str.c_str());
 		}
 	}
 
@@ -80,6 +90,10 @@ namespace LLU {
 		setStringAsMArgument(res, stringResultBuffer);
 	}
 
+	void MArgumentManager::setStringView(std::string_view str) {
+		setStringAsMArgument(res, str.data());
+	}
+
 	void MArgumentManager::setBoolean(bool result) noexcept {
 		MArgument_setBoolean(res, result ? True : False);
 	}
@@ -168,13 +182,6 @@ namespace LLU {
 		return args[index];
 	}
 
-	void MArgumentManager::initStringArgs() {
-		stringArgs.reserve(argc);
-		for (int i = 0; i < argc; ++i) {
-			stringArgs.emplace_back(nullptr, LibraryData::API()->UTF8String_disown);
-		}
-	}
-
 	ProgressMonitor MArgumentManager::getProgressMonitor(double step) const {
 		if (argc < 1) {
 			ErrorManager::throwExceptionWithDebugInfo(ErrorName::MArgumentIndexError, "Index too small when accessing ProgressMonitor.");
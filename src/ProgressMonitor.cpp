@@ -10,15 +10,33 @@
 
 namespace LLU {
 
-	ProgressMonitor::ProgressMonitor(SharedTensor sharedIndicator, double step) : sharedIndicator(std::move(sharedIndicator)), step(step) {}
+	namespace {
+		/// std::atomic<double> has no fetch_add before C++20
+		void atomicAdd(std::atomic<double>& value, double delta) noexcept {
+			auto current = value.load(std::memory_order_relaxed);
+			while (!value.compare_exchange_weak(current, current + delta, std::memory_order_relaxed)) {
+			}
+		}
+	}  // namespace
+
+	ProgressMonitor::ProgressMonitor(SharedTensor sharedIndicator, double step)
+		: sharedIndicator(std::move(sharedIndicator)), step(step), state(std::make_unique<State>()) {
+		state->progress.store(this->sharedIndicator[0], std::memory_order_relaxed);
+	}
+
+	ProgressMonitor::~ProgressMonitor() {
+		if (state && std::this_thread::get_id() == state->owner) {
+			sharedIndicator[0] = state->progress.load(std::memory_order_relaxed);
+		}
+	}
 
 	double ProgressMonitor::get() const {
-		return sharedIndicator[0];
+		return state->progress.load(std::memory_order_relaxed);
 	}
 
 	void ProgressMonitor::set(double progressValue) {
-		sharedIndicator[0] = progressValue;
-		checkAbort();
+		state->progress.store(progressValue, std::memory_order_relaxed);
+		update(true);
 	}
 
 	double ProgressMonitor::getStep() const {
@@ -27,7 +45,20 @@ namespace LLU {
 
 	void ProgressMonitor::setStep(double stepValue) {
 		step = stepValue;
-		checkAbort();
+		update(false);
+	}
+
+	std::chrono::milliseconds ProgressMonitor::getUpdateInterval() const {
+		return state->interval;
+	}
+
+	void ProgressMonitor::setUpdateInterval(std::chrono::milliseconds interval) {
+		state->interval = interval;
+		state->nextUpdate = Clock::time_point {};
+	}
+
+	void ProgressMonitor::publish() {
+		update(true);
 	}
 
 	void ProgressMonitor::checkAbort() {
@@ -36,24 +67,91 @@ namespace LLU {
 		}
 	}
 
+	void ProgressMonitor::add(double progress) {
+		atomicAdd(state->progress, progress);
+		update(false);
+	}
+
+	void ProgressMonitor::update(bool force) {
+		if (state->aborted.load(std::memory_order_relaxed)) {
+			ErrorManager::throwException(ErrorName::Aborted);
+		}
+		if (std::this_thread::get_id() != state->owner) {
+			return;
+		}
+		auto now = Clock::now();
+		if (!force && now < state->nextUpdate) {
+			return;
+		}
+		state->nextUpdate = now + state->interval;
+		sharedIndicator[0] = state->progress.load(std::memory_order_relaxed);
+		if (LibraryData::API()->AbortQ() != 0) {
+			state->aborted.store(true, std::memory_order_relaxed);
+			ErrorManager::throwException(ErrorName::Aborted);
+		}
+	}
+
 	ProgressMonitor& ProgressMonitor::operator++() {
-		set(sharedIndicator[0] + step);
+		add(step);
 		return *this;
 	}
 
 	ProgressMonitor& ProgressMonitor::operator+=(double progress) {
-		set(sharedIndicator[0] + progress);
+		add(progress);
 		return *this;
 	}
 
 	ProgressMonitor& ProgressMonitor::operator--() {
-		set(sharedIndicator[0] - step);
+		add(-step);
 		return *this;
 	}
 
 	ProgressMonitor& ProgressMonitor::operator-=(double progress) {
-		set(sharedIndicator[0] - progress);
+		add(-progress);
 		return *this;
 	}
 
-}  // namespace LLU
\ No newline at end of file
+	ProgressMonitor::Local::Local(Stage& s) noexcept : stage {&s}, step {s.step} {}
+
+	ProgressMonitor::Local::~Local() {
+		if (pending == 0) {
+			return;
+		}
+		if (stage) {
+			atomicAdd(stage->root.state->progress, stage->propagate(pending));
+		} else {
+			atomicAdd(monitor->state->progress, pending);
+		}
+	}
+
+	void ProgressMonitor::Local::flush() {
+		auto progress = pending;
+		pending = 0;
+		count = 0;
+		if (stage) {
+			*stage += progress;
+		} else {
+			monitor->add(progress);
+		}
+	}
+
+	void ProgressMonitor::Stage::set(double progressValue) {
+		auto previous = progress.exchange(progressValue, std::memory_order_relaxed);
+		auto delta = (progressValue - previous) * weight;
+		root.add(parent ? parent->propagate(delta) : delta);
+	}
+
+	auto ProgressMonitor::Stage::operator+=(double progressValue) -> Stage& {
+		root.add(propagate(progressValue));
+		return *this;
+	}
+
+	double ProgressMonitor::Stage::propagate(double progressValue) noexcept {
+		for (auto* s = this; s != nullptr; s = s->parent) {
+			atomicAdd(s->progress, progressValue);
+			progressValue *= s->weight;
+		}
+		return progressValue;
+	}
+
+}  // namespace LLU
@@ -0,0 +1,93 @@
+/**
+ * @file	SharedBuffers.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief	Implementation of the table of shared results of WSTP functions and of the interface functions fetchSharedResult and releaseSharedResult.
+ */
+#include "LLU/SharedBuffers.h"
+
+#include <mutex>
+
+#include "LLU/LibraryLinkFunctionMacro.h"
+
+namespace LLU {
+
+	namespace {
+		/// Staged buffers and the counter of tickets, shared by all threads of the library
+		struct ResultTable {
+			std::mutex mutex;
+			std::unordered_map<mint, SharedBuffer> buffers;
+			mint lastTicket = 0;
+		};
+
+		ResultTable& resultTable() {
+			static ResultTable table;
+			return table;
+		}
+	}  // namespace
+
+	mint SharedResults::stage(SharedBuffer buffer) {
+		auto& table = resultTable();
+		std::lock_guard lock {table.mutex};
+		const mint ticket = ++table.lastTicket;
+		table.buffers.emplace(ticket, std::move(buffer));
+		return ticket;
+	}
+
+	SharedBuffer SharedResults::claim(mint ticket) {
+		auto& table = resultTable();
+		std::unique_lock lock {table.mutex};
+		auto node = table.buffers.extract(ticket);
+		lock.unlock();
+		if (node.empty()) {
+			ErrorManager::throwException(ErrorName::ManagedExprInvalidID, ticket);
+		}
+		return std::move(node.mapped());
+	}
+
+	bool SharedResults::release(mint ticket) {
+		auto& table = resultTable();
+		std::unique_lock lock {table.mutex};
+		auto node = table.buffers.extract(ticket);
+		lock.unlock();
+		// the buffer is freed here, outside of the lock
+		return !node.empty();
+	}
+
+	std::size_t SharedResults::pending() {
+		auto& table = resultTable();
+		std::lock_guard lock {table.mutex};
+		return table.buffers.size();
+	}
+
+	/**
+	 * LibraryLink function that returns the Tensor or NumericArray staged with given ticket and removes it from the table. Containers created
+	 * by the library are passed to the kernel without copying. LLU loads it once for every result type, see LLU`SharedResult.
+	 * @return error code
+	 */
+	LIBRARY_LINK_FUNCTION(fetchSharedResult) {
+		auto err = ErrorCode::NoError;
+		try {
+			if (Argc != 1) {
+				ErrorManager::throwException(ErrorName::MArgumentIndexError);
+			}
+			SharedResults::claim(MArgument_getInteger(Args[0])).pass(Res);
+		} catch (LibraryLinkError& e) {
+			err = e.which();
+		} catch (...) {
+			err = ErrorCode::FunctionError;
+		}
+		return err;
+	}
+
+	/**
+	 * LibraryLink function that frees the container staged with given ticket, it returns False if there is no such container.
+	 * @return error code
+	 */
+	LIBRARY_LINK_FUNCTION(releaseSharedResult) {
+		if (Argc != 1) {
+			return ErrorCode::FunctionError;
+		}
+		MArgument_setBoolean(Res, SharedResults::release(MArgument_getInteger(Args[0])) ? True : False);
+		return ErrorCode::NoError;
+	}
+}  // namespace LLU
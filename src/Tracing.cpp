@@ -0,0 +1,201 @@
+/**
+ * @file	Tracing.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief	Implementation of trace buffers, of the Chrome trace export and of the interface functions getTrace and resetTrace.
+ */
+#include "LLU/Tracing.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_set>
+
+#include "LLU/ErrorLog/ErrorManager.h"
+#include "LLU/WSTP/WSStream.hpp"
+
+namespace LLU::Trace {
+
+	namespace {
+		/// All ring buffers ever created and those not owned by any running thread
+		struct BufferRegistry {
+			std::mutex mutex;
+			std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+			std::vector<ThreadBuffer*> unused;
+		};
+
+		BufferRegistry& registry() {
+			static BufferRegistry r;
+			return r;
+		}
+
+		/// Takes a buffer from the registry for the calling thread and gives it back when the thread exits
+		struct BufferOwner {
+			ThreadBuffer* buffer;
+
+			BufferOwner() {
+				auto& r = registry();
+				std::lock_guard<std::mutex> lock {r.mutex};
+				if (r.unused.empty()) {
+					r.buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<std::uint32_t>(r.buffers.size() + 1)));
+					buffer = r.buffers.back().get();
+				} else {
+					buffer = r.unused.back();
+					r.unused.pop_back();
+				}
+			}
+			BufferOwner(const BufferOwner&) = delete;
+			BufferOwner& operator=(const BufferOwner&) = delete;
+
+			~BufferOwner() {
+				auto& r = registry();
+				std::lock_guard<std::mutex> lock {r.mutex};
+				r.unused.push_back(buffer);
+			}
+		};
+
+		/// Write a string as a JSON string literal
+		void writeJSONString(std::ostream& out, const char* s) {
+			out << '"';
+			for (; s && *s; ++s) {
+				const auto c = static_cast<unsigned char>(*s);
+				if (c == '"' || c == '\\') {
+					out << '\\' << *s;
+				} else if (c < 0x20) {
+					out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+				} else {
+					out << *s;
+				}
+			}
+			out << '"';
+		}
+
+		/// Write a time in nanoseconds as microseconds, the unit of the Chrome trace format
+		void writeMicroseconds(std::ostream& out, std::int64_t ns) {
+			out << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000 << std::setfill(' ');
+		}
+	}  // namespace
+
+	void ThreadBuffer::collect(std::vector<Event>& events) const {
+		const auto end = written.load(std::memory_order_acquire);
+		const auto begin = std::max(cleared.load(std::memory_order_relaxed), end > capacity ? end - capacity : std::uint64_t {0});
+		const auto first = events.size();
+		for (auto i = begin; i < end; ++i) {
+			const auto& slot = slots[i % slots.size()];
+			events.push_back({slot.category.load(std::memory_order_relaxed), slot.name.load(std::memory_order_relaxed),
+							  slot.startNs.load(std::memory_order_relaxed), slot.durationNs.load(std::memory_order_relaxed), threadId});
+		}
+		// any slot that the owner started to reuse while we were copying it must be discarded, see record()
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const auto now = written.load(std::memory_order_relaxed);
+		const auto valid = now > capacity ? now - capacity : std::uint64_t {0};
+		if (valid > begin) {
+			const auto stale = static_cast<std::ptrdiff_t>(std::min(valid, end) - begin);
+			events.erase(events.begin() + static_cast<std::ptrdiff_t>(first), events.begin() + static_cast<std::ptrdiff_t>(first) + stale);
+		}
+	}
+
+	ThreadBuffer& threadBuffer() {
+		static thread_local BufferOwner owner;
+		return *owner.buffer;
+	}
+
+	const char* intern(std::string_view name) {
+		static std::mutex mutex;
+		static std::unordered_set<std::string> names;
+		std::lock_guard<std::mutex> lock {mutex};
+		return names.emplace(name).first->c_str();
+	}
+
+	std::vector<Event> collect() {
+		std::vector<Event> events;
+		{
+			auto& r = registry();
+			std::lock_guard<std::mutex> lock {r.mutex};
+			for (const auto& buffer : r.buffers) {
+				buffer->collect(events);
+			}
+		}
+		std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.startNs < b.startNs; });
+		return events;
+	}
+
+	void reset() noexcept {
+		auto& r = registry();
+		std::lock_guard<std::mutex> lock {r.mutex};
+		for (auto& buffer : r.buffers) {
+			buffer->clear();
+		}
+	}
+
+	void writeChromeTrace(std::ostream& out, const std::vector<Event>& events) {
+		std::vector<std::uint32_t> threads;
+		out << R"({"displayTimeUnit":"ns","traceEvents":[)";
+		out << R"({"ph":"M","pid":1,"tid":0,"name":"process_name","args":{"name":"LLU"}})";
+		for (const auto& e : events) {
+			if (std::find(threads.begin(), threads.end(), e.thread) == threads.end()) {
+				threads.push_back(e.thread);
+				out << R"(,{"ph":"M","pid":1,"tid":)" << e.thread << R"(,"name":"thread_name","args":{"name":"Thread )" << e.thread << R"("}})";
+			}
+			out << R"(,{"ph":"X","pid":1,"tid":)" << e.thread << R"(,"cat":)";
+			writeJSONString(out, e.category);
+			out << R"(,"name":)";
+			writeJSONString(out, e.name);
+			out << R"(,"ts":)";
+			writeMicroseconds(out, e.startNs);
+			out << R"(,"dur":)";
+			writeMicroseconds(out, e.durationNs);
+			out << '}';
+		}
+		out << "]}";
+	}
+
+	std::string chromeTrace() {
+		std::ostringstream out;
+		writeChromeTrace(out);
+		return out.str();
+	}
+}  // namespace LLU::Trace
+
+namespace LLU {
+	/**
+	 * LibraryLink function that sends all recorded spans as a String with a JSON document in the Chrome trace event format.
+	 * Spans are only recorded in libraries compiled with LLU_TRACING, otherwise the document has no events.
+	 * @param libData - WolframLibraryData
+	 * @param mlp - WSTP link to transfer data
+	 * @return error code
+	 */
+	EXTERN_C DLLEXPORT int getTrace([[maybe_unused]] WolframLibraryData libData, WSLINK mlp) {
+		auto err = ErrorCode::NoError;
+		try {
+			WSStream<WS::Encoding::UTF8> ms(mlp, "List", 0);
+			ms << WS::NewPacket << Trace::chromeTrace() << WS::EndPacket << WS::Flush;
+		} catch (LibraryLinkError& e) {
+			err = e.which();
+		} catch (...) {
+			err = ErrorCode::FunctionError;
+		}
+		return err;
+	}
+
+	/**
+	 * LibraryLink function that forgets all spans recorded so far.
+	 * @param libData - WolframLibraryData
+	 * @param mlp - WSTP link to transfer data
+	 * @return error code
+	 */
+	EXTERN_C DLLEXPORT int resetTrace([[maybe_unused]] WolframLibraryData libData, WSLINK mlp) {
+		auto err = ErrorCode::NoError;
+		try {
+			WSStream<WS::Encoding::UTF8> ms(mlp, "List", 0);
+			Trace::reset();
+			ms << WS::NewPacket << WS::Null << WS::EndPacket << WS::Flush;
+		} catch (LibraryLinkError& e) {
+			err = e.which();
+		} catch (...) {
+			err = ErrorCode::FunctionError;
+		}
+		return err;
+	}
+}  // namespace LLU
@@ -7,7 +7,16 @@
 
 #include "LLU/WSTP/Strings.h"
 
-#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LLU_ASCII_SCAN_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define LLU_ASCII_SCAN_NEON
+#endif
 
 namespace LLU::WS {
 
@@ -20,6 +29,46 @@ namespace LLU::WS {
 		bool useFastUTF8 = true;
 	}	 // namespace EncodingConfig
 
+	namespace Detail {
+		bool allASCIIQ(const unsigned char* strData, std::size_t len) noexcept {
+			constexpr std::size_t blockSize = 64;
+			std::size_t i = 0;
+#if defined(LLU_ASCII_SCAN_SSE2)
+			for (; i + blockSize <= len; i += blockSize) {
+				// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): SSE2 loads take pointers to __m128i
+				const auto* block = reinterpret_cast<const __m128i*>(strData + i);
+				auto bits = _mm_or_si128(_mm_or_si128(_mm_loadu_si128(block), _mm_loadu_si128(block + 1)),
+										 _mm_or_si128(_mm_loadu_si128(block + 2), _mm_loadu_si128(block + 3)));
+				if (_mm_movemask_epi8(bits) != 0) {
+					return false;
+				}
+			}
+#elif defined(LLU_ASCII_SCAN_NEON)
+			for (; i + blockSize <= len; i += blockSize) {
+				auto bits = vorrq_u8(vorrq_u8(vld1q_u8(strData + i), vld1q_u8(strData + i + 16)), vorrq_u8(vld1q_u8(strData + i + 32), vld1q_u8(strData + i + 48)));
+				if (vmaxvq_u8(bits) > 0x7F) {
+					return false;
+				}
+			}
+#endif
+			// the remaining bytes are checked 8 at a time
+			constexpr std::uint64_t highBits = 0x8080808080808080ULL;
+			for (; i + sizeof(std::uint64_t) <= len; i += sizeof(std::uint64_t)) {
+				std::uint64_t word {};
+				std::memcpy(&word, strData + i, sizeof(word));
+				if ((word & highBits) != 0) {
+					return false;
+				}
+			}
+			for (; i < len; ++i) {
+				if ((strData[i] & 0x80U) != 0) {
+					return false;
+				}
+			}
+			return true;
+		}
+	}  // namespace Detail
+
 #ifndef _WIN32
 	template<>
 	GetStringFuncT<CharType<Encoding::Native>> String<Encoding::Native>::Get = [](WSLINK m, const char** strData, int* len, int* charCnt) {
@@ -58,9 +107,7 @@ namespace LLU::WS {
 	GetStringFuncT<CharType<Encoding::UTF8>> String<Encoding::UTF8>::Get = WSGetUTF8String;
 	template<>
 	PutStringFuncT<CharType<Encoding::UTF8>> String<Encoding::UTF8>::Put = [](WSLINK m, const unsigned char* strData, int len) {
-		constexpr unsigned char maxValidASCII = 127;
-		std::basic_string_view<unsigned char> strView {strData, static_cast<std::size_t>(len)};
-		if (EncodingConfig::useFastUTF8 && std::all_of(strView.cbegin(), strView.cend(), [&](unsigned char strChar) { return strChar <= maxValidASCII; })) {
+		if (EncodingConfig::useFastUTF8 && Detail::allASCIIQ(strData, static_cast<std::size_t>(len))) {
 			return WSPutByteString(m, strData, len);
 		}
 		return WSPutUTF8String(m, strData, len);
@@ -0,0 +1,307 @@
+/**
+ * @file	AsyncBenchmark.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Throughput and latency benchmarks of thread pools and queues from LLU::Async.
+ *
+ * The benchmark does not need the Wolfram Language, it only uses the header-only part of LLU::Async. Usage:
+ *
+ *     AsyncBenchmark [--threads=1,2,4] [--sizes=0,100,10000] [--tasks=N] [--repetitions=R] [--format=csv|json] [--filter=substring]
+ *
+ * Each result is the median of all repetitions. Results are printed to the standard output, one record per benchmark configuration.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LLU/Async/Algorithms.h"
+#include "LLU/Async/TaskGroup.h"
+#include "LLU/Async/ThreadPool.h"
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	/// Command line configuration
+	struct Config {
+		std::vector<unsigned> threads {1, 2, 4};
+		std::vector<unsigned> sizes {0, 100, 10000};
+		std::size_t tasks = 100000;
+		unsigned repetitions = 5;
+		bool json = false;
+		std::string filter;
+	};
+
+	/// Single measurement reported by the benchmark
+	struct Result {
+		std::string name;
+		unsigned threads = 0;
+		unsigned taskSize = 0;
+		std::size_t tasks = 0;
+		double seconds = 0;
+		double p50Micros = 0;
+		double p99Micros = 0;
+	};
+
+	/// Burn roughly \p iterations cycles in a way the compiler cannot optimize out
+	void spin(unsigned iterations) {
+		static thread_local volatile std::uint64_t sink = 0;
+		std::uint64_t x = sink;
+		for (unsigned i = 0; i < iterations; ++i) {
+			x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+		}
+		sink = x;
+	}
+
+	double secondsSince(Clock::time_point start) {
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	double median(std::vector<double> values) {
+		std::sort(values.begin(), values.end());
+		return values.empty() ? 0 : values[values.size() / 2];
+	}
+
+	double percentile(std::vector<double>& sorted, double p) {
+		if (sorted.empty()) {
+			return 0;
+		}
+		auto idx = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1));
+		return sorted[idx];
+	}
+
+	/// Submit \p n independent tasks from the main thread and wait for all of them
+	template<typename Pool>
+	double flatThroughput(unsigned threads, unsigned size, std::size_t n) {
+		Pool pool {threads};
+		LLU::Async::TaskGroup group;
+		auto start = Clock::now();
+		for (std::size_t i = 0; i < n; ++i) {
+			group.run(pool, [size] { spin(size); });
+		}
+		group.wait();
+		return secondsSince(start);
+	}
+
+	/// Recursively split the work in halves, every task spawns new tasks, which is what parallelFor does
+	template<typename Pool>
+	double recursiveSpawn(unsigned threads, unsigned size, std::size_t n) {
+		Pool pool {threads};
+		auto start = Clock::now();
+		LLU::Async::parallelFor(pool, std::size_t {0}, n, 1, [size](std::size_t) { spin(size); });
+		return secondsSince(start);
+	}
+
+	/// Measure the time between submitting a task to an idle pool and the moment it starts running
+	template<typename Pool>
+	std::vector<double> wakeUpLatency(unsigned threads, std::size_t n) {
+		Pool pool {threads};
+		std::vector<double> latencies;
+		latencies.reserve(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			auto submitted = Clock::now();
+			auto started = pool.submit([] { return Clock::now(); }).get();
+			latencies.push_back(std::chrono::duration<double, std::micro>(started - submitted).count());
+		}
+		return latencies;
+	}
+
+	/// \p threads producers push and the same number of consumers pop \p n elements in total
+	double threadsafeQueueThroughput(unsigned threads, std::size_t n) {
+		LLU::Async::ThreadsafeQueue<std::size_t> queue;
+		std::atomic<std::size_t> consumed = 0;
+		std::vector<std::thread> workers;
+		auto start = Clock::now();
+		for (unsigned t = 0; t < threads; ++t) {
+			workers.emplace_back([&, t] {
+				for (std::size_t i = t; i < n; i += threads) {
+					queue.push(i);
+				}
+			});
+			workers.emplace_back([&] {
+				std::size_t value = 0;
+				while (consumed.load(std::memory_order_relaxed) < n) {
+					if (queue.tryPop(value)) {
+						consumed.fetch_add(1, std::memory_order_relaxed);
+					}
+				}
+			});
+		}
+		for (auto& w : workers) {
+			w.join();
+		}
+		return secondsSince(start);
+	}
+
+	/// The owner pushes and pops \p n elements while \p threads - 1 thieves keep stealing from the other end
+	template<typename Queue>
+	double workStealingQueueThroughput(unsigned threads, std::size_t n) {
+		Queue queue;
+		std::atomic<std::size_t> taken = 0;
+		std::atomic_bool pushing = true;
+		std::vector<std::thread> thieves;
+		auto start = Clock::now();
+		for (unsigned t = 1; t < threads; ++t) {
+			thieves.emplace_back([&] {
+				typename Queue::value_type value {};
+				while (pushing.load(std::memory_order_relaxed) || taken.load(std::memory_order_relaxed) < n) {
+					if (queue.trySteal(value)) {
+						taken.fetch_add(1, std::memory_order_relaxed);
+					}
+				}
+			});
+		}
+		typename Queue::value_type value {};
+		for (std::size_t i = 0; i < n; ++i) {
+			queue.push(i);
+			if (i % 2 == 1 && queue.tryPop(value)) {
+				taken.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+		pushing = false;
+		while (taken.load(std::memory_order_relaxed) < n) {
+			if (queue.tryPop(value)) {
+				taken.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+		for (auto& t : thieves) {
+			t.join();
+		}
+		return secondsSince(start);
+	}
+
+	class Runner {
+	public:
+		explicit Runner(Config c) : config(std::move(c)) {}
+
+		/// Run a throughput benchmark, \p f returns elapsed seconds
+		void timed(const std::string& name, unsigned threads, unsigned size, const std::function<double()>& f) {
+			if (!config.filter.empty() && name.find(config.filter) == std::string::npos) {
+				return;
+			}
+			std::vector<double> times;
+			for (unsigned r = 0; r < config.repetitions; ++r) {
+				times.push_back(f());
+			}
+			results.push_back({name, threads, size, config.tasks, median(times), 0, 0});
+		}
+
+		/// Run a latency benchmark, \p f returns individual latencies in microseconds
+		void latency(const std::string& name, unsigned threads, const std::function<std::vector<double>()>& f) {
+			if (!config.filter.empty() && name.find(config.filter) == std::string::npos) {
+				return;
+			}
+			std::vector<double> all;
+			auto start = Clock::now();
+			for (unsigned r = 0; r < config.repetitions; ++r) {
+				auto l = f();
+				all.insert(all.end(), l.begin(), l.end());
+			}
+			auto elapsed = secondsSince(start) / config.repetitions;
+			std::sort(all.begin(), all.end());
+			results.push_back({name, threads, 0, all.size() / config.repetitions, elapsed, percentile(all, 0.5), percentile(all, 0.99)});
+		}
+
+		void print(std::ostream& os) const {
+			if (config.json) {
+				os << "[\n";
+				for (std::size_t i = 0; i < results.size(); ++i) {
+					const auto& r = results[i];
+					os << "  {\"name\": \"" << r.name << "\", \"threads\": " << r.threads << ", \"taskSize\": " << r.taskSize << ", \"tasks\": " << r.tasks
+					   << ", \"seconds\": " << r.seconds << ", \"tasksPerSecond\": " << throughput(r) << ", \"p50Micros\": " << r.p50Micros
+					   << ", \"p99Micros\": " << r.p99Micros << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+				}
+				os << "]\n";
+			} else {
+				os << "name,threads,taskSize,tasks,seconds,tasksPerSecond,p50Micros,p99Micros\n";
+				for (const auto& r : results) {
+					os << r.name << "," << r.threads << "," << r.taskSize << "," << r.tasks << "," << r.seconds << "," << throughput(r) << ","
+					   << r.p50Micros << "," << r.p99Micros << "\n";
+				}
+			}
+		}
+
+	private:
+		Config config;
+		std::vector<Result> results;
+
+		static double throughput(const Result& r) {
+			return r.seconds > 0 ? static_cast<double>(r.tasks) / r.seconds : 0;
+		}
+	};
+
+	std::vector<unsigned> parseList(const std::string& s) {
+		std::vector<unsigned> res;
+		std::stringstream ss {s};
+		std::string item;
+		while (std::getline(ss, item, ',')) {
+			res.push_back(static_cast<unsigned>(std::stoul(item)));
+		}
+		return res;
+	}
+
+	Config parseArguments(int argc, char* argv[]) {
+		Config c;
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			auto value = [&](const std::string& prefix) { return arg.substr(prefix.size()); };
+			if (arg.rfind("--threads=", 0) == 0) {
+				c.threads = parseList(value("--threads="));
+			} else if (arg.rfind("--sizes=", 0) == 0) {
+				c.sizes = parseList(value("--sizes="));
+			} else if (arg.rfind("--tasks=", 0) == 0) {
+				c.tasks = std::stoul(value("--tasks="));
+			} else if (arg.rfind("--repetitions=", 0) == 0) {
+				c.repetitions = std::max(1U, static_cast<unsigned>(std::stoul(value("--repetitions="))));
+			} else if (arg == "--format=json") {
+				c.json = true;
+			} else if (arg == "--format=csv") {
+				c.json = false;
+			} else if (arg.rfind("--filter=", 0) == 0) {
+				c.filter = value("--filter=");
+			} else {
+				throw std::invalid_argument("Unknown argument: " + arg);
+			}
+		}
+		return c;
+	}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+	Config config;
+	try {
+		config = parseArguments(argc, argv);
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+	Runner runner {config};
+	const auto n = config.tasks;
+	for (auto t : config.threads) {
+		for (auto size : config.sizes) {
+			runner.timed("Flat/BasicPool", t, size, [=] { return flatThroughput<LLU::BasicPool>(t, size, n); });
+			runner.timed("Flat/ThreadPool", t, size, [=] { return flatThroughput<LLU::ThreadPool>(t, size, n); });
+			runner.timed("Flat/LockFreeThreadPool", t, size, [=] { return flatThroughput<LLU::LockFreeThreadPool>(t, size, n); });
+			runner.timed("Recursive/ThreadPool", t, size, [=] { return recursiveSpawn<LLU::ThreadPool>(t, size, n); });
+			runner.timed("Recursive/LockFreeThreadPool", t, size, [=] { return recursiveSpawn<LLU::LockFreeThreadPool>(t, size, n); });
+		}
+		const auto samples = std::min<std::size_t>(n, 1000);
+		runner.latency("Latency/BasicPool", t, [=] { return wakeUpLatency<LLU::BasicPool>(t, samples); });
+		runner.latency("Latency/ThreadPool", t, [=] { return wakeUpLatency<LLU::ThreadPool>(t, samples); });
+		runner.latency("Latency/LockFreeThreadPool", t, [=] { return wakeUpLatency<LLU::LockFreeThreadPool>(t, samples); });
+		runner.timed("Queue/ThreadsafeQueue", t, 0, [=] { return threadsafeQueueThroughput(t, n); });
+		runner.timed("Queue/WorkStealingQueue", t, 0,
+					 [=] { return workStealingQueueThroughput<LLU::Async::WorkStealingQueue<std::deque<std::size_t>>>(t, n); });
+		runner.timed("Queue/ChaseLevQueue", t, 0, [=] { return workStealingQueueThroughput<LLU::Async::ChaseLevQueue<std::size_t>>(t, n); });
+	}
+	runner.print(std::cout);
+	return 0;
+}
@@ -0,0 +1,79 @@
+(*
+ * Definitions shared by the benchmarks that run in the Wolfram Language kernel. They are loaded by the benchmark scripts with
+ *
+ *     Get[FileNameJoin[{ParentDirectory[DirectoryName[$InputFileName]], "BenchmarkConfig.wl"}]];
+ *
+ * Options common to all scripts:
+ *
+ *     --install=dir          LLU installation directory, by default the "install" directory in the project root, same as for the unit tests
+ *     --format=csv|json      output format
+ *     --output=file          write results to a file instead of printing them
+ *     --baseline=file.json   compare with results saved earlier with --format=json, exit with code 1 in case of regressions
+ *     --tolerance=0.25       allowed slowdown relative to the baseline
+ *)
+
+Needs["CCompilerDriver`"];
+
+parseOption[arg_String] := With[{kv = StringSplit[StringDrop[arg, 2], "=", 2]}, If[Length[kv] == 2, Rule @@ kv, First[kv] -> "True"]];
+options = Association[parseOption /@ Select[Rest @ $ScriptCommandLine, StringStartsQ[#, "--"]&]];
+option[name_, default_] := Lookup[options, name, default];
+listOption[name_, default_] := If[KeyExistsQ[options, name], StringSplit[options[name], ","], default];
+
+$benchmarksDir = DirectoryName[$InputFileName];
+$installDir = ExpandFileName @ option["install", FileNameJoin[{FileNameDrop[$benchmarksDir, -2], "install"}]];
+
+(* Compile a benchmark library from given source files against the installed LLU, and initialize it as the paclet library *)
+buildBenchmarkLibrary[sources_List, name_String] :=
+	Module[{llu, lib},
+		llu = FileNames[RegularExpression[".*LLU\\.(a|lib|" <> Internal`DynamicLibraryExtension[] <> ")"], $installDir, 2];
+		If[Length[llu] =!= 1,
+			Print["ERROR: Could not find LLU library in ", $installDir];
+			Exit[1]
+		];
+		LibraryLoad /@ FileNames[{"*.so", "*.dll", "*.dylib"}, DirectoryName @ First @ llu];
+		lib = CreateLibrary[sources, name,
+			"CleanIntermediate" -> True,
+			"IncludeDirectories" -> {FileNameJoin[{$installDir, "include"}]},
+			"Libraries" -> {"LLU"},
+			"LibraryDirectories" -> {DirectoryName @ First @ llu},
+			"CompileOptions" -> Switch[$OperatingSystem,
+				"Windows", "/EHsc /O2 /std:c++17",
+				"MacOSX", "-mmacosx-version-min=10.12 -O2 -fvisibility=hidden -std=c++17",
+				_, "-O2 -fvisibility=hidden -std=c++17"
+			],
+			"Language" -> "C++",
+			"TransferProtocolLibrary" -> "WSTP"
+		];
+		If[!StringQ[lib],
+			Print["ERROR: Could not compile ", name];
+			Exit[1]
+		];
+		Get[FileNameJoin[{$installDir, "share", "LibraryLinkUtilities.wl"}]];
+		`LLU`InitializePacletLibrary[lib];
+		lib
+	];
+
+(*
+ * Print or export the results and compare them with the baseline. Results are identified by the values of keys, a result is a regression
+ * if its value of metric is larger than (1 + tolerance) times the value of the baseline result with the same keys.
+ *)
+reportResults[results_List, columns_List, keys_List, metric_String] :=
+	Module[{output, base, tolerance, regressions},
+		output = If[option["format", "csv"] === "json",
+			ExportString[KeyTake[columns] /@ results, "RawJSON", "Compact" -> False],
+			ExportString[Prepend[Lookup[#, columns]& /@ results, columns], "CSV"]
+		];
+		If[KeyExistsQ[options, "output"], Export[options["output"], output, "Text"], Print[output]];
+		If[KeyExistsQ[options, "baseline"],
+			base = AssociationThread[Lookup[#, keys]& /@ #, #]& @ Import[options["baseline"], "RawJSON"];
+			tolerance = ToExpression[option["tolerance", "0.25"]];
+			regressions = Select[results,
+				With[{b = Lookup[base, Key[Lookup[#, keys]], Missing[]]}, !MissingQ[b] && #[metric] > (1 + tolerance) b[metric]]&
+			];
+			If[regressions =!= {},
+				Print["Performance regressions compared to ", options["baseline"], ":"];
+				Scan[Print[StringRiffle[ToString /@ Lookup[#, columns], ", "]]&, regressions];
+				Exit[1]
+			]
+		];
+	];
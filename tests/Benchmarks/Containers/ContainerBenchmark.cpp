@@ -0,0 +1,453 @@
+/**
+ * @file	ContainerBenchmark.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Library functions that measure the per-element cost of operations on LLU containers.
+ *
+ * Containers can only be created inside of a Wolfram Language kernel, so unlike AsyncBenchmark this benchmark is a library loaded by
+ * ContainerBenchmark.wls. Every case prepares its inputs once for a given size and returns an operation, the operation is then timed
+ * inside of the library, so the cost of calling a library function from the Wolfram Language is not included in the results.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <LLU/LLU.h>
+#include <LLU/LibraryLinkFunctionMacro.h>
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	/// Operation of a benchmark case together with the number of elements it processes
+	struct Operation {
+		std::function<void()> run;
+		mint elements = 0;
+	};
+
+	/// Benchmark case takes a size and prepares the operation to be timed
+	using Case = std::function<Operation(mint)>;
+
+	/// Keep a value that the compiler could otherwise optimize out together with the computation that produced it
+	template<typename T>
+	void keep(T value) {
+		static volatile double sink = 0;
+		sink = sink + static_cast<double>(value);
+	}
+
+	/// Side of a square matrix or image with about \p size elements
+	mint side(mint size) {
+		return std::max(mint {1}, static_cast<mint>(std::sqrt(static_cast<double>(size))));
+	}
+
+	/// Side of a cube with about \p size elements
+	mint cubeSide(mint size) {
+		return std::max(mint {1}, static_cast<mint>(std::cbrt(static_cast<double>(size))));
+	}
+
+	template<typename Container>
+	auto share(Container c) {
+		return std::make_shared<Container>(std::move(c));
+	}
+
+	/// Tensor with elements 0, 1, 2, ...
+	LLU::Tensor<double> iota(LLU::MArrayDimensions dims) {
+		return {std::move(dims), [](mint i) { return static_cast<double>(i); }};
+	}
+
+	/// Image with a byte pattern
+	LLU::Image<std::uint8_t> pattern(mint n) {
+		LLU::Image<std::uint8_t> im {n, n, 1, MImage_CS_Gray, false};
+		mint i = 0;
+		for (auto& v : im) {
+			v = static_cast<std::uint8_t>(i++ % 251);
+		}
+		return im;
+	}
+
+	/// Matrix with one explicit element in about every hundred
+	LLU::Tensor<double> sparsePattern(mint n) {
+		return {{n, n}, [](mint i) { return i % 97 == 0 ? 1.0 : 0.0; }};
+	}
+
+	/*
+	 * Pass a container to an MArgument, as if it was the result of a library function, and free it afterwards like LibraryLink does.
+	 * pass() transfers the ownership of a Library-owned container, so the destructor of the container does not free it.
+	 */
+
+	void passAndFree(const LLU::Tensor<double>& t) {
+		MTensor out {};
+		MArgument res;
+		MArgument_getMTensorAddress(res) = &out;
+		t.pass(res);
+		LLU::LibraryData::API()->MTensor_free(out);
+	}
+
+	void passAndFree(const LLU::NumericArray<std::uint8_t>& na) {
+		MNumericArray out {};
+		MArgument res;
+		MArgument_getMNumericArrayAddress(res) = &out;
+		na.pass(res);
+		LLU::LibraryData::NumericArrayAPI()->MNumericArray_free(out);
+	}
+
+	void passAndFree(const LLU::Image<std::uint8_t>& im) {
+		MImage out {};
+		MArgument res;
+		MArgument_getMImageAddress(res) = &out;
+		im.pass(res);
+		LLU::LibraryData::ImageAPI()->MImage_free(out);
+	}
+
+	void passAndFree(const LLU::SparseArray<double>& sa) {
+		MSparseArray out {};
+		MArgument res;
+		MArgument_getMSparseArrayAddress(res) = &out;
+		sa.pass(res);
+		LLU::LibraryData::SparseArrayAPI()->MSparseArray_free(out);
+	}
+
+	void passAndFree(const LLU::DataList<mint>& dl) {
+		// DataStore results are kept in the same slot of MArgument as Tensors
+		DataStore out {};
+		MArgument res;
+		MArgument_getMTensorAddress(res) = reinterpret_cast<MTensor*>(&out);
+		dl.pass(res);
+		LLU::LibraryData::DataStoreAPI()->deleteDataStore(out);
+	}
+
+	LLU::DataList<mint> integerList(mint n) {
+		LLU::DataList<mint> dl;
+		for (mint i = 0; i < n; ++i) {
+			dl.push_back(i);
+		}
+		return dl;
+	}
+
+	const std::map<std::string, Case>& cases() {
+		using LLU::Tensor, LLU::NumericArray, LLU::Image, LLU::SparseArray, LLU::MArrayDimensions;
+		static const std::map<std::string, Case> all {
+			/* Tensor */
+			{"TensorNew", [](mint n) { return Operation {[n] { keep(Tensor<double>(0.0, {n}).size()); }, n}; }},
+			{"TensorIterate",
+			 [](mint n) {
+				 auto t = share(iota({n}));
+				 return Operation {[t] {
+									   double s = 0;
+									   for (auto v : *t) {
+										   s += v;
+									   }
+									   keep(s);
+								   },
+								   n};
+			 }},
+			{"TensorFlatIndex",
+			 [](mint n) {
+				 auto t = share(iota({n}));
+				 return Operation {[t, n] {
+									   double s = 0;
+									   for (mint i = 0; i < n; ++i) {
+										   s += (*t)[i];
+									   }
+									   keep(s);
+								   },
+								   n};
+			 }},
+			{"TensorVectorIndex",
+			 [](mint n) {
+				 const mint k = side(n);
+				 auto t = share(iota({k, k}));
+				 return Operation {[t, k] {
+									   double s = 0;
+									   for (mint i = 0; i < k; ++i) {
+										   for (mint j = 0; j < k; ++j) {
+											   s += (*t)[{i, j}];
+										   }
+									   }
+									   keep(s);
+								   },
+								   k * k};
+			 }},
+			{"TensorTupleIndex",
+			 [](mint n) {
+				 const mint k = side(n);
+				 auto t = share(iota({k, k}));
+				 return Operation {[t, k] {
+									   double s = 0;
+									   for (mint i = 0; i < k; ++i) {
+										   for (mint j = 0; j < k; ++j) {
+											   s += (*t)(i, j);
+										   }
+									   }
+									   keep(s);
+								   },
+								   k * k};
+			 }},
+			{"TensorClone",
+			 [](mint n) {
+				 auto t = share(iota({n}));
+				 return Operation {[t] { keep(t->clone().size()); }, n};
+			 }},
+			{"TensorPass", [](mint n) { return Operation {[n] { passAndFree(Tensor<double>(0.0, {n})); }, n}; }},
+
+			/* NumericArray */
+			{"NumericArrayNew", [](mint n) { return Operation {[n] { keep(NumericArray<std::uint8_t>(0, {n}).size()); }, n}; }},
+			{"NumericArrayIterate",
+			 [](mint n) {
+				 auto na = share(NumericArray<std::uint8_t>({n}, [](mint i) { return static_cast<std::uint8_t>(i); }));
+				 return Operation {[na] {
+									   mint s = 0;
+									   for (auto v : *na) {
+										   s += v;
+									   }
+									   keep(s);
+								   },
+								   n};
+			 }},
+			{"NumericArrayClone",
+			 [](mint n) {
+				 auto na = share(NumericArray<std::uint8_t>(1, {n}));
+				 return Operation {[na] { keep(na->clone().size()); }, n};
+			 }},
+			{"NumericArrayConvert",
+			 [](mint n) {
+				 auto na = share(NumericArray<std::uint8_t>(1, {n}));
+				 return Operation {[na] { keep(NumericArray<double>(*na, LLU::NA::ConversionMethod::Check).size()); }, n};
+			 }},
+			{"NumericArrayPass", [](mint n) { return Operation {[n] { passAndFree(NumericArray<std::uint8_t>(0, {n})); }, n}; }},
+
+			/* Image */
+			{"ImageNew",
+			 [](mint n) {
+				 const mint k = side(n);
+				 return Operation {[k] { keep(Image<std::uint8_t>(k, k, 1, MImage_CS_Gray, false).size()); }, k * k};
+			 }},
+			{"ImageIterate",
+			 [](mint n) {
+				 const mint k = side(n);
+				 auto im = share(pattern(k));
+				 return Operation {[im] {
+									   mint s = 0;
+									   for (auto v : *im) {
+										   s += v;
+									   }
+									   keep(s);
+								   },
+								   k * k};
+			 }},
+			{"ImageGet",
+			 [](mint n) {
+				 const mint k = side(n);
+				 auto im = share(pattern(k));
+				 return Operation {[im, k] {
+									   mint s = 0;
+									   for (mint r = 1; r <= k; ++r) {
+										   for (mint c = 1; c <= k; ++c) {
+											   s += im->get(r, c, 1);
+										   }
+									   }
+									   keep(s);
+								   },
+								   k * k};
+			 }},
+			{"ImagePixels",
+			 [](mint n) {
+				 const mint k = side(n);
+				 auto im = share(pattern(k));
+				 return Operation {[im, k] {
+									   auto px = LLU::pixels(*im);
+									   mint s = 0;
+									   for (mint r = 0; r < k; ++r) {
+										   for (mint c = 0; c < k; ++c) {
+											   s += px(r, c, 0);
+										   }
+									   }
+									   keep(s);
+								   },
+								   k * k};
+			 }},
+			{"ImageClone",
+			 [](mint n) {
+				 const mint k = side(n);
+				 auto im = share(pattern(k));
+				 return Operation {[im] { keep(im->clone().size()); }, k * k};
+			 }},
+			{"ImageConvert",
+			 [](mint n) {
+				 const mint k = side(n);
+				 auto im = share(pattern(k));
+				 return Operation {[im] { keep(im->convert<float>().size()); }, k * k};
+			 }},
+			{"ImagePass",
+			 [](mint n) {
+				 const mint k = side(n);
+				 return Operation {[k] { passAndFree(Image<std::uint8_t>(k, k, 1, MImage_CS_Gray, false)); }, k * k};
+			 }},
+
+			/* SparseArray, elements are the elements of the dense matrix */
+			{"SparseFromTensor",
+			 [](mint n) {
+				 const mint k = side(n);
+				 auto t = share(sparsePattern(k));
+				 return Operation {[t] { keep(SparseArray<double>(*t, 0.0).rank()); }, k * k};
+			 }},
+			{"SparseToTensor",
+			 [](mint n) {
+				 const mint k = side(n);
+				 auto sa = share(SparseArray<double>(sparsePattern(k), 0.0));
+				 return Operation {[sa] { keep(sa->toTensor().size()); }, k * k};
+			 }},
+			{"SparseExplicitValues",
+			 [](mint n) {
+				 const mint k = side(n);
+				 auto sa = share(SparseArray<double>(sparsePattern(k), 0.0));
+				 return Operation {[sa] {
+									   auto values = sa->explicitValues();
+									   keep(std::accumulate(values.begin(), values.end(), 0.0));
+								   },
+								   k * k};
+			 }},
+			{"SparseClone",
+			 [](mint n) {
+				 const mint k = side(n);
+				 auto sa = share(SparseArray<double>(sparsePattern(k), 0.0));
+				 return Operation {[sa] { keep(SparseArray<double> {sa->clone()}.rank()); }, k * k};
+			 }},
+			{"SparsePass",
+			 [](mint n) {
+				 const mint k = side(n);
+				 auto sa = share(SparseArray<double>(sparsePattern(k), 0.0));
+				 return Operation {[sa] { passAndFree(SparseArray<double> {sa->clone()}); }, k * k};
+			 }},
+
+			/* DataList, elements are nodes */
+			{"DataListPushBack", [](mint n) { return Operation {[n] { keep(integerList(n).length()); }, n}; }},
+			{"DataListWalk",
+			 [](mint n) {
+				 auto dl = share(integerList(n));
+				 return Operation {[dl] {
+									   mint s = 0;
+									   for (auto v : dl->valueViews()) {
+										   s += v;
+									   }
+									   keep(s);
+								   },
+								   n};
+			 }},
+			{"DataListClone",
+			 [](mint n) {
+				 auto dl = share(integerList(n));
+				 return Operation {[dl] { keep(dl->clone().length()); }, n};
+			 }},
+			{"DataListPass", [](mint n) { return Operation {[n] { passAndFree(integerList(n)); }, n}; }},
+
+			/* MArrayDimensions, elements are the elements of a cube whose flat indices are computed */
+			{"DimensionsNew",
+			 [](mint n) {
+				 return Operation {[n] {
+									   for (mint i = 0; i < n; ++i) {
+										   keep(MArrayDimensions {i + 1, 2, 3}.flatCount());
+									   }
+								   },
+								   n};
+			 }},
+			{"DimensionsVectorIndex",
+			 [](mint n) {
+				 const mint k = cubeSide(n);
+				 auto dims = share(MArrayDimensions {k, k, k});
+				 return Operation {[dims, k] {
+									   mint s = 0;
+									   for (mint i = 0; i < k; ++i) {
+										   for (mint j = 0; j < k; ++j) {
+											   for (mint l = 0; l < k; ++l) {
+												   s += dims->getIndex(std::vector<mint> {i, j, l});
+											   }
+										   }
+									   }
+									   keep(s);
+								   },
+								   k * k * k};
+			 }},
+			{"DimensionsCheckedIndex",
+			 [](mint n) {
+				 const mint k = cubeSide(n);
+				 auto dims = share(MArrayDimensions {k, k, k});
+				 return Operation {[dims, k] {
+									   mint s = 0;
+									   for (mint i = 0; i < k; ++i) {
+										   for (mint j = 0; j < k; ++j) {
+											   for (mint l = 0; l < k; ++l) {
+												   s += dims->getIndexChecked(std::vector<mint> {i, j, l});
+											   }
+										   }
+									   }
+									   keep(s);
+								   },
+								   k * k * k};
+			 }},
+			{"DimensionsTupleIndex",
+			 [](mint n) {
+				 const mint k = cubeSide(n);
+				 auto dims = share(MArrayDimensions {k, k, k});
+				 return Operation {[dims, k] {
+									   mint s = 0;
+									   for (mint i = 0; i < k; ++i) {
+										   for (mint j = 0; j < k; ++j) {
+											   for (mint l = 0; l < k; ++l) {
+												   s += dims->getIndex(i, j, l);
+											   }
+										   }
+									   }
+									   keep(s);
+								   },
+								   k * k * k};
+			 }},
+		};
+		return all;
+	}
+
+	double timeRuns(const Operation& op, mint n) {
+		const auto start = Clock::now();
+		for (mint i = 0; i < n; ++i) {
+			op.run();
+		}
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+}  // namespace
+
+EXTERN_C DLLEXPORT int WolframLibrary_initialize(WolframLibraryData libData) {
+	LLU::LibraryData::setLibraryData(libData);
+	LLU::ErrorManager::registerPacletErrors({{"UnknownCase", "Benchmark case `name` does not exist."}});
+	return LLU::ErrorCode::NoError;
+}
+
+/**
+ * Run a benchmark case. Arguments are the case name, the size, the minimal duration of a single repetition in seconds and the number of
+ * repetitions. The result is a Real Tensor {runs, elements, seconds}, where seconds is the median duration of runs operations on elements.
+ */
+LLU_LIBRARY_FUNCTION(RunCase) {
+	auto [name, size, minTime, repetitions] = mngr.getTuple<std::string, mint, double, mint>();
+	const auto& all = cases();
+	auto c = all.find(name);
+	if (c == all.end()) {
+		LLU::ErrorManager::throwException("UnknownCase", name);
+	}
+	const auto op = c->second(size);
+	// warm-up and calibration: grow the number of runs until a repetition takes at least minTime
+	mint runs = 1;
+	while (timeRuns(op, runs) < minTime && runs < (mint {1} << 30)) {
+		runs *= 2;
+	}
+	std::vector<double> times;
+	for (mint i = 0; i < std::max(repetitions, mint {1}); ++i) {
+		times.push_back(timeRuns(op, runs));
+	}
+	std::nth_element(times.begin(), times.begin() + static_cast<std::ptrdiff_t>(times.size() / 2), times.end());
+	mngr.set(LLU::Tensor<double> {static_cast<double>(runs), static_cast<double>(op.elements), times[times.size() / 2]});
+}
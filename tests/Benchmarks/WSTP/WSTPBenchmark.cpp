@@ -0,0 +1,305 @@
+/**
+ * @file	WSTPBenchmark.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Library functions that measure the throughput of sending and receiving expressions with LLU::WSStream.
+ *
+ * Every benchmark case describes an expression of given size together with the code that sends it and the code that reads it back with
+ * WSStream. Cases are measured on two kinds of links:
+ *  - Loopback - RunLoopbackCase puts the expression to a loopback link and reads it back, both directions are timed inside of the library,
+ *  - Kernel   - WSTPBenchmark.wls calls PutExpression and GetExpression, so the expression travels over the link to the Wolfram Language kernel
+ *               and the result includes the cost of the library function call.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "wstp.h"
+
+#include <LLU/LLU.h>
+#include <LLU/LibraryLinkFunctionMacro.h>
+#include <LLU/WSTP/WSStream.hpp>
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+	using LLU::WS::Encoding;
+
+	/// All cases use the same stream type, strings in other encodings are sent with WS::putAs and read with WS::getAs
+	using Stream = LLU::WSStream<Encoding::UTF8>;
+
+	/// Expression of a benchmark case
+	struct Payload {
+		/// Send the expression
+		std::function<void(Stream&)> put;
+
+		/// Read the expression, it must be the next one on the link
+		std::function<void(Stream&)> get;
+
+		/// Number of bytes of data in the expression, not counting the heads
+		mint bytes = 0;
+
+		/// Number of atomic expressions sent or received one at a time, 1 for arrays, strings and other expressions sent in one piece
+		mint expressions = 1;
+	};
+
+	/// Benchmark case takes a size and prepares the expression
+	using Case = std::function<Payload(mint)>;
+
+	/// Keep a value that the compiler could otherwise optimize out together with the computation that produced it
+	template<typename T>
+	void keep(T value) {
+		static volatile double sink = 0;
+		sink = sink + static_cast<double>(value);
+	}
+
+	/// List of \p n scalars sent with a separate WSPut call each
+	template<typename T>
+	Payload scalars(mint n) {
+		return {[n](Stream& ms) {
+					ms << LLU::WS::List(static_cast<int>(n));
+					for (mint i = 0; i < n; ++i) {
+						ms << static_cast<T>(i);
+					}
+				},
+				[](Stream& ms) {
+					LLU::WS::List l;
+					ms >> l;
+					T s {};
+					for (int i = 0; i < l.getArgc(); ++i) {
+						T v {};
+						ms >> v;
+						s += v;
+					}
+					keep(s);
+				},
+				n * static_cast<mint>(sizeof(T)), n};
+	}
+
+	/// Flat List sent with WSPut*List
+	Payload realList(mint n) {
+		auto data = std::make_shared<std::vector<double>>(static_cast<std::size_t>(n), 1.0);
+		return {[data](Stream& ms) { ms << *data; },
+				[](Stream& ms) {
+					std::vector<double> v;
+					ms >> v;
+					keep(v.size());
+				},
+				n * static_cast<mint>(sizeof(double))};
+	}
+
+	/// Square matrix sent with WSPut*Array
+	Payload realArray(mint n) {
+		const mint k = std::max(mint {1}, static_cast<mint>(std::sqrt(static_cast<double>(n))));
+		auto data = std::make_shared<LLU::Tensor<double>>(1.0, LLU::MArrayDimensions {k, k});
+		return {[data](Stream& ms) { ms << *data; },
+				[](Stream& ms) {
+					LLU::Tensor<double> t;
+					ms >> t;
+					keep(t.size());
+				},
+				k * k * static_cast<mint>(sizeof(double))};
+	}
+
+	void putNested(Stream& ms, mint branching, int depth) {
+		if (depth == 0) {
+			ms << mint {1};
+			return;
+		}
+		ms << LLU::WS::BeginExpr("List");
+		for (mint i = 0; i < branching; ++i) {
+			putNested(ms, branching, depth - 1);
+		}
+		ms << LLU::WS::EndExpr();
+	}
+
+	mint getNested(Stream& ms, int depth) {
+		if (depth == 0) {
+			mint leaf = 0;
+			ms >> leaf;
+			return leaf;
+		}
+		LLU::WS::List l;
+		ms >> l;
+		mint leaves = 0;
+		for (int i = 0; i < l.getArgc(); ++i) {
+			leaves += getNested(ms, depth - 1);
+		}
+		return leaves;
+	}
+
+	/// Balanced tree of Lists of given \p depth with about \p n integer leaves, every List is sent with BeginExpr and EndExpr
+	Payload nested(mint n, int depth, LLU::WS::ExprMode mode) {
+		const auto branching = std::max(mint {2}, static_cast<mint>(std::lround(std::pow(static_cast<double>(n), 1.0 / depth))));
+		const auto leaves = static_cast<mint>(std::lround(std::pow(static_cast<double>(branching), depth)));
+		return {[branching, depth, mode](Stream& ms) {
+					const auto previous = ms.getExprMode();
+					ms.setExprMode(mode);
+					putNested(ms, branching, depth);
+					ms.setExprMode(previous);
+				},
+				[depth](Stream& ms) { keep(getNested(ms, depth)); },
+				leaves * static_cast<mint>(sizeof(mint)), leaves};
+	}
+
+	/// ASCII string of \p n characters sent in encoding \p E, \p fastUTF8 is the value of EncodingConfig::useFastUTF8 while it is sent
+	/// (it only matters for UTF8)
+	template<Encoding E>
+	Payload string(mint n, bool fastUTF8) {
+		using CharT = LLU::WS::CharType<E>;
+		auto data = std::make_shared<std::basic_string<CharT>>();
+		for (mint i = 0; i < n; ++i) {
+			data->push_back(static_cast<CharT>('a' + i % 26));
+		}
+		return {[data, fastUTF8](Stream& ms) {
+					const bool previous = LLU::WS::EncodingConfig::useFastUTF8;
+					LLU::WS::EncodingConfig::useFastUTF8 = fastUTF8;
+					ms << LLU::WS::putAs<E>(*data);
+					LLU::WS::EncodingConfig::useFastUTF8 = previous;
+				},
+				[](Stream& ms) {
+					std::basic_string<CharT> s;
+					ms >> LLU::WS::getAs<E>(s);
+					keep(s.size());
+				},
+				n * static_cast<mint>(sizeof(CharT))};
+	}
+
+	/// Association with \p n String keys and Integer values, sent from and read to std::map
+	Payload association(mint n) {
+		auto data = std::make_shared<std::map<std::string, mint>>();
+		mint bytes = 0;
+		for (mint i = 0; i < n; ++i) {
+			auto key = "key" + std::to_string(i);
+			bytes += static_cast<mint>(key.size() + sizeof(mint));
+			data->emplace(std::move(key), i);
+		}
+		return {[data](Stream& ms) { ms << *data; },
+				[](Stream& ms) {
+					std::map<std::string, mint> m;
+					ms >> m;
+					keep(m.size());
+				},
+				bytes, n};
+	}
+
+	const std::map<std::string, Case>& cases() {
+		using LLU::WS::ExprMode;
+		static const std::map<std::string, Case> all {
+			{"Integer", scalars<mint>},
+			{"Real", scalars<double>},
+			{"PutList", realList},
+			{"PutArray", realArray},
+			{"NestedLoopback2", [](mint n) { return nested(n, 2, ExprMode::Loopback); }},
+			{"NestedLoopback4", [](mint n) { return nested(n, 4, ExprMode::Loopback); }},
+			{"NestedLoopback8", [](mint n) { return nested(n, 8, ExprMode::Loopback); }},
+			{"NestedBuffered2", [](mint n) { return nested(n, 2, ExprMode::Buffered); }},
+			{"NestedBuffered4", [](mint n) { return nested(n, 4, ExprMode::Buffered); }},
+			{"NestedBuffered8", [](mint n) { return nested(n, 8, ExprMode::Buffered); }},
+			{"StringNative", [](mint n) { return string<Encoding::Native>(n, true); }},
+			{"StringByte", [](mint n) { return string<Encoding::Byte>(n, true); }},
+			{"StringUTF8", [](mint n) { return string<Encoding::UTF8>(n, false); }},
+			{"StringUTF8Fast", [](mint n) { return string<Encoding::UTF8>(n, true); }},
+			{"StringUTF16", [](mint n) { return string<Encoding::UTF16>(n, true); }},
+			{"StringUCS2", [](mint n) { return string<Encoding::UCS2>(n, true); }},
+			{"StringUTF32", [](mint n) { return string<Encoding::UTF32>(n, true); }},
+			{"Association", association},
+		};
+		return all;
+	}
+
+	/// Get the payload of a case, payloads are cached so that the calls from the Wolfram Language do not include their construction
+	const Payload& payload(const std::string& name, mint size) {
+		static std::map<std::pair<std::string, mint>, Payload> cache;
+		auto key = std::make_pair(name, size);
+		if (auto p = cache.find(key); p != cache.end()) {
+			return p->second;
+		}
+		const auto& all = cases();
+		auto c = all.find(name);
+		if (c == all.end()) {
+			LLU::ErrorManager::throwException("UnknownCase", name);
+		}
+		return cache.emplace(std::move(key), c->second(size)).first->second;
+	}
+
+	double seconds(Clock::duration d) {
+		return std::chrono::duration<double>(d).count();
+	}
+
+	double median(std::vector<double> values) {
+		std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(values.size() / 2), values.end());
+		return values[values.size() / 2];
+	}
+}  // namespace
+
+EXTERN_C DLLEXPORT int WolframLibrary_initialize(WolframLibraryData libData) {
+	LLU::LibraryData::setLibraryData(libData);
+	LLU::ErrorManager::registerPacletErrors({{"UnknownCase", "Benchmark case `name` does not exist."}});
+	return LLU::ErrorCode::NoError;
+}
+
+/**
+ * Run a benchmark case on a loopback link. Arguments are the case name, the size, the minimal duration of a single repetition in seconds
+ * and the number of repetitions. The result is a Real Tensor {runs, bytes, expressions, put seconds, get seconds}, where the times are
+ * medians over the repetitions of the total time of runs puts and runs gets, respectively.
+ */
+LLU_LIBRARY_FUNCTION(RunLoopbackCase) {
+	auto [name, size, minTime, repetitions] = mngr.getTuple<std::string, mint, double, mint>();
+	const auto& p = payload(name, size);
+	std::unique_ptr<std::remove_pointer_t<WSLINK>, decltype(&WSClose)> link {
+		LLU::WS::Detail::getNewLoopback(LLU::LibraryData::API()->getWSLINK(LLU::LibraryData::API())), &WSClose};
+	Stream ms {link.get()};
+	// every run is a put immediately followed by a get, so the loopback link never holds more than one expression
+	auto measure = [&p, &ms](mint runs) {
+		Clock::duration put {};
+		Clock::duration get {};
+		for (mint i = 0; i < runs; ++i) {
+			const auto start = Clock::now();
+			p.put(ms);
+			const auto mid = Clock::now();
+			p.get(ms);
+			get += Clock::now() - mid;
+			put += mid - start;
+		}
+		return std::make_pair(seconds(put), seconds(get));
+	};
+	// warm-up and calibration: grow the number of runs until a repetition takes at least minTime
+	mint runs = 1;
+	for (auto t = measure(runs); t.first + t.second < minTime && runs < (mint {1} << 30); t = measure(runs)) {
+		runs *= 2;
+	}
+	std::vector<double> puts;
+	std::vector<double> gets;
+	for (mint i = 0; i < std::max(repetitions, mint {1}); ++i) {
+		auto [put, get] = measure(runs);
+		puts.push_back(put);
+		gets.push_back(get);
+	}
+	mngr.set(LLU::Tensor<double> {static_cast<double>(runs), static_cast<double>(p.bytes), static_cast<double>(p.expressions), median(puts),
+								  median(gets)});
+}
+
+/// Take {name, size} and send the expression of the case to the kernel
+LLU_WSTP_FUNCTION(PutExpression) {
+	Stream ms {wsl, "List", 2};
+	std::string name;
+	mint size = 0;
+	ms >> name >> size;
+	payload(name, size).put(ms);
+}
+
+/// Take {name, size, expr}, where expr is the result of PutExpression[name, size], read expr and return {bytes, expressions}
+LLU_WSTP_FUNCTION(GetExpression) {
+	Stream ms {wsl, "List", 3};
+	std::string name;
+	mint size = 0;
+	ms >> name >> size;
+	const auto& p = payload(name, size);
+	p.get(ms);
+	ms << LLU::WS::List(2) << p.bytes << p.expressions;
+}
@@ -0,0 +1,106 @@
+BeginPackage["CallBenchmark`"];
+
+$CallBenchmarkCases::usage = "$CallBenchmarkCases is a list of associations that describe available benchmark cases. Each case has a \"Name\", \
+LibraryLink \"Arguments\" and \"Result\" types, a list of \"Variants\", a list of input \"Sizes\" and an \"Input\" function that takes a size and \
+returns the list of arguments.";
+
+RunCallBenchmark::usage = "RunCallBenchmark[opts] runs the benchmark and returns a list of associations, one for each case, variant and size, with \
+keys \"Case\", \"Variant\", \"Size\", \"Calls\", \"NsPerCall\", \"OverheadNs\" (compared to the \"Raw\" variant of the same case and size) and \
+\"AllocationsPerCall\".";
+
+CompareCallBenchmark::usage = "CompareCallBenchmark[results, baseline, tolerance] returns the list of results that are slower than the corresponding \
+baseline results by more than tolerance (relative to the baseline time per call) or that allocate more.";
+
+Begin["`Private`"];
+
+$BaseDirectory = FileNameDrop[$InputFileName, -2];
+Get[FileNameJoin[{$BaseDirectory, "LibraryResources", "LibraryLinkUtilities.wl"}]];
+
+$library := $library = `LLU`InitializePacletLibrary["CallBenchmark"];
+
+(* All functions are loaded with plain LibraryFunctionLoad, so the cost on the Wolfram Language side is the same for all variants *)
+load[name_, args_, res_] := load[name, args, res] = LibraryFunctionLoad[$library, name, args, res];
+
+allocationCount[] := load["AllocationCount", {}, Integer][];
+
+$allVariants = {"Raw", "LLU", "Typed"};
+
+$CallBenchmarkCases = {
+	<|"Name" -> "Void", "Arguments" -> {}, "Result" -> "Void", "Variants" -> $allVariants, "Sizes" -> {0}, "Input" -> ({} &)|>,
+	<|"Name" -> "Integer", "Arguments" -> {Integer}, "Result" -> Integer, "Variants" -> $allVariants, "Sizes" -> {0}, "Input" -> ({42} &)|>,
+	<|"Name" -> "IntegerTuple", "Arguments" -> {Integer, Integer, Integer, Integer}, "Result" -> Integer, "Variants" -> $allVariants,
+		"Sizes" -> {0}, "Input" -> ({1, 2, 3, 4} &)|>,
+	<|"Name" -> "Real", "Arguments" -> {Real}, "Result" -> Real, "Variants" -> $allVariants, "Sizes" -> {0}, "Input" -> ({1.5} &)|>,
+	<|"Name" -> "String", "Arguments" -> {String}, "Result" -> String, "Variants" -> $allVariants, "Sizes" -> {8, 1024, 65536},
+		"Input" -> ({StringRepeat["abcdefgh", Ceiling[#/8]]} &)|>,
+	<|"Name" -> "StringView", "Arguments" -> {String}, "Result" -> Integer, "Variants" -> $allVariants, "Sizes" -> {8, 1024, 65536},
+		"Input" -> ({StringRepeat["abcdefgh", Ceiling[#/8]]} &)|>,
+	<|"Name" -> "Tensor", "Arguments" -> {{Real, 1, "Constant"}}, "Result" -> Real, "Variants" -> $allVariants, "Sizes" -> {1, 1000, 1000000},
+		"Input" -> ({N @ Range[#]} &)|>,
+	<|"Name" -> "TensorResult", "Arguments" -> {Integer}, "Result" -> {Real, 1}, "Variants" -> {"Raw", "LLU"}, "Sizes" -> {1, 1000, 1000000},
+		"Input" -> ({#} &)|>,
+	<|"Name" -> "NumericArray", "Arguments" -> {{"NumericArray", "Constant"}}, "Result" -> Integer, "Variants" -> $allVariants,
+		"Sizes" -> {1, 1000, 1000000}, "Input" -> ({NumericArray[Mod[Range[#], 256], "UnsignedInteger8"]} &)|>,
+	<|"Name" -> "Error", "Arguments" -> {Integer}, "Result" -> Integer, "Variants" -> {"Raw", "LLU"}, "Sizes" -> {0}, "Input" -> ({42} &)|>
+};
+
+Options[RunCallBenchmark] = {
+	"Cases" -> All,         (* list of case names, or All *)
+	"Variants" -> All,      (* list of variant names, or All; "Raw" is always measured because it is the reference for "OverheadNs" *)
+	"MinTime" -> 0.1,       (* minimal duration of a single repetition, in seconds *)
+	"Repetitions" -> 5      (* number of repetitions, the reported time is the median *)
+};
+
+RunCallBenchmark[opts : OptionsPattern[]] :=
+	Module[{cases, variants},
+		cases = $CallBenchmarkCases;
+		If[OptionValue["Cases"] =!= All, cases = Select[cases, MemberQ[OptionValue["Cases"], #Name]&]];
+		variants = If[OptionValue["Variants"] === All, $allVariants, Union[{"Raw"}, OptionValue["Variants"]]];
+		Flatten @ Table[
+			runCase[case, Intersection[case["Variants"], variants], size, OptionValue["MinTime"], OptionValue["Repetitions"]],
+			{case, cases},
+			{size, case["Sizes"]}
+		]
+	];
+
+runCase[case_, variants_, size_, minTime_, repetitions_] :=
+	Module[{args = case["Input"][size], results},
+		results = Table[
+			Join[<|"Case" -> case["Name"], "Variant" -> v, "Size" -> size|>,
+				measure[load[v <> case["Name"], case["Arguments"], case["Result"]], args, minTime, repetitions]],
+			{v, SortBy[variants, Position[$allVariants, #]&]}
+		];
+		With[{raw = SelectFirst[results, #Variant === "Raw"&]["NsPerCall"]},
+			Append[#, "OverheadNs" -> #NsPerCall - raw]& /@ results
+		]
+	];
+
+(* Time n calls, the error case issues a LibraryFunction::rterr message on every call, so messages are suppressed *)
+timeCalls[f_, args_, n_] := First @ AbsoluteTiming[Quiet[Do[f @@ args, n]]];
+
+measure[f_, args_, minTime_, repetitions_] :=
+	Module[{n = 1, times, allocs},
+		(* warm-up and calibration: grow the number of calls until a repetition takes at least minTime *)
+		While[timeCalls[f, args, n] < minTime && n < 2^30, n *= 2];
+		times = Table[timeCalls[f, args, n], repetitions];
+		allocs = allocationCount[];
+		timeCalls[f, args, n];
+		allocs = allocationCount[] - allocs;
+		<|"Calls" -> n, "NsPerCall" -> 10.^9 Median[times] / n, "AllocationsPerCall" -> N[allocs / n]|>
+	];
+
+CompareCallBenchmark[results_List, baseline_List, tolerance_?NumericQ] :=
+	Module[{key, base},
+		key = {#Case, #Variant, #Size}&;
+		base = AssociationThread[key /@ baseline, baseline];
+		Select[results,
+			With[{b = Lookup[base, Key[key[#]], Missing[]]},
+				!MissingQ[b] && #Variant =!= "Raw" &&
+					(#OverheadNs - b["OverheadNs"] > tolerance * b["NsPerCall"] || #AllocationsPerCall > b["AllocationsPerCall"])
+			]&
+		]
+	];
+
+End[];
+
+EndPackage[];
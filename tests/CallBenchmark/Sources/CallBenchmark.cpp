@@ -0,0 +1,288 @@
+/**
+ * @file	CallBenchmark.cpp
+ * @author	Rafal Chojna <rafalc@wolfram.com>
+ * @brief   Library functions that measure the per-call cost of LLU compared to plain LibraryLink.
+ *
+ * Every benchmark case is implemented up to three times with identical semantics:
+ *  - Raw   - plain LIBRARY_LINK_FUNCTION that uses only the LibraryLink C API,
+ *  - LLU   - LLU_LIBRARY_FUNCTION that reads arguments with MArgumentManager getters and returns the result with set(),
+ *  - Typed - LLU_TYPED_FUNCTION generated from a C++ function, which reads arguments with getTuple.
+ *
+ * The library also replaces the global allocation functions to count calls to operator new, see AllocationCount.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+#include <LLU/LLU.h>
+#include <LLU/LibraryLinkFunctionMacro.h>
+
+namespace {
+	/// Number of calls to operator new made from this library since it was loaded
+	std::atomic<mint> allocationCount {0};
+
+	void* countedAlloc(std::size_t size) {
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+		return std::malloc(size == 0 ? 1 : size);
+	}
+}  // namespace
+
+/*
+ * Replacements of the global allocation functions. Memory comes from malloc, which is what the default operator new uses on all supported
+ * platforms, so memory allocated inside the standard library and released here (or vice versa) is handled correctly.
+ * Only allocations made by code compiled into this library are counted, including LLU and inlined standard library code. Allocations done
+ * inside the shared standard library, e.g. by the explicitly instantiated std::string members of libstdc++, are not visible.
+ */
+void* operator new(std::size_t size) {
+	if (auto* p = countedAlloc(size)) {
+		return p;
+	}
+	throw std::bad_alloc {};
+}
+
+void* operator new[](std::size_t size) {
+	return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t& /*tag*/) noexcept {
+	return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& /*tag*/) noexcept {
+	return countedAlloc(size);
+}
+
+void operator delete(void* p) noexcept {
+	std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t /*size*/) noexcept {
+	std::free(p);
+}
+
+void operator delete[](void* p, std::size_t /*size*/) noexcept {
+	std::free(p);
+}
+
+EXTERN_C DLLEXPORT int WolframLibrary_initialize(WolframLibraryData libData) {
+	LLU::LibraryData::setLibraryData(libData);
+	return LLU::ErrorCode::NoError;
+}
+
+/// Get the number of calls to operator new made from this library so far, the function itself does not allocate
+EXTERN_C DLLEXPORT int AllocationCount(WolframLibraryData /*libData*/, mint /*Argc*/, MArgument* /*Args*/, MArgument Res) {
+	MArgument_setInteger(Res, allocationCount.load(std::memory_order_relaxed));
+	return LIBRARY_NO_ERROR;
+}
+
+/* ==================== Void: no arguments, no result ==================== */
+
+namespace {
+	void nothing() {}
+}  // namespace
+
+EXTERN_C DLLEXPORT int RawVoid(WolframLibraryData /*libData*/, mint /*Argc*/, MArgument* /*Args*/, MArgument /*Res*/) {
+	return LIBRARY_NO_ERROR;
+}
+
+LLU_LIBRARY_FUNCTION(LLUVoid) {
+	static_cast<void>(mngr);
+}
+
+LLU_TYPED_FUNCTION(TypedVoid, nothing)
+
+/* ==================== Integer: one Integer argument, Integer result ==================== */
+
+namespace {
+	mint increment(mint n) {
+		return n + 1;
+	}
+}  // namespace
+
+EXTERN_C DLLEXPORT int RawInteger(WolframLibraryData /*libData*/, mint /*Argc*/, MArgument* Args, MArgument Res) {
+	MArgument_setInteger(Res, increment(MArgument_getInteger(Args[0])));
+	return LIBRARY_NO_ERROR;
+}
+
+LLU_LIBRARY_FUNCTION(LLUInteger) {
+	mngr.set(increment(mngr.getInteger<mint>(0)));
+}
+
+LLU_TYPED_FUNCTION(TypedInteger, increment)
+
+/* ==================== IntegerTuple: four Integer arguments, Integer result ==================== */
+
+namespace {
+	mint sum4(mint a, mint b, mint c, mint d) {
+		return a + b + c + d;
+	}
+}  // namespace
+
+EXTERN_C DLLEXPORT int RawIntegerTuple(WolframLibraryData /*libData*/, mint /*Argc*/, MArgument* Args, MArgument Res) {
+	MArgument_setInteger(Res, sum4(MArgument_getInteger(Args[0]), MArgument_getInteger(Args[1]), MArgument_getInteger(Args[2]),
+								   MArgument_getInteger(Args[3])));
+	return LIBRARY_NO_ERROR;
+}
+
+LLU_LIBRARY_FUNCTION(LLUIntegerTuple) {
+	auto [a, b, c, d] = mngr.getTuple<mint, mint, mint, mint>();
+	mngr.set(sum4(a, b, c, d));
+}
+
+LLU_TYPED_FUNCTION(TypedIntegerTuple, sum4)
+
+/* ==================== Real: one Real argument, Real result ==================== */
+
+namespace {
+	double half(double x) {
+		return x / 2;
+	}
+}  // namespace
+
+EXTERN_C DLLEXPORT int RawReal(WolframLibraryData /*libData*/, mint /*Argc*/, MArgument* Args, MArgument Res) {
+	MArgument_setReal(Res, half(MArgument_getReal(Args[0])));
+	return LIBRARY_NO_ERROR;
+}
+
+LLU_LIBRARY_FUNCTION(LLUReal) {
+	mngr.set(half(mngr.getReal(0)));
+}
+
+LLU_TYPED_FUNCTION(TypedReal, half)
+
+/* ==================== String: one String argument, String result of the same length ==================== */
+
+namespace {
+	std::string upper(std::string s) {
+		for (auto& c : s) {
+			if (c >= 'a' && c <= 'z') {
+				c = static_cast<char>(c - 'a' + 'A');
+			}
+		}
+		return s;
+	}
+
+	/// The result must outlive the call, in the raw implementation it is kept until the next call
+	std::string rawStringResult;
+}  // namespace
+
+EXTERN_C DLLEXPORT int RawString(WolframLibraryData libData, mint /*Argc*/, MArgument* Args, MArgument Res) {
+	char* in = MArgument_getUTF8String(Args[0]);
+	rawStringResult = upper(in);
+	libData->UTF8String_disown(in);
+	MArgument_setUTF8String(Res, rawStringResult.data());
+	return LIBRARY_NO_ERROR;
+}
+
+LLU_LIBRARY_FUNCTION(LLUString) {
+	mngr.set(upper(mngr.getString(0)));
+}
+
+LLU_TYPED_FUNCTION(TypedString, upper)
+
+/* ==================== StringView: one String argument, Integer result (length), no copy of the string ==================== */
+
+namespace {
+	mint length(std::string_view s) {
+		return static_cast<mint>(s.size());
+	}
+}  // namespace
+
+EXTERN_C DLLEXPORT int RawStringView(WolframLibraryData libData, mint /*Argc*/, MArgument* Args, MArgument Res) {
+	char* in = MArgument_getUTF8String(Args[0]);
+	MArgument_setInteger(Res, length(in));
+	libData->UTF8String_disown(in);
+	return LIBRARY_NO_ERROR;
+}
+
+LLU_LIBRARY_FUNCTION(LLUStringView) {
+	mngr.set(length(mngr.getStringView(0)));
+}
+
+LLU_TYPED_FUNCTION(TypedStringView, length)
+
+/* ==================== Tensor: one "Constant" real Tensor argument, Real result (sum of elements) ==================== */
+
+namespace {
+	double total(const LLU::Tensor<double>& t) {
+		return std::accumulate(t.begin(), t.end(), 0.0);
+	}
+}  // namespace
+
+EXTERN_C DLLEXPORT int RawTensor(WolframLibraryData libData, mint /*Argc*/, MArgument* Args, MArgument Res) {
+	MTensor t = MArgument_getMTensor(Args[0]);
+	const double* data = libData->MTensor_getRealData(t);
+	MArgument_setReal(Res, std::accumulate(data, data + libData->MTensor_getFlattenedLength(t), 0.0));
+	return LIBRARY_NO_ERROR;
+}
+
+LLU_LIBRARY_FUNCTION(LLUTensor) {
+	mngr.set(total(mngr.getTensor<double, LLU::Passing::Constant>(0)));
+}
+
+LLU_TYPED_FUNCTION(TypedTensor, total)
+
+/* ==================== TensorResult: one Integer argument n, result is a new real Tensor of length n ==================== */
+
+EXTERN_C DLLEXPORT int RawTensorResult(WolframLibraryData libData, mint /*Argc*/, MArgument* Args, MArgument Res) {
+	mint n = MArgument_getInteger(Args[0]);
+	MTensor t {};
+	if (int err = libData->MTensor_new(MType_Real, 1, &n, &t); err != LIBRARY_NO_ERROR) {
+		return err;
+	}
+	double* data = libData->MTensor_getRealData(t);
+	std::iota(data, data + n, 0.0);
+	MArgument_setMTensor(Res, t);
+	return LIBRARY_NO_ERROR;
+}
+
+LLU_LIBRARY_FUNCTION(LLUTensorResult) {
+	LLU::Tensor<double> t {0.0, LLU::MArrayDimensions {mngr.getInteger<mint>(0)}};
+	std::iota(t.begin(), t.end(), 0.0);
+	mngr.set(t);
+}
+
+/* ==================== NumericArray: one "Constant" NumericArray of bytes, Integer result (sum of elements) ==================== */
+
+namespace {
+	mint byteTotal(const LLU::NumericArray<std::uint8_t>& na) {
+		return std::accumulate(na.begin(), na.end(), mint {0});
+	}
+}  // namespace
+
+EXTERN_C DLLEXPORT int RawNumericArray(WolframLibraryData libData, mint /*Argc*/, MArgument* Args, MArgument Res) {
+	MNumericArray na = MArgument_getMNumericArray(Args[0]);
+	auto* naFuns = libData->numericarrayLibraryFunctions;
+	if (naFuns->MNumericArray_getType(na) != MNumericArray_Type_UBit8) {
+		return LIBRARY_TYPE_ERROR;
+	}
+	const auto* data = static_cast<const std::uint8_t*>(naFuns->MNumericArray_getData(na));
+	MArgument_setInteger(Res, std::accumulate(data, data + naFuns->MNumericArray_getFlattenedLength(na), mint {0}));
+	return LIBRARY_NO_ERROR;
+}
+
+LLU_LIBRARY_FUNCTION(LLUNumericArray) {
+	mngr.set(byteTotal(mngr.getNumericArray<std::uint8_t, LLU::Passing::Constant>(0)));
+}
+
+LLU_TYPED_FUNCTION(TypedNumericArray, byteTotal)
+
+/* ==================== Error: one Integer argument, the function always fails ==================== */
+
+EXTERN_C DLLEXPORT int RawError(WolframLibraryData /*libData*/, mint /*Argc*/, MArgument* /*Args*/, MArgument /*Res*/) {
+	return LIBRARY_FUNCTION_ERROR;
+}
+
+LLU_LIBRARY_FUNCTION(LLUError) {
+	LLU::ErrorManager::throwException(LLU::ErrorName::FunctionError, mngr.getInteger<mint>(0));
+}
@@ -0,0 +1,112 @@
+/**
+ * @file
+ * @brief	Unit tests of coroutine tasks from LLU/Async/Coroutine.h, this file is compiled as C++20
+ */
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include <LLU/Async/Coroutine.h>
+#include <LLU/Async/ThreadPool.h>
+#include <LLU/LLU.h>
+#include <LLU/LibraryLinkFunctionMacro.h>
+
+static_assert(LLU::Async::coroutinesEnabled, "Coroutine tests must be compiled with C++20 coroutine support");
+
+namespace Async = LLU::Async;
+
+EXTERN_C DLLEXPORT int WolframLibrary_initialize(WolframLibraryData libData) {
+	LLU::LibraryData::setLibraryData(libData);
+	return 0;
+}
+
+namespace {
+	template<typename Pool>
+	Async::Task<mint> fib(Pool& pool, mint n) {
+		if (n < 2) {
+			co_return n;
+		}
+		auto a = Async::spawn(pool, fib(pool, n - 1));
+		auto b = co_await fib(pool, n - 2);
+		co_return co_await std::move(a) + b;
+	}
+
+	template<typename Pool>
+	Async::Task<> hop(Pool& pool, std::thread::id caller, std::atomic<mint>& onWorker) {
+		co_await pool.schedule();
+		if (std::this_thread::get_id() != caller) {
+			onWorker.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	template<typename Pool>
+	Async::Task<mint> fail(Pool& pool) {
+		co_await pool.schedule();
+		throw std::runtime_error("failed task");
+	}
+
+	template<typename Pool>
+	Async::Task<mint> recover(Pool& pool) {
+		try {
+			co_await fail(pool);
+		} catch (const std::runtime_error&) {
+			co_return 1;
+		}
+		co_return 0;
+	}
+
+	mint square(mint i) {
+		return i * i;
+	}
+
+	template<typename Pool>
+	Async::Task<mint> awaitFutures(Pool& pool, mint n) {
+		mint sum = 0;
+		for (mint i = 1; i <= n; ++i) {
+			sum += co_await Async::spawn(pool, square, i);
+		}
+		co_return sum;
+	}
+}  // namespace
+
+/// CoroutineFib[n, threads] computes Fibonacci[n], every call spawns a subtask and awaits it
+LLU_LIBRARY_FUNCTION(CoroutineFib) {
+	auto [n, threads] = mngr.getTuple<mint, mint>();
+	LLU::ThreadPool pool {static_cast<unsigned>(threads)};
+	mngr.set(Async::spawn(pool, fib(pool, n)).get());
+}
+
+/// CoroutineHops[tasks, threads] returns the number of tasks that continued in a worker thread after awaiting schedule()
+LLU_LIBRARY_FUNCTION(CoroutineHops) {
+	auto [tasks, threads] = mngr.getTuple<mint, mint>();
+	std::atomic<mint> onWorker = 0;
+	{
+		LLU::LockFreeThreadPool pool {static_cast<unsigned>(threads)};
+		std::vector<Async::Future<void>> done;
+		for (mint i = 0; i < tasks; ++i) {
+			done.push_back(Async::spawn(pool, hop(pool, std::this_thread::get_id(), onWorker)));
+		}
+		Async::whenAll(std::move(done)).get();
+	}
+	mngr.set(onWorker.load());
+}
+
+/// CoroutineErrors[threads] returns {exception caught inside of a coroutine, exception rethrown from Future::get}
+LLU_LIBRARY_FUNCTION(CoroutineErrors) {
+	auto threads = mngr.getInteger<mint>(0);
+	LLU::ThreadPool pool {static_cast<unsigned>(threads)};
+	mint rethrown = 0;
+	try {
+		Async::spawn(pool, fail(pool)).get();
+	} catch (const std::runtime_error&) {
+		rethrown = 1;
+	}
+	mngr.set(LLU::Tensor<mint> {Async::spawn(pool, recover(pool)).get(), rethrown});
+}
+
+/// CoroutineAwaitFutures[n, threads] sums i^2 for i from 1 to n, every square is computed by an Async::spawn'ed function and awaited
+LLU_LIBRARY_FUNCTION(CoroutineAwaitFutures) {
+	auto [n, threads] = mngr.getTuple<mint, mint>();
+	LLU::ThreadPool pool {static_cast<unsigned>(threads)};
+	mngr.set(Async::spawn(pool, awaitFutures(pool, n)).get());
+}
@@ -2,10 +2,33 @@
  * @file
  * @brief
  */
+#include <algorithm>
+#include <future>
+#include <iterator>
+#include <new>
 #include <numeric>
 #include <thread>
+#include <utility>
 
+#include <LLU/Async/AbortCheck.h>
+#include <LLU/Async/Algorithms.h>
+#include <LLU/Async/BackgroundTask.h>
+#include <LLU/Async/BoundedQueue.h>
+#include <LLU/Async/Conversion.h>
+#include <LLU/Async/DataListTree.h>
+#include <LLU/Async/Future.h>
+#include <LLU/Async/Numa.h>
+#include <LLU/Async/Pipeline.h>
+#include <LLU/Async/Reduction.h>
+#include <LLU/Async/SharedPool.h>
+#include <LLU/Async/Sort.h>
+#include <LLU/Async/SparseMatrix.h>
+#include <LLU/Async/StatsWSTP.h>
+#include <LLU/Async/TaskGroup.h>
 #include <LLU/Async/ThreadPool.h>
+#include <LLU/Async/Tiling.h>
+#include <LLU/Async/WorkerContext.h>
+#include <LLU/Containers/Scratch.h>
 #include <LLU/ErrorLog/Logger.h>
 #include <LLU/LLU.h>
 #include <LLU/LibraryLinkFunctionMacro.h>
@@ -28,14 +51,19 @@ EXTERN_C DLLEXPORT int WolframLibrary_initialize(WolframLibraryData libData) {
 	return 0;
 }
 
+EXTERN_C DLLEXPORT void WolframLibrary_uninitialize(WolframLibraryData /*libData*/) {
+	LLU::Async::shutdownSharedPool();
+}
+
 template<typename ThreadPool>
-void sleepyThreadsInPool(LLU::MArgumentManager& mngr) {
+void sleepyThreadsInPool(LLU::MArgumentManager& mngr, std::chrono::milliseconds idleBefore = 0ms) {
 	auto numThreads = mngr.getInteger<mint>(0);
 	if (numThreads <= 0) {
 		numThreads = std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 1;
 	}
 	THREADSAFE_LOG("Running on ", numThreads, " threads.")
 	ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	std::this_thread::sleep_for(idleBefore);
 	const auto numJobs = mngr.getInteger<mint>(1);
 	const auto time = mngr.getInteger<mint>(2);
 	std::condition_variable allJobsDone;
@@ -64,6 +92,24 @@ LLU_LIBRARY_FUNCTION(SleepyThreadsBasic) {
 	sleepyThreadsInPool<LLU::BasicPool>(mngr);
 }
 
+LLU_LIBRARY_FUNCTION(SleepyThreadsBounded) {
+	sleepyThreadsInPool<LLU::BoundedBasicPool>(mngr);
+}
+
+LLU_LIBRARY_FUNCTION(SleepyThreadsLockFree) {
+	sleepyThreadsInPool<LLU::LockFreeThreadPool>(mngr);
+}
+
+LLU_LIBRARY_FUNCTION(SleepyThreadsAfterIdle) {
+	// by the time the jobs are submitted all workers have gone to sleep, so each submit must wake one of them up
+	sleepyThreadsInPool<LLU::ThreadPool>(mngr, 200ms);
+}
+
+LLU_LIBRARY_FUNCTION(SleepyThreadsSpinning) {
+	sleepyThreadsInPool<LLU::Async::GenericThreadPool<LLU::Async::ThreadsafeQueue<LLU::Async::FunctionWrapper>,
+													  LLU::Async::ChaseLevQueue<LLU::Async::FunctionWrapper>, LLU::Async::SpinIdle>>(mngr);
+}
+
 LLU_LIBRARY_FUNCTION(SleepyThreadsWithPause) {
 	auto numThreads = mngr.getInteger<mint>(0);
 	if (numThreads <= 0) {
@@ -93,6 +139,233 @@ LLU_LIBRARY_FUNCTION(SleepyThreadsWithPause) {
 	allJobsDone.wait(lg, [&] { return completedJobs == numJobs; });
 }
 
+LLU_LIBRARY_FUNCTION(PriorityOvertake) {
+	// submit n low priority tasks and then n high priority ones to a paused single-threaded pool and check when the last urgent task runs
+	const auto numJobs = mngr.getInteger<mint>(0);
+	LLU::PriorityThreadPool tp {1};
+	tp.pause();
+	std::mutex orderMutex;
+	mint executed = 0;
+	mint lastUrgent = -1;
+	std::vector<std::future<void>> results;
+	for (mint i = 0; i < numJobs; ++i) {
+		results.push_back(tp.submit(LLU::Async::TaskPriority::Low, [&] {
+			std::lock_guard lg {orderMutex};
+			++executed;
+		}));
+	}
+	for (mint i = 0; i < numJobs; ++i) {
+		results.push_back(tp.submit(LLU::Async::TaskPriority::High, [&] {
+			std::lock_guard lg {orderMutex};
+			lastUrgent = executed++;
+		}));
+	}
+	tp.resume();
+	for (auto& r : results) {
+		r.get();
+	}
+	mngr.set(lastUrgent);
+}
+
+template<typename ThreadPool>
+void postSleepyThreadsInPool(LLU::MArgumentManager& mngr) {
+	const auto numThreads = mngr.getInteger<mint>(0);
+	ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	const auto numJobs = mngr.getInteger<mint>(1);
+	const auto time = mngr.getInteger<mint>(2);
+	std::atomic_int completedJobs = 0;
+	LLU::Async::TaskGroup jobs;
+	for (int i = 0; i < numJobs; ++i) {
+		jobs.run(tp, [&] {
+			std::this_thread::sleep_for(std::chrono::milliseconds(time));
+			++completedJobs;
+		});
+	}
+	jobs.wait();
+	mngr.setInteger(completedJobs);
+}
+
+LLU_LIBRARY_FUNCTION(PostSleepyThreads) {
+	postSleepyThreadsInPool<LLU::ThreadPool>(mngr);
+}
+
+LLU_LIBRARY_FUNCTION(PostSleepyThreadsBasic) {
+	postSleepyThreadsInPool<LLU::BasicPool>(mngr);
+}
+
+template<typename ThreadPool>
+void pipelineInPool(LLU::MArgumentManager& mngr) {
+	const auto numThreads = mngr.getInteger<mint>(0);
+	const auto numJobs = mngr.getInteger<mint>(1);
+	ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	std::vector<LLU::Async::Future<mint>> stages;
+	for (mint i = 0; i < numJobs; ++i) {
+		stages.push_back(LLU::Async::spawn(tp, [i] { return i * i; }).then(tp, [](mint sq) { return sq + 1; }));
+	}
+	auto total = LLU::Async::whenAll(std::move(stages)).then(tp, [](const std::vector<mint>& values) {
+		return std::accumulate(values.cbegin(), values.cend(), mint {0});
+	});
+	mngr.set(total.get());
+}
+
+LLU_LIBRARY_FUNCTION(ContinuationPipeline) {
+	pipelineInPool<LLU::ThreadPool>(mngr);
+}
+
+LLU_LIBRARY_FUNCTION(ContinuationPipelineBasic) {
+	// continuations never block, so this works even with a single thread in the basic pool
+	pipelineInPool<LLU::BasicPool>(mngr);
+}
+
+namespace {
+	/// Pool whose post always fails after taking the task, as if the queue could not allocate memory for it
+	struct FailingPool {
+		template<typename F>
+		void post(F&& f) {
+			[[maybe_unused]] auto task = std::forward<F>(f);
+			throw std::bad_alloc {};
+		}
+	};
+}  // namespace
+
+/// ContinuationWhenPostFails[n] chains a continuation x -> x + 1 to a future with value n on a pool that cannot accept tasks
+LLU_LIBRARY_FUNCTION(ContinuationWhenPostFails) {
+	FailingPool pool;
+	LLU::Async::Promise<mint> promise;
+	auto next = promise.getFuture().then(pool, [](mint x) { return x + 1; });
+	promise.setValue(mngr.getInteger<mint>(0));
+	mngr.set(next.get());
+}
+
+template<typename ThreadPool>
+void submitNInPool(LLU::MArgumentManager& mngr) {
+	const auto numThreads = mngr.getInteger<mint>(0);
+	const auto numJobs = mngr.getInteger<mint>(1);
+	ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	auto results = tp.submitN(static_cast<std::size_t>(numJobs), [](std::size_t i) { return static_cast<mint>(i * i); });
+	mint sum = 0;
+	for (auto& r : results) {
+		sum += r.get();
+	}
+	mngr.set(sum);
+}
+
+LLU_LIBRARY_FUNCTION(SubmitNSquares) {
+	submitNInPool<LLU::ThreadPool>(mngr);
+}
+
+LLU_LIBRARY_FUNCTION(SubmitNSquaresLockFree) {
+	// lock-free local queues only accept pushes from their owner, so the batch goes to the pool queue
+	submitNInPool<LLU::LockFreeThreadPool>(mngr);
+}
+
+LLU_WSTP_FUNCTION(PoolStatistics) {
+	LLU::WSStream<LLU::WS::Encoding::UTF8> ms(wsl, "List", 2);
+	int numThreads = 0;
+	int numJobs = 0;
+	ms >> numThreads >> numJobs;
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	auto results = tp.submitN(static_cast<std::size_t>(numJobs), [](std::size_t i) { return i * i; });
+	for (auto& r : results) {
+		r.get();
+	}
+	ms << tp.stats();
+}
+
+LLU_LIBRARY_FUNCTION(SharedPoolSquares) {
+	const auto numThreads = mngr.getInteger<mint>(0);
+	const auto numJobs = mngr.getInteger<mint>(1);
+	auto startedBefore = static_cast<mint>(LLU::Async::sharedPoolStarted());
+	auto accepted = static_cast<mint>(LLU::Async::setSharedPoolThreadCount(static_cast<unsigned>(numThreads)));
+	auto results = LLU::Async::sharedPool().submitN(static_cast<std::size_t>(numJobs), [](std::size_t i) { return static_cast<mint>(i * i); });
+	mint sum = 0;
+	for (auto& r : results) {
+		sum += r.get();
+	}
+	auto rejectedAfterStart = static_cast<mint>(!LLU::Async::setSharedPoolThreadCount(1));
+	mngr.set(LLU::Tensor<mint> {startedBefore, accepted, rejectedAfterStart, static_cast<mint>(LLU::Async::sharedPoolThreadCount()), sum});
+}
+
+template<typename ThreadPool>
+void floodInPool(LLU::MArgumentManager& mngr) {
+	const auto numThreads = mngr.getInteger<mint>(0);
+	const auto numJobs = mngr.getInteger<mint>(1);
+	ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	std::atomic<mint> completedJobs = 0;
+	for (mint i = 0; i < numJobs; ++i) {
+		tp.post([&completedJobs] { ++completedJobs; });
+	}
+	tp.drain();
+	mngr.set(completedJobs.load());
+}
+
+LLU_LIBRARY_FUNCTION(TinyTasksFlood) {
+	floodInPool<LLU::ThreadPool>(mngr);
+}
+
+LLU_LIBRARY_FUNCTION(TinyTasksFloodLockFree) {
+	floodInPool<LLU::LockFreeThreadPool>(mngr);
+}
+
+LLU_LIBRARY_FUNCTION(QuiesceAndDrain) {
+	const auto numThreads = mngr.getInteger<mint>(0);
+	const auto numJobs = mngr.getInteger<mint>(1);
+	const auto sleepTime = mngr.getInteger<mint>(2);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	std::atomic<mint> completedJobs = 0;
+	for (mint i = 0; i < numJobs; ++i) {
+		tp.post([&completedJobs, sleepTime] {
+			std::this_thread::sleep_for(std::chrono::milliseconds(sleepTime));
+			++completedJobs;
+		});
+	}
+	auto stopped = static_cast<mint>(tp.quiesce());
+	auto beforeNap = completedJobs.load();
+	std::this_thread::sleep_for(std::chrono::milliseconds(2 * sleepTime));
+	auto completedWhileQuiescent = completedJobs.load() - beforeNap;
+	tp.resume();
+	tp.drain();
+	mngr.set(LLU::Tensor<mint> {stopped, completedWhileQuiescent, completedJobs.load()});
+}
+
+LLU_LIBRARY_FUNCTION(CancelledParallelFor) {
+	const auto numThreads = mngr.getInteger<mint>(0);
+	const auto numJobs = mngr.getInteger<mint>(1);
+	const auto cancelAt = mngr.getInteger<mint>(2);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	std::atomic<mint> processed = 0;
+	try {
+		LLU::Async::parallelFor(tp, mint {0}, numJobs, 1, [&](mint i) {
+			if (i == cancelAt) {
+				tp.cancel();
+			}
+			std::this_thread::sleep_for(1ms);
+			++processed;
+		});
+	} catch (const LLU::Async::TaskCancelled&) {
+		// expected, the number of processed indices tells how early the loop stopped
+	}
+	mngr.set(processed.load());
+}
+
+LLU_LIBRARY_FUNCTION(AbortableSleepyThreads) {
+	const auto numThreads = mngr.getInteger<mint>(0);
+	const auto numJobs = mngr.getInteger<mint>(1);
+	const auto sleepTime = mngr.getInteger<mint>(2);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	LLU::Async::TaskGroup jobs;
+	for (mint i = 0; i < numJobs; ++i) {
+		jobs.run(tp, [token = tp.cancellationToken(), sleepTime] {
+			for (mint slept = 0; slept < sleepTime; slept += 10) {
+				token.throwIfCancelled();
+				std::this_thread::sleep_for(10ms);
+			}
+		});
+	}
+	LLU::Async::waitWithAbortCheck(tp, jobs);
+	mngr.set(numJobs);
+}
+
 template<typename ThreadPool>
 void accumulateInPool(LLU::MArgumentManager& mngr) {
 	auto data = mngr.getGenericNumericArray<LLU::Passing::Constant>(0);
@@ -125,6 +398,10 @@ LLU_LIBRARY_FUNCTION(AccumulateBasic) {
 	accumulateInPool<LLU::BasicPool>(mngr);
 }
 
+LLU_LIBRARY_FUNCTION(AccumulateBounded) {
+	accumulateInPool<LLU::BoundedBasicPool>(mngr);
+}
+
 LLU_LIBRARY_FUNCTION(AccumulateSequential) {
 	auto data = mngr.getGenericNumericArray<LLU::Passing::Constant>(0);
 	LLU::asTypedNumericArray(data, [&](auto&& typedNA) {
@@ -134,6 +411,375 @@ LLU_LIBRARY_FUNCTION(AccumulateSequential) {
 	});
 }
 
+LLU_LIBRARY_FUNCTION(AccumulateReduce) {
+	auto data = mngr.getGenericNumericArray<LLU::Passing::Constant>(0);
+	const auto numThreads = mngr.getInteger<mint>(1);
+	const auto jobSize = mngr.getInteger<mint>(2);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	LLU::asTypedNumericArray(data, [&](auto&& typedNA) {
+		using T = typename std::remove_reference_t<decltype(typedNA)>::value_type;
+		T totalSum = LLU::Async::parallelReduce(tp, typedNA, jobSize, T {}, [](T a, T b) { return a + b; });
+		mngr.set(NumericArray<T> {totalSum});
+	});
+}
+
+LLU_LIBRARY_FUNCTION(ParallelForSquare) {
+	auto data = mngr.getTensor<double, LLU::Passing::Constant>(0);
+	const auto numThreads = mngr.getInteger<mint>(1);
+	const auto jobSize = mngr.getInteger<mint>(2);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	LLU::Tensor<double> result {0.0, data.dimensions()};
+	LLU::Async::parallelFor(tp, mint {0}, data.size(), jobSize, [&](mint i) { result[i] = data[i] * data[i]; });
+	mngr.set(result);
+}
+
+LLU_LIBRARY_FUNCTION(ParallelConvertToByte) {
+	auto data = mngr.getGenericNumericArray<LLU::Passing::Constant>(0);
+	const auto method = mngr.getInteger<LLU::NA::ConversionMethod>(1);
+	const auto numThreads = mngr.getInteger<mint>(2);
+	const auto jobSize = mngr.getInteger<mint>(3);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	mngr.set(LLU::Async::convertNumericArray<std::uint8_t>(tp, data, method, 0.0, jobSize));
+}
+
+LLU_LIBRARY_FUNCTION(ParallelSwitchInterleaving) {
+	const auto numThreads = mngr.getInteger<mint>(1);
+	const auto jobSize = mngr.getInteger<mint>(2);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	mngr.operateOnImage<LLU::Passing::Constant>(0, [&](auto&& in) {
+		using T = typename std::remove_reference_t<decltype(in)>::value_type;
+		LLU::Image<T> out(in.is3D() ? in.slices() : 0, in.columns(), in.rows(), in.channels(), in.colorspace(), !in.interleavedQ());
+		if (in.interleavedQ()) {
+			LLU::Async::deinterleave(tp, in, out, jobSize);
+		} else {
+			LLU::Async::interleave(tp, in, out, jobSize);
+		}
+		mngr.set(out);
+	});
+}
+
+// sum of 3x3 neighborhood of every pixel of a single-channel Real image, with zero padding, computed tile by tile
+LLU_LIBRARY_FUNCTION(TiledBoxSum) {
+	auto img = mngr.getImage<double, LLU::Passing::Constant>(0);
+	const auto numThreads = mngr.getInteger<mint>(1);
+	const auto tileSize = mngr.getInteger<mint>(2);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	LLU::Image<double> out(img.columns(), img.rows(), 1, img.colorspace(), img.interleavedQ());
+	auto in = LLU::pixels(std::as_const(img));
+	auto dest = LLU::pixels(out);
+	LLU::TileGrid grid {in.layout(), tileSize, tileSize, 1};
+	LLU::Async::forEachTile(tp, grid, [&](const LLU::ImageTile& t) {
+		for (mint r = t.row; r < t.row + t.rows; ++r) {
+			for (mint c = t.column; c < t.column + t.columns; ++c) {
+				double sum = 0;
+				for (mint hr = std::max(r - 1, t.haloRow); hr <= std::min(r + 1, t.haloRow + t.haloRows - 1); ++hr) {
+					for (mint hc = std::max(c - 1, t.haloColumn); hc <= std::min(c + 1, t.haloColumn + t.haloColumns - 1); ++hc) {
+						sum += in(hr, hc, 0);
+					}
+				}
+				dest(r, c, 0) = sum;
+			}
+		}
+	});
+	mngr.set(out);
+}
+
+// mean value of every frame of a Real 3D image, frames are processed in parallel
+LLU_LIBRARY_FUNCTION(FrameMeans) {
+	auto img = mngr.getImage<double, LLU::Passing::Constant>(0);
+	const auto numThreads = mngr.getInteger<mint>(1);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	auto in = LLU::pixels(std::as_const(img));
+	LLU::Tensor<double> means(0.0, {in.layout().slices});
+	LLU::Async::forEachFrame(tp, in, [&means](auto frame, mint slice) {
+		double sum = 0;
+		frame.forEachPixel([&sum](auto channels) { sum += std::accumulate(channels.begin(), channels.end(), 0.0); });
+		const auto& l = frame.layout();
+		means[slice] = sum / static_cast<double>(l.rows * l.columns * l.channels);
+	});
+	mngr.set(means);
+}
+
+// copy of a nested DataList with every Integer and Real value doubled, leaves are transformed in parallel
+LLU_LIBRARY_FUNCTION(DoubleTreeNumbers) {
+	auto ds = mngr.getGenericDataList(0);
+	const auto numThreads = mngr.getInteger<mint>(1);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	LLU::Async::DataListTree tree {ds};
+	auto out = LLU::Async::transformLeaves(tp, tree, 64, [](const LLU::Async::TreeNode& n) -> LLU::Argument::TypedArgument {
+		switch (n.node.type()) {
+			case LLU::MArgumentType::Integer: return 2 * n.node.valueAs<LLU::MArgumentType::Integer>();
+			case LLU::MArgumentType::Real: return 2 * n.node.valueAs<LLU::MArgumentType::Real>();
+			default: return n.node.value();
+		}
+	});
+	mngr.set(out);
+}
+
+LLU_LIBRARY_FUNCTION(ParallelFill) {
+	const auto n = mngr.getInteger<mint>(0);
+	const auto value = mngr.getReal(1);
+	const auto numThreads = mngr.getInteger<mint>(2);
+	const auto jobSize = mngr.getInteger<mint>(3);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	LLU::Tensor<double> t(LLU::Uninitialized, {n});
+	LLU::Async::fill(tp, t, value, jobSize);
+	mngr.set(t);
+}
+
+LLU_LIBRARY_FUNCTION(NumaFillAndShift) {
+	const auto n = mngr.getInteger<mint>(0);
+	const auto value = mngr.getReal(1);
+	const auto threadsPerNode = mngr.getInteger<mint>(2);
+	const auto jobSize = mngr.getInteger<mint>(3);
+	LLU::Async::NumaPools<> pools {static_cast<unsigned int>(threadsPerNode)};
+	LLU::Tensor<double> t(LLU::Uninitialized, {n});
+	LLU::Async::fill(pools, t, value, jobSize);
+	auto* data = t.data();
+	LLU::Async::parallelFor(pools, mint {0}, n, jobSize, [data](mint i) { data[i] += static_cast<double>(i); });
+	mngr.set(t);
+}
+
+LLU_LIBRARY_FUNCTION(UnpinnedNumaFill) {
+	const auto n = mngr.getInteger<mint>(0);
+	const auto value = mngr.getReal(1);
+	const auto numThreads = mngr.getInteger<mint>(2);
+	const auto jobSize = mngr.getInteger<mint>(3);
+	LLU::Async::NumaPools<> pools {{}, static_cast<unsigned int>(numThreads)};
+	LLU::Tensor<double> t(LLU::Uninitialized, {n});
+	LLU::Async::fill(pools, t, value, jobSize);
+	mngr.set(t);
+}
+
+LLU_LIBRARY_FUNCTION(ReproducibleDot) {
+	const auto a = mngr.getTensor<double, LLU::Passing::Constant>(0);
+	const auto b = mngr.getTensor<double, LLU::Passing::Constant>(1);
+	const auto method = mngr.getBoolean(2) ? LLU::Async::Summation::Kahan : LLU::Async::Summation::Pairwise;
+	const auto numThreads = mngr.getInteger<mint>(3);
+	const auto jobSize = mngr.getInteger<mint>(4);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	mngr.setReal(LLU::Async::reproducibleDot(tp, a, b, method, jobSize));
+}
+
+LLU_LIBRARY_FUNCTION(ParallelSortIntegers) {
+	auto data = mngr.getTensor<mint>(0);
+	const auto numThreads = mngr.getInteger<mint>(1);
+	const auto jobSize = mngr.getInteger<mint>(2);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	LLU::Async::parallelSort(tp, data, jobSize);
+	mngr.set(data);
+}
+
+LLU_LIBRARY_FUNCTION(ParallelSortReals) {
+	auto data = mngr.getTensor<double>(0);
+	const auto descending = mngr.getBoolean(1);
+	const auto numThreads = mngr.getInteger<mint>(2);
+	const auto jobSize = mngr.getInteger<mint>(3);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	if (descending) {
+		LLU::Async::parallelSort(tp, data, jobSize, std::greater<> {});
+	} else {
+		LLU::Async::parallelSort(tp, data, jobSize);
+	}
+	mngr.set(data);
+}
+
+LLU_LIBRARY_FUNCTION(ParallelScan) {
+	const auto data = mngr.getTensor<mint, LLU::Passing::Constant>(0);
+	const auto inclusive = mngr.getBoolean(1);
+	const auto numThreads = mngr.getInteger<mint>(2);
+	const auto jobSize = mngr.getInteger<mint>(3);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	LLU::Tensor<mint> result(LLU::Uninitialized, data.dimensions());
+	if (inclusive) {
+		LLU::Async::inclusiveScan(tp, data, result, jobSize);
+	} else {
+		LLU::Async::exclusiveScan(tp, data, result, jobSize, mint {0});
+	}
+	mngr.set(result);
+}
+
+LLU_LIBRARY_FUNCTION(ParallelPartitionEven) {
+	auto data = mngr.getTensor<mint>(0);
+	const auto numThreads = mngr.getInteger<mint>(1);
+	const auto jobSize = mngr.getInteger<mint>(2);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	const auto evens = LLU::Async::stablePartition(tp, data, jobSize, [](mint x) { return x % 2 == 0; });
+	LLU::Tensor<mint> result(LLU::Uninitialized, {data.size() + 1});
+	result[0] = evens;
+	std::copy(data.begin(), data.end(), std::next(result.begin()));
+	mngr.set(result);
+}
+
+/// NestedPoolSum[n, threads] sums Range[n] with parallelFor on one pool, called from the tasks of another pool of the same type, and drains both
+LLU_LIBRARY_FUNCTION(NestedPoolSum) {
+	auto [n, threads] = mngr.getTuple<mint, mint>();
+	std::atomic<mint> sum = 0;
+	LLU::ThreadPool outer {static_cast<unsigned int>(threads)};
+	LLU::ThreadPool inner {static_cast<unsigned int>(threads)};
+	for (mint t = 0; t < threads; ++t) {
+		outer.post([&] {
+			LLU::Async::parallelFor(inner, mint {1}, n + 1, 16, [&sum](mint i) { sum.fetch_add(i, std::memory_order_relaxed); });
+		});
+	}
+	outer.drain();
+	inner.drain();
+	mngr.set(sum.load() / threads);
+}
+
+/// RejectingPoolDrain[k] blocks the only worker of a pool whose queue holds 4 tasks and rejects the rest, submits k tasks one by one and k more
+/// in a batch, then unblocks the worker and drains the pool. Returns {tasks run, futures that reported broken_promise}.
+LLU_LIBRARY_FUNCTION(RejectingPoolDrain) {
+	using RejectingQueue = LLU::Async::BoundedQueue<LLU::Async::FunctionWrapper, 4, LLU::Async::FullQueuePolicy::Reject>;
+	// ChaseLevQueue has no bulk push, so the batch goes to the pool queue too
+	using RejectingPool = LLU::Async::GenericThreadPool<RejectingQueue, LLU::Async::ChaseLevQueue<LLU::Async::FunctionWrapper>>;
+	const auto k = mngr.getInteger<mint>(0);
+	RejectingPool tp {1};
+	std::promise<void> release;
+	std::promise<void> started;
+	tp.post([&started, blocker = release.get_future()] {
+		started.set_value();
+		blocker.wait();
+	});
+	started.get_future().wait();
+	std::atomic<mint> ran = 0;
+	std::vector<std::future<void>> futures;
+	for (mint i = 0; i < k; ++i) {
+		futures.push_back(tp.submit([&ran] { ++ran; }));
+	}
+	auto batch = tp.submitN(static_cast<std::size_t>(k), [&ran](std::size_t) { ++ran; });
+	std::move(batch.begin(), batch.end(), std::back_inserter(futures));
+	release.set_value();
+	tp.drain();
+	mint broken = 0;
+	for (auto& f : futures) {
+		try {
+			f.get();
+		} catch (const std::future_error& e) {
+			broken += (e.code() == std::future_errc::broken_promise) ? 1 : 0;
+		}
+	}
+	mngr.set(LLU::Tensor<mint> {ran.load(), broken});
+}
+
+LLU_LIBRARY_FUNCTION(StartCountdown) {
+	const auto steps = mngr.getInteger<mint>(0);
+	const auto maxPending = mngr.getInteger<mint>(1);
+	auto id = LLU::Async::BackgroundTask::start(
+		LLU::Async::sharedPool(),
+		[steps](LLU::Async::BackgroundTask& task) {
+			for (mint i = 1; i <= steps; ++i) {
+				LLU::GenericDataList progress;
+				progress.push_back("Step", i);
+				task.emit("Progress", std::move(progress));
+			}
+			LLU::GenericDataList result;
+			result.push_back("Steps", steps);
+			return result;
+		},
+		maxPending);
+	mngr.setInteger(id);
+}
+
+LLU_LIBRARY_FUNCTION(AcknowledgeTaskEvent) {
+	mngr.setBoolean(LLU::Async::BackgroundTask::acknowledge(mngr.getInteger<mint>(0)));
+}
+
+LLU_LIBRARY_FUNCTION(CancelBackgroundTask) {
+	mngr.setBoolean(LLU::Async::BackgroundTask::cancel(mngr.getInteger<mint>(0)));
+}
+
+LLU_LIBRARY_FUNCTION(ParallelSparseDot) {
+	const auto sp = mngr.getSparseArray<double, LLU::Passing::Constant>(0);
+	const auto dense = mngr.getTensor<double, LLU::Passing::Constant>(1);
+	const auto numThreads = mngr.getInteger<mint>(2);
+	const auto jobSize = mngr.getInteger<mint>(3);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	mngr.set(LLU::Async::dot(tp, LLU::SparseMatrixView<double> {sp}, dense, jobSize));
+}
+
+LLU_LIBRARY_FUNCTION(ParallelSparseAssembly) {
+	const auto n = mngr.getInteger<mint>(0);
+	const auto numThreads = mngr.getInteger<mint>(1);
+	const auto jobSize = mngr.getInteger<mint>(2);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	LLU::SparseArrayBuilder<double> builder {n + 1, n + 1};
+	// stiffness matrix of n linear 1D elements, each element contributes to four entries shared with its neighbors
+	LLU::Async::parallelFor(tp, mint {0}, numThreads, 1, [&](mint t) {
+		auto& buffer = builder.newBuffer();
+		for (mint e = t; e < n; e += numThreads) {
+			buffer.add(e, e, 1.0);
+			buffer.add(e, e + 1, -1.0);
+			buffer.add(e + 1, e, -1.0);
+			buffer.add(e + 1, e + 1, 1.0);
+		}
+	});
+	mngr.set(LLU::Async::compress(tp, builder, jobSize).toSparseArray());
+}
+
+LLU_LIBRARY_FUNCTION(ParallelSparseToDense) {
+	const auto sp = mngr.getSparseArray<double, LLU::Passing::Constant>(0);
+	const auto numThreads = mngr.getInteger<mint>(1);
+	const auto jobSize = mngr.getInteger<mint>(2);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	mngr.set(LLU::Async::toTensor(tp, sp, jobSize));
+}
+
+LLU_LIBRARY_FUNCTION(ParallelDenseToSparse) {
+	const auto dense = mngr.getTensor<double, LLU::Passing::Constant>(0);
+	const auto implicitValue = mngr.getReal(1);
+	const auto numThreads = mngr.getInteger<mint>(2);
+	const auto jobSize = mngr.getInteger<mint>(3);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	mngr.set(LLU::Async::toSparseArray(tp, dense, implicitValue, jobSize));
+}
+
+LLU_LIBRARY_FUNCTION(PipelineSquares) {
+	const auto input = mngr.getTensor<mint, LLU::Passing::Constant>(0);
+	const auto numThreads = mngr.getInteger<mint>(1);
+	const auto parallelism = mngr.getInteger<mint>(2);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	LLU::Tensor<mint> result(LLU::Uninitialized, input.dimensions());
+	mint next = 0;
+	mint written = 0;
+	LLU::Async::runPipeline<16>(
+		tp, tp.cancellationToken(),
+		[&input, &next]() -> std::optional<mint> {
+			if (next == input.size()) {
+				return std::nullopt;
+			}
+			return input[next++];
+		},
+		LLU::Async::stage([](mint x) { return x * x; }, static_cast<unsigned int>(parallelism)),
+		LLU::Async::orderedStage([&result, &written](mint x) { result[written++] = x; }));
+	mngr.set(result);
+}
+
+LLU_LIBRARY_FUNCTION(ScratchRowSums) {
+	const auto m = mngr.getTensor<double, LLU::Passing::Constant>(0);
+	const auto numThreads = mngr.getInteger<mint>(1);
+	const auto rows = m.dimension(0);
+	const auto cols = m.dimension(1);
+	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	std::vector<std::future<double>> sums;
+	for (mint i = 0; i < rows; ++i) {
+		sums.push_back(tp.submit([&m, i, cols] {
+			auto worker = LLU::Async::thisWorker();
+			if (!worker.inTask() || worker.scratch().bytesUsed() != 0) {
+				// scratch memory of previous tasks was not reclaimed
+				LLU::ErrorManager::throwException(LLU::ErrorName::FunctionError);
+			}
+			std::pmr::vector<double> row {&worker.memoryResource()};
+			row.reserve(static_cast<std::size_t>(cols));
+			std::copy(m.begin() + i * cols, m.begin() + (i + 1) * cols, std::back_inserter(row));
+			return std::accumulate(row.begin(), row.end(), 0.0);
+		}));
+	}
+	LLU::Tensor<double> result(LLU::Uninitialized, {rows});
+	std::transform(sums.begin(), sums.end(), result.begin(), [](auto& f) { return f.get(); });
+	mngr.set(result);
+}
+
 template<typename InputIter>
 std::uint64_t rangeLcm(InputIter first, InputIter last) {
 	std::uint64_t lcm = 1;
@@ -149,8 +795,8 @@ LLU_LIBRARY_FUNCTION(LcmSequential) {
 	mngr.set(NumericArray<std::uint64_t> {lcm});
 }
 
-template<typename InputIter>
-std::uint64_t rangeLcm([[maybe_unused]] LLU::ThreadPool& tp, mint threshold, InputIter first, InputIter last) {
+template<typename ThreadPool, typename InputIter>
+std::uint64_t rangeLcm([[maybe_unused]] ThreadPool& tp, mint threshold, InputIter first, InputIter last) {
 	auto dist = std::distance(first, last);
 	if (dist < threshold) {
 		return rangeLcm(first, last);
@@ -164,11 +810,32 @@ std::uint64_t rangeLcm([[maybe_unused]] LLU::ThreadPool& tp, mint threshold, Inp
 	return std::lcm(lcmLower.get(), lcmUpper);
 }
 
-LLU_LIBRARY_FUNCTION(LcmParallel) {
+template<typename ThreadPool, typename... PoolArgs>
+void lcmInPool(LLU::MArgumentManager& mngr, PoolArgs&&... poolArgs) {
 	auto data = mngr.getNumericArray<std::uint64_t, LLU::Passing::Constant>(0);
 	const auto numThreads = mngr.getInteger<mint>(1);
 	const auto jobSize = mngr.getInteger<mint>(2);
-	LLU::ThreadPool tp {static_cast<unsigned int>(numThreads)};
+	ThreadPool tp {static_cast<unsigned int>(numThreads), std::forward<PoolArgs>(poolArgs)...};
 	auto lcm = rangeLcm(tp, jobSize, std::begin(data), std::end(data));
 	mngr.set(NumericArray<std::uint64_t> {lcm});
-}
\ No newline at end of file
+}
+
+LLU_LIBRARY_FUNCTION(LcmParallel) {
+	lcmInPool<LLU::ThreadPool>(mngr);
+}
+
+LLU_LIBRARY_FUNCTION(LcmParallelLockFree) {
+	lcmInPool<LLU::LockFreeThreadPool>(mngr);
+}
+
+template<typename StealPolicy>
+using StealingPool = LLU::Async::GenericThreadPool<LLU::Async::ThreadsafeQueue<LLU::Async::FunctionWrapper>,
+												   LLU::Async::ChaseLevQueue<LLU::Async::FunctionWrapper>, LLU::Async::AdaptiveIdle<>, StealPolicy>;
+
+LLU_LIBRARY_FUNCTION(LcmParallelStealHalf) {
+	lcmInPool<StealingPool<LLU::Async::StealHalf<>>>(mngr);
+}
+
+LLU_LIBRARY_FUNCTION(LcmParallelPinned) {
+	lcmInPool<StealingPool<LLU::Async::CacheAwareSteal>>(mngr, LLU::Async::Topology::compactCpuOrder());
+}
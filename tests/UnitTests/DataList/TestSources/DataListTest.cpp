@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include <list>
+#include <numeric>
 #include <string>
 
 #include "wstp.h"
@@ -451,4 +452,81 @@ LLU_LIBRARY_FUNCTION(FromInitList) {
 	res.push_back(DataList<LLU::NodeType::UTF8String> {{"a","x"},{"b","y"}});
 
 	mngr.set(res);
-}
\ No newline at end of file
+}
+LLU_LIBRARY_FUNCTION(AppendNodes) {
+	auto n = mngr.getInteger<mint>(0);
+	std::vector<mint> ints(static_cast<std::size_t>(n));
+	std::iota(ints.begin(), ints.end(), 1);
+	std::vector<std::string> names;
+	std::transform(ints.cbegin(), ints.cend(), std::back_inserter(names), [](mint i) { return "k" + std::to_string(i); });
+
+	DataList<LLU::NodeType::Integer> values;
+	values.append(ints.cbegin(), ints.cend());
+	DataList<LLU::NodeType::Real> namedValues;
+	namedValues.append(names.cbegin(), names.cend(), ints.cbegin());
+	DataList<LLU::NodeType::UTF8String> keys;
+	keys.append(names.cbegin(), names.cend());
+
+	DataList<GenericDataList> dsOut;
+	dsOut.push_back("Values", std::move(values));
+	dsOut.push_back("Named", std::move(namedValues));
+	dsOut.push_back("Keys", std::move(keys));
+	mngr.set(dsOut);
+}
+
+LLU_LIBRARY_FUNCTION(LookupByName) {
+	auto dsIn = mngr.getDataList<LLU::NodeType::Integer>(0);
+	auto keys = mngr.getDataList<LLU::NodeType::UTF8String>(1);
+	LLU::Tensor<mint> values(0, {keys.length()});
+	std::transform(keys.valueBegin(), keys.valueEnd(), values.begin(), [&dsIn](std::string_view key) { return dsIn[key]; });
+	mngr.set(values);
+}
+
+LLU_LIBRARY_FUNCTION(NameAt) {
+	auto dsIn = mngr.getDataList<LLU::NodeType::Any>(0);
+	auto index = mngr.getInteger<mint>(1);
+	mngr.set(std::string {dsIn.at(index).name()});
+}
+
+LLU_LIBRARY_FUNCTION(CountNamesEqualToValues) {
+	auto dsIn = mngr.getDataList<LLU::NodeType::UTF8String>(0);
+	mint equal = 0;
+	auto value = dsIn.valueViews().begin();
+	for (std::string_view name : dsIn.nameViews()) {
+		equal += (name == *value++) ? 1 : 0;
+	}
+	mint characters = 0;
+	for (std::string_view v : dsIn.valueViews()) {
+		characters += static_cast<mint>(v.size());
+	}
+	mngr.set(LLU::Tensor<mint> {equal, characters});
+}
+
+LLU_LIBRARY_FUNCTION(HomogeneousSum) {
+	auto dsIn = mngr.getDataList<LLU::NodeType::Any>(0);
+	if (auto reals = dsIn.tryPackHomogeneous<double>()) {
+		mngr.set(LLU::Tensor<double> {1., std::accumulate(reals->cbegin(), reals->cend(), 0.)});
+	} else if (auto ints = dsIn.tryAsHomogeneous<mint>()) {
+		mngr.set(LLU::Tensor<double> {2., static_cast<double>(std::accumulate(ints->begin(), ints->end(), mint {0}))});
+	} else {
+		mngr.set(LLU::Tensor<double> {0., 0.});
+	}
+}
+
+/// Sum a list of integers, with validation of node types only when the list is not passed as trusted
+LLU_LIBRARY_FUNCTION(IntegerListSum) {
+	auto gds = mngr.getGenericDataList(0);
+	auto list = mngr.getBoolean(1) ? DataList<LLU::NodeType::Integer>::fromTrusted(std::move(gds)) : DataList<LLU::NodeType::Integer> {std::move(gds)};
+	mngr.set(std::accumulate(list.valueBegin(), list.valueEnd(), mint {0}));
+}
+
+LLU_LIBRARY_FUNCTION(RecordBatchLabels) {
+	LLU::RecordBatch batch {mngr.getGenericDataList(0)};
+	std::vector<std::string> labels;
+	labels.reserve(static_cast<std::size_t>(batch.rows()));
+	for (auto row : batch) {
+		labels.push_back(std::string {row.get<std::string_view>("name")} + std::to_string(row.get<mint>("id")));
+	}
+	batch.addColumn("label", LLU::StringColumn {labels.cbegin(), labels.cend()});
+	mngr.set(batch.toDataList());
+}
@@ -25,10 +25,13 @@ class MyTestExpression {};
 
 DEFINE_MANAGED_STORE_AND_SPECIALIZATION(MyTestExpression)
 
+/// Ids of paclet errors, in the order of registration
+std::vector<ErrorManager::ErrorId> pacletErrorIds;
+
 EXTERN_C DLLEXPORT int WolframLibrary_initialize(WolframLibraryData libData) {
 	LLU::LibraryData::setLibraryData(libData);
 	MyTestExpressionStore.registerType("MyTestExpression");
-	ErrorManager::registerPacletErrors({{"DataFileError", "Data in file `fname` in line `lineNumber` is invalid because `reason`."},
+	pacletErrorIds = ErrorManager::registerPacletErrors({{"DataFileError", "Data in file `fname` in line `lineNumber` is invalid because `reason`."},
 										{"RepeatedTemplateError", "Cannot accept `x` nor `y` because `x` is unacceptable. So are `y` and `z`."},
 										{"NumberedSlotsError", "First slot is `1` and second is `2`."},
 										{"RepeatedNumberTemplateError", "Cannot accept `` nor `` because `1` is unacceptable. So are `2` and ``."},
@@ -254,3 +257,54 @@ LLU_WSTP_FUNCTION(GetMLEErrorWSTP) {
 	LLU::Unused(wsl);
 	LLU::ErrorManager::throwException("SimpleError");
 }
+
+LLU_LIBRARY_FUNCTION(ValidateElements) {
+	static const auto dataFileError = ErrorManager::getErrorId("DataFileError");
+	auto count = mngr.getInteger<mint>(0);
+	mint invalid = 0;
+	for (mint i = 0; i < count; ++i) {
+		try {
+			if (i % 2 == 1) {
+				ErrorManager::throwException(dataFileError, "element", i, "it is odd");
+			}
+		} catch (const LibraryLinkError&) {
+			++invalid;
+		}
+	}
+	ErrorManager::throwException(dataFileError, "summary", invalid, "some elements are invalid");
+}
+
+LLU_LIBRARY_FUNCTION(CollectElementErrors) {
+	static const auto dataFileError = ErrorManager::getErrorId("DataFileError");
+	auto count = mngr.getInteger<mint>(0);
+	LLU::ErrorCollector errors;
+	for (mint i = 1; i <= count; ++i) {
+		if (i % 2 == 0) {
+			errors.add(dataFileError, i, "element", i, "it is even");
+		}
+	}
+	mngr.set(errors.toTensor());
+}
+
+LLU_LIBRARY_FUNCTION(CollectElementFailures) {
+	auto count = mngr.getInteger<mint>(0);
+	LLU::ErrorCollector errors {2};
+	mint valid = 0;
+	for (mint i = 1; i <= count; ++i) {
+		try {
+			if (i % 2 == 0) {
+				ErrorManager::throwException("DataFileError", "element", i, "it is even");
+			}
+			++valid;
+		} catch (const LibraryLinkError& e) {
+			errors.add(e, i);
+		}
+	}
+	errors.sendFailures();
+	mngr.set(valid + static_cast<mint>(errors.droppedCount()) * 1000);
+}
+
+LLU_LIBRARY_FUNCTION(ThrowRegisteredError) {
+	auto index = mngr.getInteger<mint>(0);
+	ErrorManager::throwException(pacletErrorIds.at(static_cast<std::size_t>(index)), "registered", index, "it was thrown by id");
+}
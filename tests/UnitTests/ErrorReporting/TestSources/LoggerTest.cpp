@@ -2,7 +2,9 @@
  * @file	LoggerTest.cpp
  * @brief 	Unit tests for Logger
  */
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <random>
 #include <sstream>
 #include <thread>
@@ -107,4 +109,40 @@ LIBRARY_LINK_FUNCTION(LogsFromThreads) {
 		err = LLErrorCode::FunctionError;
 	}
 	return err;
-}
\ No newline at end of file
+}
+LLU_LIBRARY_FUNCTION(LogsFromWorkers) {
+	auto threadCount = mngr.getInteger<mint>(0);
+	auto logsPerThread = mngr.getInteger<mint>(1);
+	std::vector<std::thread> threads;
+	for (mint i = 0; i < threadCount; ++i) {
+		threads.emplace_back([i, logsPerThread] {
+			for (mint j = 0; j < logsPerThread; ++j) {
+				LLU_DEBUG("Worker ", i, " log ", j);
+			}
+		});
+	}
+	for (auto& t : threads) {
+		t.join();
+	}
+	LLU_DEBUG("All workers joined.");
+}
+
+namespace {
+	std::atomic<std::int64_t> fakeSecond {0};
+
+	std::int64_t fakeClock() noexcept {
+		return fakeSecond.load();
+	}
+}  // namespace
+
+/// SampledLogs[count, second] logs count times through sampled and rate limited macros, with the rate limiter clock showing given second
+LLU_LIBRARY_FUNCTION(SampledLogs) {
+	auto [count, second] = mngr.getTuple<mint, mint>();
+	fakeSecond = second;
+	LLU::Logger::setRateLimiterClock(&fakeClock);
+	for (mint i = 0; i < count; ++i) {
+		LLU_DEBUG_EVERY_N(10, "Sample ", i);
+		LLU_WARNING_RATE_LIMITED(5, "Limited ", i);
+	}
+	LLU_DEBUG("Done.");
+}
@@ -3,6 +3,10 @@
  * @brief	Unit tests for passing policies and related functionality
  */
 
+#include <cstddef>
+#include <fstream>
+#include <numeric>
+
 #include <LLU/ErrorLog/Logger.h>
 #include <LLU/LLU.h>
 #include <LLU/LibraryLinkFunctionMacro.h>
@@ -127,4 +131,61 @@ LIBRARY_LINK_FUNCTION(MoveShared) {
 	LLU_DEBUG("Shared arg owner: ", to_string(na.getOwner()), ", clone owner: ", to_string(clone.getOwner()));
 	// NOLINTNEXTLINE(bugprone-use-after-move): deliberate use after move for testing purposes
 	return (isShared(na) && isShared(clone)) ? ErrorCode::NoError : ErrorCode::MemoryError;
-}
\ No newline at end of file
+}
+
+LLU_LIBRARY_FUNCTION(SerializeRoundTrip) {
+	auto path = mngr.getString(0);
+	LLU::Serialization::serialize(path, mngr.getGenericDataList(1));
+	mngr.set(std::get<LLU::GenericDataList>(LLU::Serialization::deserialize(path)));
+}
+
+LLU_LIBRARY_FUNCTION(SerializedTensorTotal) {
+	auto path = mngr.getString(0);
+	LLU::Serialization::serialize(path, mngr.getGenericTensor(1));
+	LLU::Serialization::SerializedFile file {path};
+	auto view = file.root().view<double>();
+	mngr.set(std::accumulate(view.begin(), view.end(), 0.0));
+}
+
+LLU_LIBRARY_FUNCTION(SerializeCompressed) {
+	auto path = mngr.getString(0);
+	LLU::Serialization::SerializeOptions opts;
+	opts.compress = true;
+	opts.compression.codec = static_cast<std::uint32_t>(mngr.getInteger<mint>(2));
+	LLU::Serialization::serialize(path, mngr.getGenericDataList(1), opts);
+	mngr.set(std::get<LLU::GenericDataList>(LLU::Serialization::deserialize(path)));
+}
+
+/// Serialize a compressed Tensor with given compression.elementSize and get the size of the file
+LLU_LIBRARY_FUNCTION(CompressedFileSize) {
+	auto path = mngr.getString(0);
+	LLU::Serialization::SerializeOptions opts;
+	opts.compress = true;
+	opts.compression.elementSize = static_cast<std::size_t>(mngr.getInteger<mint>(2));
+	LLU::Serialization::serialize(path, mngr.getGenericTensor(1), opts);
+	std::ifstream file {path, std::ios::binary | std::ios::ate};
+	mngr.set(static_cast<mint>(file.tellg()));
+}
+
+/// Serialize a DataList, overwrite the first dimension or the number of explicit values of its first node with given number and deserialize it
+LLU_LIBRARY_FUNCTION(LoadTampered) {
+	auto path = mngr.getString(0);
+	LLU::Serialization::serialize(path, mngr.getGenericDataList(1));
+	const auto field = mngr.getString(2);
+	const std::int64_t newValue = mngr.getInteger<mint>(3);
+	{
+		std::fstream file {path, std::ios::binary | std::ios::in | std::ios::out};
+		LLU::Serialization::NodeHeader root {};
+		file.seekg(sizeof(LLU::Serialization::FileHeader));
+		file.read(reinterpret_cast<char*>(&root), sizeof(root));	// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		const auto child = sizeof(LLU::Serialization::FileHeader) + root.payloadOffset;
+		const auto at = (field == "Dimension") ? sizeof(LLU::Serialization::NodeHeader) : offsetof(LLU::Serialization::NodeHeader, extra);
+		file.seekp(static_cast<std::streamoff>(child + at));
+		file.write(reinterpret_cast<const char*>(&newValue), sizeof(newValue));	   // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+	}
+	mngr.set(std::get<LLU::GenericDataList>(LLU::Serialization::deserialize(path)));
+}
+
+LLU_LIBRARY_FUNCTION(LoadSerialized) {
+	mngr.set(std::get<LLU::GenericDataList>(LLU::Serialization::deserialize(mngr.getString(0))));
+}
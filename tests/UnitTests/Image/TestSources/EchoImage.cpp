@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdint>
 #include <type_traits>
 
@@ -41,6 +42,55 @@ LLU_LIBRARY_FUNCTION(EchoImage2) {
 	});
 }
 
+// copy all channels to a new image with the opposite interleaving, using direct pixel access
+LLU_LIBRARY_FUNCTION(EchoImagePixels) {
+	mngr.operateOnImage(0, [&mngr](auto&& in) {
+		using T = typename std::remove_reference_t<decltype(in)>::value_type;
+		LLU::Image<T> out(in.is3D() ? in.slices() : 0, in.columns(), in.rows(), in.channels(), in.colorspace(), !in.interleavedQ());
+		auto dest = LLU::pixels(out);
+		LLU::pixels(std::as_const(in)).forEachPixel([&dest](auto channels, mint slice, mint row, mint column) {
+			std::copy(channels.begin(), channels.end(), dest.pixel(row, column, slice).begin());
+		});
+		mngr.setImage(out);
+	});
+}
+
+// reverse the order of channels in every pixel, in place
+LLU_LIBRARY_FUNCTION(ReverseChannels) {
+	mngr.operateOnImage(0, [&mngr](auto&& in) {
+		using T = typename std::remove_reference_t<decltype(in)>::value_type;
+		LLU::Image<T> out {in.clone()};
+		LLU::pixels(out).forEachPixel([](auto channels) { std::reverse(channels.begin(), channels.end()); });
+		mngr.setImage(out);
+	});
+}
+
+// copy the image to a newly allocated image with the opposite interleaving, using dedicated layout transforms
+LLU_LIBRARY_FUNCTION(SwitchInterleaving) {
+	mngr.operateOnImage(0, [&mngr](auto&& in) {
+		using T = typename std::remove_reference_t<decltype(in)>::value_type;
+		LLU::Image<T> out(in.is3D() ? in.slices() : 0, in.columns(), in.rows(), in.channels(), in.colorspace(), !in.interleavedQ());
+		if (in.interleavedQ()) {
+			LLU::deinterleave(in, out);
+		} else {
+			LLU::interleave(in, out);
+		}
+		mngr.setImage(out);
+	});
+}
+
+// interleaved "Real32" image with the data of a Real Tensor of rank 2 or 3
+LLU_LIBRARY_FUNCTION(TensorToImage32) {
+	auto t = mngr.getTensor<double, LLU::Passing::Constant>(0);
+	mngr.setImage(LLU::toImage<float>(t));
+}
+
+// Real Tensor with the data of a "Real32" image, in the memory layout of the image
+LLU_LIBRARY_FUNCTION(Image32ToTensor) {
+	auto img = mngr.getImage<float, LLU::Passing::Constant>(0);
+	mngr.setTensor(LLU::toTensor<double>(img));
+}
+
 LLU_LIBRARY_FUNCTION(EchoImage3) {
 	auto img = mngr.getGenericImage(0);
 	mngr.set(img);
@@ -0,0 +1,65 @@
+#include <type_traits>
+
+#include <LLU/ImageKernels.h>
+#include <LLU/LLU.h>
+#include <LLU/LibraryLinkFunctionMacro.h>
+
+namespace K = LLU::Kernels;
+
+// histogram of a "Bit", "Byte" or "Bit16" image, of all channels or of the channel given as the second argument (0 means all)
+LLU_LIBRARY_FUNCTION(ImageHistogram) {
+	const auto channel = mngr.getInteger<mint>(1);
+	mngr.operateOnImage<LLU::Passing::Constant>(0, [&mngr, channel](auto&& img) {
+		using T = typename std::remove_reference_t<decltype(img)>::value_type;
+		if constexpr (K::Detail::is_integer_pixel_v<T>) {
+			auto counts = channel == 0 ? K::histogram(img) : K::histogram(img, channel - 1);
+			mngr.set(LLU::Tensor<mint>(counts.begin(), counts.end()));
+		} else {
+			LLU::ErrorManager::throwException(LLU::ErrorName::ImageTypeError);
+		}
+	});
+}
+
+// number of pixel values above the threshold and the "Bit" image with the thresholded first channel of a single-channel image
+LLU_LIBRARY_FUNCTION(ImageThreshold) {
+	const auto level = mngr.getInteger<mint>(1);
+	mngr.operateOnImage<LLU::Passing::Constant>(0, [&mngr, level](auto&& img) {
+		using T = typename std::remove_reference_t<decltype(img)>::value_type;
+		LLU::Image<std::int8_t> out {img.columns(), img.rows(), 1, img.colorspace(), img.interleavedQ()};
+		K::threshold(img, static_cast<T>(level), out);
+		mngr.set(out);
+	});
+}
+
+// dilation (when the third argument is True) or erosion of every channel of an image with a square of given radius
+LLU_LIBRARY_FUNCTION(ImageMorphology) {
+	const auto radius = mngr.getInteger<mint>(1);
+	const auto dilation = mngr.getBoolean(2);
+	mngr.operateOnImage<LLU::Passing::Constant>(0, [&mngr, radius, dilation](auto&& img) {
+		auto out = img.clone();
+		if (dilation) {
+			K::dilate(img, out, radius);
+		} else {
+			K::erode(img, out, radius);
+		}
+		mngr.set(out);
+	});
+}
+
+// opening (erosion followed by dilation) of the mask of pixels above given level in a "Byte" image, computed in the bit-packed form
+LLU_LIBRARY_FUNCTION(MaskOpening) {
+	const auto img = mngr.getImage<std::uint8_t, LLU::Passing::Constant>(0);
+	const auto level = mngr.getInteger<mint>(1);
+	const auto radius = mngr.getInteger<mint>(2);
+	const auto mask = K::thresholdMask(img, static_cast<std::uint8_t>(level)).erode(radius).dilate(radius);
+	LLU::Image<std::int8_t> out {img.columns(), img.rows(), 1, MImage_CS_Gray, true};
+	K::writeMask(mask, out);
+	mngr.set(out);
+}
+
+// number of pixels above given level in a "Byte" image, counted in the bit-packed form
+LLU_LIBRARY_FUNCTION(MaskCount) {
+	const auto img = mngr.getImage<std::uint8_t, LLU::Passing::Constant>(0);
+	const auto level = mngr.getInteger<mint>(1);
+	mngr.set(K::thresholdMask(img, static_cast<std::uint8_t>(level)).count());
+}
@@ -201,4 +201,31 @@ LIBRARIFY(repeatString)
 void doNothing() noexcept {}
 LIBRARIFY(doNothing)
 
-LIBRARIFY_TO(&Person::description, GetPersonDescription)
\ No newline at end of file
+LIBRARIFY_TO(&Person::description, GetPersonDescription)
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Library functions generated from regular functions with LLU_TYPED_FUNCTION
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+LLU_TYPED_FUNCTION(TypedRepeatString, repeatString)
+
+LLU_TYPED_FUNCTION(TypedPersonDescription, Person::description)
+
+LLU::Tensor<double> scaleTensor(const LLU::Tensor<double>& t, double factor) {
+	LLU::Tensor<double> res {t.begin(), t.end(), t.dimensions()};
+	for (auto& x : res) {
+		x *= factor;
+	}
+	return res;
+}
+LLU_TYPED_FUNCTION(TypedScaleTensor, scaleTensor)
+
+int32_t countAbove(const LLU::NumericArray<int32_t>& na, int32_t threshold) {
+	return static_cast<int32_t>(std::count_if(na.begin(), na.end(), [threshold](int32_t x) { return x > threshold; }));
+}
+LLU_TYPED_FUNCTION(TypedCountAbove, countAbove)
+
+float half(float x) noexcept {
+	return x / 2;
+}
+LLU_TYPED_FUNCTION(TypedHalf, half)
@@ -2,12 +2,23 @@
  * @file	ManagedExprTest.cpp
  * @brief
  */
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <functional>
+#include <numeric>
+#include <thread>
+#include <vector>
 
+#include <LLU/Async/ManagedExpressions.h>
+#include <LLU/Async/ThreadPool.h>
 #include <LLU/ErrorLog/Logger.h>
+#include <LLU/ConcurrentManagedExpression.hpp>
 #include <LLU/LLU.h>
 #include <LLU/LibraryLinkFunctionMacro.h>
 #include <LLU/ManagedExpression.hpp>
+#include <LLU/SharedBuffers.h>
+#include <LLU/SlabManagedExpression.hpp>
 
 /**
  * Sample class to be "managed" by WL.
@@ -51,16 +62,42 @@ DEFINE_MANAGED_STORE_AND_SPECIALIZATION(MyExpression)
 struct Serializable;
 LLU::ManagedExpressionStore<Serializable> SerializableStore;
 
+DEFINE_SHARED_BUFFER_REGISTRY(SharedBuffers)
+
+/// Managed class accessed from worker threads
+struct Tally {
+	explicit Tally(mint v) : value {v} {}
+	mint value;
+};
+
+DEFINE_CONCURRENT_MANAGED_STORE_AND_SPECIALIZATION(Tally)
+
+/// Managed class of which many instances are created
+struct Particle {
+	explicit Particle(mint c) : charge {c} {}
+	mint charge;
+};
+
+DEFINE_SLAB_MANAGED_STORE_AND_SPECIALIZATION(Particle)
+LLU::InstancePool ParticlePool;
+
 EXTERN_C DLLEXPORT int WolframLibrary_initialize(WolframLibraryData libData) {
 	LLU::LibraryData::setLibraryData(libData);
 	MyExpressionStore.registerType("MyExpression");
 	SerializableStore.registerType("Serializable");
+	SharedBuffers.registerType("SharedBuffer");
+	TallyStore.registerType("Tally");
+	ParticleStore.registerType("Particle");
+	ParticleStore.setInstancePool(ParticlePool);
 	return 0;
 }
 
 EXTERN_C DLLEXPORT void WolframLibrary_uninitialize(WolframLibraryData libData) {
 	MyExpressionStore.unregisterType(libData);
 	SerializableStore.unregisterType(libData);
+	SharedBuffers.unregisterType(libData);
+	TallyStore.unregisterType(libData);
+	ParticleStore.unregisterType(libData);
 }
 
 LLU_LIBRARY_FUNCTION(GetManagedExpressionCount) {
@@ -304,4 +341,142 @@ LLU_LIBRARY_FUNCTION(CreateSerializableExpression) {
 LLU_LIBRARY_FUNCTION(Serialize) {
 	auto& myExpr = mngr.getManagedExpression(0, SerializableStore);
 	mngr.set(myExpr.to_string());
-}
\ No newline at end of file
+}
+
+LLU_LIBRARY_FUNCTION(OpenSharedBuffer) {
+	auto id = mngr.getInteger<mint>(0);
+	SharedBuffers.share(id, mngr.getGenericTensor<LLU::Passing::Shared>(1));
+	SharedBuffers.setName(mngr.getString(2), id);
+}
+
+LLU_LIBRARY_FUNCTION(SharedBufferTotal) {
+	auto data = mngr.getManagedExpression(0, SharedBuffers).tensor<double>();
+	mngr.set(std::accumulate(data.begin(), data.end(), 0.0));
+}
+
+LLU_LIBRARY_FUNCTION(ScaleSharedBufferByName) {
+	auto data = SharedBuffers.getInstance(mngr.getString(0)).tensor<double>();
+	auto factor = mngr.getReal(1);
+	std::transform(data.begin(), data.end(), data.begin(), [factor](double x) { return factor * x; });
+}
+
+LLU_LIBRARY_FUNCTION(OpenTally) {
+	auto [id, value] = mngr.getTuple<mint, mint>();
+	TallyStore.createInstance(id, value);
+}
+
+LLU_LIBRARY_FUNCTION(GetTallyValue) {
+	mngr.set(mngr.getManagedExpression(0, TallyStore).value);
+}
+
+/// Sum values of Tallies with given IDs, looked up from multiple threads at the same time
+LLU_LIBRARY_FUNCTION(ParallelTallySum) {
+	auto ids = mngr.getTensor<mint>(0);
+	auto threadCount = mngr.getInteger<mint>(1);
+	std::vector<mint> partialSums(static_cast<std::size_t>(threadCount));
+	std::vector<std::exception_ptr> errors(static_cast<std::size_t>(threadCount));
+	std::vector<std::thread> threads;
+	for (mint t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&, t] {
+			auto pos = static_cast<std::size_t>(t);
+			try {
+				for (mint i = t; i < ids.size(); i += threadCount) {
+					partialSums[pos] += TallyStore.getInstancePointer(ids[i])->value;
+				}
+			} catch (...) {
+				errors[pos] = std::current_exception();
+			}
+		});
+	}
+	for (auto& th : threads) {
+		th.join();
+	}
+	for (const auto& e : errors) {
+		if (e) {
+			std::rethrow_exception(e);
+		}
+	}
+	mngr.set(std::accumulate(partialSums.cbegin(), partialSums.cend(), mint {0}));
+}
+
+/// Multiply values of all Tallies by a factor on a thread pool, while another thread keeps creating and releasing Tallies with negative IDs
+LLU_LIBRARY_FUNCTION(ScaleTallies) {
+	auto [factor, threadCount] = mngr.getTuple<mint, mint>();
+	std::atomic<bool> done = false;
+	std::thread churn {[&done] {
+		for (mint id = -1; !done.load() || id > -100; --id) {
+			TallyStore.manageInstance(False, id);
+			TallyStore.createInstance(id, 0);
+			TallyStore.manageInstance(True, id);
+		}
+	}};
+	{
+		LLU::ThreadPool pool {static_cast<unsigned>(threadCount)};
+		LLU::Async::parallelForEach(pool, TallyStore, 16, [factor = factor](Tally& t) { t.value *= factor; });
+	}
+	done = true;
+	churn.join();
+	mngr.set(static_cast<mint>(TallyStore.size()));
+}
+
+LLU_LIBRARY_FUNCTION(OpenParticle) {
+	auto [id, charge] = mngr.getTuple<mint, mint>();
+	ParticleStore.createInstance(id, charge);
+}
+
+LLU_LIBRARY_FUNCTION(GetCharge) {
+	mngr.set(mngr.getManagedExpression(0, ParticleStore).charge);
+}
+
+/// Get the number of live Particles and their total charge
+LLU_LIBRARY_FUNCTION(ParticleSummary) {
+	mint total = 0;
+	for (const auto& p : ParticleStore) {
+		total += p.second->charge;
+	}
+	mngr.set(LLU::Tensor<mint> {static_cast<mint>(ParticleStore.size()), total});
+}
+
+/// Get the total charge of all Particles, computed on a thread pool
+LLU_LIBRARY_FUNCTION(ParallelParticleCharge) {
+	auto threadCount = mngr.getInteger<mint>(0);
+	std::atomic<mint> total = 0;
+	LLU::ThreadPool pool {static_cast<unsigned>(threadCount)};
+	LLU::Async::parallelForEach(pool, ParticleStore, 256, [&total](const Particle& p) { total.fetch_add(p.charge, std::memory_order_relaxed); });
+	mngr.set(total.load());
+}
+
+LLU_LIBRARY_FUNCTION(OpenParticles) {
+	auto ids = mngr.getTensor<mint>(0);
+	auto charge = mngr.getInteger<mint>(1);
+	ParticleStore.createInstances(ids, charge);
+}
+
+LLU_LIBRARY_FUNCTION(ReleaseParticles) {
+	mngr.set(ParticleStore.releaseInstances(mngr.getTensor<mint>(0)));
+}
+
+LLU_LIBRARY_FUNCTION(ParticlePoolUsage) {
+	mngr.set(static_cast<mint>(ParticlePool.blocksInUse()));
+}
+
+/// Receive n via WSTP and send {n, shared Range[n]} and {n, shared NumericArray of n bytes}, the arrays are handed off via SharedResults
+LLU_WSTP_FUNCTION(StageRanges) {
+	namespace WS = LLU::WS;
+	LLU::WSStream<WS::Encoding::UTF8> ws(wsl, 1);
+	mint n {};
+	ws >> n;
+	LLU::Tensor<double> range(LLU::Uninitialized, {n});
+	std::iota(range.begin(), range.end(), 1.0);
+	LLU::NumericArray<std::uint8_t> bytes(static_cast<std::uint8_t>(7), LLU::MArrayDimensions {n});
+	ws << WS::List(3) << n << WS::shared(std::move(range)) << WS::shared(std::move(bytes));
+}
+
+LLU_LIBRARY_FUNCTION(AdoptSharedResult) {
+	auto id = mngr.getInteger<mint>(0);
+	SharedBuffers.adopt(id, mngr.getInteger<mint>(1));
+}
+
+LLU_LIBRARY_FUNCTION(PendingSharedResults) {
+	mngr.set(static_cast<mint>(LLU::SharedResults::pending()));
+}
@@ -1,10 +1,16 @@
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <list>
 #include <memory>
 #include <numeric>
 #include <type_traits>
 
+#include <LLU/Containers/NumericArrayIO.h>
+#include <LLU/Containers/Views/Converting.hpp>
 #include <LLU/Containers/Views/NumericArray.hpp>
 #include <LLU/ErrorLog/Logger.h>
+#include <LLU/Kernels.h>
 #include <LLU/LibraryLinkFunctionMacro.h>
 #include <LLU/MArgumentManager.h>
 
@@ -197,6 +203,49 @@ LLU_LIBRARY_FUNCTION(convertGeneric) {
 	mngr.set(converted);
 }
 
+// convert NumericArray lazily, element by element
+LLU_LIBRARY_FUNCTION(convertLazy) {
+	mngr.operateOnNumericArray<LLU::Passing::Constant>(0, [&mngr](auto&& numArr) {
+		auto converted = NA::convertingView<std::uint16_t>(numArr, mngr.getInteger<NA::ConversionMethod>(1), mngr.getReal(2));
+		mngr.set(NumericArray<std::uint16_t> {converted.begin(), converted.end(), numArr.dimensions()});
+	});
+}
+
+// convert a copy of Integer32 NumericArray to UnsignedInteger32 reusing its memory
+LLU_LIBRARY_FUNCTION(convertInPlace) {
+	auto numArr = mngr.getNumericArray<std::int32_t, LLU::Passing::Constant>(0).clone();
+	auto converted = NA::convertInPlace<std::uint32_t>(numArr, mngr.getInteger<NA::ConversionMethod>(1), mngr.getReal(2));
+	mngr.set(NumericArray<std::uint32_t> {converted.begin(), converted.end(), numArr.dimensions()});
+}
+
+// convert {NaN, 300.5, -7.2, 3.6} to UnsignedInteger8 with convertRange and with convertValue, the rows of the result must be equal
+LLU_LIBRARY_FUNCTION(convertRangeNaN) {
+	const auto method = mngr.getInteger<NA::ConversionMethod>(0);
+	const std::array<double, 4> in {std::numeric_limits<double>::quiet_NaN(), 300.5, -7.2, 3.6};
+	std::array<std::uint8_t, 4> out {};
+	NA::convertRange(in.data(), out.data(), static_cast<mint>(in.size()), method);
+	LLU::Tensor<mint> result(0, {2, 4});
+	for (std::size_t i = 0; i < in.size(); ++i) {
+		result[static_cast<mint>(i)] = out[i];
+		result[static_cast<mint>(in.size() + i)] = NA::convertValue<std::uint8_t>(in[i], method);
+	}
+	mngr.set(result);
+}
+
+// every element is overwritten, so the NumericArray is created without initialization
+LLU_LIBRARY_FUNCTION(IotaNA) {
+	const auto n = mngr.getInteger<mint>(0);
+	NumericArray<std::int64_t> iota(LLU::Uninitialized, {n});
+	std::iota(iota.begin(), iota.end(), std::int64_t {1});
+	mngr.set(iota);
+}
+
+// elements are computed straight into the result
+LLU_LIBRARY_FUNCTION(SquaresNA) {
+	const auto n = mngr.getInteger<mint>(0);
+	mngr.setNumericArray<double>({n}, [](mint i) { return static_cast<double>((i + 1) * (i + 1)); });
+}
+
 LLU_LIBRARY_FUNCTION(TestDimensions) {
 	auto dims = mngr.getTensor<mint>(0);
 	NumericArray<float> na(0.0, LLU::MArrayDimensions {dims.asVector()});
@@ -273,4 +322,74 @@ LLU_LIBRARY_FUNCTION(Reverse) {
 		using T = typename std::remove_reference_t<decltype(typedNA)>::value_type;
 		mngr.set(NumericArray<T>(std::crbegin(typedNA), std::crend(typedNA), LLU::MArrayDimensions {typedNA.getDimensions(), typedNA.getRank()}));
 	});
-}
\ No newline at end of file
+}
+
+LLU_LIBRARY_FUNCTION(Norms) {
+	auto naConstant = mngr.getGenericNumericArray<LLU::Passing::Constant>(0);
+	LLU::asTypedNumericArray(naConstant, [&mngr](auto&& typedNA) {
+		namespace K = LLU::Kernels;
+		mngr.set(LLU::Tensor<double> {static_cast<double>(K::norm1(typedNA)), static_cast<double>(K::norm2(typedNA)),
+									  static_cast<double>(K::normInf(typedNA))});
+	});
+}
+
+LLU_LIBRARY_FUNCTION(Axpy) {
+	auto alpha = mngr.getReal(0);
+	auto x = mngr.getNumericArray<double, LLU::Passing::Constant>(1);
+	auto y = mngr.getNumericArray<double, LLU::Passing::Constant>(2);
+	NumericArray<double> out = y.clone();
+	LLU::Kernels::axpy(alpha, x, out);
+	mngr.set(out);
+}
+
+// dot product of two real NumericArrays of any precision, the lambda is instantiated only for the 4 combinations of float and double
+LLU_LIBRARY_FUNCTION(DotReal) {
+	auto dot = mngr.visitNumericArrays<LLU::TypeList<float, double>, LLU::Passing::Constant>(
+		[](const auto& x, const auto& y) {
+			if (x.size() != y.size()) {
+				LLU::ErrorManager::throwException(LLU::ErrorName::DimensionsError);
+			}
+			return std::inner_product(x.begin(), x.end(), y.begin(), 0.0);
+		},
+		0, 1);
+	mngr.set(dot);
+}
+
+// arguments are read as views, so no NumericArray wrappers are created and metadata is only queried when used
+LLU_LIBRARY_FUNCTION(ViewSummary) {
+	auto [values, shape] = mngr.getTuple<LLU::NumericArrayTypedView<double>, LLU::NumericArrayView>();
+	const auto dims = shape.dimensions();
+	mngr.set(LLU::Tensor<double> {std::accumulate(values.begin(), values.end(), 0.0), static_cast<double>(dims.rank()),
+								  static_cast<double>(dims.flatCount())});
+}
+
+LLU_LIBRARY_FUNCTION(ReadReal32File) {
+	LLU::BinaryReadOptions opts;
+	opts.offset = static_cast<std::uint64_t>(mngr.getInteger<mint>(1));
+	opts.byteOrder = mngr.getBoolean(2) ? LLU::ByteOrder::BigEndian : LLU::ByteOrder::LittleEndian;
+	opts.chunkSize = 1024;
+	mngr.set(LLU::readBinaryFile<double, float>(mngr.getString(0), {}, opts));
+}
+
+LLU_LIBRARY_FUNCTION(ReadIntegerMatrix) {
+	auto columns = mngr.getInteger<mint>(1);
+	LLU::TextReadOptions opts;
+	opts.chunkSize = 1024;
+	auto numbers = LLU::readTextFile<std::int64_t>(mngr.getString(0), {}, opts);
+	mngr.set(LLU::NumericArray<std::int64_t> {numbers, {numbers.size() / columns, columns}});
+}
+
+LLU_LIBRARY_FUNCTION(WriteRealArray) {
+	auto na = mngr.getNumericArray<double>(1);
+	LLU::BinaryWriteOptions opts;
+	opts.bufferSize = 4096;
+	opts.directIO = mngr.getBoolean(2);
+	LLU::BinaryFileWriter writer {mngr.getString(0), opts};
+	// element by element through the buffers, then the whole array at once
+	for (auto x : na) {
+		writer.write(&x, 1);
+	}
+	writer.write(na);
+	writer.close();
+	mngr.set(static_cast<mint>(writer.bytesWritten()));
+}
@@ -18,6 +18,11 @@ accumulateIntegers = `LLU`PacletFunctionLoad["accumulateIntegers", {{NumericArra
 convertMethodName = `LLU`PacletFunctionLoad["convertMethodName", {Integer}, String];
 convert = `LLU`PacletFunctionLoad["convert", {{NumericArray, "Constant"}, Integer, Real}, NumericArray];
 convertGeneric = `LLU`PacletFunctionLoad["convertGeneric", {{NumericArray, "Constant"}, Integer, Real}, NumericArray];
+convertLazy = `LLU`PacletFunctionLoad["convertLazy", {{NumericArray, "Constant"}, Integer, Real}, NumericArray];
+convertInPlace = `LLU`PacletFunctionLoad["convertInPlace", {{NumericArray, "Constant"}, Integer, Real}, NumericArray];
+convertRangeNaN = `LLU`PacletFunctionLoad["convertRangeNaN", {Integer}, {Integer, 2}];
+iotaNA = `LLU`PacletFunctionLoad["IotaNA", {Integer}, NumericArray];
+squaresNA = `LLU`PacletFunctionLoad["SquaresNA", {Integer}, NumericArray];
 testDimensions = `LLU`PacletFunctionLoad["TestDimensions", {{Integer, 1, "Constant"}}, NumericArray];
 testDimensions2 = `LLU`PacletFunctionLoad["TestDimensions2", {}, "DataStore"];
 FlattenThroughList = `LLU`PacletFunctionLoad["FlattenThroughList", {NumericArray}, NumericArray];
@@ -25,4 +30,11 @@ CopyThroughTensor = `LLU`PacletFunctionLoad["CopyThroughTensor", {NumericArray},
 GetLargest = `LLU`PacletFunctionLoad["GetLargest", {NumericArray, {NumericArray, "Constant"}, {NumericArray, "Manual"}}, Integer];
 EmptyView = `LLU`PacletFunctionLoad["EmptyView", {}, {Integer, 1}];
 SumLargestDimensions = `LLU`PacletFunctionLoad["SumLargestDimensions", {NumericArray, {NumericArray, "Constant"}}, Integer];
-ReverseNA = `LLU`PacletFunctionLoad["Reverse", {{NumericArray, "Constant"}}, NumericArray];
\ No newline at end of file
+ReverseNA = `LLU`PacletFunctionLoad["Reverse", {{NumericArray, "Constant"}}, NumericArray];
+Norms = `LLU`PacletFunctionLoad["Norms", {{NumericArray, "Constant"}}, {Real, 1}];
+Axpy = `LLU`PacletFunctionLoad["Axpy", {Real, {NumericArray, "Constant"}, {NumericArray, "Constant"}}, NumericArray];
+DotReal = `LLU`PacletFunctionLoad["DotReal", {{NumericArray, "Constant"}, {NumericArray, "Constant"}}, Real];
+ViewSummary = `LLU`PacletFunctionLoad["ViewSummary", {{NumericArray, "Constant"}, {NumericArray, "Shared"}}, {Real, 1}];
+ReadReal32File = `LLU`PacletFunctionLoad["ReadReal32File", {String, Integer, "Boolean"}, NumericArray];
+ReadIntegerMatrix = `LLU`PacletFunctionLoad["ReadIntegerMatrix", {String, Integer}, NumericArray];
+WriteRealArray = `LLU`PacletFunctionLoad["WriteRealArray", {String, {NumericArray, "Constant"}, "Boolean"}, Integer];
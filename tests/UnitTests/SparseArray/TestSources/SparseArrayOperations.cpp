@@ -131,4 +131,34 @@ LLU_LIBRARY_FUNCTION(SetImplicitValueTyped) {
 	auto implValue = mngr.getReal(1);
 	sp.setImplicitValue(implValue);
 	mngr.set(sp);
-}
\ No newline at end of file
+}
+
+LLU_LIBRARY_FUNCTION(SparseRowEntries) {
+	const auto sp = mngr.getSparseArray<double, LLU::Passing::Constant>(0);
+	const auto row = LLU::SparseMatrixView<double> {sp}.row(mngr.getInteger<mint>(1) - 1);
+	LLU::Tensor<double> entries(0.0, {row.size(), 2});
+	mint k = 0;
+	for (auto [column, value] : row) {
+		entries[{k, 0}] = static_cast<double>(column + 1);
+		entries[{k, 1}] = value;
+		++k;
+	}
+	mngr.set(entries);
+}
+
+LLU_LIBRARY_FUNCTION(SparseDot) {
+	const auto sp = mngr.getSparseArray<double, LLU::Passing::Constant>(0);
+	const auto dense = mngr.getTensor<double, LLU::Passing::Constant>(1);
+	mngr.set(LLU::Sparse::dot(LLU::SparseMatrixView<double> {sp}, dense));
+}
+
+LLU_LIBRARY_FUNCTION(BuildSparse) {
+	const auto positions = mngr.getTensor<mint, LLU::Passing::Constant>(0);
+	const auto values = mngr.getTensor<double, LLU::Passing::Constant>(1);
+	const auto dims = mngr.getTensor<mint, LLU::Passing::Constant>(2);
+	LLU::SparseArrayBuilder<double> builder {dims[0], dims[1]};
+	for (mint k = 0; k < values.size(); ++k) {
+		builder.add(positions[{k, 0}] - 1, positions[{k, 1}] - 1, values[k]);
+	}
+	mngr.set(builder.finalize());
+}
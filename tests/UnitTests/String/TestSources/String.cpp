@@ -60,4 +60,40 @@ EXTERN_C DLLEXPORT int StringLength(WolframLibraryData libData, mint Argc, MArgu
 	auto name = mngr.getString(0);
 	mngr.setInteger(name.length());
 	return LIBRARY_NO_ERROR;
-}
\ No newline at end of file
+}
+
+LIBRARY_LINK_FUNCTION(JoinStringViews) {
+	LLU::MArgumentManager mngr(libData, Argc, Args, Res);
+
+	auto sep = mngr.getStringView(0);
+	std::string result {mngr.getStringView(1)};
+	for (mint i = 2; i < Argc; ++i) {
+		result.append(sep).append(mngr.getStringView(i));
+	}
+	// reading the same argument again must not take it from LibraryLink for the second time
+	result.append(mngr.getStringView(0));
+	mngr.setString(std::move(result));
+	return LIBRARY_NO_ERROR;
+}
+
+LIBRARY_LINK_FUNCTION(StaticGreeting) {
+	LLU::MArgumentManager mngr(libData, Argc, Args, Res);
+
+	static const std::string greeting = "Hello from a static string";
+	mngr.setStringView(greeting);
+	return LIBRARY_NO_ERROR;
+}
+
+LIBRARY_LINK_FUNCTION(RepeatStringMoved) {
+	LLU::MArgumentManager mngr(libData, Argc, Args, Res);
+
+	auto in = mngr.getStringView(0);
+	auto n = mngr.getInteger<std::size_t>(1);
+	std::string result;
+	result.reserve(in.size() * n);
+	for (std::size_t i = 0; i < n; ++i) {
+		result.append(in);
+	}
+	mngr.setString(std::move(result));
+	return LIBRARY_NO_ERROR;
+}
@@ -3,11 +3,22 @@
  * @brief
  */
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <numeric>
+#include <vector>
 
+#include <LLU/Async/ThreadPool.h>
+#include <LLU/Containers/FixedRank.hpp>
+#include <LLU/Containers/Scratch.h>
 #include <LLU/Containers/Tensor.h>
+#include <LLU/Containers/Transpose.h>
 #include <LLU/Containers/Views/Tensor.hpp>
+#include <LLU/Expressions.h>
 #include <LLU/LibraryLinkFunctionMacro.h>
+#include <LLU/Listable.h>
 #include <LLU/MArgumentManager.h>
 
 using LLU::Tensor;
@@ -119,6 +130,71 @@ LLU_LIBRARY_FUNCTION(IntegerMatrixTranspose) {
 	mngr.setTensor(out);
 }
 
+LLU_LIBRARY_FUNCTION(IntegerMatrixTransposeView) {
+	auto t = mngr.getTensor<mint, LLU::Passing::Constant>(0);
+	Tensor<mint> out(0, {t.dimension(1), t.dimension(0)});
+	auto dest = out.begin();
+	t.view().transposed().forEach([&dest](mint elem) { *dest++ = elem; });
+	mngr.setTensor(out);
+}
+
+LLU_LIBRARY_FUNCTION(IntegerMatrixTransposeBlocked) {
+	auto t = mngr.getTensor<mint, LLU::Passing::Constant>(0);
+	mngr.setTensor(LLU::transpose(t));
+}
+
+// dimension i of the result is dimension order[i] of the input, order is 0-based
+LLU_LIBRARY_FUNCTION(PermuteDimensions) {
+	auto t = mngr.getTensor<double, LLU::Passing::Constant>(0);
+	auto order = mngr.getTensor<mint, LLU::Passing::Constant>(1);
+	mngr.setTensor(LLU::permuteDimensions(t, order.asVector()));
+}
+
+// row sums of the data of a Tensor viewed as a matrix with n columns, without copying
+LLU_LIBRARY_FUNCTION(ReshapedRowSums) {
+	auto t = mngr.getTensor<double, LLU::Passing::Constant>(0);
+	auto n = mngr.getInteger<mint>(1);
+	auto matrix = LLU::reshape(t, {t.size() / n, n});
+	Tensor<double> out(0., {matrix.dimension(0)});
+	for (mint row = 0; row < matrix.dimension(0); ++row) {
+		matrix.slice(0, row).forEach([&out, row](double x) { out[row] += x; });
+	}
+	mngr.setTensor(out);
+}
+
+LLU_LIBRARY_FUNCTION(ColumnSums) {
+	auto t = mngr.getTensor<double, LLU::Passing::Constant>(0);
+	auto matrix = t.view();
+	Tensor<double> out(0., {t.dimension(1)});
+	for (mint col = 0; col < t.dimension(1); ++col) {
+		auto column = matrix.slice(1, col);
+		out[col] = std::accumulate(column.begin(), column.end(), 0.0);
+	}
+	mngr.setTensor(out);
+}
+
+LLU_LIBRARY_FUNCTION(SubBlock) {
+	auto t = mngr.getTensor<mint, LLU::Passing::Constant>(0);
+	auto lo = mngr.getTensor<mint, LLU::Passing::Constant>(1);
+	auto hi = mngr.getTensor<mint, LLU::Passing::Constant>(2);
+	auto block = t.view().subarray({lo.begin(), lo.end()}, {hi.begin(), hi.end()});
+	Tensor<mint> out(block.begin(), block.end(), LLU::MArrayDimensions {block.dimensions().begin(), block.dimensions().end()});
+	mngr.setTensor(out);
+}
+
+LLU_LIBRARY_FUNCTION(FivePointLaplacian) {
+	LLU::FixedRankTensor<double, 2> in {mngr.getTensor<double, LLU::Passing::Constant>(0)};
+	const auto rows = in.extent<0>();
+	const auto cols = in.extent<1>();
+	LLU::FixedRankTensor<double, 2> out(0., {rows, cols});
+	for (mint i = 1; i < rows - 1; ++i) {
+		for (mint j = 1; j < cols - 1; ++j) {
+			out(i, j) = in(i - 1, j) + in(i + 1, j) + in(i, j - 1) + in(i, j + 1) - 4 * in(i, j);
+		}
+	}
+	mngr.setTensor(out);
+}
+
 LLU_LIBRARY_FUNCTION(MeanValue) {
 	auto t = mngr.getTensor<double>(0);
 
@@ -193,4 +269,147 @@ LLU_LIBRARY_FUNCTION(Reverse) {
 		using T = typename std::remove_reference_t<decltype(typedNA)>::value_type;
 		mngr.set(Tensor<T>(std::crbegin(typedNA), std::crend(typedNA), LLU::MArrayDimensions{typedNA.getDimensions(), typedNA.getRank()}));
 	});
-}
\ No newline at end of file
+}
+
+LLU_LIBRARY_FUNCTION(ScratchSmooth) {
+	const auto data = mngr.getTensor<double, LLU::Passing::Constant>(0);
+	const auto passes = mngr.getInteger<mint>(1);
+	LLU::ScratchScope scope;
+	LLU::ScratchArray<double> current {scope.arena(), data.begin(), data.end(), data.dimensions()};
+	LLU::ScratchArray<double> next {scope.arena(), data.dimensions()};
+	const auto n = current.size();
+	for (mint p = 0; p < passes; ++p) {
+		next[0] = current[0];
+		next[n - 1] = current[n - 1];
+		for (mint i = 1; i < n - 1; ++i) {
+			next[i] = (current[i - 1] + current[i] + current[i + 1]) / 3.0;
+		}
+		std::swap(current, next);
+	}
+	mngr.set(current.toTensor());
+}
+
+LLU_LIBRARY_FUNCTION(OuterProduct) {
+	const auto u = mngr.getTensor<double, LLU::Passing::Constant>(0);
+	const auto v = mngr.getTensor<double, LLU::Passing::Constant>(1);
+	mngr.setTensor<double>({u.size(), v.size()}, [&u, &v](double* out, mint /*length*/) {
+		for (mint i = 0; i < u.size(); ++i) {
+			for (mint j = 0; j < v.size(); ++j) {
+				*out++ = u[i] * v[j];
+			}
+		}
+	});
+}
+
+// sum of squares with the leading elements peeled off, so that the main loop starts at an Alignment-byte boundary
+template<std::size_t Alignment>
+double peeledSumOfSquares(const LLU::IterableContainer<double>& c) {
+	const auto peel = c.peelCount<Alignment>();
+	if (peel < c.size() && reinterpret_cast<std::uintptr_t>(c.data() + peel) % Alignment != 0) {
+		LLU::ErrorManager::throwException(LLU::ErrorName::FunctionError);
+	}
+	double sum = 0.0;
+	for (mint i = 0; i < peel; ++i) {
+		sum += c[i] * c[i];
+	}
+	if (c.alignedQ<Alignment>()) {
+		const double* data = c.assumeAligned<Alignment>();
+		for (mint i = 0; i < c.size(); ++i) {
+			sum += data[i] * data[i];
+		}
+	} else {
+		for (mint i = peel; i < c.size(); ++i) {
+			sum += c[i] * c[i];
+		}
+	}
+	return sum;
+}
+
+// the alignment actually provided by LibraryLink is checked before it is assumed
+LLU_LIBRARY_FUNCTION(AlignedSumOfSquares) {
+	const auto in = mngr.getTensor<double, LLU::Passing::Constant>(0);
+	if (in.alignment() >= 32) {
+		mngr.set(peeledSumOfSquares<32>(in));
+	} else {
+		mngr.set(peeledSumOfSquares<16>(in));
+	}
+}
+
+// contiguous doubles starting given number of elements after a 32-byte boundary, so that the number of peeled elements is known
+class ShiftedBuffer : public LLU::IterableContainer<double> {
+public:
+	ShiftedBuffer(const double* first, mint count, mint shift) : storage(static_cast<std::size_t>(count + shift + 4)) {
+		auto* boundary = storage.data();
+		while (reinterpret_cast<std::uintptr_t>(boundary) % 32 != 0) {
+			++boundary;
+		}
+		start = boundary + shift;
+		length = count;
+		std::copy_n(first, count, start);
+	}
+
+private:
+	double* getData() const noexcept override {
+		return start;
+	}
+
+	mint getSize() const noexcept override {
+		return length;
+	}
+
+	std::vector<double> storage;
+	double* start = nullptr;
+	mint length = 0;
+};
+
+LLU_LIBRARY_FUNCTION(ShiftedSumOfSquares) {
+	const auto in = mngr.getTensor<double, LLU::Passing::Constant>(0);
+	const ShiftedBuffer buffer {in.data(), in.size(), mngr.getInteger<mint>(1)};
+	mngr.set(LLU::Tensor<double> {static_cast<double>(buffer.peelCount<32>()), peeledSumOfSquares<32>(buffer)});
+}
+
+// the matrix is read as a view, so no Tensor wrapper is created and the dimensions are not copied
+double traceView(const LLU::TensorTypedView<double>& m) {
+	const auto dims = m.dimensions();
+	if (dims.rank() != 2 || dims[0] != dims[1]) {
+		LLU::ErrorManager::throwException(LLU::ErrorName::DimensionsError);
+	}
+	double trace = 0.0;
+	for (mint i = 0; i < dims[0]; ++i) {
+		trace += m[i * dims[0] + i];
+	}
+	return trace;
+}
+
+LLU_TYPED_FUNCTION(TraceView, traceView)
+
+double hypotenuse(double x, double y) {
+	return std::sqrt(x * x + y * y);
+}
+
+LLU_LISTABLE_FUNCTION(ListableHypot, hypotenuse)
+
+bool divides(mint d, mint n) {
+	return d != 0 && n % d == 0;
+}
+
+LLU_LISTABLE_FUNCTION(ListableDivides, divides)
+
+mint collatzSteps(mint n) {
+	mint steps = 0;
+	for (; n > 1; ++steps) {
+		n = (n % 2 == 0) ? n / 2 : 3 * n + 1;
+	}
+	return steps;
+}
+
+LLU_PARALLEL_LISTABLE_FUNCTION(ParallelCollatz, collatzSteps)
+
+LLU_LIBRARY_FUNCTION(FusedExpression) {
+	auto a = mngr.getTensor<double, LLU::Passing::Constant>(0);
+	auto b = mngr.getTensor<double, LLU::Passing::Constant>(1);
+	Tensor<double> c(a.dimensions(), a * b + 1.0);
+	LLU::ThreadPool pool {2};
+	LLU::Expr::assign(pool, c, LLU::Expr::sqrt(c) - 2.0 * LLU::Expr::max(a, b), 4);
+	mngr.set(c);
+}
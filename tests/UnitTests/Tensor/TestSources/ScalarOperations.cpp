@@ -27,6 +27,30 @@ LLU_LIBRARY_FUNCTION(getNthIntegerFromTR2) {
 		mngr.setInteger(t[{i, j}]);
 }
 
+/* Gets the (i,j,k) Real number from the rank 3 tensor T0, with bound checking */
+LLU_LIBRARY_FUNCTION(getNthRealFromTR3) {
+		auto t = mngr.getTensor<double>(0);
+		auto i = mngr.getInteger<mint>(1) - 1;
+		auto j = mngr.getInteger<mint>(2) - 1;
+		auto k = mngr.getInteger<mint>(3) - 1;
+
+		mngr.setReal(t.at(i, j, k));
+}
+
+/* Computes a weighted sum of all elements in the rank 3 tensor T0, accessing them by coordinates */
+LLU_LIBRARY_FUNCTION(weightedSumTR3) {
+		auto t = mngr.getTensor<double>(0);
+		double sum = 0.;
+		for (mint i = 0; i < t.dimension(0); ++i) {
+			for (mint j = 0; j < t.dimension(1); ++j) {
+				for (mint k = 0; k < t.dimension(2); ++k) {
+					sum += static_cast<double>(i + 2 * j + 3 * k) * t(i, j, k);
+				}
+			}
+		}
+		mngr.setReal(sum);
+}
+
 /**
  * Constructs a new rank 1 tensor of length I0, and sets the
  * ith element of the vector to 2*i
@@ -1,11 +1,17 @@
+#include <algorithm>
 #include <memory>
+#include <numeric>
+#include <utility>
 
+#include <LLU/Containers/ContainerPool.h>
+#include <LLU/Containers/CopyOnWrite.h>
 #include <LLU/Containers/Tensor.h>
 #include <LLU/LibraryLinkFunctionMacro.h>
 #include <LLU/MArgumentManager.h>
 
 namespace {
 	std::unique_ptr<LLU::Tensor<double>> tensor {};
+	LLU::ContainerPool pool;
 }
 
 EXTERN_C DLLEXPORT mint WolframLibrary_getVersion() {
@@ -17,6 +23,10 @@ EXTERN_C DLLEXPORT int WolframLibrary_initialize(WolframLibraryData libData) {
 	return 0;
 }
 
+EXTERN_C DLLEXPORT void WolframLibrary_uninitialize(WolframLibraryData /*libData*/) {
+	pool.clear();
+}
+
 LLU_LIBRARY_FUNCTION(loadRealArray) {
 	auto genericTensor = mngr.getGenericTensor<LLU::Passing::Shared>(0);
 	tensor = std::make_unique<LLU::Tensor<double>>(std::move(genericTensor));
@@ -63,3 +73,31 @@ LLU_LIBRARY_FUNCTION(copyShared) {
 	LLU::Tensor<double> copy {sharedTensor.clone()};	   // create deep copy of the shared Tensor. The new Tensor is not Shared
 	mngr.setInteger(100 * sc + 10 * sharedTensor.shareCount() + copy.shareCount());
 }
+
+// Returns {shared after reading, shared after writing, first element of the input, first element of the clone}
+LLU_LIBRARY_FUNCTION(lazyCloneIncrement) {
+	auto in = mngr.getTensor<mint, LLU::Passing::Constant>(0);
+	auto lazy = LLU::lazyClone(in);
+	auto total = std::accumulate(std::as_const(lazy).begin(), std::as_const(lazy).end(), mint {0});
+	auto sharedAfterRead = lazy.sharedQ();
+	lazy[0] += total;
+	mngr.set(LLU::Tensor<mint> {static_cast<mint>(sharedAfterRead), static_cast<mint>(lazy.sharedQ()), in[0], lazy.get()[0]});
+}
+
+LLU_LIBRARY_FUNCTION(pooledSquareTotal) {
+	auto in = mngr.getTensor<double, LLU::Passing::Constant>(0);
+	auto squares = pool.tensor<double>(in.dimensions());
+	std::transform(in.begin(), in.end(), squares->begin(), [](double x) { return x * x; });
+	mngr.set(std::accumulate(squares->begin(), squares->end(), 0.0));
+}
+
+LLU_LIBRARY_FUNCTION(pooledSquares) {
+	auto in = mngr.getTensor<double, LLU::Passing::Constant>(0);
+	auto squares = pool.tensor<double>(in.dimensions());
+	std::transform(in.begin(), in.end(), squares->begin(), [](double x) { return x * x; });
+	mngr.set(squares);
+}
+
+LLU_LIBRARY_FUNCTION(pooledCount) {
+	mngr.set(static_cast<mint>(pool.size()));
+}
@@ -3,7 +3,10 @@
  * @brief
  */
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <vector>
 
 #include <LLU/LLU.h>
 #include <LLU/LibraryLinkFunctionMacro.h>
@@ -93,6 +96,17 @@ LLU_LIBRARY_FUNCTION(ReadStrings) {
 	mngr.set(wordList);
 }
 
+LLU_LIBRARY_FUNCTION(SumMappedReals) {
+	auto filePath = mngr.getString(0);
+	auto offset = mngr.getInteger<mint>(1);
+	LLU::MappedFile file {filePath};
+	file.advise(LLU::AccessHint::Sequential);
+	auto numbers = file.view<double>(static_cast<std::size_t>(offset));
+	double sum = 0;
+	numbers.forEach([&sum](double x) { sum += x; });
+	mngr.set(sum);
+}
+
 static std::wstring toWideStr(const std::u16string& u16) {
 	return {u16.begin(), u16.end()};
 }
@@ -171,3 +185,42 @@ LLU_LIBRARY_FUNCTION(UTF32BytesToUTF8) {
 	std::string u8str = LLU::fromUTF32toUTF8(u32str);
 	mngr.set(u8str);
 }
+
+LLU_LIBRARY_FUNCTION(UTF8BytesToUTF16Chunked) {
+	auto u8bytes = mngr.getNumericArray<uint8_t>(0);
+	// the buffer must fit a surrogate pair
+	auto chunkSize = std::max<std::size_t>(mngr.getInteger<std::size_t>(1), 2);
+	std::string u8 {u8bytes.begin(), u8bytes.end()};
+	std::vector<char16_t> buffer(chunkSize);
+	std::u16string u16;
+	std::size_t pos = 0;
+	for (;;) {
+		auto result = LLU::convertUTF8toUTF16(u8.data() + pos, u8.size() - pos, buffer.data(), buffer.size());
+		u16.append(buffer.data(), result.written);
+		pos += result.read;
+		if (result.status == LLU::ConversionStatus::Ok) {
+			break;
+		}
+		if (result.status == LLU::ConversionStatus::InvalidInput) {
+			LLU::ErrorManager::throwException(LLU::ErrorName::InvalidEncoding, "UTF8", static_cast<mint>(pos));
+		}
+	}
+	LLU::NumericArray<uint16_t> u16bytes {0, LLU::MArrayDimensions {static_cast<mint>(u16.length())}};
+	std::copy(u16.cbegin(), u16.cend(), u16bytes.begin());
+	mngr.set(u16bytes);
+}
+
+namespace {
+	std::atomic<mint> dispatchedCalls {0};
+
+	int countDispatchedCall(const LLU::FunctionRegistry::Entry& entry, WolframLibraryData libData, mint Argc, MArgument* Args, MArgument Res) {
+		++dispatchedCalls;
+		return entry.function(libData, Argc, Args, Res);
+	}
+}  // namespace
+
+// installs an interceptor that counts calls made through the dispatcher and returns the number of calls counted so far
+LLU_LIBRARY_FUNCTION(DispatchedCallCount) {
+	LLU::FunctionRegistry::setInterceptor(&countDispatchedCall);
+	mngr.setInteger(dispatchedCalls.load());
+}
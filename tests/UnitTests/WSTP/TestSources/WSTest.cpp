@@ -8,14 +8,20 @@
 #include <LLU/NoMinMaxWindows.h>
 
 #include <algorithm>
+#include <array>
 #include <iostream>
 #include <map>
+#include <numeric>
 #include <random>
 #include <regex>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <LLU/Containers/NumericArray.h>
+#include <LLU/Containers/Tensor.h>
 #include <LLU/LibraryData.h>
 #include <LLU/ErrorLog/LibraryLinkError.h>
 #include <LLU/LibraryLinkFunctionMacro.h>
@@ -424,6 +430,21 @@ LLU_WSTP_FUNCTION(GetSet) {
 	ml << WS::EndPacket;
 }
 
+LLU_WSTP_FUNCTION(SendContiguousRanges) {
+	WSStream<WS::Encoding::UTF8> ml(wsl, "List", 1);
+	wsint64 n {};
+	ml >> n;
+	std::vector<wsint64> v(static_cast<std::size_t>(n));
+	std::iota(v.begin(), v.end(), wsint64 {1});
+	std::array<double, 3> a {0.5, 1.5, 2.5};
+	ml << WS::List(4);
+	ml.sendRange(v.cbegin(), v.cend());
+	ml.sendRange(v.data(), v.data() + v.size(), "Hold");
+	ml << a;
+	ml.sendRange(v.cend(), v.cend());
+	ml << WS::EndPacket;
+}
+
 //
 // Associations/Maps
 //
@@ -453,6 +474,46 @@ LLU_WSTP_FUNCTION(ReadNestedMap) {
 	ml << WS::putAs<WS::Encoding::UTF8>(myNestedMap);
 }
 
+LLU_WSTP_FUNCTION(WordLengths) {
+	WSTPStream ml(wsl, 1);
+
+	std::vector<std::pair<std::string, mint>> words;
+	ml >> words;
+
+	std::unordered_map<std::string, mint> lengths;
+	for (const auto& [word, count] : words) {
+		lengths[word] = count * static_cast<mint>(word.length());
+	}
+	ml << lengths;
+}
+
+LLU_WSTP_FUNCTION(InvertPackedTable) {
+	WSTPStream ml(wsl, 1);
+
+	std::unordered_map<double, mint> table;
+	ml.receivePackedAssociation(table);
+
+	std::map<mint, double> inverted;
+	for (const auto& [key, value] : table) {
+		inverted.emplace(value, key);
+	}
+	ml.sendPackedAssociation(inverted);
+}
+
+//
+// Expressions with fixed shape
+//
+
+LLU_WSTP_FUNCTION(FixedShapeExpr) {
+	WSTPStream ml(wsl, 2);
+
+	mint n {};
+	double d {};
+	ml >> n >> d;
+
+	ml << WS::association(WS::rule("n", n), WS::rule("d", d), WS::rule("both", WS::list(n, d, WS::expr("f", n * 2))), WS::rule("empty", WS::list()));
+}
+
 //
 // BeginExpr - DropExpr - EndExpr
 //
@@ -521,6 +582,61 @@ LLU_WSTP_FUNCTION(FactorsOrFailed) {
 	ml << WS::EndExpr();
 }
 
+LLU_WSTP_FUNCTION(BufferedRaggedArray) {
+	WSTPStream ml(wsl, 1);
+	ml.setExprMode(WS::ExprMode::Buffered);
+
+	int len = 0;
+	ml >> len;
+
+	ml << WS::BeginExpr("List");
+	for (int i = 0; i < len; ++i) {
+		ml << WS::BeginExpr("List");
+		for (int j = 0; j < i; ++j) {
+			ml << WS::BeginExpr("List");
+			for (int k = 0; k <= j; ++k) {
+				ml << k;
+			}
+			if (j % 2 == 1) {
+				ml << WS::DropExpr();
+				ml << WS::Symbol("$Failed");
+			}
+			ml << WS::EndExpr();
+		}
+		ml << WS::EndExpr();
+	}
+	ml << WS::EndExpr();
+}
+
+LLU_WSTP_FUNCTION(BufferedFactorsOrFailed) {
+	WSTPStream ml(wsl, 1);
+	ml.setExprMode(WS::ExprMode::Buffered);
+
+	std::vector<int> numbers;
+	ml >> numbers;
+
+	ml << WS::BeginExpr("Association");
+	for (auto&& n : numbers) {
+		ml << WS::Rule << n;
+		ml << WS::BeginExpr("List");
+		int divisors = 0;
+		for (int j = 1; j <= n; ++j) {
+			if (n % j == 0) {
+				if (divisors < 15) {
+					ml << j;
+					divisors++;
+				} else {
+					ml << WS::DropExpr();
+					ml << WS::Symbol("$Failed");
+					break;
+				}
+			}
+		}
+		ml << WS::EndExpr();
+	}
+	ml << WS::EndExpr();
+}
+
 LLU_WSTP_FUNCTION(Empty) {
 	WSTPStream ml(wsl, 1);
 
@@ -531,6 +647,16 @@ LLU_WSTP_FUNCTION(Empty) {
 	ml << WS::EndExpr();
 }
 
+LLU_WSTP_FUNCTION(ReverseStrings) {
+	WSTPStream ml(wsl, 1);
+
+	std::vector<std::string> listOfStrings;
+	ml >> listOfStrings;
+
+	std::reverse(listOfStrings.begin(), listOfStrings.end());
+	ml << listOfStrings;
+}
+
 LLU_WSTP_FUNCTION(ListOfStringsTiming) {
 
 	WSTPStream ml(wsl, 2);
@@ -556,3 +682,92 @@ LLU_WSTP_FUNCTION(ListOfStringsTiming) {
 
 	ml << WS::EndPacket;
 }
+
+//
+// Tensors and NumericArrays
+//
+
+LLU_WSTP_FUNCTION(ScaleTensor) {
+	WSTPStream ml(wsl, 2);
+
+	LLU::Tensor<double> t;
+	double factor {};
+	ml >> t >> factor;
+
+	std::transform(t.cbegin(), t.cend(), t.begin(), [factor](double d) { return d * factor; });
+	ml << t;
+}
+
+LLU_WSTP_FUNCTION(ReverseNumericArrays) {
+	WSTPStream ml(wsl, 2);
+
+	LLU::NumericArray<std::uint8_t> bytes;
+	LLU::NumericArray<std::int64_t> integers;
+	ml >> bytes >> integers;
+
+	std::reverse(bytes.begin(), bytes.end());
+	std::reverse(integers.begin(), integers.end());
+	ml << WS::List(2) << bytes << integers;
+}
+
+LLU_WSTP_FUNCTION(ChunkedAccumulate) {
+	WSTPStream ml(wsl, 2);
+
+	mint chunkSize {};
+	ml >> chunkSize;
+	std::vector<mint> sums;
+	mint runningSum = 0;
+	ml.receiveChunked<mint>([&](const mint* data, mint /*offset*/, mint count) {
+		std::for_each(data, data + count, [&](mint x) { sums.push_back(runningSum += x); });
+	});
+
+	ml.sendChunked<mint>(static_cast<mint>(sums.size()), chunkSize,
+						 [&sums](mint* buffer, mint offset, mint count) { std::copy_n(sums.cbegin() + offset, count, buffer); });
+}
+
+LLU_WSTP_FUNCTION(SumListsInPlace) {
+	WSTPStream ml(wsl, 2);
+
+	mint capacity {};
+	WS::List lists;
+	ml >> capacity >> lists;
+
+	// every list is received into the same storage, which is allocated only once
+	std::vector<double> storage(static_cast<std::size_t>(capacity));
+	WS::ListSpan<double> span {storage.data(), storage.size()};
+	std::vector<double> sums;
+	for (int i = 0; i < lists.getArgc(); ++i) {
+		ml >> span;
+		sums.push_back(std::accumulate(span.data, span.data + span.length, 0.0));
+	}
+	ml << sums;
+}
+
+LLU_WSTP_FUNCTION(ListLengthsReused) {
+	WSTPStream ml(wsl, 1);
+
+	WS::List lists;
+	ml >> lists;
+
+	std::vector<mint> reused;
+	std::vector<mint> lengths;
+	const mint* storage = nullptr;
+	bool reallocated = false;
+	for (int i = 0; i < lists.getArgc(); ++i) {
+		ml >> reused;
+		lengths.push_back(static_cast<mint>(reused.size()));
+		// if the first list is the longest, all other lists should be received into the same storage
+		reallocated |= (i > 0 && reused.data() != storage);
+		storage = reused.data();
+	}
+	ml << WS::List(2) << lengths << reallocated;
+}
+
+/// Receive two lists of Associations into the same vector and send back the second one
+LLU_WSTP_FUNCTION(AssociationsReceivedTwice) {
+	WSTPStream ml(wsl, 2);
+
+	std::vector<std::map<std::string, mint>> maps;
+	ml >> maps >> maps;
+	ml << maps;
+}